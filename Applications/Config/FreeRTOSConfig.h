@@ -57,6 +57,8 @@
 #define configSUPPORT_DYNAMIC_ALLOCATION         1
 #define configUSE_IDLE_HOOK                      1		// Have to set it to 1 for implementing Idle Hook
 #define configUSE_TICK_HOOK                      0
+#define configUSE_TICKLESS_IDLE                  0		//Rahul - Make it 2 for LowPowerConsole.c (tickless idle of LowPower.c)
+#define configUSE_POST_MORTEM                    0		//Rahul - Make it 1 for PostMortemExample.c (configASSERT() freezes the trace of PostMortem.c)
 #define configCPU_CLOCK_HZ                       ( SystemCoreClock )
 #define configTICK_RATE_HZ                       ((TickType_t)1000)
 #define configMAX_PRIORITIES                     ( 7 )
@@ -64,12 +66,14 @@
 #define configTOTAL_HEAP_SIZE                    ((size_t)12288) //Rahul - I have changed 3072 to 6144 (i.e., 12KB to 24KB)
 #define configMAX_TASK_NAME_LEN                  ( 16 )
 #define configUSE_TRACE_FACILITY                 1
+#define configCHECK_FOR_STACK_OVERFLOW           0		//Rahul - Make it 2 for QueueProcessing.c (vApplicationStackOverflowHook() of StackProfiler.c)
 #define configUSE_16_BIT_TICKS                   0
 #define configUSE_MUTEXES                        1
 #define configQUEUE_REGISTRY_SIZE                8
 #define configUSE_RECURSIVE_MUTEXES              1
 #define configUSE_COUNTING_SEMAPHORES            1
 #define configUSE_PORT_OPTIMISED_TASK_SELECTION  1
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES    3		//Rahul - Notification values per task (index 0 is used by stream/message buffers)
 
 /* Co-routine definitions. */
 #define configUSE_CO_ROUTINES                    0
@@ -93,6 +97,7 @@ to exclude the API function. */
 #define INCLUDE_xTaskGetSchedulerState      1
 #define INCLUDE_xQueueGetMutexHolder        1
 #define INCLUDE_eTaskGetState               1
+#define INCLUDE_xTaskGetIdleTaskHandle      1		//Used by StackProfiler.c
 
 /* Cortex-M specific definitions. */
 #ifdef __NVIC_PRIO_BITS
@@ -122,7 +127,14 @@ See http://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html. */
 /* Normal assert() semantics without relying on the provision of an assert.h
 header file. */
 /* USER CODE BEGIN 1 */
-#define configASSERT( x ) if( ( x ) == 0 ) { taskDISABLE_INTERRUPTS(); for( ;; ); }
+#if ( configUSE_POST_MORTEM == 1 )
+	#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+		void vPostMortemAssert(const char *pcFile, uint32_t ulLine);
+	#endif
+	#define configASSERT( x ) if( ( x ) == 0 ) { taskDISABLE_INTERRUPTS(); vPostMortemAssert( __FILE__, __LINE__ ); for( ;; ); }
+#else
+	#define configASSERT( x ) if( ( x ) == 0 ) { taskDISABLE_INTERRUPTS(); for( ;; ); }
+#endif
 /* USER CODE END 1 */
 
 /* Definitions that map the FreeRTOS port interrupt handlers to their CMSIS
@@ -148,6 +160,14 @@ standard names. */
 #define INCLUDE_xTaskGetIdleTaskHandle 	1
 #define INCLUDE_xTaskGetStackStart		1
 
+// Tickless idle implemented by LowPower.c (STOP2 with LPTIM1 as time base)
+#if ( configUSE_TICKLESS_IDLE == 2 )
+	#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+		void vLowPowerSuppressTicksAndSleep(uint32_t xExpectedIdleTime);
+	#endif
+	#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )	vLowPowerSuppressTicksAndSleep( xExpectedIdleTime )
+#endif
+
 
 
 #endif /* FREERTOS_CONFIG_H */
@@ -128,7 +128,10 @@ Revision: $Rev: 12706 $
 
 #define SEGGER_SYSVIEW_USE_STATIC_BUFFER    1                                   // Use a static buffer to generate events instead of a buffer on the stack
 
-#define SEGGER_SYSVIEW_POST_MORTEM_MODE     0                                   // 1: Enable post mortem analysis mode
+#define SEGGER_SYSVIEW_POST_MORTEM_MODE     0                                   // 1: Enable post mortem analysis mode (Rahul - Make it 1 for PostMortemExample.c)
+#if (SEGGER_SYSVIEW_POST_MORTEM_MODE == 1)
+  #define SEGGER_SYSVIEW_SECTION            ".noinit"                           // The ring is kept across a reset (PostMortem.c)
+#endif
 
 /*********************************************************************
 *
@@ -149,6 +152,14 @@ Revision: $Rev: 12706 $
 #define SEGGER_SYSVIEW_ID_BASE         0x10000000                               // Default value for the lowest Id reported by the application. Can be overridden by the application via SEGGER_SYSVIEW_SetRAMBase(). (i.e. 0x20000000 when all Ids are an address in this RAM)
 #define SEGGER_SYSVIEW_ID_SHIFT        2                                        // Number of bits to shift the Id to save bandwidth. (i.e. 2 when Ids are 4 byte aligned)
 
+/*********************************************************************
+*
+*       SystemView compact encoding (Rahul - the recording has to be converted by Tools/svcompact.py before SystemView opens it)
+*/
+#define SEGGER_SYSVIEW_COMPACT_MODE             0                               // 1: Task indices instead of Ids, coarse timestamps, no new start of the running task
+#define SEGGER_SYSVIEW_COMPACT_MAX_TASKS        16                              // Number of task indices. Tasks beyond them keep their Id.
+#define SEGGER_SYSVIEW_COMPACT_TIMESTAMP_SHIFT  4                               // Timestamps in units of 2^shift cycles of SEGGER_SYSVIEW_GET_TIMESTAMP()
+
 /*********************************************************************
 *
 *       SystemView interrupt configuration
@@ -189,6 +189,29 @@ Additional information:
   #define MAKE_DELTA_32BIT(Delta)
 #endif
 
+// Compact encoding (Rahul): task Ids are small indices, announced by Task Index packets,
+// timestamps are in units of 2^SEGGER_SYSVIEW_COMPACT_TIMESTAMP_SHIFT cycles (SysFreq is
+// sent in the same units), and the start of the task which already runs is not sent again
+// (i.e. after an interrupt which did not switch the task).
+// Tools/svcompact.py converts the recording back to the standard encoding.
+#if (SEGGER_SYSVIEW_COMPACT_MODE == 1)
+  #define SHRINK_TASK_ID(Id)                _CompactTaskId(Id, 0)
+  #define ANNOUNCE_TASK_ID(Id)              _CompactTaskId(Id, 1)
+  #define SHRINK_DELTA(Delta)               Delta = (U32)(Delta) >> SEGGER_SYSVIEW_COMPACT_TIMESTAMP_SHIFT;
+  #define SHRINK_TIME(Time)                 ((U32)(Time) >> SEGGER_SYSVIEW_COMPACT_TIMESTAMP_SHIFT)
+  #define SENT_TIMESTAMP(TimeStamp, Delta)  (_SYSVIEW_Globals.LastTxTimeStamp + ((U32)(Delta) << SEGGER_SYSVIEW_COMPACT_TIMESTAMP_SHIFT))
+  #define IS_RUNNING(Id)                    _CompactIsRunning(Id)
+  #define STOP_RUNNING(Id)                  _CompactStopRunning(Id)
+#else
+  #define SHRINK_TASK_ID(Id)                SHRINK_ID(Id)
+  #define ANNOUNCE_TASK_ID(Id)              SHRINK_ID(Id)
+  #define SHRINK_DELTA(Delta)
+  #define SHRINK_TIME(Time)                 (Time)
+  #define SENT_TIMESTAMP(TimeStamp, Delta)  (TimeStamp)
+  #define IS_RUNNING(Id)                    0
+  #define STOP_RUNNING(Id)
+#endif
+
 
 /*********************************************************************
 *
@@ -207,6 +230,9 @@ Additional information:
 
 #define MODULE_EVENT_OFFSET        (512)
 
+#define COMPACT_IDLE               (0u)            // Running task Id of the idle state
+#define COMPACT_NONE               (0xFFFFFFFFu)   // Running task unknown (scheduler, new recording)
+
 /*********************************************************************
 *
 *       Types, local
@@ -236,6 +262,10 @@ typedef struct {
         U8                      DownChannel;
 #endif
         U32                     DisabledEvents;
+#if (SEGGER_SYSVIEW_COMPACT_MODE == 1)
+        U32                     RunningTask;
+        U32                     aTaskId[SEGGER_SYSVIEW_COMPACT_MAX_TASKS];   // Task of each index, 0: free
+#endif
   const SEGGER_SYSVIEW_OS_API*  pOSAPI;
         SEGGER_SYSVIEW_SEND_SYS_DESC_FUNC*   pfSendSysDesc;
 } SEGGER_SYSVIEW_GLOBALS;
@@ -247,6 +277,11 @@ typedef struct {
 **********************************************************************
 */
 static void _SendPacket(U8* pStartPacket, U8* pEndPacket, unsigned int EventId);
+#if (SEGGER_SYSVIEW_COMPACT_MODE == 1)
+static U32  _CompactTaskId(U32 TaskId, int Announce);
+static int  _CompactIsRunning(U32 TaskId);
+static void _CompactStopRunning(U32 TaskId);
+#endif
 
 /*********************************************************************
 *
@@ -535,14 +570,16 @@ static int _TrySendOverflowPacket(void) {
   TimeStamp  = SEGGER_SYSVIEW_GET_TIMESTAMP();
   Delta = TimeStamp - _SYSVIEW_Globals.LastTxTimeStamp;
   MAKE_DELTA_32BIT(Delta);
+  SHRINK_DELTA(Delta);
   ENCODE_U32(pPayload, Delta);
   //
   // Try to store packet in RTT buffer and update time stamp when this was successful
   //
   Status = SEGGER_RTT_WriteSkipNoLock(CHANNEL_ID_UP, aPacket, pPayload - aPacket);
   if (Status) {
-    _SYSVIEW_Globals.LastTxTimeStamp = TimeStamp;
+    _SYSVIEW_Globals.LastTxTimeStamp = SENT_TIMESTAMP(TimeStamp, Delta);
     _SYSVIEW_Globals.EnableState--; // EnableState has been 2, will be 1. Always.
+    STOP_RUNNING(COMPACT_NONE);     // Packets have been lost: send the next task start
   } else {
     _SYSVIEW_Globals.DropCount++;
   }
@@ -573,6 +610,7 @@ static void _SendSyncInfo(void) {
   // Send module information
   //
   SEGGER_RTT_WriteWithOverwriteNoLock(CHANNEL_ID_UP, _abSync, 10);
+  STOP_RUNNING(COMPACT_NONE);   // The oldest packets will be lost: send the next task start
   SEGGER_SYSVIEW_RecordVoid(SYSVIEW_EVTID_TRACE_START);
   {
     U8* pPayload;
@@ -580,7 +618,7 @@ static void _SendSyncInfo(void) {
     RECORD_START(SEGGER_SYSVIEW_INFO_SIZE + 4 * SEGGER_SYSVIEW_QUANTA_U32);
     //
     pPayload = pPayloadStart;
-    ENCODE_U32(pPayload, _SYSVIEW_Globals.SysFreq);
+    ENCODE_U32(pPayload, SHRINK_TIME(_SYSVIEW_Globals.SysFreq));
     ENCODE_U32(pPayload, _SYSVIEW_Globals.CPUFreq);
     ENCODE_U32(pPayload, _SYSVIEW_Globals.RAMBaseAddress);
     ENCODE_U32(pPayload, SEGGER_SYSVIEW_ID_SHIFT);
@@ -693,20 +731,21 @@ Send:
   TimeStamp  = SEGGER_SYSVIEW_GET_TIMESTAMP();
   Delta = TimeStamp - _SYSVIEW_Globals.LastTxTimeStamp;
   MAKE_DELTA_32BIT(Delta);
+  SHRINK_DELTA(Delta);
   ENCODE_U32(pEndPacket, Delta);
 #if (SEGGER_SYSVIEW_POST_MORTEM_MODE == 1)
   //
   // Store packet in RTT buffer by overwriting old data and update time stamp
   //
   SEGGER_RTT_WriteWithOverwriteNoLock(CHANNEL_ID_UP, pStartPacket, pEndPacket - pStartPacket);
-  _SYSVIEW_Globals.LastTxTimeStamp = TimeStamp;
+  _SYSVIEW_Globals.LastTxTimeStamp = SENT_TIMESTAMP(TimeStamp, Delta);
 #else
   //
   // Try to store packet in RTT buffer and update time stamp when this was successful
   //
   Status = SEGGER_RTT_WriteSkipNoLock(CHANNEL_ID_UP, pStartPacket, pEndPacket - pStartPacket);
   if (Status) {
-    _SYSVIEW_Globals.LastTxTimeStamp = TimeStamp;
+    _SYSVIEW_Globals.LastTxTimeStamp = SENT_TIMESTAMP(TimeStamp, Delta);
   } else {
     _SYSVIEW_Globals.EnableState++; // EnableState has been 1, will be 2. Always.
   }
@@ -747,6 +786,108 @@ SendDone:
 #endif
 }
 
+#if (SEGGER_SYSVIEW_COMPACT_MODE == 1)
+/*********************************************************************
+*
+*       _CompactTaskId()
+*
+*  Function description
+*    Get the Id of a task in the compact encoding.
+*    A task gets the first free index when it is seen for the first
+*    time, and the index is announced with a Task Index packet.
+*    When all indices are used, the task keeps its (shrunk) Id, sent
+*    above the indices.
+*
+*  Parameters
+*    TaskId   - Task ID (address of the task).
+*    Announce - !=0: Send the Task Index packet even if the task has
+*               an index already (task list of a sync).
+*
+*  Return value
+*    1..SEGGER_SYSVIEW_COMPACT_MAX_TASKS: Index of the task.
+*    Above: SEGGER_SYSVIEW_COMPACT_MAX_TASKS + 1 + shrunk Id.
+*
+*  Additional information
+*    Called with SystemView locked, before the payload of the calling
+*    packet is encoded.
+*    Format of the Task Index packet:
+*      30 <Len> <Index> <TaskId> <MaxTasks> <TimeStamp>
+*/
+static U32 _CompactTaskId(U32 TaskId, int Announce) {
+  U8  aIndexPacket[SEGGER_SYSVIEW_INFO_SIZE + 3 * SEGGER_SYSVIEW_QUANTA_U32];
+  U8* pPayloadStart;
+  U8* pPayload;
+  U32 Index;
+  U32 Free;
+
+  Free = 0;
+  for (Index = 1; Index <= SEGGER_SYSVIEW_COMPACT_MAX_TASKS; Index++) {
+    if (_SYSVIEW_Globals.aTaskId[Index - 1] == TaskId) {
+      break;
+    }
+    if ((Free == 0) && (_SYSVIEW_Globals.aTaskId[Index - 1] == 0)) {
+      Free = Index;
+    }
+  }
+  if (Index > SEGGER_SYSVIEW_COMPACT_MAX_TASKS) {
+    if (Free == 0) {
+      return SEGGER_SYSVIEW_COMPACT_MAX_TASKS + 1 + SHRINK_ID(TaskId);
+    }
+    Index = Free;
+    _SYSVIEW_Globals.aTaskId[Index - 1] = TaskId;
+    Announce = 1;
+  }
+  if (Announce) {
+    pPayloadStart = _PreparePacket(aIndexPacket);
+    pPayload = pPayloadStart;
+    ENCODE_U32(pPayload, Index);
+    ENCODE_U32(pPayload, SHRINK_ID(TaskId));
+    ENCODE_U32(pPayload, SEGGER_SYSVIEW_COMPACT_MAX_TASKS);
+    _SendPacket(pPayloadStart, pPayload, SYSVIEW_EVTID_TASK_INDEX);
+  }
+  return Index;
+}
+
+/*********************************************************************
+*
+*       _CompactIsRunning()
+*
+*  Function description
+*    Check if a task start has to be sent: it is not when the task
+*    runs already (i.e. the scheduler selects it again after an
+*    interrupt). Otherwise, the task becomes the running one.
+*
+*  Parameters
+*    TaskId - Compact Id of the task, COMPACT_IDLE for the idle state.
+*
+*  Return value
+*    !=0: The task runs already, the start is not sent.
+*/
+static int _CompactIsRunning(U32 TaskId) {
+  if (_SYSVIEW_Globals.RunningTask == TaskId) {
+    return 1;
+  }
+  _SYSVIEW_Globals.RunningTask = TaskId;
+  return 0;
+}
+
+/*********************************************************************
+*
+*       _CompactStopRunning()
+*
+*  Function description
+*    Forget the running task, so that its next start is sent.
+*
+*  Parameters
+*    TaskId - Compact Id of the task which stops, COMPACT_NONE for any.
+*/
+static void _CompactStopRunning(U32 TaskId) {
+  if ((TaskId == COMPACT_NONE) || (TaskId == _SYSVIEW_Globals.RunningTask)) {
+    _SYSVIEW_Globals.RunningTask = COMPACT_NONE;
+  }
+}
+#endif  // (SEGGER_SYSVIEW_COMPACT_MODE == 1)
+
 #ifndef SEGGER_SYSVIEW_EXCLUDE_PRINTF // Define in project to avoid warnings about variable parameter list
 /*********************************************************************
 *
@@ -1264,6 +1405,7 @@ void SEGGER_SYSVIEW_Init(U32 SysFreq, U32 CPUFreq, const SEGGER_SYSVIEW_OS_API *
   _SYSVIEW_Globals.pfSendSysDesc    = pfSendSysDesc;
   _SYSVIEW_Globals.EnableState      = 0;
 #endif  // (SEGGER_SYSVIEW_POST_MORTEM_MODE == 1)
+  STOP_RUNNING(COMPACT_NONE);
 }
 
 /*********************************************************************
@@ -1657,6 +1799,7 @@ void SEGGER_SYSVIEW_RecordString(unsigned int EventID, const char* pString) {
 void SEGGER_SYSVIEW_Start(void) {
   if (_SYSVIEW_Globals.EnableState == 0) {
     _SYSVIEW_Globals.EnableState = 1;
+    STOP_RUNNING(COMPACT_NONE);
 #if (SEGGER_SYSVIEW_POST_MORTEM_MODE == 1)
     _SendSyncInfo();
 #else
@@ -1670,7 +1813,7 @@ void SEGGER_SYSVIEW_Start(void) {
       RECORD_START(SEGGER_SYSVIEW_INFO_SIZE + 4 * SEGGER_SYSVIEW_QUANTA_U32);
       //
       pPayload = pPayloadStart;
-      ENCODE_U32(pPayload, _SYSVIEW_Globals.SysFreq);
+      ENCODE_U32(pPayload, SHRINK_TIME(_SYSVIEW_Globals.SysFreq));
       ENCODE_U32(pPayload, _SYSVIEW_Globals.CPUFreq);
       ENCODE_U32(pPayload, _SYSVIEW_Globals.RAMBaseAddress);
       ENCODE_U32(pPayload, SEGGER_SYSVIEW_ID_SHIFT);
@@ -1725,7 +1868,7 @@ void SEGGER_SYSVIEW_GetSysDesc(void) {
   RECORD_START(SEGGER_SYSVIEW_INFO_SIZE + 4 * SEGGER_SYSVIEW_QUANTA_U32);
   //
   pPayload = pPayloadStart;
-  ENCODE_U32(pPayload, _SYSVIEW_Globals.SysFreq);
+  ENCODE_U32(pPayload, SHRINK_TIME(_SYSVIEW_Globals.SysFreq));
   ENCODE_U32(pPayload, _SYSVIEW_Globals.CPUFreq);
   ENCODE_U32(pPayload, _SYSVIEW_Globals.RAMBaseAddress);
   ENCODE_U32(pPayload, SEGGER_SYSVIEW_ID_SHIFT);
@@ -1750,16 +1893,18 @@ void SEGGER_SYSVIEW_GetSysDesc(void) {
 void SEGGER_SYSVIEW_SendTaskInfo(const SEGGER_SYSVIEW_TASKINFO *pInfo) {
   U8* pPayload;
   U8* pPayloadStart;
+  U32 TaskId;
   RECORD_START(SEGGER_SYSVIEW_INFO_SIZE + SEGGER_SYSVIEW_QUANTA_U32 + 1 + 32);
   //
+  TaskId = ANNOUNCE_TASK_ID(pInfo->TaskID);
   pPayload = pPayloadStart;
-  ENCODE_U32(pPayload, SHRINK_ID(pInfo->TaskID));
+  ENCODE_U32(pPayload, TaskId);
   ENCODE_U32(pPayload, pInfo->Prio);
   pPayload = _EncodeStr(pPayload, pInfo->sName, 32);
   _SendPacket(pPayloadStart, pPayload, SYSVIEW_EVTID_TASK_INFO);
   //
   pPayload = pPayloadStart;
-  ENCODE_U32(pPayload, SHRINK_ID(pInfo->TaskID));
+  ENCODE_U32(pPayload, TaskId);
   ENCODE_U32(pPayload, pInfo->StackBase);
   ENCODE_U32(pPayload, pInfo->StackSize);
   ENCODE_U32(pPayload, 0); // Stack End, future use
@@ -1826,7 +1971,7 @@ void SEGGER_SYSVIEW_RecordSystime(void) {
                                (U32)(Systime),
                                (U32)(Systime >> 32));
   } else {
-    SEGGER_SYSVIEW_RecordU32(SYSVIEW_EVTID_SYSTIME_CYCLES, SEGGER_SYSVIEW_GET_TIMESTAMP());
+    SEGGER_SYSVIEW_RecordU32(SYSVIEW_EVTID_SYSTIME_CYCLES, SHRINK_TIME(SEGGER_SYSVIEW_GET_TIMESTAMP()));
   }
 }
 
@@ -1895,6 +2040,7 @@ void SEGGER_SYSVIEW_RecordExitISRToScheduler(void) {
   RECORD_START(SEGGER_SYSVIEW_INFO_SIZE);
   //
   _SendPacket(pPayloadStart, pPayloadStart, SYSVIEW_EVTID_ISR_TO_SCHEDULER);
+  STOP_RUNNING(COMPACT_NONE);
   RECORD_END();
 }
 
@@ -1989,7 +2135,9 @@ void SEGGER_SYSVIEW_OnIdle(void) {
   U8* pPayloadStart;
   RECORD_START(SEGGER_SYSVIEW_INFO_SIZE);
   //
-  _SendPacket(pPayloadStart, pPayloadStart, SYSVIEW_EVTID_IDLE);
+  if (IS_RUNNING(COMPACT_IDLE) == 0) {
+    _SendPacket(pPayloadStart, pPayloadStart, SYSVIEW_EVTID_IDLE);
+  }
   RECORD_END();
 }
 
@@ -2010,7 +2158,7 @@ void SEGGER_SYSVIEW_OnTaskCreate(U32 TaskId) {
   RECORD_START(SEGGER_SYSVIEW_INFO_SIZE + SEGGER_SYSVIEW_QUANTA_U32);
   //
   pPayload = pPayloadStart;
-  TaskId = SHRINK_ID(TaskId);
+  TaskId = SHRINK_TASK_ID(TaskId);
   ENCODE_U32(pPayload, TaskId);
   _SendPacket(pPayloadStart, pPayload, SYSVIEW_EVTID_TASK_CREATE);
   RECORD_END();
@@ -2035,9 +2183,15 @@ void SEGGER_SYSVIEW_OnTaskTerminate(U32 TaskId) {
   RECORD_START(SEGGER_SYSVIEW_INFO_SIZE + SEGGER_SYSVIEW_QUANTA_U32);
   //
   pPayload = pPayloadStart;
-  TaskId = SHRINK_ID(TaskId);
+  TaskId = SHRINK_TASK_ID(TaskId);
   ENCODE_U32(pPayload, TaskId);
   _SendPacket(pPayloadStart, pPayload, SYSVIEW_EVTID_TASK_TERMINATE);
+  STOP_RUNNING(TaskId);
+#if (SEGGER_SYSVIEW_COMPACT_MODE == 1)
+  if (TaskId <= SEGGER_SYSVIEW_COMPACT_MAX_TASKS) {
+    _SYSVIEW_Globals.aTaskId[TaskId - 1] = 0;   // The index is free for the next task
+  }
+#endif
   RECORD_END();
 }
 
@@ -2059,9 +2213,11 @@ void SEGGER_SYSVIEW_OnTaskStartExec(U32 TaskId) {
   RECORD_START(SEGGER_SYSVIEW_INFO_SIZE + SEGGER_SYSVIEW_QUANTA_U32);
   //
   pPayload = pPayloadStart;
-  TaskId = SHRINK_ID(TaskId);
-  ENCODE_U32(pPayload, TaskId);
-  _SendPacket(pPayloadStart, pPayload, SYSVIEW_EVTID_TASK_START_EXEC);
+  TaskId = SHRINK_TASK_ID(TaskId);
+  if (IS_RUNNING(TaskId) == 0) {
+    ENCODE_U32(pPayload, TaskId);
+    _SendPacket(pPayloadStart, pPayload, SYSVIEW_EVTID_TASK_START_EXEC);
+  }
   RECORD_END();
 }
 
@@ -2078,6 +2234,7 @@ void SEGGER_SYSVIEW_OnTaskStopExec(void) {
   RECORD_START(SEGGER_SYSVIEW_INFO_SIZE);
   //
   _SendPacket(pPayloadStart, pPayloadStart, SYSVIEW_EVTID_TASK_STOP_EXEC);
+  STOP_RUNNING(COMPACT_NONE);
   RECORD_END();
 }
 
@@ -2097,7 +2254,7 @@ void SEGGER_SYSVIEW_OnTaskStartReady(U32 TaskId) {
   RECORD_START(SEGGER_SYSVIEW_INFO_SIZE + SEGGER_SYSVIEW_QUANTA_U32);
   //
   pPayload = pPayloadStart;
-  TaskId = SHRINK_ID(TaskId);
+  TaskId = SHRINK_TASK_ID(TaskId);
   ENCODE_U32(pPayload, TaskId);
   _SendPacket(pPayloadStart, pPayload, SYSVIEW_EVTID_TASK_START_READY);
   RECORD_END();
@@ -2120,10 +2277,11 @@ void SEGGER_SYSVIEW_OnTaskStopReady(U32 TaskId, unsigned int Cause) {
   RECORD_START(SEGGER_SYSVIEW_INFO_SIZE + 2 * SEGGER_SYSVIEW_QUANTA_U32);
   //
   pPayload = pPayloadStart;
-  TaskId = SHRINK_ID(TaskId);
+  TaskId = SHRINK_TASK_ID(TaskId);
   ENCODE_U32(pPayload, TaskId);
   ENCODE_U32(pPayload, Cause);
   _SendPacket(pPayloadStart, pPayload, SYSVIEW_EVTID_TASK_STOP_READY);
+  STOP_RUNNING(TaskId);
   RECORD_END();
 }
 
@@ -2845,6 +3003,7 @@ void SEGGER_SYSVIEW_DisableEvents(U32 DisableMask) {
 *    > 0: Recording started.
 */
 int SEGGER_SYSVIEW_IsStarted(void) {
+#if (SEGGER_SYSVIEW_POST_MORTEM_MODE != 1)   // No down channel in post mortem mode
   //
   // Check if host is sending data which needs to be processed.
   //
@@ -2855,6 +3014,7 @@ int SEGGER_SYSVIEW_IsStarted(void) {
       _SYSVIEW_Globals.RecursionCnt = 0;
     }
   }
+#endif
   return _SYSVIEW_Globals.EnableState;
 }
 
@@ -129,6 +129,7 @@ extern "C" {
 #define   SYSVIEW_EVTID_NUMMODULES        27
 #define   SYSVIEW_EVTID_END_CALL          28
 #define   SYSVIEW_EVTID_TASK_TERMINATE    29
+#define   SYSVIEW_EVTID_TASK_INDEX        30  // Compact encoding only: <Index><TaskId><MaxTasks>, removed by Tools/svcompact.py
 
 #define   SYSVIEW_EVTID_EX                31
 //
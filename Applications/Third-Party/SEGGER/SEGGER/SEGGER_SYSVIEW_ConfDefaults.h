@@ -163,6 +163,21 @@ extern "C" {
   #define SEGGER_SYSVIEW_SYNC_PERIOD_SHIFT  8
 #endif
 
+// Use the compact encoding (task indices, coarse timestamps), converted back by the host
+#ifndef   SEGGER_SYSVIEW_COMPACT_MODE
+  #define SEGGER_SYSVIEW_COMPACT_MODE       0
+#endif
+
+// Number of task indices of the compact encoding
+#ifndef   SEGGER_SYSVIEW_COMPACT_MAX_TASKS
+  #define SEGGER_SYSVIEW_COMPACT_MAX_TASKS  16
+#endif
+
+// Number of bits to shift timestamps in the compact encoding
+#ifndef   SEGGER_SYSVIEW_COMPACT_TIMESTAMP_SHIFT
+  #define SEGGER_SYSVIEW_COMPACT_TIMESTAMP_SHIFT  0
+#endif
+
 // Lock SystemView (nestable)
 #ifndef   SEGGER_SYSVIEW_LOCK
   #define SEGGER_SYSVIEW_LOCK()             SEGGER_RTT_LOCK()
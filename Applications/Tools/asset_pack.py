@@ -0,0 +1,214 @@
+#!/usr/bin/env python3
+#
+# asset_pack.py
+#
+#  Created on: 19-Oct-2026
+#      Author: Rahul
+#
+# Packer and reader of the asset containers of the QSPI flash (inc/AssetStore.h, src/AssetStore.c).
+#
+# Container (little endian):
+#   header (16 bytes): magic "ASST" | version (2) | count (2) | size of the container (4) | CRC-32 (4)
+#   index: count entries of 32 bytes, sorted by name:
+#          name (16, '\0' padded) | offset (4) | length (4) | CRC-32 of the data (4) | type (2) | 0 (2)
+#   data: each asset at an offset aligned on 8 bytes. A text asset is followed by a '\0' (not in its length).
+# The CRC-32 of the header covers its first 12 bytes and the index. The CRC-32 is the zlib one (Crc32.c).
+#
+# Usage:
+#   python3 asset_pack.py pack -o assets.bin [--header ../inc/AssetImage.h] name=file[:text|:bin] ...
+#   python3 asset_pack.py list assets.bin
+#   python3 asset_pack.py verify assets.bin
+#   python3 asset_pack.py extract assets.bin name [-o file]
+# A file ending in .txt is a text asset unless :bin is given. The image of AssetStoreExample.c was packed with:
+#   python3 asset_pack.py pack -o assets.bin --header ../inc/AssetImage.h menu=assets/menu.txt \
+#       help=assets/help.txt sine_q15=assets/sine_q15.bin
+# (assets/sine_q15.bin: 256 int16 of 32767 * sin(2 * pi * i / 256), rounded)
+
+import argparse
+import struct
+import sys
+import zlib
+
+MAGIC = b"ASST"
+VERSION = 1
+HEADER = struct.Struct("<4sHHII")
+ENTRY = struct.Struct("<16sIIIHH")
+NAME_SIZE = 16
+ALIGNMENT = 8
+
+TYPE_BINARY = 0
+TYPE_TEXT = 1
+TYPE_NAMES = {TYPE_BINARY: "bin", TYPE_TEXT: "text"}
+
+
+class Asset:
+    def __init__(self, name, data, kind, offset=0, crc=0):
+        self.name = name
+        self.data = data
+        self.kind = kind
+        self.offset = offset
+        self.crc = crc
+
+
+def align(value):
+    return (value + ALIGNMENT - 1) & ~(ALIGNMENT - 1)
+
+
+def pack(assets):
+    """Container of a list of Asset (data and kind set), as bytes."""
+    assets = sorted(assets, key=lambda asset: asset.name.encode())
+    offset = align(HEADER.size + ENTRY.size * len(assets))
+    index = b""
+    data = b""
+    for asset in assets:
+        asset.offset = offset
+        asset.crc = zlib.crc32(asset.data)
+        index += ENTRY.pack(asset.name.encode(), asset.offset, len(asset.data), asset.crc, asset.kind, 0)
+        stored = asset.data + (b"\0" if asset.kind == TYPE_TEXT else b"")
+        data += stored + b"\xff" * (align(len(stored)) - len(stored))
+        offset += align(len(stored))
+
+    size = align(HEADER.size + len(index)) + len(data)
+    first = HEADER.pack(MAGIC, VERSION, len(assets), size, 0)[:12]
+    header = first + struct.pack("<I", zlib.crc32(first + index))
+    image = header + index
+    return image + b"\xff" * (align(len(image)) - len(image)) + data
+
+
+def read(image):
+    """List of Asset of a container. It raises ValueError if the header or the index is not valid."""
+    if len(image) < HEADER.size:
+        raise ValueError("too short for a header")
+    magic, version, count, size, crc = HEADER.unpack_from(image, 0)
+    if magic != MAGIC or version != VERSION:
+        raise ValueError("not a container (magic %r, version %d)" % (magic, version))
+    if size > len(image) or HEADER.size + count * ENTRY.size > size:
+        raise ValueError("size %d does not fit in %d bytes" % (size, len(image)))
+    index = image[HEADER.size:HEADER.size + count * ENTRY.size]
+    if zlib.crc32(image[:12] + index) != crc:
+        raise ValueError("wrong CRC of the header and index")
+
+    assets = []
+    for number in range(count):
+        name, offset, length, data_crc, kind, _ = ENTRY.unpack_from(index, number * ENTRY.size)
+        if offset + length > size:
+            raise ValueError("asset %d is out of the container" % number)
+        assets.append(Asset(name.rstrip(b"\0").decode(), image[offset:offset + length], kind, offset, data_crc))
+    return assets
+
+
+def parse_spec(spec):
+    """name=file[:text|:bin] -> Asset"""
+    name, _, path = spec.partition("=")
+    if not name or not path:
+        raise ValueError("expected name=file, got %r" % spec)
+    if len(name.encode()) >= NAME_SIZE:
+        raise ValueError("name %r is longer than %d characters" % (name, NAME_SIZE - 1))
+    kind = TYPE_TEXT if path.endswith(".txt") else TYPE_BINARY
+    for suffix, suffix_kind in ((":text", TYPE_TEXT), (":bin", TYPE_BINARY)):
+        if path.endswith(suffix):
+            path, kind = path[:-len(suffix)], suffix_kind
+    with open(path, "rb") as source:
+        data = source.read()
+    if kind == TYPE_TEXT:
+        # The board prints them on a terminal
+        data = data.replace(b"\r\n", b"\n").replace(b"\n", b"\r\n")
+    return Asset(name, data, kind)
+
+
+def write_header(path, image):
+    lines = ["/*", " * AssetImage.h", " *", " * Generated by Tools/asset_pack.py: do not edit.", " */", "",
+             "#ifndef ASSETIMAGE_H_", "#define ASSETIMAGE_H_", "", "#include <stdint.h>", "",
+             "#define ASSET_IMAGE_SIZE\t\t%d" % len(image), "",
+             "static const uint8_t ucAssetImage[ASSET_IMAGE_SIZE] __attribute__((aligned(8))) =", "{"]
+    for start in range(0, len(image), 16):
+        lines.append("\t" + ", ".join("0x%02X" % byte for byte in image[start:start + 16]) + ",")
+    lines += ["};", "", "#endif /* ASSETIMAGE_H_ */", ""]
+    with open(path, "w") as header:
+        header.write("\n".join(lines))
+
+
+def cmd_pack(args):
+    image = pack([parse_spec(spec) for spec in args.assets])
+    with open(args.output, "wb") as output:
+        output.write(image)
+    if args.header:
+        write_header(args.header, image)
+    print("%d assets, %d bytes" % (len(args.assets), len(image)))
+    return 0
+
+
+def load(path):
+    with open(path, "rb") as source:
+        return read(source.read())
+
+
+def cmd_list(args):
+    for asset in load(args.image):
+        print("%-16s %-4s offset %6d length %6d crc %08X" % (asset.name, TYPE_NAMES.get(asset.kind, "?"),
+                                                            asset.offset, len(asset.data), asset.crc))
+    return 0
+
+
+def cmd_verify(args):
+    errors = 0
+    assets = load(args.image)
+    for asset in assets:
+        if zlib.crc32(asset.data) != asset.crc:
+            print("%s: wrong CRC" % asset.name)
+            errors += 1
+    names = [asset.name.encode() for asset in assets]
+    if names != sorted(names):
+        print("the index is not sorted")
+        errors += 1
+    print("%d assets, %d errors" % (len(assets), errors))
+    return 1 if errors else 0
+
+
+def cmd_extract(args):
+    for asset in load(args.image):
+        if asset.name == args.name:
+            if args.output:
+                with open(args.output, "wb") as output:
+                    output.write(asset.data)
+            else:
+                sys.stdout.buffer.write(asset.data)
+            return 0
+    print("no asset %r" % args.name)
+    return 1
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Asset container packer and reader")
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    pack_cmd = commands.add_parser("pack", help="pack files into a container")
+    pack_cmd.add_argument("-o", "--output", required=True, help="container file")
+    pack_cmd.add_argument("--header", help="also write the container as a C array in this header")
+    pack_cmd.add_argument("assets", nargs="+", help="name=file[:text|:bin]")
+    pack_cmd.set_defaults(handler=cmd_pack)
+
+    list_cmd = commands.add_parser("list", help="print the index of a container")
+    list_cmd.add_argument("image")
+    list_cmd.set_defaults(handler=cmd_list)
+
+    verify_cmd = commands.add_parser("verify", help="check the CRC of every asset")
+    verify_cmd.add_argument("image")
+    verify_cmd.set_defaults(handler=cmd_verify)
+
+    extract_cmd = commands.add_parser("extract", help="write the data of one asset")
+    extract_cmd.add_argument("image")
+    extract_cmd.add_argument("name")
+    extract_cmd.add_argument("-o", "--output", help="file (default: standard output)")
+    extract_cmd.set_defaults(handler=cmd_extract)
+
+    args = parser.parse_args()
+    try:
+        return args.handler(args)
+    except (OSError, ValueError) as exc:
+        print(exc)
+        return 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
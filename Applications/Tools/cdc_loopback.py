@@ -0,0 +1,88 @@
+#!/usr/bin/env python3
+#
+# cdc_loopback.py
+#
+#  Created on: 19-Oct-2026
+#      Author: Rahul
+#
+# Loopback throughput test of the USB CDC console (src/UsbCdcConsole.c built with
+# CONSOLE_USE_USB_CDC set to 0, so the board only echoes the data on the USB port).
+#
+# A writer thread sends a pseudo random pattern while the main thread reads the echo
+# back and checks it byte by byte. The throughput counts the data in one direction.
+#
+# Usage: python3 cdc_loopback.py /dev/ttyACM0 [--size 1048576] [--chunk 4096]
+# It needs pyserial (pip install pyserial).
+
+import argparse
+import random
+import sys
+import threading
+import time
+
+import serial
+
+
+def make_pattern(size, seed):
+    rng = random.Random(seed)
+    return bytes(rng.getrandbits(8) for _ in range(size))
+
+
+def writer(port, data, chunk, errors):
+    try:
+        for offset in range(0, len(data), chunk):
+            port.write(data[offset:offset + chunk])
+        port.flush()
+    except serial.SerialException as exc:
+        errors.append(exc)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="USB CDC loopback throughput test")
+    parser.add_argument("port", help="serial port of the board (e.g. /dev/ttyACM0 or COM5)")
+    parser.add_argument("--size", type=int, default=1024 * 1024, help="bytes to send (default 1 MiB)")
+    parser.add_argument("--chunk", type=int, default=4096, help="bytes per write call (default 4096)")
+    parser.add_argument("--timeout", type=float, default=5.0, help="seconds without data before giving up")
+    args = parser.parse_args()
+
+    data = make_pattern(args.size, seed=0x5EED)
+
+    # The baud rate is not used by the CDC device, but opening the port sets DTR which opens the console
+    port = serial.Serial(args.port, baudrate=115200, timeout=args.timeout)
+    port.reset_input_buffer()
+
+    errors = []
+    thread = threading.Thread(target=writer, args=(port, data, args.chunk, errors))
+
+    received = bytearray()
+    start = time.perf_counter()
+    thread.start()
+
+    while len(received) < len(data):
+        block = port.read(min(65536, len(data) - len(received)))
+        if not block:
+            print("Timeout after %d of %d bytes" % (len(received), len(data)))
+            break
+        received += block
+
+    elapsed = time.perf_counter() - start
+    thread.join()
+    port.close()
+
+    if errors:
+        print("Write error: %s" % errors[0])
+        return 1
+
+    mismatch = next((i for i, (a, b) in enumerate(zip(data, received)) if a != b), None)
+    if mismatch is not None:
+        print("Data mismatch at byte %d" % mismatch)
+        return 1
+    if len(received) != len(data):
+        return 1
+
+    print("%d bytes echoed in %.3f s: %.1f KB/s each way" % (len(data), elapsed, len(data) / elapsed / 1024))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
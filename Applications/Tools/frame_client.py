@@ -0,0 +1,201 @@
+#!/usr/bin/env python3
+#
+# frame_client.py
+#
+#  Created on: 19-Oct-2026
+#      Author: Rahul
+#
+# Host side of the binary framed protocol (inc/FrameProtocol.h, src/FrameProtocolExample.c).
+#
+# Frame: | length (2, LE) | command (1) | payload | CRC-32 (4, LE) |, COBS encoded between two 0x00
+# delimiters. The CRC-32 is the zlib one, so zlib.crc32() checks the board bit for bit.
+#
+# Usage:
+#   python3 frame_client.py /dev/ttyACM0 ping [--count 100] [--size 512]
+#   python3 frame_client.py /dev/ttyACM0 led on|off|toggle
+#   python3 frame_client.py /dev/ttyACM0 stats
+#   python3 frame_client.py /dev/ttyACM0 crc [--size 512]
+# It needs pyserial (pip install pyserial).
+
+import argparse
+import os
+import struct
+import sys
+import time
+import zlib
+
+import serial
+
+CMD_PING = 0x01
+CMD_LED = 0x02
+CMD_STATS = 0x03
+CMD_CRC = 0x04
+CMD_NAK = 0x7F
+ANSWER = 0x80
+
+MAX_PAYLOAD = 512
+NAK_REASONS = {1: "COBS error", 2: "length error", 3: "CRC error"}
+
+
+def cobs_encode(data):
+    out = bytearray()
+    block = bytearray()
+    for byte in data:
+        if byte == 0:
+            out.append(len(block) + 1)
+            out += block
+            block = bytearray()
+        else:
+            block.append(byte)
+            if len(block) == 254:
+                out.append(0xFF)
+                out += block
+                block = bytearray()
+    out.append(len(block) + 1)
+    out += block
+    return bytes(out)
+
+
+def cobs_decode(data):
+    out = bytearray()
+    index = 0
+    while index < len(data):
+        code = data[index]
+        if code == 0 or index + code > len(data):
+            raise ValueError("bad COBS block")
+        out += data[index + 1:index + code]
+        index += code
+        if code != 0xFF and index < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def encode_frame(command, payload):
+    raw = struct.pack("<HB", len(payload), command) + payload
+    raw += struct.pack("<I", zlib.crc32(raw) & 0xFFFFFFFF)
+    return b"\x00" + cobs_encode(raw) + b"\x00"
+
+
+def decode_frame(data):
+    raw = cobs_decode(data)
+    if len(raw) < 7:
+        raise ValueError("frame too short")
+    length, command = struct.unpack_from("<HB", raw)
+    if len(raw) != length + 7:
+        raise ValueError("length mismatch")
+    (crc,) = struct.unpack_from("<I", raw, 3 + length)
+    if zlib.crc32(raw[:3 + length]) & 0xFFFFFFFF != crc:
+        raise ValueError("CRC mismatch")
+    return command, raw[3:3 + length]
+
+
+class FrameLink:
+    def __init__(self, port, timeout):
+        self.port = serial.Serial(port, baudrate=115200, timeout=timeout)
+        self.pending = bytearray()
+
+    def send(self, command, payload=b""):
+        self.port.write(encode_frame(command, payload))
+
+    def receive(self):
+        # Text and broken frames between the delimiters are skipped
+        while True:
+            while b"\x00" not in self.pending:
+                block = self.port.read(max(1, self.port.in_waiting))
+                if not block:
+                    raise TimeoutError("no answer from the board")
+                self.pending += block
+            data, _, rest = bytes(self.pending).partition(b"\x00")
+            self.pending = bytearray(rest)
+            if not data:
+                continue
+            try:
+                return decode_frame(data)
+            except ValueError as exc:
+                print("Skipped %d bytes: %s" % (len(data), exc))
+
+    def request(self, command, payload=b""):
+        self.send(command, payload)
+        answer, data = self.receive()
+        if answer == CMD_NAK:
+            reason = NAK_REASONS.get(data[0], "unknown command 0x%02X" % data[0]) if data else "?"
+            raise RuntimeError("NAK: %s" % reason)
+        if answer != (command | ANSWER):
+            raise RuntimeError("unexpected answer 0x%02X" % answer)
+        return data
+
+
+def cmd_ping(link, args):
+    start = time.perf_counter()
+    for _ in range(args.count):
+        payload = os.urandom(args.size)
+        if link.request(CMD_PING, payload) != payload:
+            print("Payload mismatch")
+            return 1
+    elapsed = time.perf_counter() - start
+    total = 2 * args.count * (args.size + 7)
+    print("%d pings of %d bytes in %.2f s: %.1f KB/s of frames (both ways)" %
+          (args.count, args.size, elapsed, total / elapsed / 1024))
+    return 0
+
+
+def cmd_led(link, args):
+    state = link.request(CMD_LED, bytes([{"off": 0, "on": 1, "toggle": 2}[args.state]]))
+    print("LED is %s" % ("on" if state[0] else "off"))
+    return 0
+
+
+def cmd_stats(link, args):
+    names = ("frames ok", "COBS errors", "length errors", "CRC errors", "dropped", "overruns")
+    values = struct.unpack("<6I", link.request(CMD_STATS))
+    for name, value in zip(names, values):
+        print("%-14s %lu" % (name, value))
+    return 0
+
+
+def cmd_crc(link, args):
+    payload = os.urandom(args.size)
+    hw_crc, sw_crc, hw_cycles, sw_cycles = struct.unpack("<4I", link.request(CMD_CRC, payload))
+    expected = zlib.crc32(payload) & 0xFFFFFFFF
+    print("zlib     0x%08X" % expected)
+    print("hardware 0x%08X  %6d cycles" % (hw_crc, hw_cycles))
+    print("software 0x%08X  %6d cycles" % (sw_crc, sw_cycles))
+    return 0 if hw_crc == sw_crc == expected else 1
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Framed protocol client")
+    parser.add_argument("port", help="serial port of the board (e.g. /dev/ttyACM0 or COM5)")
+    parser.add_argument("--timeout", type=float, default=1.0, help="seconds to wait for an answer")
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    ping = commands.add_parser("ping", help="send random payloads and check the echo")
+    ping.add_argument("--count", type=int, default=100)
+    ping.add_argument("--size", type=int, default=MAX_PAYLOAD)
+    ping.set_defaults(handler=cmd_ping)
+
+    led = commands.add_parser("led", help="switch the LED")
+    led.add_argument("state", choices=("on", "off", "toggle"))
+    led.set_defaults(handler=cmd_led)
+
+    stats = commands.add_parser("stats", help="print the receive counters of the board")
+    stats.set_defaults(handler=cmd_stats)
+
+    crc = commands.add_parser("crc", help="compare the hardware and software CRC-32 with zlib")
+    crc.add_argument("--size", type=int, default=MAX_PAYLOAD)
+    crc.set_defaults(handler=cmd_crc)
+
+    args = parser.parse_args()
+    if getattr(args, "size", 0) > MAX_PAYLOAD:
+        parser.error("the payload is limited to %d bytes" % MAX_PAYLOAD)
+
+    link = FrameLink(args.port, args.timeout)
+    try:
+        return args.handler(link, args)
+    except (RuntimeError, TimeoutError) as exc:
+        print(exc)
+        return 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,193 @@
+#!/usr/bin/env python3
+#
+# postmortem_decode.py
+#
+#  Created on: 19-Oct-2026
+#      Author: Rahul
+#
+# Decoder of the post-mortem dumps of PostMortem.c (inc/PostMortem.h), read from a console log.
+#
+# The last PM-BEGIN ... PM-END block of the log is checked (offsets of the PM-DATA lines, byte count and
+# CRC-32 of the header, the zlib one of Crc32.c), then:
+#   - the cause of the crash is printed (fault registers decoded for a HardFault)
+#   - the ring is decoded from its first sync (svtrace.py) and the last events before the freeze are printed
+#   - with -o, the ring from its first sync to its last whole packet is written as a .SVDat file for SystemView
+#
+# Usage:
+#   python3 postmortem_decode.py console.log [-o crash.SVDat] [--events 30]
+
+import argparse
+import sys
+import zlib
+
+import svtrace
+
+CFSR_BITS = [
+    (0, "IACCVIOL: instruction fetch from a protected region"),
+    (1, "DACCVIOL: data access to a protected region"),
+    (3, "MUNSTKERR: MemManage fault on exception return"),
+    (4, "MSTKERR: MemManage fault on exception entry"),
+    (5, "MLSPERR: MemManage fault on FPU lazy state preservation"),
+    (7, "MMARVALID: MMFAR holds the address"),
+    (8, "IBUSERR: bus error on instruction fetch"),
+    (9, "PRECISERR: precise data bus error"),
+    (10, "IMPRECISERR: imprecise data bus error (the PC is after the access)"),
+    (11, "UNSTKERR: bus fault on exception return"),
+    (12, "STKERR: bus fault on exception entry (stack overflow?)"),
+    (13, "LSPERR: bus fault on FPU lazy state preservation"),
+    (15, "BFARVALID: BFAR holds the address"),
+    (16, "UNDEFINSTR: undefined instruction"),
+    (17, "INVSTATE: invalid state (a branch to an even address?)"),
+    (18, "INVPC: invalid EXC_RETURN"),
+    (19, "NOCP: coprocessor access (FPU disabled?)"),
+    (24, "UNALIGNED: unaligned access"),
+    (25, "DIVBYZERO: division by zero"),
+]
+
+HFSR_BITS = [
+    (1, "VECTTBL: bus fault on a vector table read"),
+    (30, "FORCED: escalated from a configurable fault (see CFSR)"),
+    (31, "DEBUGEVT: debug event"),
+]
+
+
+class DumpError(Exception):
+    pass
+
+
+class Dump:
+    def __init__(self):
+        self.header = {}
+        self.fault = None
+        self.assertion = None
+        self.data = b""
+
+
+def fields(text):
+    """key=value items of a line. The last value (task=...) may hold spaces."""
+    result = {}
+    key = None
+    for item in text.split(" "):
+        if "=" in item:
+            key, value = item.split("=", 1)
+            result[key] = value
+        elif key is not None:
+            result[key] += " " + item
+    return result
+
+
+def read_dump(lines):
+    """Last complete dump of the log."""
+    begin = None
+    end = None
+    for index, line in enumerate(lines):
+        if line.startswith("PM-BEGIN"):
+            begin = index
+            end = None
+        elif line.startswith("PM-END") and begin is not None:
+            end = index
+    if begin is None:
+        if any(line.startswith("PM-NONE") for line in lines):
+            raise DumpError("the board had no capture (PM-NONE)")
+        raise DumpError("no PM-BEGIN in the log")
+    if end is None:
+        raise DumpError("the last dump has no PM-END (log cut?)")
+
+    dump = Dump()
+    dump.header = fields(lines[begin][len("PM-BEGIN "):])
+    data = bytearray()
+    for line in lines[begin + 1:end]:
+        if line.startswith("PM-FAULT"):
+            dump.fault = fields(line[len("PM-FAULT "):])
+        elif line.startswith("PM-ASSERT"):
+            dump.assertion = fields(line[len("PM-ASSERT "):])
+        elif line.startswith("PM-DATA"):
+            parts = line.split()
+            if len(parts) != 3:
+                raise DumpError("bad line: %s" % line)
+            offset = int(parts[1], 16)
+            if offset != len(data):
+                raise DumpError("missing bytes: line at 0x%X, expected 0x%X" % (offset, len(data)))
+            data += bytes.fromhex(parts[2])
+
+    expected = int(dump.header.get("bytes", "-1"))
+    if len(data) != expected:
+        raise DumpError("%u bytes in the dump, %d in its header" % (len(data), expected))
+    crc = zlib.crc32(bytes(data)) & 0xFFFFFFFF
+    if crc != int(dump.header.get("crc", "0"), 16):
+        raise DumpError("CRC-32 %08X, %s in the header: corrupted log" % (crc, dump.header.get("crc")))
+    dump.data = bytes(data)
+    return dump
+
+
+def print_bits(value, table, indent="    "):
+    for bit, text in table:
+        if value & (1 << bit):
+            print("%s%s" % (indent, text))
+
+
+def print_cause(dump):
+    print("Cause: %s (%s later crashes while held)" % (dump.header.get("reason"), dump.header.get("later", "0")))
+    if dump.fault is not None:
+        fault = dump.fault
+        print("  task %s, PC 0x%s, LR 0x%s, xPSR 0x%s" % (fault.get("task") or "-", fault["pc"], fault["lr"],
+                                                         fault["psr"]))
+        cfsr = int(fault["cfsr"], 16)
+        hfsr = int(fault["hfsr"], 16)
+        print("  CFSR 0x%08X, HFSR 0x%08X" % (cfsr, hfsr))
+        print_bits(cfsr, CFSR_BITS)
+        print_bits(hfsr, HFSR_BITS)
+        if cfsr & ((1 << 7) | (1 << 15)):
+            print("  fault address 0x%s" % fault["addr"])
+        print("  (arm-none-eabi-addr2line -e Applications.elf 0x%s 0x%s gives the source lines)" % (fault["pc"],
+                                                                                                     fault["lr"]))
+    if dump.assertion is not None:
+        print("  configASSERT() failed at %s:%s, task %s" % (dump.assertion["file"], dump.assertion["line"],
+                                                             dump.assertion.get("task") or "-"))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode a post-mortem dump of PostMortem.c")
+    parser.add_argument("log", help="console log holding the dump")
+    parser.add_argument("-o", "--output", help=".SVDat file to write")
+    parser.add_argument("--events", type=int, default=30, help="last events to print")
+    args = parser.parse_args()
+
+    with open(args.log, "r", errors="replace") as handle:
+        lines = [line.strip() for line in handle]
+
+    try:
+        dump = read_dump(lines)
+    except (DumpError, ValueError) as error:
+        print("%s: %s" % (args.log, error))
+        return 1
+
+    print_cause(dump)
+
+    sync = dump.data.find(svtrace.SYNC)
+    if sync < 0:
+        print("No sync in the %u bytes of the ring: nothing to decode" % len(dump.data))
+        return 1
+    trace = svtrace.parse(dump.data[sync:], strict=False)
+
+    print("Ring: %u bytes, %u skipped before the first sync, %u events" % (len(dump.data), sync, len(trace.events)))
+    if trace.events:
+        last = trace.events[-1].timestamp
+        print("  %.3f ms of trace before the freeze (%u syncs)" % (trace.seconds(last) * 1000, trace.syncs))
+        if trace.end < trace.size:
+            print("  decoding stopped %u bytes before the end" % (trace.size - trace.end))
+        for task_id in sorted(trace.tasks):
+            print("  task %-16s priority %u" % (trace.tasks[task_id], trace.priorities[task_id]))
+        print("Last events (ms before the freeze):")
+        for event in trace.events[-args.events:]:
+            print("%10.3f  %s" % (trace.seconds(last - event.timestamp) * 1000, svtrace.describe(trace, event)))
+
+    if args.output:
+        with open(args.output, "wb") as handle:
+            handle.write(dump.data[sync:sync + trace.end])
+        print("Wrote %s (%u bytes)" % (args.output, trace.end))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
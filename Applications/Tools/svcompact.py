@@ -0,0 +1,258 @@
+#!/usr/bin/env python3
+#
+# svcompact.py
+#
+#  Created on: 19-Oct-2026
+#      Author: Rahul
+#
+# Converter of the compact SystemView encoding (SEGGER_SYSVIEW_COMPACT_MODE 1 in SEGGER_SYSVIEW_Conf.h) to
+# the standard one, which SystemView opens.
+#
+# Compact encoding (SEGGER_SYSVIEW.c):
+#   - the task Ids of the task events are indices 1..MaxTasks, announced by Task Index packets
+#     (id 30: index, task Id, MaxTasks) when a task gets an index and with the task list of each sync.
+#     Values above MaxTasks are task Ids + MaxTasks + 1 (tasks beyond the indices).
+#   - the timestamps are in units of 2^SEGGER_SYSVIEW_COMPACT_TIMESTAMP_SHIFT cycles, SysFreq of the INIT packet too
+#   - the start (or idle) of the task which runs already is not sent again: after an interrupt which did not
+#     switch the task, the scheduler selects the same task and SystemView would show a switch to itself
+# decode replaces the indices with the task Ids and drops the Task Index packets. The timestamps keep their
+# resolution (SysFreq of the INIT packet matches it) and the repeated task starts are not restored: they carry
+# no information.
+#
+# measure encodes a standard recording the way SEGGER_SYSVIEW.c does in compact mode, checks that decode gives
+# the recording back (but the repeated task starts, and timestamps within 2^shift cycles), and prints the bytes
+# of both encodings, per second of recording and per context switch. A context switch is a change of the running
+# task (a task, or idle), as in svgate.py: the repeated task starts which compact mode drops are not switches, so
+# they do not lower the bytes per switch of the standard encoding.
+#
+# Usage:
+#   python3 svcompact.py decode compact.SVDat -o standard.SVDat
+#   python3 svcompact.py measure ../SEGGER_Mem_Dump/*.SVDat [--shift 4] [--max-tasks 16]
+
+import argparse
+import sys
+
+import svtrace
+from svtrace import (EVT_INIT, EVT_SYSTIME_CYCLES, EVT_TASK_START_EXEC, EVT_TASK_STOP_EXEC, EVT_TASK_START_READY,
+                     EVT_TASK_STOP_READY, EVT_TASK_CREATE, EVT_TASK_INFO, EVT_STACK_INFO, EVT_TASK_TERMINATE,
+                     EVT_TASK_INDEX, EVT_IDLE, EVT_ISR_TO_SCHEDULER, EVT_TRACE_START, EVT_OVERFLOW)
+
+# Events whose first value is a task Id
+TASK_EVENTS = (EVT_TASK_START_EXEC, EVT_TASK_START_READY, EVT_TASK_STOP_READY, EVT_TASK_CREATE, EVT_TASK_INFO,
+               EVT_STACK_INFO, EVT_TASK_TERMINATE)
+
+# Running task of the compact encoding (COMPACT_IDLE, COMPACT_NONE of SEGGER_SYSVIEW.c)
+IDLE = 0
+NONE = -1
+
+
+def packet_values(event):
+    """Values to encode again: None keeps the payload of a long packet."""
+    return event.values if (event.id < 24 or event.id in TASK_EVENTS) else None
+
+
+def decode(data, max_tasks=16):
+    """Standard stream of a compact stream, and the number of task Ids which had no index announced."""
+    trace = svtrace.parse(data)
+    out = bytearray(svtrace.SYNC)
+    indices = {}
+    unknown = 0
+    previous = 0
+
+    for event in trace.events:
+        if event.id == EVT_TASK_INDEX:
+            index, task_id, max_tasks = event.values[:3]
+            indices[index] = task_id
+            continue
+        values = event.values
+        if event.id in TASK_EVENTS:
+            value = values[0]
+            if value > max_tasks:
+                value -= max_tasks + 1
+            elif value in indices:
+                value = indices[value]
+            else:
+                unknown += 1
+            values = [value] + values[1:]
+        out += svtrace.encode_packet(event.id, values if event.id in TASK_EVENTS else packet_values(event),
+                                     event.text, event.raw, event.timestamp - previous)
+        previous = event.timestamp
+
+    return bytes(out), unknown
+
+
+class Encoder:
+    """Compact encoding of SEGGER_SYSVIEW.c, applied to a standard recording."""
+
+    def __init__(self, shift, max_tasks):
+        self.shift = shift
+        self.max_tasks = max_tasks
+        self.table = [0] * max_tasks
+        self.running = NONE
+        self.last = 0                   # Cycles of the last packet sent
+        self.out = bytearray(svtrace.SYNC)
+        self.skipped = 0
+
+    def send(self, event_id, values, text, raw, timestamp):
+        delta = (timestamp - self.last) >> self.shift
+        self.last += delta << self.shift
+        self.out += svtrace.encode_packet(event_id, values, text, raw, delta)
+
+    def task_id(self, task_id, announce, timestamp):
+        if task_id in self.table:
+            index = self.table.index(task_id) + 1
+        elif 0 in self.table:
+            index = self.table.index(0) + 1
+            self.table[index - 1] = task_id
+            announce = True
+        else:
+            return self.max_tasks + 1 + task_id
+        if announce:
+            self.send(EVT_TASK_INDEX, [index, task_id, self.max_tasks], None, b"", timestamp)
+        return index
+
+    def event(self, event):
+        values = packet_values(event)
+        timestamp = event.timestamp
+
+        if event.id in (EVT_TRACE_START, EVT_OVERFLOW):
+            self.running = NONE
+        elif event.id in (EVT_INIT, EVT_SYSTIME_CYCLES):
+            values = [event.values[0] >> self.shift] + event.values[1:]
+        elif event.id in TASK_EVENTS:
+            task_id = self.task_id(event.values[0], event.id == EVT_TASK_INFO, timestamp)
+            values = [task_id] + event.values[1:]
+            if event.id == EVT_TASK_START_EXEC:
+                if self.running == task_id:
+                    self.skipped += 1
+                    return
+                self.running = task_id
+        elif event.id == EVT_IDLE:
+            if self.running == IDLE:
+                self.skipped += 1
+                return
+            self.running = IDLE
+
+        self.send(event.id, values, event.text, event.raw, timestamp)
+
+        if event.id in (EVT_ISR_TO_SCHEDULER, EVT_TASK_STOP_EXEC):
+            self.running = NONE
+        elif event.id in (EVT_TASK_STOP_READY, EVT_TASK_TERMINATE) and self.running == values[0]:
+            self.running = NONE
+        if event.id == EVT_TASK_TERMINATE and values[0] <= self.max_tasks:
+            self.table[values[0] - 1] = 0
+
+
+def is_switch(event):
+    return event.id in (EVT_TASK_START_EXEC, EVT_IDLE)
+
+
+def real_switches(events):
+    """Changes of the running task (task Id or idle), as in svgate.py."""
+    switches = 0
+    last_running = None
+    for event in events:
+        if is_switch(event):
+            task = event.values[0] if event.id == EVT_TASK_START_EXEC else "idle"
+            if last_running is not None and task != last_running:
+                switches += 1
+            last_running = task
+    return switches
+
+
+def round_trip_errors(original, decoded, shift):
+    """Differences between a recording and decode(encode()) of it, but the repeated task starts."""
+    errors = 0
+    running = None
+    expected = []
+    for event in original.events:
+        if is_switch(event):
+            task = event.values[0] if event.id == EVT_TASK_START_EXEC else "idle"
+            if task == running:
+                continue
+            running = task
+        elif event.id in (EVT_TRACE_START, EVT_OVERFLOW, EVT_ISR_TO_SCHEDULER, EVT_TASK_STOP_EXEC):
+            running = None
+        elif event.id in (EVT_TASK_STOP_READY, EVT_TASK_TERMINATE) and event.values[0] == running:
+            running = None
+        expected.append(event)
+
+    if len(expected) != len(decoded.events):
+        return abs(len(expected) - len(decoded.events))
+    for before, after in zip(expected, decoded.events):
+        values = before.values
+        if before.id in (EVT_INIT, EVT_SYSTIME_CYCLES):
+            values = [values[0] >> shift] + values[1:]
+        if (before.id != after.id) or (values != after.values) or (before.text != after.text):
+            errors += 1
+        elif abs(before.timestamp - (after.timestamp << shift)) >= (1 << shift):
+            errors += 1
+    return errors
+
+
+def measure(name, data, shift, max_tasks):
+    original = svtrace.parse(data, strict=False)
+    if original.events:
+        # Without the zeros after the last packet (end of a memory dump)
+        last = original.events[-1]
+        data = data[:last.offset + last.size]
+    encoder = Encoder(shift, max_tasks)
+    for event in original.events:
+        encoder.event(event)
+    compact = bytes(encoder.out)
+    standard, unknown = decode(compact, max_tasks)
+    errors = round_trip_errors(original, svtrace.parse(standard), shift) + unknown
+
+    switches = real_switches(original.events)
+    duration = 0.0
+    if original.events:
+        duration = original.seconds(original.events[-1].timestamp - original.events[0].timestamp)
+    print("%s: %u events, %.3f s, %u context switches" % (name, len(original.events), duration, switches))
+    if switches == 0 or duration == 0:
+        return errors
+    print("  standard: %6u bytes, %8.1f bytes/s, %6.2f bytes per context switch"
+          % (len(data), len(data) / duration, len(data) / switches))
+    print("  compact:  %6u bytes, %8.1f bytes/s, %6.2f bytes per context switch (%.0f %% less, %u repeated task "
+          "starts not sent)" % (len(compact), len(compact) / duration, len(compact) / switches,
+                                100.0 * (len(data) - len(compact)) / len(data), encoder.skipped))
+    print("  round trip: %s" % ("OK" if errors == 0 else "%u differences" % errors))
+    return errors
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compact SystemView encoding of SEGGER_SYSVIEW.c")
+    commands = parser.add_subparsers(dest="command", required=True)
+    decode_parser = commands.add_parser("decode", help="convert a compact recording to a standard one")
+    decode_parser.add_argument("file")
+    decode_parser.add_argument("-o", "--output", required=True, help=".SVDat file to write")
+    measure_parser = commands.add_parser("measure", help="bytes per second and per context switch of "
+                                                         "standard recordings, in both encodings")
+    measure_parser.add_argument("files", nargs="+")
+    measure_parser.add_argument("--shift", type=int, default=4, help="SEGGER_SYSVIEW_COMPACT_TIMESTAMP_SHIFT")
+    measure_parser.add_argument("--max-tasks", type=int, default=16, help="SEGGER_SYSVIEW_COMPACT_MAX_TASKS")
+    args = parser.parse_args()
+
+    if args.command == "decode":
+        with open(args.file, "rb") as handle:
+            data = handle.read()
+        try:
+            standard, unknown = decode(data)
+        except svtrace.TraceError as error:
+            print("%s: %s" % (args.file, error))
+            return 1
+        with open(args.output, "wb") as handle:
+            handle.write(standard)
+        print("Wrote %s (%u bytes from %u)" % (args.output, len(standard), len(data)))
+        if unknown:
+            print("%u task events had an index without Task Index packet (kept as is)" % unknown)
+        return 0
+
+    errors = 0
+    for name in args.files:
+        with open(name, "rb") as handle:
+            errors += measure(name, handle.read(), args.shift, args.max_tasks)
+    return 1 if errors else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,279 @@
+#!/usr/bin/env python3
+#
+# svgate.py
+#
+#  Created on: 19-Oct-2026
+#      Author: Rahul
+#
+# Regression gate for the demos: compares a SystemView capture with a baseline (e.g. the recordings of
+# SEGGER_Mem_Dump) and fails when the capture is significantly worse.
+#
+# Both recordings are replayed (svtrace.py) to get:
+#   - the context switch rate: changes of the running task (a task, or idle), per second. The start of the
+#     task which runs already (scheduler after a SysTick) is not a switch, so compact recordings (svcompact.py)
+#     compare with standard ones.
+#   - the CPU of each task: time running, outside of the interrupts, in % of the recording
+#   - the duration of each interrupt: ISR enter to ISR exit (or exit to the scheduler), nested ones excluded
+#   - the wake latency of each task: task ready (unblocked) to task start
+# Tasks are aligned by name, interrupts by number.
+#
+# A metric is a regression when it is worse than the baseline by more than its threshold and the difference is
+# significant: one-sided Mann-Whitney U test (normal approximation) at --alpha, on the samples (interrupt
+# durations, latencies) or on the values of the --window ms windows (switch rate, CPU). With fewer than
+# --min-samples samples on a side, the threshold alone decides (marked "few").
+#
+# Exit code: 0 no regression, 1 regressions, 2 unreadable recording.
+#
+# Usage:
+#   python3 svgate.py ../SEGGER_Mem_Dump/TaskDelay.SVDat TaskDelay_new.SVDat [--switch-rate 10] [--cpu 5]
+#                     [--isr 20] [--latency 20] [--alpha 0.01] [--window 50] [--min-samples 5]
+
+import argparse
+import math
+import sys
+
+import svtrace
+from svtrace import (EVT_ISR_ENTER, EVT_ISR_EXIT, EVT_ISR_TO_SCHEDULER, EVT_TASK_START_EXEC, EVT_TASK_STOP_EXEC,
+                     EVT_TASK_START_READY, EVT_TASK_STOP_READY, EVT_IDLE)
+
+IDLE = "idle"
+
+
+class Profile:
+    """Metrics of a recording, times in seconds."""
+
+    def __init__(self, trace, window):
+        self.trace = trace
+        self.window = window
+        self.duration = 0.0
+        self.switches = 0
+        self.window_switches = []           # Switches per window
+        self.cpu = {}                       # Task name -> seconds running
+        self.window_cpu = []                # Per window: task name -> seconds running
+        self.isr = {}                       # Interrupt number -> durations
+        self.latency = {}                   # Task name -> wake latencies
+        self.replay()
+
+    def name(self, task_id):
+        return self.trace.task_name(task_id)
+
+    def account(self, context, start, end):
+        """Time of a context, split on the windows."""
+        if context is None or end <= start:
+            return
+        self.cpu[context] = self.cpu.get(context, 0.0) + end - start
+        while start < end:
+            index = int(start / self.window)
+            if (index + 1) * self.window <= start:
+                index += 1                  # Rounding of the window end
+            stop = min(end, (index + 1) * self.window)
+            while len(self.window_cpu) <= index:
+                self.window_cpu.append({})
+            self.window_cpu[index][context] = self.window_cpu[index].get(context, 0.0) + stop - start
+            start = stop
+
+    def switch(self, now):
+        self.switches += 1
+        index = int(now / self.window)
+        while len(self.window_switches) <= index:
+            self.window_switches.append(0)
+        self.window_switches[index] += 1
+
+    def replay(self):
+        events = self.trace.events
+        if not events:
+            return
+        origin = events[0].timestamp
+        seconds = self.trace.seconds
+        running = None                      # Task name or IDLE, None: scheduler / unknown
+        last_running = None                 # Last task or IDLE, for the switches
+        isr_stack = []                      # (number, start, time of the nested interrupts)
+        ready = {}                          # Task name -> time it became ready
+        previous = 0.0
+
+        for event in events:
+            now = seconds(event.timestamp - origin)
+            if not isr_stack:               # Interrupt time is not task time
+                self.account(running, previous, now)
+            previous = now
+
+            if event.id == EVT_ISR_ENTER:
+                isr_stack.append([event.values[0], now, 0.0])
+            elif event.id in (EVT_ISR_EXIT, EVT_ISR_TO_SCHEDULER) and isr_stack:
+                number, start, nested = isr_stack.pop()
+                self.isr.setdefault(number, []).append(now - start - nested)
+                if isr_stack:
+                    isr_stack[-1][2] += now - start
+                if event.id == EVT_ISR_TO_SCHEDULER:
+                    running = None
+            elif event.id in (EVT_TASK_START_EXEC, EVT_IDLE):
+                task = self.name(event.values[0]) if event.id == EVT_TASK_START_EXEC else IDLE
+                if last_running is not None and task != last_running:
+                    self.switch(now)
+                running = last_running = task
+                if task in ready:
+                    self.latency.setdefault(task, []).append(now - ready.pop(task))
+            elif event.id == EVT_TASK_STOP_EXEC:
+                running = None
+            elif event.id == EVT_TASK_START_READY:
+                ready.setdefault(self.name(event.values[0]), now)
+            elif event.id == EVT_TASK_STOP_READY:
+                ready.pop(self.name(event.values[0]), None)
+
+        self.duration = previous
+
+    def full_windows(self):
+        return int(self.duration / self.window)
+
+    def switch_samples(self):
+        count = self.full_windows()
+        samples = self.window_switches[:count] + [0] * (count - len(self.window_switches))
+        return [value / self.window for value in samples]
+
+    def cpu_samples(self, task):
+        count = self.full_windows()
+        return [100.0 * window.get(task, 0.0) / self.window for window in self.window_cpu[:count]]
+
+    def tasks(self):
+        return sorted(name for name in self.cpu if name != IDLE)
+
+
+def mann_whitney_greater(baseline, capture):
+    """One-sided p-value of the capture samples being greater than the baseline ones."""
+    n1 = len(baseline)
+    n2 = len(capture)
+    if n1 == 0 or n2 == 0:
+        return 1.0
+    values = sorted([(value, 0) for value in baseline] + [(value, 1) for value in capture])
+    rank_sum = 0.0
+    ties = 0.0
+    position = 0
+    while position < len(values):
+        end = position
+        while end + 1 < len(values) and values[end + 1][0] == values[position][0]:
+            end += 1
+        rank = (position + end) / 2.0 + 1.0
+        count = end - position + 1
+        ties += count ** 3 - count
+        rank_sum += rank * sum(1 for index in range(position, end + 1) if values[index][1] == 1)
+        position = end + 1
+    n = n1 + n2
+    u = rank_sum - n2 * (n2 + 1) / 2.0
+    variance = n1 * n2 / 12.0 * ((n + 1) - ties / (n * (n - 1)))
+    if variance <= 0:
+        return 1.0
+    z = (u - n1 * n2 / 2.0 - 0.5) / math.sqrt(variance)
+    return 0.5 * math.erfc(z / math.sqrt(2))
+
+
+def median(values):
+    ordered = sorted(values)
+    middle = len(ordered) // 2
+    if len(ordered) % 2:
+        return ordered[middle]
+    return (ordered[middle - 1] + ordered[middle]) / 2.0
+
+
+def percentile(values, fraction):
+    ordered = sorted(values)
+    return ordered[min(len(ordered) - 1, int(fraction * len(ordered)))]
+
+
+class Gate:
+    def __init__(self, args):
+        self.args = args
+        self.regressions = 0
+
+    def check(self, label, unit, before, after, worse, samples_before, samples_after):
+        """One metric. worse: True when the capture is beyond the threshold."""
+        few = min(len(samples_before), len(samples_after)) < self.args.min_samples
+        p = mann_whitney_greater(samples_before, samples_after)
+        significant = few or p < self.args.alpha
+        verdict = "REGRESSION" if (worse and significant) else "ok"
+        if verdict != "ok":
+            self.regressions += 1
+        change = "%+.1f %%" % (100.0 * (after - before) / before) if before else "-"
+        print("  %-34s %12.3f %12.3f %10s  %-7s %s" % ("%s (%s)" % (label, unit), before, after, change,
+                                                       "few" if few else "p=%.3f" % p, verdict))
+
+    def relative(self, before, after, threshold):
+        return after > before * (1.0 + threshold / 100.0)
+
+    def run(self, base, capture):
+        args = self.args
+        print("  %-34s %12s %12s %10s  %-7s %s" % ("metric", "baseline", "capture", "change", "test", "verdict"))
+
+        before = base.switches / base.duration if base.duration else 0.0
+        after = capture.switches / capture.duration if capture.duration else 0.0
+        self.check("context switches", "1/s", before, after, self.relative(before, after, args.switch_rate),
+                   base.switch_samples(), capture.switch_samples())
+
+        for task in sorted(set(base.tasks()) | set(capture.tasks())):
+            if task not in base.cpu or task not in capture.cpu:
+                print("  %-34s only in the %s" % ("task " + task, "baseline" if task in base.cpu else "capture"))
+                continue
+            before = 100.0 * base.cpu[task] / base.duration
+            after = 100.0 * capture.cpu[task] / capture.duration
+            self.check("CPU " + task, "%", before, after, after - before > args.cpu,
+                       base.cpu_samples(task), capture.cpu_samples(task))
+        if IDLE in base.cpu and IDLE in capture.cpu:
+            print("  %-34s %12.3f %12.3f" % ("CPU idle (%)", 100.0 * base.cpu[IDLE] / base.duration,
+                                              100.0 * capture.cpu[IDLE] / capture.duration))
+
+        for number in sorted(set(base.isr) & set(capture.isr)):
+            before = [value * 1e6 for value in base.isr[number]]
+            after = [value * 1e6 for value in capture.isr[number]]
+            name = base.trace.isr_name(number)
+            self.check("%s duration median" % name, "us", median(before), median(after),
+                       self.relative(median(before), median(after), args.isr), before, after)
+            print("  %-34s %12.3f %12.3f" % ("%s duration p95 (us)" % name, percentile(before, 0.95),
+                                              percentile(after, 0.95)))
+
+        for task in sorted(set(base.latency) & set(capture.latency)):
+            before = [value * 1e6 for value in base.latency[task]]
+            after = [value * 1e6 for value in capture.latency[task]]
+            self.check("wake latency %s median" % task, "us", median(before), median(after),
+                       self.relative(median(before), median(after), args.latency), before, after)
+
+
+def load(name, window):
+    with open(name, "rb") as handle:
+        trace = svtrace.parse(handle.read(), strict=False)
+    if not trace.sys_freq or not trace.events:
+        raise svtrace.TraceError("no INIT packet or no events")
+    return Profile(trace, window)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare a SystemView capture with a baseline")
+    parser.add_argument("baseline")
+    parser.add_argument("capture")
+    parser.add_argument("--switch-rate", type=float, default=10.0, help="%% more context switches per second")
+    parser.add_argument("--cpu", type=float, default=5.0, help="percentage points more CPU for a task")
+    parser.add_argument("--isr", type=float, default=20.0, help="%% longer median interrupt duration")
+    parser.add_argument("--latency", type=float, default=20.0, help="%% longer median wake latency")
+    parser.add_argument("--alpha", type=float, default=0.01, help="significance level of the test")
+    parser.add_argument("--window", type=float, default=50.0, help="ms per window of the rate and CPU samples")
+    parser.add_argument("--min-samples", type=int, default=5, help="fewer samples: the threshold alone decides")
+    args = parser.parse_args()
+
+    profiles = []
+    for name in (args.baseline, args.capture):
+        try:
+            profiles.append(load(name, args.window / 1000.0))
+        except (OSError, svtrace.TraceError) as error:
+            print("%s: %s" % (name, error))
+            return 2
+        profile = profiles[-1]
+        print("%-9s %s: %.3f s, %u events, %u context switches" % ("Baseline" if len(profiles) == 1 else "Capture",
+                                                                 name, profile.duration, len(profile.trace.events),
+                                                                 profile.switches))
+
+    gate = Gate(args)
+    gate.run(profiles[0], profiles[1])
+    print("%u regressions" % gate.regressions)
+    return 1 if gate.regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,350 @@
+#!/usr/bin/env python3
+#
+# svtrace.py
+#
+#  Created on: 19-Oct-2026
+#      Author: Rahul
+#
+# Reader of the SEGGER SystemView recordings (the .SVDat files of SEGGER_Mem_Dump, the RTT stream of
+# SEGGER_SYSVIEW.c V2.52d). Used as a module by the other trace tools, or alone to print a summary.
+#
+# Stream: a sync (10 * 0x00), then packets. A packet is:
+#   id < 24:  | id (1) | payload (fixed layout per id) | timestamp delta |
+#   id >= 24: | id (varint) | length (varint) | payload (length bytes) | timestamp delta |
+# Integers are varints (7 bits per byte, low bits first, bit 7 set when a byte follows). A string is a
+# length byte (255: 2 bytes of length follow) and the characters. The timestamp delta is in cycles of the
+# timestamp source (SysFreq of the INIT packet) since the previous packet. Task Ids are
+# (address - RAM base) >> Id shift (INIT packet).
+#
+# Usage:
+#   python3 svtrace.py ../SEGGER_Mem_Dump/TaskDelay.SVDat [--events 40]
+
+import argparse
+import sys
+
+EVT_NOP = 0
+EVT_OVERFLOW = 1
+EVT_ISR_ENTER = 2
+EVT_ISR_EXIT = 3
+EVT_TASK_START_EXEC = 4
+EVT_TASK_STOP_EXEC = 5
+EVT_TASK_START_READY = 6
+EVT_TASK_STOP_READY = 7
+EVT_TASK_CREATE = 8
+EVT_TASK_INFO = 9
+EVT_TRACE_START = 10
+EVT_TRACE_STOP = 11
+EVT_SYSTIME_CYCLES = 12
+EVT_SYSTIME_US = 13
+EVT_SYSDESC = 14
+EVT_USER_START = 15
+EVT_USER_STOP = 16
+EVT_IDLE = 17
+EVT_ISR_TO_SCHEDULER = 18
+EVT_TIMER_ENTER = 19
+EVT_TIMER_EXIT = 20
+EVT_STACK_INFO = 21
+EVT_MODULEDESC = 22
+EVT_INIT = 24
+EVT_NAME_RESOURCE = 25
+EVT_PRINT_FORMATTED = 26
+EVT_NUMMODULES = 27
+EVT_END_CALL = 28
+EVT_TASK_TERMINATE = 29
+EVT_TASK_INDEX = 30                 # Compact encoding of SEGGER_SYSVIEW.c: index, task Id, number of indices
+EVT_API_OFFSET = 32                 # apiID_OFFSET of SEGGER_SYSVIEW_FreeRTOS.h
+
+SYNC = bytes(10)
+
+# Layout of the short packets: number of integers, then a string or not
+SHORT_LAYOUT = {
+    EVT_OVERFLOW: (1, False),
+    EVT_ISR_ENTER: (1, False),
+    EVT_ISR_EXIT: (0, False),
+    EVT_TASK_START_EXEC: (1, False),
+    EVT_TASK_STOP_EXEC: (0, False),
+    EVT_TASK_START_READY: (1, False),
+    EVT_TASK_STOP_READY: (2, False),
+    EVT_TASK_CREATE: (1, False),
+    EVT_TASK_INFO: (2, True),
+    EVT_TRACE_START: (0, False),
+    EVT_TRACE_STOP: (0, False),
+    EVT_SYSTIME_CYCLES: (1, False),
+    EVT_SYSTIME_US: (2, False),
+    EVT_SYSDESC: (0, True),
+    EVT_USER_START: (1, False),
+    EVT_USER_STOP: (1, False),
+    EVT_IDLE: (0, False),
+    EVT_ISR_TO_SCHEDULER: (0, False),
+    EVT_TIMER_ENTER: (1, False),
+    EVT_TIMER_EXIT: (0, False),
+    EVT_STACK_INFO: (4, False),
+    EVT_MODULEDESC: (2, True),
+}
+
+EVENT_NAMES = {
+    EVT_OVERFLOW: "overflow", EVT_ISR_ENTER: "isr enter", EVT_ISR_EXIT: "isr exit",
+    EVT_TASK_START_EXEC: "task start exec", EVT_TASK_STOP_EXEC: "task stop exec",
+    EVT_TASK_START_READY: "task ready", EVT_TASK_STOP_READY: "task blocked", EVT_TASK_CREATE: "task create",
+    EVT_TASK_INFO: "task info", EVT_TRACE_START: "trace start", EVT_TRACE_STOP: "trace stop",
+    EVT_SYSTIME_CYCLES: "systime", EVT_SYSTIME_US: "systime", EVT_SYSDESC: "sysdesc",
+    EVT_USER_START: "user start", EVT_USER_STOP: "user stop", EVT_IDLE: "idle",
+    EVT_ISR_TO_SCHEDULER: "isr exit to scheduler", EVT_TIMER_ENTER: "timer enter", EVT_TIMER_EXIT: "timer exit",
+    EVT_STACK_INFO: "stack info", EVT_MODULEDESC: "module", EVT_INIT: "init",
+    EVT_NAME_RESOURCE: "name resource", EVT_PRINT_FORMATTED: "print", EVT_NUMMODULES: "modules",
+    EVT_END_CALL: "end call", EVT_TASK_TERMINATE: "task terminate", EVT_TASK_INDEX: "task index",
+}
+
+
+class TraceError(Exception):
+    pass
+
+
+class Event:
+    def __init__(self, offset, event_id, values, text, timestamp, raw=b"", size=0):
+        self.offset = offset            # Offset of the packet in the stream
+        self.size = size                # Bytes of the packet
+        self.id = event_id
+        self.values = values            # Integers of the payload
+        self.text = text                # String of the payload (or None)
+        self.timestamp = timestamp      # Cycles since the first packet
+        self.raw = raw                  # Payload of a long packet (id >= 24)
+
+    def name(self):
+        if self.id >= EVT_API_OFFSET:
+            return "api %u" % (self.id - EVT_API_OFFSET)
+        return EVENT_NAMES.get(self.id, "event %u" % self.id)
+
+
+class Trace:
+    def __init__(self):
+        self.events = []
+        self.sys_freq = 0
+        self.cpu_freq = 0
+        self.ram_base = 0
+        self.id_shift = 0
+        self.sysdesc = []
+        self.tasks = {}                 # Task Id -> name
+        self.priorities = {}            # Task Id -> priority
+        self.isr_names = {}             # Interrupt number -> name (I#n=name of the system description)
+        self.syncs = 0
+        self.size = 0
+        self.end = 0                    # Offset where the decoding stopped (size if it went through)
+
+    def task_name(self, task_id):
+        return self.tasks.get(task_id, "0x%X" % self.task_address(task_id))
+
+    def task_address(self, task_id):
+        return self.ram_base + (task_id << self.id_shift)
+
+    def isr_name(self, number):
+        return self.isr_names.get(number, "ISR %u" % number)
+
+    def seconds(self, cycles):
+        return cycles / self.sys_freq if self.sys_freq else 0.0
+
+
+def read_varint(data, position):
+    value = 0
+    shift = 0
+    while True:
+        if position >= len(data):
+            raise TraceError("varint past the end at %u" % position)
+        byte = data[position]
+        position += 1
+        value |= (byte & 0x7F) << shift
+        if byte & 0x80 == 0:
+            return value, position
+        shift += 7
+        if shift > 35:
+            raise TraceError("varint too long at %u" % position)
+
+
+def read_string(data, position):
+    if position >= len(data):
+        raise TraceError("string past the end at %u" % position)
+    length = data[position]
+    position += 1
+    if length == 255:
+        length = data[position] | (data[position + 1] << 8)
+        position += 2
+    if position + length > len(data):
+        raise TraceError("string past the end at %u" % position)
+    return data[position:position + length].decode("latin-1"), position + length
+
+
+def encode_varint(value):
+    out = bytearray()
+    while value > 0x7F:
+        out.append((value & 0x7F) | 0x80)
+        value >>= 7
+    out.append(value)
+    return bytes(out)
+
+
+def encode_string(text):
+    raw = text.encode("latin-1")
+    if len(raw) < 255:
+        return bytes([len(raw)]) + raw
+    return bytes([255, len(raw) & 0xFF, len(raw) >> 8]) + raw
+
+
+def encode_packet(event_id, values, text, raw, delta):
+    """Bytes of a packet. A long packet (id >= 24) takes its payload from raw if values is None."""
+    if event_id < 24:
+        out = bytes([event_id]) + b"".join(encode_varint(value) for value in values)
+        if text is not None:
+            out += encode_string(text)
+    else:
+        payload = raw if values is None else b"".join(encode_varint(value) for value in values)
+        out = encode_varint(event_id) + encode_varint(len(payload)) + payload
+    return out + encode_varint(delta)
+
+
+def long_values(raw):
+    """Integers of a long payload (the OS API events are only integers)."""
+    values = []
+    position = 0
+    while position < len(raw):
+        value, position = read_varint(raw, position)
+        values.append(value)
+    return values
+
+
+def find_sync(data, start=0):
+    """Offset just after the first sync at or after start, or -1."""
+    position = data.find(SYNC, start)
+    if position < 0:
+        return -1
+    position += len(SYNC)
+    while position < len(data) and data[position] == 0:
+        position += 1
+    return position
+
+
+def parse(data, strict=True):
+    """Trace of a stream. It starts at the first sync: bytes before it are skipped (e.g. the oldest,
+    partly overwritten packet of a ring). strict=False stops at the first bad packet instead of raising."""
+    trace = Trace()
+    trace.size = len(data)
+    position = find_sync(data)
+    if position < 0:
+        raise TraceError("no sync in the stream")
+    trace.syncs = 1
+    timestamp = 0
+
+    while position < len(data):
+        start = position
+        try:
+            if data[position] == 0:
+                # Sync (or its tail)
+                if data.startswith(SYNC, position):
+                    position = find_sync(data, position)
+                    if position < len(data):
+                        trace.syncs += 1
+                else:
+                    position += 1
+                continue
+
+            event_id, position = read_varint(data, position)
+            values = []
+            text = None
+            raw = b""
+            if event_id < 24:
+                if event_id not in SHORT_LAYOUT:
+                    raise TraceError("unknown event %u at %u" % (event_id, start))
+                count, has_text = SHORT_LAYOUT[event_id]
+                for _ in range(count):
+                    value, position = read_varint(data, position)
+                    values.append(value)
+                if has_text:
+                    text, position = read_string(data, position)
+            else:
+                length, position = read_varint(data, position)
+                if position + length > len(data):
+                    raise TraceError("packet past the end at %u" % start)
+                raw = bytes(data[position:position + length])
+                position += length
+                if event_id in (EVT_NAME_RESOURCE,):
+                    values = [read_varint(raw, 0)[0]]
+                    text = read_string(raw, read_varint(raw, 0)[1])[0]
+                elif event_id == EVT_PRINT_FORMATTED:
+                    text, _ = read_string(raw, 0)
+                else:
+                    values = long_values(raw)
+            delta, position = read_varint(data, position)
+        except (TraceError, IndexError, UnicodeDecodeError):
+            if strict:
+                raise
+            position = start
+            break
+
+        timestamp += delta
+        event = Event(start, event_id, values, text, timestamp, raw, position - start)
+        trace.events.append(event)
+        _track(trace, event)
+
+    trace.end = position
+    return trace
+
+
+def _track(trace, event):
+    if event.id == EVT_INIT and len(event.values) >= 4:
+        trace.sys_freq, trace.cpu_freq, trace.ram_base, trace.id_shift = event.values[:4]
+    elif event.id == EVT_TASK_INFO:
+        trace.tasks[event.values[0]] = event.text
+        trace.priorities[event.values[0]] = event.values[1]
+    elif event.id == EVT_SYSDESC:
+        trace.sysdesc.append(event.text)
+        for item in event.text.split(","):
+            if item.startswith("I#") and "=" in item:
+                number, name = item[2:].split("=", 1)
+                if number.isdigit():
+                    trace.isr_names[int(number)] = name
+
+
+def describe(trace, event):
+    """One line for an event."""
+    name = event.name()
+    if event.id in (EVT_TASK_START_EXEC, EVT_TASK_START_READY, EVT_TASK_CREATE, EVT_TASK_STOP_READY,
+                    EVT_TASK_INFO, EVT_TASK_TERMINATE):
+        detail = trace.task_name(event.values[0])
+        if event.id == EVT_TASK_STOP_READY:
+            detail += " (cause %u)" % event.values[1]
+        if event.id == EVT_TASK_INFO:
+            detail += " (priority %u)" % event.values[1]
+    elif event.id == EVT_ISR_ENTER:
+        detail = trace.isr_name(event.values[0])
+    elif event.text is not None:
+        detail = event.text
+    else:
+        detail = " ".join("%u" % value for value in event.values)
+    return ("%-22s %s" % (name, detail)).rstrip()
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Summary of a SystemView recording")
+    parser.add_argument("file")
+    parser.add_argument("--events", type=int, default=0, help="print the last EVENTS events")
+    args = parser.parse_args()
+
+    with open(args.file, "rb") as handle:
+        data = handle.read()
+    try:
+        trace = parse(data)
+    except TraceError as error:
+        print("%s: %s" % (args.file, error))
+        return 1
+
+    duration = trace.events[-1].timestamp if trace.events else 0
+    print("%s: %u bytes, %u events, %u syncs, %.3f s at %u Hz" % (args.file, trace.size, len(trace.events),
+                                                               trace.syncs, trace.seconds(duration), trace.sys_freq))
+    for task_id in sorted(trace.tasks):
+        print("  task %-16s priority %u" % (trace.tasks[task_id], trace.priorities[task_id]))
+    for event in trace.events[-args.events:] if args.events > 0 else []:
+        print("%12.6f  %s" % (trace.seconds(event.timestamp), describe(trace, event)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,91 @@
+/*
+ * AdcSampler.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * Continuous sampling of one analog input. TIM2 triggers the conversions of ADC1 at the sample rate, and
+ * DMA1 channel 1 writes the samples in a circular buffer of two blocks (ping-pong). When a block is full
+ * (half transfer and transfer complete interrupts), the consumer task is woken up and gets a pointer to
+ * the block in the DMA buffer: the samples are not copied. The consumer has to finish with the block
+ * before the DMA has filled the other one (one block period), see xAdcSamplerBlockIntact().
+ *
+ * vAdcReduce() decimates a block (average of groups of samples) and computes its minimum, maximum and sum
+ * with the DSP instructions of the Cortex-M4, two samples at a time.
+ */
+
+#ifndef ADCSAMPLER_H_
+#define ADCSAMPLER_H_
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+//Analog input: PC0, ADC1 channel 1 (A0 of the Arduino connector of the Nucleo board)
+#define ADC_SAMPLER_CHANNEL				ADC_CHANNEL_1
+#define ADC_SAMPLER_GPIO_PORT			GPIOC
+#define ADC_SAMPLER_GPIO_PIN			GPIO_PIN_0
+
+//Samples of one block (even). The DMA buffer has two blocks.
+#define ADC_SAMPLER_BLOCK_SIZE			256
+
+//Task notification index used to wake up the consumer task (a task waits for one driver at a time)
+#define ADC_SAMPLER_NOTIFY_INDEX		2
+
+//Priority of the DMA interrupt. It should be less than or equal to configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY.
+#define ADC_SAMPLER_IRQ_PRIORITY		5
+
+//Largest decimation of vAdcReduce() (12 bit samples: the sum of 8 samples fits in a signed half word)
+#define ADC_MAX_DECIMATION				16
+
+//One block of samples, in the DMA buffer
+typedef struct AdcBlock
+{
+	const uint16_t *pusSamples;
+	size_t xLength;
+	uint32_t ulSequence;				//Number of the block since the start (1 for the first one)
+	uint32_t ulMissed;					//Blocks lost before this one (the consumer was late)
+}AdcBlock_t;
+
+//Reductions of a block
+typedef struct AdcStats
+{
+	uint16_t usMin;
+	uint16_t usMax;
+	uint32_t ulSum;
+}AdcStats_t;
+
+/*
+ * Initializes TIM2, ADC1 (with its calibration), DMA1 channel 1 and the analog input.
+ * Returns pdFAIL if the ADC could not be initialized.
+ */
+BaseType_t xAdcSamplerInit(void);
+
+/*
+ * Starts the sampling at ulSampleRate samples per second. The calling task is the consumer:
+ * it is notified at the end of each block. Not from an interrupt.
+ */
+BaseType_t xAdcSamplerStart(uint32_t ulSampleRate);
+void vAdcSamplerStop(void);
+
+/*
+ * Blocks the consumer task until the next block is full, and gives the last full block.
+ * Returns pdFAIL if no block is full after xTicksToWait.
+ */
+BaseType_t xAdcSamplerWaitBlock(AdcBlock_t *pxBlock, TickType_t xTicksToWait);
+
+//pdTRUE if the DMA has not started to write the block again (the data read from it is valid)
+BaseType_t xAdcSamplerBlockIntact(const AdcBlock_t *pxBlock);
+
+//CPU cycles spent in the DMA interrupt since the start
+uint32_t ulAdcSamplerInterruptCycles(void);
+
+/*
+ * Minimum, maximum and sum of xLength samples (even), and the average of each group of ucDecimation samples
+ * in pusOutput (xLength / ucDecimation samples). ucDecimation: 2, 4, 8 or 16; with 1, pusOutput is not used.
+ * The samples must be 12 bit values, and pusSamples word aligned (the blocks of the sampler are).
+ */
+void vAdcReduce(const uint16_t *pusSamples, size_t xLength, uint8_t ucDecimation, uint16_t *pusOutput, AdcStats_t *pxStats);
+
+#endif /* ADCSAMPLER_H_ */
@@ -0,0 +1,92 @@
+/*
+ * AesEngine.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * AES-CTR (streaming) and AES-GCM (one shot) encryption with the AES1 unit of the MCU.
+ * Large buffers are moved in and out of the AES unit by DMA (DMA2 channels 2 and 3) while the calling
+ * task is blocked, so the CPU is free for the other tasks. The AES unit is shared by the tasks with a mutex.
+ *
+ * The software AES of AesSoft.c gives the same results. It is used when the AES unit is not initialized,
+ * when its self test fails, or when AES_ENGINE_USE_HARDWARE is 0.
+ *
+ * The counter of CTR is the last 32 bits of the counter block (big endian), incremented modulo 2^32
+ * like the AES unit does. GCM only supports the 96 bit IV.
+ */
+
+#ifndef AESENGINE_H_
+#define AESENGINE_H_
+
+#include "FreeRTOS.h"
+#include "AesSoft.h"
+
+//0: always use the software AES (e.g. when the AES unit or the DMA channels are used by something else)
+#define AES_ENGINE_USE_HARDWARE			1
+
+//Buffers of at least this size are moved by DMA. Below it the CPU writes and reads the AES unit.
+#define AES_ENGINE_DMA_THRESHOLD		64
+
+//CTR buffers which are not word aligned are processed in pieces of this size in an aligned buffer
+#define AES_ENGINE_BOUNCE_SIZE			256
+
+//Task notification index used to wait for the end of the DMA transfers (a task waits for one driver at a time)
+#define AES_ENGINE_NOTIFY_INDEX			2
+
+//Priority of the DMA interrupts. It should be less than or equal to configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY.
+#define AES_ENGINE_DMA_IRQ_PRIORITY		5
+
+#define AES_GCM_IV_SIZE					12
+#define AES_GCM_TAG_SIZE				16
+#define AES_GCM_MAX_LENGTH				0xFFF0
+
+//The AES unit writes the last block of GCM in full: the output buffer must have room for this size
+#define AES_OUTPUT_SIZE(length)			( ((length) + AES_BLOCK_SIZE - 1) & ~(AES_BLOCK_SIZE - 1) )
+
+//State of a CTR stream. One context per stream (per task); the contexts are not shared.
+typedef struct AesCtrContext
+{
+	uint32_t ulKey[8];						//Key in the word format of the AES unit
+	uint8_t ucKeyLength;					//16 or 32 bytes
+	uint8_t ucCounter[AES_BLOCK_SIZE];		//Next counter block
+	uint8_t ucKeystream[AES_BLOCK_SIZE];	//Key stream of the last partial block
+	uint8_t ucKeystreamUsed;				//Bytes of ucKeystream already used (AES_BLOCK_SIZE: none left)
+	AesSoftKey_t xSoftKey;
+}AesCtrContext_t;
+
+/*
+ * Initializes the AES unit and its DMA channels, and checks the hardware against the NIST test vectors.
+ * Returns pdFAIL if the software AES has to be used.
+ */
+BaseType_t xAesEngineInit(void);
+
+//pdTRUE: hardware (if its self test passed), pdFALSE: software. Used to compare both.
+void vAesEngineUseHardware(BaseType_t xUseHardware);
+BaseType_t xAesEngineIsHardware(void);
+
+//Starts a CTR stream with a key of 16 or 32 bytes and the first counter block
+void vAesCtrStart(AesCtrContext_t *pxContext, const uint8_t *pucKey, size_t xKeyLength, const uint8_t *pucCounter);
+
+/*
+ * Encrypts (or decrypts, it is the same operation) the next xLength bytes of the stream.
+ * pucInput and pucOutput can be the same buffer. Not from an interrupt.
+ */
+BaseType_t xAesCtrProcess(AesCtrContext_t *pxContext, const uint8_t *pucInput, uint8_t *pucOutput, size_t xLength);
+
+/*
+ * GCM encryption of xLength bytes (at most AES_GCM_MAX_LENGTH) with the additional data pucAad (authenticated,
+ * not encrypted). pucOutput must have room for AES_OUTPUT_SIZE(xLength) bytes. Not from an interrupt.
+ * The AES unit is used if the buffers are word aligned and xAadLength is a multiple of 4.
+ */
+BaseType_t xAesGcmEncrypt(const uint8_t *pucKey, size_t xKeyLength, const uint8_t *pucIV,
+						  const uint8_t *pucAad, size_t xAadLength,
+						  const uint8_t *pucInput, uint8_t *pucOutput, size_t xLength, uint8_t *pucTag);
+
+//GCM decryption. Returns pdFAIL (and clears the output) if the tag does not match.
+BaseType_t xAesGcmDecrypt(const uint8_t *pucKey, size_t xKeyLength, const uint8_t *pucIV,
+						  const uint8_t *pucAad, size_t xAadLength,
+						  const uint8_t *pucInput, uint8_t *pucOutput, size_t xLength, const uint8_t *pucTag);
+
+#endif /* AESENGINE_H_ */
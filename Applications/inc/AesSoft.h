@@ -0,0 +1,40 @@
+/*
+ * AesSoft.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * Software AES-128/256 block encryption and GCM multiplication, without lookup tables.
+ * The S-box is computed (inverse in GF(2^8) and affine transform) on the 4 bytes of a column at once,
+ * so there is no table in flash or RAM and no memory access which depends on the key or the data.
+ * It does not use the HAL, so it also builds on the host (e.g. to check the test vectors).
+ *
+ * Only the encryption is needed: CTR and GCM decrypt with the encryption of the counter blocks.
+ */
+
+#ifndef AESSOFT_H_
+#define AESSOFT_H_
+
+#include "stdint.h"
+#include "stddef.h"
+
+#define AES_BLOCK_SIZE			16
+
+typedef struct AesSoftKey
+{
+	uint32_t ulRoundKeys[60];		//4 * (rounds + 1) words
+	uint8_t ucRounds;				//10 (AES-128) or 14 (AES-256)
+}AesSoftKey_t;
+
+//Key expansion. xKeyLength is 16 or 32 bytes.
+void vAesSoftSetKey(AesSoftKey_t *pxKey, const uint8_t *pucKey, size_t xKeyLength);
+
+//Encrypts one block. pucInput and pucOutput can be the same buffer.
+void vAesSoftEncryptBlock(const AesSoftKey_t *pxKey, const uint8_t *pucInput, uint8_t *pucOutput);
+
+//pucX = pucX * pucH in GF(2^128) with the GCM bit order (GHASH step)
+void vAesSoftGcmMultiply(uint8_t *pucX, const uint8_t *pucH);
+
+#endif /* AESSOFT_H_ */
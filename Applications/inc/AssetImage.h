@@ -0,0 +1,83 @@
+/*
+ * AssetImage.h
+ *
+ * Generated by Tools/asset_pack.py: do not edit.
+ */
+
+#ifndef ASSETIMAGE_H_
+#define ASSETIMAGE_H_
+
+#include <stdint.h>
+
+#define ASSET_IMAGE_SIZE		1040
+
+static const uint8_t ucAssetImage[ASSET_IMAGE_SIZE] __attribute__((aligned(8))) =
+{
+	0x41, 0x53, 0x53, 0x54, 0x01, 0x00, 0x03, 0x00, 0x10, 0x04, 0x00, 0x00, 0xBD, 0x34, 0xC4, 0x5C,
+	0x68, 0x65, 0x6C, 0x70, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x70, 0x00, 0x00, 0x00, 0xC2, 0x00, 0x00, 0x00, 0x42, 0x29, 0x02, 0x0D, 0x01, 0x00, 0x00, 0x00,
+	0x6D, 0x65, 0x6E, 0x75, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x38, 0x01, 0x00, 0x00, 0xD5, 0x00, 0x00, 0x00, 0xA9, 0x2B, 0x2B, 0x25, 0x01, 0x00, 0x00, 0x00,
+	0x73, 0x69, 0x6E, 0x65, 0x5F, 0x71, 0x31, 0x35, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x10, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x73, 0x07, 0x0A, 0x39, 0x00, 0x00, 0x00, 0x00,
+	0x54, 0x68, 0x65, 0x20, 0x61, 0x73, 0x73, 0x65, 0x74, 0x73, 0x20, 0x61, 0x72, 0x65, 0x20, 0x72,
+	0x65, 0x61, 0x64, 0x20, 0x69, 0x6E, 0x20, 0x70, 0x6C, 0x61, 0x63, 0x65, 0x20, 0x69, 0x6E, 0x20,
+	0x74, 0x68, 0x65, 0x20, 0x51, 0x53, 0x50, 0x49, 0x20, 0x66, 0x6C, 0x61, 0x73, 0x68, 0x2C, 0x20,
+	0x6D, 0x61, 0x70, 0x70, 0x65, 0x64, 0x20, 0x61, 0x74, 0x20, 0x30, 0x78, 0x39, 0x30, 0x30, 0x30,
+	0x30, 0x30, 0x30, 0x30, 0x3A, 0x0D, 0x0A, 0x6E, 0x6F, 0x20, 0x63, 0x6F, 0x70, 0x79, 0x20, 0x69,
+	0x6E, 0x20, 0x52, 0x41, 0x4D, 0x2C, 0x20, 0x61, 0x6E, 0x64, 0x20, 0x6E, 0x6F, 0x20, 0x69, 0x6E,
+	0x74, 0x65, 0x72, 0x6E, 0x61, 0x6C, 0x20, 0x66, 0x6C, 0x61, 0x73, 0x68, 0x20, 0x75, 0x73, 0x65,
+	0x64, 0x20, 0x66, 0x6F, 0x72, 0x20, 0x74, 0x68, 0x65, 0x6D, 0x2E, 0x0D, 0x0A, 0x50, 0x61, 0x63,
+	0x6B, 0x20, 0x6E, 0x65, 0x77, 0x20, 0x6F, 0x6E, 0x65, 0x73, 0x20, 0x77, 0x69, 0x74, 0x68, 0x20,
+	0x54, 0x6F, 0x6F, 0x6C, 0x73, 0x2F, 0x61, 0x73, 0x73, 0x65, 0x74, 0x5F, 0x70, 0x61, 0x63, 0x6B,
+	0x2E, 0x70, 0x79, 0x2C, 0x20, 0x74, 0x68, 0x65, 0x6E, 0x20, 0x70, 0x72, 0x6F, 0x67, 0x72, 0x61,
+	0x6D, 0x20, 0x74, 0x68, 0x65, 0x20, 0x63, 0x6F, 0x6E, 0x74, 0x61, 0x69, 0x6E, 0x65, 0x72, 0x2E,
+	0x0D, 0x0A, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x0D, 0x0A, 0x4C, 0x45, 0x44, 0x5F, 0x4F, 0x4E,
+	0x09, 0x09, 0x09, 0x2D, 0x2D, 0x2D, 0x3E, 0x20, 0x31, 0x0D, 0x0A, 0x4C, 0x45, 0x44, 0x5F, 0x4F,
+	0x46, 0x46, 0x09, 0x09, 0x09, 0x2D, 0x2D, 0x2D, 0x3E, 0x20, 0x32, 0x0D, 0x0A, 0x4C, 0x45, 0x44,
+	0x5F, 0x54, 0x4F, 0x47, 0x47, 0x4C, 0x45, 0x09, 0x09, 0x2D, 0x2D, 0x2D, 0x3E, 0x20, 0x33, 0x0D,
+	0x0A, 0x4C, 0x45, 0x44, 0x5F, 0x54, 0x4F, 0x47, 0x47, 0x4C, 0x45, 0x5F, 0x4F, 0x46, 0x46, 0x09,
+	0x09, 0x2D, 0x2D, 0x2D, 0x3E, 0x20, 0x34, 0x0D, 0x0A, 0x4C, 0x45, 0x44, 0x5F, 0x52, 0x45, 0x41,
+	0x44, 0x5F, 0x53, 0x54, 0x41, 0x54, 0x55, 0x53, 0x09, 0x09, 0x2D, 0x2D, 0x2D, 0x3E, 0x20, 0x35,
+	0x0D, 0x0A, 0x52, 0x54, 0x43, 0x5F, 0x50, 0x52, 0x49, 0x4E, 0x54, 0x5F, 0x44, 0x41, 0x54, 0x45,
+	0x54, 0x49, 0x4D, 0x45, 0x09, 0x2D, 0x2D, 0x2D, 0x3E, 0x20, 0x36, 0x0D, 0x0A, 0x53, 0x54, 0x41,
+	0x43, 0x4B, 0x5F, 0x52, 0x45, 0x50, 0x4F, 0x52, 0x54, 0x09, 0x09, 0x2D, 0x2D, 0x2D, 0x3E, 0x20,
+	0x37, 0x0D, 0x0A, 0x52, 0x54, 0x43, 0x5F, 0x53, 0x45, 0x54, 0x5F, 0x44, 0x41, 0x54, 0x45, 0x54,
+	0x49, 0x4D, 0x45, 0x09, 0x2D, 0x2D, 0x2D, 0x3E, 0x20, 0x38, 0x20, 0x59, 0x59, 0x59, 0x59, 0x4D,
+	0x4D, 0x44, 0x44, 0x68, 0x68, 0x6D, 0x6D, 0x73, 0x73, 0x0D, 0x0A, 0x45, 0x58, 0x49, 0x54, 0x5F,
+	0x41, 0x50, 0x50, 0x09, 0x09, 0x2D, 0x2D, 0x2D, 0x3E, 0x20, 0x30, 0x0D, 0x0A, 0x00, 0xFF, 0xFF,
+	0x00, 0x00, 0x24, 0x03, 0x48, 0x06, 0x6A, 0x09, 0x8C, 0x0C, 0xAB, 0x0F, 0xC8, 0x12, 0xE2, 0x15,
+	0xF9, 0x18, 0x0B, 0x1C, 0x1A, 0x1F, 0x23, 0x22, 0x28, 0x25, 0x26, 0x28, 0x1F, 0x2B, 0x11, 0x2E,
+	0xFB, 0x30, 0xDF, 0x33, 0xBA, 0x36, 0x8C, 0x39, 0x56, 0x3C, 0x17, 0x3F, 0xCE, 0x41, 0x7A, 0x44,
+	0x1C, 0x47, 0xB4, 0x49, 0x3F, 0x4C, 0xBF, 0x4E, 0x33, 0x51, 0x9B, 0x53, 0xF5, 0x55, 0x42, 0x58,
+	0x82, 0x5A, 0xB3, 0x5C, 0xD7, 0x5E, 0xEB, 0x60, 0xF1, 0x62, 0xE8, 0x64, 0xCF, 0x66, 0xA6, 0x68,
+	0x6D, 0x6A, 0x23, 0x6C, 0xC9, 0x6D, 0x5E, 0x6F, 0xE2, 0x70, 0x54, 0x72, 0xB5, 0x73, 0x04, 0x75,
+	0x41, 0x76, 0x6B, 0x77, 0x84, 0x78, 0x89, 0x79, 0x7C, 0x7A, 0x5C, 0x7B, 0x29, 0x7C, 0xE3, 0x7C,
+	0x89, 0x7D, 0x1D, 0x7E, 0x9C, 0x7E, 0x09, 0x7F, 0x61, 0x7F, 0xA6, 0x7F, 0xD8, 0x7F, 0xF5, 0x7F,
+	0xFF, 0x7F, 0xF5, 0x7F, 0xD8, 0x7F, 0xA6, 0x7F, 0x61, 0x7F, 0x09, 0x7F, 0x9C, 0x7E, 0x1D, 0x7E,
+	0x89, 0x7D, 0xE3, 0x7C, 0x29, 0x7C, 0x5C, 0x7B, 0x7C, 0x7A, 0x89, 0x79, 0x84, 0x78, 0x6B, 0x77,
+	0x41, 0x76, 0x04, 0x75, 0xB5, 0x73, 0x54, 0x72, 0xE2, 0x70, 0x5E, 0x6F, 0xC9, 0x6D, 0x23, 0x6C,
+	0x6D, 0x6A, 0xA6, 0x68, 0xCF, 0x66, 0xE8, 0x64, 0xF1, 0x62, 0xEB, 0x60, 0xD7, 0x5E, 0xB3, 0x5C,
+	0x82, 0x5A, 0x42, 0x58, 0xF5, 0x55, 0x9B, 0x53, 0x33, 0x51, 0xBF, 0x4E, 0x3F, 0x4C, 0xB4, 0x49,
+	0x1C, 0x47, 0x7A, 0x44, 0xCE, 0x41, 0x17, 0x3F, 0x56, 0x3C, 0x8C, 0x39, 0xBA, 0x36, 0xDF, 0x33,
+	0xFB, 0x30, 0x11, 0x2E, 0x1F, 0x2B, 0x26, 0x28, 0x28, 0x25, 0x23, 0x22, 0x1A, 0x1F, 0x0B, 0x1C,
+	0xF9, 0x18, 0xE2, 0x15, 0xC8, 0x12, 0xAB, 0x0F, 0x8C, 0x0C, 0x6A, 0x09, 0x48, 0x06, 0x24, 0x03,
+	0x00, 0x00, 0xDC, 0xFC, 0xB8, 0xF9, 0x96, 0xF6, 0x74, 0xF3, 0x55, 0xF0, 0x38, 0xED, 0x1E, 0xEA,
+	0x07, 0xE7, 0xF5, 0xE3, 0xE6, 0xE0, 0xDD, 0xDD, 0xD8, 0xDA, 0xDA, 0xD7, 0xE1, 0xD4, 0xEF, 0xD1,
+	0x05, 0xCF, 0x21, 0xCC, 0x46, 0xC9, 0x74, 0xC6, 0xAA, 0xC3, 0xE9, 0xC0, 0x32, 0xBE, 0x86, 0xBB,
+	0xE4, 0xB8, 0x4C, 0xB6, 0xC1, 0xB3, 0x41, 0xB1, 0xCD, 0xAE, 0x65, 0xAC, 0x0B, 0xAA, 0xBE, 0xA7,
+	0x7E, 0xA5, 0x4D, 0xA3, 0x29, 0xA1, 0x15, 0x9F, 0x0F, 0x9D, 0x18, 0x9B, 0x31, 0x99, 0x5A, 0x97,
+	0x93, 0x95, 0xDD, 0x93, 0x37, 0x92, 0xA2, 0x90, 0x1E, 0x8F, 0xAC, 0x8D, 0x4B, 0x8C, 0xFC, 0x8A,
+	0xBF, 0x89, 0x95, 0x88, 0x7C, 0x87, 0x77, 0x86, 0x84, 0x85, 0xA4, 0x84, 0xD7, 0x83, 0x1D, 0x83,
+	0x77, 0x82, 0xE3, 0x81, 0x64, 0x81, 0xF7, 0x80, 0x9F, 0x80, 0x5A, 0x80, 0x28, 0x80, 0x0B, 0x80,
+	0x01, 0x80, 0x0B, 0x80, 0x28, 0x80, 0x5A, 0x80, 0x9F, 0x80, 0xF7, 0x80, 0x64, 0x81, 0xE3, 0x81,
+	0x77, 0x82, 0x1D, 0x83, 0xD7, 0x83, 0xA4, 0x84, 0x84, 0x85, 0x77, 0x86, 0x7C, 0x87, 0x95, 0x88,
+	0xBF, 0x89, 0xFC, 0x8A, 0x4B, 0x8C, 0xAC, 0x8D, 0x1E, 0x8F, 0xA2, 0x90, 0x37, 0x92, 0xDD, 0x93,
+	0x93, 0x95, 0x5A, 0x97, 0x31, 0x99, 0x18, 0x9B, 0x0F, 0x9D, 0x15, 0x9F, 0x29, 0xA1, 0x4D, 0xA3,
+	0x7E, 0xA5, 0xBE, 0xA7, 0x0B, 0xAA, 0x65, 0xAC, 0xCD, 0xAE, 0x41, 0xB1, 0xC1, 0xB3, 0x4C, 0xB6,
+	0xE4, 0xB8, 0x86, 0xBB, 0x32, 0xBE, 0xE9, 0xC0, 0xAA, 0xC3, 0x74, 0xC6, 0x46, 0xC9, 0x21, 0xCC,
+	0x05, 0xCF, 0xEF, 0xD1, 0xE1, 0xD4, 0xDA, 0xD7, 0xD8, 0xDA, 0xDD, 0xDD, 0xE6, 0xE0, 0xF5, 0xE3,
+	0x07, 0xE7, 0x1E, 0xEA, 0x38, 0xED, 0x55, 0xF0, 0x74, 0xF3, 0x96, 0xF6, 0xB8, 0xF9, 0xDC, 0xFC,
+};
+
+#endif /* ASSETIMAGE_H_ */
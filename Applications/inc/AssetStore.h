@@ -0,0 +1,86 @@
+/*
+ * AssetStore.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * Read-only assets (menus, help texts, lookup tables) in an external QSPI NOR flash.
+ *
+ * The QUADSPI peripheral maps the flash at 0x90000000 (memory-mapped mode, quad I/O fast read): the assets
+ * are read in place by the CPU, like the internal flash. pvAssetFind() gives a pointer to the data, nothing
+ * is copied in RAM.
+ *
+ * The assets are packed in a container by Tools/asset_pack.py: a header, an index sorted by name (binary
+ * search) and the data, each asset aligned on 8 bytes (a table can be read as an array). The CRC-32 of the
+ * header and index is checked by xAssetStoreInit(); the CRC-32 of an asset by xAssetVerify().
+ * The container is written by an external loader of the programming tool, or by xAssetStoreProgram().
+ *
+ * Flash: 24-bit addresses, commands of the common SPI NOR flashes (JEDEC ID 0x9F, 0xEB quad I/O read, 4 KB
+ * sector erase 0x20, page program 0x02). The quad enable bit is set at the start (ASSET_FLASH_QE_*).
+ */
+
+#ifndef ASSETSTORE_H_
+#define ASSETSTORE_H_
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stm32wbxx.h"
+
+//QUADSPI pins (AF10): PA2 (NCS), PA3 (CLK), PB9 (IO0), PB8 (IO1), PA7 (IO2), PA6 (IO3)
+
+//QSPI clock: HCLK / (ASSET_QSPI_PRESCALER + 1). It must not be above the clock of the 0xEB read of the flash.
+#define ASSET_QSPI_PRESCALER			1
+
+//Flash size: 2^ASSET_FLASH_SIZE_BITS bytes (24: 16 MB, the most with 24-bit addresses)
+#define ASSET_FLASH_SIZE_BITS			24
+
+//Address of the container in the flash (a multiple of the 4 KB sector)
+#define ASSET_STORE_OFFSET				0
+
+//Dummy cycles of the 0xEB read, after the mode byte (2 cycles on 4 lines)
+#define ASSET_FLASH_DUMMY_CYCLES		4
+
+//Quad enable bit: read and write commands of its status register, and its mask (Winbond: SR2 bit 1; Macronix: 0x05, 0x01, 0x40)
+#define ASSET_FLASH_QE_READ_CMD			0x35
+#define ASSET_FLASH_QE_WRITE_CMD		0x31
+#define ASSET_FLASH_QE_BIT				0x02
+
+#define ASSET_NAME_SIZE					16
+
+//Types of the assets. A text is followed by a '\0', which is not counted in its length.
+#define ASSET_TYPE_BINARY				0
+#define ASSET_TYPE_TEXT					1
+
+//Memory-mapped address of the flash
+#define ASSET_FLASH_MAPPED_ADDRESS		QUADSPI_BASE
+
+/*
+ * Starts the QUADSPI, reads the JEDEC ID, sets the quad enable bit, maps the flash and checks the container.
+ * Returns pdFAIL if the flash does not answer. Without a valid container, ulAssetCount() is 0.
+ */
+BaseType_t xAssetStoreInit(void);
+
+//JEDEC ID of the flash (manufacturer, type, capacity), read by xAssetStoreInit()
+uint32_t ulAssetStoreJedecId(void);
+
+//Number of assets of the container, 0 if there is none (or not valid)
+uint32_t ulAssetCount(void);
+
+//Data of an asset in the mapped flash, and its length. Returns NULL if there is no asset with this name.
+const void *pvAssetFind(const char *pcName, uint32_t *pulLength);
+
+//A text asset, NULL if there is none with this name (or it is not a text)
+const char *pcAssetText(const char *pcName);
+
+//Checks the CRC-32 of the data of an asset (it reads all of it)
+BaseType_t xAssetVerify(const char *pcName);
+
+/*
+ * Writes a container (e.g. the output of asset_pack.py) at ASSET_STORE_OFFSET, then maps the flash again and
+ * checks it. The flash is not mapped while it is written: no task may use the assets during the call.
+ */
+BaseType_t xAssetStoreProgram(const uint8_t *pucImage, uint32_t ulLength);
+
+#endif /* ASSETSTORE_H_ */
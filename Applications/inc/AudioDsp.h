@@ -0,0 +1,61 @@
+/*
+ * AudioDsp.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * Fixed-point processing of 16 bit stereo frames (one word: left sample in the low half word, right sample
+ * in the high half word, as in the DMA buffers of AudioStream.c). Each function processes both channels of
+ * a frame with the SIMD and saturating instructions of the Cortex-M4, without a copy of the block.
+ * The output may be the input buffer (processing in place).
+ *
+ *   gain:   Q15 gain per channel, saturated
+ *   biquad: one second order IIR section (direct form I), Q14 coefficients, the same for both channels
+ *   level:  RMS and peak of each channel over a block
+ */
+
+#ifndef AUDIODSP_H_
+#define AUDIODSP_H_
+
+#include "FreeRTOS.h"
+
+//Q14: 1.0 is 16384
+#define AUDIO_Q14(x)					((int16_t) ((x) * 16384.0f + (((x) < 0) ? -0.5f : 0.5f)))
+
+/*
+ * Biquad section: y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] - a1 y[n-1] - a2 y[n-2], coefficients in Q14
+ * (-2.0 < a1 < 2.0). The accumulator holds 32 bits: the sum of the magnitudes of the five coefficients
+ * must be below 4.0.
+ */
+typedef struct AudioBiquad
+{
+	uint32_t ulB0B1;					//b0 | b1 << 16
+	uint32_t ulB2A1;					//b2 | -a1 << 16
+	uint32_t ulA2;						//-a2 (low half word)
+	uint32_t ulX1, ulX2;				//Previous input frames
+	uint32_t ulY1, ulY2;				//Previous output frames
+}AudioBiquad_t;
+
+//Level of a block: in sample units (0 to 32767, a full scale square wave is 32767 RMS)
+typedef struct AudioLevel
+{
+	uint16_t usRmsLeft;
+	uint16_t usRmsRight;
+	uint16_t usPeakLeft;
+	uint16_t usPeakRight;
+}AudioLevel_t;
+
+//Multiplies the left samples by sLeftGain and the right ones by sRightGain (Q15)
+void vAudioGain(const uint32_t *pulInput, uint32_t *pulOutput, size_t xFrames, int16_t sLeftGain, int16_t sRightGain);
+
+//Sets the coefficients (Q14) and clears the history
+void vAudioBiquadInit(AudioBiquad_t *pxBiquad, int16_t sB0, int16_t sB1, int16_t sB2, int16_t sA1, int16_t sA2);
+
+//Filters xFrames frames. The history is kept in pxBiquad for the next block.
+void vAudioBiquad(AudioBiquad_t *pxBiquad, const uint32_t *pulInput, uint32_t *pulOutput, size_t xFrames);
+
+void vAudioLevel(const uint32_t *pulFrames, size_t xFrames, AudioLevel_t *pxLevel);
+
+#endif /* AUDIODSP_H_ */
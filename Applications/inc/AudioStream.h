@@ -0,0 +1,101 @@
+/*
+ * AudioStream.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * Audio streaming with SAI1: 16 bit stereo I2S at AUDIO_STREAM_RATE, playback on block A (master: it drives
+ * the clocks) and capture on block B (synchronous slave, same clocks). Each block has a circular DMA buffer
+ * of two halves (ping-pong) of AUDIO_STREAM_BLOCK_FRAMES frames.
+ *
+ * When the capture DMA has filled a half (half transfer and transfer complete interrupts), the processing
+ * task is woken up. It gets the captured half and the playback half of the same index, processes one into
+ * the other in place in the DMA buffers, and calls vAudioStreamBlockDone(). It has one block period for it:
+ *   overrun:  a capture half is full again while the previous block is not done (its input is overwritten)
+ *   underrun: the playback DMA starts a half that was not written since it played it last (it plays it again)
+ * The processing time of each block, from the capture interrupt to vAudioStreamBlockDone(), is measured in
+ * CPU cycles, with its worst case: it has to stay under the cycles of one block period.
+ *
+ * A frame is one 32 bit word: left sample in the low half word, right sample in the high half word. The DSP
+ * functions of AudioDsp.h process both channels of a frame at once with the SIMD instructions.
+ */
+
+#ifndef AUDIOSTREAM_H_
+#define AUDIOSTREAM_H_
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+//SAI1 pins (AF13): PA3 (MCLK_A), PA8 (SCK_A), PA9 (FS_A), PA10 (SD_A, playback), PB5 (SD_B, capture)
+
+//Sample rate: one of the SAI_AUDIO_FREQUENCY_x values of the HAL (its MCKDIV is computed from the SAI clock)
+#define AUDIO_STREAM_RATE				48000
+
+/*
+ * SAI clock: PLLSAI1 P output from HSI16 / 2 (PLLM is shared with the main PLL, which is not used):
+ * 8 MHz * 43 / 7 = 49.14 MHz, i.e. 256 * 48 kHz * 4 (MCKDIV 4) with a small error.
+ */
+#define AUDIO_STREAM_PLLSAI1_N			43
+#define AUDIO_STREAM_PLLSAI1_P			LL_RCC_PLLSAI1P_DIV_7
+
+//Frames of one half of the DMA buffers (one block)
+#define AUDIO_STREAM_BLOCK_FRAMES		128
+
+//Task notification index used to wake up the processing task (a task waits for one driver at a time)
+#define AUDIO_STREAM_NOTIFY_INDEX		2
+
+//Priority of the DMA and SAI interrupts. It should be less than or equal to configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY.
+#define AUDIO_STREAM_IRQ_PRIORITY		5
+
+//One block: the captured frames and the frames to play, in the DMA buffers
+typedef struct AudioBlock
+{
+	const uint32_t *pulInput;
+	uint32_t *pulOutput;
+	size_t xFrames;
+	uint32_t ulSequence;				//Number of the block since the start (1 for the first one)
+	uint32_t ulStartCycles;				//DWT->CYCCNT at the capture interrupt
+	uint8_t ucHalf;
+}AudioBlock_t;
+
+typedef struct AudioStreamStats
+{
+	uint32_t ulBlocks;					//Blocks done
+	uint32_t ulOverruns;
+	uint32_t ulUnderruns;
+	uint32_t ulFifoErrors;				//Overrun/underrun flags of the SAI FIFOs (the DMA was late)
+	uint32_t ulLastCycles;				//Processing time of the last block
+	uint32_t ulWorstCycles;
+	uint32_t ulBudgetCycles;			//CPU cycles of one block period
+}AudioStreamStats_t;
+
+/*
+ * Initializes PLLSAI1, SAI1 blocks A and B, their DMA channels (DMA1 channels 6 and 7) and pins.
+ * Returns pdFAIL if the SAI could not be initialized.
+ */
+BaseType_t xAudioStreamInit(void);
+
+/*
+ * Starts the capture and the playback (silence until the first block is done). The calling task is the
+ * processing task: it is notified at the end of each captured block. Not from an interrupt.
+ */
+BaseType_t xAudioStreamStart(void);
+void vAudioStreamStop(void);
+
+/*
+ * Blocks the processing task until the next captured block, and gives it with its playback half.
+ * Returns pdFAIL if no block is captured after xTicksToWait.
+ */
+BaseType_t xAudioStreamWaitBlock(AudioBlock_t *pxBlock, TickType_t xTicksToWait);
+
+//The output of the block is written: records its processing time
+void vAudioStreamBlockDone(const AudioBlock_t *pxBlock);
+
+void vAudioStreamGetStats(AudioStreamStats_t *pxStats);
+
+//Worst processing time set to 0 (e.g. after the start)
+void vAudioStreamResetWorst(void);
+
+#endif /* AUDIOSTREAM_H_ */
@@ -0,0 +1,48 @@
+/*
+ * Crc32.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * CRC-32 (IEEE 802.3, the CRC of zlib/Ethernet/PNG: polynomial 0x04C11DB7 reflected, initial value
+ * and final XOR 0xFFFFFFFF). The check value of "123456789" is 0xCBF43926.
+ *
+ * It is computed by the CRC unit of the MCU. Large buffers are fed to the CRC unit by a memory to
+ * memory DMA transfer while the calling task is blocked. The software version gives the same result
+ * bit for bit; it is used when the CRC unit is not initialized (or CRC32_USE_HARDWARE is 0).
+ */
+
+#ifndef CRC32_H_
+#define CRC32_H_
+
+#include "FreeRTOS.h"
+
+//0: always use the software CRC (e.g. when the CRC unit or the DMA channel is used by something else)
+#define CRC32_USE_HARDWARE			1
+
+//Buffers of at least this size are fed to the CRC unit by DMA. Below it the CPU writes them (no DMA set up cost).
+#define CRC32_DMA_THRESHOLD			128
+
+//Task notification index used to wait for the end of the DMA transfer
+#define CRC32_NOTIFY_INDEX			2
+
+//Priority of the DMA interrupt. It should be less than or equal to configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY.
+#define CRC32_DMA_IRQ_PRIORITY		5
+
+#define CRC32_CHECK_VALUE			0xCBF43926UL
+
+/*
+ * Initializes the CRC unit and its DMA channel (DMA2 channel 1), and checks the hardware result
+ * against the software one. Returns pdFAIL if the software CRC has to be used.
+ */
+BaseType_t xCrc32Init(void);
+
+//CRC-32 of a buffer. It can be called by several tasks (the CRC unit is protected by a mutex), not from an interrupt.
+uint32_t ulCrc32Calculate(const uint8_t *pucData, size_t xLength);
+
+//Software CRC-32. ulCrc is 0 for a new CRC, or the result of the previous part to continue a CRC.
+uint32_t ulCrc32Software(uint32_t ulCrc, const uint8_t *pucData, size_t xLength);
+
+#endif /* CRC32_H_ */
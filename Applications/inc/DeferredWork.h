@@ -0,0 +1,63 @@
+/*
+ * DeferredWork.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * Deferred work executor (bottom half) for interrupt handlers.
+ * An ISR submits a function and its arguments to one of the priority lanes,
+ * and the worker task of that lane executes it later at task level.
+ */
+
+#ifndef DEFERREDWORK_H_
+#define DEFERREDWORK_H_
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+//Number of lanes and their worker task priorities (lane 0 is the most urgent one)
+#define DEFERRED_WORK_LANES				3
+#define DEFERRED_WORK_LANE_PRIORITIES	{ configMAX_PRIORITIES - 1, 4, 2 }
+
+//Items per lane. It must be a power of 2.
+#define DEFERRED_WORK_QUEUE_LENGTH		32
+
+//Stack size of each worker task. The deferred functions run on this stack.
+#define DEFERRED_WORK_STACK_SIZE		384
+
+#define DEFERRED_WORK_LANE_HIGH			0
+#define DEFERRED_WORK_LANE_NORMAL		1
+#define DEFERRED_WORK_LANE_LOW			2
+
+//Same prototype as the functions passed to xTimerPendFunctionCallFromISR()
+typedef void (*DeferredWorkFunction_t)(void *pvParameter1, uint32_t ulParameter2);
+
+//Statistics of a lane. The latencies are in CPU cycles (DWT cycle counter).
+typedef struct DeferredWorkStats
+{
+	uint32_t ulExecuted;
+	uint32_t ulDropped;				//Submissions rejected because the lane was full
+	uint32_t ulMinLatency;
+	uint32_t ulMaxLatency;
+	uint64_t ullTotalLatency;
+	uint32_t ulHighWaterMark;		//Maximum number of items waiting in the lane
+}DeferredWorkStats_t;
+
+//Creates the worker tasks. It must be called before vTaskStartScheduler().
+BaseType_t xDeferredWorkInit(void);
+
+/*
+ * Queues a function call on a lane. These calls never block and never allocate memory.
+ * pdFAIL is returned if the lane is full (the call is counted as dropped).
+ */
+BaseType_t xDeferredWorkSubmitFromISR(UBaseType_t uxLane, DeferredWorkFunction_t pxFunction,
+		void *pvParameter1, uint32_t ulParameter2, BaseType_t *pxHigherPriorityTaskWoken);
+BaseType_t xDeferredWorkSubmit(UBaseType_t uxLane, DeferredWorkFunction_t pxFunction,
+		void *pvParameter1, uint32_t ulParameter2);
+
+void vDeferredWorkGetStats(UBaseType_t uxLane, DeferredWorkStats_t *pxStats);
+void vDeferredWorkResetStats(UBaseType_t uxLane);
+
+#endif /* DEFERREDWORK_H_ */
@@ -0,0 +1,38 @@
+/*
+ * EcdsaSoft.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * Software ECDSA signature verification on the NIST P-256 curve (secp256r1).
+ * It gives the same result as the PKA of the MCU for the same input, and it does not use the HAL,
+ * so it also builds on the host (e.g. to check the test vectors).
+ *
+ * All the numbers are big endian byte arrays, like in the PKA interface and in the certificates:
+ *   public key: X || Y (64 bytes, the uncompressed point without its 0x04 prefix)
+ *   signature:  r || s (64 bytes)
+ *   hash:       32 bytes (SHA-256 of the message)
+ */
+
+#ifndef ECDSASOFT_H_
+#define ECDSASOFT_H_
+
+#include "stdint.h"
+
+#define ECDSA_P256_SIZE				32
+
+//Curve parameters (big endian), also given to the PKA
+extern const uint8_t ucP256Prime[ECDSA_P256_SIZE];
+extern const uint8_t ucP256Order[ECDSA_P256_SIZE];
+extern const uint8_t ucP256Gx[ECDSA_P256_SIZE];
+extern const uint8_t ucP256Gy[ECDSA_P256_SIZE];
+
+//1 if r and s are in [1, n - 1] and the coordinates of the public key are lower than p, else 0
+uint8_t ucEcdsaSoftCheckInputs(const uint8_t *pucPublicKey, const uint8_t *pucSignature);
+
+//1 if the signature is valid, else 0
+uint8_t ucEcdsaSoftVerify(const uint8_t *pucPublicKey, const uint8_t *pucHash, const uint8_t *pucSignature);
+
+#endif /* ECDSASOFT_H_ */
@@ -0,0 +1,78 @@
+/*
+ * EcdsaVerify.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * ECDSA P-256 signature verification with the PKA of the MCU.
+ * A task submits a job and is free until the end of the verification: the PKA runs the job under interrupt,
+ * and its interrupt wakes up the task by task notification. The jobs submitted while the PKA is busy
+ * are kept in a list and started one after the other from the interrupt.
+ *
+ * The software verification of EcdsaSoft.c gives the same results. It is used (in the calling task)
+ * when the PKA is not initialized, when its self test fails, or when ECDSA_VERIFY_USE_HARDWARE is 0.
+ */
+
+#ifndef ECDSAVERIFY_H_
+#define ECDSAVERIFY_H_
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "EcdsaSoft.h"
+
+//0: always use the software verification
+#define ECDSA_VERIFY_USE_HARDWARE			1
+
+//Task notification index used to wait for the end of the jobs (a task waits for one driver at a time)
+#define ECDSA_VERIFY_NOTIFY_INDEX			2
+
+//Priority of the PKA interrupt. It should be less than or equal to configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY.
+#define ECDSA_VERIFY_IRQ_PRIORITY			6
+
+/*
+ * One verification. The caller sets the three inputs (big endian, see EcdsaSoft.h); the buffers and the job
+ * must stay valid until the end of the job, as the PKA reads the inputs only when the job is started.
+ */
+typedef struct EcdsaJob
+{
+	const uint8_t *pucPublicKey;		//X || Y
+	const uint8_t *pucHash;
+	const uint8_t *pucSignature;		//r || s
+
+	//Set by the driver
+	TaskHandle_t xTask;					//Task notified at the end of the job
+	struct EcdsaJob *pxNext;			//Next job waiting for the PKA
+	uint32_t ulCycles;					//CPU cycles of the verification (PKA: from the start to the interrupt)
+	volatile uint8_t ucDone;
+	volatile uint8_t ucError;			//The PKA reported an error: the job is done again in software
+	uint8_t ucValid;					//1 if the signature is valid (read it after xEcdsaVerifyWait())
+}EcdsaJob_t;
+
+/*
+ * Initializes the PKA and checks it with a test vector.
+ * Returns pdFAIL if the software verification has to be used.
+ */
+BaseType_t xEcdsaVerifyInit(void);
+
+//pdTRUE: PKA (if its self test passed), pdFALSE: software. Used to compare both.
+void vEcdsaVerifyUseHardware(BaseType_t xUseHardware);
+BaseType_t xEcdsaVerifyIsHardware(void);
+
+/*
+ * Starts the job, or puts it in the list if the PKA is busy. Not from an interrupt.
+ * With the software verification, the job is done before the function returns.
+ */
+void vEcdsaVerifySubmit(EcdsaJob_t *pxJob);
+
+/*
+ * Blocks the calling task (the one which submitted the job) until the end of the job.
+ * Returns pdFAIL if the job is not done after xTicksToWait.
+ */
+BaseType_t xEcdsaVerifyWait(EcdsaJob_t *pxJob, TickType_t xTicksToWait);
+
+//Submit and wait. Returns 1 if the signature is valid, else 0.
+uint8_t ucEcdsaVerify(const uint8_t *pucPublicKey, const uint8_t *pucHash, const uint8_t *pucSignature);
+
+#endif /* ECDSAVERIFY_H_ */
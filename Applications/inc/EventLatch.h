@@ -0,0 +1,89 @@
+/*
+ * EventLatch.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * Event latching between an interrupt and a handler task, with loss detection
+ * and per-event latency measurement (DWT cycle counter).
+ *
+ * Modes:
+ *  - EVENT_LATCH_SEMAPHORE : events are latched in a counting semaphore. When it is full,
+ *                            the event is lost (and counted as lost).
+ *  - EVENT_LATCH_SEMAPHORE_FALLBACK : same as above, but the events which do not fit in the
+ *                            semaphore are accumulated in the notification value of the handler task.
+ *  - EVENT_LATCH_NOTIFY    : events are only accumulated in the notification value (32 bit counter).
+ *
+ * In the fallback and notify modes the handler task must not use its task notification for anything else.
+ */
+
+#ifndef EVENTLATCH_H_
+#define EVENTLATCH_H_
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+//Number of events whose timestamps can be kept for the latency measurement. It must be a power of 2.
+#define EVENT_LATCH_STAMP_SLOTS		64
+
+typedef enum
+{
+	EVENT_LATCH_SEMAPHORE = 0,
+	EVENT_LATCH_SEMAPHORE_FALLBACK,
+	EVENT_LATCH_NOTIFY
+}EventLatchMode_t;
+
+typedef struct EventLatchStats
+{
+	uint32_t ulSignalled;			//Events raised by the interrupt
+	uint32_t ulHandled;				//Events taken by the handler task
+	uint32_t ulLost;				//Events dropped because the semaphore was full
+	uint32_t ulAccumulated;			//Events which overflowed into the notification value
+	uint32_t ulUnstamped;			//Events handled without latency sample (timestamp ring was full)
+	uint32_t ulMinLatency;			//Latencies in CPU cycles, from signal to handler
+	uint32_t ulMaxLatency;
+	uint64_t ullTotalLatency;
+	uint32_t ulLatencySamples;
+}EventLatchStats_t;
+
+typedef struct EventLatchStamp
+{
+	uint32_t ulSequence;			//Index of the latched event
+	uint32_t ulTimestamp;
+}EventLatchStamp_t;
+
+typedef struct EventLatch
+{
+	EventLatchMode_t eMode;
+	SemaphoreHandle_t xSemaphore;
+	TaskHandle_t xHandlerTask;
+	EventLatchStamp_t xStamps[EVENT_LATCH_STAMP_SLOTS];
+	volatile uint32_t ulStampHead;
+	volatile uint32_t ulStampTail;
+	volatile uint32_t ulLatched;	//Events latched since init (signalled and not lost)
+	volatile uint32_t ulTaken;		//Events taken by the handler task since init
+	volatile EventLatchStats_t xStats;
+}EventLatch_t;
+
+/*
+ * uxMaxCount is the semaphore size (not used in EVENT_LATCH_NOTIFY mode).
+ * xHandlerTask is the only task allowed to call xEventLatchWait().
+ */
+BaseType_t xEventLatchInit(EventLatch_t *pxLatch, EventLatchMode_t eMode, UBaseType_t uxMaxCount, TaskHandle_t xHandlerTask);
+
+//Latches one event. It returns pdFAIL if the event has been lost. All the signals must come from the same interrupt priority.
+BaseType_t xEventLatchSignalFromISR(EventLatch_t *pxLatch, BaseType_t *pxHigherPriorityTaskWoken);
+
+//Takes one event. It returns pdFALSE if there was no event within xTicksToWait.
+BaseType_t xEventLatchWait(EventLatch_t *pxLatch, TickType_t xTicksToWait);
+
+//Number of events latched and not handled yet
+uint32_t ulEventLatchPending(EventLatch_t *pxLatch);
+
+void vEventLatchGetStats(EventLatch_t *pxLatch, EventLatchStats_t *pxStats);
+void vEventLatchResetStats(EventLatch_t *pxLatch);
+
+#endif /* EVENTLATCH_H_ */
@@ -0,0 +1,114 @@
+/*
+ * FlashLog.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * Append-only log of small records in the internal flash, kept across resets and power cuts.
+ *
+ * The log uses FLASH_LOG_PAGES pages of 4 KB as a ring: records are appended to the newest page,
+ * and when it is full the oldest page is erased and becomes the newest one, so all the pages are
+ * erased equally often (wear levelling). The oldest records are lost when the ring wraps.
+ *
+ * A task appends a record by copying it into a RAM queue: the flash is programmed and erased by the
+ * writer task of the log, in batches, so the appending tasks never wait for an erase. Each record is
+ * followed by a commit double word written last: a record cut by a reset or a power loss has no commit
+ * and is skipped. The data of the records is checked with a CRC-32 when they are read.
+ * A double word cut during its programming can be left with an ECC double error, which raises the NMI when
+ * it is read: NMI_Handler() of FlashLog.c clears it and the record (or the page) is skipped like a torn one.
+ * The application must not have its own NMI_Handler().
+ *
+ * At the start, the index (order of the pages, end of the newest one) is rebuilt by reading the page
+ * headers and the header of each record: one read per record, the time is bounded by the size of the log.
+ *
+ * The pages must be in the FLASH_LOG region of LinkerScript.ld (out of ROM, so the linker does not put the
+ * application there) and below the flash used by CPU2 (wireless stack): xFlashLogInit() checks it.
+ * CPU2 must not be started: the flash operations are not coordinated with it (semaphores of the HSEM).
+ * The CPU cannot read the flash during a page erase: all the code running from the flash, interrupts
+ * included, waits for its end.
+ */
+
+#ifndef FLASHLOG_H_
+#define FLASHLOG_H_
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+//Flash pages of the log (4 KB each), in the FLASH_LOG region of LinkerScript.ld
+#define FLASH_LOG_START_ADDRESS		0x080A0000
+#define FLASH_LOG_PAGES				8
+
+//Largest data of a record (bytes)
+#define FLASH_LOG_MAX_RECORD		240
+
+//RAM queue of the records waiting for the writer task (bytes, power of 2). A record takes its size + 4 bytes.
+#define FLASH_LOG_QUEUE_SIZE		2048
+
+//Writer task
+#define FLASH_LOG_TASK_PRIORITY		1
+#define FLASH_LOG_TASK_STACK		384
+
+//Task notification index used to wait for the writer task (room in the queue, flush)
+#define FLASH_LOG_NOTIFY_INDEX		2
+
+typedef struct FlashLogStats
+{
+	uint32_t ulRecords;					//Committed records in the log (at the start, then appended)
+	uint32_t ulTornRecords;				//Records without commit found at the start (cut by a reset)
+	uint32_t ulBadPages;				//Pages with a damaged header or record header found at the start
+	uint32_t ulRebuildCycles;			//CPU cycles of the index rebuild
+	uint32_t ulAppended;				//Records queued
+	uint32_t ulWritten;					//Records programmed and committed
+	uint32_t ulDropped;					//Records not queued (queue full after the wait)
+	uint32_t ulErases;
+	uint32_t ulWriteErrors;
+	uint32_t ulCrcErrors;				//Records skipped by the readers because of a wrong CRC
+	uint32_t ulEccErrors;				//Reads of a double word with an ECC double error (torn), by the scan and the readers
+}FlashLogStats_t;
+
+//Position of a reader in the log, from the oldest record to the newest
+typedef struct FlashLogCursor
+{
+	uint32_t ulSequence;				//Sequence number of the page being read (0: before the oldest)
+	uint32_t ulOffset;
+}FlashLogCursor_t;
+
+/*
+ * Rebuilds the index from the flash and creates the writer task. It must be called before vTaskStartScheduler().
+ * Returns pdFAIL if the pages are not usable (secure flash of CPU2) or the task could not be created.
+ */
+BaseType_t xFlashLogInit(void);
+
+/*
+ * Queues a record of xLength bytes (at most FLASH_LOG_MAX_RECORD) with a type chosen by the application.
+ * If the queue is full, the caller blocks up to xTicksToWait. Returns pdFAIL if the record was not queued.
+ * From a task, not from an interrupt.
+ */
+BaseType_t xFlashLogAppend(uint8_t ucType, const void *pvData, size_t xLength, TickType_t xTicksToWait);
+
+//Blocks up to xTicksToWait until the queued records are committed. Returns pdFAIL on timeout.
+BaseType_t xFlashLogFlush(TickType_t xTicksToWait);
+
+//Sets the cursor before the oldest record
+void vFlashLogRewind(FlashLogCursor_t *pxCursor);
+
+/*
+ * Copies the next committed record (data up to xBufferSize bytes) and moves the cursor after it.
+ * Returns pdFAIL when there is no newer record. Records with a wrong CRC are skipped.
+ * If the writer erased the page of the cursor meanwhile, the reading goes on with the oldest page.
+ */
+BaseType_t xFlashLogReadNext(FlashLogCursor_t *pxCursor, uint8_t *pucType, void *pvBuffer, size_t xBufferSize, size_t *pxLength);
+
+void vFlashLogGetStats(FlashLogStats_t *pxStats);
+
+/*
+ * Test of the power cut: the writer programs the first ulDoubleWords double words of the next record, starts
+ * the programming of the next one (0: the record header, at most the commit) and resets the MCU in the middle
+ * of it, like a power loss. The double word is left torn: wrong bits, or an ECC double error. If the programming
+ * ends before the reset, the cut is between double words.
+ */
+void vFlashLogInjectCut(uint32_t ulDoubleWords);
+
+#endif /* FLASHLOG_H_ */
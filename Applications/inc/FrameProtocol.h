@@ -0,0 +1,65 @@
+/*
+ * FrameProtocol.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * Binary framed protocol for the UART console.
+ *
+ * Frame before encoding (little endian):
+ *   | payload length (2) | command (1) | payload (0..FRAME_MAX_PAYLOAD) | CRC-32 (4) |
+ * The CRC-32 (Crc32.h) covers the length, command and payload.
+ *
+ * The frame is COBS encoded (Consistent Overhead Byte Stuffing: no 0x00 byte inside, 1 byte of overhead
+ * every 254 bytes) and sent between two 0x00 delimiters. The receiver collects the bytes up to the
+ * next 0x00 and gives them to xFrameDecode(). The leading delimiter ends any garbage received before
+ * the frame (e.g. a text message or a lost byte), so the receiver is always back in sync at the next frame.
+ */
+
+#ifndef FRAMEPROTOCOL_H_
+#define FRAMEPROTOCOL_H_
+
+#include "FreeRTOS.h"
+
+#define FRAME_MAX_PAYLOAD			512
+
+#define FRAME_DELIMITER				0x00
+#define FRAME_HEADER_SIZE			3
+#define FRAME_CRC_SIZE				4
+#define FRAME_MAX_RAW_SIZE			(FRAME_HEADER_SIZE + FRAME_MAX_PAYLOAD + FRAME_CRC_SIZE)
+
+//COBS adds 1 byte, plus 1 for every 254 bytes. The encoded frame also has 2 delimiters.
+#define FRAME_COBS_OVERHEAD(n)		(1 + ((n) / 254))
+#define FRAME_MAX_ENCODED_SIZE		(FRAME_MAX_RAW_SIZE + FRAME_COBS_OVERHEAD(FRAME_MAX_RAW_SIZE) + 2)
+
+typedef enum
+{
+	eFrameOk = 0,
+	eFrameCobsError,		//Invalid COBS encoding
+	eFrameLengthError,		//Too short, or the length field does not match the received size
+	eFrameCrcError
+}FrameStatus_t;
+
+//Decoded frame. The payload points into the buffer given to xFrameDecode().
+typedef struct Frame
+{
+	uint8_t ucCommand;
+	uint16_t usLength;
+	uint8_t *pucPayload;
+}Frame_t;
+
+/*
+ * Builds the encoded frame (with its delimiters) in pucOutput. xOutputSize should be FRAME_MAX_ENCODED_SIZE
+ * (or at least the encoded size for usLength). Returns the number of bytes to send, 0 if it does not fit.
+ */
+size_t xFrameEncode(uint8_t ucCommand, const uint8_t *pucPayload, uint16_t usLength, uint8_t *pucOutput, size_t xOutputSize);
+
+/*
+ * Decodes the bytes received between two delimiters (xLength bytes, without the delimiters).
+ * The buffer is decoded in place and pxFrame points into it.
+ */
+FrameStatus_t xFrameDecode(uint8_t *pucBuffer, size_t xLength, Frame_t *pxFrame);
+
+#endif /* FRAMEPROTOCOL_H_ */
@@ -0,0 +1,104 @@
+/*
+ * I2cManager.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * Register reads and writes on the I2C1 bus (master), shared by the tasks. A task submits a job and is free
+ * until its end: the I2C interrupt runs the phases of the job (register address, restart, data) and starts
+ * the next job of the list, without waking up a task in between. At the end of a job, its callback is called,
+ * or the task which submitted it is notified.
+ *
+ * A job which transfers no byte for I2C_MANAGER_TIMEOUT_MS (a slave holds SDA or SCL low) is stopped by a timer:
+ * the bus is cleared (clock pulses until SDA is released, then a STOP) and the I2C is restarted.
+ * A long job which keeps transferring is not stopped, whatever its length.
+ */
+
+#ifndef I2CMANAGER_H_
+#define I2CMANAGER_H_
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+//I2C1 on PB8 (SCL) and PB9 (SDA), 100 kHz with the I2C clock (PCLK1) at 32 MHz
+#define I2C_MANAGER_TIMING				0x70420F13
+
+//Largest number of data bytes of a write job (they are copied with the register address)
+#define I2C_MANAGER_MAX_WRITE			32
+
+//A job which transfers no byte for longer is stopped and the bus is cleared (between one and two periods of the timer)
+#define I2C_MANAGER_TIMEOUT_MS			20
+
+//Task notification index used to wait for the end of the jobs (a task waits for one driver at a time)
+#define I2C_MANAGER_NOTIFY_INDEX		2
+
+//Priority of the I2C interrupts. It should be less than or equal to configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY.
+#define I2C_MANAGER_IRQ_PRIORITY		6
+
+//Result of a job (ucStatus)
+#define I2C_JOB_OK						0
+#define I2C_JOB_NACK					1		//No acknowledge of the address or of a byte
+#define I2C_JOB_BUS_ERROR				2		//Bus error or arbitration lost
+#define I2C_JOB_TIMEOUT					3		//Stopped by the timer, the bus was cleared
+
+struct I2cJob;
+
+/*
+ * Called at the end of a job, from the I2C interrupt, or from the timer task after a timeout
+ * (with the I2C interrupts masked). It must be short, and can only use the FromISR functions of FreeRTOS.
+ */
+typedef void (*I2cCallback_t)(struct I2cJob *pxJob);
+
+/*
+ * One register read or write. The caller sets the first fields; the job and the data buffer must stay
+ * valid until the end of the job.
+ */
+typedef struct I2cJob
+{
+	uint8_t ucAddress;					//7 bit address of the slave
+	uint8_t ucRead;						//1: read usLength bytes from the register, 0: write them
+	uint16_t usRegister;
+	uint8_t ucRegisterSize;				//Bytes of the register address (0, 1 or 2, most significant byte first)
+	uint8_t *pucData;
+	uint16_t usLength;
+	I2cCallback_t pxCallback;			//NULL: the task which submitted the job is notified
+	void *pvContext;					//Free for the callback
+
+	//Set by the manager
+	TaskHandle_t xTask;
+	struct I2cJob *pxNext;				//Next job waiting for the bus
+	uint8_t ucPhase;
+	uint32_t ulStartCycle;
+	uint32_t ulCycles;					//CPU cycles from the start of the job to its end
+	volatile uint8_t ucDone;
+	volatile uint8_t ucStatus;			//I2C_JOB_OK ...
+}I2cJob_t;
+
+/*
+ * Initializes I2C1, its pins and interrupts, and the timer of the timeouts. Not from an interrupt.
+ * Returns pdFAIL if the I2C or the timer could not be initialized.
+ */
+BaseType_t xI2cManagerInit(void);
+
+/*
+ * Starts the job, or puts it in the list if the bus is busy. From a task, not from an interrupt.
+ * Returns pdFAIL if the job is not valid (address, lengths): it is not submitted and its callback is not called.
+ */
+BaseType_t xI2cSubmit(I2cJob_t *pxJob);
+
+/*
+ * Blocks the calling task (the one which submitted the job, without callback) until the end of the job.
+ * Returns pdFAIL if the job is not done after xTicksToWait, or if it did not end with I2C_JOB_OK.
+ */
+BaseType_t xI2cWait(I2cJob_t *pxJob, TickType_t xTicksToWait);
+
+//Submit and wait
+BaseType_t xI2cReadRegister(uint8_t ucAddress, uint8_t ucRegister, uint8_t *pucData, uint16_t usLength);
+BaseType_t xI2cWriteRegister(uint8_t ucAddress, uint8_t ucRegister, const uint8_t *pucData, uint16_t usLength);
+
+//Number of bus clears since the start
+uint32_t ulI2cManagerRecoveries(void);
+
+#endif /* I2CMANAGER_H_ */
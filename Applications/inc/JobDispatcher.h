@@ -0,0 +1,86 @@
+/*
+ * JobDispatcher.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * Job dispatcher with a pool of worker tasks.
+ * Jobs are posted to one bounded queue which is shared by all the workers (multiple producers,
+ * multiple consumers). A free worker blocks on the queue, and a producer blocks (or gives up)
+ * when the queue is full, so the queue length is the backpressure limit.
+ * When a job is done, its completion callback is called from the worker task.
+ */
+
+#ifndef JOBDISPATCHER_H_
+#define JOBDISPATCHER_H_
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+//Maximum number of worker tasks of a dispatcher
+#define JOB_DISPATCHER_MAX_WORKERS		4
+
+//Stack size of each worker task. The jobs and their callbacks run on this stack.
+#define JOB_DISPATCHER_STACK_SIZE		384
+
+//Job function. Its return value is passed to the completion callback.
+typedef BaseType_t (*JobFunction_t)(void *pvParameter);
+
+//Completion callback, called by the worker task which executed the job
+typedef void (*JobCompleteCallback_t)(void *pvParameter, BaseType_t xResult);
+
+//Statistics of a dispatcher. The times are in CPU cycles (DWT cycle counter).
+typedef struct JobDispatcherStats
+{
+	uint32_t ulSubmitted;
+	uint32_t ulRejected;			//Submissions which timed out because the queue was full
+	uint32_t ulCompleted;
+	uint32_t ulMaxPending;			//Maximum number of jobs waiting in the queue
+	uint32_t ulMinQueueWait;		//Time from the submission to the start of the job
+	uint32_t ulMaxQueueWait;
+	uint64_t ullTotalQueueWait;
+	uint64_t ullTotalRunTime;		//Time spent in the job functions (and callbacks)
+	uint32_t ulCompletedPerWorker[JOB_DISPATCHER_MAX_WORKERS];
+}JobDispatcherStats_t;
+
+typedef struct JobDispatcherWorker
+{
+	struct JobDispatcher *pxDispatcher;
+	TaskHandle_t xHandle;
+	UBaseType_t uxIndex;
+}JobDispatcherWorker_t;
+
+typedef struct JobDispatcher
+{
+	QueueHandle_t xJobQueue;
+	JobDispatcherWorker_t xWorkers[JOB_DISPATCHER_MAX_WORKERS];
+	UBaseType_t uxWorkerCount;
+	volatile JobDispatcherStats_t xStats;
+}JobDispatcher_t;
+
+/*
+ * Creates the job queue (uxQueueLength jobs) and uxWorkerCount worker tasks of priority uxPriority.
+ * The worker tasks are named pcName followed by the worker number.
+ */
+BaseType_t xJobDispatcherCreate(JobDispatcher_t *pxDispatcher, const char *pcName, UBaseType_t uxWorkerCount,
+		UBaseType_t uxQueueLength, UBaseType_t uxPriority);
+
+/*
+ * Posts a job. pxCallback can be NULL.
+ * If the queue is full, the caller blocks up to xTicksToWait, and pdFAIL is returned if there is still no room.
+ */
+BaseType_t xJobDispatcherSubmit(JobDispatcher_t *pxDispatcher, JobFunction_t pxFunction, void *pvParameter,
+		JobCompleteCallback_t pxCallback, TickType_t xTicksToWait);
+BaseType_t xJobDispatcherSubmitFromISR(JobDispatcher_t *pxDispatcher, JobFunction_t pxFunction, void *pvParameter,
+		JobCompleteCallback_t pxCallback, BaseType_t *pxHigherPriorityTaskWoken);
+
+//Number of jobs waiting for a worker
+UBaseType_t uxJobDispatcherPending(JobDispatcher_t *pxDispatcher);
+
+void vJobDispatcherGetStats(JobDispatcher_t *pxDispatcher, JobDispatcherStats_t *pxStats);
+void vJobDispatcherResetStats(JobDispatcher_t *pxDispatcher);
+
+#endif /* JOBDISPATCHER_H_ */
@@ -0,0 +1,69 @@
+/*
+ * LowPower.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * Tickless idle of FreeRTOS (configUSE_TICKLESS_IDLE 2) with the choice of the low power mode.
+ * When the idle task has nothing to do, the kernel calls vLowPowerSuppressTicksAndSleep() with the
+ * number of ticks until the next task wakes up:
+ *   - if a driver holds a vote (I/O in progress which needs the peripheral clocks, like a UART
+ *     transmission), or if the idle time is shorter than LOW_POWER_STOP2_MIN_TICKS: sleep mode (WFI),
+ *     the SysTick keeps running;
+ *   - otherwise: STOP2. The SysTick is stopped and LPTIM1 (clocked by the LSE, it runs in STOP2)
+ *     wakes up the CPU at the next task wake-up time; the tick count is then stepped by the time spent
+ *     in STOP2. An interrupt of a peripheral which runs in STOP2 (LPUART1, EXTI) wakes it up earlier.
+ *
+ * The CPU wakes up from STOP2 on the MSI, at its range before STOP2: the system clock must be the MSI.
+ * The debugger connection is lost in STOP2, unless DBGMCU keeps it (more consumption).
+ */
+
+#ifndef LOWPOWER_H_
+#define LOWPOWER_H_
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+//Shorter idle times (ticks) use the sleep mode: the STOP2 entry and exit are not worth it
+#define LOW_POWER_STOP2_MIN_TICKS		5
+
+//Longest STOP2 (ticks): LPTIM1 counts 16 bits at the LSE frequency, it wraps after 2 seconds
+#define LOW_POWER_MAX_STOP2_TICKS		pdMS_TO_TICKS(1900)
+
+//Time allowed to the LSE to start (ms)
+#define LOW_POWER_LSE_TIMEOUT_MS		2000
+
+//Priority of the LPTIM1 interrupt. It should be less than or equal to configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY.
+#define LOW_POWER_IRQ_PRIORITY			6
+
+typedef struct LowPowerStats
+{
+	uint32_t ulSleepEntries;
+	uint32_t ulStop2Entries;
+	uint32_t ulStop2Ticks;				//Ticks stepped after the STOP2 periods
+	uint32_t ulEarlyWakeups;			//STOP2 periods ended by another interrupt than LPTIM1
+	uint32_t ulVetoed;					//Idle periods long enough for STOP2, spent in sleep mode because of a vote
+}LowPowerStats_t;
+
+/*
+ * Starts the LSE and LPTIM1, and keeps CPU2 (not started) from blocking STOP2.
+ * It must be called before vTaskStartScheduler(). Returns pdFAIL if the LSE does not start.
+ */
+BaseType_t xLowPowerInit(void);
+
+/*
+ * Votes of the drivers: while at least one vote is held, the idle time is spent in sleep mode, not in STOP2.
+ * The calls must be paired. From a task or an interrupt.
+ */
+void vLowPowerHoldSleep(void);
+void vLowPowerReleaseSleep(void);
+
+//Copies the statistics and resets them
+void vLowPowerGetStats(LowPowerStats_t *pxStats);
+
+//Called by the kernel (portSUPPRESS_TICKS_AND_SLEEP in FreeRTOSConfig.h), with the scheduler suspended
+void vLowPowerSuppressTicksAndSleep(TickType_t xExpectedIdleTime);
+
+#endif /* LOWPOWER_H_ */
@@ -0,0 +1,70 @@
+/*
+ * LpuartConsole.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * Serial console on LPUART1 (LL driver), clocked by the LSE: it keeps receiving while the device is in STOP2.
+ * The start bit of a received character (or the address match, see LPUART_CONSOLE_WAKEUP) wakes up the
+ * CPU, and the byte is received in STOP2 or after the wake-up: no character is lost, even the first one.
+ *
+ * Both directions use rings filled and emptied by the LPUART interrupt. While characters are being
+ * sent, the console holds a sleep vote (LowPower.h): the interrupt which sends the ring byte by byte
+ * needs the CPU awake, so the idle time is spent in sleep mode instead of STOP2.
+ *
+ * LPUART1 on PA2 (TX) and PA3 (RX), 8N1. The LSE has to be started (xLowPowerInit()) before xLpuartConsoleInit().
+ */
+
+#ifndef LPUARTCONSOLE_H_
+#define LPUARTCONSOLE_H_
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stm32wbxx_ll_lpuart.h"
+
+//Clocked by the LSE (32768 Hz), the LPUART is limited to 9600 baud
+#define LPUART_CONSOLE_BAUD_RATE		9600
+
+/*
+ * Event which wakes up the CPU from STOP2: LL_LPUART_WAKEUP_ON_STARTBIT (any character), or
+ * LL_LPUART_WAKEUP_ON_ADDRESS (only a character with LPUART_CONSOLE_ADDRESS in its 4 lower bits and
+ * the bit 7 set, on a bus shared by several devices: the other characters are ignored in mute mode).
+ */
+#define LPUART_CONSOLE_WAKEUP			LL_LPUART_WAKEUP_ON_STARTBIT
+#define LPUART_CONSOLE_ADDRESS			0x1
+
+//Sizes of the rings. They must be powers of 2.
+#define LPUART_CONSOLE_TX_SIZE			256
+#define LPUART_CONSOLE_RX_SIZE			64
+
+//Task notification index used to wait for the rings (the default index stays free for the application)
+#define LPUART_CONSOLE_NOTIFY_INDEX		1
+
+//Priority of the LPUART1 interrupt. It should be less than or equal to configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY.
+#define LPUART_CONSOLE_IRQ_PRIORITY		6
+
+typedef struct LpuartConsoleStats
+{
+	uint32_t ulTxBytes;
+	uint32_t ulRxBytes;
+	uint32_t ulWakeups;				//Wake-up events (start bit or address match)
+	uint32_t ulRxDropped;			//Bytes lost: receive ring full, overrun, framing or noise error
+}LpuartConsoleStats_t;
+
+//Initializes LPUART1, its pins and interrupt. It must be called before vTaskStartScheduler().
+BaseType_t xLpuartConsoleInit(void);
+
+/*
+ * Queues xLength bytes. If the transmit ring is full, the caller blocks up to xTicksToWait.
+ * Returns the number of bytes queued. The messages of several writers are not interleaved.
+ */
+size_t xLpuartConsoleWrite(const uint8_t *pucData, size_t xLength, TickType_t xTicksToWait);
+
+//Blocks up to xTicksToWait for received bytes. Returns the number of bytes copied (at most xLength).
+size_t xLpuartConsoleRead(uint8_t *pucBuffer, size_t xLength, TickType_t xTicksToWait);
+
+void vLpuartConsoleGetStats(LpuartConsoleStats_t *pxStats);
+
+#endif /* LPUARTCONSOLE_H_ */
@@ -0,0 +1,98 @@
+/*
+ * Mailbox.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * Mailbox between the Cortex-M4 (CPU1) and the Cortex-M0+ (CPU2), in shared memory (SRAM2a, section
+ * MB_MEM2 of LinkerScript.ld).
+ *
+ * Each side sends on its own ring of MAILBOX_SLOTS slots of MAILBOX_SLOT_SIZE bytes, and receives on the ring
+ * of the other side. The messages are not copied: the sender writes its message in the slot given by
+ * pvMailboxAcquire(), then sends it; the receiver reads it in the same slot, then releases it. Each index of
+ * a ring has a single writer (the head: the sender, the tail: the receiver), so the messages need no lock.
+ * The control block (magic number, state of the sides) is guarded by a hardware semaphore (HSEM).
+ *
+ * After each change of a ring (message sent, slot released) the other side is called by an IPCC channel
+ * (the doorbell). Its interrupt clears the channel, then wakes up the tasks of the side which wait for a
+ * message or for a free slot: they check the rings again. A doorbell rung while the channel is still
+ * occupied is not lost, the other side has not checked the rings yet.
+ *
+ * On this board, CPU2 runs the ST wireless firmware, which does not know this mailbox. With MAILBOX_LOOPBACK,
+ * the CPU2 side is used by tasks on CPU1 and its doorbell is a function call: both sides run, on one core.
+ */
+
+#ifndef MAILBOX_H_
+#define MAILBOX_H_
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stm32wbxx.h"
+
+//Sides. A side is used by one sending task (or several, serialized by pvMailboxAcquire()) and one receiving task.
+#define MAILBOX_CPU1					0
+#define MAILBOX_CPU2					1
+
+//1: the CPU2 side is used on CPU1 (see above). 0: it is used by a firmware on CPU2.
+#define MAILBOX_LOOPBACK				1
+
+//Ring of each side. Both sides must be built with the same values.
+#define MAILBOX_SLOTS					8
+#define MAILBOX_SLOT_SIZE				256
+
+//IPCC channel of the doorbells (one per direction, with the same number) and hardware semaphore of the control block
+#define MAILBOX_IPCC_CHANNEL			IPCC_CHANNEL_6
+#define MAILBOX_HSEM_ID					8
+
+//Task notification index used to wait for a message or a free slot (a task waits for one driver at a time)
+#define MAILBOX_NOTIFY_INDEX			2
+
+//Priority of the IPCC interrupt. It should be less than or equal to configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY.
+#define MAILBOX_IRQ_PRIORITY			6
+
+//A received message: it stays in its slot until vMailboxRelease()
+typedef struct MailboxMessage
+{
+	uint16_t usType;					//Given by the sender, for the application
+	uint16_t usLength;
+	void *pvData;
+}MailboxMessage_t;
+
+typedef struct MailboxStats
+{
+	uint32_t ulSent;
+	uint32_t ulReceived;
+	uint32_t ulDoorbells;				//Doorbells received
+	uint32_t ulFullWaits;				//pvMailboxAcquire() calls which waited for a free slot
+}MailboxStats_t;
+
+/*
+ * Enables the IPCC and HSEM clocks, resets the rings and marks CPU1 (and CPU2 with MAILBOX_LOOPBACK) as up.
+ * It must be called before vTaskStartScheduler(). Returns pdFAIL if the control block is locked by CPU2.
+ */
+BaseType_t xMailboxInit(void);
+
+/*
+ * Gives the next free slot of the ring of ucSide (MAILBOX_SLOT_SIZE bytes), waiting up to xTicksToWait for it.
+ * The slot belongs to the calling task until vMailboxSend(), which must follow: the other senders of the side
+ * wait. Returns NULL on timeout.
+ */
+void *pvMailboxAcquire(uint8_t ucSide, TickType_t xTicksToWait);
+
+//Sends the slot of pvMailboxAcquire() with usLength bytes (at most MAILBOX_SLOT_SIZE), and rings the doorbell
+void vMailboxSend(uint8_t ucSide, uint16_t usType, uint16_t usLength);
+
+/*
+ * Gives the oldest message sent by the other side, waiting up to xTicksToWait for it.
+ * Returns pdFAIL on timeout. Only one task receives on a side.
+ */
+BaseType_t xMailboxReceive(uint8_t ucSide, MailboxMessage_t *pxMessage, TickType_t xTicksToWait);
+
+//Gives the slot of a received message back to the sender. The messages are released in the order received.
+void vMailboxRelease(uint8_t ucSide, const MailboxMessage_t *pxMessage);
+
+void vMailboxGetStats(uint8_t ucSide, MailboxStats_t *pxStats);
+
+#endif /* MAILBOX_H_ */
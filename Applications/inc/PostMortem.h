@@ -0,0 +1,94 @@
+/*
+ * PostMortem.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * Post-mortem trace: the last SystemView events, kept in RAM across a crash and the reset which follows.
+ *
+ * With SEGGER_SYSVIEW_POST_MORTEM_MODE 1 (SEGGER_SYSVIEW_Conf.h), SystemView records without a probe: the
+ * events go into a ring (the RTT buffer, SEGGER_SYSVIEW_RTT_BUFFER_SIZE bytes) which overwrites the oldest
+ * ones, with a sync and the system information (task names, description) every 2^SEGGER_SYSVIEW_SYNC_PERIOD_SHIFT
+ * packets, so the tail of the ring can be decoded alone. The ring is in .noinit: the startup does not clear it.
+ *
+ * The HardFault handler (here) and a failed configASSERT() (configUSE_POST_MORTEM 1 in FreeRTOSConfig.h)
+ * freeze the ring: a last event is recorded, the recording stops, and a record of the crash (cause, fault
+ * registers, task, position of the oldest byte) is written in .noinit. Then the MCU is reset (POST_MORTEM_RESET).
+ * At the next start the capture is held: the recording does not start again before the capture has been
+ * dumped and released, so it cannot be overwritten.
+ *
+ * The dump is text, given line by line to a function of the application (UART, RTT terminal...):
+ *   PM-BEGIN reason=<name> bytes=<count> crc=<CRC-32 of the bytes, hex> later=<crashes while held>
+ *   PM-FAULT pc=<hex> lr=<hex> psr=<hex> cfsr=<hex> hfsr=<hex> addr=<hex> task=<name>
+ *   PM-ASSERT file=<name> line=<number> task=<name>
+ *   PM-DATA <offset, hex> <POST_MORTEM_LINE_BYTES bytes, hex>
+ *   PM-END
+ * The bytes are the ring from its oldest byte to its newest one. Tools/postmortem_decode.py reads a log
+ * holding a dump, checks it, writes a .SVDat file for SystemView and prints the last events before the crash.
+ */
+
+#ifndef POSTMORTEM_H_
+#define POSTMORTEM_H_
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+//1: reset the MCU once the ring is frozen by a HardFault or a failed configASSERT(). 0: stop there (debugger).
+#define POST_MORTEM_RESET				1
+
+//Bytes of the ring per PM-DATA line
+#define POST_MORTEM_LINE_BYTES			32
+
+//Characters of the file name kept for a failed configASSERT() (the end of __FILE__)
+#define POST_MORTEM_FILE_NAME_LEN		24
+
+//Causes of a freeze
+#define POST_MORTEM_NONE				0
+#define POST_MORTEM_HARDFAULT			1
+#define POST_MORTEM_ASSERT				2
+#define POST_MORTEM_REQUEST				3			//vPostMortemFreeze() of the application
+
+//Crash of the held capture
+typedef struct PostMortemInfo
+{
+	uint32_t ulReason;
+	uint32_t ulPC;								//HardFault: stacked PC, LR and xPSR of the faulting code
+	uint32_t ulLR;
+	uint32_t ulPSR;
+	uint32_t ulCFSR;							//HardFault: fault status registers, and BFAR or MMFAR when valid
+	uint32_t ulHFSR;
+	uint32_t ulFaultAddress;
+	uint32_t ulLine;							//configASSERT(): line and end of the file name
+	char cFile[POST_MORTEM_FILE_NAME_LEN];
+	char cTask[configMAX_TASK_NAME_LEN];		//Running task ("" before the scheduler)
+	uint32_t ulBytes;							//Bytes of the ring in the capture
+	uint32_t ulLaterFaults;						//Crashes while the capture was held (not recorded)
+}PostMortemInfo_t;
+
+/*
+ * Looks for a capture kept across the reset. It must be called after SEGGER_SYSVIEW_Conf(), instead of
+ * SEGGER_SYSVIEW_Start(): if there is no capture, the ring is cleared and the recording is started.
+ */
+void vPostMortemInit(void);
+
+//pdTRUE if a capture is held (pxInfo is then filled, it may be NULL)
+BaseType_t xPostMortemHeld(PostMortemInfo_t *pxInfo);
+
+/*
+ * Writes the held capture as text lines (without line ending) with pvWriteLine. It takes a while: the ring
+ * is written in hex. Writes "PM-NONE" if no capture is held.
+ */
+void vPostMortemDump(void (*pvWriteLine)(const char *pcLine));
+
+//Forgets the held capture, clears the ring and starts the recording again. From a task.
+void vPostMortemRelease(void);
+
+//Freezes the ring now, without reset (POST_MORTEM_REQUEST): e.g. when the application detects an error
+void vPostMortemFreeze(void);
+
+//Called by configASSERT() (FreeRTOSConfig.h) with the interrupts masked
+void vPostMortemAssert(const char *pcFile, uint32_t ulLine);
+
+#endif /* POSTMORTEM_H_ */
@@ -0,0 +1,59 @@
+/*
+ * Random.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * Random numbers for the tasks and the interrupts, instead of rand() of the C library (one hidden state
+ * shared by all the callers, which is not protected and is kept in the reentrancy structure).
+ *
+ * The RNG peripheral fills a pool of true random words by interrupt, in the background.
+ * Each caller (task or interrupt) has its own stream: a fast pseudo random generator (xoshiro128**,
+ * of the xorshift family) seeded from the pool. A stream is only used by its owner, so getting a number
+ * needs no lock and no access to the RNG. The pool is read (in a short critical section) only to seed
+ * the streams, or directly by the callers which need true random words (keys, nonces).
+ *
+ * The streams are not a cryptographic generator: their output can be predicted from a few outputs.
+ */
+
+#ifndef RANDOM_H_
+#define RANDOM_H_
+
+#include "FreeRTOS.h"
+
+//Words of the pool of true random numbers
+#define RANDOM_POOL_WORDS				32
+
+//Priority of the RNG interrupt. It should be less than or equal to configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY.
+#define RANDOM_IRQ_PRIORITY				6
+
+//State of a stream. One stream per task (or per interrupt); the streams are not shared.
+typedef struct RandomStream
+{
+	uint32_t ulState[4];
+}RandomStream_t;
+
+/*
+ * Starts the RNG (HSI48 clock) and fills the pool. Call it before the streams are started.
+ * Returns pdFAIL if the RNG does not work: the streams are then seeded from the cycle counter.
+ */
+BaseType_t xRandomInit(void);
+
+/*
+ * Copies up to xWords true random words from the pool, and restarts the filling of the pool.
+ * Returns the number of words copied (less than xWords if the pool is not full yet). From a task or an interrupt.
+ */
+size_t xRandomGetEntropy(uint32_t *pulWords, size_t xWords);
+
+//Seeds the stream from the pool
+void vRandomStreamInit(RandomStream_t *pxStream);
+
+//Next 32 bit number of the stream
+uint32_t ulRandomNext(RandomStream_t *pxStream);
+
+//Number in [0, ulRange - 1], without the bias of the modulo
+uint32_t ulRandomRange(RandomStream_t *pxStream, uint32_t ulRange);
+
+#endif /* RANDOM_H_ */
@@ -0,0 +1,77 @@
+/*
+ * RtcClock.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * Wall clock with the RTC on the LSE, with millisecond resolution.
+ *
+ * The calendar registers are read (sub-seconds, time and date, with the shadow register unlock) only
+ * when the clock is set, and every RTC_CLOCK_RESYNC_MS by a software timer. Each read gives a base: the
+ * RTC time in ms paired with the tick count of the read. The time is then the base plus the ticks elapsed
+ * since it: ullRtcClockNowMs() reads no peripheral register, it is cheap enough to stamp every log record.
+ *
+ * The time is in ms since 2000-01-01 00:00:00 (the RTC years are 2000 to 2099), in a uint64_t.
+ * It never goes back, except when the clock is set: a resync which finds the ticks ahead of the RTC
+ * holds the time until the RTC catches up.
+ *
+ * The RTC keeps running across resets (backup domain): once set, the time is kept until the power is lost.
+ */
+
+#ifndef RTCCLOCK_H_
+#define RTCCLOCK_H_
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+//Period of the resync with the RTC: the drift of the tick against the LSE is corrected at this period
+#define RTC_CLOCK_RESYNC_MS			60000
+
+//Time allowed to the LSE to start (ms)
+#define RTC_CLOCK_LSE_TIMEOUT_MS	2000
+
+//Size of the text of xRtcClockFormat(), with the '\0': "2026-10-19 12:34:56.789"
+#define RTC_CLOCK_TEXT_SIZE			24
+
+typedef struct RtcDateTime
+{
+	uint16_t usYear;				//2000 to 2099
+	uint8_t ucMonth;				//1 to 12
+	uint8_t ucDay;					//1 to 31
+	uint8_t ucHours;
+	uint8_t ucMinutes;
+	uint8_t ucSeconds;
+	uint16_t usMilliseconds;
+}RtcDateTime_t;
+
+/*
+ * Starts the LSE and the RTC (if it is not already running since an earlier start), reads the first base
+ * and creates the resync timer. It must be called before vTaskStartScheduler().
+ * Returns pdFAIL if the LSE or the RTC does not start.
+ */
+BaseType_t xRtcClockInit(void);
+
+//pdTRUE if the clock was set (xRtcClockSet()) since the last loss of the backup domain
+BaseType_t xRtcClockIsSet(void);
+
+/*
+ * Sets the RTC (the milliseconds are ignored, the RTC starts the second at 0) and the base.
+ * From a task. Returns pdFAIL if the date is not valid.
+ */
+BaseType_t xRtcClockSet(const RtcDateTime_t *pxDateTime);
+
+//Time in ms since 2000-01-01 00:00:00. From a task or an interrupt, no peripheral access.
+uint64_t ullRtcClockNowMs(void);
+
+//Date and time of a time in ms (e.g. a stamp of ullRtcClockNowMs()). No peripheral access.
+void vRtcClockToDateTime(uint64_t ullMs, RtcDateTime_t *pxDateTime);
+
+/*
+ * Writes a time in ms as "YYYY-MM-DD hh:mm:ss.mmm". xSize must be at least RTC_CLOCK_TEXT_SIZE.
+ * Returns the length of the text.
+ */
+size_t xRtcClockFormat(uint64_t ullMs, char *pcBuffer, size_t xSize);
+
+#endif /* RTCCLOCK_H_ */
@@ -0,0 +1,126 @@
+/*
+ * SpiBus.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * SPI master driver shared by the tasks. A task submits a transaction and is free until its end: the
+ * transfers are done by DMA, and the DMA interrupt wakes up the task by task notification. The transactions
+ * submitted while the bus is busy are kept in a list (one list per bus) and started one after the other
+ * from the interrupt.
+ *
+ * A transaction is a list of segments. Each segment is one transfer with one device, and the driver drives
+ * the chip select (CS) of the device around it. The segments of a transaction are chained from the DMA
+ * interrupt without waking up the task in between: a task can batch the accesses to several devices,
+ * or the command and data phases of one access (ucKeepCs), in one transaction.
+ *
+ * Statistics: the time of each transaction in the list and on the bus, and the busy time of each bus,
+ * in CPU cycles (DWT cycle counter).
+ */
+
+#ifndef SPIBUS_H_
+#define SPIBUS_H_
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stm32wbxx.h"
+
+//Buses: SPI1 on PA5 (SCK), PA6 (MISO), PA7 (MOSI), DMA1 channels 2 (RX) and 3 (TX)
+//       SPI2 on PB13 (SCK), PB14 (MISO), PB15 (MOSI), DMA1 channels 4 (RX) and 5 (TX)
+#define SPI_BUS_1						0
+#define SPI_BUS_2						1
+#define SPI_BUS_COUNT					2
+
+//Task notification index used to wait for the end of the transactions (a task waits for one driver at a time)
+#define SPI_BUS_NOTIFY_INDEX			2
+
+//Priority of the DMA and SPI interrupts. It should be less than or equal to configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY.
+#define SPI_BUS_IRQ_PRIORITY			6
+
+//One device on a bus. Its CS pin is active low. The SPI clock is the bus clock (PCLK) / ulPrescaler.
+typedef struct SpiDevice
+{
+	uint8_t ucBus;						//SPI_BUS_1 or SPI_BUS_2
+	GPIO_TypeDef *pxCsPort;
+	uint16_t usCsPin;
+	uint32_t ulPrescaler;				//SPI_BAUDRATEPRESCALER_2 ... SPI_BAUDRATEPRESCALER_256
+	uint32_t ulPolarity;				//SPI_POLARITY_LOW or SPI_POLARITY_HIGH
+	uint32_t ulPhase;					//SPI_PHASE_1EDGE or SPI_PHASE_2EDGE
+}SpiDevice_t;
+
+/*
+ * One transfer of usLength bytes. Without pucTx, the bytes of pucRx are sent (set them to the value the device
+ * expects, 0xFF for most of them). Without pucRx, the received bytes are dropped.
+ */
+typedef struct SpiSegment
+{
+	const SpiDevice_t *pxDevice;
+	const uint8_t *pucTx;
+	uint8_t *pucRx;
+	uint16_t usLength;
+	uint8_t ucKeepCs;					//1: CS stays low for the next segment (same device), 0: CS high at the end
+}SpiSegment_t;
+
+/*
+ * One transaction. The caller sets the segments (all on the same bus); the segments, their buffers and
+ * the transaction must stay valid until the end of the transaction.
+ */
+typedef struct SpiTransaction
+{
+	const SpiSegment_t *pxSegments;
+	uint8_t ucSegments;
+
+	//Set by the driver
+	TaskHandle_t xTask;					//Task notified at the end of the transaction
+	struct SpiTransaction *pxNext;		//Next transaction waiting for the bus
+	uint8_t ucSegment;					//Segment on the bus
+	uint32_t ulSubmitCycle;
+	uint32_t ulStartCycle;
+	uint32_t ulQueueCycles;				//CPU cycles in the list of the bus (latency before the start)
+	uint32_t ulBusCycles;				//CPU cycles from the start of the first segment to the end of the last one
+	volatile uint8_t ucDone;
+	volatile uint8_t ucError;			//SPI or DMA error: the segments from ucSegment are not done
+}SpiTransaction_t;
+
+//Statistics of one bus, since the last reset
+typedef struct SpiBusStats
+{
+	uint32_t ulTransactions;
+	uint32_t ulSegments;
+	uint32_t ulBytes;
+	uint32_t ulErrors;
+	uint32_t ulBusyCycles;				//Sum of ulBusCycles of the transactions
+	uint32_t ulMaxQueueCycles;
+	uint32_t ulMaxLatencyCycles;		//Largest ulQueueCycles + ulBusCycles
+}SpiBusStats_t;
+
+/*
+ * Initializes the SPI, its pins, its DMA channels and interrupts. Returns pdFAIL if it could not be initialized.
+ * Not from an interrupt, and before the devices of the bus are used.
+ */
+BaseType_t xSpiBusInit(uint8_t ucBus);
+
+//Configures the CS pin of the device as an output, high (not selected)
+void vSpiDeviceInit(const SpiDevice_t *pxDevice);
+
+/*
+ * Starts the transaction, or puts it in the list of its bus if the bus is busy. Not from an interrupt.
+ */
+void vSpiSubmit(SpiTransaction_t *pxTransaction);
+
+/*
+ * Blocks the calling task (the one which submitted the transaction) until the end of the transaction.
+ * Returns pdFAIL if it is not done after xTicksToWait, or if it ended with an error.
+ */
+BaseType_t xSpiWait(SpiTransaction_t *pxTransaction, TickType_t xTicksToWait);
+
+//One segment, submit and wait. Returns pdFAIL on error.
+BaseType_t xSpiTransfer(const SpiDevice_t *pxDevice, const uint8_t *pucTx, uint8_t *pucRx, uint16_t usLength);
+
+//Copy of the statistics of the bus (vSpiBusGetStats() resets them too)
+void vSpiBusGetStats(uint8_t ucBus, SpiBusStats_t *pxStats);
+void vSpiBusResetStats(uint8_t ucBus);
+
+#endif /* SPIBUS_H_ */
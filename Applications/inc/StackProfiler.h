@@ -0,0 +1,59 @@
+/*
+ * StackProfiler.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * Stack usage profiler.
+ * It reports, for every task, the stack size, the maximum usage seen so far (high water mark)
+ * and a recommended stack size with a safety margin. The main stack (used by main() and the
+ * interrupt handlers) is measured with the same fill pattern scan.
+ *
+ * StackProfiler.c also implements vApplicationStackOverflowHook(), built when configCHECK_FOR_STACK_OVERFLOW
+ * is set in FreeRTOSConfig.h (2: the pattern check at each context switch, which costs time in every switch).
+ */
+
+#ifndef STACKPROFILER_H_
+#define STACKPROFILER_H_
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+//Maximum number of tasks in the report, and of tasks whose stack size can be registered
+#define STACK_PROFILER_MAX_TASKS			12
+
+//Recommended size = usage + margin (at least STACK_PROFILER_MIN_MARGIN_WORDS), rounded up to STACK_PROFILER_ALIGN_WORDS
+#define STACK_PROFILER_MARGIN_PERCENT		25
+#define STACK_PROFILER_MIN_MARGIN_WORDS		32
+#define STACK_PROFILER_ALIGN_WORDS			8
+
+//Stack sizes and usages are in words (like the usStackDepth parameter of xTaskCreate())
+typedef struct StackProfile
+{
+	const char *pcTaskName;
+	uint32_t ulStackWords;			//0 if the task has not been registered
+	uint32_t ulUsedWords;
+	uint32_t ulRecommendedWords;	//0 if the task has not been registered
+}StackProfile_t;
+
+//Fills the free part of the main stack with the fill pattern. It should be called at the beginning of main().
+void vStackProfilerInit(void);
+
+/*
+ * Tells the profiler the stack size given to xTaskCreate() for a task. The Idle and Timer
+ * tasks are known already. The usage of unregistered tasks is reported without recommendation.
+ */
+void vStackProfilerRegister(TaskHandle_t xTask, uint32_t ulStackWords);
+
+//Fills pxProfiles with the running tasks and returns their number
+UBaseType_t uxStackProfilerSample(StackProfile_t *pxProfiles, UBaseType_t uxMaxProfiles);
+
+//Main stack size and maximum usage in words
+void vStackProfilerMainStack(uint32_t *pulStackWords, uint32_t *pulUsedWords);
+
+//Prints the report line by line with pxPrint (e.g. printmsg)
+void vStackProfilerPrintReport(void (*pxPrint)(char *msg));
+
+#endif /* STACKPROFILER_H_ */
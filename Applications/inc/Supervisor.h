@@ -0,0 +1,79 @@
+/*
+ * Supervisor.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * Health supervisor of the tasks with the independent watchdog (IWDG).
+ *
+ * Each supervised task registers itself with a deadline, then checks in (SUPERVISOR_CHECK_IN) at least
+ * once per deadline, e.g. once per loop. The supervisor task runs every SUPERVISOR_PERIOD_MS and
+ * refreshes the IWDG only if every registered task checked in within its deadline. When a task misses
+ * its deadline, the supervisor writes its name in a RAM section which is not initialized at the start
+ * (.noinit), and stops refreshing the IWDG: the MCU is reset, and the record is read at the next start.
+ *
+ * A check-in is the increment of a counter of the task (no lock, no kernel call): each counter has a single
+ * writer, the supervisor only reads them.
+ *
+ * If the supervisor task itself cannot run (interrupts masked by configASSERT(), an interrupt which never
+ * returns), the IWDG resets the MCU without record: the report says that no task was identified.
+ */
+
+#ifndef SUPERVISOR_H_
+#define SUPERVISOR_H_
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define SUPERVISOR_MAX_TASKS			8
+
+//Period of the supervisor task. The deadlines are checked with this resolution.
+#define SUPERVISOR_PERIOD_MS			100
+
+//IWDG timeout (LSI at 32 kHz, prescaler 64: at most 8 seconds). It must be longer than SUPERVISOR_PERIOD_MS.
+#define SUPERVISOR_IWDG_TIMEOUT_MS		1000
+
+//The supervisor runs above the supervised tasks, so a task which never blocks does not stop it
+#define SUPERVISOR_TASK_PRIORITY		( configMAX_PRIORITIES - 1 )
+
+#define SUPERVISOR_NO_SLOT				( -1 )
+
+//Check-in of a registered task (its slot, from xSupervisorRegister()). Only the task itself checks in.
+#define SUPERVISOR_CHECK_IN( xSlot )	( ulSupervisorCheckIns[ (xSlot) ]++ )
+
+//Check-in counters, one per slot. Only for SUPERVISOR_CHECK_IN.
+extern volatile uint32_t ulSupervisorCheckIns[SUPERVISOR_MAX_TASKS];
+
+//Cause of the last reset, given by xSupervisorLastReset()
+typedef struct SupervisorReport
+{
+	BaseType_t xWatchdogReset;					//pdTRUE: the last reset was done by the IWDG
+	BaseType_t xSlot;							//Slot of the task which missed its deadline, SUPERVISOR_NO_SLOT if none was identified
+	char cTaskName[configMAX_TASK_NAME_LEN];
+	uint32_t ulDeadlineMs;
+	uint32_t ulLateMs;							//Time since its last check-in, when it was found late
+	uint32_t ulUptimeMs;						//Time from the start to the detection
+}SupervisorReport_t;
+
+/*
+ * Reads (and clears) the record of the last reset, starts the IWDG and creates the supervisor task.
+ * It must be called just before vTaskStartScheduler(): the first refresh comes SUPERVISOR_PERIOD_MS after
+ * the start of the scheduler. Once started, the IWDG cannot be stopped.
+ */
+BaseType_t xSupervisorInit(void);
+
+//Cause of the last reset, read by xSupervisorInit()
+void vSupervisorLastReset(SupervisorReport_t *pxReport);
+
+/*
+ * Registers the calling task: from now on it has to check in at least every xDeadline ticks.
+ * Returns its slot, or SUPERVISOR_NO_SLOT if all the slots are used.
+ */
+BaseType_t xSupervisorRegister(TickType_t xDeadline);
+
+//Ends the supervision of a slot (e.g. before the task deletes itself)
+void vSupervisorUnregister(BaseType_t xSlot);
+
+#endif /* SUPERVISOR_H_ */
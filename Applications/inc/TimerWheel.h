@@ -0,0 +1,72 @@
+/*
+ * TimerWheel.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * Hierarchical timer wheel service.
+ * It keeps the shape of the FreeRTOS xTimer* API, but timers are started and stopped
+ * directly on the wheel in O(1) instead of going through the timer command queue
+ * and the sorted active timer list of timers.c.
+ */
+
+#ifndef TIMERWHEEL_H_
+#define TIMERWHEEL_H_
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+//Number of timers in the static pool (no heap is used for the timers)
+#ifndef TIMER_WHEEL_MAX_TIMERS
+#define TIMER_WHEEL_MAX_TIMERS			1000
+#endif
+
+//Wheel geometry: 256 one-tick slots in level 0, then 4 levels of 64 slots (covers 32 bit tick count)
+#define TIMER_WHEEL_L0_BITS				8
+#define TIMER_WHEEL_LN_BITS				6
+#define TIMER_WHEEL_LEVELS				5
+
+typedef struct TimerWheelTimer * TimerWheelHandle_t;
+typedef void (*TimerWheelCallback_t)(TimerWheelHandle_t xTimer);
+
+/*
+ * Creates the timer service task. It must be called before vTaskStartScheduler().
+ * The timer callbacks are executed in the context of this task.
+ */
+BaseType_t xTimerWheelInit(UBaseType_t uxPriority, configSTACK_DEPTH_TYPE usStackDepth);
+
+/*
+ * Same parameters as xTimerCreate(). The timer is taken from the static pool,
+ * NULL is returned when the pool is exhausted.
+ */
+TimerWheelHandle_t xTimerWheelCreate(const char * const pcTimerName, TickType_t xTimerPeriodInTicks,
+		UBaseType_t uxAutoReload, void * const pvTimerID, TimerWheelCallback_t pxCallbackFunction);
+
+/*
+ * xTicksToWait is kept for compatibility with the xTimer* calls. There is no command
+ * queue to block on, so the operation always completes immediately.
+ */
+BaseType_t xTimerWheelStart(TimerWheelHandle_t xTimer, TickType_t xTicksToWait);
+BaseType_t xTimerWheelStop(TimerWheelHandle_t xTimer, TickType_t xTicksToWait);
+BaseType_t xTimerWheelChangePeriod(TimerWheelHandle_t xTimer, TickType_t xNewPeriod, TickType_t xTicksToWait);
+BaseType_t xTimerWheelDelete(TimerWheelHandle_t xTimer, TickType_t xTicksToWait);
+#define xTimerWheelReset(xTimer, xTicksToWait)		xTimerWheelStart((xTimer), (xTicksToWait))
+
+//Interrupt safe versions
+BaseType_t xTimerWheelStartFromISR(TimerWheelHandle_t xTimer, BaseType_t *pxHigherPriorityTaskWoken);
+BaseType_t xTimerWheelStopFromISR(TimerWheelHandle_t xTimer, BaseType_t *pxHigherPriorityTaskWoken);
+BaseType_t xTimerWheelChangePeriodFromISR(TimerWheelHandle_t xTimer, TickType_t xNewPeriod, BaseType_t *pxHigherPriorityTaskWoken);
+#define xTimerWheelResetFromISR(xTimer, pxHigherPriorityTaskWoken)	xTimerWheelStartFromISR((xTimer), (pxHigherPriorityTaskWoken))
+
+//Accessors
+BaseType_t xTimerWheelIsTimerActive(TimerWheelHandle_t xTimer);
+void *pvTimerWheelGetTimerID(TimerWheelHandle_t xTimer);
+void vTimerWheelSetTimerID(TimerWheelHandle_t xTimer, void *pvNewID);
+const char *pcTimerWheelGetName(TimerWheelHandle_t xTimer);
+TickType_t xTimerWheelGetPeriod(TimerWheelHandle_t xTimer);
+TickType_t xTimerWheelGetExpiryTime(TimerWheelHandle_t xTimer);
+TaskHandle_t xTimerWheelGetTaskHandle(void);
+
+#endif /* TIMERWHEEL_H_ */
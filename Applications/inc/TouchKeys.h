@@ -0,0 +1,101 @@
+/*
+ * TouchKeys.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * Capacitive touch keys on the TSC peripheral.
+ *
+ * Each key is an electrode on a channel IO of its own TSC group, with a sampling capacitor on another IO of
+ * the group. The groups are acquired in parallel by the hardware: one acquisition measures all the keys.
+ * A software timer starts an acquisition every TOUCH_SCAN_PERIOD_MS; at its end, the TSC interrupt reads
+ * the counts (charge transfers to fill the sampling capacitor: a finger on the electrode lowers it) and,
+ * for each key:
+ *   - calibrates the baseline (reference count) on the first TOUCH_CALIBRATION_SCANS acquisitions
+ *   - tracks the baseline while the key is released (slow drift of the environment)
+ *   - compares the delta (baseline - count) to the press and release thresholds (hysteresis), which must
+ *     hold for TOUCH_DEBOUNCE_SCANS acquisitions in a row (debounce)
+ *   - posts a press or release event to the queue of the application
+ * No task runs for the keys: the CPU time is the interrupt (measured) and the start of the acquisitions.
+ *
+ * The keys (pins, groups, IOs) are in the table of TouchKeys.c.
+ */
+
+#ifndef TOUCHKEYS_H_
+#define TOUCHKEYS_H_
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+//Keys of the table of TouchKeys.c
+#define TOUCH_KEYS						2
+
+//Period of the acquisitions
+#define TOUCH_SCAN_PERIOD_MS			20
+
+//Acquisitions averaged for the first baseline
+#define TOUCH_CALIBRATION_SCANS			8
+
+//Thresholds on the delta, in counts. They depend on the electrodes and the overlay: see the deltas printed by TouchKeysExample.c.
+#define TOUCH_PRESS_THRESHOLD			50
+#define TOUCH_RELEASE_THRESHOLD			30
+
+//Acquisitions in a row over (under) the threshold for a press (release)
+#define TOUCH_DEBOUNCE_SCANS			2
+
+//Baseline tracking: baseline += (count - baseline) / 2^TOUCH_BASELINE_SHIFT at each acquisition while released
+#define TOUCH_BASELINE_SHIFT			5
+
+//A key pressed for longer is calibrated again (e.g. water or an object on the electrode), a release event is posted
+#define TOUCH_MAX_PRESS_SCANS			(10000 / TOUCH_SCAN_PERIOD_MS)
+
+//Priority of the TSC interrupt. It should be less than or equal to configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY.
+#define TOUCH_IRQ_PRIORITY				6
+
+//Types of the events
+#define TOUCH_EVENT_PRESS				1
+#define TOUCH_EVENT_RELEASE				2
+
+//One event, as posted to the queue (the queue items must have this size)
+typedef struct TouchEvent
+{
+	uint8_t ucKey;
+	uint8_t ucType;
+	uint16_t usDelta;					//Delta at the event
+	TickType_t xTick;
+}TouchEvent_t;
+
+//State of one key
+typedef struct TouchKeyState
+{
+	uint16_t usCount;					//Last count
+	uint16_t usBaseline;
+	int16_t sDelta;						//Baseline - count
+	uint8_t ucPressed;
+	uint8_t ucCalibrated;
+}TouchKeyState_t;
+
+typedef struct TouchStats
+{
+	uint32_t ulAcquisitions;
+	uint32_t ulMaxCountErrors;			//Groups which reached the max count (electrode not connected)
+	uint32_t ulBusyScans;				//Acquisitions not started: the previous one was not finished
+	uint32_t ulLostEvents;				//Events not posted: the queue was full
+	uint32_t ulInterruptCycles;			//CPU cycles of all the interrupts
+	uint32_t ulWorstInterruptCycles;
+}TouchStats_t;
+
+/*
+ * Initializes the pins, the TSC and the scan timer, and starts the acquisitions (calibration first).
+ * The events are posted to xEventQueue (items of sizeof(TouchEvent_t)) without waiting.
+ * Returns pdFAIL if the TSC or the timer could not be initialized.
+ */
+BaseType_t xTouchKeysInit(QueueHandle_t xEventQueue);
+
+void vTouchKeysGetState(UBaseType_t uxKey, TouchKeyState_t *pxState);
+void vTouchKeysGetStats(TouchStats_t *pxStats);
+
+#endif /* TOUCHKEYS_H_ */
@@ -0,0 +1,63 @@
+/*
+ * UsbCdc.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * USB CDC-ACM device (virtual COM port) on the full speed USB device of the STM32WB55 (HAL PCD driver).
+ * The host sees a serial port like the ST-LINK one, but the data is not limited by a baud rate.
+ *
+ * The IN endpoint sends the data straight from the transmit ring and the OUT endpoint receives the
+ * packets straight into the receive buffers, so there is no intermediate packet copy. The transfer
+ * completions (USB interrupt) wake up the waiting tasks with a task notification (USB_CDC_NOTIFY_INDEX).
+ *
+ * The USB device needs HCLK >= 14.2 MHz: the system clock has to be raised before xUsbCdcInit().
+ */
+
+#ifndef USBCDC_H_
+#define USBCDC_H_
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+//Sizes of the data buffers. The ring size must be a power of 2.
+#define USB_CDC_TX_RING_SIZE			2048
+#define USB_CDC_RX_PACKETS				8
+
+//Maximum size of one IN transfer (several packets sent by the USB interrupt)
+#define USB_CDC_MAX_TX_TRANSFER			512
+
+//Task notification index used to wait for the USB transfers (the default index stays free for the application)
+#define USB_CDC_NOTIFY_INDEX			1
+
+//Priority of the USB interrupt. It should be less than or equal to configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY.
+#define USB_CDC_IRQ_PRIORITY			5
+
+typedef struct UsbCdcStats
+{
+	uint32_t ulTxBytes;
+	uint32_t ulRxBytes;
+	uint32_t ulTxTransfers;
+	uint32_t ulRxPaused;			//OUT packets held back (NAK) because all the receive buffers were full
+}UsbCdcStats_t;
+
+//Initializes the USB device and connects it to the host (D+ pull-up). It must be called before vTaskStartScheduler().
+BaseType_t xUsbCdcInit(void);
+
+//pdTRUE when the host has configured the device and opened the port (DTR set)
+BaseType_t xUsbCdcIsConnected(void);
+
+/*
+ * Queues xLength bytes for the host. If the transmit ring is full, the caller blocks up to xTicksToWait.
+ * Returns the number of bytes queued (0 if the port is not open).
+ */
+size_t xUsbCdcWrite(const uint8_t *pucData, size_t xLength, TickType_t xTicksToWait);
+
+//Blocks up to xTicksToWait for data from the host. Returns the number of bytes copied (at most xLength).
+size_t xUsbCdcRead(uint8_t *pucBuffer, size_t xLength, TickType_t xTicksToWait);
+
+void vUsbCdcGetStats(UsbCdcStats_t *pxStats);
+
+#endif /* USBCDC_H_ */
@@ -0,0 +1,290 @@
+/*
+ * AdcSampler.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * TIM2 update event -> TRGO -> start of one conversion of ADC1 -> DMA request -> one sample in the buffer.
+ * The DMA channel is circular on the whole buffer: its half transfer interrupt means that the first block
+ * is full (the DMA writes the second one), and its transfer complete interrupt that the second block is full.
+ * The CPU only runs at the end of the blocks.
+ *
+ * The interrupt counts the blocks: block N is given to the consumer, and it is valid until the count is N + 1,
+ * when the DMA starts to write its half of the buffer again.
+ *
+ * vAdcReduce() reads the samples as words (two samples):
+ *   sum:      SMLAD with 0x00010001 adds both halves of the word to the sum
+ *   min, max: USUB16 compares both halves, SEL selects the smaller (larger) half of each side
+ *   groups:   QADD16 adds the words of a group half by half (saturated), then both halves are added
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stm32wbxx.h"
+#include "stm32wbxx_hal.h"
+#include "stm32wbxx_ll_tim.h"
+#include "stm32wbxx_ll_bus.h"
+#include "string.h"
+#include "AdcSampler.h"
+
+static ADC_HandleTypeDef AdcHandle;
+static DMA_HandleTypeDef AdcDmaHandle;
+
+//Two blocks of samples, word aligned for vAdcReduce()
+static uint32_t ulBuffer[ADC_SAMPLER_BLOCK_SIZE];
+
+//Changed by the DMA interrupt
+static TaskHandle_t xConsumerTask = NULL;
+static volatile uint32_t ulBlockCount = 0;
+static volatile uint8_t ucLastHalf = 0;
+static volatile uint32_t ulInterruptCycles = 0;
+
+//Last block given to the consumer
+static uint32_t ulLastSequence = 0;
+
+//Private helper functions
+static void prvBlockDone(uint8_t ucHalf);
+
+
+BaseType_t xAdcSamplerInit(void)
+{
+	GPIO_InitTypeDef xAnalogPin;
+	ADC_ChannelConfTypeDef xChannel;
+
+	//1. Analog input
+	__HAL_RCC_GPIOC_CLK_ENABLE();
+	memset(&xAnalogPin, 0, sizeof(xAnalogPin));
+	xAnalogPin.Pin = ADC_SAMPLER_GPIO_PIN;
+	xAnalogPin.Mode = GPIO_MODE_ANALOG;
+	xAnalogPin.Pull = GPIO_NOPULL;
+	HAL_GPIO_Init(ADC_SAMPLER_GPIO_PORT, &xAnalogPin);
+
+	//2. TIM2: one update event (TRGO) per sample. The rate is set by xAdcSamplerStart().
+	LL_APB1_GRP1_EnableClock(LL_APB1_GRP1_PERIPH_TIM2);
+	LL_TIM_DisableCounter(TIM2);
+	LL_TIM_SetPrescaler(TIM2, 0);
+	LL_TIM_SetTriggerOutput(TIM2, LL_TIM_TRGO_UPDATE);
+
+	//3. ADC1: 12 bit, one conversion per trigger, clocked by HCLK / 2
+	__HAL_RCC_ADC_CONFIG(RCC_ADCCLKSOURCE_SYSCLK);
+
+	memset(&AdcHandle, 0, sizeof(AdcHandle));
+	AdcHandle.Instance = ADC1;
+	AdcHandle.Init.ClockPrescaler = ADC_CLOCK_SYNC_PCLK_DIV2;
+	AdcHandle.Init.Resolution = ADC_RESOLUTION_12B;
+	AdcHandle.Init.DataAlign = ADC_DATAALIGN_RIGHT;
+	AdcHandle.Init.ScanConvMode = ADC_SCAN_DISABLE;
+	AdcHandle.Init.EOCSelection = ADC_EOC_SINGLE_CONV;
+	AdcHandle.Init.LowPowerAutoWait = DISABLE;
+	AdcHandle.Init.ContinuousConvMode = DISABLE;
+	AdcHandle.Init.NbrOfConversion = 1;
+	AdcHandle.Init.DiscontinuousConvMode = DISABLE;
+	AdcHandle.Init.ExternalTrigConv = ADC_EXTERNALTRIG_T2_TRGO;
+	AdcHandle.Init.ExternalTrigConvEdge = ADC_EXTERNALTRIGCONVEDGE_RISING;
+	AdcHandle.Init.DMAContinuousRequests = ENABLE;
+	AdcHandle.Init.Overrun = ADC_OVR_DATA_OVERWRITTEN;
+	AdcHandle.Init.OversamplingMode = DISABLE;
+
+	if(HAL_ADC_Init(&AdcHandle) != HAL_OK)
+	{
+		return pdFAIL;
+	}
+
+	memset(&xChannel, 0, sizeof(xChannel));
+	xChannel.Channel = ADC_SAMPLER_CHANNEL;
+	xChannel.Rank = ADC_REGULAR_RANK_1;
+	xChannel.SamplingTime = ADC_SAMPLETIME_24CYCLES_5;
+	xChannel.SingleDiff = ADC_SINGLE_ENDED;
+	xChannel.OffsetNumber = ADC_OFFSET_NONE;
+	xChannel.Offset = 0;
+
+	if( (HAL_ADC_ConfigChannel(&AdcHandle, &xChannel) != HAL_OK) ||
+		(HAL_ADCEx_Calibration_Start(&AdcHandle, ADC_SINGLE_ENDED) != HAL_OK) )
+	{
+		return pdFAIL;
+	}
+
+	//4. DMA1 channel 1: ADC data register to the buffer, half words, circular
+	__HAL_RCC_DMAMUX1_CLK_ENABLE();
+	__HAL_RCC_DMA1_CLK_ENABLE();
+
+	AdcDmaHandle.Instance = DMA1_Channel1;
+	AdcDmaHandle.Init.Request = DMA_REQUEST_ADC1;
+	AdcDmaHandle.Init.Direction = DMA_PERIPH_TO_MEMORY;
+	AdcDmaHandle.Init.PeriphInc = DMA_PINC_DISABLE;
+	AdcDmaHandle.Init.MemInc = DMA_MINC_ENABLE;
+	AdcDmaHandle.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+	AdcDmaHandle.Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+	AdcDmaHandle.Init.Mode = DMA_CIRCULAR;
+	AdcDmaHandle.Init.Priority = DMA_PRIORITY_HIGH;
+
+	if(HAL_DMA_Init(&AdcDmaHandle) != HAL_OK)
+	{
+		return pdFAIL;
+	}
+
+	__HAL_LINKDMA(&AdcHandle, DMA_Handle, AdcDmaHandle);
+
+	NVIC_SetPriority(DMA1_Channel1_IRQn, ADC_SAMPLER_IRQ_PRIORITY); //Priority should be less than or equal to configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY
+	NVIC_EnableIRQ(DMA1_Channel1_IRQn);
+
+	return pdPASS;
+}
+
+BaseType_t xAdcSamplerStart(uint32_t ulSampleRate)
+{
+	if( (ulSampleRate == 0) || (ulSampleRate > SystemCoreClock) )
+	{
+		return pdFAIL;
+	}
+
+	xConsumerTask = xTaskGetCurrentTaskHandle();
+	ulBlockCount = 0;
+	ulLastSequence = 0;
+	ulInterruptCycles = 0;
+
+	//Notifications of a previous run
+	ulTaskNotifyValueClearIndexed(NULL, ADC_SAMPLER_NOTIFY_INDEX, 0xFFFFFFFF);
+
+	//TIM2 is clocked from APB1 (no prescaler after reset, so at SystemCoreClock)
+	LL_TIM_SetAutoReload(TIM2, (SystemCoreClock / ulSampleRate) - 1);
+	LL_TIM_SetCounter(TIM2, 0);
+
+	if(HAL_ADC_Start_DMA(&AdcHandle, ulBuffer, 2 * ADC_SAMPLER_BLOCK_SIZE) != HAL_OK)
+	{
+		return pdFAIL;
+	}
+
+	LL_TIM_EnableCounter(TIM2);
+
+	return pdPASS;
+}
+
+void vAdcSamplerStop(void)
+{
+	LL_TIM_DisableCounter(TIM2);
+	HAL_ADC_Stop_DMA(&AdcHandle);
+}
+
+BaseType_t xAdcSamplerWaitBlock(AdcBlock_t *pxBlock, TickType_t xTicksToWait)
+{
+	uint32_t ulSequence;
+	uint8_t ucHalf;
+
+	if(ulTaskNotifyTakeIndexed(ADC_SAMPLER_NOTIFY_INDEX, pdTRUE, xTicksToWait) == 0)
+	{
+		return pdFAIL;
+	}
+
+	//The count and the half are changed together by the interrupt
+	taskENTER_CRITICAL();
+	ulSequence = ulBlockCount;
+	ucHalf = ucLastHalf;
+	taskEXIT_CRITICAL();
+
+	pxBlock->pusSamples = (const uint16_t *) ulBuffer + (ucHalf * ADC_SAMPLER_BLOCK_SIZE);
+	pxBlock->xLength = ADC_SAMPLER_BLOCK_SIZE;
+	pxBlock->ulSequence = ulSequence;
+	pxBlock->ulMissed = ulSequence - ulLastSequence - 1;
+	ulLastSequence = ulSequence;
+
+	return pdPASS;
+}
+
+BaseType_t xAdcSamplerBlockIntact(const AdcBlock_t *pxBlock)
+{
+	return (ulBlockCount == pxBlock->ulSequence) ? pdTRUE : pdFALSE;
+}
+
+uint32_t ulAdcSamplerInterruptCycles(void)
+{
+	return ulInterruptCycles;
+}
+
+void vAdcReduce(const uint16_t *pusSamples, size_t xLength, uint8_t ucDecimation, uint16_t *pusOutput, AdcStats_t *pxStats)
+{
+	const uint32_t *pulPairs = (const uint32_t *) pusSamples;
+	uint32_t ulPairs = xLength / 2;
+	uint32_t ulGroupPairs = (ucDecimation < 2) ? ulPairs : (ucDecimation / 2);
+	uint32_t ulMin = 0xFFFFFFFFUL;
+	uint32_t ulMax = 0;
+	uint32_t ulSum = 0;
+	uint32_t ulGroup, ulPair;
+	uint8_t ucShift = 0;
+
+	while((1U << ucShift) < ucDecimation)
+	{
+		ucShift++;
+	}
+
+	while(ulPairs >= ulGroupPairs)
+	{
+		ulGroup = 0;
+
+		for(ulPair = 0; ulPair < ulGroupPairs; ulPair++)
+		{
+			uint32_t ulWord = *pulPairs++;
+
+			//Each SEL uses the flags of the USUB16 just before it
+			__USUB16(ulWord, ulMax);
+			ulMax = __SEL(ulWord, ulMax);
+			__USUB16(ulWord, ulMin);
+			ulMin = __SEL(ulMin, ulWord);
+
+			ulSum = __SMLAD(ulWord, 0x00010001UL, ulSum);
+			ulGroup = __QADD16(ulGroup, ulWord);
+		}
+
+		if(ucDecimation >= 2)
+		{
+			*pusOutput++ = (uint16_t)(((ulGroup & 0xFFFF) + (ulGroup >> 16)) >> ucShift);
+		}
+		ulPairs -= ulGroupPairs;
+	}
+
+	pxStats->usMin = (uint16_t)(((ulMin & 0xFFFF) < (ulMin >> 16)) ? (ulMin & 0xFFFF) : (ulMin >> 16));
+	pxStats->usMax = (uint16_t)(((ulMax & 0xFFFF) > (ulMax >> 16)) ? (ulMax & 0xFFFF) : (ulMax >> 16));
+	pxStats->ulSum = ulSum;
+}
+
+
+void DMA1_Channel1_IRQHandler(void)
+{
+	uint32_t ulStart = DWT->CYCCNT;
+
+	HAL_DMA_IRQHandler(&AdcDmaHandle);
+
+	ulInterruptCycles += DWT->CYCCNT - ulStart;
+}
+
+//Called by HAL_ADC_Init()
+void HAL_ADC_MspInit(ADC_HandleTypeDef *hadc)
+{
+	__HAL_RCC_ADC_CLK_ENABLE();
+}
+
+//Called from the DMA interrupt when the first block is full
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef *hadc)
+{
+	prvBlockDone(0);
+}
+
+//Called from the DMA interrupt when the second block is full
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc)
+{
+	prvBlockDone(1);
+}
+
+
+static void prvBlockDone(uint8_t ucHalf)
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	ucLastHalf = ucHalf;
+	ulBlockCount++;
+	vTaskNotifyGiveIndexedFromISR(xConsumerTask, ADC_SAMPLER_NOTIFY_INDEX, &xHigherPriorityTaskWoken);
+
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
@@ -0,0 +1,331 @@
+/*
+ * AdcSamplerExample.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * This application samples the analog input A0 (PC0) with the ADC sampler (AdcSampler.c).
+ *
+ * The Processing task is the consumer of the blocks. It first compares vAdcReduce() (DSP instructions)
+ * with the same reductions written in plain C, on a block of samples: the results and the cycles.
+ * Then it samples one second at several rates and reduces each block (decimation by ADC_DECIMATION).
+ * For each rate it prints:
+ *   sustained rate: samples of the blocks processed in time per second
+ *   missed / late:  blocks lost, and blocks overwritten by the DMA before the end of their processing
+ *   CPU load:       cycles of the DMA interrupt and of the processing, in percent of the elapsed cycles
+ * At the end it samples at 10 kHz continuously and prints the minimum, mean and maximum every second.
+ *
+ * The CPU runs at 32 MHz (MSI range 10), like UsbCdcConsole.c.
+ * AdcSampler.c has to be included in the build with this file, and HAL_ADC_MODULE_ENABLED in stm32wbxx_hal_conf.h.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stm32wbxx.h"
+#include "stm32wbxx_nucleo.h"
+#include "stdio.h"
+#include "string.h"
+#include "AdcSampler.h"
+
+#define ADC_DECIMATION			8
+#define MONITOR_RATE			10000
+
+//Task handles and functions
+TaskHandle_t xProcessingTask = NULL;
+void vProcessingTaskFunction(void *params);
+
+//UART Handle and Init types
+UART_HandleTypeDef Uart1;
+UART_InitTypeDef Uart1Init;
+GPIO_InitTypeDef GpioUARTpins;
+
+//Sample rates of the measurement
+static const uint32_t ulRates[] = { 1000, 10000, 50000, 100000, 200000 };
+
+//Output of the decimation
+static uint16_t usDecimated[ADC_SAMPLER_BLOCK_SIZE / ADC_DECIMATION];
+
+//Private helper functions and variables
+static void prvSetupClock(void);
+static void prvSetupUART(void);
+static void prvCompareReductions(void);
+static void prvMeasureRate(uint32_t ulRate);
+static void prvReduceScalar(const uint16_t *pusSamples, size_t xLength, uint8_t ucDecimation, uint16_t *pusOutput, AdcStats_t *pxStats);
+void printmsg(char *msg);
+char UsrMsg[250];
+
+
+int main()
+{
+	// Enable the DWT Cycle Count Register (SEGGER Settings)
+	DWT->CTRL |= (1 << 0);
+
+	// Private functions called to setup the Hardware. The clock first: the UART baud rate depends on it.
+	prvSetupClock();
+	prvSetupUART();
+
+	//Start Recording for SEGGER SystemView
+	SEGGER_SYSVIEW_Conf();
+	SEGGER_SYSVIEW_Start();
+
+	sprintf(UsrMsg,"Example of continuous ADC sampling with double buffered DMA \r\n");
+	printmsg(UsrMsg);
+
+	if(xAdcSamplerInit() == pdPASS)
+	{
+		//Create Processing Task. It is the consumer of the blocks.
+		xTaskCreate(vProcessingTaskFunction, "Processing-Task", 384, NULL, 3, &xProcessingTask);
+
+		//Schedule the tasks
+		vTaskStartScheduler();
+	}
+	else
+	{
+		sprintf(UsrMsg, "ADC initialization failed... :( \r\n");
+		printmsg(UsrMsg);
+	}
+
+	/*
+	 * If scheduler can start the tasks and run them, the program will never reach here.
+	 * If the program comes to the below line, that means there was a problem while creating or scheduling the tasks
+	 */
+	for(;;);
+}
+
+
+void vProcessingTaskFunction(void *params)
+{
+	AdcBlock_t xBlock;
+	AdcStats_t xStats;
+	uint32_t ulSamples = 0, ulSum = 0;
+	uint16_t usMin = 0xFFFF, usMax = 0;
+	TickType_t xLastPrint;
+	uint8_t i;
+
+	//1. DSP instructions and plain C
+	prvCompareReductions();
+
+	//2. Sustained rate and CPU load at each rate
+	printmsg("\r\nRate (Hz)  sustained (Hz)  missed  late  CPU load \r\n");
+	for(i = 0; i < sizeof(ulRates) / sizeof(ulRates[0]); i++)
+	{
+		prvMeasureRate(ulRates[i]);
+	}
+
+	//3. Continuous sampling
+	printmsg("\r\nMonitoring A0: \r\n");
+	xAdcSamplerStart(MONITOR_RATE);
+	xLastPrint = xTaskGetTickCount();
+
+	while(1)
+	{
+		if(xAdcSamplerWaitBlock(&xBlock, pdMS_TO_TICKS(100)) != pdPASS)
+		{
+			printmsg("No block from the ADC \r\n");
+			continue;
+		}
+
+		vAdcReduce(xBlock.pusSamples, xBlock.xLength, ADC_DECIMATION, usDecimated, &xStats);
+		usMin = (xStats.usMin < usMin) ? xStats.usMin : usMin;
+		usMax = (xStats.usMax > usMax) ? xStats.usMax : usMax;
+		ulSum += xStats.ulSum;
+		ulSamples += xBlock.xLength;
+
+		if((xTaskGetTickCount() - xLastPrint) >= pdMS_TO_TICKS(1000))
+		{
+			sprintf(UsrMsg, "A0: min %4u  mean %4lu  max %4u (%lu samples) \r\n", usMin, ulSum / ulSamples, usMax, ulSamples);
+			printmsg(UsrMsg);
+
+			xLastPrint = xTaskGetTickCount();
+			usMin = 0xFFFF;
+			usMax = 0;
+			ulSum = 0;
+			ulSamples = 0;
+		}
+	}
+}
+
+
+//Same block with vAdcReduce() and with prvReduceScalar(): results and cycles
+static void prvCompareReductions(void)
+{
+	static uint16_t usScalarDecimated[ADC_SAMPLER_BLOCK_SIZE / ADC_DECIMATION];
+	static uint32_t ulCopy[ADC_SAMPLER_BLOCK_SIZE / 2];
+	AdcBlock_t xBlock;
+	AdcStats_t xSimd, xScalar;
+	uint32_t ulSimdCycles, ulScalarCycles;
+	const uint16_t *pusCopy = (const uint16_t *) ulCopy;
+
+	//One block of real samples, copied: the DMA does not change it during the measurement
+	xAdcSamplerStart(MONITOR_RATE);
+	if(xAdcSamplerWaitBlock(&xBlock, pdMS_TO_TICKS(1000)) != pdPASS)
+	{
+		vAdcSamplerStop();
+		printmsg("No block from the ADC \r\n");
+		return;
+	}
+	memcpy(ulCopy, xBlock.pusSamples, sizeof(ulCopy));
+	vAdcSamplerStop();
+
+	ulSimdCycles = DWT->CYCCNT;
+	vAdcReduce(pusCopy, ADC_SAMPLER_BLOCK_SIZE, ADC_DECIMATION, usDecimated, &xSimd);
+	ulSimdCycles = DWT->CYCCNT - ulSimdCycles;
+
+	ulScalarCycles = DWT->CYCCNT;
+	prvReduceScalar(pusCopy, ADC_SAMPLER_BLOCK_SIZE, ADC_DECIMATION, usScalarDecimated, &xScalar);
+	ulScalarCycles = DWT->CYCCNT - ulScalarCycles;
+
+	sprintf(UsrMsg, "Reduction of %u samples (decimation %u): DSP %lu cycles, C %lu cycles, results %s \r\n",
+			ADC_SAMPLER_BLOCK_SIZE, ADC_DECIMATION, ulSimdCycles, ulScalarCycles,
+			( (xSimd.usMin == xScalar.usMin) && (xSimd.usMax == xScalar.usMax) && (xSimd.ulSum == xScalar.ulSum) &&
+			  (memcmp(usDecimated, usScalarDecimated, sizeof(usDecimated)) == 0) ) ? "identical" : "DIFFERENT");
+	printmsg(UsrMsg);
+}
+
+//Samples one second at ulRate and prints the figures
+static void prvMeasureRate(uint32_t ulRate)
+{
+	AdcBlock_t xBlock;
+	AdcStats_t xStats;
+	uint32_t ulElapsed, ulProcessing = 0, ulBlockStart;
+	uint32_t ulProcessed = 0, ulMissed = 0, ulLate = 0, ulSustained, ulLoad;
+	TickType_t xStartTick;
+
+	if(xAdcSamplerStart(ulRate) != pdPASS)
+	{
+		return;
+	}
+
+	xStartTick = xTaskGetTickCount();
+
+	while((xTaskGetTickCount() - xStartTick) < pdMS_TO_TICKS(1000))
+	{
+		if(xAdcSamplerWaitBlock(&xBlock, pdMS_TO_TICKS(500)) != pdPASS)
+		{
+			continue;
+		}
+
+		ulBlockStart = DWT->CYCCNT;
+		vAdcReduce(xBlock.pusSamples, xBlock.xLength, ADC_DECIMATION, usDecimated, &xStats);
+		ulProcessing += DWT->CYCCNT - ulBlockStart;
+
+		ulMissed += xBlock.ulMissed;
+		if(xAdcSamplerBlockIntact(&xBlock) == pdTRUE)
+		{
+			ulProcessed++;
+		}
+		else
+		{
+			ulLate++;
+		}
+	}
+
+	//Elapsed cycles from the tick count: the cycle counter stops when the CPU sleeps in the idle task
+	ulElapsed = (xTaskGetTickCount() - xStartTick) * (SystemCoreClock / configTICK_RATE_HZ);
+	vAdcSamplerStop();
+
+	//Samples per second, and the load in tenths of percent
+	ulSustained = (uint32_t)(((uint64_t) ulProcessed * ADC_SAMPLER_BLOCK_SIZE * SystemCoreClock) / ulElapsed);
+	ulLoad = (uint32_t)(((uint64_t)(ulProcessing + ulAdcSamplerInterruptCycles()) * 1000) / ulElapsed);
+
+	sprintf(UsrMsg, "%9lu  %14lu  %6lu  %4lu  %3lu.%lu %% \r\n", ulRate, ulSustained, ulMissed, ulLate, ulLoad / 10, ulLoad % 10);
+	printmsg(UsrMsg);
+}
+
+//The reductions of vAdcReduce(), one sample at a time
+static void prvReduceScalar(const uint16_t *pusSamples, size_t xLength, uint8_t ucDecimation, uint16_t *pusOutput, AdcStats_t *pxStats)
+{
+	uint32_t ulGroup = 0;
+	size_t i;
+
+	pxStats->usMin = 0xFFFF;
+	pxStats->usMax = 0;
+	pxStats->ulSum = 0;
+
+	for(i = 0; i < xLength; i++)
+	{
+		pxStats->usMin = (pusSamples[i] < pxStats->usMin) ? pusSamples[i] : pxStats->usMin;
+		pxStats->usMax = (pusSamples[i] > pxStats->usMax) ? pusSamples[i] : pxStats->usMax;
+		pxStats->ulSum += pusSamples[i];
+
+		ulGroup += pusSamples[i];
+		if(((i + 1) % ucDecimation) == 0)
+		{
+			*pusOutput++ = (uint16_t)(ulGroup / ucDecimation);
+			ulGroup = 0;
+		}
+	}
+}
+
+
+static void prvSetupClock(void)
+{
+	//MSI 4 MHz -> 32 MHz, which needs 1 flash wait state. TIM2 and the ADC are clocked from it.
+	__HAL_FLASH_SET_LATENCY(FLASH_LATENCY_1);
+	while(__HAL_FLASH_GET_LATENCY() != FLASH_LATENCY_1);
+
+	__HAL_RCC_MSI_RANGE_CONFIG(RCC_MSIRANGE_10);
+	while(__HAL_RCC_GET_FLAG(RCC_FLAG_MSIRDY) == 0);
+
+	//SystemCoreClock is used by the kernel tick, SystemView, the UART baud rate and the sample rate
+	SystemCoreClockUpdate();
+}
+
+static void prvSetupUART(void)
+{
+	//1. Enable the UART1 and GPIOB Peripheral Clocks
+	__HAL_RCC_USART1_CLK_ENABLE();
+	__HAL_RCC_GPIOB_CLK_ENABLE();
+
+	//In UART connection with Virtual COM-port, PB6->TX and PB7->RX
+	//2. Alternate Functionality Configuration to make Port B pins work as UART pins
+
+	//Zeroing each and every member element of the structure.
+	memset(&GpioUARTpins, 0, sizeof(GpioUARTpins));
+	GpioUARTpins.Pin = GPIO_PIN_6 | GPIO_PIN_7;
+	GpioUARTpins.Mode = GPIO_MODE_AF_PP;
+	GpioUARTpins.Alternate = GPIO_AF7_USART1;
+	GpioUARTpins.Pull = GPIO_PULLUP;
+
+	HAL_GPIO_Init(GPIOB, &GpioUARTpins);
+
+	//3. Configure and initialize UART parameters
+
+	//Zeroing each and every member element of the structure.
+	memset(&Uart1Init, 0, sizeof(Uart1Init));
+	memset(&Uart1, 0, sizeof(Uart1));
+
+	//UART Initialization
+	Uart1Init.BaudRate = 115200;
+	Uart1Init.WordLength = UART_WORDLENGTH_8B;
+	Uart1Init.HwFlowCtl = UART_HWCONTROL_NONE;
+	Uart1Init.Mode = UART_MODE_TX_RX;
+	Uart1Init.Parity = UART_PARITY_NONE;
+	Uart1Init.StopBits = UART_STOPBITS_1;
+
+	Uart1.Init = Uart1Init;
+	Uart1.Instance = USART1;
+
+	//4. Initialize the UART peripheral
+	uint16_t UARTSetUpResult = HAL_UART_Init(&Uart1);
+
+	if(UARTSetUpResult == HAL_ERROR)
+	{
+		//printf("USART Initialization was not successful \n");
+	}
+
+}
+
+void printmsg(char *msg)
+{
+	HAL_UART_Transmit(&Uart1, (uint8_t *)msg, strlen(msg), 1);
+}
+
+//Implement the Idle Hook function
+void vApplicationIdleHook()
+{
+	//Send the CPU to normal sleep mode
+	__WFI();
+}
@@ -0,0 +1,639 @@
+/*
+ * AesEngine.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * The AES unit reads the key and the counter block as big endian words (register KEYR7/IVR3 gets the
+ * first word), and the data as bytes (8 bit data type: it swaps the bytes of each word of DINR/DOUTR).
+ * The DMA channels move one word per request: DMA IN writes a block in DINR, the unit computes it,
+ * and DMA OUT reads it from DOUTR while DMA IN writes the next block. The CPU is not involved until the
+ * end of the transfer, when the DMA OUT interrupt wakes up the task.
+ *
+ * CTR: every call configures the key and the counter block, so the AES unit has no state between two
+ * calls and the streams of several tasks can be interleaved. The counter is kept in the context.
+ * GCM: one call of the HAL for the whole message (init, header and payload phases), then the final phase.
+ *
+ * Before the scheduler is started (self test) and for short buffers, the HAL polling functions are used.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "stm32wbxx.h"
+#include "stm32wbxx_hal.h"
+#include "string.h"
+#include "AesEngine.h"
+
+//Timeout of the HAL polling functions (ms)
+#define AES_ENGINE_TIMEOUT			10
+
+//Maximum size of one HAL call (16 bit size, whole blocks)
+#define AES_ENGINE_MAX_CHUNK		0xFFF0
+
+#define IS_WORD_ALIGNED(p)			( ((uint32_t)(p) & 0x03) == 0 )
+
+//Self test: NIST SP 800-38A F.5.1 (CTR-AES128, first block), GCM test case 2 (key, IV and plaintext zero)
+static const uint8_t ucCtrKey[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+static const uint8_t ucCtrCounter[16] = { 0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff };
+static const uint32_t ulCtrPlain[4] = { 0xe2bec16bUL, 0x969f402eUL, 0x117e3de9UL, 0x2a179373UL };	//6bc1bee2 2e409f96 ...
+static const uint8_t ucCtrCipher[16] = { 0x87, 0x4d, 0x61, 0x91, 0xb6, 0x20, 0xe3, 0x26, 0x1b, 0xef, 0x68, 0x64, 0x99, 0x0d, 0xb6, 0xce };
+static const uint8_t ucGcmCipher[16] = { 0x03, 0x88, 0xda, 0xce, 0x60, 0xb6, 0xa3, 0x92, 0xf3, 0x28, 0xc2, 0xb9, 0x71, 0xb2, 0xfe, 0x78 };
+static const uint8_t ucGcmTag[16] = { 0xab, 0x6e, 0x47, 0xd4, 0x2c, 0xec, 0x13, 0xbd, 0xf5, 0x3a, 0x67, 0xb2, 0x12, 0x57, 0xbd, 0xdf };
+
+static CRYP_HandleTypeDef CrypHandle;
+static DMA_HandleTypeDef AesDmaInHandle, AesDmaOutHandle;
+static SemaphoreHandle_t xAesMutex = NULL;
+static BaseType_t xHardwareReady = pdFALSE;
+static BaseType_t xUseHardware = pdTRUE;
+
+//Task waiting for the end of the DMA transfers
+static TaskHandle_t xDmaWaitingTask = NULL;
+static volatile uint8_t ucDmaDone = 0;
+static volatile uint8_t ucDmaError = 0;
+
+//Word aligned buffer for the CTR data which is not aligned, and for the key stream of a partial block
+static uint32_t ulBounce[AES_ENGINE_BOUNCE_SIZE / 4];
+
+//Private helper functions
+static BaseType_t prvHardwareCrypt(uint32_t ulAlgorithm, const uint32_t *pulKey, uint8_t ucKeyLength, uint32_t *pulIV,
+								   const uint8_t *pucAad, size_t xAadLength, BaseType_t xDecrypt,
+								   const uint8_t *pucInput, uint8_t *pucOutput, size_t xLength);
+static BaseType_t prvCtrHardware(AesCtrContext_t *pxContext, const uint8_t *pucInput, uint8_t *pucOutput, size_t xLength);
+static BaseType_t prvGcmHardware(const uint8_t *pucKey, size_t xKeyLength, const uint8_t *pucIV,
+								 const uint8_t *pucAad, size_t xAadLength, BaseType_t xDecrypt,
+								 const uint8_t *pucInput, uint8_t *pucOutput, size_t xLength, uint8_t *pucTag);
+static void prvGcmSoftware(const uint8_t *pucKey, size_t xKeyLength, const uint8_t *pucIV,
+						   const uint8_t *pucAad, size_t xAadLength, BaseType_t xDecrypt,
+						   const uint8_t *pucInput, uint8_t *pucOutput, size_t xLength, uint8_t *pucTag);
+static void prvCtrSoftware(const AesSoftKey_t *pxKey, uint8_t *pucCounter, const uint8_t *pucInput, uint8_t *pucOutput, size_t xLength);
+static void prvGhash(uint8_t *pucX, const uint8_t *pucH, const uint8_t *pucData, size_t xLength);
+static void prvIncrement(uint8_t *pucCounter, uint32_t ulBlocks);
+static void prvLoadWords(uint32_t *pulWords, const uint8_t *pucBytes, size_t xWords);
+static BaseType_t prvUseHardware(void);
+
+
+BaseType_t xAesEngineInit(void)
+{
+#if ( AES_ENGINE_USE_HARDWARE == 1 )
+	AesCtrContext_t xContext;
+	uint32_t ulZero[4] = { 0, 0, 0, 0 };
+	uint32_t ulOutput[4];
+	uint8_t ucTag[16];
+
+	xAesMutex = xSemaphoreCreateMutex();
+	if(xAesMutex == NULL)
+	{
+		return pdFAIL;
+	}
+
+	//1. AES unit: the configuration is set again for every operation
+	CrypHandle.Instance = AES1;
+	CrypHandle.Init.DataType = CRYP_DATATYPE_8B;
+	CrypHandle.Init.KeySize = CRYP_KEYSIZE_128B;
+	CrypHandle.Init.Algorithm = CRYP_AES_CTR;
+	CrypHandle.Init.pKey = ulBounce;
+	CrypHandle.Init.pInitVect = ulBounce;
+	CrypHandle.Init.DataWidthUnit = CRYP_DATAWIDTHUNIT_BYTE;
+	CrypHandle.Init.KeyIVConfigSkip = CRYP_KEYIVCONFIG_ALWAYS;
+
+	if(HAL_CRYP_Init(&CrypHandle) != HAL_OK)
+	{
+		return pdFAIL;
+	}
+
+	//2. DMA2 channel 2: memory to DINR, channel 3: DOUTR to memory (words, the memory address is incremented)
+	__HAL_RCC_DMAMUX1_CLK_ENABLE();
+	__HAL_RCC_DMA2_CLK_ENABLE();
+
+	AesDmaInHandle.Instance = DMA2_Channel2;
+	AesDmaInHandle.Init.Request = DMA_REQUEST_AES1_IN;
+	AesDmaInHandle.Init.Direction = DMA_MEMORY_TO_PERIPH;
+	AesDmaInHandle.Init.PeriphInc = DMA_PINC_DISABLE;
+	AesDmaInHandle.Init.MemInc = DMA_MINC_ENABLE;
+	AesDmaInHandle.Init.PeriphDataAlignment = DMA_PDATAALIGN_WORD;
+	AesDmaInHandle.Init.MemDataAlignment = DMA_MDATAALIGN_WORD;
+	AesDmaInHandle.Init.Mode = DMA_NORMAL;
+	AesDmaInHandle.Init.Priority = DMA_PRIORITY_MEDIUM;
+
+	AesDmaOutHandle.Instance = DMA2_Channel3;
+	AesDmaOutHandle.Init = AesDmaInHandle.Init;
+	AesDmaOutHandle.Init.Request = DMA_REQUEST_AES1_OUT;
+	AesDmaOutHandle.Init.Direction = DMA_PERIPH_TO_MEMORY;
+	AesDmaOutHandle.Init.Priority = DMA_PRIORITY_HIGH;		//The AES unit waits until its output is read
+
+	if( (HAL_DMA_Init(&AesDmaInHandle) != HAL_OK) || (HAL_DMA_Init(&AesDmaOutHandle) != HAL_OK) )
+	{
+		return pdFAIL;
+	}
+
+	__HAL_LINKDMA(&CrypHandle, hdmain, AesDmaInHandle);
+	__HAL_LINKDMA(&CrypHandle, hdmaout, AesDmaOutHandle);
+
+	NVIC_SetPriority(DMA2_Channel2_IRQn, AES_ENGINE_DMA_IRQ_PRIORITY); //Priority should be less than or equal to configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY
+	NVIC_EnableIRQ(DMA2_Channel2_IRQn);
+	NVIC_SetPriority(DMA2_Channel3_IRQn, AES_ENGINE_DMA_IRQ_PRIORITY); //Priority should be less than or equal to configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY
+	NVIC_EnableIRQ(DMA2_Channel3_IRQn);
+
+	//3. The hardware has to give the results of the test vectors, or it is not used
+	vAesCtrStart(&xContext, ucCtrKey, sizeof(ucCtrKey), ucCtrCounter);
+	if( (prvCtrHardware(&xContext, (const uint8_t *) ulCtrPlain, (uint8_t *) ulOutput, sizeof(ulOutput)) != pdPASS) ||
+		(memcmp(ulOutput, ucCtrCipher, sizeof(ulOutput)) != 0) )
+	{
+		return pdFAIL;
+	}
+
+	if( (prvGcmHardware((const uint8_t *) ulZero, 16, (const uint8_t *) ulZero, NULL, 0, pdFALSE,
+						(const uint8_t *) ulZero, (uint8_t *) ulOutput, sizeof(ulOutput), ucTag) != pdPASS) ||
+		(memcmp(ulOutput, ucGcmCipher, sizeof(ulOutput)) != 0) || (memcmp(ucTag, ucGcmTag, sizeof(ucTag)) != 0) )
+	{
+		return pdFAIL;
+	}
+
+	xHardwareReady = pdTRUE;
+	return pdPASS;
+#else
+	return pdFAIL;
+#endif
+}
+
+void vAesEngineUseHardware(BaseType_t xUseHardwareParam)
+{
+	xUseHardware = xUseHardwareParam;
+}
+
+BaseType_t xAesEngineIsHardware(void)
+{
+	return prvUseHardware();
+}
+
+void vAesCtrStart(AesCtrContext_t *pxContext, const uint8_t *pucKey, size_t xKeyLength, const uint8_t *pucCounter)
+{
+	memset(pxContext->ulKey, 0, sizeof(pxContext->ulKey));
+	prvLoadWords(pxContext->ulKey, pucKey, xKeyLength / 4);
+	pxContext->ucKeyLength = (uint8_t) xKeyLength;
+	memcpy(pxContext->ucCounter, pucCounter, AES_BLOCK_SIZE);
+	pxContext->ucKeystreamUsed = AES_BLOCK_SIZE;
+
+	//The software key is always expanded: the hardware can be switched off during the stream
+	vAesSoftSetKey(&pxContext->xSoftKey, pucKey, xKeyLength);
+}
+
+BaseType_t xAesCtrProcess(AesCtrContext_t *pxContext, const uint8_t *pucInput, uint8_t *pucOutput, size_t xLength)
+{
+	BaseType_t xResult = pdPASS;
+	BaseType_t xHardware = prvUseHardware();
+	size_t xBlocks, i;
+
+	//1. Rest of the key stream of the previous call
+	while( (xLength != 0) && (pxContext->ucKeystreamUsed < AES_BLOCK_SIZE) )
+	{
+		*pucOutput++ = *pucInput++ ^ pxContext->ucKeystream[pxContext->ucKeystreamUsed++];
+		xLength--;
+	}
+
+	if(xLength == 0)
+	{
+		return pdPASS;
+	}
+
+	if(xHardware == pdTRUE)
+	{
+		xSemaphoreTake(xAesMutex, portMAX_DELAY);
+	}
+
+	//2. Whole blocks
+	xBlocks = xLength & ~(size_t)(AES_BLOCK_SIZE - 1);
+	if(xBlocks != 0)
+	{
+		if(xHardware == pdTRUE)
+		{
+			xResult = prvCtrHardware(pxContext, pucInput, pucOutput, xBlocks);
+		}
+		else
+		{
+			prvCtrSoftware(&pxContext->xSoftKey, pxContext->ucCounter, pucInput, pucOutput, xBlocks);
+		}
+
+		pucInput += xBlocks;
+		pucOutput += xBlocks;
+		xLength -= xBlocks;
+	}
+
+	//3. Last partial block: the rest of its key stream is kept for the next call
+	if( (xLength != 0) && (xResult == pdPASS) )
+	{
+		if(xHardware == pdTRUE)
+		{
+			memset(ulBounce, 0, AES_BLOCK_SIZE);
+			xResult = prvCtrHardware(pxContext, (const uint8_t *) ulBounce, (uint8_t *) ulBounce, AES_BLOCK_SIZE);
+			memcpy(pxContext->ucKeystream, ulBounce, AES_BLOCK_SIZE);
+		}
+		else
+		{
+			vAesSoftEncryptBlock(&pxContext->xSoftKey, pxContext->ucCounter, pxContext->ucKeystream);
+			prvIncrement(pxContext->ucCounter, 1);
+		}
+
+		for(i = 0; i < xLength; i++)
+		{
+			pucOutput[i] = pucInput[i] ^ pxContext->ucKeystream[i];
+		}
+		pxContext->ucKeystreamUsed = (uint8_t) xLength;
+	}
+
+	if(xHardware == pdTRUE)
+	{
+		xSemaphoreGive(xAesMutex);
+	}
+
+	return xResult;
+}
+
+BaseType_t xAesGcmEncrypt(const uint8_t *pucKey, size_t xKeyLength, const uint8_t *pucIV,
+						  const uint8_t *pucAad, size_t xAadLength,
+						  const uint8_t *pucInput, uint8_t *pucOutput, size_t xLength, uint8_t *pucTag)
+{
+	BaseType_t xResult = pdPASS;
+
+	if( (xLength > AES_GCM_MAX_LENGTH) || ((xKeyLength != 16) && (xKeyLength != 32)) )
+	{
+		return pdFAIL;
+	}
+
+	//The AES unit reads the data and the additional data by words
+	if( (prvUseHardware() == pdTRUE) && (xLength != 0) && IS_WORD_ALIGNED(pucInput) && IS_WORD_ALIGNED(pucOutput) &&
+		IS_WORD_ALIGNED(pucAad) && ((xAadLength & 0x03) == 0) )
+	{
+		xSemaphoreTake(xAesMutex, portMAX_DELAY);
+		xResult = prvGcmHardware(pucKey, xKeyLength, pucIV, pucAad, xAadLength, pdFALSE, pucInput, pucOutput, xLength, pucTag);
+		xSemaphoreGive(xAesMutex);
+	}
+	else
+	{
+		prvGcmSoftware(pucKey, xKeyLength, pucIV, pucAad, xAadLength, pdFALSE, pucInput, pucOutput, xLength, pucTag);
+	}
+
+	return xResult;
+}
+
+BaseType_t xAesGcmDecrypt(const uint8_t *pucKey, size_t xKeyLength, const uint8_t *pucIV,
+						  const uint8_t *pucAad, size_t xAadLength,
+						  const uint8_t *pucInput, uint8_t *pucOutput, size_t xLength, const uint8_t *pucTag)
+{
+	BaseType_t xResult = pdPASS;
+	uint8_t ucTag[AES_GCM_TAG_SIZE];
+	uint8_t ucDifference = 0;
+	uint8_t i;
+
+	if( (xLength > AES_GCM_MAX_LENGTH) || ((xKeyLength != 16) && (xKeyLength != 32)) )
+	{
+		return pdFAIL;
+	}
+
+	if( (prvUseHardware() == pdTRUE) && (xLength != 0) && IS_WORD_ALIGNED(pucInput) && IS_WORD_ALIGNED(pucOutput) &&
+		IS_WORD_ALIGNED(pucAad) && ((xAadLength & 0x03) == 0) )
+	{
+		xSemaphoreTake(xAesMutex, portMAX_DELAY);
+		xResult = prvGcmHardware(pucKey, xKeyLength, pucIV, pucAad, xAadLength, pdTRUE, pucInput, pucOutput, xLength, ucTag);
+		xSemaphoreGive(xAesMutex);
+	}
+	else
+	{
+		prvGcmSoftware(pucKey, xKeyLength, pucIV, pucAad, xAadLength, pdTRUE, pucInput, pucOutput, xLength, ucTag);
+	}
+
+	//Comparison in constant time: the time does not tell how many bytes of the tag are right
+	for(i = 0; i < AES_GCM_TAG_SIZE; i++)
+	{
+		ucDifference |= ucTag[i] ^ pucTag[i];
+	}
+
+	if( (xResult != pdPASS) || (ucDifference != 0) )
+	{
+		memset(pucOutput, 0, xLength);
+		return pdFAIL;
+	}
+
+	return pdPASS;
+}
+
+
+void DMA2_Channel2_IRQHandler(void)
+{
+	HAL_DMA_IRQHandler(&AesDmaInHandle);
+}
+
+void DMA2_Channel3_IRQHandler(void)
+{
+	HAL_DMA_IRQHandler(&AesDmaOutHandle);
+}
+
+//Called by HAL_CRYP_Init()
+void HAL_CRYP_MspInit(CRYP_HandleTypeDef *hcryp)
+{
+	__HAL_RCC_AES1_CLK_ENABLE();
+}
+
+//Called from the DMA OUT interrupt at the end of the transfer
+void HAL_CRYP_OutCpltCallback(CRYP_HandleTypeDef *hcryp)
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	ucDmaDone = 1;
+	vTaskNotifyGiveIndexedFromISR(xDmaWaitingTask, AES_ENGINE_NOTIFY_INDEX, &xHigherPriorityTaskWoken);
+
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+//Called from the DMA interrupts on a transfer error
+void HAL_CRYP_ErrorCallback(CRYP_HandleTypeDef *hcryp)
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	ucDmaError = 1;
+	ucDmaDone = 1;
+	vTaskNotifyGiveIndexedFromISR(xDmaWaitingTask, AES_ENGINE_NOTIFY_INDEX, &xHigherPriorityTaskWoken);
+
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+
+/*
+ * One operation of the AES unit. The caller owns the AES unit (mutex, or before the scheduler is started).
+ * xLength is at most AES_ENGINE_MAX_CHUNK, the buffers are word aligned.
+ */
+static BaseType_t prvHardwareCrypt(uint32_t ulAlgorithm, const uint32_t *pulKey, uint8_t ucKeyLength, uint32_t *pulIV,
+								   const uint8_t *pucAad, size_t xAadLength, BaseType_t xDecrypt,
+								   const uint8_t *pucInput, uint8_t *pucOutput, size_t xLength)
+{
+	CRYP_ConfigTypeDef xConfig;
+	HAL_StatusTypeDef xStatus;
+
+	xConfig = CrypHandle.Init;
+	xConfig.Algorithm = ulAlgorithm;
+	xConfig.KeySize = (ucKeyLength == 32) ? CRYP_KEYSIZE_256B : CRYP_KEYSIZE_128B;
+	xConfig.pKey = (uint32_t *) pulKey;
+	xConfig.pInitVect = pulIV;
+	xConfig.Header = (uint32_t *) pucAad;
+	xConfig.HeaderSize = xAadLength / 4;
+
+	if(HAL_CRYP_SetConfig(&CrypHandle, &xConfig) != HAL_OK)
+	{
+		return pdFAIL;
+	}
+
+	//Short buffers, or no task to block: the CPU writes and reads the AES unit
+	if( (xLength < AES_ENGINE_DMA_THRESHOLD) || (xTaskGetSchedulerState() != taskSCHEDULER_RUNNING) )
+	{
+		if(xDecrypt == pdTRUE)
+		{
+			xStatus = HAL_CRYP_Decrypt(&CrypHandle, (uint32_t *) pucInput, (uint16_t) xLength, (uint32_t *) pucOutput, AES_ENGINE_TIMEOUT);
+		}
+		else
+		{
+			xStatus = HAL_CRYP_Encrypt(&CrypHandle, (uint32_t *) pucInput, (uint16_t) xLength, (uint32_t *) pucOutput, AES_ENGINE_TIMEOUT);
+		}
+
+		return (xStatus == HAL_OK) ? pdPASS : pdFAIL;
+	}
+
+	ucDmaDone = 0;
+	ucDmaError = 0;
+	xDmaWaitingTask = xTaskGetCurrentTaskHandle();
+
+	if(xDecrypt == pdTRUE)
+	{
+		xStatus = HAL_CRYP_Decrypt_DMA(&CrypHandle, (uint32_t *) pucInput, (uint16_t) xLength, (uint32_t *) pucOutput);
+	}
+	else
+	{
+		xStatus = HAL_CRYP_Encrypt_DMA(&CrypHandle, (uint32_t *) pucInput, (uint16_t) xLength, (uint32_t *) pucOutput);
+	}
+
+	if(xStatus != HAL_OK)
+	{
+		return pdFAIL;
+	}
+
+	//The CPU is free for the other tasks during the transfer
+	while(ucDmaDone == 0)
+	{
+		ulTaskNotifyTakeIndexed(AES_ENGINE_NOTIFY_INDEX, pdTRUE, portMAX_DELAY);
+	}
+
+	return (ucDmaError == 0) ? pdPASS : pdFAIL;
+}
+
+//CTR by the AES unit, the counter of the context is updated. The caller owns the AES unit.
+static BaseType_t prvCtrHardware(AesCtrContext_t *pxContext, const uint8_t *pucInput, uint8_t *pucOutput, size_t xLength)
+{
+	uint32_t ulIV[4];
+	size_t xChunk;
+	BaseType_t xAligned = (IS_WORD_ALIGNED(pucInput) && IS_WORD_ALIGNED(pucOutput)) ? pdTRUE : pdFALSE;
+
+	while(xLength != 0)
+	{
+		prvLoadWords(ulIV, pxContext->ucCounter, 4);
+
+		if(xAligned == pdTRUE)
+		{
+			xChunk = (xLength > AES_ENGINE_MAX_CHUNK) ? AES_ENGINE_MAX_CHUNK : xLength;
+
+			if(prvHardwareCrypt(CRYP_AES_CTR, pxContext->ulKey, pxContext->ucKeyLength, ulIV, NULL, 0, pdFALSE,
+								pucInput, pucOutput, xChunk) != pdPASS)
+			{
+				return pdFAIL;
+			}
+		}
+		else
+		{
+			//The DMA moves words: the data goes through the aligned buffer, encrypted in place
+			xChunk = (xLength > AES_ENGINE_BOUNCE_SIZE) ? AES_ENGINE_BOUNCE_SIZE : xLength;
+			memcpy(ulBounce, pucInput, xChunk);
+
+			if(prvHardwareCrypt(CRYP_AES_CTR, pxContext->ulKey, pxContext->ucKeyLength, ulIV, NULL, 0, pdFALSE,
+								(const uint8_t *) ulBounce, (uint8_t *) ulBounce, xChunk) != pdPASS)
+			{
+				return pdFAIL;
+			}
+
+			memcpy(pucOutput, ulBounce, xChunk);
+		}
+
+		prvIncrement(pxContext->ucCounter, xChunk / AES_BLOCK_SIZE);
+		pucInput += xChunk;
+		pucOutput += xChunk;
+		xLength -= xChunk;
+	}
+
+	return pdPASS;
+}
+
+//GCM by the AES unit (the payload, then the final phase for the tag). The caller owns the AES unit.
+static BaseType_t prvGcmHardware(const uint8_t *pucKey, size_t xKeyLength, const uint8_t *pucIV,
+								 const uint8_t *pucAad, size_t xAadLength, BaseType_t xDecrypt,
+								 const uint8_t *pucInput, uint8_t *pucOutput, size_t xLength, uint8_t *pucTag)
+{
+	uint32_t ulKey[8];
+	uint32_t ulIV[4];
+	uint32_t ulTag[4];
+
+	//The initial counter block of the payload: IV || 2 (the counter 1 is used for the tag)
+	prvLoadWords(ulKey, pucKey, xKeyLength / 4);
+	prvLoadWords(ulIV, pucIV, 3);
+	ulIV[3] = 2;
+
+	if(prvHardwareCrypt(CRYP_AES_GCM_GMAC, ulKey, (uint8_t) xKeyLength, ulIV, pucAad, xAadLength, xDecrypt,
+						pucInput, pucOutput, xLength) != pdPASS)
+	{
+		return pdFAIL;
+	}
+
+	if(HAL_CRYPEx_AESGCM_GenerateAuthTAG(&CrypHandle, ulTag, AES_ENGINE_TIMEOUT) != HAL_OK)
+	{
+		return pdFAIL;
+	}
+
+	memcpy(pucTag, ulTag, AES_GCM_TAG_SIZE);
+	return pdPASS;
+}
+
+//GCM by software (NIST SP 800-38D with a 96 bit IV)
+static void prvGcmSoftware(const uint8_t *pucKey, size_t xKeyLength, const uint8_t *pucIV,
+						   const uint8_t *pucAad, size_t xAadLength, BaseType_t xDecrypt,
+						   const uint8_t *pucInput, uint8_t *pucOutput, size_t xLength, uint8_t *pucTag)
+{
+	AesSoftKey_t xKey;
+	uint8_t ucH[AES_BLOCK_SIZE];
+	uint8_t ucCounter[AES_BLOCK_SIZE];
+	uint8_t ucX[AES_BLOCK_SIZE];
+	uint8_t ucLengths[AES_BLOCK_SIZE];
+	uint8_t i;
+
+	vAesSoftSetKey(&xKey, pucKey, xKeyLength);
+
+	//H = E(K, 0), J0 = IV || 1
+	memset(ucH, 0, sizeof(ucH));
+	vAesSoftEncryptBlock(&xKey, ucH, ucH);
+	memcpy(ucCounter, pucIV, AES_GCM_IV_SIZE);
+	ucCounter[12] = 0;
+	ucCounter[13] = 0;
+	ucCounter[14] = 0;
+	ucCounter[15] = 1;
+
+	//The hash of the ciphertext: before the decryption, after the encryption (the buffers can be the same)
+	memset(ucX, 0, sizeof(ucX));
+	prvGhash(ucX, ucH, pucAad, xAadLength);
+
+	if(xDecrypt == pdTRUE)
+	{
+		prvGhash(ucX, ucH, pucInput, xLength);
+	}
+
+	prvIncrement(ucCounter, 1);
+	prvCtrSoftware(&xKey, ucCounter, pucInput, pucOutput, xLength);
+
+	if(xDecrypt == pdFALSE)
+	{
+		prvGhash(ucX, ucH, pucOutput, xLength);
+	}
+
+	//Lengths in bits (64 bit big endian each)
+	memset(ucLengths, 0, sizeof(ucLengths));
+	for(i = 0; i < 4; i++)
+	{
+		ucLengths[7 - i] = (uint8_t)(((uint64_t) xAadLength * 8) >> (8 * i));
+		ucLengths[15 - i] = (uint8_t)(((uint64_t) xLength * 8) >> (8 * i));
+	}
+	prvGhash(ucX, ucH, ucLengths, sizeof(ucLengths));
+
+	//Tag = E(K, J0) ^ GHASH
+	ucCounter[12] = 0;
+	ucCounter[13] = 0;
+	ucCounter[14] = 0;
+	ucCounter[15] = 1;
+	vAesSoftEncryptBlock(&xKey, ucCounter, ucH);
+
+	for(i = 0; i < AES_GCM_TAG_SIZE; i++)
+	{
+		pucTag[i] = ucX[i] ^ ucH[i];
+	}
+}
+
+//CTR by software. The last block can be partial (its key stream is lost).
+static void prvCtrSoftware(const AesSoftKey_t *pxKey, uint8_t *pucCounter, const uint8_t *pucInput, uint8_t *pucOutput, size_t xLength)
+{
+	uint8_t ucKeystream[AES_BLOCK_SIZE];
+	size_t xBlock, i;
+
+	while(xLength != 0)
+	{
+		xBlock = (xLength > AES_BLOCK_SIZE) ? AES_BLOCK_SIZE : xLength;
+
+		vAesSoftEncryptBlock(pxKey, pucCounter, ucKeystream);
+		prvIncrement(pucCounter, 1);
+
+		for(i = 0; i < xBlock; i++)
+		{
+			pucOutput[i] = pucInput[i] ^ ucKeystream[i];
+		}
+
+		pucInput += xBlock;
+		pucOutput += xBlock;
+		xLength -= xBlock;
+	}
+}
+
+//GHASH of the data, the last block padded with zeros
+static void prvGhash(uint8_t *pucX, const uint8_t *pucH, const uint8_t *pucData, size_t xLength)
+{
+	size_t xBlock, i;
+
+	while(xLength != 0)
+	{
+		xBlock = (xLength > AES_BLOCK_SIZE) ? AES_BLOCK_SIZE : xLength;
+
+		for(i = 0; i < xBlock; i++)
+		{
+			pucX[i] ^= pucData[i];
+		}
+		vAesSoftGcmMultiply(pucX, pucH);
+
+		pucData += xBlock;
+		xLength -= xBlock;
+	}
+}
+
+//Adds ulBlocks to the last 32 bits of the counter block (modulo 2^32, like the AES unit)
+static void prvIncrement(uint8_t *pucCounter, uint32_t ulBlocks)
+{
+	uint32_t ulCounter;
+
+	ulCounter = ((uint32_t) pucCounter[12] << 24) | ((uint32_t) pucCounter[13] << 16) | ((uint32_t) pucCounter[14] << 8) | pucCounter[15];
+	ulCounter += ulBlocks;
+
+	pucCounter[12] = (uint8_t)(ulCounter >> 24);
+	pucCounter[13] = (uint8_t)(ulCounter >> 16);
+	pucCounter[14] = (uint8_t)(ulCounter >> 8);
+	pucCounter[15] = (uint8_t) ulCounter;
+}
+
+//Big endian words, the format of the key and IV registers
+static void prvLoadWords(uint32_t *pulWords, const uint8_t *pucBytes, size_t xWords)
+{
+	size_t i;
+
+	for(i = 0; i < xWords; i++)
+	{
+		pulWords[i] = ((uint32_t) pucBytes[4 * i] << 24) | ((uint32_t) pucBytes[4 * i + 1] << 16) |
+					  ((uint32_t) pucBytes[4 * i + 2] << 8) | (uint32_t) pucBytes[4 * i + 3];
+	}
+}
+
+static BaseType_t prvUseHardware(void)
+{
+	return ( (xHardwareReady == pdTRUE) && (xUseHardware == pdTRUE) ) ? pdTRUE : pdFALSE;
+}
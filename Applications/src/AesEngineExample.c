@@ -0,0 +1,440 @@
+/*
+ * AesEngineExample.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * This application encrypts log records with the AES engine (AesEngine.c) before they leave the device.
+ *
+ * The Test task first checks both paths (AES unit with DMA, and software AES) with the NIST test vectors:
+ * SP 800-38A F.5.1 and F.5.5 (CTR-AES128 and CTR-AES256, processed in pieces to test the streaming) and
+ * the GCM test cases 4 and 16 (AES-128 and AES-256 with additional data), with a modified ciphertext too.
+ * Then it measures the throughput of both paths in MB/s (DWT cycle counter), and starts the loggers:
+ *   CTR logger: all its records are one CTR stream (the key stream continues from one record to the next)
+ *   GCM logger: each record is encrypted with its own IV (record number) and its header is authenticated
+ * Both loggers use the AES unit at the same time, the engine serializes them. They decrypt their records
+ * again to check them and print the beginning of the encrypted record.
+ *
+ * The CPU runs at 32 MHz (MSI range 10), like UsbCdcConsole.c.
+ * AesSoft.c and AesEngine.c have to be included in the build with this file,
+ * and HAL_CRYP_MODULE_ENABLED in stm32wbxx_hal_conf.h.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stm32wbxx.h"
+#include "stm32wbxx_nucleo.h"
+#include "stdio.h"
+#include "string.h"
+#include "AesEngine.h"
+
+#define BENCHMARK_SIZE			4096
+#define RECORD_SIZE				96
+
+//Task handles and functions
+TaskHandle_t xTestTask = NULL;
+TaskHandle_t xCtrLoggerTask = NULL;
+TaskHandle_t xGcmLoggerTask = NULL;
+void vTestTaskFunction(void *params);
+void vCtrLoggerTaskFunction(void *params);
+void vGcmLoggerTaskFunction(void *params);
+
+//UART Handle and Init types
+UART_HandleTypeDef Uart1;
+UART_InitTypeDef Uart1Init;
+GPIO_InitTypeDef GpioUARTpins;
+
+//NIST SP 800-38A F.5.1 and F.5.5: the same counter block and plaintext, AES-128 and AES-256 keys
+static const uint8_t ucCtrKey128[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+static const uint8_t ucCtrKey256[32] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+										 0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+static const uint8_t ucCtrCounter[16] = { 0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff };
+static const uint8_t ucCtrPlain[64] =
+{
+	0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+	0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+	0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+	0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10
+};
+static const uint8_t ucCtrCipher128[64] =
+{
+	0x87, 0x4d, 0x61, 0x91, 0xb6, 0x20, 0xe3, 0x26, 0x1b, 0xef, 0x68, 0x64, 0x99, 0x0d, 0xb6, 0xce,
+	0x98, 0x06, 0xf6, 0x6b, 0x79, 0x70, 0xfd, 0xff, 0x86, 0x17, 0x18, 0x7b, 0xb9, 0xff, 0xfd, 0xff,
+	0x5a, 0xe4, 0xdf, 0x3e, 0xdb, 0xd5, 0xd3, 0x5e, 0x5b, 0x4f, 0x09, 0x02, 0x0d, 0xb0, 0x3e, 0xab,
+	0x1e, 0x03, 0x1d, 0xda, 0x2f, 0xbe, 0x03, 0xd1, 0x79, 0x21, 0x70, 0xa0, 0xf3, 0x00, 0x9c, 0xee
+};
+static const uint8_t ucCtrCipher256[64] =
+{
+	0x60, 0x1e, 0xc3, 0x13, 0x77, 0x57, 0x89, 0xa5, 0xb7, 0xa7, 0xf5, 0x04, 0xbb, 0xf3, 0xd2, 0x28,
+	0xf4, 0x43, 0xe3, 0xca, 0x4d, 0x62, 0xb5, 0x9a, 0xca, 0x84, 0xe9, 0x90, 0xca, 0xca, 0xf5, 0xc5,
+	0x2b, 0x09, 0x30, 0xda, 0xa2, 0x3d, 0xe9, 0x4c, 0xe8, 0x70, 0x17, 0xba, 0x2d, 0x84, 0x98, 0x8d,
+	0xdf, 0xc9, 0xc5, 0x8d, 0xb6, 0x7a, 0xad, 0xa6, 0x13, 0xc2, 0xdd, 0x08, 0x45, 0x79, 0x41, 0xa6
+};
+
+//GCM test cases 4 (AES-128) and 16 (AES-256): 60 bytes of plaintext, 20 bytes of additional data
+static const uint8_t ucGcmKey[32] = { 0xfe, 0xff, 0xe9, 0x92, 0x86, 0x65, 0x73, 0x1c, 0x6d, 0x6a, 0x8f, 0x94, 0x67, 0x30, 0x83, 0x08,
+									  0xfe, 0xff, 0xe9, 0x92, 0x86, 0x65, 0x73, 0x1c, 0x6d, 0x6a, 0x8f, 0x94, 0x67, 0x30, 0x83, 0x08 };
+static const uint8_t ucGcmIV[12] = { 0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad, 0xde, 0xca, 0xf8, 0x88 };
+static const uint8_t ucGcmAad[20] = { 0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef, 0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef,
+									  0xab, 0xad, 0xda, 0xd2 };
+static const uint8_t ucGcmPlain[60] =
+{
+	0xd9, 0x31, 0x32, 0x25, 0xf8, 0x84, 0x06, 0xe5, 0xa5, 0x59, 0x09, 0xc5, 0xaf, 0xf5, 0x26, 0x9a,
+	0x86, 0xa7, 0xa9, 0x53, 0x15, 0x34, 0xf7, 0xda, 0x2e, 0x4c, 0x30, 0x3d, 0x8a, 0x31, 0x8a, 0x72,
+	0x1c, 0x3c, 0x0c, 0x95, 0x95, 0x68, 0x09, 0x53, 0x2f, 0xcf, 0x0e, 0x24, 0x49, 0xa6, 0xb5, 0x25,
+	0xb1, 0x6a, 0xed, 0xf5, 0xaa, 0x0d, 0xe6, 0x57, 0xba, 0x63, 0x7b, 0x39
+};
+static const uint8_t ucGcmCipher128[60] =
+{
+	0x42, 0x83, 0x1e, 0xc2, 0x21, 0x77, 0x74, 0x24, 0x4b, 0x72, 0x21, 0xb7, 0x84, 0xd0, 0xd4, 0x9c,
+	0xe3, 0xaa, 0x21, 0x2f, 0x2c, 0x02, 0xa4, 0xe0, 0x35, 0xc1, 0x7e, 0x23, 0x29, 0xac, 0xa1, 0x2e,
+	0x21, 0xd5, 0x14, 0xb2, 0x54, 0x66, 0x93, 0x1c, 0x7d, 0x8f, 0x6a, 0x5a, 0xac, 0x84, 0xaa, 0x05,
+	0x1b, 0xa3, 0x0b, 0x39, 0x6a, 0x0a, 0xac, 0x97, 0x3d, 0x58, 0xe0, 0x91
+};
+static const uint8_t ucGcmTag128[16] = { 0x5b, 0xc9, 0x4f, 0xbc, 0x32, 0x21, 0xa5, 0xdb, 0x94, 0xfa, 0xe9, 0x5a, 0xe7, 0x12, 0x1a, 0x47 };
+static const uint8_t ucGcmCipher256[60] =
+{
+	0x52, 0x2d, 0xc1, 0xf0, 0x99, 0x56, 0x7d, 0x07, 0xf4, 0x7f, 0x37, 0xa3, 0x2a, 0x84, 0x42, 0x7d,
+	0x64, 0x3a, 0x8c, 0xdc, 0xbf, 0xe5, 0xc0, 0xc9, 0x75, 0x98, 0xa2, 0xbd, 0x25, 0x55, 0xd1, 0xaa,
+	0x8c, 0xb0, 0x8e, 0x48, 0x59, 0x0d, 0xbb, 0x3d, 0xa7, 0xb0, 0x8b, 0x10, 0x56, 0x82, 0x88, 0x38,
+	0xc5, 0xf6, 0x1e, 0x63, 0x93, 0xba, 0x7a, 0x0a, 0xbc, 0xc9, 0xf6, 0x62
+};
+static const uint8_t ucGcmTag256[16] = { 0x76, 0xfc, 0x6e, 0xce, 0x0f, 0x4e, 0x17, 0x68, 0xcd, 0xdf, 0x88, 0x53, 0xbb, 0x2d, 0x55, 0x1b };
+
+//Key of the log records (a real device would read it from a protected storage)
+static const uint8_t ucLogKey[16] = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff };
+
+//Word aligned buffers: the AES unit is only used for GCM with aligned buffers
+static uint32_t ulBenchmarkBuffer[BENCHMARK_SIZE / 4];
+static uint32_t ulInput[16], ulOutput[16], ulAad[5];
+
+//Private helper functions and variables
+static void prvSetupClock(void);
+static void prvSetupUART(void);
+static void prvCheckVectors(void);
+static void prvBenchmark(const char *pcName, BaseType_t xGcm, uint8_t *pucBuffer, size_t xLength);
+static void prvPrintResult(const char *pcName, BaseType_t xPass);
+static void prvPrintHex(const char *pcPrefix, const uint8_t *pucData, size_t xLength);
+void printmsg(char *msg);
+char UsrMsg[250];
+
+
+int main()
+{
+	// Enable the DWT Cycle Count Register (SEGGER Settings)
+	DWT->CTRL |= (1 << 0);
+
+	// Private functions called to setup the Hardware. The clock first: the UART baud rate depends on it.
+	prvSetupClock();
+	prvSetupUART();
+
+	//Start Recording for SEGGER SystemView
+	SEGGER_SYSVIEW_Conf();
+	SEGGER_SYSVIEW_Start();
+
+	sprintf(UsrMsg,"Example of AES-CTR/GCM encryption of log records with the AES unit and DMA \r\n");
+	printmsg(UsrMsg);
+
+	//The engine works without the AES unit too (software AES)
+	if(xAesEngineInit() == pdPASS)
+	{
+		sprintf(UsrMsg, "AES unit ready (self test passed) \r\n");
+	}
+	else
+	{
+		sprintf(UsrMsg, "AES unit not available, software AES only \r\n");
+	}
+	printmsg(UsrMsg);
+
+	//Create Test Task. It creates the logger tasks when the tests and the benchmark are done.
+	xTaskCreate(vTestTaskFunction, "Test-Task", 512, NULL, 2, &xTestTask);
+
+	//Schedule the tasks
+	vTaskStartScheduler();
+
+	/*
+	 * If scheduler can start the tasks and run them, the program will never reach here.
+	 * If the program comes to the below line, that means there was a problem while creating or scheduling the tasks
+	 */
+	for(;;);
+}
+
+
+void vTestTaskFunction(void *params)
+{
+	BaseType_t xHardware = xAesEngineIsHardware();
+
+	//1. Test vectors with both paths
+	if(xHardware == pdTRUE)
+	{
+		printmsg("\r\nTest vectors, AES unit: \r\n");
+		prvCheckVectors();
+		vAesEngineUseHardware(pdFALSE);
+	}
+
+	printmsg("\r\nTest vectors, software AES: \r\n");
+	prvCheckVectors();
+
+	//2. Throughput of both paths, aligned and not aligned buffers
+	printmsg("\r\nThroughput: \r\n");
+	if(xHardware == pdTRUE)
+	{
+		vAesEngineUseHardware(pdTRUE);
+		prvBenchmark("CTR AES unit", pdFALSE, (uint8_t *) ulBenchmarkBuffer, BENCHMARK_SIZE);
+		prvBenchmark("CTR AES unit, not aligned", pdFALSE, (uint8_t *) ulBenchmarkBuffer + 1, BENCHMARK_SIZE - AES_BLOCK_SIZE);
+		prvBenchmark("GCM AES unit", pdTRUE, (uint8_t *) ulBenchmarkBuffer, BENCHMARK_SIZE - AES_BLOCK_SIZE);
+		vAesEngineUseHardware(pdFALSE);
+	}
+	prvBenchmark("CTR software", pdFALSE, (uint8_t *) ulBenchmarkBuffer, BENCHMARK_SIZE);
+	prvBenchmark("GCM software", pdTRUE, (uint8_t *) ulBenchmarkBuffer, BENCHMARK_SIZE - AES_BLOCK_SIZE);
+	vAesEngineUseHardware(xHardware);
+
+	//3. The loggers use the engine at the same time
+	xTaskCreate(vCtrLoggerTaskFunction, "CTR-Logger", 384, NULL, 2, &xCtrLoggerTask);
+	xTaskCreate(vGcmLoggerTaskFunction, "GCM-Logger", 384, NULL, 2, &xGcmLoggerTask);
+
+	vTaskDelete(NULL);
+}
+
+
+void vCtrLoggerTaskFunction(void *params)
+{
+	static AesCtrContext_t xEncryptStream, xDecryptStream;
+	uint8_t ucCounter[AES_BLOCK_SIZE];
+	char cRecord[RECORD_SIZE];
+	uint8_t ucEncrypted[RECORD_SIZE];
+	uint8_t ucDecrypted[RECORD_SIZE];
+	char cPrefix[48];
+	uint32_t ulRecord = 0;
+	size_t xLength;
+
+	//The receiver of the log keeps its own stream with the same key and first counter block
+	memset(ucCounter, 0, sizeof(ucCounter));
+	ucCounter[0] = 'C';
+	vAesCtrStart(&xEncryptStream, ucLogKey, sizeof(ucLogKey), ucCounter);
+	vAesCtrStart(&xDecryptStream, ucLogKey, sizeof(ucLogKey), ucCounter);
+
+	while(1)
+	{
+		xLength = sprintf(cRecord, "Tick %lu: CTR record %lu, free heap %u", xTaskGetTickCount(), ulRecord++, xPortGetFreeHeapSize());
+
+		//The records are not a multiple of the block size: the next record continues the key stream
+		xAesCtrProcess(&xEncryptStream, (uint8_t *) cRecord, ucEncrypted, xLength);
+		xAesCtrProcess(&xDecryptStream, ucEncrypted, ucDecrypted, xLength);
+
+		sprintf(cPrefix, "CTR logger: %u bytes, %s ", xLength, (memcmp(ucDecrypted, cRecord, xLength) == 0) ? "ok" : "ERROR");
+		prvPrintHex(cPrefix, ucEncrypted, 8);
+		vTaskDelay(pdMS_TO_TICKS(1000));
+	}
+}
+
+
+void vGcmLoggerTaskFunction(void *params)
+{
+	uint8_t ucIV[AES_GCM_IV_SIZE];
+	uint32_t ulRecord[RECORD_SIZE / 4];
+	uint32_t ulEncrypted[AES_OUTPUT_SIZE(RECORD_SIZE) / 4];
+	uint32_t ulDecrypted[AES_OUTPUT_SIZE(RECORD_SIZE) / 4];
+	uint32_t ulHeader[2];
+	uint8_t ucTag[AES_GCM_TAG_SIZE];
+	uint32_t ulNumber = 0;
+	size_t xLength;
+	char cPrefix[48];
+	BaseType_t xValid;
+
+	memset(ucIV, 0, sizeof(ucIV));
+	ucIV[0] = 'G';
+
+	while(1)
+	{
+		xLength = sprintf((char *) ulRecord, "Tick %lu: GCM record %lu", xTaskGetTickCount(), ulNumber);
+
+		//An IV is never used twice with the same key: the record number is in the IV.
+		//The header (record number and length) is sent in clear and authenticated with the record.
+		ucIV[8] = (uint8_t)(ulNumber >> 24);
+		ucIV[9] = (uint8_t)(ulNumber >> 16);
+		ucIV[10] = (uint8_t)(ulNumber >> 8);
+		ucIV[11] = (uint8_t) ulNumber;
+		ulHeader[0] = ulNumber++;
+		ulHeader[1] = xLength;
+
+		xAesGcmEncrypt(ucLogKey, sizeof(ucLogKey), ucIV, (uint8_t *) ulHeader, sizeof(ulHeader),
+					   (uint8_t *) ulRecord, (uint8_t *) ulEncrypted, xLength, ucTag);
+
+		xValid = xAesGcmDecrypt(ucLogKey, sizeof(ucLogKey), ucIV, (uint8_t *) ulHeader, sizeof(ulHeader),
+								(uint8_t *) ulEncrypted, (uint8_t *) ulDecrypted, xLength, ucTag);
+
+		sprintf(cPrefix, "GCM logger: %u bytes, %s ", xLength,
+				((xValid == pdPASS) && (memcmp(ulDecrypted, ulRecord, xLength) == 0)) ? "ok" : "ERROR");
+		prvPrintHex(cPrefix, (uint8_t *) ulEncrypted, 8);
+		vTaskDelay(pdMS_TO_TICKS(1500));
+	}
+}
+
+
+//The test vectors with the current path (CTR in pieces of 7, 25 and 32 bytes)
+static void prvCheckVectors(void)
+{
+	AesCtrContext_t xStream;
+	uint8_t ucTag[AES_GCM_TAG_SIZE];
+	uint8_t *pucInput = (uint8_t *) ulInput;
+	uint8_t *pucOutput = (uint8_t *) ulOutput;
+	BaseType_t xPass;
+
+	memcpy(ulInput, ucCtrPlain, sizeof(ucCtrPlain));
+
+	vAesCtrStart(&xStream, ucCtrKey128, sizeof(ucCtrKey128), ucCtrCounter);
+	xPass = xAesCtrProcess(&xStream, pucInput, pucOutput, 7);
+	xPass &= xAesCtrProcess(&xStream, &pucInput[7], &pucOutput[7], 25);
+	xPass &= xAesCtrProcess(&xStream, &pucInput[32], &pucOutput[32], 32);
+	prvPrintResult("CTR-AES128 (SP 800-38A F.5.1)", xPass && (memcmp(ulOutput, ucCtrCipher128, sizeof(ucCtrCipher128)) == 0));
+
+	vAesCtrStart(&xStream, ucCtrKey256, sizeof(ucCtrKey256), ucCtrCounter);
+	xPass = xAesCtrProcess(&xStream, pucInput, pucOutput, sizeof(ucCtrPlain));
+	prvPrintResult("CTR-AES256 (SP 800-38A F.5.5)", xPass && (memcmp(ulOutput, ucCtrCipher256, sizeof(ucCtrCipher256)) == 0));
+
+	memcpy(ulInput, ucGcmPlain, sizeof(ucGcmPlain));
+	memcpy(ulAad, ucGcmAad, sizeof(ucGcmAad));
+
+	xPass = xAesGcmEncrypt(ucGcmKey, 16, ucGcmIV, (uint8_t *) ulAad, sizeof(ucGcmAad), pucInput, pucOutput, sizeof(ucGcmPlain), ucTag);
+	xPass = xPass && (memcmp(ulOutput, ucGcmCipher128, sizeof(ucGcmCipher128)) == 0) && (memcmp(ucTag, ucGcmTag128, sizeof(ucTag)) == 0);
+	prvPrintResult("GCM-AES128 encryption (test case 4)", xPass);
+
+	memcpy(ulInput, ucGcmCipher128, sizeof(ucGcmCipher128));
+	xPass = xAesGcmDecrypt(ucGcmKey, 16, ucGcmIV, (uint8_t *) ulAad, sizeof(ucGcmAad), pucInput, pucOutput, sizeof(ucGcmCipher128), ucGcmTag128);
+	prvPrintResult("GCM-AES128 decryption (test case 4)", xPass && (memcmp(ulOutput, ucGcmPlain, sizeof(ucGcmPlain)) == 0));
+
+	//A single bit changed in the ciphertext: the tag does not match
+	pucInput[10] ^= 0x01;
+	xPass = xAesGcmDecrypt(ucGcmKey, 16, ucGcmIV, (uint8_t *) ulAad, sizeof(ucGcmAad), pucInput, pucOutput, sizeof(ucGcmCipher128), ucGcmTag128);
+	prvPrintResult("GCM-AES128 modified ciphertext rejected", (xPass == pdFAIL) ? pdPASS : pdFAIL);
+
+	memcpy(ulInput, ucGcmPlain, sizeof(ucGcmPlain));
+	xPass = xAesGcmEncrypt(ucGcmKey, 32, ucGcmIV, (uint8_t *) ulAad, sizeof(ucGcmAad), pucInput, pucOutput, sizeof(ucGcmPlain), ucTag);
+	xPass = xPass && (memcmp(ulOutput, ucGcmCipher256, sizeof(ucGcmCipher256)) == 0) && (memcmp(ucTag, ucGcmTag256, sizeof(ucTag)) == 0);
+	prvPrintResult("GCM-AES256 encryption (test case 16)", xPass);
+}
+
+//Encrypts the buffer once and prints the throughput in MB/s
+static void prvBenchmark(const char *pcName, BaseType_t xGcm, uint8_t *pucBuffer, size_t xLength)
+{
+	AesCtrContext_t xStream;
+	uint8_t ucCounter[AES_BLOCK_SIZE];
+	uint8_t ucTag[AES_GCM_TAG_SIZE];
+	uint32_t ulCycles, ulRate;
+
+	memset(ucCounter, 0, sizeof(ucCounter));
+	vAesCtrStart(&xStream, ucLogKey, sizeof(ucLogKey), ucCounter);
+
+	ulCycles = DWT->CYCCNT;
+	if(xGcm == pdTRUE)
+	{
+		xAesGcmEncrypt(ucLogKey, sizeof(ucLogKey), ucCounter, NULL, 0, pucBuffer, pucBuffer, xLength, ucTag);
+	}
+	else
+	{
+		xAesCtrProcess(&xStream, pucBuffer, pucBuffer, xLength);
+	}
+	ulCycles = DWT->CYCCNT - ulCycles;
+
+	//MB/s with 2 decimals: bytes / (cycles / f) / 10^6 * 100
+	ulRate = (uint32_t)(((uint64_t) xLength * SystemCoreClock) / ((uint64_t) ulCycles * 10000));
+
+	sprintf(UsrMsg, "  %-28s %5u bytes %9lu cycles %3lu.%02lu MB/s \r\n", pcName, xLength, ulCycles, ulRate / 100, ulRate % 100);
+	printmsg(UsrMsg);
+}
+
+static void prvPrintResult(const char *pcName, BaseType_t xPass)
+{
+	sprintf(UsrMsg, "  %-40s %s \r\n", pcName, (xPass != pdFAIL) ? "PASS" : "FAIL");
+	printmsg(UsrMsg);
+}
+
+//Prints the prefix and the first bytes of the data in hexadecimal (own buffer: called by both loggers)
+static void prvPrintHex(const char *pcPrefix, const uint8_t *pucData, size_t xLength)
+{
+	char cLine[200];
+	size_t xPosition, i;
+
+	xPosition = sprintf(cLine, "%s", pcPrefix);
+	for(i = 0; i < xLength; i++)
+	{
+		xPosition += sprintf(&cLine[xPosition], "%02x", pucData[i]);
+	}
+	sprintf(&cLine[xPosition], "\r\n");
+
+	printmsg(cLine);
+}
+
+
+static void prvSetupClock(void)
+{
+	//MSI 4 MHz -> 32 MHz, which needs 1 flash wait state. The AES unit runs at HCLK.
+	__HAL_FLASH_SET_LATENCY(FLASH_LATENCY_1);
+	while(__HAL_FLASH_GET_LATENCY() != FLASH_LATENCY_1);
+
+	__HAL_RCC_MSI_RANGE_CONFIG(RCC_MSIRANGE_10);
+	while(__HAL_RCC_GET_FLAG(RCC_FLAG_MSIRDY) == 0);
+
+	//SystemCoreClock is used by the kernel tick, SystemView, the UART baud rate and the benchmark
+	SystemCoreClockUpdate();
+}
+
+static void prvSetupUART(void)
+{
+	//1. Enable the UART1 and GPIOB Peripheral Clocks
+	__HAL_RCC_USART1_CLK_ENABLE();
+	__HAL_RCC_GPIOB_CLK_ENABLE();
+
+	//In UART connection with Virtual COM-port, PB6->TX and PB7->RX
+	//2. Alternate Functionality Configuration to make Port B pins work as UART pins
+
+	//Zeroing each and every member element of the structure.
+	memset(&GpioUARTpins, 0, sizeof(GpioUARTpins));
+	GpioUARTpins.Pin = GPIO_PIN_6 | GPIO_PIN_7;
+	GpioUARTpins.Mode = GPIO_MODE_AF_PP;
+	GpioUARTpins.Alternate = GPIO_AF7_USART1;
+	GpioUARTpins.Pull = GPIO_PULLUP;
+
+	HAL_GPIO_Init(GPIOB, &GpioUARTpins);
+
+	//3. Configure and initialize UART parameters
+
+	//Zeroing each and every member element of the structure.
+	memset(&Uart1Init, 0, sizeof(Uart1Init));
+	memset(&Uart1, 0, sizeof(Uart1));
+
+	//UART Initialization
+	Uart1Init.BaudRate = 115200;
+	Uart1Init.WordLength = UART_WORDLENGTH_8B;
+	Uart1Init.HwFlowCtl = UART_HWCONTROL_NONE;
+	Uart1Init.Mode = UART_MODE_TX_RX;
+	Uart1Init.Parity = UART_PARITY_NONE;
+	Uart1Init.StopBits = UART_STOPBITS_1;
+
+	Uart1.Init = Uart1Init;
+	Uart1.Instance = USART1;
+
+	//4. Initialize the UART peripheral
+	uint16_t UARTSetUpResult = HAL_UART_Init(&Uart1);
+
+	if(UARTSetUpResult == HAL_ERROR)
+	{
+		//printf("USART Initialization was not successful \n");
+	}
+
+}
+
+void printmsg(char *msg)
+{
+	HAL_UART_Transmit(&Uart1, (uint8_t *)msg, strlen(msg), 1);
+}
+
+//Implement the Idle Hook function
+void vApplicationIdleHook()
+{
+	//Send the CPU to normal sleep mode
+	__WFI();
+}
@@ -0,0 +1,210 @@
+/*
+ * AesSoft.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * The state is kept as 4 columns of 4 bytes, each column in a 32 bit word with the byte of row 0 in the
+ * low byte. The GF(2^8) operations are done on the 4 bytes of a word at once (SIMD within a register):
+ * xtime() doubles each byte, and the multiplication is 8 steps of xtime() and masked XOR.
+ *
+ * S-box: inverse x^254 (0 for 0) computed with 6 squares and 4 multiplications, then the affine transform.
+ * The round keys are in the same word format, so a round key is added to a column with one XOR.
+ */
+
+#include "stdint.h"
+#include "AesSoft.h"
+
+#define BYTES_LSB		0x01010101UL
+#define BYTES_LOW7		0x7F7F7F7FUL
+
+//Rotation of each byte of a word by n bits to the left
+#define ROTL_BYTES(x, n)	( (((x) << (n)) & (0xFFUL * BYTES_LSB & ~((0xFFUL >> (8 - (n))) * BYTES_LSB))) | \
+							  (((x) >> (8 - (n))) & ((0xFFUL >> (8 - (n))) * BYTES_LSB)) )
+
+//Rotation of a word: ROTR_WORD(x, 8) moves the byte of row r+1 to row r
+#define ROTR_WORD(x, n)		( ((x) >> (n)) | ((x) << (32 - (n))) )
+
+//Private helper functions
+static uint32_t prvXtime(uint32_t ulBytes);
+static uint32_t prvMultiply(uint32_t ulA, uint32_t ulB);
+static uint32_t prvSubWord(uint32_t ulWord);
+static uint32_t prvLoad(const uint8_t *pucBytes);
+static void prvStore(uint8_t *pucBytes, uint32_t ulWord);
+
+
+void vAesSoftSetKey(AesSoftKey_t *pxKey, const uint8_t *pucKey, size_t xKeyLength)
+{
+	uint32_t ulWords = xKeyLength / 4;
+	uint32_t ulTotal, ulTemp, ulRcon = 0x01, i;
+
+	pxKey->ucRounds = (uint8_t)(ulWords + 6);
+	ulTotal = 4 * (pxKey->ucRounds + 1);
+
+	for(i = 0; i < ulWords; i++)
+	{
+		pxKey->ulRoundKeys[i] = prvLoad(&pucKey[4 * i]);
+	}
+
+	for(i = ulWords; i < ulTotal; i++)
+	{
+		ulTemp = pxKey->ulRoundKeys[i - 1];
+
+		if( (i % ulWords) == 0 )
+		{
+			//RotWord, SubWord and round constant (in the byte of row 0)
+			ulTemp = prvSubWord(ROTR_WORD(ulTemp, 8)) ^ ulRcon;
+			ulRcon = prvXtime(ulRcon);
+		}
+		else if( (ulWords > 6) && ((i % ulWords) == 4) )
+		{
+			ulTemp = prvSubWord(ulTemp);
+		}
+
+		pxKey->ulRoundKeys[i] = pxKey->ulRoundKeys[i - ulWords] ^ ulTemp;
+	}
+}
+
+void vAesSoftEncryptBlock(const AesSoftKey_t *pxKey, const uint8_t *pucInput, uint8_t *pucOutput)
+{
+	const uint32_t *pulRoundKey = pxKey->ulRoundKeys;
+	uint32_t ulState[4], ulShifted[4], ulRot;
+	uint8_t ucRound, c;
+
+	for(c = 0; c < 4; c++)
+	{
+		ulState[c] = prvLoad(&pucInput[4 * c]) ^ pulRoundKey[c];
+	}
+
+	for(ucRound = 1; ucRound <= pxKey->ucRounds; ucRound++)
+	{
+		pulRoundKey += 4;
+
+		//SubBytes
+		for(c = 0; c < 4; c++)
+		{
+			ulState[c] = prvSubWord(ulState[c]);
+		}
+
+		//ShiftRows: row r of column c comes from column c + r
+		for(c = 0; c < 4; c++)
+		{
+			ulShifted[c] = (ulState[c] & 0x000000FFUL) | (ulState[(c + 1) & 3] & 0x0000FF00UL) |
+						   (ulState[(c + 2) & 3] & 0x00FF0000UL) | (ulState[(c + 3) & 3] & 0xFF000000UL);
+		}
+
+		//MixColumns (not in the last round): b[r] = 2a[r] ^ 3a[r+1] ^ a[r+2] ^ a[r+3]
+		for(c = 0; c < 4; c++)
+		{
+			if(ucRound != pxKey->ucRounds)
+			{
+				ulRot = ROTR_WORD(ulShifted[c], 8);
+				ulShifted[c] = prvXtime(ulShifted[c] ^ ulRot) ^ ulRot ^ ROTR_WORD(ulShifted[c], 16) ^ ROTR_WORD(ulShifted[c], 24);
+			}
+
+			ulState[c] = ulShifted[c] ^ pulRoundKey[c];
+		}
+	}
+
+	for(c = 0; c < 4; c++)
+	{
+		prvStore(&pucOutput[4 * c], ulState[c]);
+	}
+}
+
+void vAesSoftGcmMultiply(uint8_t *pucX, const uint8_t *pucH)
+{
+	uint32_t ulZ[4] = { 0, 0, 0, 0 };
+	uint32_t ulV[4], ulMask;
+	uint8_t i, j;
+
+	//Big endian words: bit 0 of the GCM order is the MSB of ulV[0]
+	for(j = 0; j < 4; j++)
+	{
+		ulV[j] = ((uint32_t) pucH[4 * j] << 24) | ((uint32_t) pucH[4 * j + 1] << 16) |
+				 ((uint32_t) pucH[4 * j + 2] << 8) | (uint32_t) pucH[4 * j + 3];
+	}
+
+	for(i = 0; i < 128; i++)
+	{
+		//Z ^= V if bit i of X is set, V = V * x (shift right, reduced by R = 0xE1 || 0^120)
+		ulMask = 0UL - (uint32_t)((pucX[i / 8] >> (7 - (i % 8))) & 0x01);
+		for(j = 0; j < 4; j++)
+		{
+			ulZ[j] ^= ulV[j] & ulMask;
+		}
+
+		ulMask = 0UL - (ulV[3] & 0x01);
+		ulV[3] = (ulV[3] >> 1) | (ulV[2] << 31);
+		ulV[2] = (ulV[2] >> 1) | (ulV[1] << 31);
+		ulV[1] = (ulV[1] >> 1) | (ulV[0] << 31);
+		ulV[0] = (ulV[0] >> 1) ^ (0xE1000000UL & ulMask);
+	}
+
+	for(j = 0; j < 4; j++)
+	{
+		pucX[4 * j] = (uint8_t)(ulZ[j] >> 24);
+		pucX[4 * j + 1] = (uint8_t)(ulZ[j] >> 16);
+		pucX[4 * j + 2] = (uint8_t)(ulZ[j] >> 8);
+		pucX[4 * j + 3] = (uint8_t) ulZ[j];
+	}
+}
+
+
+//Multiplication of each byte by x in GF(2^8), modulo x^8 + x^4 + x^3 + x + 1
+static uint32_t prvXtime(uint32_t ulBytes)
+{
+	return ((ulBytes & BYTES_LOW7) << 1) ^ (((ulBytes >> 7) & BYTES_LSB) * 0x1B);
+}
+
+//Multiplication of each byte of ulA by the same byte of ulB in GF(2^8)
+static uint32_t prvMultiply(uint32_t ulA, uint32_t ulB)
+{
+	uint32_t ulResult = 0;
+	uint8_t i;
+
+	for(i = 0; i < 8; i++)
+	{
+		ulResult ^= ulA & (((ulB >> i) & BYTES_LSB) * 0xFF);
+		ulA = prvXtime(ulA);
+	}
+
+	return ulResult;
+}
+
+//S-box on the 4 bytes of a word
+static uint32_t prvSubWord(uint32_t ulWord)
+{
+	uint32_t ulX2, ulX3, ulX12, ulX15, ulInverse;
+
+	//x^254 = x^240 * x^14
+	ulX2 = prvMultiply(ulWord, ulWord);
+	ulX3 = prvMultiply(ulX2, ulWord);
+	ulX12 = prvMultiply(ulX3, ulX3);
+	ulX12 = prvMultiply(ulX12, ulX12);
+	ulX15 = prvMultiply(ulX12, ulX3);
+	ulInverse = prvMultiply(ulX15, ulX15);
+	ulInverse = prvMultiply(ulInverse, ulInverse);
+	ulInverse = prvMultiply(ulInverse, ulInverse);
+	ulInverse = prvMultiply(ulInverse, ulInverse);
+	ulInverse = prvMultiply(ulInverse, prvMultiply(ulX12, ulX2));
+
+	//Affine transform
+	return ulInverse ^ ROTL_BYTES(ulInverse, 1) ^ ROTL_BYTES(ulInverse, 2) ^ ROTL_BYTES(ulInverse, 3) ^
+		   ROTL_BYTES(ulInverse, 4) ^ (0x63UL * BYTES_LSB);
+}
+
+static uint32_t prvLoad(const uint8_t *pucBytes)
+{
+	return (uint32_t) pucBytes[0] | ((uint32_t) pucBytes[1] << 8) | ((uint32_t) pucBytes[2] << 16) | ((uint32_t) pucBytes[3] << 24);
+}
+
+static void prvStore(uint8_t *pucBytes, uint32_t ulWord)
+{
+	pucBytes[0] = (uint8_t) ulWord;
+	pucBytes[1] = (uint8_t)(ulWord >> 8);
+	pucBytes[2] = (uint8_t)(ulWord >> 16);
+	pucBytes[3] = (uint8_t)(ulWord >> 24);
+}
@@ -0,0 +1,462 @@
+/*
+ * AssetStore.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * The flash is used in indirect mode (commands) at the start and while a container is written, and in
+ * memory-mapped mode the rest of the time. In memory-mapped mode, nCS is released after
+ * MAPPED_CS_TIMEOUT cycles without access, so the flash can go to standby between the reads.
+ *
+ * Container: see Tools/asset_pack.py. The structures below are its header and index entries.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stm32wbxx.h"
+#include "stm32wbxx_hal.h"
+#include "stddef.h"
+#include "string.h"
+#include "Crc32.h"
+#include "AssetStore.h"
+
+#define ASSET_MAGIC					0x54535341UL			//"ASST"
+#define ASSET_VERSION				1
+
+//Flash commands
+#define CMD_RESET_ENABLE			0x66
+#define CMD_RESET					0x99
+#define CMD_READ_ID					0x9F
+#define CMD_WRITE_ENABLE			0x06
+#define CMD_READ_STATUS				0x05
+#define CMD_SECTOR_ERASE			0x20
+#define CMD_PAGE_PROGRAM			0x02
+#define CMD_QUAD_READ				0xEB
+
+#define STATUS_WIP					0x01
+#define STATUS_WEL					0x02
+
+#define SECTOR_SIZE					4096
+#define PAGE_SIZE					256
+#define MAPPED_CS_TIMEOUT			32
+#define QSPI_TIMEOUT				HAL_QPSI_TIMEOUT_DEFAULT_VALUE		//(sic, HAL name)
+
+typedef struct AssetHeader
+{
+	uint32_t ulMagic;
+	uint16_t usVersion;
+	uint16_t usCount;
+	uint32_t ulSize;
+	uint32_t ulCrc;							//Of the first 12 bytes and the index
+}AssetHeader_t;
+
+typedef struct AssetEntry
+{
+	char cName[ASSET_NAME_SIZE];
+	uint32_t ulOffset;						//From the start of the container
+	uint32_t ulLength;
+	uint32_t ulCrc;
+	uint16_t usType;
+	uint16_t usReserved;
+}AssetEntry_t;
+
+static QSPI_HandleTypeDef QspiHandle;
+static uint32_t ulJedecId = 0;
+
+//Valid container, NULL if none
+static const AssetHeader_t *pxHeader = NULL;
+static const AssetEntry_t *pxIndex = NULL;
+
+//Private helper functions
+static void prvSetupPins(void);
+static HAL_StatusTypeDef prvCommand(uint8_t ucInstruction, uint32_t ulAddressMode, uint32_t ulAddress, uint32_t ulNbData);
+static HAL_StatusTypeDef prvWriteEnable(void);
+static HAL_StatusTypeDef prvWaitReady(void);
+static HAL_StatusTypeDef prvEnableQuad(void);
+static HAL_StatusTypeDef prvMap(void);
+static void prvCheckContainer(void);
+static const AssetEntry_t *prvFindEntry(const char *pcName);
+
+
+BaseType_t xAssetStoreInit(void)
+{
+	uint8_t ucId[3];
+
+	//1. QUADSPI in indirect mode
+	prvSetupPins();
+	__HAL_RCC_QUADSPI_CLK_ENABLE();
+	memset(&QspiHandle, 0, sizeof(QspiHandle));
+	QspiHandle.Instance = QUADSPI;
+	QspiHandle.Init.ClockPrescaler = ASSET_QSPI_PRESCALER;
+	QspiHandle.Init.FifoThreshold = 4;
+	QspiHandle.Init.SampleShifting = QSPI_SAMPLE_SHIFTING_HALFCYCLE;
+	QspiHandle.Init.FlashSize = ASSET_FLASH_SIZE_BITS - 1;
+	QspiHandle.Init.ChipSelectHighTime = QSPI_CS_HIGH_TIME_2_CYCLE;
+	QspiHandle.Init.ClockMode = QSPI_CLOCK_MODE_0;
+	if(HAL_QSPI_Init(&QspiHandle) != HAL_OK)
+	{
+		return pdFAIL;
+	}
+
+	//2. Flash: reset (it may be left in a continuous read by a debug session), ID, quad enable bit
+	if( (prvCommand(CMD_RESET_ENABLE, QSPI_ADDRESS_NONE, 0, 0) != HAL_OK) || (prvCommand(CMD_RESET, QSPI_ADDRESS_NONE, 0, 0) != HAL_OK) ||
+		(prvWaitReady() != HAL_OK) )
+	{
+		return pdFAIL;
+	}
+
+	if( (prvCommand(CMD_READ_ID, QSPI_ADDRESS_NONE, 0, sizeof(ucId)) != HAL_OK) ||
+		(HAL_QSPI_Receive(&QspiHandle, ucId, QSPI_TIMEOUT) != HAL_OK) )
+	{
+		return pdFAIL;
+	}
+	ulJedecId = (ucId[0] << 16) | (ucId[1] << 8) | ucId[2];
+	if( (ulJedecId == 0) || (ulJedecId == 0xFFFFFF) )
+	{
+		//No flash: the data lines are not driven
+		return pdFAIL;
+	}
+
+	if( (prvEnableQuad() != HAL_OK) || (prvMap() != HAL_OK) )
+	{
+		return pdFAIL;
+	}
+
+	//3. Container
+	prvCheckContainer();
+
+	return pdPASS;
+}
+
+
+uint32_t ulAssetStoreJedecId(void)
+{
+	return ulJedecId;
+}
+
+
+uint32_t ulAssetCount(void)
+{
+	return (pxHeader != NULL) ? pxHeader->usCount : 0;
+}
+
+
+const void *pvAssetFind(const char *pcName, uint32_t *pulLength)
+{
+	const AssetEntry_t *pxEntry = prvFindEntry(pcName);
+
+	if(pxEntry == NULL)
+	{
+		return NULL;
+	}
+
+	if(pulLength != NULL)
+	{
+		*pulLength = pxEntry->ulLength;
+	}
+	return (const uint8_t *) pxHeader + pxEntry->ulOffset;
+}
+
+
+const char *pcAssetText(const char *pcName)
+{
+	const AssetEntry_t *pxEntry = prvFindEntry(pcName);
+
+	if( (pxEntry == NULL) || (pxEntry->usType != ASSET_TYPE_TEXT) )
+	{
+		return NULL;
+	}
+	return (const char *) pxHeader + pxEntry->ulOffset;
+}
+
+
+BaseType_t xAssetVerify(const char *pcName)
+{
+	const AssetEntry_t *pxEntry = prvFindEntry(pcName);
+
+	if(pxEntry == NULL)
+	{
+		return pdFAIL;
+	}
+	return (ulCrc32Software(0, (const uint8_t *) pxHeader + pxEntry->ulOffset, pxEntry->ulLength) == pxEntry->ulCrc) ? pdPASS : pdFAIL;
+}
+
+
+BaseType_t xAssetStoreProgram(const uint8_t *pucImage, uint32_t ulLength)
+{
+	uint32_t ulAddress;
+	uint32_t ulChunk;
+	HAL_StatusTypeDef xStatus = HAL_OK;
+
+	if( (ulLength == 0) || ((ASSET_STORE_OFFSET + ulLength) > (1UL << ASSET_FLASH_SIZE_BITS)) )
+	{
+		return pdFAIL;
+	}
+
+	//1. Out of the memory-mapped mode: the container is not valid any more
+	pxHeader = NULL;
+	pxIndex = NULL;
+	HAL_QSPI_Abort(&QspiHandle);
+
+	//2. Erase the sectors, then program page by page (a page program must not cross the end of a page)
+	for(ulAddress = 0; (ulAddress < ulLength) && (xStatus == HAL_OK); ulAddress += SECTOR_SIZE)
+	{
+		xStatus = prvWriteEnable();
+		if(xStatus == HAL_OK)
+		{
+			xStatus = prvCommand(CMD_SECTOR_ERASE, QSPI_ADDRESS_1_LINE, ASSET_STORE_OFFSET + ulAddress, 0);
+		}
+		if(xStatus == HAL_OK)
+		{
+			xStatus = prvWaitReady();
+		}
+	}
+
+	for(ulAddress = 0; (ulAddress < ulLength) && (xStatus == HAL_OK); ulAddress += ulChunk)
+	{
+		ulChunk = PAGE_SIZE - ((ASSET_STORE_OFFSET + ulAddress) % PAGE_SIZE);
+		if(ulChunk > (ulLength - ulAddress))
+		{
+			ulChunk = ulLength - ulAddress;
+		}
+
+		xStatus = prvWriteEnable();
+		if(xStatus == HAL_OK)
+		{
+			xStatus = prvCommand(CMD_PAGE_PROGRAM, QSPI_ADDRESS_1_LINE, ASSET_STORE_OFFSET + ulAddress, ulChunk);
+		}
+		if(xStatus == HAL_OK)
+		{
+			xStatus = HAL_QSPI_Transmit(&QspiHandle, (uint8_t *) &pucImage[ulAddress], QSPI_TIMEOUT);
+		}
+		if(xStatus == HAL_OK)
+		{
+			xStatus = prvWaitReady();
+		}
+	}
+
+	//3. Mapped again, and the new container checked
+	if( (prvMap() != HAL_OK) || (xStatus != HAL_OK) )
+	{
+		return pdFAIL;
+	}
+	prvCheckContainer();
+
+	return ( (pxHeader != NULL) && (memcmp(pxHeader, pucImage, ulLength) == 0) ) ? pdPASS : pdFAIL;
+}
+
+
+static void prvSetupPins(void)
+{
+	GPIO_InitTypeDef GpioQspiPins;
+
+	__HAL_RCC_GPIOA_CLK_ENABLE();
+	__HAL_RCC_GPIOB_CLK_ENABLE();
+
+	memset(&GpioQspiPins, 0, sizeof(GpioQspiPins));
+	GpioQspiPins.Mode = GPIO_MODE_AF_PP;
+	GpioQspiPins.Pull = GPIO_NOPULL;
+	GpioQspiPins.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+	GpioQspiPins.Alternate = GPIO_AF10_QUADSPI;
+
+	GpioQspiPins.Pin = GPIO_PIN_2 | GPIO_PIN_3 | GPIO_PIN_6 | GPIO_PIN_7;
+	HAL_GPIO_Init(GPIOA, &GpioQspiPins);
+
+	GpioQspiPins.Pin = GPIO_PIN_8 | GPIO_PIN_9;
+	HAL_GPIO_Init(GPIOB, &GpioQspiPins);
+}
+
+
+//Command on one line, with a 24-bit address (or not) and ulNbData bytes of data on one line (to transmit or receive)
+static HAL_StatusTypeDef prvCommand(uint8_t ucInstruction, uint32_t ulAddressMode, uint32_t ulAddress, uint32_t ulNbData)
+{
+	QSPI_CommandTypeDef xCommand;
+
+	memset(&xCommand, 0, sizeof(xCommand));
+	xCommand.InstructionMode = QSPI_INSTRUCTION_1_LINE;
+	xCommand.Instruction = ucInstruction;
+	xCommand.AddressMode = ulAddressMode;
+	xCommand.AddressSize = QSPI_ADDRESS_24_BITS;
+	xCommand.Address = ulAddress;
+	xCommand.AlternateByteMode = QSPI_ALTERNATE_BYTES_NONE;
+	xCommand.DataMode = (ulNbData != 0) ? QSPI_DATA_1_LINE : QSPI_DATA_NONE;
+	xCommand.NbData = ulNbData;
+	xCommand.DdrMode = QSPI_DDR_MODE_DISABLE;
+	xCommand.SIOOMode = QSPI_SIOO_INST_EVERY_CMD;
+
+	return HAL_QSPI_Command(&QspiHandle, &xCommand, QSPI_TIMEOUT);
+}
+
+
+static HAL_StatusTypeDef prvWriteEnable(void)
+{
+	QSPI_CommandTypeDef xCommand;
+	QSPI_AutoPollingTypeDef xPolling;
+
+	if(prvCommand(CMD_WRITE_ENABLE, QSPI_ADDRESS_NONE, 0, 0) != HAL_OK)
+	{
+		return HAL_ERROR;
+	}
+
+	//Until the write enable latch is set
+	memset(&xCommand, 0, sizeof(xCommand));
+	xCommand.InstructionMode = QSPI_INSTRUCTION_1_LINE;
+	xCommand.Instruction = CMD_READ_STATUS;
+	xCommand.DataMode = QSPI_DATA_1_LINE;
+
+	memset(&xPolling, 0, sizeof(xPolling));
+	xPolling.Match = STATUS_WEL;
+	xPolling.Mask = STATUS_WEL;
+	xPolling.MatchMode = QSPI_MATCH_MODE_AND;
+	xPolling.StatusBytesSize = 1;
+	xPolling.Interval = 16;
+	xPolling.AutomaticStop = QSPI_AUTOMATIC_STOP_ENABLE;
+
+	return HAL_QSPI_AutoPolling(&QspiHandle, &xCommand, &xPolling, QSPI_TIMEOUT);
+}
+
+
+//Until the end of the erase or program (status polled by the QUADSPI, not by the CPU)
+static HAL_StatusTypeDef prvWaitReady(void)
+{
+	QSPI_CommandTypeDef xCommand;
+	QSPI_AutoPollingTypeDef xPolling;
+
+	memset(&xCommand, 0, sizeof(xCommand));
+	xCommand.InstructionMode = QSPI_INSTRUCTION_1_LINE;
+	xCommand.Instruction = CMD_READ_STATUS;
+	xCommand.DataMode = QSPI_DATA_1_LINE;
+
+	memset(&xPolling, 0, sizeof(xPolling));
+	xPolling.Match = 0;
+	xPolling.Mask = STATUS_WIP;
+	xPolling.MatchMode = QSPI_MATCH_MODE_AND;
+	xPolling.StatusBytesSize = 1;
+	xPolling.Interval = 16;
+	xPolling.AutomaticStop = QSPI_AUTOMATIC_STOP_ENABLE;
+
+	return HAL_QSPI_AutoPolling(&QspiHandle, &xCommand, &xPolling, QSPI_TIMEOUT);
+}
+
+
+static HAL_StatusTypeDef prvEnableQuad(void)
+{
+	uint8_t ucStatus;
+
+	if( (prvCommand(ASSET_FLASH_QE_READ_CMD, QSPI_ADDRESS_NONE, 0, 1) != HAL_OK) ||
+		(HAL_QSPI_Receive(&QspiHandle, &ucStatus, QSPI_TIMEOUT) != HAL_OK) )
+	{
+		return HAL_ERROR;
+	}
+
+	if((ucStatus & ASSET_FLASH_QE_BIT) != 0)
+	{
+		return HAL_OK;
+	}
+
+	ucStatus |= ASSET_FLASH_QE_BIT;
+	if( (prvWriteEnable() != HAL_OK) || (prvCommand(ASSET_FLASH_QE_WRITE_CMD, QSPI_ADDRESS_NONE, 0, 1) != HAL_OK) ||
+		(HAL_QSPI_Transmit(&QspiHandle, &ucStatus, QSPI_TIMEOUT) != HAL_OK) )
+	{
+		return HAL_ERROR;
+	}
+
+	return prvWaitReady();
+}
+
+
+//Memory-mapped mode: quad I/O read, the mode byte 0xFF keeps the flash out of its continuous read mode
+static HAL_StatusTypeDef prvMap(void)
+{
+	QSPI_CommandTypeDef xCommand;
+	QSPI_MemoryMappedTypeDef xMapped;
+
+	memset(&xCommand, 0, sizeof(xCommand));
+	xCommand.InstructionMode = QSPI_INSTRUCTION_1_LINE;
+	xCommand.Instruction = CMD_QUAD_READ;
+	xCommand.AddressMode = QSPI_ADDRESS_4_LINES;
+	xCommand.AddressSize = QSPI_ADDRESS_24_BITS;
+	xCommand.AlternateByteMode = QSPI_ALTERNATE_BYTES_4_LINES;
+	xCommand.AlternateBytesSize = QSPI_ALTERNATE_BYTES_8_BITS;
+	xCommand.AlternateBytes = 0xFF;
+	xCommand.DummyCycles = ASSET_FLASH_DUMMY_CYCLES;
+	xCommand.DataMode = QSPI_DATA_4_LINES;
+	xCommand.DdrMode = QSPI_DDR_MODE_DISABLE;
+	xCommand.SIOOMode = QSPI_SIOO_INST_EVERY_CMD;
+
+	memset(&xMapped, 0, sizeof(xMapped));
+	xMapped.TimeOutActivation = QSPI_TIMEOUT_COUNTER_ENABLE;
+	xMapped.TimeOutPeriod = MAPPED_CS_TIMEOUT;
+
+	return HAL_QSPI_MemoryMapped(&QspiHandle, &xCommand, &xMapped);
+}
+
+
+static void prvCheckContainer(void)
+{
+	const AssetHeader_t *pxMapped = (const AssetHeader_t *) (ASSET_FLASH_MAPPED_ADDRESS + ASSET_STORE_OFFSET);
+	uint32_t ulIndexSize;
+	uint32_t ulCrc;
+
+	pxHeader = NULL;
+	pxIndex = NULL;
+
+	if( (pxMapped->ulMagic != ASSET_MAGIC) || (pxMapped->usVersion != ASSET_VERSION) ||
+		((ASSET_STORE_OFFSET + pxMapped->ulSize) > (1UL << ASSET_FLASH_SIZE_BITS)) )
+	{
+		return;
+	}
+
+	ulIndexSize = pxMapped->usCount * sizeof(AssetEntry_t);
+	if((sizeof(AssetHeader_t) + ulIndexSize) > pxMapped->ulSize)
+	{
+		return;
+	}
+
+	ulCrc = ulCrc32Software(0, (const uint8_t *) pxMapped, offsetof(AssetHeader_t, ulCrc));
+	ulCrc = ulCrc32Software(ulCrc, (const uint8_t *) (pxMapped + 1), ulIndexSize);
+	if(ulCrc == pxMapped->ulCrc)
+	{
+		pxIndex = (const AssetEntry_t *) (pxMapped + 1);
+		pxHeader = pxMapped;
+	}
+}
+
+
+//Binary search: the index is sorted by name
+static const AssetEntry_t *prvFindEntry(const char *pcName)
+{
+	int32_t lLow = 0;
+	int32_t lHigh;
+	int32_t lMiddle;
+	int lOrder;
+
+	if(pxHeader == NULL)
+	{
+		return NULL;
+	}
+
+	lHigh = (int32_t) pxHeader->usCount - 1;
+	while(lLow <= lHigh)
+	{
+		lMiddle = (lLow + lHigh) / 2;
+		lOrder = strncmp(pcName, pxIndex[lMiddle].cName, ASSET_NAME_SIZE);
+		if(lOrder == 0)
+		{
+			//The entries out of the container are not given
+			return ((pxIndex[lMiddle].ulOffset + pxIndex[lMiddle].ulLength) <= pxHeader->ulSize) ? &pxIndex[lMiddle] : NULL;
+		}
+		else if(lOrder < 0)
+		{
+			lHigh = lMiddle - 1;
+		}
+		else
+		{
+			lLow = lMiddle + 1;
+		}
+	}
+
+	return NULL;
+}
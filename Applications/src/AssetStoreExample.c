@@ -0,0 +1,251 @@
+/*
+ * AssetStoreExample.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * This application shows the asset store in the external QSPI flash (AssetStore.c).
+ *
+ * At the start, if the flash has no valid container, the Assets task writes the one of AssetImage.h
+ * (packed by Tools/asset_pack.py from Tools/assets). Then it checks the CRC-32 of each asset and prints the
+ * menu and help texts from the mapped flash, without a copy in RAM.
+ * Every 2 seconds, it reads the sine table in place (a Q15 lookup for each of its 256 entries) and prints
+ * the cycles of the loop, with the table in the QSPI flash and with the same table in the internal flash
+ * (the copy of AssetImage.h), to compare the two memories.
+ *
+ * AssetStore.c and Crc32.c have to be included in the build with this file, and HAL_QSPI_MODULE_ENABLED in
+ * stm32wbxx_hal_conf.h.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stm32wbxx.h"
+#include "stm32wbxx_nucleo.h"
+#include "stdio.h"
+#include "string.h"
+#include "AssetStore.h"
+#include "AssetImage.h"
+
+#define REPORT_PERIOD_MS		2000
+#define SINE_ENTRIES			256
+
+//Task handles and functions
+TaskHandle_t xAssetsTask = NULL;
+void vAssetsTaskFunction(void *params);
+
+//UART Handle and Init types
+UART_HandleTypeDef Uart1;
+UART_InitTypeDef Uart1Init;
+GPIO_InitTypeDef GpioUARTpins;
+
+//Private helper functions and variables
+static void prvSetupUART(void);
+static BaseType_t prvOpenStore(void);
+static uint32_t prvSineLoop(const int16_t *psTable, int32_t *plSum);
+void printmsg(char *msg);
+char UsrMsg[250];
+
+
+int main()
+{
+	// Enable the DWT Cycle Count Register (SEGGER Settings)
+	DWT->CTRL |= (1 << 0);
+
+	// Private function called to setup the Hardware
+	prvSetupUART();
+
+	//Start Recording for SEGGER SystemView
+	SEGGER_SYSVIEW_Conf();
+	SEGGER_SYSVIEW_Start();
+
+	sprintf(UsrMsg,"Example of the asset store in the QSPI flash \r\n");
+	printmsg(UsrMsg);
+
+	if(xAssetStoreInit() == pdPASS)
+	{
+		//Create the task
+		xTaskCreate(vAssetsTaskFunction, "Assets-Task", 384, NULL, 2, &xAssetsTask);
+
+		//Schedule the tasks
+		vTaskStartScheduler();
+	}
+	else
+	{
+		sprintf(UsrMsg, "QSPI flash initialization failed... :( \r\n");
+		printmsg(UsrMsg);
+	}
+
+	/*
+	 * If scheduler can start the tasks and run them, the program will never reach here.
+	 * If the program comes to the below line, that means there was a problem while creating or scheduling the tasks
+	 */
+	for(;;);
+}
+
+
+void vAssetsTaskFunction(void *params)
+{
+	TickType_t xLastWakeTime;
+	const int16_t *psSine;
+	const int16_t *psInternalSine;
+	const char *pcText;
+	uint32_t ulLength;
+	uint32_t ulQspiCycles;
+	uint32_t ulInternalCycles;
+	int32_t lQspiSum;
+	int32_t lInternalSum;
+
+	if(prvOpenStore() != pdPASS)
+	{
+		vTaskDelete(NULL);
+	}
+
+	//Texts printed from the mapped flash
+	pcText = pcAssetText("help");
+	if(pcText != NULL)
+	{
+		printmsg((char *) pcText);
+	}
+	pcText = pcAssetText("menu");
+	if(pcText != NULL)
+	{
+		printmsg((char *) pcText);
+	}
+
+	psSine = pvAssetFind("sine_q15", &ulLength);
+	if( (psSine == NULL) || (ulLength != (SINE_ENTRIES * sizeof(int16_t))) )
+	{
+		sprintf(UsrMsg, "No sine table in the container \r\n");
+		printmsg(UsrMsg);
+		vTaskDelete(NULL);
+	}
+
+	//Same offset in the image of AssetImage.h, in the internal flash
+	psInternalSine = (const int16_t *) &ucAssetImage[(uint32_t) psSine - (ASSET_FLASH_MAPPED_ADDRESS + ASSET_STORE_OFFSET)];
+
+	xLastWakeTime = xTaskGetTickCount();
+	while(1)
+	{
+		vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(REPORT_PERIOD_MS));
+
+		ulQspiCycles = prvSineLoop(psSine, &lQspiSum);
+		ulInternalCycles = prvSineLoop(psInternalSine, &lInternalSum);
+
+		sprintf(UsrMsg, "Sine lookups: QSPI flash %lu cycles, internal flash %lu cycles (%d entries, sums %ld / %ld) \r\n",
+				ulQspiCycles, ulInternalCycles, SINE_ENTRIES, lQspiSum, lInternalSum);
+		printmsg(UsrMsg);
+	}
+}
+
+
+//Writes the container of AssetImage.h if the flash has none, then checks all the assets
+static BaseType_t prvOpenStore(void)
+{
+	uint32_t ulCount;
+	uint32_t ulId = ulAssetStoreJedecId();
+	const char *pcNames[] = { "help", "menu", "sine_q15" };
+	uint32_t i;
+
+	sprintf(UsrMsg, "Flash JEDEC ID %02lX %02lX %02lX, %lu assets \r\n", (ulId >> 16) & 0xFF, (ulId >> 8) & 0xFF, ulId & 0xFF, ulAssetCount());
+	printmsg(UsrMsg);
+
+	if(ulAssetCount() == 0)
+	{
+		sprintf(UsrMsg, "No container: writing the one of AssetImage.h (%d bytes) \r\n", ASSET_IMAGE_SIZE);
+		printmsg(UsrMsg);
+		if(xAssetStoreProgram(ucAssetImage, ASSET_IMAGE_SIZE) != pdPASS)
+		{
+			sprintf(UsrMsg, "Programming of the container failed... :( \r\n");
+			printmsg(UsrMsg);
+			return pdFAIL;
+		}
+	}
+
+	ulCount = ulAssetCount();
+	for(i = 0; i < (sizeof(pcNames) / sizeof(pcNames[0])); i++)
+	{
+		sprintf(UsrMsg, "%s: %s \r\n", pcNames[i], (xAssetVerify(pcNames[i]) == pdPASS) ? "CRC OK" : "missing or wrong CRC");
+		printmsg(UsrMsg);
+	}
+
+	return (ulCount != 0) ? pdPASS : pdFAIL;
+}
+
+
+//One lookup per entry of the table, the cycles of the loop. The sum is printed so the loop is not removed.
+static uint32_t prvSineLoop(const int16_t *psTable, int32_t *plSum)
+{
+	uint32_t ulStart;
+	int32_t lSum = 0;
+	uint32_t i;
+
+	ulStart = DWT->CYCCNT;
+	for(i = 0; i < SINE_ENTRIES; i++)
+	{
+		lSum += psTable[(i * 7) % SINE_ENTRIES];
+	}
+	ulStart = DWT->CYCCNT - ulStart;
+
+	*plSum = lSum;
+	return ulStart;
+}
+
+
+static void prvSetupUART(void)
+{
+	//1. Enable the UART1 and GPIOB Peripheral Clocks
+	__HAL_RCC_USART1_CLK_ENABLE();
+	__HAL_RCC_GPIOB_CLK_ENABLE();
+
+	//In UART connection with Virtual COM-port, PB6->TX and PB7->RX
+	//2. Alternate Functionality Configuration to make Port B pins work as UART pins
+
+	//Zeroing each and every member element of the structure.
+	memset(&GpioUARTpins, 0, sizeof(GpioUARTpins));
+	GpioUARTpins.Pin = GPIO_PIN_6 | GPIO_PIN_7;
+	GpioUARTpins.Mode = GPIO_MODE_AF_PP;
+	GpioUARTpins.Alternate = GPIO_AF7_USART1;
+	GpioUARTpins.Pull = GPIO_PULLUP;
+
+	HAL_GPIO_Init(GPIOB, &GpioUARTpins);
+
+	//3. Configure and initialize UART parameters
+
+	//Zeroing each and every member element of the structure.
+	memset(&Uart1Init, 0, sizeof(Uart1Init));
+	memset(&Uart1, 0, sizeof(Uart1));
+
+	//UART Initialization
+	Uart1Init.BaudRate = 115200;
+	Uart1Init.WordLength = UART_WORDLENGTH_8B;
+	Uart1Init.HwFlowCtl = UART_HWCONTROL_NONE;
+	Uart1Init.Mode = UART_MODE_TX_RX;
+	Uart1Init.Parity = UART_PARITY_NONE;
+	Uart1Init.StopBits = UART_STOPBITS_1;
+
+	Uart1.Init = Uart1Init;
+	Uart1.Instance = USART1;
+
+	//4. Initialize the UART peripheral
+	uint16_t UARTSetUpResult = HAL_UART_Init(&Uart1);
+
+	if(UARTSetUpResult == HAL_ERROR)
+	{
+		//printf("USART Initialization was not successful \n");
+	}
+
+}
+
+void printmsg(char *msg)
+{
+	HAL_UART_Transmit(&Uart1, (uint8_t *)msg, strlen(msg), 1);
+}
+
+//Implement the Idle Hook function
+void vApplicationIdleHook()
+{
+	//Send the CPU to normal sleep mode
+	__WFI();
+}
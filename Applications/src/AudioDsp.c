@@ -0,0 +1,158 @@
+/*
+ * AudioDsp.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * Instructions used on a frame word (two signed half words):
+ *   gain:   SMUAD with a word holding the gain in one half word (0 in the other) multiplies the sample of
+ *           that channel only, SSAT saturates each product, PKHBT packs both results back in one word
+ *   biquad: PKHBT and PKHTB pair the current and previous samples of one channel, so SMLAD computes two
+ *           products and adds them in one instruction: b0 x[n] + b1 x[n-1], then b2 x[n-2] - a1 y[n-1],
+ *           and the one of -a2 y[n-2] with -a2 in the half word of the channel
+ *   level:  QSUB16 negates both samples (saturated), SSUB16 and SEL keep the larger of each pair (absolute
+ *           value, then peak); SMUAD of the frame with one of its half words squares that sample (RMS)
+ */
+
+#include "FreeRTOS.h"
+#include "stm32wbxx.h"
+#include "AudioDsp.h"
+
+//Private helper functions
+static uint32_t prvSquareRoot(uint32_t ulValue);
+
+
+void vAudioGain(const uint32_t *pulInput, uint32_t *pulOutput, size_t xFrames, int16_t sLeftGain, int16_t sRightGain)
+{
+	uint32_t ulLeftGain = (uint16_t) sLeftGain;
+	uint32_t ulRightGain = (uint32_t) sRightGain << 16;
+	uint32_t ulFrame;
+	int32_t lLeft, lRight;
+
+	while(xFrames-- > 0)
+	{
+		ulFrame = *pulInput++;
+		lLeft = __SSAT((int32_t) __SMUAD(ulFrame, ulLeftGain) >> 15, 16);
+		lRight = __SSAT((int32_t) __SMUAD(ulFrame, ulRightGain) >> 15, 16);
+		*pulOutput++ = __PKHBT((uint32_t) lLeft, (uint32_t) lRight, 16);
+	}
+}
+
+
+void vAudioBiquadInit(AudioBiquad_t *pxBiquad, int16_t sB0, int16_t sB1, int16_t sB2, int16_t sA1, int16_t sA2)
+{
+	pxBiquad->ulB0B1 = __PKHBT((uint16_t) sB0, (uint32_t) sB1, 16);
+	pxBiquad->ulB2A1 = __PKHBT((uint16_t) sB2, (uint32_t) -sA1, 16);
+	pxBiquad->ulA2 = (uint16_t) -sA2;
+	pxBiquad->ulX1 = 0;
+	pxBiquad->ulX2 = 0;
+	pxBiquad->ulY1 = 0;
+	pxBiquad->ulY2 = 0;
+}
+
+
+void vAudioBiquad(AudioBiquad_t *pxBiquad, const uint32_t *pulInput, uint32_t *pulOutput, size_t xFrames)
+{
+	uint32_t ulB0B1 = pxBiquad->ulB0B1;
+	uint32_t ulB2A1 = pxBiquad->ulB2A1;
+	uint32_t ulLeftA2 = pxBiquad->ulA2;
+	uint32_t ulRightA2 = pxBiquad->ulA2 << 16;
+	uint32_t ulX1 = pxBiquad->ulX1, ulX2 = pxBiquad->ulX2;
+	uint32_t ulY1 = pxBiquad->ulY1, ulY2 = pxBiquad->ulY2;
+	uint32_t ulFrame, ulOutput;
+	int32_t lLeft, lRight;
+
+	while(xFrames-- > 0)
+	{
+		ulFrame = *pulInput++;
+
+		//Left: x[n] | x[n-1], x[n-2] | y[n-1] (low half words), then y[n-2]
+		lLeft = (int32_t) __SMUAD(__PKHBT(ulFrame, ulX1, 16), ulB0B1);
+		lLeft = (int32_t) __SMLAD(__PKHBT(ulX2, ulY1, 16), ulB2A1, (uint32_t) lLeft);
+		lLeft = (int32_t) __SMLAD(ulY2, ulLeftA2, (uint32_t) lLeft);
+
+		//Right: the same with the high half words
+		lRight = (int32_t) __SMUAD(__PKHTB(ulX1, ulFrame, 16), ulB0B1);
+		lRight = (int32_t) __SMLAD(__PKHTB(ulY1, ulX2, 16), ulB2A1, (uint32_t) lRight);
+		lRight = (int32_t) __SMLAD(ulY2, ulRightA2, (uint32_t) lRight);
+
+		ulOutput = __PKHBT((uint32_t) __SSAT(lLeft >> 14, 16), (uint32_t) __SSAT(lRight >> 14, 16), 16);
+		*pulOutput++ = ulOutput;
+
+		ulX2 = ulX1;
+		ulX1 = ulFrame;
+		ulY2 = ulY1;
+		ulY1 = ulOutput;
+	}
+
+	pxBiquad->ulX1 = ulX1;
+	pxBiquad->ulX2 = ulX2;
+	pxBiquad->ulY1 = ulY1;
+	pxBiquad->ulY2 = ulY2;
+}
+
+
+void vAudioLevel(const uint32_t *pulFrames, size_t xFrames, AudioLevel_t *pxLevel)
+{
+	uint64_t ullSumLeft = 0, ullSumRight = 0;
+	uint32_t ulPeak = 0;
+	uint32_t ulFrame, ulNegative, ulAbsolute;
+	size_t xCount = xFrames;
+
+	if(xFrames == 0)
+	{
+		pxLevel->usRmsLeft = pxLevel->usRmsRight = pxLevel->usPeakLeft = pxLevel->usPeakRight = 0;
+		return;
+	}
+
+	while(xCount-- > 0)
+	{
+		ulFrame = *pulFrames++;
+
+		//Each SEL uses the flags of the SSUB16 just before it
+		ulNegative = __QSUB16(0, ulFrame);
+		__SSUB16(ulFrame, ulNegative);
+		ulAbsolute = __SEL(ulFrame, ulNegative);
+		__SSUB16(ulAbsolute, ulPeak);
+		ulPeak = __SEL(ulAbsolute, ulPeak);
+
+		ullSumLeft += __SMUAD(ulFrame, ulFrame & 0x0000FFFFUL);
+		ullSumRight += __SMUAD(ulFrame, ulFrame & 0xFFFF0000UL);
+	}
+
+	pxLevel->usRmsLeft = (uint16_t) prvSquareRoot((uint32_t) (ullSumLeft / xFrames));
+	pxLevel->usRmsRight = (uint16_t) prvSquareRoot((uint32_t) (ullSumRight / xFrames));
+	pxLevel->usPeakLeft = (uint16_t) (ulPeak & 0xFFFF);
+	pxLevel->usPeakRight = (uint16_t) (ulPeak >> 16);
+}
+
+
+//Integer square root (bit by bit)
+static uint32_t prvSquareRoot(uint32_t ulValue)
+{
+	uint32_t ulRoot = 0;
+	uint32_t ulBit = 1UL << 30;
+
+	while(ulBit > ulValue)
+	{
+		ulBit >>= 2;
+	}
+
+	while(ulBit != 0)
+	{
+		if(ulValue >= ulRoot + ulBit)
+		{
+			ulValue -= ulRoot + ulBit;
+			ulRoot = (ulRoot >> 1) + ulBit;
+		}
+		else
+		{
+			ulRoot >>= 1;
+		}
+		ulBit >>= 2;
+	}
+
+	return ulRoot;
+}
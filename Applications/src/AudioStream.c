@@ -0,0 +1,356 @@
+/*
+ * AudioStream.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * Block A (master transmitter) generates MCLK, SCK and FS; block B (synchronous receiver) uses them, so the
+ * two DMA channels run at the same rate and the halves of both buffers go together:
+ *   capture half transfer:  capture half 0 is full -> block of half 0 (input half 0, output half 0)
+ *   capture complete:       capture half 1 is full -> block of half 1
+ *   playback half transfer: the playback DMA starts to read half 1 (it must have been written)
+ *   playback complete:      the playback DMA starts to read half 0
+ * The playback DMA is a few frames ahead of the capture one (the SAI FIFO is filled first), so the output
+ * half of a block is read again one block period after its capture interrupt, less these frames.
+ *
+ * The DMA transfers half words: one per slot (16 bit data), two per frame. Block A uses DMA1 channel 6 and
+ * block B DMA1 channel 7: channel 1 is the ADC one (AdcSampler.c), channels 2 to 5 the SPI ones (SpiBus.c).
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stm32wbxx.h"
+#include "stm32wbxx_hal.h"
+#include "stm32wbxx_ll_rcc.h"
+#include "string.h"
+#include "AudioStream.h"
+
+#define BUFFER_FRAMES			(2 * AUDIO_STREAM_BLOCK_FRAMES)
+
+static SAI_HandleTypeDef SaiTxHandle;
+static SAI_HandleTypeDef SaiRxHandle;
+static DMA_HandleTypeDef SaiTxDmaHandle;
+static DMA_HandleTypeDef SaiRxDmaHandle;
+
+//Two halves of frames for each direction
+static uint32_t ulCapture[BUFFER_FRAMES];
+static uint32_t ulPlayback[BUFFER_FRAMES];
+
+//Changed by the interrupts
+static TaskHandle_t xProcessingTask = NULL;
+static volatile uint32_t ulBlockCount = 0;
+static volatile uint8_t ucLastHalf = 0;
+static volatile uint32_t ulBlockStartCycles = 0;
+static volatile uint8_t ucOutputReady[2];
+
+//Changed by vAudioStreamBlockDone() and read by the interrupts
+static volatile uint32_t ulDoneCount = 0;
+
+static AudioStreamStats_t xStats;
+
+//Private helper functions
+static BaseType_t prvSetupClock(void);
+static void prvSetupPins(void);
+static void prvCaptureDone(uint8_t ucHalf);
+static void prvPlaybackHalf(uint8_t ucHalf);
+
+
+BaseType_t xAudioStreamInit(void)
+{
+	//1. SAI clock and pins
+	if(prvSetupClock() != pdPASS)
+	{
+		return pdFAIL;
+	}
+	prvSetupPins();
+
+	//2. Block A: master transmitter, it drives MCLK, SCK and FS
+	memset(&SaiTxHandle, 0, sizeof(SaiTxHandle));
+	SaiTxHandle.Instance = SAI1_Block_A;
+	SaiTxHandle.Init.AudioMode = SAI_MODEMASTER_TX;
+	SaiTxHandle.Init.Synchro = SAI_ASYNCHRONOUS;
+	SaiTxHandle.Init.SynchroExt = SAI_SYNCEXT_DISABLE;
+	SaiTxHandle.Init.OutputDrive = SAI_OUTPUTDRIVE_ENABLE;
+	SaiTxHandle.Init.NoDivider = SAI_MASTERDIVIDER_ENABLE;
+	SaiTxHandle.Init.FIFOThreshold = SAI_FIFOTHRESHOLD_1QF;
+	SaiTxHandle.Init.AudioFrequency = AUDIO_STREAM_RATE;
+	SaiTxHandle.Init.MonoStereoMode = SAI_STEREOMODE;
+	SaiTxHandle.Init.CompandingMode = SAI_NOCOMPANDING;
+	SaiTxHandle.Init.TriState = SAI_OUTPUT_NOTRELEASED;
+	SaiTxHandle.Init.MckOutput = SAI_MCK_OUTPUT_ENABLE;
+	SaiTxHandle.Init.MckOverSampling = SAI_MCK_OVERSAMPLING_DISABLE;
+	SaiTxHandle.Init.PdmInit.Activation = DISABLE;
+
+	//3. Block B: receiver, synchronous with block A
+	SaiRxHandle = SaiTxHandle;
+	SaiRxHandle.Instance = SAI1_Block_B;
+	SaiRxHandle.Init.AudioMode = SAI_MODESLAVE_RX;
+	SaiRxHandle.Init.Synchro = SAI_SYNCHRONOUS;
+	SaiRxHandle.Init.OutputDrive = SAI_OUTPUTDRIVE_DISABLE;
+	SaiRxHandle.Init.MckOutput = SAI_MCK_OUTPUT_DISABLE;
+
+	if( (HAL_SAI_InitProtocol(&SaiTxHandle, SAI_I2S_STANDARD, SAI_PROTOCOL_DATASIZE_16BIT, 2) != HAL_OK) ||
+		(HAL_SAI_InitProtocol(&SaiRxHandle, SAI_I2S_STANDARD, SAI_PROTOCOL_DATASIZE_16BIT, 2) != HAL_OK) )
+	{
+		return pdFAIL;
+	}
+
+	//4. DMA1 channel 6: playback buffer to block A; channel 7: block B to the capture buffer. Half words, circular.
+	__HAL_RCC_DMAMUX1_CLK_ENABLE();
+	__HAL_RCC_DMA1_CLK_ENABLE();
+
+	SaiTxDmaHandle.Instance = DMA1_Channel6;
+	SaiTxDmaHandle.Init.Request = DMA_REQUEST_SAI1_A;
+	SaiTxDmaHandle.Init.Direction = DMA_MEMORY_TO_PERIPH;
+	SaiTxDmaHandle.Init.PeriphInc = DMA_PINC_DISABLE;
+	SaiTxDmaHandle.Init.MemInc = DMA_MINC_ENABLE;
+	SaiTxDmaHandle.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+	SaiTxDmaHandle.Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+	SaiTxDmaHandle.Init.Mode = DMA_CIRCULAR;
+	SaiTxDmaHandle.Init.Priority = DMA_PRIORITY_VERY_HIGH;
+
+	SaiRxDmaHandle.Instance = DMA1_Channel7;
+	SaiRxDmaHandle.Init = SaiTxDmaHandle.Init;
+	SaiRxDmaHandle.Init.Request = DMA_REQUEST_SAI1_B;
+	SaiRxDmaHandle.Init.Direction = DMA_PERIPH_TO_MEMORY;
+
+	if( (HAL_DMA_Init(&SaiTxDmaHandle) != HAL_OK) || (HAL_DMA_Init(&SaiRxDmaHandle) != HAL_OK) )
+	{
+		return pdFAIL;
+	}
+
+	__HAL_LINKDMA(&SaiTxHandle, hdmatx, SaiTxDmaHandle);
+	__HAL_LINKDMA(&SaiRxHandle, hdmarx, SaiRxDmaHandle);
+
+	NVIC_SetPriority(DMA1_Channel6_IRQn, AUDIO_STREAM_IRQ_PRIORITY); //Priority should be less than or equal to configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY
+	NVIC_SetPriority(DMA1_Channel7_IRQn, AUDIO_STREAM_IRQ_PRIORITY);
+	NVIC_SetPriority(SAI1_IRQn, AUDIO_STREAM_IRQ_PRIORITY);
+	NVIC_EnableIRQ(DMA1_Channel6_IRQn);
+	NVIC_EnableIRQ(DMA1_Channel7_IRQn);
+	NVIC_EnableIRQ(SAI1_IRQn);
+
+	return pdPASS;
+}
+
+BaseType_t xAudioStreamStart(void)
+{
+	xProcessingTask = xTaskGetCurrentTaskHandle();
+	ulBlockCount = 0;
+	ulDoneCount = 0;
+	memset(&xStats, 0, sizeof(xStats));
+	xStats.ulBudgetCycles = (uint32_t) (((uint64_t) SystemCoreClock * AUDIO_STREAM_BLOCK_FRAMES) / AUDIO_STREAM_RATE);
+
+	//Silence in both halves until the processing task writes them. The DMA starts with half 0.
+	memset(ulPlayback, 0, sizeof(ulPlayback));
+	ucOutputReady[0] = 0;
+	ucOutputReady[1] = 1;
+
+	//Notifications of a previous run
+	ulTaskNotifyValueClearIndexed(NULL, AUDIO_STREAM_NOTIFY_INDEX, 0xFFFFFFFF);
+
+	//The receiver first: it waits for the clocks of the transmitter
+	if( (HAL_SAI_Receive_DMA(&SaiRxHandle, (uint8_t *) ulCapture, 2 * BUFFER_FRAMES) != HAL_OK) ||
+		(HAL_SAI_Transmit_DMA(&SaiTxHandle, (uint8_t *) ulPlayback, 2 * BUFFER_FRAMES) != HAL_OK) )
+	{
+		vAudioStreamStop();
+		return pdFAIL;
+	}
+
+	return pdPASS;
+}
+
+void vAudioStreamStop(void)
+{
+	HAL_SAI_DMAStop(&SaiTxHandle);
+	HAL_SAI_DMAStop(&SaiRxHandle);
+}
+
+BaseType_t xAudioStreamWaitBlock(AudioBlock_t *pxBlock, TickType_t xTicksToWait)
+{
+	uint32_t ulSequence;
+	uint8_t ucHalf;
+
+	if(ulTaskNotifyTakeIndexed(AUDIO_STREAM_NOTIFY_INDEX, pdTRUE, xTicksToWait) == 0)
+	{
+		return pdFAIL;
+	}
+
+	//The count, the half and the start are changed together by the interrupt
+	taskENTER_CRITICAL();
+	ulSequence = ulBlockCount;
+	ucHalf = ucLastHalf;
+	pxBlock->ulStartCycles = ulBlockStartCycles;
+	taskEXIT_CRITICAL();
+
+	pxBlock->pulInput = &ulCapture[ucHalf * AUDIO_STREAM_BLOCK_FRAMES];
+	pxBlock->pulOutput = &ulPlayback[ucHalf * AUDIO_STREAM_BLOCK_FRAMES];
+	pxBlock->xFrames = AUDIO_STREAM_BLOCK_FRAMES;
+	pxBlock->ulSequence = ulSequence;
+	pxBlock->ucHalf = ucHalf;
+
+	return pdPASS;
+}
+
+void vAudioStreamBlockDone(const AudioBlock_t *pxBlock)
+{
+	uint32_t ulCycles = DWT->CYCCNT - pxBlock->ulStartCycles;
+
+	taskENTER_CRITICAL();
+	ucOutputReady[pxBlock->ucHalf] = 1;
+	ulDoneCount = pxBlock->ulSequence;
+	xStats.ulBlocks++;
+	xStats.ulLastCycles = ulCycles;
+	if(ulCycles > xStats.ulWorstCycles)
+	{
+		xStats.ulWorstCycles = ulCycles;
+	}
+	taskEXIT_CRITICAL();
+}
+
+void vAudioStreamGetStats(AudioStreamStats_t *pxStats)
+{
+	taskENTER_CRITICAL();
+	*pxStats = xStats;
+	taskEXIT_CRITICAL();
+}
+
+void vAudioStreamResetWorst(void)
+{
+	taskENTER_CRITICAL();
+	xStats.ulWorstCycles = 0;
+	taskEXIT_CRITICAL();
+}
+
+
+//PLLSAI1 P output as SAI1 clock, from HSI16 / 2
+static BaseType_t prvSetupClock(void)
+{
+	//PLLM and the PLL source can only be changed while the main PLL is off
+	if(LL_RCC_PLL_IsReady() != 0)
+	{
+		return pdFAIL;
+	}
+
+	LL_RCC_HSI_Enable();
+	while(LL_RCC_HSI_IsReady() == 0);
+
+	LL_RCC_PLLSAI1_Disable();
+	while(LL_RCC_PLLSAI1_IsReady() != 0);
+
+	LL_RCC_PLLSAI1_ConfigDomain_SAI(LL_RCC_PLLSOURCE_HSI, LL_RCC_PLLM_DIV_2, AUDIO_STREAM_PLLSAI1_N, AUDIO_STREAM_PLLSAI1_P);
+	LL_RCC_PLLSAI1_EnableDomain_SAI();
+	LL_RCC_PLLSAI1_Enable();
+	while(LL_RCC_PLLSAI1_IsReady() == 0);
+
+	LL_RCC_SetSAIClockSource(LL_RCC_SAI1_CLKSOURCE_PLLSAI1);
+
+	return pdPASS;
+}
+
+static void prvSetupPins(void)
+{
+	GPIO_InitTypeDef GpioSaiPins;
+
+	__HAL_RCC_GPIOA_CLK_ENABLE();
+	__HAL_RCC_GPIOB_CLK_ENABLE();
+
+	memset(&GpioSaiPins, 0, sizeof(GpioSaiPins));
+	GpioSaiPins.Mode = GPIO_MODE_AF_PP;
+	GpioSaiPins.Pull = GPIO_NOPULL;
+	GpioSaiPins.Speed = GPIO_SPEED_FREQ_HIGH;
+	GpioSaiPins.Alternate = GPIO_AF13_SAI1;
+
+	GpioSaiPins.Pin = GPIO_PIN_3 | GPIO_PIN_8 | GPIO_PIN_9 | GPIO_PIN_10;
+	HAL_GPIO_Init(GPIOA, &GpioSaiPins);
+
+	GpioSaiPins.Pin = GPIO_PIN_5;
+	HAL_GPIO_Init(GPIOB, &GpioSaiPins);
+}
+
+
+void DMA1_Channel6_IRQHandler(void)
+{
+	HAL_DMA_IRQHandler(&SaiTxDmaHandle);
+}
+
+void DMA1_Channel7_IRQHandler(void)
+{
+	HAL_DMA_IRQHandler(&SaiRxDmaHandle);
+}
+
+//FIFO overrun (block B) and underrun (block A) flags
+void SAI1_IRQHandler(void)
+{
+	HAL_SAI_IRQHandler(&SaiTxHandle);
+	HAL_SAI_IRQHandler(&SaiRxHandle);
+}
+
+//Called by HAL_SAI_Init()
+void HAL_SAI_MspInit(SAI_HandleTypeDef *hsai)
+{
+	__HAL_RCC_SAI1_CLK_ENABLE();
+}
+
+//Called from the DMA interrupt when the first capture half is full
+void HAL_SAI_RxHalfCpltCallback(SAI_HandleTypeDef *hsai)
+{
+	prvCaptureDone(0);
+}
+
+//Called from the DMA interrupt when the second capture half is full
+void HAL_SAI_RxCpltCallback(SAI_HandleTypeDef *hsai)
+{
+	prvCaptureDone(1);
+}
+
+//Called from the DMA interrupt when the playback DMA has read the first half (it reads the second one)
+void HAL_SAI_TxHalfCpltCallback(SAI_HandleTypeDef *hsai)
+{
+	prvPlaybackHalf(1);
+}
+
+//Called from the DMA interrupt when the playback DMA has read the second half (it reads the first one)
+void HAL_SAI_TxCpltCallback(SAI_HandleTypeDef *hsai)
+{
+	prvPlaybackHalf(0);
+}
+
+void HAL_SAI_ErrorCallback(SAI_HandleTypeDef *hsai)
+{
+	if((hsai->ErrorCode & (HAL_SAI_ERROR_OVR | HAL_SAI_ERROR_UDR)) != 0)
+	{
+		xStats.ulFifoErrors++;
+		hsai->ErrorCode &= ~(HAL_SAI_ERROR_OVR | HAL_SAI_ERROR_UDR);
+	}
+}
+
+
+static void prvCaptureDone(uint8_t ucHalf)
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	//The DMA starts to write the other half again: the block of that half must be done
+	if(ulDoneCount != ulBlockCount)
+	{
+		xStats.ulOverruns++;
+	}
+
+	ulBlockStartCycles = DWT->CYCCNT;
+	ucLastHalf = ucHalf;
+	ulBlockCount++;
+	vTaskNotifyGiveIndexedFromISR(xProcessingTask, AUDIO_STREAM_NOTIFY_INDEX, &xHigherPriorityTaskWoken);
+
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+static void prvPlaybackHalf(uint8_t ucHalf)
+{
+	//Written since the DMA read it last, else it is played again
+	if(ucOutputReady[ucHalf] == 0)
+	{
+		xStats.ulUnderruns++;
+	}
+	ucOutputReady[ucHalf] = 0;
+}
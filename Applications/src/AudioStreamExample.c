@@ -0,0 +1,283 @@
+/*
+ * AudioStreamExample.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * This application streams 16 bit stereo audio at 48 kHz through SAI1 (AudioStream.c) and processes it
+ * block by block with the fixed-point DSP functions (AudioDsp.c).
+ *
+ * The Audio task (above the other tasks) is the processing task. For each captured block it:
+ *   - measures the level of the input (RMS and peak of each channel)
+ *   - writes the output: input * 0.5 (gain), low pass filtered at 4 kHz (biquad), plus a 1 kHz test tone
+ * The Report task prints every 2 seconds the blocks, the overruns and underruns, the processing time of a
+ * block (last and worst, from the capture interrupt) against the block period, and the input level.
+ *
+ * Without a codec, connect SD_A (PA10) to SD_B (PB5): the input is the output about two blocks earlier, so
+ * the level shows the tone and its filtered copies (the loop gain is below 0.5, the echo decays).
+ *
+ * The CPU runs at 32 MHz (MSI range 10), like AdcSamplerExample.c. The SAI clock comes from PLLSAI1.
+ * AudioStream.c and AudioDsp.c have to be included in the build with this file, and HAL_SAI_MODULE_ENABLED
+ * in stm32wbxx_hal_conf.h.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stm32wbxx.h"
+#include "stm32wbxx_nucleo.h"
+#include "stdio.h"
+#include "string.h"
+#include "AudioStream.h"
+#include "AudioDsp.h"
+
+#define REPORT_PERIOD_MS		2000
+#define OUTPUT_GAIN				16384				//0.5 in Q15
+#define TONE_PERIOD				48					//Frames of one period: 1 kHz at 48 kHz
+
+//Task handles and functions
+TaskHandle_t xAudioTask = NULL;
+TaskHandle_t xReportTask = NULL;
+void vAudioTaskFunction(void *params);
+void vReportTaskFunction(void *params);
+
+//UART Handle and Init types
+UART_HandleTypeDef Uart1;
+UART_InitTypeDef Uart1Init;
+GPIO_InitTypeDef GpioUARTpins;
+
+//1 kHz sine at -12 dBFS (8231)
+static const int16_t sTone[TONE_PERIOD] =
+{
+	0, 1074, 2130, 3150, 4115, 5011, 5820, 6530, 7128, 7604, 7951, 8161,
+	8231, 8161, 7951, 7604, 7128, 6530, 5820, 5011, 4115, 3150, 2130, 1074,
+	0, -1074, -2130, -3150, -4115, -5011, -5820, -6530, -7128, -7604, -7951, -8161,
+	-8231, -8161, -7951, -7604, -7128, -6530, -5820, -5011, -4116, -3150, -2130, -1074,
+};
+
+//Written by the Audio task, printed by the Report task
+static AudioLevel_t xInputLevel;
+static volatile uint32_t ulDspWorstCycles = 0;
+
+//Private helper functions and variables
+static void prvSetupClock(void);
+static void prvSetupUART(void);
+static uint32_t prvAddTone(uint32_t *pulFrames, size_t xFrames, uint32_t ulPhase);
+void printmsg(char *msg);
+char UsrMsg[250];
+
+
+int main()
+{
+	// Enable the DWT Cycle Count Register (SEGGER Settings)
+	DWT->CTRL |= (1 << 0);
+
+	// Private functions called to setup the Hardware. The clock first: the UART baud rate depends on it.
+	prvSetupClock();
+	prvSetupUART();
+
+	//Start Recording for SEGGER SystemView
+	SEGGER_SYSVIEW_Conf();
+	SEGGER_SYSVIEW_Start();
+
+	sprintf(UsrMsg,"Example of SAI audio streaming with double buffered DMA and fixed-point processing \r\n");
+	printmsg(UsrMsg);
+
+	if(xAudioStreamInit() == pdPASS)
+	{
+		//Create the tasks. The Audio task runs above everything else: it has one block period per block.
+		xTaskCreate(vAudioTaskFunction, "Audio-Task", 256, NULL, configMAX_PRIORITIES - 2, &xAudioTask);
+		xTaskCreate(vReportTaskFunction, "Report-Task", 384, NULL, 1, &xReportTask);
+
+		//Schedule the tasks
+		vTaskStartScheduler();
+	}
+	else
+	{
+		sprintf(UsrMsg, "SAI initialization failed... :( \r\n");
+		printmsg(UsrMsg);
+	}
+
+	/*
+	 * If scheduler can start the tasks and run them, the program will never reach here.
+	 * If the program comes to the below line, that means there was a problem while creating or scheduling the tasks
+	 */
+	for(;;);
+}
+
+
+void vAudioTaskFunction(void *params)
+{
+	AudioBlock_t xBlock;
+	AudioBiquad_t xLowPass;
+	AudioLevel_t xLevel;
+	uint32_t ulPhase = 0;
+	uint32_t ulStart, ulCycles;
+
+	//RBJ low pass: 4 kHz at 48 kHz, Q 0.707
+	vAudioBiquadInit(&xLowPass, AUDIO_Q14(0.04948996f), AUDIO_Q14(0.09897991f), AUDIO_Q14(0.04948996f),
+			AUDIO_Q14(-1.27963242f), AUDIO_Q14(0.47759225f));
+
+	if(xAudioStreamStart() != pdPASS)
+	{
+		printmsg("The audio stream could not start \r\n");
+		vTaskDelete(NULL);
+	}
+
+	while(1)
+	{
+		if(xAudioStreamWaitBlock(&xBlock, pdMS_TO_TICKS(100)) != pdPASS)
+		{
+			printmsg("No block from the SAI \r\n");
+			continue;
+		}
+
+		ulStart = DWT->CYCCNT;
+
+		vAudioLevel(xBlock.pulInput, xBlock.xFrames, &xLevel);
+		vAudioGain(xBlock.pulInput, xBlock.pulOutput, xBlock.xFrames, OUTPUT_GAIN, OUTPUT_GAIN);
+		vAudioBiquad(&xLowPass, xBlock.pulOutput, xBlock.pulOutput, xBlock.xFrames);
+		ulPhase = prvAddTone(xBlock.pulOutput, xBlock.xFrames, ulPhase);
+
+		ulCycles = DWT->CYCCNT - ulStart;
+		vAudioStreamBlockDone(&xBlock);
+
+		if(ulCycles > ulDspWorstCycles)
+		{
+			ulDspWorstCycles = ulCycles;
+		}
+		taskENTER_CRITICAL();
+		xInputLevel = xLevel;
+		taskEXIT_CRITICAL();
+	}
+}
+
+
+void vReportTaskFunction(void *params)
+{
+	AudioStreamStats_t xStats;
+	AudioLevel_t xLevel;
+	BaseType_t xFirst = pdTRUE;
+
+	while(1)
+	{
+		vTaskDelay(pdMS_TO_TICKS(REPORT_PERIOD_MS));
+
+		vAudioStreamGetStats(&xStats);
+		taskENTER_CRITICAL();
+		xLevel = xInputLevel;
+		taskEXIT_CRITICAL();
+
+		sprintf(UsrMsg, "Blocks %lu, overruns %lu, underruns %lu, FIFO errors %lu \r\n",
+				xStats.ulBlocks, xStats.ulOverruns, xStats.ulUnderruns, xStats.ulFifoErrors);
+		printmsg(UsrMsg);
+		sprintf(UsrMsg, "Block: last %lu, worst %lu (DSP %lu) of %lu cycles (worst %lu%%) \r\n",
+				xStats.ulLastCycles, xStats.ulWorstCycles, ulDspWorstCycles, xStats.ulBudgetCycles,
+				(xStats.ulWorstCycles * 100) / xStats.ulBudgetCycles);
+		printmsg(UsrMsg);
+		sprintf(UsrMsg, "Input: RMS %u / %u, peak %u / %u \r\n",
+				xLevel.usRmsLeft, xLevel.usRmsRight, xLevel.usPeakLeft, xLevel.usPeakRight);
+		printmsg(UsrMsg);
+
+		//The first blocks include the start of the stream
+		if(xFirst == pdTRUE)
+		{
+			vAudioStreamResetWorst();
+			xFirst = pdFALSE;
+		}
+	}
+}
+
+
+//Adds the tone to both channels (saturated), returns the phase for the next block
+static uint32_t prvAddTone(uint32_t *pulFrames, size_t xFrames, uint32_t ulPhase)
+{
+	uint32_t ulTone;
+
+	while(xFrames-- > 0)
+	{
+		ulTone = (uint16_t) sTone[ulPhase];
+		ulTone |= ulTone << 16;
+		*pulFrames = __QADD16(*pulFrames, ulTone);
+		pulFrames++;
+
+		if(++ulPhase == TONE_PERIOD)
+		{
+			ulPhase = 0;
+		}
+	}
+
+	return ulPhase;
+}
+
+
+static void prvSetupClock(void)
+{
+	//MSI 4 MHz -> 32 MHz, which needs 1 flash wait state
+	__HAL_FLASH_SET_LATENCY(FLASH_LATENCY_1);
+	while(__HAL_FLASH_GET_LATENCY() != FLASH_LATENCY_1);
+
+	__HAL_RCC_MSI_RANGE_CONFIG(RCC_MSIRANGE_10);
+	while(__HAL_RCC_GET_FLAG(RCC_FLAG_MSIRDY) == 0);
+
+	//SystemCoreClock is used by the kernel tick, SystemView, the UART baud rate and the cycle budget
+	SystemCoreClockUpdate();
+}
+
+static void prvSetupUART(void)
+{
+	//1. Enable the UART1 and GPIOB Peripheral Clocks
+	__HAL_RCC_USART1_CLK_ENABLE();
+	__HAL_RCC_GPIOB_CLK_ENABLE();
+
+	//In UART connection with Virtual COM-port, PB6->TX and PB7->RX
+	//2. Alternate Functionality Configuration to make Port B pins work as UART pins
+
+	//Zeroing each and every member element of the structure.
+	memset(&GpioUARTpins, 0, sizeof(GpioUARTpins));
+	GpioUARTpins.Pin = GPIO_PIN_6 | GPIO_PIN_7;
+	GpioUARTpins.Mode = GPIO_MODE_AF_PP;
+	GpioUARTpins.Alternate = GPIO_AF7_USART1;
+	GpioUARTpins.Pull = GPIO_PULLUP;
+
+	HAL_GPIO_Init(GPIOB, &GpioUARTpins);
+
+	//3. Configure and initialize UART parameters
+
+	//Zeroing each and every member element of the structure.
+	memset(&Uart1Init, 0, sizeof(Uart1Init));
+	memset(&Uart1, 0, sizeof(Uart1));
+
+	//UART Initialization
+	Uart1Init.BaudRate = 115200;
+	Uart1Init.WordLength = UART_WORDLENGTH_8B;
+	Uart1Init.HwFlowCtl = UART_HWCONTROL_NONE;
+	Uart1Init.Mode = UART_MODE_TX_RX;
+	Uart1Init.Parity = UART_PARITY_NONE;
+	Uart1Init.StopBits = UART_STOPBITS_1;
+
+	Uart1.Init = Uart1Init;
+	Uart1.Instance = USART1;
+
+	//4. Initialize the UART peripheral
+	uint16_t UARTSetUpResult = HAL_UART_Init(&Uart1);
+
+	if(UARTSetUpResult == HAL_ERROR)
+	{
+		//printf("USART Initialization was not successful \n");
+	}
+
+}
+
+void printmsg(char *msg)
+{
+	HAL_UART_Transmit(&Uart1, (uint8_t *)msg, strlen(msg), 1);
+}
+
+//Implement the Idle Hook function
+void vApplicationIdleHook()
+{
+	//Send the CPU to normal sleep mode
+	__WFI();
+}
@@ -18,7 +18,7 @@
 #include "string.h"
 #include "queue.h"
 #include "semphr.h"
-#include "stdlib.h"
+#include "Random.h"
 
 //Task handles and functions
 xTaskHandle xManagerTask = NULL;
@@ -57,6 +57,9 @@ int main()
 	sprintf(UsrMsg,"Example of Binary semaphore synchronization between 2 Tasks \r\n");
 	printmsg(UsrMsg);
 
+	//Random numbers of the tasks (Random.c has to be included in the build, and HAL_RNG_MODULE_ENABLED)
+	xRandomInit();
+
 	//Create Semaphore
 	vSemaphoreCreateBinary(xWorkSemaphore);
 
@@ -92,6 +95,10 @@ void vManagerTaskFunction (void *params)
 {
 	unsigned int ulWorkTaskID;
 	BaseType_t xSendStatus = pdFAIL;
+	RandomStream_t xStream;
+
+	vRandomStreamInit(&xStream);
+
 	/*
 	 * Semaphore is created in an 'empty' state. At first, we should give it using
 	 * xSemaphoreGive() API function before taking it.
@@ -101,7 +108,7 @@ void vManagerTaskFunction (void *params)
 	while(1)
 	{
 		//Get a working Task Id.
-		ulWorkTaskID = (unsigned int) (rand() & 0x1FF);
+		ulWorkTaskID = (unsigned int) (ulRandomNext(&xStream) & 0x1FF);
 
 		//Send the created WorkTaskID to Employee task using the queue
 		xSendStatus = xQueueSend(xWorkQueue, &ulWorkTaskID, portMAX_DELAY);
@@ -132,8 +139,8 @@ void vEmployeeTaskFunction (void *params)
 
 	while(1)
 	{
-		//Take the Semaphore
-		if(xSemaphoreTake(xWorkSemaphore, 0))
+		//Take the Semaphore. Block until the Manager gives it instead of polling it (busy loop).
+		if(xSemaphoreTake(xWorkSemaphore, portMAX_DELAY))
 		{
 
 			//Receive the TaskID from the Queue
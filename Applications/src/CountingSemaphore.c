@@ -19,7 +19,7 @@
 #include "string.h"
 #include "queue.h"
 #include "semphr.h"
-#include "stdlib.h"
+#include "Random.h"
 
 //Task handles and functions
 xTaskHandle xHandlerTask = NULL;
@@ -41,6 +41,8 @@ GPIO_InitTypeDef GpioUARTpins;
 static void prvSetupUART(void);
 void printmsg(char *msg);
 char UsrMsg[250];
+volatile uint32_t ulLostEvents = 0;	//Events dropped because the semaphore was full
+static RandomStream_t xInterruptStream;	//Random stream of the interrupt handler (only used there)
 
 int main()
 {
@@ -58,6 +60,10 @@ int main()
 	sprintf(UsrMsg,"Example of Counting semaphore for synchronization between 2 Tasks and event latching \r\n");
 	printmsg(UsrMsg);
 
+	//Random numbers of the interrupt handler (Random.c has to be included in the build, and HAL_RNG_MODULE_ENABLED)
+	xRandomInit();
+	vRandomStreamInit(&xInterruptStream);
+
 	//Create Counting Semaphore
 	xCountingSemaphore = xSemaphoreCreateCounting(10, 0);
 
@@ -93,7 +99,7 @@ void vHandlerTaskFunction (void *params)
 		//Wait and take the Semaphore when it is given by the interrupt handler
 		xSemaphoreTake(xCountingSemaphore, portMAX_DELAY);
 
-		sprintf(UsrMsg, "Handler Task: Processing the event %ld \r\n", uxSemaphoreGetCount(xCountingSemaphore));
+		sprintf(UsrMsg, "Handler Task: Processing the event %ld (lost events: %lu) \r\n", uxSemaphoreGetCount(xCountingSemaphore), ulLostEvents);
 		printmsg(UsrMsg);
 
 	}
@@ -126,7 +132,7 @@ void vPeriodicTaskFunction (void *params)
 void EXTI15_10_IRQHandler(void)
 {
 	portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
-	uint8_t ucCount = (uint8_t) ( rand() & 0x09);	//The ucCount maximum value should be Semaphores MaxCount
+	uint8_t ucCount = (uint8_t) ( ulRandomNext(&xInterruptStream) & 0x09);	//The ucCount maximum value should be Semaphores MaxCount
 
 	sprintf(UsrMsg, "Button Interrupt Service Routine. Giving the Semaphore to the Handler task.\r\n");
 	printmsg(UsrMsg);
@@ -134,7 +140,11 @@ void EXTI15_10_IRQHandler(void)
 	//Give xcountingSemaphore ucCount number of  times
 	for(uint8_t i = 0; i < ucCount; i++)
 	{
-		xSemaphoreGiveFromISR(xCountingSemaphore, &xHigherPriorityTaskWoken);
+		//The give fails when the semaphore is full, i.e. the handler task is behind. Count the lost event.
+		if(xSemaphoreGiveFromISR(xCountingSemaphore, &xHigherPriorityTaskWoken) != pdPASS)
+		{
+			ulLostEvents++;
+		}
 	}
 
 }
@@ -0,0 +1,195 @@
+/*
+ * Crc32.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * The CRC unit computes the CRC with the polynomial 0x04C11DB7 MSB first. To get the reflected CRC-32,
+ * the input bytes are bit reversed (byte-wise input inversion) and so is the result (output inversion).
+ * It starts from 0xFFFFFFFF (default initial value) and the final XOR is done by software.
+ *
+ * The DMA transfer is a memory to memory transfer from the buffer to the CRC data register, one byte
+ * at a time (the buffer does not have to be aligned). The data register is not incremented.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "stm32wbxx.h"
+#include "stm32wbxx_hal.h"
+#include "Crc32.h"
+
+//Maximum number of bytes of one DMA transfer (16 bit counter)
+#define CRC32_DMA_MAX_LENGTH		0xFFFF
+
+//CRC of 4 bits at a time: a 16 entries table is enough for a fallback (64 bytes instead of 1KB)
+static const uint32_t ulCrc32Table[16] =
+{
+	0x00000000UL, 0x1DB71064UL, 0x3B6E20C8UL, 0x26D930ACUL, 0x76DC4190UL, 0x6B6B51F4UL, 0x4DB26158UL, 0x5005713CUL,
+	0xEDB88320UL, 0xF00F9344UL, 0xD6D6A3E8UL, 0xCB61B38CUL, 0x9B64C2B0UL, 0x86D3D2D4UL, 0xA00AE278UL, 0xBDBDF21CUL
+};
+
+static const uint8_t ucCheckString[9] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+
+static CRC_HandleTypeDef CrcHandle;
+static DMA_HandleTypeDef CrcDmaHandle;
+static SemaphoreHandle_t xCrcMutex = NULL;
+static BaseType_t xHardwareReady = pdFALSE;
+
+//Task waiting for the end of the DMA transfer
+static TaskHandle_t xDmaWaitingTask = NULL;
+static volatile uint8_t ucDmaDone = 0;
+
+//Private helper functions
+static uint32_t prvCrc32Hardware(const uint8_t *pucData, size_t xLength);
+static void prvDmaComplete(DMA_HandleTypeDef *hdma);
+
+
+BaseType_t xCrc32Init(void)
+{
+#if ( CRC32_USE_HARDWARE == 1 )
+	xCrcMutex = xSemaphoreCreateMutex();
+	if(xCrcMutex == NULL)
+	{
+		return pdFAIL;
+	}
+
+	//1. CRC unit: default polynomial and initial value, reflected input and output
+	CrcHandle.Instance = CRC;
+	CrcHandle.Init.DefaultPolynomialUse = DEFAULT_POLYNOMIAL_ENABLE;
+	CrcHandle.Init.DefaultInitValueUse = DEFAULT_INIT_VALUE_ENABLE;
+	CrcHandle.Init.InputDataInversionMode = CRC_INPUTDATA_INVERSION_BYTE;
+	CrcHandle.Init.OutputDataInversionMode = CRC_OUTPUTDATA_INVERSION_ENABLE;
+	CrcHandle.InputDataFormat = CRC_INPUTDATA_FORMAT_BYTES;
+
+	if(HAL_CRC_Init(&CrcHandle) != HAL_OK)
+	{
+		return pdFAIL;
+	}
+
+	//2. DMA2 channel 1: memory (byte, incremented) to the CRC data register (byte, fixed)
+	__HAL_RCC_DMAMUX1_CLK_ENABLE();
+	__HAL_RCC_DMA2_CLK_ENABLE();
+
+	CrcDmaHandle.Instance = DMA2_Channel1;
+	CrcDmaHandle.Init.Request = DMA_REQUEST_MEM2MEM;
+	CrcDmaHandle.Init.Direction = DMA_MEMORY_TO_MEMORY;
+	CrcDmaHandle.Init.PeriphInc = DMA_PINC_ENABLE;
+	CrcDmaHandle.Init.MemInc = DMA_MINC_DISABLE;
+	CrcDmaHandle.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+	CrcDmaHandle.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+	CrcDmaHandle.Init.Mode = DMA_NORMAL;
+	CrcDmaHandle.Init.Priority = DMA_PRIORITY_LOW;
+
+	if(HAL_DMA_Init(&CrcDmaHandle) != HAL_OK)
+	{
+		return pdFAIL;
+	}
+
+	CrcDmaHandle.XferCpltCallback = prvDmaComplete;
+
+	NVIC_SetPriority(DMA2_Channel1_IRQn, CRC32_DMA_IRQ_PRIORITY); //Priority should be less than or equal to configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY
+	NVIC_EnableIRQ(DMA2_Channel1_IRQn);
+
+	//3. The hardware has to give the same CRC as the software one, or it is not used
+	if(prvCrc32Hardware(ucCheckString, sizeof(ucCheckString)) != CRC32_CHECK_VALUE)
+	{
+		return pdFAIL;
+	}
+
+	xHardwareReady = pdTRUE;
+	return pdPASS;
+#else
+	return pdFAIL;
+#endif
+}
+
+uint32_t ulCrc32Calculate(const uint8_t *pucData, size_t xLength)
+{
+	uint32_t ulCrc;
+
+	if(xHardwareReady == pdFALSE)
+	{
+		return ulCrc32Software(0, pucData, xLength);
+	}
+
+	xSemaphoreTake(xCrcMutex, portMAX_DELAY);
+	ulCrc = prvCrc32Hardware(pucData, xLength);
+	xSemaphoreGive(xCrcMutex);
+
+	return ulCrc;
+}
+
+uint32_t ulCrc32Software(uint32_t ulCrc, const uint8_t *pucData, size_t xLength)
+{
+	ulCrc = ~ulCrc;
+
+	while(xLength-- != 0)
+	{
+		ulCrc ^= *pucData++;
+		ulCrc = (ulCrc >> 4) ^ ulCrc32Table[ulCrc & 0x0F];
+		ulCrc = (ulCrc >> 4) ^ ulCrc32Table[ulCrc & 0x0F];
+	}
+
+	return ~ulCrc;
+}
+
+
+void DMA2_Channel1_IRQHandler(void)
+{
+	HAL_DMA_IRQHandler(&CrcDmaHandle);
+}
+
+//Called by HAL_CRC_Init()
+void HAL_CRC_MspInit(CRC_HandleTypeDef *hcrc)
+{
+	__HAL_RCC_CRC_CLK_ENABLE();
+}
+
+
+//The caller owns the CRC unit (mutex, or before the scheduler is started)
+static uint32_t prvCrc32Hardware(const uint8_t *pucData, size_t xLength)
+{
+	uint32_t ulChunk;
+
+	//Short buffers, or no task to block: the CPU writes the bytes to the CRC unit
+	if( (xLength < CRC32_DMA_THRESHOLD) || (xTaskGetSchedulerState() != taskSCHEDULER_RUNNING) )
+	{
+		return HAL_CRC_Calculate(&CrcHandle, (uint32_t *) pucData, xLength) ^ 0xFFFFFFFFUL;
+	}
+
+	__HAL_CRC_DR_RESET(&CrcHandle);
+
+	while(xLength != 0)
+	{
+		ulChunk = (xLength > CRC32_DMA_MAX_LENGTH) ? CRC32_DMA_MAX_LENGTH : xLength;
+
+		ucDmaDone = 0;
+		xDmaWaitingTask = xTaskGetCurrentTaskHandle();
+		HAL_DMA_Start_IT(&CrcDmaHandle, (uint32_t) pucData, (uint32_t) &CRC->DR, ulChunk);
+
+		//The CPU is free for the other tasks during the transfer
+		while(ucDmaDone == 0)
+		{
+			ulTaskNotifyTakeIndexed(CRC32_NOTIFY_INDEX, pdTRUE, portMAX_DELAY);
+		}
+
+		pucData += ulChunk;
+		xLength -= ulChunk;
+	}
+
+	return CRC->DR ^ 0xFFFFFFFFUL;
+}
+
+//Called from the DMA interrupt
+static void prvDmaComplete(DMA_HandleTypeDef *hdma)
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	ucDmaDone = 1;
+	vTaskNotifyGiveIndexedFromISR(xDmaWaitingTask, CRC32_NOTIFY_INDEX, &xHigherPriorityTaskWoken);
+
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
@@ -0,0 +1,269 @@
+/*
+ * DeferredWork.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * Every lane is a bounded lock-free ring (Vyukov's bounded queue with one sequence number per cell).
+ * Producers reserve a cell with a compare-and-swap (LDREX/STREX on the Cortex-M4), so ISRs of
+ * different priorities can nest and submit to the same lane without disabling interrupts.
+ * The worker task of the lane is the only consumer.
+ *
+ * The submit time is stamped with the DWT cycle counter, and the worker records the
+ * enqueue-to-execute latency before calling the function.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stm32wbxx.h"
+#include "DeferredWork.h"
+
+#define QUEUE_MASK		( DEFERRED_WORK_QUEUE_LENGTH - 1UL )
+
+#if ( DEFERRED_WORK_QUEUE_LENGTH & ( DEFERRED_WORK_QUEUE_LENGTH - 1 ) ) != 0
+#error "DEFERRED_WORK_QUEUE_LENGTH must be a power of 2"
+#endif
+
+typedef struct DeferredWorkItem
+{
+	volatile uint32_t ulSequence;
+	DeferredWorkFunction_t pxFunction;
+	void *pvParameter1;
+	uint32_t ulParameter2;
+	uint32_t ulTimestamp;
+}DeferredWorkItem_t;
+
+typedef struct DeferredWorkLane
+{
+	DeferredWorkItem_t xItems[DEFERRED_WORK_QUEUE_LENGTH];
+	volatile uint32_t ulEnqueuePos;
+	volatile uint32_t ulDequeuePos;
+	volatile uint32_t ulDropped;
+	TaskHandle_t xWorkerHandle;
+	DeferredWorkStats_t xStats;
+}DeferredWorkLane_t;
+
+static DeferredWorkLane_t xLanes[DEFERRED_WORK_LANES];
+
+//Private helper functions
+static void prvWorkerTask(void *params);
+static BaseType_t prvEnqueue(DeferredWorkLane_t *pxLane, DeferredWorkFunction_t pxFunction,
+		void *pvParameter1, uint32_t ulParameter2);
+static BaseType_t prvDequeue(DeferredWorkLane_t *pxLane, DeferredWorkItem_t *pxItem);
+
+
+BaseType_t xDeferredWorkInit(void)
+{
+	const UBaseType_t uxPriorities[DEFERRED_WORK_LANES] = DEFERRED_WORK_LANE_PRIORITIES;
+	static const char * const pcNames[] = { "Deferred-0", "Deferred-1", "Deferred-2", "Deferred-3" };
+	UBaseType_t uxLane, i;
+
+	configASSERT( DEFERRED_WORK_LANES <= ( sizeof(pcNames) / sizeof(pcNames[0]) ) );
+
+	for(uxLane = 0; uxLane < DEFERRED_WORK_LANES; uxLane++)
+	{
+		DeferredWorkLane_t *pxLane = &xLanes[uxLane];
+
+		//Cell i is free for the producer whose position is i
+		for(i = 0; i < DEFERRED_WORK_QUEUE_LENGTH; i++)
+		{
+			pxLane->xItems[i].ulSequence = i;
+		}
+
+		pxLane->ulEnqueuePos = 0;
+		pxLane->ulDequeuePos = 0;
+		pxLane->ulDropped = 0;
+		vDeferredWorkResetStats(uxLane);
+
+		if(xTaskCreate(prvWorkerTask, pcNames[uxLane], DEFERRED_WORK_STACK_SIZE, pxLane,
+				uxPriorities[uxLane], &pxLane->xWorkerHandle) != pdPASS)
+		{
+			return pdFAIL;
+		}
+	}
+
+	return pdPASS;
+}
+
+BaseType_t xDeferredWorkSubmitFromISR(UBaseType_t uxLane, DeferredWorkFunction_t pxFunction,
+		void *pvParameter1, uint32_t ulParameter2, BaseType_t *pxHigherPriorityTaskWoken)
+{
+	DeferredWorkLane_t *pxLane;
+
+	configASSERT( uxLane < DEFERRED_WORK_LANES );
+	pxLane = &xLanes[uxLane];
+
+	if(prvEnqueue(pxLane, pxFunction, pvParameter1, ulParameter2) != pdPASS)
+	{
+		return pdFAIL;
+	}
+
+	vTaskNotifyGiveFromISR(pxLane->xWorkerHandle, pxHigherPriorityTaskWoken);
+
+	return pdPASS;
+}
+
+BaseType_t xDeferredWorkSubmit(UBaseType_t uxLane, DeferredWorkFunction_t pxFunction,
+		void *pvParameter1, uint32_t ulParameter2)
+{
+	DeferredWorkLane_t *pxLane;
+
+	configASSERT( uxLane < DEFERRED_WORK_LANES );
+	pxLane = &xLanes[uxLane];
+
+	if(prvEnqueue(pxLane, pxFunction, pvParameter1, ulParameter2) != pdPASS)
+	{
+		return pdFAIL;
+	}
+
+	xTaskNotifyGive(pxLane->xWorkerHandle);
+
+	return pdPASS;
+}
+
+void vDeferredWorkGetStats(UBaseType_t uxLane, DeferredWorkStats_t *pxStats)
+{
+	configASSERT( uxLane < DEFERRED_WORK_LANES );
+
+	taskENTER_CRITICAL();
+	*pxStats = xLanes[uxLane].xStats;
+	pxStats->ulDropped = xLanes[uxLane].ulDropped;
+	taskEXIT_CRITICAL();
+}
+
+void vDeferredWorkResetStats(UBaseType_t uxLane)
+{
+	DeferredWorkStats_t *pxStats;
+
+	configASSERT( uxLane < DEFERRED_WORK_LANES );
+	pxStats = &xLanes[uxLane].xStats;
+
+	taskENTER_CRITICAL();
+	pxStats->ulExecuted = 0;
+	pxStats->ulDropped = 0;
+	pxStats->ulMinLatency = 0xFFFFFFFFUL;
+	pxStats->ulMaxLatency = 0;
+	pxStats->ullTotalLatency = 0;
+	pxStats->ulHighWaterMark = 0;
+	xLanes[uxLane].ulDropped = 0;
+	taskEXIT_CRITICAL();
+}
+
+
+static void prvWorkerTask(void *params)
+{
+	DeferredWorkLane_t *pxLane = (DeferredWorkLane_t *) params;
+	DeferredWorkStats_t *pxStats = &pxLane->xStats;
+	DeferredWorkItem_t xItem;
+	uint32_t ulLatency, ulPending;
+
+	while(1)
+	{
+		//One notification can stand for several items, all of them are drained below
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+		ulPending = pxLane->ulEnqueuePos - pxLane->ulDequeuePos;
+
+		while(prvDequeue(pxLane, &xItem) == pdPASS)
+		{
+			ulLatency = DWT->CYCCNT - xItem.ulTimestamp;
+
+			taskENTER_CRITICAL();
+			pxStats->ulExecuted++;
+			pxStats->ullTotalLatency += ulLatency;
+			if(ulLatency < pxStats->ulMinLatency)
+			{
+				pxStats->ulMinLatency = ulLatency;
+			}
+			if(ulLatency > pxStats->ulMaxLatency)
+			{
+				pxStats->ulMaxLatency = ulLatency;
+			}
+			if(ulPending > pxStats->ulHighWaterMark)
+			{
+				pxStats->ulHighWaterMark = ulPending;
+			}
+			taskEXIT_CRITICAL();
+
+			xItem.pxFunction(xItem.pvParameter1, xItem.ulParameter2);
+		}
+	}
+}
+
+static BaseType_t prvEnqueue(DeferredWorkLane_t *pxLane, DeferredWorkFunction_t pxFunction,
+		void *pvParameter1, uint32_t ulParameter2)
+{
+	DeferredWorkItem_t *pxItem;
+	uint32_t ulPos, ulSequence;
+	int32_t lDiff;
+
+	ulPos = __atomic_load_n(&pxLane->ulEnqueuePos, __ATOMIC_RELAXED);
+
+	while(1)
+	{
+		pxItem = &pxLane->xItems[ulPos & QUEUE_MASK];
+		ulSequence = __atomic_load_n(&pxItem->ulSequence, __ATOMIC_ACQUIRE);
+		lDiff = (int32_t)(ulSequence - ulPos);
+
+		if(lDiff == 0)
+		{
+			//Cell is free: try to reserve it. On failure ulPos is reloaded with the current position.
+			if(__atomic_compare_exchange_n(&pxLane->ulEnqueuePos, &ulPos, ulPos + 1, pdFALSE,
+					__ATOMIC_RELAXED, __ATOMIC_RELAXED))
+			{
+				break;
+			}
+		}
+		else if(lDiff < 0)
+		{
+			//The worker has not consumed this cell yet: the lane is full
+			__atomic_add_fetch(&pxLane->ulDropped, 1, __ATOMIC_RELAXED);
+			return pdFAIL;
+		}
+		else
+		{
+			//Another producer took this cell in the meantime
+			ulPos = __atomic_load_n(&pxLane->ulEnqueuePos, __ATOMIC_RELAXED);
+		}
+	}
+
+	pxItem->pxFunction = pxFunction;
+	pxItem->pvParameter1 = pvParameter1;
+	pxItem->ulParameter2 = ulParameter2;
+	pxItem->ulTimestamp = DWT->CYCCNT;
+
+	//Publish the item to the worker
+	__atomic_store_n(&pxItem->ulSequence, ulPos + 1, __ATOMIC_RELEASE);
+
+	return pdPASS;
+}
+
+static BaseType_t prvDequeue(DeferredWorkLane_t *pxLane, DeferredWorkItem_t *pxItem)
+{
+	uint32_t ulPos = pxLane->ulDequeuePos;
+	DeferredWorkItem_t *pxCell = &pxLane->xItems[ulPos & QUEUE_MASK];
+	uint32_t ulSequence = __atomic_load_n(&pxCell->ulSequence, __ATOMIC_ACQUIRE);
+
+	/*
+	 * The cell is not published yet: the lane is empty, or a producer has reserved it
+	 * and was interrupted before publishing. That producer notifies the worker when it is done.
+	 */
+	if(ulSequence != (ulPos + 1))
+	{
+		return pdFAIL;
+	}
+
+	pxItem->pxFunction = pxCell->pxFunction;
+	pxItem->pvParameter1 = pxCell->pvParameter1;
+	pxItem->ulParameter2 = pxCell->ulParameter2;
+	pxItem->ulTimestamp = pxCell->ulTimestamp;
+
+	pxLane->ulDequeuePos = ulPos + 1;
+
+	//Give the cell back to the producers for the next round
+	__atomic_store_n(&pxCell->ulSequence, ulPos + DEFERRED_WORK_QUEUE_LENGTH, __ATOMIC_RELEASE);
+
+	return pdPASS;
+}
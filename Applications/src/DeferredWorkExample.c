@@ -0,0 +1,286 @@
+/*
+ * DeferredWorkExample.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * This application is the CountingSemaphore example without any work inside the interrupt handler.
+ * The periodic task simulates the interrupt, and the ISR only submits function calls to the
+ * deferred work executor (DeferredWork.c):
+ *  - High lane   : toggle the LED
+ *  - Normal lane : print the event messages (sprintf + UART were called from the ISR before)
+ *  - Low lane    : a burst of small jobs to load the executor
+ * The ISR duration and the enqueue-to-execute latency of each lane are printed every 5 seconds.
+ *
+ * DeferredWork.c has to be included in the build with this file.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stm32wbxx.h"
+#include "stm32wbxx_nucleo.h"
+#include "stdio.h"
+#include "string.h"
+#include "DeferredWork.h"
+
+#define REPORT_PERIOD_MS		5000
+#define BURST_MAX_JOBS			8
+
+//Task handles and functions
+TaskHandle_t xPeriodicTask = NULL;
+TaskHandle_t xReportTask = NULL;
+void vPeriodicTaskFunction(void *params);
+void vReportTaskFunction(void *params);
+/* Enable the software interrupt and set its priority. */
+static void prvSetupSoftwareInterrupt();
+
+//Deferred functions
+void vToggleLEDWork(void *pvParameter1, uint32_t ulParameter2);
+void vPrintEventWork(void *pvParameter1, uint32_t ulParameter2);
+void vBurstWork(void *pvParameter1, uint32_t ulParameter2);
+
+//UART Handle and Init types
+UART_HandleTypeDef Uart1;
+UART_InitTypeDef Uart1Init;
+GPIO_InitTypeDef GpioUARTpins, GpioLEDpin;
+
+//Private helper functions and variables
+static void prvSetupUART(void);
+static void prvSetupLED(void);
+void printmsg(char *msg);
+char UsrMsg[250];
+char WorkMsg[100];
+volatile uint32_t ulEventCount = 0;
+volatile uint32_t ulBurstCount = 0;
+volatile uint32_t ulISRMaxCycles = 0;
+uint32_t ulBurstSeed = 1;
+
+int main()
+{
+	// Enable the DWT Cycle Count Register (SEGGER Settings)
+	DWT->CTRL |= (1 << 0);
+
+	// Private function called to setup the Hardware
+	prvSetupUART();
+	prvSetupLED();
+	prvSetupSoftwareInterrupt();
+
+	//Start Recording for SEGGER SystemView
+	SEGGER_SYSVIEW_Conf();
+	SEGGER_SYSVIEW_Start();
+
+	sprintf(UsrMsg,"Example of deferred interrupt processing with priority lanes \r\n");
+	printmsg(UsrMsg);
+
+	if(xDeferredWorkInit() == pdPASS)
+	{
+		//Create Periodic Task. It simulates the interrupts.
+		xTaskCreate(vPeriodicTaskFunction, "Periodic-Task", configMINIMAL_STACK_SIZE, NULL, 3, &xPeriodicTask);
+
+		//Create Report Task. It prints the statistics.
+		xTaskCreate(vReportTaskFunction, "Report-Task", 512, NULL, 1, &xReportTask);
+
+		//Schedule the tasks
+		vTaskStartScheduler();
+	}
+	else
+	{
+		sprintf(UsrMsg, "Deferred work executor creation failed... :( \r\n");
+		printmsg(UsrMsg);
+	}
+
+	/*
+	 * If scheduler can start the tasks and run them, the program will never reach here.
+	 * If the program comes to the below line, that means there was a problem while creating or scheduling the tasks
+	 */
+	for(;;);
+}
+
+
+void vPeriodicTaskFunction(void *params)
+{
+	/*
+	 * This periodic task is used to simulate interrupts for every 500ms.
+	 */
+	while(1)
+	{
+		vTaskDelay(pdMS_TO_TICKS(500));
+
+		//Pend the interrupt
+		NVIC_SetPendingIRQ(EXTI15_10_IRQn);
+	}
+}
+
+
+void vReportTaskFunction(void *params)
+{
+	static const char * const pcLaneNames[DEFERRED_WORK_LANES] = { "High", "Normal", "Low" };
+	DeferredWorkStats_t xStats;
+	UBaseType_t uxLane;
+
+	while(1)
+	{
+		vTaskDelay(pdMS_TO_TICKS(REPORT_PERIOD_MS));
+
+		sprintf(UsrMsg, "\r\nEvents: %lu, ISR max: %lu cycles \r\n", ulEventCount, ulISRMaxCycles);
+		printmsg(UsrMsg);
+
+		for(uxLane = 0; uxLane < DEFERRED_WORK_LANES; uxLane++)
+		{
+			vDeferredWorkGetStats(uxLane, &xStats);
+
+			if(xStats.ulExecuted == 0)
+			{
+				continue;
+			}
+
+			//Latencies in cycles: enqueue in the ISR to the start of the deferred function
+			sprintf(UsrMsg, "%-6s lane: %5lu jobs, %lu dropped, latency min %lu / avg %lu / max %lu cycles, max pending %lu \r\n",
+					pcLaneNames[uxLane], xStats.ulExecuted, xStats.ulDropped, xStats.ulMinLatency,
+					(uint32_t)(xStats.ullTotalLatency / xStats.ulExecuted), xStats.ulMaxLatency, xStats.ulHighWaterMark);
+			printmsg(UsrMsg);
+		}
+	}
+}
+
+
+void EXTI15_10_IRQHandler(void)
+{
+	portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+	uint32_t ulStart = DWT->CYCCNT;
+	uint32_t ulCycles;
+	uint8_t ucCount, i;
+
+	ulEventCount++;
+
+	//Number of burst jobs for this event (small LCG instead of rand(), which is not reentrant)
+	ulBurstSeed = (ulBurstSeed * 1103515245UL) + 12345UL;
+	ucCount = (uint8_t) ( (ulBurstSeed >> 16) % (BURST_MAX_JOBS + 1) );
+
+	xDeferredWorkSubmitFromISR(DEFERRED_WORK_LANE_HIGH, vToggleLEDWork, NULL, 0, &xHigherPriorityTaskWoken);
+	xDeferredWorkSubmitFromISR(DEFERRED_WORK_LANE_NORMAL, vPrintEventWork, NULL, ulEventCount, &xHigherPriorityTaskWoken);
+
+	for(i = 0; i < ucCount; i++)
+	{
+		xDeferredWorkSubmitFromISR(DEFERRED_WORK_LANE_LOW, vBurstWork, NULL, i, &xHigherPriorityTaskWoken);
+	}
+
+	ulCycles = DWT->CYCCNT - ulStart;
+	if(ulCycles > ulISRMaxCycles)
+	{
+		ulISRMaxCycles = ulCycles;
+	}
+
+	/*
+	 * If the above FreeRTOS APIs unblocks any other higher priority tasks,
+	 * then yield the processor to the higher priority task which has been unblocked.
+	 */
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+
+void vToggleLEDWork(void *pvParameter1, uint32_t ulParameter2)
+{
+	HAL_GPIO_TogglePin(LED1_GPIO_PORT, LED1_PIN);
+}
+
+void vPrintEventWork(void *pvParameter1, uint32_t ulParameter2)
+{
+	sprintf(WorkMsg, "Normal lane: processing the event %lu \r\n", ulParameter2);
+	printmsg(WorkMsg);
+}
+
+void vBurstWork(void *pvParameter1, uint32_t ulParameter2)
+{
+	ulBurstCount++;
+}
+
+
+static void prvSetupSoftwareInterrupt()
+{
+	/*
+	 * Here were simulating the button interrupt by manually setting the interrupt enable bit in the NVIC enable register.
+	 * The interrupt service routine uses an (interrupt safe) FreeRTOS API function so the interrupt priority
+	 * must be at or below the priority defined by configSYSCALL_INTERRUPT_PRIORITY.
+	 */
+
+	NVIC_SetPriority( EXTI15_10_IRQn, configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY );
+
+	/* Enable the interrupt. */
+	NVIC_EnableIRQ( EXTI15_10_IRQn );
+}
+
+
+static void prvSetupLED(void)
+{
+	LED1_GPIO_CLK_ENABLE();
+
+	//Zeroing each and every member element of the structure.
+	memset(&GpioLEDpin, 0, sizeof(GpioLEDpin));
+	GpioLEDpin.Pin = LED1_PIN;
+	GpioLEDpin.Mode = GPIO_MODE_OUTPUT_PP;
+	GpioLEDpin.Speed = GPIO_SPEED_FREQ_MEDIUM;
+	GpioLEDpin.Pull = GPIO_NOPULL;
+
+	HAL_GPIO_Init(GPIOB, &GpioLEDpin);
+}
+
+
+static void prvSetupUART(void)
+{
+	//1. Enable the UART1 and GPIOB Peripheral Clocks
+	__HAL_RCC_USART1_CLK_ENABLE();
+	__HAL_RCC_GPIOB_CLK_ENABLE();
+
+	//In UART connection with Virtual COM-port, PB6->TX and PB7->RX
+	//2. Alternate Functionality Configuration to make Port B pins work as UART pins
+
+	//Zeroing each and every member element of the structure.
+	memset(&GpioUARTpins, 0, sizeof(GpioUARTpins));
+	GpioUARTpins.Pin = GPIO_PIN_6 | GPIO_PIN_7;
+	GpioUARTpins.Mode = GPIO_MODE_AF_PP;
+	GpioUARTpins.Alternate = GPIO_AF7_USART1;
+	GpioUARTpins.Pull = GPIO_PULLUP;
+
+	HAL_GPIO_Init(GPIOB, &GpioUARTpins);
+
+	//3. Configure and initialize UART parameters
+
+	//Zeroing each and every member element of the structure.
+	memset(&Uart1Init, 0, sizeof(Uart1Init));
+	memset(&Uart1, 0, sizeof(Uart1));
+
+	//UART Initialization
+	Uart1Init.BaudRate = 115200;
+	Uart1Init.WordLength = UART_WORDLENGTH_8B;
+	Uart1Init.HwFlowCtl = UART_HWCONTROL_NONE;
+	Uart1Init.Mode = UART_MODE_TX_RX;
+	Uart1Init.Parity = UART_PARITY_NONE;
+	Uart1Init.StopBits = UART_STOPBITS_1;
+
+	Uart1.Init = Uart1Init;
+	Uart1.Instance = USART1;
+
+	//4. Initialize the UART peripheral
+	uint16_t UARTSetUpResult = HAL_UART_Init(&Uart1);
+
+	if(UARTSetUpResult == HAL_ERROR)
+	{
+		//printf("USART Initialization was not successful \n");
+	}
+
+}
+
+void printmsg(char *msg)
+{
+	HAL_UART_Transmit(&Uart1, (uint8_t *)msg, strlen(msg), 1);
+}
+
+//Implement the Idle Hook function
+void vApplicationIdleHook()
+{
+	//Send the CPU to normal sleep mode
+	__WFI();
+}
@@ -0,0 +1,483 @@
+/*
+ * EcdsaSoft.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * The numbers are 8 words of 32 bits, least significant word first. The arithmetic modulo p (coordinates)
+ * and modulo n (scalars) is the same Montgomery multiplication (CIOS) with different constants:
+ * a value x is kept as x * 2^256 mod m, and the inverse is x^(m - 2) (both moduli are prime).
+ *
+ * The points are in Jacobian coordinates (x = X / Z^2, y = Y / Z^3, Z = 0 is the point at infinity),
+ * so the additions and doublings need no inversion. u1 * G + u2 * Q is computed in one pass over the bits
+ * of u1 and u2 (Shamir's trick: one doubling per bit and an addition of G, Q or G + Q).
+ *
+ * The verification only uses public data, so it does not have to run in constant time.
+ */
+
+#include "stdint.h"
+#include "string.h"
+#include "EcdsaSoft.h"
+
+#define P256_WORDS		8
+
+typedef struct Modulus
+{
+	uint32_t ulValue[P256_WORDS];
+	uint32_t ulR2[P256_WORDS];		//2^512 mod m, to convert to the Montgomery form
+	uint32_t ulInverse;				//-m^-1 mod 2^32
+}Modulus_t;
+
+typedef struct JacobianPoint
+{
+	uint32_t ulX[P256_WORDS];
+	uint32_t ulY[P256_WORDS];
+	uint32_t ulZ[P256_WORDS];
+}JacobianPoint_t;
+
+const uint8_t ucP256Prime[ECDSA_P256_SIZE] =
+{
+	0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+};
+const uint8_t ucP256Order[ECDSA_P256_SIZE] =
+{
+	0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xbc, 0xe6, 0xfa, 0xad, 0xa7, 0x17, 0x9e, 0x84, 0xf3, 0xb9, 0xca, 0xc2, 0xfc, 0x63, 0x25, 0x51
+};
+const uint8_t ucP256Gx[ECDSA_P256_SIZE] =
+{
+	0x6b, 0x17, 0xd1, 0xf2, 0xe1, 0x2c, 0x42, 0x47, 0xf8, 0xbc, 0xe6, 0xe5, 0x63, 0xa4, 0x40, 0xf2,
+	0x77, 0x03, 0x7d, 0x81, 0x2d, 0xeb, 0x33, 0xa0, 0xf4, 0xa1, 0x39, 0x45, 0xd8, 0x98, 0xc2, 0x96
+};
+const uint8_t ucP256Gy[ECDSA_P256_SIZE] =
+{
+	0x4f, 0xe3, 0x42, 0xe2, 0xfe, 0x1a, 0x7f, 0x9b, 0x8e, 0xe7, 0xeb, 0x4a, 0x7c, 0x0f, 0x9e, 0x16,
+	0x2b, 0xce, 0x33, 0x57, 0x6b, 0x31, 0x5e, 0xce, 0xcb, 0xb6, 0x40, 0x68, 0x37, 0xbf, 0x51, 0xf5
+};
+
+static const Modulus_t xPrime =
+{
+	{ 0xffffffffUL, 0xffffffffUL, 0xffffffffUL, 0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000001UL, 0xffffffffUL },
+	{ 0x00000003UL, 0x00000000UL, 0xffffffffUL, 0xfffffffbUL, 0xfffffffeUL, 0xffffffffUL, 0xfffffffdUL, 0x00000004UL },
+	0x00000001UL
+};
+
+static const Modulus_t xOrder =
+{
+	{ 0xfc632551UL, 0xf3b9cac2UL, 0xa7179e84UL, 0xbce6faadUL, 0xffffffffUL, 0xffffffffUL, 0x00000000UL, 0xffffffffUL },
+	{ 0xbe79eea2UL, 0x83244c95UL, 0x49bd6fa6UL, 0x4699799cUL, 0x2b6bec59UL, 0x2845b239UL, 0xf3d95620UL, 0x66e12d94UL },
+	0xee00bc4fUL
+};
+
+//Private helper functions
+static void prvLoad(uint32_t *pulValue, const uint8_t *pucBytes);
+static int8_t prvCompare(const uint32_t *pulA, const uint32_t *pulB);
+static uint8_t prvIsZero(const uint32_t *pulA);
+static uint32_t prvAdd(uint32_t *pulResult, const uint32_t *pulA, const uint32_t *pulB);
+static uint32_t prvSub(uint32_t *pulResult, const uint32_t *pulA, const uint32_t *pulB);
+static void prvModAdd(uint32_t *pulResult, const uint32_t *pulA, const uint32_t *pulB, const Modulus_t *pxModulus);
+static void prvModSub(uint32_t *pulResult, const uint32_t *pulA, const uint32_t *pulB, const Modulus_t *pxModulus);
+static void prvMontMul(uint32_t *pulResult, const uint32_t *pulA, const uint32_t *pulB, const Modulus_t *pxModulus);
+static void prvToMont(uint32_t *pulResult, const uint32_t *pulA, const Modulus_t *pxModulus);
+static void prvFromMont(uint32_t *pulResult, const uint32_t *pulA, const Modulus_t *pxModulus);
+static void prvModInverse(uint32_t *pulResult, const uint32_t *pulA, const Modulus_t *pxModulus);
+static void prvPointDouble(JacobianPoint_t *pxResult, const JacobianPoint_t *pxPoint);
+static void prvPointAdd(JacobianPoint_t *pxResult, const JacobianPoint_t *pxP, const JacobianPoint_t *pxQ);
+
+
+uint8_t ucEcdsaSoftCheckInputs(const uint8_t *pucPublicKey, const uint8_t *pucSignature)
+{
+	uint32_t ulValue[P256_WORDS];
+	uint8_t i;
+
+	for(i = 0; i < 2; i++)
+	{
+		prvLoad(ulValue, &pucSignature[i * ECDSA_P256_SIZE]);
+		if( (prvIsZero(ulValue) != 0) || (prvCompare(ulValue, xOrder.ulValue) >= 0) )
+		{
+			return 0;
+		}
+
+		prvLoad(ulValue, &pucPublicKey[i * ECDSA_P256_SIZE]);
+		if(prvCompare(ulValue, xPrime.ulValue) >= 0)
+		{
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+uint8_t ucEcdsaSoftVerify(const uint8_t *pucPublicKey, const uint8_t *pucHash, const uint8_t *pucSignature)
+{
+	uint32_t ulR[P256_WORDS], ulW[P256_WORDS], ulU1[P256_WORDS], ulU2[P256_WORDS], ulTemp[P256_WORDS];
+	JacobianPoint_t xPoints[4];			//Infinity (unused), G, Q, G + Q: index = bit of u1 + 2 * bit of u2
+	JacobianPoint_t xSum;
+	uint8_t ucIndex;
+	int16_t i;
+
+	if(ucEcdsaSoftCheckInputs(pucPublicKey, pucSignature) == 0)
+	{
+		return 0;
+	}
+
+	//1. w = s^-1, u1 = e * w, u2 = r * w (mod n)
+	prvLoad(ulTemp, &pucSignature[ECDSA_P256_SIZE]);
+	prvToMont(ulTemp, ulTemp, &xOrder);
+	prvModInverse(ulW, ulTemp, &xOrder);
+
+	prvLoad(ulTemp, pucHash);
+	prvToMont(ulTemp, ulTemp, &xOrder);				//The hash can be >= n: the result is reduced
+	prvMontMul(ulU1, ulTemp, ulW, &xOrder);
+	prvFromMont(ulU1, ulU1, &xOrder);
+
+	prvLoad(ulR, pucSignature);
+	prvToMont(ulTemp, ulR, &xOrder);
+	prvMontMul(ulU2, ulTemp, ulW, &xOrder);
+	prvFromMont(ulU2, ulU2, &xOrder);
+
+	//2. G, Q (Z = 1) and G + Q, in the Montgomery form modulo p
+	prvLoad(xPoints[1].ulX, ucP256Gx);
+	prvLoad(xPoints[1].ulY, ucP256Gy);
+	prvLoad(xPoints[2].ulX, pucPublicKey);
+	prvLoad(xPoints[2].ulY, &pucPublicKey[ECDSA_P256_SIZE]);
+
+	memset(ulTemp, 0, sizeof(ulTemp));
+	ulTemp[0] = 1;
+	for(ucIndex = 1; ucIndex <= 2; ucIndex++)
+	{
+		prvToMont(xPoints[ucIndex].ulX, xPoints[ucIndex].ulX, &xPrime);
+		prvToMont(xPoints[ucIndex].ulY, xPoints[ucIndex].ulY, &xPrime);
+		prvToMont(xPoints[ucIndex].ulZ, ulTemp, &xPrime);
+	}
+	prvPointAdd(&xPoints[3], &xPoints[1], &xPoints[2]);
+
+	//3. u1 * G + u2 * Q, from the most significant bit
+	memset(&xSum, 0, sizeof(xSum));
+	for(i = 255; i >= 0; i--)
+	{
+		prvPointDouble(&xSum, &xSum);
+
+		ucIndex = (uint8_t)(((ulU1[i / 32] >> (i % 32)) & 0x01) | (((ulU2[i / 32] >> (i % 32)) & 0x01) << 1));
+		if(ucIndex != 0)
+		{
+			prvPointAdd(&xSum, &xSum, &xPoints[ucIndex]);
+		}
+	}
+
+	if(prvIsZero(xSum.ulZ) != 0)
+	{
+		return 0;
+	}
+
+	//4. x = X / Z^2, valid if x mod n == r (x < p < 2n: one subtraction at most)
+	prvModInverse(ulW, xSum.ulZ, &xPrime);
+	prvMontMul(ulTemp, ulW, ulW, &xPrime);
+	prvMontMul(ulTemp, xSum.ulX, ulTemp, &xPrime);
+	prvFromMont(ulTemp, ulTemp, &xPrime);
+
+	if(prvCompare(ulTemp, xOrder.ulValue) >= 0)
+	{
+		prvSub(ulTemp, ulTemp, xOrder.ulValue);
+	}
+
+	return (prvCompare(ulTemp, ulR) == 0) ? 1 : 0;
+}
+
+
+//Big endian bytes -> words, least significant word first
+static void prvLoad(uint32_t *pulValue, const uint8_t *pucBytes)
+{
+	uint8_t i;
+
+	for(i = 0; i < P256_WORDS; i++)
+	{
+		pulValue[P256_WORDS - 1 - i] = ((uint32_t) pucBytes[4 * i] << 24) | ((uint32_t) pucBytes[4 * i + 1] << 16) |
+									   ((uint32_t) pucBytes[4 * i + 2] << 8) | (uint32_t) pucBytes[4 * i + 3];
+	}
+}
+
+static int8_t prvCompare(const uint32_t *pulA, const uint32_t *pulB)
+{
+	int8_t i;
+
+	for(i = P256_WORDS - 1; i >= 0; i--)
+	{
+		if(pulA[i] != pulB[i])
+		{
+			return (pulA[i] > pulB[i]) ? 1 : -1;
+		}
+	}
+
+	return 0;
+}
+
+static uint8_t prvIsZero(const uint32_t *pulA)
+{
+	uint32_t ulOr = 0;
+	uint8_t i;
+
+	for(i = 0; i < P256_WORDS; i++)
+	{
+		ulOr |= pulA[i];
+	}
+
+	return (ulOr == 0) ? 1 : 0;
+}
+
+//Returns the carry
+static uint32_t prvAdd(uint32_t *pulResult, const uint32_t *pulA, const uint32_t *pulB)
+{
+	uint64_t ullSum = 0;
+	uint8_t i;
+
+	for(i = 0; i < P256_WORDS; i++)
+	{
+		ullSum += (uint64_t) pulA[i] + pulB[i];
+		pulResult[i] = (uint32_t) ullSum;
+		ullSum >>= 32;
+	}
+
+	return (uint32_t) ullSum;
+}
+
+//Returns the borrow
+static uint32_t prvSub(uint32_t *pulResult, const uint32_t *pulA, const uint32_t *pulB)
+{
+	int64_t llDifference = 0;
+	uint8_t i;
+
+	for(i = 0; i < P256_WORDS; i++)
+	{
+		llDifference += (int64_t) pulA[i] - pulB[i];
+		pulResult[i] = (uint32_t) llDifference;
+		llDifference >>= 32;			//0 or -1
+	}
+
+	return (uint32_t)(-llDifference);
+}
+
+//a + b mod m, a and b lower than m
+static void prvModAdd(uint32_t *pulResult, const uint32_t *pulA, const uint32_t *pulB, const Modulus_t *pxModulus)
+{
+	if( (prvAdd(pulResult, pulA, pulB) != 0) || (prvCompare(pulResult, pxModulus->ulValue) >= 0) )
+	{
+		prvSub(pulResult, pulResult, pxModulus->ulValue);
+	}
+}
+
+//a - b mod m, a and b lower than m
+static void prvModSub(uint32_t *pulResult, const uint32_t *pulA, const uint32_t *pulB, const Modulus_t *pxModulus)
+{
+	if(prvSub(pulResult, pulA, pulB) != 0)
+	{
+		prvAdd(pulResult, pulResult, pxModulus->ulValue);
+	}
+}
+
+//a * b * 2^-256 mod m (CIOS). The result can be one of the operands. a * b has to be lower than m * 2^256.
+static void prvMontMul(uint32_t *pulResult, const uint32_t *pulA, const uint32_t *pulB, const Modulus_t *pxModulus)
+{
+	uint32_t ulT[P256_WORDS + 2];
+	uint64_t ullProduct;
+	uint32_t ulQuotient;
+	uint8_t i, j;
+
+	memset(ulT, 0, sizeof(ulT));
+
+	for(i = 0; i < P256_WORDS; i++)
+	{
+		//T += a * b[i]
+		ullProduct = 0;
+		for(j = 0; j < P256_WORDS; j++)
+		{
+			ullProduct += (uint64_t) pulA[j] * pulB[i] + ulT[j];
+			ulT[j] = (uint32_t) ullProduct;
+			ullProduct >>= 32;
+		}
+		ullProduct += ulT[P256_WORDS];
+		ulT[P256_WORDS] = (uint32_t) ullProduct;
+		ulT[P256_WORDS + 1] = (uint32_t)(ullProduct >> 32);
+
+		//T = (T + q * m) / 2^32, q chosen so that the low word is 0
+		ulQuotient = ulT[0] * pxModulus->ulInverse;
+		ullProduct = (uint64_t) ulQuotient * pxModulus->ulValue[0] + ulT[0];
+		ullProduct >>= 32;
+		for(j = 1; j < P256_WORDS; j++)
+		{
+			ullProduct += (uint64_t) ulQuotient * pxModulus->ulValue[j] + ulT[j];
+			ulT[j - 1] = (uint32_t) ullProduct;
+			ullProduct >>= 32;
+		}
+		ullProduct += ulT[P256_WORDS];
+		ulT[P256_WORDS - 1] = (uint32_t) ullProduct;
+		ulT[P256_WORDS] = ulT[P256_WORDS + 1] + (uint32_t)(ullProduct >> 32);
+	}
+
+	//T < 2m
+	if( (ulT[P256_WORDS] != 0) || (prvCompare(ulT, pxModulus->ulValue) >= 0) )
+	{
+		prvSub(ulT, ulT, pxModulus->ulValue);
+	}
+
+	memcpy(pulResult, ulT, P256_WORDS * sizeof(uint32_t));
+}
+
+static void prvToMont(uint32_t *pulResult, const uint32_t *pulA, const Modulus_t *pxModulus)
+{
+	prvMontMul(pulResult, pulA, pxModulus->ulR2, pxModulus);
+}
+
+static void prvFromMont(uint32_t *pulResult, const uint32_t *pulA, const Modulus_t *pxModulus)
+{
+	uint32_t ulOne[P256_WORDS] = { 1, 0, 0, 0, 0, 0, 0, 0 };
+
+	prvMontMul(pulResult, pulA, ulOne, pxModulus);
+}
+
+//a^-1 = a^(m - 2) mod m, in the Montgomery form
+static void prvModInverse(uint32_t *pulResult, const uint32_t *pulA, const Modulus_t *pxModulus)
+{
+	uint32_t ulExponent[P256_WORDS] = { 2, 0, 0, 0, 0, 0, 0, 0 };
+	uint32_t ulPower[P256_WORDS];
+	uint32_t ulOne[P256_WORDS] = { 1, 0, 0, 0, 0, 0, 0, 0 };
+	int16_t i;
+
+	prvSub(ulExponent, pxModulus->ulValue, ulExponent);
+	prvToMont(ulPower, ulOne, pxModulus);
+
+	for(i = 255; i >= 0; i--)
+	{
+		prvMontMul(ulPower, ulPower, ulPower, pxModulus);
+
+		if( ((ulExponent[i / 32] >> (i % 32)) & 0x01) != 0 )
+		{
+			prvMontMul(ulPower, ulPower, pulA, pxModulus);
+		}
+	}
+
+	memcpy(pulResult, ulPower, sizeof(ulPower));
+}
+
+//2P with a = -3 (dbl-2001-b). The result can be the point.
+static void prvPointDouble(JacobianPoint_t *pxResult, const JacobianPoint_t *pxPoint)
+{
+	uint32_t ulDelta[P256_WORDS], ulGamma[P256_WORDS], ulBeta[P256_WORDS], ulAlpha[P256_WORDS], ulTemp[P256_WORDS];
+
+	if( (prvIsZero(pxPoint->ulZ) != 0) || (prvIsZero(pxPoint->ulY) != 0) )
+	{
+		memset(pxResult, 0, sizeof(JacobianPoint_t));
+		return;
+	}
+
+	prvMontMul(ulDelta, pxPoint->ulZ, pxPoint->ulZ, &xPrime);
+	prvMontMul(ulGamma, pxPoint->ulY, pxPoint->ulY, &xPrime);
+	prvMontMul(ulBeta, pxPoint->ulX, ulGamma, &xPrime);
+
+	//alpha = 3 * (X - delta) * (X + delta)
+	prvModSub(ulTemp, pxPoint->ulX, ulDelta, &xPrime);
+	prvModAdd(ulAlpha, pxPoint->ulX, ulDelta, &xPrime);
+	prvMontMul(ulTemp, ulTemp, ulAlpha, &xPrime);
+	prvModAdd(ulAlpha, ulTemp, ulTemp, &xPrime);
+	prvModAdd(ulAlpha, ulAlpha, ulTemp, &xPrime);
+
+	//Z3 = (Y + Z)^2 - gamma - delta
+	prvModAdd(ulTemp, pxPoint->ulY, pxPoint->ulZ, &xPrime);
+	prvMontMul(ulTemp, ulTemp, ulTemp, &xPrime);
+	prvModSub(ulTemp, ulTemp, ulGamma, &xPrime);
+	prvModSub(pxResult->ulZ, ulTemp, ulDelta, &xPrime);
+
+	//X3 = alpha^2 - 8 * beta
+	prvModAdd(ulBeta, ulBeta, ulBeta, &xPrime);
+	prvModAdd(ulBeta, ulBeta, ulBeta, &xPrime);			//4 * beta
+	prvMontMul(ulTemp, ulAlpha, ulAlpha, &xPrime);
+	prvModSub(ulTemp, ulTemp, ulBeta, &xPrime);
+	prvModSub(pxResult->ulX, ulTemp, ulBeta, &xPrime);
+
+	//Y3 = alpha * (4 * beta - X3) - 8 * gamma^2
+	prvModSub(ulBeta, ulBeta, pxResult->ulX, &xPrime);
+	prvMontMul(ulBeta, ulAlpha, ulBeta, &xPrime);
+	prvMontMul(ulGamma, ulGamma, ulGamma, &xPrime);
+	prvModAdd(ulGamma, ulGamma, ulGamma, &xPrime);
+	prvModAdd(ulGamma, ulGamma, ulGamma, &xPrime);
+	prvModAdd(ulGamma, ulGamma, ulGamma, &xPrime);
+	prvModSub(pxResult->ulY, ulBeta, ulGamma, &xPrime);
+}
+
+//P + Q (add-2007-bl), with the special cases. The result can be one of the points.
+static void prvPointAdd(JacobianPoint_t *pxResult, const JacobianPoint_t *pxP, const JacobianPoint_t *pxQ)
+{
+	uint32_t ulZ1Z1[P256_WORDS], ulZ2Z2[P256_WORDS], ulU1[P256_WORDS], ulS1[P256_WORDS];
+	uint32_t ulH[P256_WORDS], ulI[P256_WORDS], ulJ[P256_WORDS], ulRr[P256_WORDS], ulTemp[P256_WORDS];
+
+	if(prvIsZero(pxP->ulZ) != 0)
+	{
+		memcpy(pxResult, pxQ, sizeof(JacobianPoint_t));
+		return;
+	}
+	if(prvIsZero(pxQ->ulZ) != 0)
+	{
+		memcpy(pxResult, pxP, sizeof(JacobianPoint_t));
+		return;
+	}
+
+	prvMontMul(ulZ1Z1, pxP->ulZ, pxP->ulZ, &xPrime);
+	prvMontMul(ulZ2Z2, pxQ->ulZ, pxQ->ulZ, &xPrime);
+
+	//U1 = X1 * Z2Z2, H = X2 * Z1Z1 - U1
+	prvMontMul(ulU1, pxP->ulX, ulZ2Z2, &xPrime);
+	prvMontMul(ulH, pxQ->ulX, ulZ1Z1, &xPrime);
+	prvModSub(ulH, ulH, ulU1, &xPrime);
+
+	//S1 = Y1 * Z2 * Z2Z2, r = 2 * (Y2 * Z1 * Z1Z1 - S1)
+	prvMontMul(ulS1, pxP->ulY, pxQ->ulZ, &xPrime);
+	prvMontMul(ulS1, ulS1, ulZ2Z2, &xPrime);
+	prvMontMul(ulRr, pxQ->ulY, pxP->ulZ, &xPrime);
+	prvMontMul(ulRr, ulRr, ulZ1Z1, &xPrime);
+	prvModSub(ulRr, ulRr, ulS1, &xPrime);
+
+	//Same x: P = Q (doubling) or P = -Q (infinity)
+	if(prvIsZero(ulH) != 0)
+	{
+		if(prvIsZero(ulRr) != 0)
+		{
+			prvPointDouble(pxResult, pxP);
+		}
+		else
+		{
+			memset(pxResult, 0, sizeof(JacobianPoint_t));
+		}
+		return;
+	}
+
+	prvModAdd(ulRr, ulRr, ulRr, &xPrime);
+
+	//Z3 = ((Z1 + Z2)^2 - Z1Z1 - Z2Z2) * H, before the points are overwritten
+	prvModAdd(ulTemp, pxP->ulZ, pxQ->ulZ, &xPrime);
+	prvMontMul(ulTemp, ulTemp, ulTemp, &xPrime);
+	prvModSub(ulTemp, ulTemp, ulZ1Z1, &xPrime);
+	prvModSub(ulTemp, ulTemp, ulZ2Z2, &xPrime);
+	prvMontMul(pxResult->ulZ, ulTemp, ulH, &xPrime);
+
+	//I = (2 * H)^2, J = H * I, V = U1 * I (in ulU1)
+	prvModAdd(ulI, ulH, ulH, &xPrime);
+	prvMontMul(ulI, ulI, ulI, &xPrime);
+	prvMontMul(ulJ, ulH, ulI, &xPrime);
+	prvMontMul(ulU1, ulU1, ulI, &xPrime);
+
+	//X3 = r^2 - J - 2 * V
+	prvMontMul(ulTemp, ulRr, ulRr, &xPrime);
+	prvModSub(ulTemp, ulTemp, ulJ, &xPrime);
+	prvModSub(ulTemp, ulTemp, ulU1, &xPrime);
+	prvModSub(pxResult->ulX, ulTemp, ulU1, &xPrime);
+
+	//Y3 = r * (V - X3) - 2 * S1 * J
+	prvModSub(ulTemp, ulU1, pxResult->ulX, &xPrime);
+	prvMontMul(ulTemp, ulRr, ulTemp, &xPrime);
+	prvMontMul(ulS1, ulS1, ulJ, &xPrime);
+	prvModAdd(ulS1, ulS1, ulS1, &xPrime);
+	prvModSub(pxResult->ulY, ulTemp, ulS1, &xPrime);
+}
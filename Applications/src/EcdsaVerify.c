@@ -0,0 +1,323 @@
+/*
+ * EcdsaVerify.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * The HAL copies the inputs of a job in the PKA RAM and starts the PKA (HAL_PKA_ECDSAVerif_IT()). The PKA then
+ * computes the verification alone, and raises its interrupt at the end. The interrupt reads the result,
+ * wakes up the task of the job and starts the next job of the list, so the PKA is not idle between two jobs
+ * and no task has to be scheduled to keep it busy.
+ *
+ * The list of jobs is shared by the tasks and the PKA interrupt: the tasks change it in a critical section
+ * (the PKA interrupt is masked by it, see ECDSA_VERIFY_IRQ_PRIORITY).
+ *
+ * The range of r, s and of the public key coordinates is checked by the CPU before the job is given
+ * to the PKA or to the software verification, so both reject the same inputs.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stm32wbxx.h"
+#include "stm32wbxx_hal.h"
+#include "string.h"
+#include "EcdsaVerify.h"
+
+//Timeout of the HAL polling function (ms)
+#define ECDSA_VERIFY_TIMEOUT			100
+
+//Self test: RFC 6979 A.2.5 (P-256, SHA-256, message "sample")
+static const uint8_t ucTestPublicKey[2 * ECDSA_P256_SIZE] =
+{
+	0x60, 0xfe, 0xd4, 0xba, 0x25, 0x5a, 0x9d, 0x31, 0xc9, 0x61, 0xeb, 0x74, 0xc6, 0x35, 0x6d, 0x68,
+	0xc0, 0x49, 0xb8, 0x92, 0x3b, 0x61, 0xfa, 0x6c, 0xe6, 0x69, 0x62, 0x2e, 0x60, 0xf2, 0x9f, 0xb6,
+	0x79, 0x03, 0xfe, 0x10, 0x08, 0xb8, 0xbc, 0x99, 0xa4, 0x1a, 0xe9, 0xe9, 0x56, 0x28, 0xbc, 0x64,
+	0xf2, 0xf1, 0xb2, 0x0c, 0x2d, 0x7e, 0x9f, 0x51, 0x77, 0xa3, 0xc2, 0x94, 0xd4, 0x46, 0x22, 0x99
+};
+static const uint8_t ucTestHash[ECDSA_P256_SIZE] =
+{
+	0xaf, 0x2b, 0xdb, 0xe1, 0xaa, 0x9b, 0x6e, 0xc1, 0xe2, 0xad, 0xe1, 0xd6, 0x94, 0xf4, 0x1f, 0xc7,
+	0x1a, 0x83, 0x1d, 0x02, 0x68, 0xe9, 0x89, 0x15, 0x62, 0x11, 0x3d, 0x8a, 0x62, 0xad, 0xd1, 0xbf
+};
+static const uint8_t ucTestSignature[2 * ECDSA_P256_SIZE] =
+{
+	0xef, 0xd4, 0x8b, 0x2a, 0xac, 0xb6, 0xa8, 0xfd, 0x11, 0x40, 0xdd, 0x9c, 0xd4, 0x5e, 0x81, 0xd6,
+	0x9d, 0x2c, 0x87, 0x7b, 0x56, 0xaa, 0xf9, 0x91, 0xc3, 0x4d, 0x0e, 0xa8, 0x4e, 0xaf, 0x37, 0x16,
+	0xf7, 0xcb, 0x1c, 0x94, 0x2d, 0x65, 0x7c, 0x41, 0xd4, 0x36, 0xc7, 0xa1, 0xb6, 0xe2, 0x9f, 0x65,
+	0xf3, 0xe9, 0x00, 0xdb, 0xb9, 0xaf, 0xf4, 0x06, 0x4d, 0xc4, 0xab, 0x2f, 0x84, 0x3a, 0xcd, 0xa8
+};
+
+//|a| of the curve (a = -3), big endian
+static const uint8_t ucP256Coef[ECDSA_P256_SIZE] =
+{
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03
+};
+
+static PKA_HandleTypeDef PkaHandle;
+static BaseType_t xHardwareReady = pdFALSE;
+static BaseType_t xUseHardware = pdTRUE;
+
+//Job running on the PKA, and the list of the jobs waiting for it
+static EcdsaJob_t *pxCurrentJob = NULL;
+static EcdsaJob_t *pxFirstJob = NULL;
+static EcdsaJob_t *pxLastJob = NULL;
+static uint32_t ulStartCycle = 0;
+static volatile uint8_t ucPkaError = 0;
+
+//Private helper functions
+static void prvSetInput(PKA_ECDSAVerifInTypeDef *pxInput, const uint8_t *pucPublicKey, const uint8_t *pucHash, const uint8_t *pucSignature);
+static void prvStartJob(EcdsaJob_t *pxJob);
+static void prvJobDone(uint8_t ucValid, uint8_t ucError);
+static BaseType_t prvUseHardware(void);
+
+
+BaseType_t xEcdsaVerifyInit(void)
+{
+#if ( ECDSA_VERIFY_USE_HARDWARE == 1 )
+	PKA_ECDSAVerifInTypeDef xInput;
+	uint8_t ucHash[ECDSA_P256_SIZE];
+
+	//1. PKA, with the interrupts of the end of the operation and of the errors (enabled by the HAL at each start)
+	PkaHandle.Instance = PKA;
+	if(HAL_PKA_Init(&PkaHandle) != HAL_OK)
+	{
+		return pdFAIL;
+	}
+
+	NVIC_SetPriority(PKA_IRQn, ECDSA_VERIFY_IRQ_PRIORITY); //Priority should be less than or equal to configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY
+	NVIC_EnableIRQ(PKA_IRQn);
+
+	//2. The PKA has to accept the test vector and reject it with a changed hash, or it is not used
+	prvSetInput(&xInput, ucTestPublicKey, ucTestHash, ucTestSignature);
+	if( (HAL_PKA_ECDSAVerif(&PkaHandle, &xInput, ECDSA_VERIFY_TIMEOUT) != HAL_OK) ||
+		(HAL_PKA_ECDSAVerif_IsValidSignature(&PkaHandle) != 1) )
+	{
+		return pdFAIL;
+	}
+
+	memcpy(ucHash, ucTestHash, sizeof(ucHash));
+	ucHash[ECDSA_P256_SIZE - 1] ^= 0x01;
+	prvSetInput(&xInput, ucTestPublicKey, ucHash, ucTestSignature);
+	if( (HAL_PKA_ECDSAVerif(&PkaHandle, &xInput, ECDSA_VERIFY_TIMEOUT) != HAL_OK) ||
+		(HAL_PKA_ECDSAVerif_IsValidSignature(&PkaHandle) != 0) )
+	{
+		return pdFAIL;
+	}
+
+	xHardwareReady = pdTRUE;
+	return pdPASS;
+#else
+	return pdFAIL;
+#endif
+}
+
+void vEcdsaVerifyUseHardware(BaseType_t xUseHardwareParam)
+{
+	xUseHardware = xUseHardwareParam;
+}
+
+BaseType_t xEcdsaVerifyIsHardware(void)
+{
+	return prvUseHardware();
+}
+
+void vEcdsaVerifySubmit(EcdsaJob_t *pxJob)
+{
+	uint32_t ulStart;
+
+	pxJob->xTask = xTaskGetCurrentTaskHandle();
+	pxJob->pxNext = NULL;
+	pxJob->ulCycles = 0;
+	pxJob->ucError = 0;
+	pxJob->ucValid = 0;
+	pxJob->ucDone = 0;
+
+	//1. Inputs out of range: rejected without computation
+	if(ucEcdsaSoftCheckInputs(pxJob->pucPublicKey, pxJob->pucSignature) == 0)
+	{
+		pxJob->ucDone = 1;
+		return;
+	}
+
+	//2. Software: the job is done by the calling task
+	if(prvUseHardware() == pdFALSE)
+	{
+		ulStart = DWT->CYCCNT;
+		pxJob->ucValid = ucEcdsaSoftVerify(pxJob->pucPublicKey, pxJob->pucHash, pxJob->pucSignature);
+		pxJob->ulCycles = DWT->CYCCNT - ulStart;
+		pxJob->ucDone = 1;
+		return;
+	}
+
+	//3. PKA: started now if it is idle, else at the end of the last job of the list
+	taskENTER_CRITICAL();
+	if(pxCurrentJob == NULL)
+	{
+		prvStartJob(pxJob);
+	}
+	else
+	{
+		if(pxLastJob == NULL)
+		{
+			pxFirstJob = pxJob;
+		}
+		else
+		{
+			pxLastJob->pxNext = pxJob;
+		}
+		pxLastJob = pxJob;
+	}
+	taskEXIT_CRITICAL();
+}
+
+BaseType_t xEcdsaVerifyWait(EcdsaJob_t *pxJob, TickType_t xTicksToWait)
+{
+	TimeOut_t xTimeOut;
+
+	//The notifications of the other jobs of the task wake it up too: the timeout is for the whole wait
+	vTaskSetTimeOutState(&xTimeOut);
+	while(pxJob->ucDone == 0)
+	{
+		if(xTaskCheckForTimeOut(&xTimeOut, &xTicksToWait) == pdTRUE)
+		{
+			return pdFAIL;
+		}
+		ulTaskNotifyTakeIndexed(ECDSA_VERIFY_NOTIFY_INDEX, pdTRUE, xTicksToWait);
+	}
+
+	//The PKA could not finish the job: same job in software
+	if(pxJob->ucError != 0)
+	{
+		pxJob->ucValid = ucEcdsaSoftVerify(pxJob->pucPublicKey, pxJob->pucHash, pxJob->pucSignature);
+		pxJob->ucError = 0;
+	}
+
+	return pdPASS;
+}
+
+uint8_t ucEcdsaVerify(const uint8_t *pucPublicKey, const uint8_t *pucHash, const uint8_t *pucSignature)
+{
+	EcdsaJob_t xJob;
+
+	xJob.pucPublicKey = pucPublicKey;
+	xJob.pucHash = pucHash;
+	xJob.pucSignature = pucSignature;
+
+	vEcdsaVerifySubmit(&xJob);
+	xEcdsaVerifyWait(&xJob, portMAX_DELAY);
+
+	return xJob.ucValid;
+}
+
+
+void PKA_IRQHandler(void)
+{
+	HAL_PKA_IRQHandler(&PkaHandle);
+
+	//Error without the end of the operation: the PKA is stopped
+	if( (ucPkaError != 0) && (pxCurrentJob != NULL) )
+	{
+		HAL_PKA_Abort(&PkaHandle);
+		prvJobDone(0, 1);
+	}
+}
+
+//Called by HAL_PKA_Init()
+void HAL_PKA_MspInit(PKA_HandleTypeDef *hpka)
+{
+	__HAL_RCC_PKA_CLK_ENABLE();
+}
+
+//Called from the PKA interrupt at the end of the operation
+void HAL_PKA_OperationCpltCallback(PKA_HandleTypeDef *hpka)
+{
+	if(pxCurrentJob != NULL)
+	{
+		prvJobDone((uint8_t) HAL_PKA_ECDSAVerif_IsValidSignature(hpka), ucPkaError);
+	}
+}
+
+//Called from the PKA interrupt on an address or RAM error, before HAL_PKA_OperationCpltCallback()
+void HAL_PKA_ErrorCallback(PKA_HandleTypeDef *hpka)
+{
+	ucPkaError = 1;
+}
+
+
+static void prvSetInput(PKA_ECDSAVerifInTypeDef *pxInput, const uint8_t *pucPublicKey, const uint8_t *pucHash, const uint8_t *pucSignature)
+{
+	pxInput->primeOrderSize = ECDSA_P256_SIZE;
+	pxInput->modulusSize = ECDSA_P256_SIZE;
+	pxInput->coefSign = 1;								//a is negative
+	pxInput->coef = ucP256Coef;
+	pxInput->modulus = ucP256Prime;
+	pxInput->basePointX = ucP256Gx;
+	pxInput->basePointY = ucP256Gy;
+	pxInput->primeOrder = ucP256Order;
+	pxInput->pPubKeyCurvePtX = pucPublicKey;
+	pxInput->pPubKeyCurvePtY = &pucPublicKey[ECDSA_P256_SIZE];
+	pxInput->RSign = pucSignature;
+	pxInput->SSign = &pucSignature[ECDSA_P256_SIZE];
+	pxInput->hash = pucHash;
+}
+
+//Called in a critical section or from the PKA interrupt, when the PKA is idle
+static void prvStartJob(EcdsaJob_t *pxJob)
+{
+	PKA_ECDSAVerifInTypeDef xInput;
+
+	pxCurrentJob = pxJob;
+	ucPkaError = 0;
+
+	prvSetInput(&xInput, pxJob->pucPublicKey, pxJob->pucHash, pxJob->pucSignature);
+	ulStartCycle = DWT->CYCCNT;
+
+	if(HAL_PKA_ECDSAVerif_IT(&PkaHandle, &xInput) != HAL_OK)
+	{
+		//Not started: done by the task in software
+		pxCurrentJob = NULL;
+		pxJob->ucError = 1;
+		pxJob->ucDone = 1;
+	}
+}
+
+//Called from the PKA interrupt: ends the current job and starts the next one
+static void prvJobDone(uint8_t ucValid, uint8_t ucError)
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	EcdsaJob_t *pxJob = pxCurrentJob;
+
+	pxJob->ulCycles = DWT->CYCCNT - ulStartCycle;
+	pxJob->ucValid = ucValid;
+	pxJob->ucError = ucError;
+	pxJob->ucDone = 1;
+	pxCurrentJob = NULL;
+	vTaskNotifyGiveIndexedFromISR(pxJob->xTask, ECDSA_VERIFY_NOTIFY_INDEX, &xHigherPriorityTaskWoken);
+
+	//The jobs which cannot be started are done: the next one is tried
+	while( (pxCurrentJob == NULL) && (pxFirstJob != NULL) )
+	{
+		pxJob = pxFirstJob;
+		pxFirstJob = pxJob->pxNext;
+		if(pxFirstJob == NULL)
+		{
+			pxLastJob = NULL;
+		}
+
+		prvStartJob(pxJob);
+		if(pxCurrentJob == NULL)
+		{
+			vTaskNotifyGiveIndexedFromISR(pxJob->xTask, ECDSA_VERIFY_NOTIFY_INDEX, &xHigherPriorityTaskWoken);
+		}
+	}
+
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+static BaseType_t prvUseHardware(void)
+{
+	return ( (xHardwareReady == pdTRUE) && (xUseHardware == pdTRUE) ) ? pdTRUE : pdFALSE;
+}
@@ -0,0 +1,344 @@
+/*
+ * EcdsaVerifyExample.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * This application checks signed messages (e.g. firmware update manifests) with the ECDSA verification
+ * service (EcdsaVerify.c).
+ *
+ * The Test task first checks both paths (PKA and software P-256) with the test vectors of RFC 6979 A.2.5
+ * (messages "sample" and "test"), a changed hash, a changed signature and a signature out of range.
+ * Then it measures the verifications per second of both paths (DWT cycle counter). The PKA jobs are all
+ * submitted at once, and the Test task is blocked until the last one is done: meanwhile the Counter task
+ * (lower priority) runs, which shows that the CPU is free during the PKA jobs. With the software path the
+ * Test task uses the CPU and the Counter task does not run.
+ * At the end, the Verifier task checks one message per second, alternately with a valid and a changed hash.
+ *
+ * The CPU runs at 32 MHz (MSI range 10), like UsbCdcConsole.c.
+ * EcdsaSoft.c and EcdsaVerify.c have to be included in the build with this file,
+ * and HAL_PKA_MODULE_ENABLED in stm32wbxx_hal_conf.h.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stm32wbxx.h"
+#include "stm32wbxx_nucleo.h"
+#include "stdio.h"
+#include "string.h"
+#include "EcdsaVerify.h"
+
+//Number of verifications of the benchmark
+#define BENCHMARK_HARDWARE_JOBS		8
+#define BENCHMARK_SOFTWARE_JOBS		2
+
+//Task handles and functions
+TaskHandle_t xTestTask = NULL;
+TaskHandle_t xCounterTask = NULL;
+TaskHandle_t xVerifierTask = NULL;
+void vTestTaskFunction(void *params);
+void vCounterTaskFunction(void *params);
+void vVerifierTaskFunction(void *params);
+
+//UART Handle and Init types
+UART_HandleTypeDef Uart1;
+UART_InitTypeDef Uart1Init;
+GPIO_InitTypeDef GpioUARTpins;
+
+//RFC 6979 A.2.5: public key, and the SHA-256 hash and the signature of the messages "sample" and "test"
+static const uint8_t ucPublicKey[2 * ECDSA_P256_SIZE] =
+{
+	0x60, 0xfe, 0xd4, 0xba, 0x25, 0x5a, 0x9d, 0x31, 0xc9, 0x61, 0xeb, 0x74, 0xc6, 0x35, 0x6d, 0x68,
+	0xc0, 0x49, 0xb8, 0x92, 0x3b, 0x61, 0xfa, 0x6c, 0xe6, 0x69, 0x62, 0x2e, 0x60, 0xf2, 0x9f, 0xb6,
+	0x79, 0x03, 0xfe, 0x10, 0x08, 0xb8, 0xbc, 0x99, 0xa4, 0x1a, 0xe9, 0xe9, 0x56, 0x28, 0xbc, 0x64,
+	0xf2, 0xf1, 0xb2, 0x0c, 0x2d, 0x7e, 0x9f, 0x51, 0x77, 0xa3, 0xc2, 0x94, 0xd4, 0x46, 0x22, 0x99
+};
+static const uint8_t ucSampleHash[ECDSA_P256_SIZE] =
+{
+	0xaf, 0x2b, 0xdb, 0xe1, 0xaa, 0x9b, 0x6e, 0xc1, 0xe2, 0xad, 0xe1, 0xd6, 0x94, 0xf4, 0x1f, 0xc7,
+	0x1a, 0x83, 0x1d, 0x02, 0x68, 0xe9, 0x89, 0x15, 0x62, 0x11, 0x3d, 0x8a, 0x62, 0xad, 0xd1, 0xbf
+};
+static const uint8_t ucSampleSignature[2 * ECDSA_P256_SIZE] =
+{
+	0xef, 0xd4, 0x8b, 0x2a, 0xac, 0xb6, 0xa8, 0xfd, 0x11, 0x40, 0xdd, 0x9c, 0xd4, 0x5e, 0x81, 0xd6,
+	0x9d, 0x2c, 0x87, 0x7b, 0x56, 0xaa, 0xf9, 0x91, 0xc3, 0x4d, 0x0e, 0xa8, 0x4e, 0xaf, 0x37, 0x16,
+	0xf7, 0xcb, 0x1c, 0x94, 0x2d, 0x65, 0x7c, 0x41, 0xd4, 0x36, 0xc7, 0xa1, 0xb6, 0xe2, 0x9f, 0x65,
+	0xf3, 0xe9, 0x00, 0xdb, 0xb9, 0xaf, 0xf4, 0x06, 0x4d, 0xc4, 0xab, 0x2f, 0x84, 0x3a, 0xcd, 0xa8
+};
+static const uint8_t ucTestHash[ECDSA_P256_SIZE] =
+{
+	0x9f, 0x86, 0xd0, 0x81, 0x88, 0x4c, 0x7d, 0x65, 0x9a, 0x2f, 0xea, 0xa0, 0xc5, 0x5a, 0xd0, 0x15,
+	0xa3, 0xbf, 0x4f, 0x1b, 0x2b, 0x0b, 0x82, 0x2c, 0xd1, 0x5d, 0x6c, 0x15, 0xb0, 0xf0, 0x0a, 0x08
+};
+static const uint8_t ucTestSignature[2 * ECDSA_P256_SIZE] =
+{
+	0xf1, 0xab, 0xb0, 0x23, 0x51, 0x83, 0x51, 0xcd, 0x71, 0xd8, 0x81, 0x56, 0x7b, 0x1e, 0xa6, 0x63,
+	0xed, 0x3e, 0xfc, 0xf6, 0xc5, 0x13, 0x2b, 0x35, 0x4f, 0x28, 0xd3, 0xb0, 0xb7, 0xd3, 0x83, 0x67,
+	0x01, 0x9f, 0x41, 0x13, 0x74, 0x2a, 0x2b, 0x14, 0xbd, 0x25, 0x92, 0x6b, 0x49, 0xc6, 0x49, 0x15,
+	0x5f, 0x26, 0x7e, 0x60, 0xd3, 0x81, 0x4b, 0x4c, 0x0c, 0xc8, 0x42, 0x50, 0xe4, 0x6f, 0x00, 0x83
+};
+
+//Incremented by the Counter task when the CPU is free
+static volatile uint32_t ulFreeCount = 0;
+
+//Private helper functions and variables
+static void prvSetupClock(void);
+static void prvSetupUART(void);
+static void prvCheckVectors(void);
+static void prvBenchmark(const char *pcName, uint32_t ulJobs);
+static void prvPrintResult(const char *pcName, BaseType_t xPass);
+void printmsg(char *msg);
+char UsrMsg[250];
+
+
+int main()
+{
+	// Enable the DWT Cycle Count Register (SEGGER Settings)
+	DWT->CTRL |= (1 << 0);
+
+	// Private functions called to setup the Hardware. The clock first: the UART baud rate depends on it.
+	prvSetupClock();
+	prvSetupUART();
+
+	//Start Recording for SEGGER SystemView
+	SEGGER_SYSVIEW_Conf();
+	SEGGER_SYSVIEW_Start();
+
+	sprintf(UsrMsg,"Example of ECDSA P-256 signature verification with the PKA \r\n");
+	printmsg(UsrMsg);
+
+	//The service works without the PKA too (software verification)
+	if(xEcdsaVerifyInit() == pdPASS)
+	{
+		sprintf(UsrMsg, "PKA ready (self test passed) \r\n");
+	}
+	else
+	{
+		sprintf(UsrMsg, "PKA not available, software verification only \r\n");
+	}
+	printmsg(UsrMsg);
+
+	//Create Test Task. It creates the Verifier task when the tests and the benchmark are done.
+	xTaskCreate(vTestTaskFunction, "Test-Task", 512, NULL, 2, &xTestTask);
+	xTaskCreate(vCounterTaskFunction, "Counter-Task", 128, NULL, 1, &xCounterTask);
+
+	//Schedule the tasks
+	vTaskStartScheduler();
+
+	/*
+	 * If scheduler can start the tasks and run them, the program will never reach here.
+	 * If the program comes to the below line, that means there was a problem while creating or scheduling the tasks
+	 */
+	for(;;);
+}
+
+
+void vTestTaskFunction(void *params)
+{
+	BaseType_t xHardware = xEcdsaVerifyIsHardware();
+
+	//1. Test vectors with both paths
+	if(xHardware == pdTRUE)
+	{
+		printmsg("\r\nTest vectors, PKA: \r\n");
+		prvCheckVectors();
+		vEcdsaVerifyUseHardware(pdFALSE);
+	}
+
+	printmsg("\r\nTest vectors, software: \r\n");
+	prvCheckVectors();
+
+	//2. Verifications per second of both paths
+	printmsg("\r\nVerifications per second: \r\n");
+	if(xHardware == pdTRUE)
+	{
+		vEcdsaVerifyUseHardware(pdTRUE);
+		prvBenchmark("PKA", BENCHMARK_HARDWARE_JOBS);
+		vEcdsaVerifyUseHardware(pdFALSE);
+	}
+	prvBenchmark("Software", BENCHMARK_SOFTWARE_JOBS);
+	vEcdsaVerifyUseHardware(xHardware);
+
+	//The Counter task never blocks: it is deleted so that the idle task runs again
+	vTaskDelete(xCounterTask);
+
+	//3. Periodic verification
+	xTaskCreate(vVerifierTaskFunction, "Verifier-Task", 384, NULL, 2, &xVerifierTask);
+
+	vTaskDelete(NULL);
+}
+
+
+void vCounterTaskFunction(void *params)
+{
+	while(1)
+	{
+		ulFreeCount++;
+		taskYIELD();
+	}
+}
+
+
+void vVerifierTaskFunction(void *params)
+{
+	uint8_t ucHash[ECDSA_P256_SIZE];
+	uint32_t ulMessage = 0;
+	uint8_t ucValid;
+
+	while(1)
+	{
+		//Every other message is changed on its way: its signature does not match
+		memcpy(ucHash, ucSampleHash, sizeof(ucHash));
+		if((ulMessage & 0x01) != 0)
+		{
+			ucHash[0] ^= 0x80;
+		}
+
+		ucValid = ucEcdsaVerify(ucPublicKey, ucHash, ucSampleSignature);
+
+		sprintf(UsrMsg, "Message %lu (%s): signature %s \r\n", ulMessage++,
+				(xEcdsaVerifyIsHardware() == pdTRUE) ? "PKA" : "software", (ucValid != 0) ? "valid" : "INVALID");
+		printmsg(UsrMsg);
+		vTaskDelay(pdMS_TO_TICKS(1000));
+	}
+}
+
+
+//The test vectors with the current path
+static void prvCheckVectors(void)
+{
+	uint8_t ucHash[ECDSA_P256_SIZE];
+	uint8_t ucSignature[2 * ECDSA_P256_SIZE];
+
+	prvPrintResult("RFC 6979 A.2.5 \"sample\"", ucEcdsaVerify(ucPublicKey, ucSampleHash, ucSampleSignature) == 1);
+	prvPrintResult("RFC 6979 A.2.5 \"test\"", ucEcdsaVerify(ucPublicKey, ucTestHash, ucTestSignature) == 1);
+
+	//One bit changed in the hash, then in s: rejected
+	memcpy(ucHash, ucSampleHash, sizeof(ucHash));
+	ucHash[ECDSA_P256_SIZE - 1] ^= 0x01;
+	prvPrintResult("Changed hash rejected", ucEcdsaVerify(ucPublicKey, ucHash, ucSampleSignature) == 0);
+
+	memcpy(ucSignature, ucSampleSignature, sizeof(ucSignature));
+	ucSignature[ECDSA_P256_SIZE + 5] ^= 0x10;
+	prvPrintResult("Changed signature rejected", ucEcdsaVerify(ucPublicKey, ucSampleHash, ucSignature) == 0);
+
+	//r = n: out of range, rejected before the computation
+	memcpy(ucSignature, ucP256Order, ECDSA_P256_SIZE);
+	prvPrintResult("Signature out of range rejected", ucEcdsaVerify(ucPublicKey, ucSampleHash, ucSignature) == 0);
+}
+
+//Submits the jobs at once, waits for all of them and prints the verifications per second
+static void prvBenchmark(const char *pcName, uint32_t ulJobs)
+{
+	EcdsaJob_t xJobs[BENCHMARK_HARDWARE_JOBS];
+	uint32_t ulCycles, ulFree, ulRate, ulJobCycles = 0;
+	uint8_t ucValid = 1;
+	uint32_t i;
+
+	ulFree = ulFreeCount;
+	ulCycles = DWT->CYCCNT;
+
+	for(i = 0; i < ulJobs; i++)
+	{
+		xJobs[i].pucPublicKey = ucPublicKey;
+		xJobs[i].pucHash = ((i & 0x01) == 0) ? ucSampleHash : ucTestHash;
+		xJobs[i].pucSignature = ((i & 0x01) == 0) ? ucSampleSignature : ucTestSignature;
+		vEcdsaVerifySubmit(&xJobs[i]);
+	}
+
+	for(i = 0; i < ulJobs; i++)
+	{
+		xEcdsaVerifyWait(&xJobs[i], portMAX_DELAY);
+		ucValid &= xJobs[i].ucValid;
+		ulJobCycles += xJobs[i].ulCycles;
+	}
+
+	ulCycles = DWT->CYCCNT - ulCycles;
+	ulFree = ulFreeCount - ulFree;
+
+	//Verifications per second with 2 decimals: jobs / (cycles / f) * 100
+	ulRate = (uint32_t)(((uint64_t) ulJobs * SystemCoreClock * 100) / ulCycles);
+
+	sprintf(UsrMsg, "  %-10s %lu jobs %s: %10lu cycles (%9lu per job) %3lu.%02lu per second, Counter task +%lu \r\n",
+			pcName, ulJobs, (ucValid != 0) ? "valid" : "ERROR", ulCycles, ulJobCycles / ulJobs, ulRate / 100, ulRate % 100, ulFree);
+	printmsg(UsrMsg);
+}
+
+static void prvPrintResult(const char *pcName, BaseType_t xPass)
+{
+	sprintf(UsrMsg, "  %-40s %s \r\n", pcName, (xPass != pdFALSE) ? "PASS" : "FAIL");
+	printmsg(UsrMsg);
+}
+
+
+static void prvSetupClock(void)
+{
+	//MSI 4 MHz -> 32 MHz, which needs 1 flash wait state. The PKA runs at HCLK.
+	__HAL_FLASH_SET_LATENCY(FLASH_LATENCY_1);
+	while(__HAL_FLASH_GET_LATENCY() != FLASH_LATENCY_1);
+
+	__HAL_RCC_MSI_RANGE_CONFIG(RCC_MSIRANGE_10);
+	while(__HAL_RCC_GET_FLAG(RCC_FLAG_MSIRDY) == 0);
+
+	//SystemCoreClock is used by the kernel tick, SystemView, the UART baud rate and the benchmark
+	SystemCoreClockUpdate();
+}
+
+static void prvSetupUART(void)
+{
+	//1. Enable the UART1 and GPIOB Peripheral Clocks
+	__HAL_RCC_USART1_CLK_ENABLE();
+	__HAL_RCC_GPIOB_CLK_ENABLE();
+
+	//In UART connection with Virtual COM-port, PB6->TX and PB7->RX
+	//2. Alternate Functionality Configuration to make Port B pins work as UART pins
+
+	//Zeroing each and every member element of the structure.
+	memset(&GpioUARTpins, 0, sizeof(GpioUARTpins));
+	GpioUARTpins.Pin = GPIO_PIN_6 | GPIO_PIN_7;
+	GpioUARTpins.Mode = GPIO_MODE_AF_PP;
+	GpioUARTpins.Alternate = GPIO_AF7_USART1;
+	GpioUARTpins.Pull = GPIO_PULLUP;
+
+	HAL_GPIO_Init(GPIOB, &GpioUARTpins);
+
+	//3. Configure and initialize UART parameters
+
+	//Zeroing each and every member element of the structure.
+	memset(&Uart1Init, 0, sizeof(Uart1Init));
+	memset(&Uart1, 0, sizeof(Uart1));
+
+	//UART Initialization
+	Uart1Init.BaudRate = 115200;
+	Uart1Init.WordLength = UART_WORDLENGTH_8B;
+	Uart1Init.HwFlowCtl = UART_HWCONTROL_NONE;
+	Uart1Init.Mode = UART_MODE_TX_RX;
+	Uart1Init.Parity = UART_PARITY_NONE;
+	Uart1Init.StopBits = UART_STOPBITS_1;
+
+	Uart1.Init = Uart1Init;
+	Uart1.Instance = USART1;
+
+	//4. Initialize the UART peripheral
+	uint16_t UARTSetUpResult = HAL_UART_Init(&Uart1);
+
+	if(UARTSetUpResult == HAL_ERROR)
+	{
+		//printf("USART Initialization was not successful \n");
+	}
+
+}
+
+void printmsg(char *msg)
+{
+	HAL_UART_Transmit(&Uart1, (uint8_t *)msg, strlen(msg), 1);
+}
+
+//Implement the Idle Hook function
+void vApplicationIdleHook()
+{
+	//Send the CPU to normal sleep mode
+	__WFI();
+}
@@ -0,0 +1,229 @@
+/*
+ * EventLatch.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * The interrupt stamps every latched event with the DWT cycle counter and its sequence number.
+ * The handler task takes the events in order, so the event it takes is always the next sequence
+ * number; the matching stamp gives the signal-to-handler latency. When the stamp ring is full
+ * the event is still latched, only its latency sample is skipped.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "stm32wbxx.h"
+#include "EventLatch.h"
+
+#define STAMP_MASK		( EVENT_LATCH_STAMP_SLOTS - 1UL )
+
+//Private helper functions
+static BaseType_t prvTakeFromFallback(EventLatch_t *pxLatch, TickType_t xTicksToWait);
+static void prvRecordLatency(EventLatch_t *pxLatch, uint32_t ulNow);
+
+
+BaseType_t xEventLatchInit(EventLatch_t *pxLatch, EventLatchMode_t eMode, UBaseType_t uxMaxCount, TaskHandle_t xHandlerTask)
+{
+	configASSERT( xHandlerTask != NULL );
+
+	pxLatch->eMode = eMode;
+	pxLatch->xHandlerTask = xHandlerTask;
+	pxLatch->xSemaphore = NULL;
+	pxLatch->ulStampHead = 0;
+	pxLatch->ulStampTail = 0;
+	pxLatch->ulLatched = 0;
+	pxLatch->ulTaken = 0;
+	vEventLatchResetStats(pxLatch);
+
+	if(eMode != EVENT_LATCH_NOTIFY)
+	{
+		pxLatch->xSemaphore = xSemaphoreCreateCounting(uxMaxCount, 0);
+		if(pxLatch->xSemaphore == NULL)
+		{
+			return pdFAIL;
+		}
+	}
+
+	return pdPASS;
+}
+
+BaseType_t xEventLatchSignalFromISR(EventLatch_t *pxLatch, BaseType_t *pxHigherPriorityTaskWoken)
+{
+	uint32_t ulNow = DWT->CYCCNT;
+	uint32_t ulHead;
+
+	pxLatch->xStats.ulSignalled++;
+
+	switch(pxLatch->eMode)
+	{
+		case EVENT_LATCH_SEMAPHORE:
+			if(xSemaphoreGiveFromISR(pxLatch->xSemaphore, pxHigherPriorityTaskWoken) != pdPASS)
+			{
+				//Semaphore is full: the handler task is behind and this event is lost
+				pxLatch->xStats.ulLost++;
+				return pdFAIL;
+			}
+			break;
+
+		case EVENT_LATCH_SEMAPHORE_FALLBACK:
+			if(xSemaphoreGiveFromISR(pxLatch->xSemaphore, pxHigherPriorityTaskWoken) != pdPASS)
+			{
+				//Keep the event in the notification value of the handler task instead of losing it
+				vTaskNotifyGiveFromISR(pxLatch->xHandlerTask, pxHigherPriorityTaskWoken);
+				pxLatch->xStats.ulAccumulated++;
+			}
+			break;
+
+		case EVENT_LATCH_NOTIFY:
+		default:
+			vTaskNotifyGiveFromISR(pxLatch->xHandlerTask, pxHigherPriorityTaskWoken);
+			break;
+	}
+
+	/*
+	 * The handler task cannot run before this ISR returns, so the stamp can be written
+	 * after the event has been given.
+	 */
+	ulHead = pxLatch->ulStampHead;
+	if( (ulHead - pxLatch->ulStampTail) < EVENT_LATCH_STAMP_SLOTS )
+	{
+		pxLatch->xStamps[ulHead & STAMP_MASK].ulSequence = pxLatch->ulLatched;
+		pxLatch->xStamps[ulHead & STAMP_MASK].ulTimestamp = ulNow;
+		pxLatch->ulStampHead = ulHead + 1;
+	}
+	pxLatch->ulLatched++;
+
+	return pdPASS;
+}
+
+BaseType_t xEventLatchWait(EventLatch_t *pxLatch, TickType_t xTicksToWait)
+{
+	BaseType_t xResult;
+
+	switch(pxLatch->eMode)
+	{
+		case EVENT_LATCH_SEMAPHORE:
+			xResult = xSemaphoreTake(pxLatch->xSemaphore, xTicksToWait);
+			break;
+
+		case EVENT_LATCH_SEMAPHORE_FALLBACK:
+			xResult = prvTakeFromFallback(pxLatch, xTicksToWait);
+			break;
+
+		case EVENT_LATCH_NOTIFY:
+		default:
+			//Take only one event: the notification value is decremented, not cleared
+			xResult = (ulTaskNotifyTake(pdFALSE, xTicksToWait) != 0) ? pdTRUE : pdFALSE;
+			break;
+	}
+
+	if(xResult == pdTRUE)
+	{
+		prvRecordLatency(pxLatch, DWT->CYCCNT);
+	}
+
+	return xResult;
+}
+
+uint32_t ulEventLatchPending(EventLatch_t *pxLatch)
+{
+	return pxLatch->ulLatched - pxLatch->ulTaken;
+}
+
+void vEventLatchGetStats(EventLatch_t *pxLatch, EventLatchStats_t *pxStats)
+{
+	taskENTER_CRITICAL();
+	*pxStats = *(EventLatchStats_t *) &pxLatch->xStats;
+	taskEXIT_CRITICAL();
+}
+
+void vEventLatchResetStats(EventLatch_t *pxLatch)
+{
+	taskENTER_CRITICAL();
+	pxLatch->xStats.ulSignalled = 0;
+	pxLatch->xStats.ulHandled = 0;
+	pxLatch->xStats.ulLost = 0;
+	pxLatch->xStats.ulAccumulated = 0;
+	pxLatch->xStats.ulUnstamped = 0;
+	pxLatch->xStats.ulMinLatency = 0xFFFFFFFFUL;
+	pxLatch->xStats.ulMaxLatency = 0;
+	pxLatch->xStats.ullTotalLatency = 0;
+	pxLatch->xStats.ulLatencySamples = 0;
+	taskEXIT_CRITICAL();
+}
+
+
+static BaseType_t prvTakeFromFallback(EventLatch_t *pxLatch, TickType_t xTicksToWait)
+{
+	//Events in the semaphore first, then the ones which overflowed into the notification value
+	if(xSemaphoreTake(pxLatch->xSemaphore, 0) == pdTRUE)
+	{
+		return pdTRUE;
+	}
+
+	if(ulTaskNotifyTake(pdFALSE, 0) != 0)
+	{
+		return pdTRUE;
+	}
+
+	/*
+	 * Nothing is latched. Events can only overflow into the notification value when the
+	 * semaphore is full, and that wakes this task up, so blocking on the semaphore is enough.
+	 */
+	return xSemaphoreTake(pxLatch->xSemaphore, xTicksToWait);
+}
+
+static void prvRecordLatency(EventLatch_t *pxLatch, uint32_t ulNow)
+{
+	volatile EventLatchStats_t *pxStats = &pxLatch->xStats;
+	EventLatchStamp_t *pxStamp;
+	uint32_t ulSequence, ulLatency = 0;
+	BaseType_t xStamped = pdFALSE;
+
+	taskENTER_CRITICAL();
+	ulSequence = pxLatch->ulTaken++;
+	pxStats->ulHandled++;
+
+	//Skip the stamps of older events, if any
+	while(pxLatch->ulStampTail != pxLatch->ulStampHead)
+	{
+		pxStamp = &pxLatch->xStamps[pxLatch->ulStampTail & STAMP_MASK];
+
+		if( (int32_t)(pxStamp->ulSequence - ulSequence) > 0 )
+		{
+			//The stamp belongs to a later event, this one was not stamped
+			break;
+		}
+
+		pxLatch->ulStampTail++;
+
+		if(pxStamp->ulSequence == ulSequence)
+		{
+			ulLatency = ulNow - pxStamp->ulTimestamp;
+			xStamped = pdTRUE;
+			break;
+		}
+	}
+
+	if(xStamped == pdFALSE)
+	{
+		pxStats->ulUnstamped++;
+	}
+	else
+	{
+		pxStats->ulLatencySamples++;
+		pxStats->ullTotalLatency += ulLatency;
+		if(ulLatency < pxStats->ulMinLatency)
+		{
+			pxStats->ulMinLatency = ulLatency;
+		}
+		if(ulLatency > pxStats->ulMaxLatency)
+		{
+			pxStats->ulMaxLatency = ulLatency;
+		}
+	}
+	taskEXIT_CRITICAL();
+}
@@ -0,0 +1,324 @@
+/*
+ * EventLatchExample.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * Event latching benchmark and loss detector.
+ *
+ * TIM2 is used as a load generator: its update interrupt signals an event to the handler task
+ * through the event latch (EventLatch.c). The handler task spends a fixed amount of CPU cycles
+ * on every event. The interrupt rate is swept upwards for the three latch modes:
+ *  - Counting semaphore (max count 10, like the CountingSemaphore example)
+ *  - Counting semaphore with fallback to the notification value
+ *  - Notification value only
+ * For every rate it prints the lost/accumulated events and the signal-to-handler latency,
+ * and finally the saturation point, i.e. the first rate where events are lost (semaphore)
+ * or the backlog keeps growing (fallback and notification modes).
+ *
+ * EventLatch.c has to be included in the build with this file.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stm32wbxx.h"
+#include "stm32wbxx_nucleo.h"
+#include "stm32wbxx_ll_bus.h"
+#include "stm32wbxx_ll_tim.h"
+#include "stdio.h"
+#include "string.h"
+#include "semphr.h"
+#include "EventLatch.h"
+
+//Macros
+#define TRUE 			1
+#define FALSE 			0
+
+#define SEMAPHORE_MAX_COUNT		10
+#define HANDLER_WORK_CYCLES		2000		//CPU cycles spent by the handler task on every event
+#define RUN_TIME_MS				1000
+#define DRAIN_TIMEOUT_MS		5000
+
+//Task handles and functions
+TaskHandle_t xHandlerTask = NULL;
+TaskHandle_t xLoadTask = NULL;
+void vHandlerTaskFunction(void *params);
+void vLoadTaskFunction(void *params);
+
+//Event latches (one per mode) and the one used by the running test
+EventLatch_t xLatches[3];
+EventLatch_t * volatile pxActiveLatch = NULL;
+const char * const pcModeNames[3] = { "Semaphore", "Fallback", "Notify" };
+
+/*
+ * Interrupt rates of the sweep (events per second). At 4MHz the top rate leaves 800 cycles between
+ * two interrupts; higher rates would starve the tick interrupt (lowest priority) completely.
+ */
+const uint32_t ulRates[] = { 100, 200, 500, 1000, 1500, 2000, 3000, 4000, 5000 };
+
+//UART Handle and Init types
+UART_HandleTypeDef Uart1;
+UART_InitTypeDef Uart1Init;
+GPIO_InitTypeDef GpioUARTpins;
+
+//Private helper functions and variables
+static void prvSetupUART(void);
+static void prvSetupLoadTimer(void);
+static void prvStartLoad(uint32_t ulRate);
+static void prvStopLoad(void);
+static BaseType_t prvRunTest(EventLatch_t *pxLatch, uint8_t ucMode, uint32_t ulRate);
+void printmsg(char *msg);
+char UsrMsg[250];
+
+int main()
+{
+	// Enable the DWT Cycle Count Register (SEGGER Settings)
+	DWT->CTRL |= (1 << 0);
+
+	// Private function called to setup the Hardware
+	prvSetupUART();
+	prvSetupLoadTimer();
+
+	//Start Recording for SEGGER SystemView
+	SEGGER_SYSVIEW_Conf();
+	SEGGER_SYSVIEW_Start();
+
+	sprintf(UsrMsg,"Event latching benchmark: counting semaphore vs notification value \r\n");
+	printmsg(UsrMsg);
+
+	//Create Handler Task. It processes the events.
+	xTaskCreate(vHandlerTaskFunction, "Handler-Task", configMINIMAL_STACK_SIZE, NULL, 2, &xHandlerTask);
+
+	//Create Load Task. It drives the interrupt rate sweep and prints the results.
+	xTaskCreate(vLoadTaskFunction, "Load-Task", 512, NULL, 3, &xLoadTask);
+
+	if( (xHandlerTask != NULL) && (xLoadTask != NULL)
+		&& (xEventLatchInit(&xLatches[0], EVENT_LATCH_SEMAPHORE, SEMAPHORE_MAX_COUNT, xHandlerTask) == pdPASS)
+		&& (xEventLatchInit(&xLatches[1], EVENT_LATCH_SEMAPHORE_FALLBACK, SEMAPHORE_MAX_COUNT, xHandlerTask) == pdPASS)
+		&& (xEventLatchInit(&xLatches[2], EVENT_LATCH_NOTIFY, 0, xHandlerTask) == pdPASS) )
+	{
+		//Schedule the tasks
+		vTaskStartScheduler();
+	}
+	else
+	{
+		sprintf(UsrMsg, "Task or event latch creation failed... :( \r\n");
+		printmsg(UsrMsg);
+	}
+
+	/*
+	 * If scheduler can start the tasks and run them, the program will never reach here.
+	 * If the program comes to the below line, that means there was a problem while creating or scheduling the tasks
+	 */
+	for(;;);
+}
+
+
+void vHandlerTaskFunction(void *params)
+{
+	EventLatch_t *pxLatch;
+	uint32_t ulStart;
+
+	while(1)
+	{
+		pxLatch = pxActiveLatch;
+
+		if(pxLatch == NULL)
+		{
+			vTaskDelay(pdMS_TO_TICKS(10));
+			continue;
+		}
+
+		//Wait with a timeout, so that the next test (other latch) is picked up
+		if(xEventLatchWait(pxLatch, pdMS_TO_TICKS(10)) == pdTRUE)
+		{
+			//Simulate the event processing
+			ulStart = DWT->CYCCNT;
+			while( (DWT->CYCCNT - ulStart) < HANDLER_WORK_CYCLES );
+		}
+	}
+}
+
+
+void vLoadTaskFunction(void *params)
+{
+	uint32_t ulSaturation;
+	uint8_t ucMode, i;
+
+	sprintf(UsrMsg, "Handler work: %d cycles per event, CPU clock %lu Hz \r\n", HANDLER_WORK_CYCLES, SystemCoreClock);
+	printmsg(UsrMsg);
+
+	for(ucMode = 0; ucMode < 3; ucMode++)
+	{
+		ulSaturation = 0;
+
+		sprintf(UsrMsg, "\r\n--- %s mode --- \r\n", pcModeNames[ucMode]);
+		printmsg(UsrMsg);
+
+		for(i = 0; i < (sizeof(ulRates) / sizeof(ulRates[0])); i++)
+		{
+			if( (prvRunTest(&xLatches[ucMode], ucMode, ulRates[i]) != pdPASS) && (ulSaturation == 0) )
+			{
+				ulSaturation = ulRates[i];
+			}
+		}
+
+		if(ulSaturation != 0)
+		{
+			sprintf(UsrMsg, "%s mode saturates at %lu events/s \r\n", pcModeNames[ucMode], ulSaturation);
+		}
+		else
+		{
+			sprintf(UsrMsg, "%s mode keeps up with all the rates \r\n", pcModeNames[ucMode]);
+		}
+		printmsg(UsrMsg);
+	}
+
+	vTaskDelete(NULL);
+}
+
+
+static BaseType_t prvRunTest(EventLatch_t *pxLatch, uint8_t ucMode, uint32_t ulRate)
+{
+	EventLatchStats_t xStats;
+	uint32_t ulBacklog, ulAvgLatency = 0, ulCyclesPerUs;
+	TickType_t xDrainStart;
+
+	vEventLatchResetStats(pxLatch);
+	pxActiveLatch = pxLatch;
+
+	prvStartLoad(ulRate);
+	vTaskDelay(pdMS_TO_TICKS(RUN_TIME_MS));
+	prvStopLoad();
+
+	//Backlog when the load stops. If it is bigger than the semaphore, the handler did not keep up.
+	ulBacklog = ulEventLatchPending(pxLatch);
+
+	//Let the handler task process the remaining events before the next test
+	xDrainStart = xTaskGetTickCount();
+	while( (ulEventLatchPending(pxLatch) != 0) && ( (xTaskGetTickCount() - xDrainStart) < pdMS_TO_TICKS(DRAIN_TIMEOUT_MS) ) )
+	{
+		vTaskDelay(pdMS_TO_TICKS(10));
+	}
+
+	vEventLatchGetStats(pxLatch, &xStats);
+
+	ulCyclesPerUs = SystemCoreClock / 1000000UL;
+	if(xStats.ulLatencySamples != 0)
+	{
+		ulAvgLatency = (uint32_t)(xStats.ullTotalLatency / xStats.ulLatencySamples) / ulCyclesPerUs;
+	}
+
+	sprintf(UsrMsg, "%6lu ev/s: signalled %6lu handled %6lu lost %5lu accumulated %5lu backlog %5lu latency avg %6lu us max %6lu us \r\n",
+			ulRate, xStats.ulSignalled, xStats.ulHandled, xStats.ulLost, xStats.ulAccumulated, ulBacklog,
+			ulAvgLatency, (xStats.ulLatencySamples != 0) ? (xStats.ulMaxLatency / ulCyclesPerUs) : 0);
+	printmsg(UsrMsg);
+
+	return ( (xStats.ulLost == 0) && (ulBacklog <= SEMAPHORE_MAX_COUNT) ) ? pdPASS : pdFAIL;
+}
+
+
+void TIM2_IRQHandler(void)
+{
+	portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+	if(LL_TIM_IsActiveFlag_UPDATE(TIM2))
+	{
+		LL_TIM_ClearFlag_UPDATE(TIM2);
+
+		if(pxActiveLatch != NULL)
+		{
+			//The return value is not ignored any more: losses are counted by the latch
+			xEventLatchSignalFromISR(pxActiveLatch, &xHigherPriorityTaskWoken);
+		}
+	}
+
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+
+static void prvSetupLoadTimer(void)
+{
+	//TIM2 is clocked from APB1 (no prescaler after reset, so at SystemCoreClock)
+	LL_APB1_GRP1_EnableClock(LL_APB1_GRP1_PERIPH_TIM2);
+
+	LL_TIM_DisableCounter(TIM2);
+	LL_TIM_SetPrescaler(TIM2, 0);
+	LL_TIM_EnableIT_UPDATE(TIM2);
+
+	//The ISR uses FreeRTOS API, so the priority must not be above configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY
+	NVIC_SetPriority(TIM2_IRQn, configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY);
+	NVIC_EnableIRQ(TIM2_IRQn);
+}
+
+static void prvStartLoad(uint32_t ulRate)
+{
+	LL_TIM_SetAutoReload(TIM2, (SystemCoreClock / ulRate) - 1);
+	LL_TIM_SetCounter(TIM2, 0);
+	LL_TIM_EnableCounter(TIM2);
+}
+
+static void prvStopLoad(void)
+{
+	LL_TIM_DisableCounter(TIM2);
+}
+
+
+static void prvSetupUART(void)
+{
+	//1. Enable the UART1 and GPIOB Peripheral Clocks
+	__HAL_RCC_USART1_CLK_ENABLE();
+	__HAL_RCC_GPIOB_CLK_ENABLE();
+
+	//In UART connection with Virtual COM-port, PB6->TX and PB7->RX
+	//2. Alternate Functionality Configuration to make Port B pins work as UART pins
+
+	//Zeroing each and every member element of the structure.
+	memset(&GpioUARTpins, 0, sizeof(GpioUARTpins));
+	GpioUARTpins.Pin = GPIO_PIN_6 | GPIO_PIN_7;
+	GpioUARTpins.Mode = GPIO_MODE_AF_PP;
+	GpioUARTpins.Alternate = GPIO_AF7_USART1;
+	GpioUARTpins.Pull = GPIO_PULLUP;
+
+	HAL_GPIO_Init(GPIOB, &GpioUARTpins);
+
+	//3. Configure and initialize UART parameters
+
+	//Zeroing each and every member element of the structure.
+	memset(&Uart1Init, 0, sizeof(Uart1Init));
+	memset(&Uart1, 0, sizeof(Uart1));
+
+	//UART Initialization
+	Uart1Init.BaudRate = 115200;
+	Uart1Init.WordLength = UART_WORDLENGTH_8B;
+	Uart1Init.HwFlowCtl = UART_HWCONTROL_NONE;
+	Uart1Init.Mode = UART_MODE_TX_RX;
+	Uart1Init.Parity = UART_PARITY_NONE;
+	Uart1Init.StopBits = UART_STOPBITS_1;
+
+	Uart1.Init = Uart1Init;
+	Uart1.Instance = USART1;
+
+	//4. Initialize the UART peripheral
+	uint16_t UARTSetUpResult = HAL_UART_Init(&Uart1);
+
+	if(UARTSetUpResult == HAL_ERROR)
+	{
+		//printf("USART Initialization was not successful \n");
+	}
+
+}
+
+void printmsg(char *msg)
+{
+	HAL_UART_Transmit(&Uart1, (uint8_t *)msg, strlen(msg), 1);
+}
+
+//Implement the Idle Hook function
+void vApplicationIdleHook()
+{
+	//Send the CPU to normal sleep mode
+	__WFI();
+}
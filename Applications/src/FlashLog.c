@@ -0,0 +1,774 @@
+/*
+ * FlashLog.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * Page: | header (2 double words) | record | record | ... | erased |
+ *   header: magic and sequence number of the page, CRC-32 of the first double word.
+ *   The newest page has the highest sequence number. A page without valid header is free.
+ * Record (double word aligned, the flash is programmed by double words):
+ *   | length (2) | type (1) | RECORD_MARKER (1) | CRC-32 (4) | data, padded with 0xFF | commit (8) |
+ *   The CRC covers the 4 first bytes and the data. The commit double word is programmed last.
+ *
+ * Power cut: a page erase which did not end leaves a page without valid header, which is erased again
+ * before use. A record which was not fully programmed has no commit: its header gives its size, so the
+ * next records are found after it. A header which is not valid (cut during its programming) closes the page.
+ *
+ * A double word cut during its programming can also be left with an ECC double error: a read of it sets
+ * ECCD and raises the NMI. The pages are only read by prvReadFlash(), which sees the error recorded by
+ * NMI_Handler() and returns pdFAIL: the double word is then handled like a damaged one (free page not erased,
+ * header which closes the page, missing commit). The data of a record is only read after its commit.
+ *
+ * The index (sequence number, used size and records of each page) is shared by the writer task and the
+ * readers: it is changed in critical sections. The pages are read in place: a reader checks after the
+ * copy that the page was not erased meanwhile.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "stm32wbxx.h"
+#include "stm32wbxx_hal.h"
+#include "string.h"
+#include "Crc32.h"
+#include "FlashLog.h"
+
+#define PAGE_SIZE					FLASH_PAGE_SIZE
+#define PAGE_HEADER_SIZE			16
+#define PAGE_MAGIC					0x474F4C46UL			//"FLOG"
+#define NO_PAGE						FLASH_LOG_PAGES
+
+#define RECORD_MARKER				0xA5
+#define RECORD_COMMIT				0x3CC35AA5C33CA55AULL
+#define ERASED_DOUBLE_WORD			0xFFFFFFFFFFFFFFFFULL
+
+//Bytes of the data of a record read (and checked with the CRC) at a time
+#define READ_CHUNK_SIZE				32
+
+//Size in the flash of a record with ulLength bytes of data: header, data padded to a double word, commit
+#define RECORD_SIZE(ulLength)		(8 + (((ulLength) + 7) & ~7UL) + 8)
+
+//Queue entry: | length (2) | type (1) | unused (1) | data, padded to 4 bytes |
+#define QUEUE_MASK					(FLASH_LOG_QUEUE_SIZE - 1)
+#define QUEUE_ENTRY_SIZE(ulLength)	(4 + (((ulLength) + 3) & ~3UL))
+
+typedef struct PageIndex
+{
+	uint32_t ulSequence;				//0: no valid header (free page)
+	uint32_t ulUsed;					//Offset of the first erased double word
+	uint32_t ulRecords;					//Committed records
+	uint8_t ucErased;					//1: known to be erased (ready for a header)
+}PageIndex_t;
+
+//Index of the pages. Changed by the writer task in critical sections.
+static PageIndex_t xPages[FLASH_LOG_PAGES];
+static uint32_t ulHead = NO_PAGE;
+static uint32_t ulLastSequence = 0;
+
+//Queue of the records: entries from ulQueueTail to ulQueueHead
+static uint8_t ucQueue[FLASH_LOG_QUEUE_SIZE];
+static volatile uint32_t ulQueueHead = 0;
+static volatile uint32_t ulQueueTail = 0;
+
+//One task appends or flushes at a time. It waits for the writer task with xWaitingTask.
+static SemaphoreHandle_t xLogMutex = NULL;
+static TaskHandle_t xWaitingTask = NULL;
+static TaskHandle_t xWriterTask = NULL;
+
+//Record being programmed (double word aligned)
+static uint64_t ullRecord[RECORD_SIZE(FLASH_LOG_MAX_RECORD) / 8];
+
+//Power cut test: 1 + double words of the next record programmed before the torn one (0: no test)
+static volatile uint32_t ulCutAfter = 0;
+
+//Address of the double word of the last ECC double error in the log, set by NMI_Handler() (0: none)
+static volatile uint32_t ulEccAddress = 0;
+
+static FlashLogStats_t xStats;
+
+//Flash of the log in LinkerScript.ld (FLASH_LOG region, out of ROM)
+extern uint32_t _sflash_log;
+extern uint32_t _eflash_log;
+
+//Private helper functions
+static void prvWriterTask(void *params);
+static void prvScanPage(uint32_t ulPage);
+static BaseType_t prvReadFlash(uint32_t ulAddress, void *pvData, uint32_t ulLength);
+static BaseType_t prvOpenPage(void);
+static BaseType_t prvErasePage(uint32_t ulPage);
+static BaseType_t prvProgramRecord(uint32_t ulLength);
+static void prvTearDoubleWord(uint32_t ulAddress, uint64_t ullData);
+static uint32_t prvFindPage(uint32_t ulSequence);
+static uint32_t prvFindNextPage(uint32_t ulSequence);
+static uint32_t prvPageAddress(uint32_t ulPage);
+static void prvQueueCopy(uint32_t ulPosition, void *pvData, uint32_t ulLength);
+static void prvWakeWaitingTask(void);
+
+
+BaseType_t xFlashLogInit(void)
+{
+	uint32_t ulSecureStart;
+	uint32_t ulStart;
+	uint32_t ulPage;
+
+	//1. The pages must be in the FLASH_LOG region of the linker script, below the secure flash of CPU2 (SFSA: its first page)
+	ulSecureStart = FLASH_BASE + ((FLASH->SFR & FLASH_SFR_SFSA) * PAGE_SIZE);
+	if( (FLASH_LOG_START_ADDRESS < (uint32_t) &_sflash_log) || ((FLASH_LOG_START_ADDRESS % PAGE_SIZE) != 0) ||
+		((FLASH_LOG_START_ADDRESS + (FLASH_LOG_PAGES * PAGE_SIZE)) > (uint32_t) &_eflash_log) ||
+		((FLASH_LOG_START_ADDRESS + (FLASH_LOG_PAGES * PAGE_SIZE)) > ulSecureStart) )
+	{
+		return pdFAIL;
+	}
+
+	memset(&xStats, 0, sizeof(xStats));
+
+	//2. Index rebuild: headers of the pages and of the records
+	ulStart = DWT->CYCCNT;
+	for(ulPage = 0; ulPage < FLASH_LOG_PAGES; ulPage++)
+	{
+		prvScanPage(ulPage);
+		xStats.ulRecords += xPages[ulPage].ulRecords;
+		if(xPages[ulPage].ulSequence > ulLastSequence)
+		{
+			ulLastSequence = xPages[ulPage].ulSequence;
+			ulHead = ulPage;
+		}
+	}
+	xStats.ulRebuildCycles = DWT->CYCCNT - ulStart;
+
+	xLogMutex = xSemaphoreCreateMutex();
+	if(xLogMutex == NULL)
+	{
+		return pdFAIL;
+	}
+
+	if(xTaskCreate(prvWriterTask, "FlashLog-Task", FLASH_LOG_TASK_STACK, NULL, FLASH_LOG_TASK_PRIORITY, &xWriterTask) != pdPASS)
+	{
+		return pdFAIL;
+	}
+
+	return pdPASS;
+}
+
+
+BaseType_t xFlashLogAppend(uint8_t ucType, const void *pvData, size_t xLength, TickType_t xTicksToWait)
+{
+	TimeOut_t xTimeOut;
+	uint32_t ulEntrySize = QUEUE_ENTRY_SIZE(xLength);
+	uint32_t ulFree;
+	uint8_t ucHeader[4];
+	BaseType_t xQueued = pdFAIL;
+	const uint8_t *pucData = (const uint8_t *) pvData;
+	uint32_t i;
+
+	if(xLength > FLASH_LOG_MAX_RECORD)
+	{
+		return pdFAIL;
+	}
+
+	vTaskSetTimeOutState(&xTimeOut);
+
+	if(xSemaphoreTake(xLogMutex, xTicksToWait) != pdPASS)
+	{
+		taskENTER_CRITICAL();
+		xStats.ulDropped++;
+		taskEXIT_CRITICAL();
+		return pdFAIL;
+	}
+
+	while(1)
+	{
+		taskENTER_CRITICAL();
+		ulFree = FLASH_LOG_QUEUE_SIZE - (ulQueueHead - ulQueueTail);
+		if(ulFree < ulEntrySize)
+		{
+			xWaitingTask = xTaskGetCurrentTaskHandle();
+		}
+		taskEXIT_CRITICAL();
+
+		if(ulFree >= ulEntrySize)
+		{
+			break;
+		}
+
+		//Woken up by the writer task when it removes a record from the queue
+		if(xTaskCheckForTimeOut(&xTimeOut, &xTicksToWait) != pdFALSE)
+		{
+			break;
+		}
+		ulTaskNotifyTakeIndexed(FLASH_LOG_NOTIFY_INDEX, pdTRUE, xTicksToWait);
+	}
+
+	if(ulFree >= ulEntrySize)
+	{
+		//The writer task does not read the entry before ulQueueHead is moved
+		ucHeader[0] = (uint8_t) xLength;
+		ucHeader[1] = (uint8_t) (xLength >> 8);
+		ucHeader[2] = ucType;
+		ucHeader[3] = 0;
+		for(i = 0; i < 4; i++)
+		{
+			ucQueue[(ulQueueHead + i) & QUEUE_MASK] = ucHeader[i];
+		}
+		for(i = 0; i < xLength; i++)
+		{
+			ucQueue[(ulQueueHead + 4 + i) & QUEUE_MASK] = pucData[i];
+		}
+
+		taskENTER_CRITICAL();
+		ulQueueHead += ulEntrySize;
+		xStats.ulAppended++;
+		taskEXIT_CRITICAL();
+
+		xTaskNotifyGive(xWriterTask);
+		xQueued = pdPASS;
+	}
+	else
+	{
+		taskENTER_CRITICAL();
+		xStats.ulDropped++;
+		taskEXIT_CRITICAL();
+	}
+
+	xSemaphoreGive(xLogMutex);
+
+	return xQueued;
+}
+
+
+BaseType_t xFlashLogFlush(TickType_t xTicksToWait)
+{
+	TimeOut_t xTimeOut;
+	BaseType_t xEmpty = pdFALSE;
+
+	vTaskSetTimeOutState(&xTimeOut);
+
+	if(xSemaphoreTake(xLogMutex, xTicksToWait) != pdPASS)
+	{
+		return pdFAIL;
+	}
+
+	while(1)
+	{
+		taskENTER_CRITICAL();
+		xEmpty = (ulQueueHead == ulQueueTail) ? pdTRUE : pdFALSE;
+		if(xEmpty == pdFALSE)
+		{
+			xWaitingTask = xTaskGetCurrentTaskHandle();
+		}
+		taskEXIT_CRITICAL();
+
+		if( (xEmpty != pdFALSE) || (xTaskCheckForTimeOut(&xTimeOut, &xTicksToWait) != pdFALSE) )
+		{
+			break;
+		}
+		ulTaskNotifyTakeIndexed(FLASH_LOG_NOTIFY_INDEX, pdTRUE, xTicksToWait);
+	}
+
+	xSemaphoreGive(xLogMutex);
+
+	return (xEmpty != pdFALSE) ? pdPASS : pdFAIL;
+}
+
+
+void vFlashLogRewind(FlashLogCursor_t *pxCursor)
+{
+	pxCursor->ulSequence = 0;
+	pxCursor->ulOffset = 0;
+}
+
+
+BaseType_t xFlashLogReadNext(FlashLogCursor_t *pxCursor, uint8_t *pucType, void *pvBuffer, size_t xBufferSize, size_t *pxLength)
+{
+	uint8_t ucChunk[READ_CHUNK_SIZE];
+	uint32_t ulPage, ulUsed, ulAddress, ulLength, ulCrc, ulHeader, ulDone, ulChunk;
+	uint64_t ullHeader, ullCommit;
+	BaseType_t xErased, xRead;
+
+	while(1)
+	{
+		//1. Page of the cursor, or the next one when it is read to its end (or was erased)
+		taskENTER_CRITICAL();
+		ulPage = prvFindPage(pxCursor->ulSequence);
+		if( (ulPage == NO_PAGE) || (pxCursor->ulOffset >= xPages[ulPage].ulUsed) )
+		{
+			ulPage = prvFindNextPage(pxCursor->ulSequence);
+			if(ulPage != NO_PAGE)
+			{
+				pxCursor->ulSequence = xPages[ulPage].ulSequence;
+				pxCursor->ulOffset = PAGE_HEADER_SIZE;
+			}
+		}
+		ulUsed = (ulPage != NO_PAGE) ? xPages[ulPage].ulUsed : 0;
+		taskEXIT_CRITICAL();
+
+		if(ulPage == NO_PAGE)
+		{
+			return pdFAIL;
+		}
+		if(pxCursor->ulOffset >= ulUsed)
+		{
+			continue;
+		}
+
+		//2. Record in place. Below ulUsed its header is valid (checked by the scan or written by the writer task).
+		ulAddress = prvPageAddress(ulPage) + pxCursor->ulOffset;
+		xRead = prvReadFlash(ulAddress, &ullHeader, 8);
+		ulHeader = (uint32_t) ullHeader;
+		ulLength = ulHeader & 0xFFFF;
+		if( (xRead == pdFAIL) || (ulLength > FLASH_LOG_MAX_RECORD) )
+		{
+			//Not a header (the page was erased meanwhile, or an ECC double error): nothing more is read in this page
+			pxCursor->ulOffset = PAGE_SIZE;
+			continue;
+		}
+
+		//3. Commit, then the data of a committed record only: a record cut by a reset can hold a torn double word
+		ullCommit = 0;
+		xRead = prvReadFlash(ulAddress + RECORD_SIZE(ulLength) - 8, &ullCommit, 8);
+		*pucType = (uint8_t) (ulHeader >> 16);
+		*pxLength = (ulLength < xBufferSize) ? ulLength : xBufferSize;
+		ulCrc = ulCrc32Software(0, (const uint8_t *) &ulHeader, 4);
+		for(ulDone = 0; (xRead == pdPASS) && (ullCommit == RECORD_COMMIT) && (ulDone < ulLength); ulDone += ulChunk)
+		{
+			ulChunk = ((ulLength - ulDone) < READ_CHUNK_SIZE) ? (ulLength - ulDone) : READ_CHUNK_SIZE;
+			xRead = prvReadFlash(ulAddress + 8 + ulDone, ucChunk, ulChunk);
+			ulCrc = ulCrc32Software(ulCrc, ucChunk, ulChunk);
+			if(ulDone < *pxLength)
+			{
+				memcpy((uint8_t *) pvBuffer + ulDone, ucChunk, ((*pxLength - ulDone) < ulChunk) ? (*pxLength - ulDone) : ulChunk);
+			}
+		}
+
+		//4. The page may have been erased by the writer task during the copy: go on with the oldest page
+		taskENTER_CRITICAL();
+		xErased = (xPages[ulPage].ulSequence != pxCursor->ulSequence) ? pdTRUE : pdFALSE;
+		taskEXIT_CRITICAL();
+		if(xErased != pdFALSE)
+		{
+			continue;
+		}
+
+		pxCursor->ulOffset += RECORD_SIZE(ulLength);
+
+		//Record cut by a reset (commit missing or torn), or data with an ECC double error (counted by prvReadFlash())
+		if( (xRead == pdFAIL) || (ullCommit != RECORD_COMMIT) )
+		{
+			continue;
+		}
+
+		if(ulCrc != (uint32_t) (ullHeader >> 32))
+		{
+			taskENTER_CRITICAL();
+			xStats.ulCrcErrors++;
+			taskEXIT_CRITICAL();
+			continue;
+		}
+
+		return pdPASS;
+	}
+}
+
+
+void vFlashLogGetStats(FlashLogStats_t *pxStats)
+{
+	taskENTER_CRITICAL();
+	*pxStats = xStats;
+	taskEXIT_CRITICAL();
+}
+
+
+void vFlashLogInjectCut(uint32_t ulDoubleWords)
+{
+	ulCutAfter = ulDoubleWords + 1;
+}
+
+
+/*
+ * NMI. An ECC double error in the flash (ECCD) raises it: the read gets wrong data. In the pages of the log
+ * it is a double word torn by a power cut: the error is cleared and prvReadFlash() sees it. Any other NMI
+ * (clock security system, ECC double error in the code) stops here like the default handler.
+ */
+void NMI_Handler(void)
+{
+	uint32_t ulEccr = FLASH->ECCR;
+	uint32_t ulAddress = FLASH_BASE + ((ulEccr & FLASH_ECCR_ADDR_ECC) * 8);
+
+	if( ((ulEccr & FLASH_ECCR_ECCD) != 0) && ((ulEccr & FLASH_ECCR_SYSF_ECC) == 0) &&
+		(ulAddress >= FLASH_LOG_START_ADDRESS) && (ulAddress < (FLASH_LOG_START_ADDRESS + (FLASH_LOG_PAGES * PAGE_SIZE))) )
+	{
+		ulEccAddress = ulAddress;
+		__HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_ECCD);
+		return;
+	}
+
+	for( ;; );
+}
+
+
+static void prvWriterTask(void *params)
+{
+	uint8_t ucEntry[4];
+	uint32_t ulLength;
+	uint32_t ulHeader;
+	uint32_t ulSpare;
+
+	while(1)
+	{
+		//Woken up by the appends. The records queued meanwhile are written in the same batch.
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+		HAL_FLASH_Unlock();
+		__HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_ALL_ERRORS);
+
+		while(ulQueueHead != ulQueueTail)
+		{
+			//1. Next record of the queue, into the double word buffer
+			prvQueueCopy(ulQueueTail, ucEntry, 4);
+			ulLength = ucEntry[0] | (ucEntry[1] << 8);
+			ulHeader = ulLength | ((uint32_t) ucEntry[2] << 16) | ((uint32_t) RECORD_MARKER << 24);
+			ullRecord[0] = ulHeader;
+			memset(&ullRecord[1], 0xFF, RECORD_SIZE(ulLength) - 16);
+			prvQueueCopy(ulQueueTail + 4, &ullRecord[1], ulLength);
+
+			//2. New page when the record does not fit in the newest one
+			if( (ulHead == NO_PAGE) || ((xPages[ulHead].ulUsed + RECORD_SIZE(ulLength)) > PAGE_SIZE) )
+			{
+				if(prvOpenPage() != pdPASS)
+				{
+					taskENTER_CRITICAL();
+					xStats.ulWriteErrors++;
+					taskEXIT_CRITICAL();
+				}
+			}
+
+			//3. Program and commit. The record is dropped on a flash error.
+			if( (ulHead != NO_PAGE) && ((xPages[ulHead].ulUsed + RECORD_SIZE(ulLength)) <= PAGE_SIZE) )
+			{
+				if(prvProgramRecord(ulLength) != pdPASS)
+				{
+					taskENTER_CRITICAL();
+					xStats.ulWriteErrors++;
+					taskEXIT_CRITICAL();
+				}
+			}
+
+			taskENTER_CRITICAL();
+			ulQueueTail += QUEUE_ENTRY_SIZE(ulLength);
+			prvWakeWaitingTask();
+			taskEXIT_CRITICAL();
+		}
+
+		//4. Queue empty: the page after the newest one is erased now, so a new page only needs its header
+		ulSpare = (ulHead == NO_PAGE) ? 0 : ((ulHead + 1) % FLASH_LOG_PAGES);
+		if( (xPages[ulSpare].ucErased == 0) && (ulSpare != ulHead) )
+		{
+			prvErasePage(ulSpare);
+		}
+
+		HAL_FLASH_Lock();
+
+		//A flushing task checks the queue again
+		taskENTER_CRITICAL();
+		prvWakeWaitingTask();
+		taskEXIT_CRITICAL();
+	}
+}
+
+
+static void prvScanPage(uint32_t ulPage)
+{
+	uint32_t ulAddress = prvPageAddress(ulPage);
+	PageIndex_t *pxPage = &xPages[ulPage];
+	uint32_t ulOffset, ulLength, ulSize;
+	uint64_t ullPageHeader[2];
+	uint64_t ullHeader, ullCommit;
+
+	memset(pxPage, 0, sizeof(PageIndex_t));
+
+	//1. Header. A free page is used without erase only if it is fully erased (and has no ECC double error).
+	if( (prvReadFlash(ulAddress, ullPageHeader, sizeof(ullPageHeader)) != pdPASS) || ((uint32_t) ullPageHeader[0] != PAGE_MAGIC) ||
+		((uint32_t) ullPageHeader[1] != ulCrc32Software(0, (const uint8_t *) &ullPageHeader[0], 8)) || ((uint32_t) (ullPageHeader[0] >> 32) == 0) )
+	{
+		pxPage->ucErased = 1;
+		for(ulOffset = 0; ulOffset < PAGE_SIZE; ulOffset += 8)
+		{
+			if( (prvReadFlash(ulAddress + ulOffset, &ullHeader, 8) != pdPASS) || (ullHeader != ERASED_DOUBLE_WORD) )
+			{
+				pxPage->ucErased = 0;
+				break;
+			}
+		}
+		return;
+	}
+
+	//2. Records: header and commit of each one, until the first erased double word
+	pxPage->ulSequence = (uint32_t) (ullPageHeader[0] >> 32);
+	ulOffset = PAGE_HEADER_SIZE;
+	while((ulOffset + RECORD_SIZE(0)) <= PAGE_SIZE)
+	{
+		if(prvReadFlash(ulAddress + ulOffset, &ullHeader, 8) != pdPASS)
+		{
+			//Header torn (ECC double error): nothing more is written in this page
+			xStats.ulBadPages++;
+			ulOffset = PAGE_SIZE;
+			break;
+		}
+		if(ullHeader == ERASED_DOUBLE_WORD)
+		{
+			break;
+		}
+
+		ulLength = (uint32_t) ullHeader & 0xFFFF;
+		ulSize = RECORD_SIZE(ulLength);
+		if( ((((uint32_t) ullHeader) >> 24) != RECORD_MARKER) || (ulLength > FLASH_LOG_MAX_RECORD) || ((ulOffset + ulSize) > PAGE_SIZE) )
+		{
+			//Header cut during its programming: nothing more is written in this page
+			xStats.ulBadPages++;
+			ulOffset = PAGE_SIZE;
+			break;
+		}
+
+		//A torn commit (ECC double error) is a missing one
+		if( (prvReadFlash(ulAddress + ulOffset + ulSize - 8, &ullCommit, 8) == pdPASS) && (ullCommit == RECORD_COMMIT) )
+		{
+			pxPage->ulRecords++;
+		}
+		else
+		{
+			xStats.ulTornRecords++;
+		}
+		ulOffset += ulSize;
+	}
+	pxPage->ulUsed = ulOffset;
+}
+
+
+//Called by the writer task with the flash unlocked
+static BaseType_t prvOpenPage(void)
+{
+	uint32_t ulPage = (ulHead == NO_PAGE) ? 0 : ((ulHead + 1) % FLASH_LOG_PAGES);
+	uint64_t ullHeader;
+
+	if( (xPages[ulPage].ucErased == 0) && (prvErasePage(ulPage) != pdPASS) )
+	{
+		return pdFAIL;
+	}
+
+	ullHeader = PAGE_MAGIC | ((uint64_t) (ulLastSequence + 1) << 32);
+	if( (HAL_FLASH_Program(FLASH_TYPEPROGRAM_DOUBLEWORD, prvPageAddress(ulPage), ullHeader) != HAL_OK) ||
+		(HAL_FLASH_Program(FLASH_TYPEPROGRAM_DOUBLEWORD, prvPageAddress(ulPage) + 8, ulCrc32Software(0, (const uint8_t *) &ullHeader, 8)) != HAL_OK) )
+	{
+		//Not usable before a new erase
+		xPages[ulPage].ucErased = 0;
+		return pdFAIL;
+	}
+
+	taskENTER_CRITICAL();
+	ulLastSequence++;
+	xPages[ulPage].ulSequence = ulLastSequence;
+	xPages[ulPage].ulUsed = PAGE_HEADER_SIZE;
+	xPages[ulPage].ulRecords = 0;
+	xPages[ulPage].ucErased = 0;
+	ulHead = ulPage;
+	taskEXIT_CRITICAL();
+
+	return pdPASS;
+}
+
+
+//Called by the writer task with the flash unlocked
+static BaseType_t prvErasePage(uint32_t ulPage)
+{
+	FLASH_EraseInitTypeDef xErase;
+	uint32_t ulError = 0;
+
+	//The readers leave the page before it is erased
+	taskENTER_CRITICAL();
+	xStats.ulRecords -= xPages[ulPage].ulRecords;
+	xPages[ulPage].ulSequence = 0;
+	xPages[ulPage].ulUsed = 0;
+	xPages[ulPage].ulRecords = 0;
+	xPages[ulPage].ucErased = 0;
+	taskEXIT_CRITICAL();
+
+	xErase.TypeErase = FLASH_TYPEERASE_PAGES;
+	xErase.Page = (prvPageAddress(ulPage) - FLASH_BASE) / PAGE_SIZE;
+	xErase.NbPages = 1;
+	if(HAL_FLASHEx_Erase(&xErase, &ulError) != HAL_OK)
+	{
+		return pdFAIL;
+	}
+
+	taskENTER_CRITICAL();
+	xStats.ulErases++;
+	xPages[ulPage].ucErased = 1;
+	taskEXIT_CRITICAL();
+
+	return pdPASS;
+}
+
+
+//Programs the record of ullRecord in the newest page: header and data first, the commit last
+static BaseType_t prvProgramRecord(uint32_t ulLength)
+{
+	uint32_t ulAddress = prvPageAddress(ulHead) + xPages[ulHead].ulUsed;
+	uint32_t ulDoubleWords = RECORD_SIZE(ulLength) / 8;
+	uint32_t ulHeader = (uint32_t) ullRecord[0];
+	uint32_t ulCut = ulCutAfter;
+	BaseType_t xResult = pdPASS;
+	uint32_t i;
+
+	//The torn double word is at most the commit
+	if(ulCut > ulDoubleWords)
+	{
+		ulCut = ulDoubleWords;
+	}
+
+	ullRecord[0] |= (uint64_t) ulCrc32Software(ulCrc32Software(0, (const uint8_t *) &ulHeader, 4), (const uint8_t *) &ullRecord[1], ulLength) << 32;
+	ullRecord[ulDoubleWords - 1] = RECORD_COMMIT;
+
+	for(i = 0; i < ulDoubleWords; i++)
+	{
+		if( (ulCut != 0) && (i == (ulCut - 1)) )
+		{
+			//Power cut test: does not return
+			prvTearDoubleWord(ulAddress + (i * 8), ullRecord[i]);
+		}
+
+		if(HAL_FLASH_Program(FLASH_TYPEPROGRAM_DOUBLEWORD, ulAddress + (i * 8), ullRecord[i]) != HAL_OK)
+		{
+			xResult = pdFAIL;
+			break;
+		}
+	}
+
+	//The space is used even after an error: a damaged record is skipped by its CRC or its missing commit
+	taskENTER_CRITICAL();
+	xPages[ulHead].ulUsed += RECORD_SIZE(ulLength);
+	if(xResult == pdPASS)
+	{
+		xPages[ulHead].ulRecords++;
+		xStats.ulRecords++;
+		xStats.ulWritten++;
+	}
+	taskEXIT_CRITICAL();
+
+	return xResult;
+}
+
+
+/*
+ * Power cut test: starts the programming of the double word and resets the MCU while it runs (about 85 us),
+ * so the reset stops the programming like a power loss: the double word is left torn (wrong bits or an ECC
+ * double error). It runs from the RAM: the CPU would wait for the end of the programming to fetch the next
+ * instruction from the flash. The flash is unlocked and idle (writer task).
+ */
+static __RAM_FUNC void prvTearDoubleWord(uint32_t ulAddress, uint64_t ullData)
+{
+	__disable_irq();
+
+	//The programming starts when the second word is written
+	SET_BIT(FLASH->CR, FLASH_CR_PG);
+	*(volatile uint32_t *) ulAddress = (uint32_t) ullData;
+	__ISB();
+	*(volatile uint32_t *) (ulAddress + 4) = (uint32_t) (ullData >> 32);
+
+	NVIC_SystemReset();
+}
+
+
+/*
+ * Copies from the pages of the log. Returns pdFAIL if a double word read has an ECC double error (torn by a
+ * power cut): NMI_Handler() cleared it and recorded its address. One read is checked at a time (critical section,
+ * the NMI is not masked by it).
+ */
+static BaseType_t prvReadFlash(uint32_t ulAddress, void *pvData, uint32_t ulLength)
+{
+	BaseType_t xResult;
+
+	taskENTER_CRITICAL();
+	ulEccAddress = 0;
+	memcpy(pvData, (const void *) ulAddress, ulLength);
+
+	//The NMI of the last read is taken before the check
+	__DSB();
+	__ISB();
+	xResult = (ulEccAddress == 0) ? pdPASS : pdFAIL;
+	if(xResult == pdFAIL)
+	{
+		xStats.ulEccErrors++;
+	}
+	taskEXIT_CRITICAL();
+
+	return xResult;
+}
+
+
+//Called in a critical section
+static uint32_t prvFindPage(uint32_t ulSequence)
+{
+	uint32_t ulPage;
+
+	for(ulPage = 0; (ulSequence != 0) && (ulPage < FLASH_LOG_PAGES); ulPage++)
+	{
+		if(xPages[ulPage].ulSequence == ulSequence)
+		{
+			return ulPage;
+		}
+	}
+
+	return NO_PAGE;
+}
+
+
+//Page with the lowest sequence number above ulSequence. Called in a critical section.
+static uint32_t prvFindNextPage(uint32_t ulSequence)
+{
+	uint32_t ulPage;
+	uint32_t ulNext = NO_PAGE;
+
+	for(ulPage = 0; ulPage < FLASH_LOG_PAGES; ulPage++)
+	{
+		if( (xPages[ulPage].ulSequence > ulSequence) &&
+			((ulNext == NO_PAGE) || (xPages[ulPage].ulSequence < xPages[ulNext].ulSequence)) )
+		{
+			ulNext = ulPage;
+		}
+	}
+
+	return ulNext;
+}
+
+
+static uint32_t prvPageAddress(uint32_t ulPage)
+{
+	return FLASH_LOG_START_ADDRESS + (ulPage * PAGE_SIZE);
+}
+
+
+//Copies from the queue, which wraps around its end
+static void prvQueueCopy(uint32_t ulPosition, void *pvData, uint32_t ulLength)
+{
+	uint8_t *pucData = (uint8_t *) pvData;
+	uint32_t i;
+
+	for(i = 0; i < ulLength; i++)
+	{
+		pucData[i] = ucQueue[(ulPosition + i) & QUEUE_MASK];
+	}
+}
+
+
+//Called in a critical section
+static void prvWakeWaitingTask(void)
+{
+	if(xWaitingTask != NULL)
+	{
+		xTaskNotifyGiveIndexed(xWaitingTask, FLASH_LOG_NOTIFY_INDEX);
+		xWaitingTask = NULL;
+	}
+}
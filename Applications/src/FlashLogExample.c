@@ -0,0 +1,310 @@
+/*
+ * FlashLogExample.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * This application shows the flash log (FlashLog.c): the records are kept across resets.
+ *
+ * At the start, the Boot task reads the whole log: it counts the records of each type, checks the
+ * events (their data is a pattern made from their number) and finds the last boot record. Then it
+ * appends a new boot record with the next boot number.
+ * The Event task appends an event record of 8 to 64 bytes every EVENT_PERIOD_MS, without waiting for the
+ * flash. The Boot task prints the statistics of the log and writes its boot record again every 5 seconds.
+ *
+ * Power cut test (POWER_CUT_TEST): after POWER_CUT_AFTER_MS the writer task resets the MCU in the middle of
+ * the programming of a double word of a record. At the next start the record cut is found (torn records,
+ * or a bad page when its header was cut, ECC errors when the torn double word was read) and skipped, the
+ * other records are still read without error, and the boot number goes on.
+ *
+ * FlashLog.c and Crc32.c have to be included in the build with this file, and HAL_FLASH_MODULE_ENABLED
+ * in stm32wbxx_hal_conf.h.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stm32wbxx.h"
+#include "stm32wbxx_nucleo.h"
+#include "stdio.h"
+#include "string.h"
+#include "FlashLog.h"
+
+//Types of the records
+#define RECORD_BOOT				1
+#define RECORD_EVENT			2
+
+#define EVENT_PERIOD_MS			100
+#define EVENT_MIN_SIZE			8
+#define EVENT_MAX_SIZE			64
+#define REPORT_PERIOD_MS		5000
+
+//1: the power cut test resets the MCU after POWER_CUT_AFTER_MS, 0: the log only grows
+#define POWER_CUT_TEST			1
+#define POWER_CUT_AFTER_MS		20000
+
+//Data of the records
+typedef struct BootRecord
+{
+	uint32_t ulBoot;
+	uint32_t ulRecordsFound;
+	uint32_t ulTornFound;
+}BootRecord_t;
+
+typedef struct EventRecord
+{
+	uint32_t ulBoot;
+	uint32_t ulNumber;
+	uint8_t ucPattern[EVENT_MAX_SIZE - 8];
+}EventRecord_t;
+
+//Task handles and functions
+TaskHandle_t xBootTask = NULL;
+TaskHandle_t xEventTask = NULL;
+void vBootTaskFunction(void *params);
+void vEventTaskFunction(void *params);
+
+//UART Handle and Init types
+UART_HandleTypeDef Uart1;
+UART_InitTypeDef Uart1Init;
+GPIO_InitTypeDef GpioUARTpins;
+
+//Boot number of this run, set by the Boot task before the Event task is created
+static uint32_t ulBoot = 0;
+
+//Private helper functions and variables
+static void prvSetupUART(void);
+static void prvReadLog(void);
+static void prvPrintStats(void);
+static size_t prvMakeEvent(EventRecord_t *pxEvent, uint32_t ulBootNumber, uint32_t ulNumber);
+void printmsg(char *msg);
+char UsrMsg[250];
+
+
+int main()
+{
+	// Enable the DWT Cycle Count Register (SEGGER Settings)
+	DWT->CTRL |= (1 << 0);
+
+	// Private function called to setup the Hardware
+	prvSetupUART();
+
+	//Start Recording for SEGGER SystemView
+	SEGGER_SYSVIEW_Conf();
+	SEGGER_SYSVIEW_Start();
+
+	sprintf(UsrMsg,"Example of the flash log, kept across resets \r\n");
+	printmsg(UsrMsg);
+
+	if(xFlashLogInit() == pdPASS)
+	{
+		//Create Boot Task. It creates the Event task after the reading of the log.
+		xTaskCreate(vBootTaskFunction, "Boot-Task", 512, NULL, 2, &xBootTask);
+
+		//Schedule the tasks
+		vTaskStartScheduler();
+	}
+	else
+	{
+		sprintf(UsrMsg, "Flash log initialization failed... :( \r\n");
+		printmsg(UsrMsg);
+	}
+
+	/*
+	 * If scheduler can start the tasks and run them, the program will never reach here.
+	 * If the program comes to the below line, that means there was a problem while creating or scheduling the tasks
+	 */
+	for(;;);
+}
+
+
+void vBootTaskFunction(void *params)
+{
+	BootRecord_t xBoot;
+	FlashLogStats_t xStats;
+	TickType_t xStart;
+
+	//1. Index rebuilt by xFlashLogInit()
+	vFlashLogGetStats(&xStats);
+	sprintf(UsrMsg, "Index rebuilt in %lu us: %lu records, %lu torn, %lu bad pages, %lu ECC errors \r\n",
+			xStats.ulRebuildCycles / (SystemCoreClock / 1000000), xStats.ulRecords, xStats.ulTornRecords, xStats.ulBadPages, xStats.ulEccErrors);
+	printmsg(UsrMsg);
+
+	//2. Whole log, then the boot record of this run
+	prvReadLog();
+
+	xBoot.ulBoot = ulBoot;
+	xBoot.ulRecordsFound = xStats.ulRecords;
+	xBoot.ulTornFound = xStats.ulTornRecords;
+	if( (xFlashLogAppend(RECORD_BOOT, &xBoot, sizeof(xBoot), portMAX_DELAY) != pdPASS) || (xFlashLogFlush(pdMS_TO_TICKS(1000)) != pdPASS) )
+	{
+		printmsg("Boot record not written \r\n");
+	}
+
+	xTaskCreate(vEventTaskFunction, "Event-Task", 384, NULL, 2, &xEventTask);
+
+	//3. Statistics, and the power cut
+	xStart = xTaskGetTickCount();
+	while(1)
+	{
+		vTaskDelay(pdMS_TO_TICKS(REPORT_PERIOD_MS));
+		prvPrintStats();
+
+		//Written again, so the boot number is not lost when the ring erases the oldest page
+		xFlashLogAppend(RECORD_BOOT, &xBoot, sizeof(xBoot), 0);
+
+		if( (POWER_CUT_TEST != 0) && ((xTaskGetTickCount() - xStart) >= pdMS_TO_TICKS(POWER_CUT_AFTER_MS)) )
+		{
+			//Cut in one of the first 5 double words of the next record (the header too): the writer task resets the MCU
+			printmsg("Power cut: reset \r\n\r\n");
+			vFlashLogInjectCut(DWT->CYCCNT % 5);
+			vTaskDelay(pdMS_TO_TICKS(EVENT_PERIOD_MS * 4));
+			NVIC_SystemReset();
+		}
+	}
+}
+
+
+void vEventTaskFunction(void *params)
+{
+	EventRecord_t xEvent;
+	TickType_t xLastWakeTime = xTaskGetTickCount();
+	uint32_t ulNumber = 0;
+	size_t xLength;
+
+	while(1)
+	{
+		vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(EVENT_PERIOD_MS));
+
+		//Copied into the queue: the task does not wait for the programming or an erase
+		xLength = prvMakeEvent(&xEvent, ulBoot, ulNumber);
+		if(xFlashLogAppend(RECORD_EVENT, &xEvent, xLength, 0) == pdPASS)
+		{
+			ulNumber++;
+		}
+	}
+}
+
+
+static void prvReadLog(void)
+{
+	FlashLogCursor_t xCursor;
+	EventRecord_t xRecord;
+	EventRecord_t xExpected;
+	uint8_t ucType;
+	size_t xLength;
+	uint32_t ulBoots = 0;
+	uint32_t ulEvents = 0;
+	uint32_t ulWrongEvents = 0;
+	uint32_t ulLastBoot = 0;
+
+	vFlashLogRewind(&xCursor);
+	while(xFlashLogReadNext(&xCursor, &ucType, &xRecord, sizeof(xRecord), &xLength) == pdPASS)
+	{
+		if( (ucType == RECORD_BOOT) && (xLength == sizeof(BootRecord_t)) )
+		{
+			ulBoots++;
+			ulLastBoot = ((BootRecord_t *) &xRecord)->ulBoot;
+		}
+		else if(ucType == RECORD_EVENT)
+		{
+			//The CRC is already checked: this checks the data the application wrote
+			ulEvents++;
+			if( (xLength != prvMakeEvent(&xExpected, xRecord.ulBoot, xRecord.ulNumber)) || (memcmp(&xRecord, &xExpected, xLength) != 0) )
+			{
+				ulWrongEvents++;
+			}
+		}
+	}
+
+	ulBoot = ulLastBoot + 1;
+	sprintf(UsrMsg, "Log: %lu boot records, %lu events (%lu wrong). This is boot %lu \r\n", ulBoots, ulEvents, ulWrongEvents, ulBoot);
+	printmsg(UsrMsg);
+}
+
+
+static void prvPrintStats(void)
+{
+	FlashLogStats_t xStats;
+
+	vFlashLogGetStats(&xStats);
+	sprintf(UsrMsg, "Records %lu, appended %lu, written %lu, dropped %lu, erases %lu, errors %lu, CRC errors %lu \r\n",
+			xStats.ulRecords, xStats.ulAppended, xStats.ulWritten, xStats.ulDropped, xStats.ulErases, xStats.ulWriteErrors, xStats.ulCrcErrors);
+	printmsg(UsrMsg);
+}
+
+
+//Event of a boot: its size and pattern depend on its number
+static size_t prvMakeEvent(EventRecord_t *pxEvent, uint32_t ulBootNumber, uint32_t ulNumber)
+{
+	size_t xLength = EVENT_MIN_SIZE + ((ulNumber * 7) % (EVENT_MAX_SIZE - EVENT_MIN_SIZE + 1));
+	uint32_t i;
+
+	pxEvent->ulBoot = ulBootNumber;
+	pxEvent->ulNumber = ulNumber;
+	for(i = 0; i < (xLength - 8); i++)
+	{
+		pxEvent->ucPattern[i] = (uint8_t) (ulNumber + (i * 13) + ulBootNumber);
+	}
+
+	return xLength;
+}
+
+
+static void prvSetupUART(void)
+{
+	//1. Enable the UART1 and GPIOB Peripheral Clocks
+	__HAL_RCC_USART1_CLK_ENABLE();
+	__HAL_RCC_GPIOB_CLK_ENABLE();
+
+	//In UART connection with Virtual COM-port, PB6->TX and PB7->RX
+	//2. Alternate Functionality Configuration to make Port B pins work as UART pins
+
+	//Zeroing each and every member element of the structure.
+	memset(&GpioUARTpins, 0, sizeof(GpioUARTpins));
+	GpioUARTpins.Pin = GPIO_PIN_6 | GPIO_PIN_7;
+	GpioUARTpins.Mode = GPIO_MODE_AF_PP;
+	GpioUARTpins.Alternate = GPIO_AF7_USART1;
+	GpioUARTpins.Pull = GPIO_PULLUP;
+
+	HAL_GPIO_Init(GPIOB, &GpioUARTpins);
+
+	//3. Configure and initialize UART parameters
+
+	//Zeroing each and every member element of the structure.
+	memset(&Uart1Init, 0, sizeof(Uart1Init));
+	memset(&Uart1, 0, sizeof(Uart1));
+
+	//UART Initialization
+	Uart1Init.BaudRate = 115200;
+	Uart1Init.WordLength = UART_WORDLENGTH_8B;
+	Uart1Init.HwFlowCtl = UART_HWCONTROL_NONE;
+	Uart1Init.Mode = UART_MODE_TX_RX;
+	Uart1Init.Parity = UART_PARITY_NONE;
+	Uart1Init.StopBits = UART_STOPBITS_1;
+
+	Uart1.Init = Uart1Init;
+	Uart1.Instance = USART1;
+
+	//4. Initialize the UART peripheral
+	uint16_t UARTSetUpResult = HAL_UART_Init(&Uart1);
+
+	if(UARTSetUpResult == HAL_ERROR)
+	{
+		//printf("USART Initialization was not successful \n");
+	}
+
+}
+
+void printmsg(char *msg)
+{
+	HAL_UART_Transmit(&Uart1, (uint8_t *)msg, strlen(msg), 1);
+}
+
+//Implement the Idle Hook function
+void vApplicationIdleHook()
+{
+	//Send the CPU to normal sleep mode
+	__WFI();
+}
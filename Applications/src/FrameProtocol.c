@@ -0,0 +1,144 @@
+/*
+ * FrameProtocol.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * COBS encoding: the data is cut at each 0x00 byte into blocks. Each block is sent as a code byte
+ * (block length + 1) followed by its non zero bytes, and the 0x00 byte is implied by the next code
+ * byte. A block of 254 non zero bytes has the code 0xFF and no implied 0x00 after it.
+ *
+ * xFrameEncode() builds the raw frame at the end of the output buffer, computes the CRC on it in one
+ * piece, and encodes it forwards to the start of the same buffer. The encoder writes at most 2 bytes
+ * plus 1 byte every 254 bytes ahead of the data it reads, so it never overwrites data not read yet.
+ * The decoder works in place too: the decoded data is never longer than the encoded data.
+ */
+
+#include "FreeRTOS.h"
+#include "string.h"
+#include "Crc32.h"
+#include "FrameProtocol.h"
+
+
+size_t xFrameEncode(uint8_t ucCommand, const uint8_t *pucPayload, uint16_t usLength, uint8_t *pucOutput, size_t xOutputSize)
+{
+	size_t xRawSize = FRAME_HEADER_SIZE + usLength + FRAME_CRC_SIZE;
+	size_t xRead, xWrite, xCodeIndex;
+	uint8_t *pucRaw;
+	uint8_t ucCode;
+	uint32_t ulCrc;
+
+	if( (usLength > FRAME_MAX_PAYLOAD) || ((xRawSize + FRAME_COBS_OVERHEAD(xRawSize) + 2) > xOutputSize) )
+	{
+		return 0;
+	}
+
+	//1. Raw frame at the end of the output buffer
+	pucRaw = &pucOutput[xOutputSize - xRawSize];
+	pucRaw[0] = (uint8_t)(usLength & 0xFF);
+	pucRaw[1] = (uint8_t)(usLength >> 8);
+	pucRaw[2] = ucCommand;
+	memcpy(&pucRaw[FRAME_HEADER_SIZE], pucPayload, usLength);
+
+	ulCrc = ulCrc32Calculate(pucRaw, FRAME_HEADER_SIZE + usLength);
+	pucRaw[FRAME_HEADER_SIZE + usLength] = (uint8_t)(ulCrc & 0xFF);
+	pucRaw[FRAME_HEADER_SIZE + usLength + 1] = (uint8_t)((ulCrc >> 8) & 0xFF);
+	pucRaw[FRAME_HEADER_SIZE + usLength + 2] = (uint8_t)((ulCrc >> 16) & 0xFF);
+	pucRaw[FRAME_HEADER_SIZE + usLength + 3] = (uint8_t)(ulCrc >> 24);
+
+	//2. COBS encoding between the delimiters. The code byte of a block is written when the block ends.
+	pucOutput[0] = FRAME_DELIMITER;
+	xCodeIndex = 1;
+	xWrite = 2;
+	ucCode = 1;
+
+	for(xRead = 0; xRead < xRawSize; xRead++)
+	{
+		if(pucRaw[xRead] == 0)
+		{
+			pucOutput[xCodeIndex] = ucCode;
+			xCodeIndex = xWrite++;
+			ucCode = 1;
+		}
+		else
+		{
+			pucOutput[xWrite++] = pucRaw[xRead];
+			ucCode++;
+
+			if(ucCode == 0xFF)
+			{
+				pucOutput[xCodeIndex] = ucCode;
+				xCodeIndex = xWrite++;
+				ucCode = 1;
+			}
+		}
+	}
+
+	pucOutput[xCodeIndex] = ucCode;
+	pucOutput[xWrite++] = FRAME_DELIMITER;
+
+	return xWrite;
+}
+
+FrameStatus_t xFrameDecode(uint8_t *pucBuffer, size_t xLength, Frame_t *pxFrame)
+{
+	size_t xRead = 0, xWrite = 0;
+	uint8_t ucCode, i;
+	uint16_t usLength;
+	uint32_t ulCrc;
+
+	//1. COBS decoding in place
+	while(xRead < xLength)
+	{
+		ucCode = pucBuffer[xRead++];
+		if(ucCode == 0)
+		{
+			return eFrameCobsError;
+		}
+
+		for(i = 1; i < ucCode; i++)
+		{
+			if( (xRead >= xLength) || (pucBuffer[xRead] == 0) )
+			{
+				return eFrameCobsError;
+			}
+			pucBuffer[xWrite++] = pucBuffer[xRead++];
+		}
+
+		//The 0x00 implied at the end of the block, except after the last block and after a full block
+		if( (ucCode != 0xFF) && (xRead < xLength) )
+		{
+			pucBuffer[xWrite++] = 0;
+		}
+	}
+
+	//2. Length and CRC
+	if(xWrite < (FRAME_HEADER_SIZE + FRAME_CRC_SIZE))
+	{
+		return eFrameLengthError;
+	}
+
+	usLength = pucBuffer[0] | (pucBuffer[1] << 8);
+	if( (usLength > FRAME_MAX_PAYLOAD) || ((size_t)(FRAME_HEADER_SIZE + usLength + FRAME_CRC_SIZE) != xWrite) )
+	{
+		return eFrameLengthError;
+	}
+
+	ulCrc = (uint32_t) pucBuffer[FRAME_HEADER_SIZE + usLength] |
+			((uint32_t) pucBuffer[FRAME_HEADER_SIZE + usLength + 1] << 8) |
+			((uint32_t) pucBuffer[FRAME_HEADER_SIZE + usLength + 2] << 16) |
+			((uint32_t) pucBuffer[FRAME_HEADER_SIZE + usLength + 3] << 24);
+
+	if(ulCrc32Calculate(pucBuffer, FRAME_HEADER_SIZE + usLength) != ulCrc)
+	{
+		return eFrameCrcError;
+	}
+
+	pxFrame->ucCommand = pucBuffer[2];
+	pxFrame->usLength = usLength;
+	pxFrame->pucPayload = &pucBuffer[FRAME_HEADER_SIZE];
+
+	return eFrameOk;
+}
@@ -0,0 +1,372 @@
+/*
+ * FrameProtocolExample.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * This application is a binary command protocol on USART1 (FrameProtocol.c), instead of the ASCII
+ * commands of QueueProcessing.c. Every frame has a CRC-32 computed by the CRC unit (Crc32.c).
+ *
+ * The USART1 interrupt only stores the bytes. When it receives a frame delimiter, it hands the buffer
+ * to the Frame task and goes on with the second buffer (no byte is lost while the frame is processed).
+ * The Frame task decodes and checks the frame, executes the command and sends the answer frame.
+ *
+ * Commands (the answer has the command code with bit 7 set, FRAME_CMD_NAK if the frame is invalid):
+ *   PING:  the payload is sent back
+ *   LED:   payload[0] is 0 (off), 1 (on) or 2 (toggle). Answer: LED state.
+ *   STATS: answer: the counters of FrameStats_t
+ *   CRC:   answer: CRC-32 of the payload by hardware and software, and their durations in CPU cycles
+ * Tools/frame_client.py sends these commands from the host.
+ *
+ * Crc32.c and FrameProtocol.c have to be included in the build with this file,
+ * and HAL_CRC_MODULE_ENABLED in stm32wbxx_hal_conf.h.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stm32wbxx.h"
+#include "stm32wbxx_nucleo.h"
+#include "stdio.h"
+#include "string.h"
+#include "Crc32.h"
+#include "FrameProtocol.h"
+
+//Command codes
+#define FRAME_CMD_PING			0x01
+#define FRAME_CMD_LED			0x02
+#define FRAME_CMD_STATS			0x03
+#define FRAME_CMD_CRC			0x04
+#define FRAME_CMD_NAK			0x7F
+#define FRAME_ANSWER			0x80
+
+//Counters of the receiver (sent by the STATS command)
+typedef struct FrameStats
+{
+	uint32_t ulFramesOk;
+	uint32_t ulCobsErrors;
+	uint32_t ulLengthErrors;
+	uint32_t ulCrcErrors;
+	uint32_t ulDropped;			//Frames received while the Frame task still had both buffers
+	uint32_t ulOverruns;		//Frames too long for the buffer, and UART overruns
+}FrameStats_t;
+
+//Task handles and functions
+TaskHandle_t xFrameTask = NULL;
+void vFrameTaskFunction(void *params);
+
+//Variables related to peripherals
+GPIO_InitTypeDef GpioLEDpin, GpioUARTpins;
+UART_HandleTypeDef Uart1;
+UART_InitTypeDef Uart1Init;
+
+//Receive buffers: one filled by the interrupt, the other one processed by the Frame task
+uint8_t ucRxBuffer[2][FRAME_MAX_ENCODED_SIZE];
+volatile uint8_t ucRxActive = 0;
+volatile uint16_t usRxLength = 0;
+volatile uint8_t ucRxOverflow = 0;
+volatile uint8_t ucFrameTaskBusy = 0;
+volatile FrameStats_t xFrameStats;
+
+uint8_t ucTxBuffer[FRAME_MAX_ENCODED_SIZE];
+
+//Private helper functions and variables
+static void prvSetupLED(void);
+static void prvSetupUART(void);
+static void prvProcessFrame(Frame_t *pxFrame);
+static void prvSendFrame(uint8_t ucCommand, const uint8_t *pucPayload, uint16_t usLength);
+void printmsg(char *msg);
+char UsrMsg[250];
+
+int main()
+{
+	// Enable the DWT Cycle Count Register (SEGGER Settings)
+	DWT->CTRL |= (1 << 0);
+
+	// Private functions called to setup the Hardware
+	prvSetupLED();
+	prvSetupUART();
+
+	//Start Recording for SEGGER SystemView
+	SEGGER_SYSVIEW_Conf();
+	SEGGER_SYSVIEW_Start();
+
+	//The host tool skips this text: it is not inside a frame
+	sprintf(UsrMsg,"Example of a binary framed command protocol with CRC-32 \r\n");
+	printmsg(UsrMsg);
+
+	if(xCrc32Init() != pdPASS)
+	{
+		sprintf(UsrMsg,"CRC unit not available, using the software CRC-32 \r\n");
+		printmsg(UsrMsg);
+	}
+
+	//Create Frame Task. Its stack holds the CRC command buffers and the sprintf of the messages.
+	xTaskCreate(vFrameTaskFunction, "Frame-Task", 384, NULL, 2, &xFrameTask);
+
+	//Schedule the tasks
+	vTaskStartScheduler();
+
+	/*
+	 * If scheduler can start the tasks and run them, the program will never reach here.
+	 * If the program comes to the below line, that means there was a problem while creating or scheduling the tasks
+	 */
+	for(;;);
+}
+
+
+void vFrameTaskFunction(void *params)
+{
+	uint32_t ulNotifiedValue;
+	uint8_t *pucBuffer;
+	uint16_t usLength;
+	Frame_t xFrame;
+	uint8_t ucStatus;
+
+	//Receive the frames from now on
+	__HAL_UART_ENABLE_IT(&Uart1, UART_IT_RXNE);
+
+	while(1)
+	{
+		//The interrupt sends the buffer index (bit 16) and the length of the received bytes
+		xTaskNotifyWait(0, 0, &ulNotifiedValue, portMAX_DELAY);
+
+		pucBuffer = ucRxBuffer[(ulNotifiedValue >> 16) & 0x01];
+		usLength = (uint16_t)(ulNotifiedValue & 0xFFFF);
+
+		ucStatus = (uint8_t) xFrameDecode(pucBuffer, usLength, &xFrame);
+
+		switch(ucStatus)
+		{
+			case eFrameOk:
+				xFrameStats.ulFramesOk++;
+				prvProcessFrame(&xFrame);
+				break;
+
+			case eFrameCobsError:
+				xFrameStats.ulCobsErrors++;
+				break;
+
+			case eFrameLengthError:
+				xFrameStats.ulLengthErrors++;
+				break;
+
+			default:
+				xFrameStats.ulCrcErrors++;
+				break;
+		}
+
+		if(ucStatus != eFrameOk)
+		{
+			prvSendFrame(FRAME_CMD_NAK, &ucStatus, 1);
+		}
+
+		//The buffer can be used by the interrupt again
+		ucFrameTaskBusy = 0;
+	}
+}
+
+
+static void prvProcessFrame(Frame_t *pxFrame)
+{
+	uint8_t ucAnswer[16];
+	uint32_t ulCrc, ulStart, ulHwCycles, ulSwCycles;
+
+	switch(pxFrame->ucCommand)
+	{
+		case FRAME_CMD_PING:
+			prvSendFrame(FRAME_CMD_PING | FRAME_ANSWER, pxFrame->pucPayload, pxFrame->usLength);
+			break;
+
+		case FRAME_CMD_LED:
+			if( (pxFrame->usLength == 1) && (pxFrame->pucPayload[0] < 2) )
+			{
+				HAL_GPIO_WritePin(GPIOB, LED1_PIN, (pxFrame->pucPayload[0] == 1) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+			}
+			else if(pxFrame->usLength == 1)
+			{
+				HAL_GPIO_TogglePin(GPIOB, LED1_PIN);
+			}
+			ucAnswer[0] = (uint8_t) HAL_GPIO_ReadPin(GPIOB, LED1_PIN);
+			prvSendFrame(FRAME_CMD_LED | FRAME_ANSWER, ucAnswer, 1);
+			break;
+
+		case FRAME_CMD_STATS:
+			prvSendFrame(FRAME_CMD_STATS | FRAME_ANSWER, (uint8_t *) &xFrameStats, sizeof(FrameStats_t));
+			break;
+
+		case FRAME_CMD_CRC:
+			ulStart = DWT->CYCCNT;
+			ulCrc = ulCrc32Calculate(pxFrame->pucPayload, pxFrame->usLength);
+			ulHwCycles = DWT->CYCCNT - ulStart;
+			memcpy(&ucAnswer[0], &ulCrc, 4);
+
+			ulStart = DWT->CYCCNT;
+			ulCrc = ulCrc32Software(0, pxFrame->pucPayload, pxFrame->usLength);
+			ulSwCycles = DWT->CYCCNT - ulStart;
+			memcpy(&ucAnswer[4], &ulCrc, 4);
+
+			memcpy(&ucAnswer[8], &ulHwCycles, 4);
+			memcpy(&ucAnswer[12], &ulSwCycles, 4);
+			prvSendFrame(FRAME_CMD_CRC | FRAME_ANSWER, ucAnswer, 16);
+			break;
+
+		default:
+			ucAnswer[0] = pxFrame->ucCommand;
+			prvSendFrame(FRAME_CMD_NAK, ucAnswer, 1);
+			break;
+	}
+}
+
+static void prvSendFrame(uint8_t ucCommand, const uint8_t *pucPayload, uint16_t usLength)
+{
+	size_t xSize = xFrameEncode(ucCommand, pucPayload, usLength, ucTxBuffer, sizeof(ucTxBuffer));
+
+	if(xSize != 0)
+	{
+		//About 45ms for the largest frame at 115200 baud
+		HAL_UART_Transmit(&Uart1, ucTxBuffer, xSize, 100);
+	}
+}
+
+
+static void prvSetupLED(void)
+{
+	LED1_GPIO_CLK_ENABLE();
+
+	//Zeroing each and every member element of the structure.
+	memset(&GpioLEDpin, 0, sizeof(GpioLEDpin));
+	GpioLEDpin.Pin = LED1_PIN;
+	GpioLEDpin.Mode = GPIO_MODE_OUTPUT_PP;
+	GpioLEDpin.Speed = GPIO_SPEED_FREQ_MEDIUM;
+	GpioLEDpin.Pull = GPIO_NOPULL;
+
+	HAL_GPIO_Init(GPIOB, &GpioLEDpin);
+}
+
+static void prvSetupUART(void)
+{
+	//1. Enable the UART1 and GPIOB Peripheral Clocks
+	__HAL_RCC_USART1_CLK_ENABLE();
+	__HAL_RCC_GPIOB_CLK_ENABLE();
+
+	//In UART connection with Virtual COM-port, PB6->TX and PB7->RX
+	//2. Alternate Functionality Configuration to make Port B pins work as UART pins
+
+	//Zeroing each and every member element of the structure.
+	memset(&GpioUARTpins, 0, sizeof(GpioUARTpins));
+	GpioUARTpins.Pin = GPIO_PIN_6 | GPIO_PIN_7;
+	GpioUARTpins.Mode = GPIO_MODE_AF_PP;
+	GpioUARTpins.Alternate = GPIO_AF7_USART1;
+	GpioUARTpins.Pull = GPIO_PULLUP;
+
+	HAL_GPIO_Init(GPIOB, &GpioUARTpins);
+
+	//3. Configure and initialize UART parameters
+
+	//Zeroing each and every member element of the structure.
+	memset(&Uart1Init, 0, sizeof(Uart1Init));
+	memset(&Uart1, 0, sizeof(Uart1));
+
+	//UART Initialization
+	Uart1Init.BaudRate = 115200;
+	Uart1Init.WordLength = UART_WORDLENGTH_8B;
+	Uart1Init.HwFlowCtl = UART_HWCONTROL_NONE;
+	Uart1Init.Mode = UART_MODE_TX_RX;
+	Uart1Init.Parity = UART_PARITY_NONE;
+	Uart1Init.StopBits = UART_STOPBITS_1;
+
+	Uart1.Init = Uart1Init;
+	Uart1.Instance = USART1;
+
+	//4. Initialize the UART peripheral
+	uint16_t UARTSetUpResult = HAL_UART_Init(&Uart1);
+
+	if(UARTSetUpResult == HAL_ERROR)
+	{
+		//printf("USART Initialization was not successful \n");
+	}
+
+	//5. Set the USART1 interrupt priority in NVIC (the RXNE interrupt is enabled by the Frame task)
+	NVIC_SetPriority(USART1_IRQn, 5); //Priority should be less than or equal to configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY
+
+	//6. Enable the USART1 IRQ in NVIC
+	NVIC_EnableIRQ(USART1_IRQn);
+}
+
+void printmsg(char *msg)
+{
+	HAL_UART_Transmit(&Uart1, (uint8_t *)msg, strlen(msg), 1);
+}
+
+
+void USART1_IRQHandler(void)
+{
+	uint8_t RxData;
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	//A byte was lost: the frame will fail its CRC check
+	if( __HAL_UART_GET_FLAG(&Uart1, UART_FLAG_ORE) )
+	{
+		__HAL_UART_CLEAR_OREFLAG(&Uart1);
+		xFrameStats.ulOverruns++;
+	}
+
+	if( __HAL_UART_GET_FLAG(&Uart1, UART_FLAG_RXNE) )
+	{
+		//Reading the data register clears the RXNE flag
+		RxData = (uint8_t)(Uart1.Instance->RDR & 0xFF);
+
+		if(RxData != FRAME_DELIMITER)
+		{
+			if(usRxLength < FRAME_MAX_ENCODED_SIZE)
+			{
+				ucRxBuffer[ucRxActive][usRxLength++] = RxData;
+			}
+			else
+			{
+				//Too long for a frame: skip the bytes up to the next delimiter
+				ucRxOverflow = 1;
+			}
+		}
+		else
+		{
+			if(ucRxOverflow != 0)
+			{
+				xFrameStats.ulOverruns++;
+			}
+			else if(usRxLength != 0)
+			{
+				if(ucFrameTaskBusy == 0)
+				{
+					//Hand over the buffer and receive the next frame in the other one
+					ucFrameTaskBusy = 1;
+					xTaskNotifyFromISR(xFrameTask, ((uint32_t) ucRxActive << 16) | usRxLength, eSetValueWithOverwrite, &xHigherPriorityTaskWoken);
+					ucRxActive ^= 1;
+				}
+				else
+				{
+					xFrameStats.ulDropped++;
+				}
+			}
+
+			//Empty frames are the delimiters between two frames
+			usRxLength = 0;
+			ucRxOverflow = 0;
+		}
+	}
+
+	/*
+	 * If the above FreeRTOS APIs unblocks any other higher priority tasks,
+	 * then yield the processor to the higher priority task which has been unblocked.
+	 */
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+//Implement the Idle Hook function
+void vApplicationIdleHook()
+{
+	//Send the CPU to normal sleep mode
+	__WFI();
+}
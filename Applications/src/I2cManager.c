@@ -0,0 +1,494 @@
+/*
+ * I2cManager.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * The phases of a job are sequential transfers of the HAL, chained from the I2C interrupt:
+ *   read:  register address (HAL_I2C_Master_Seq_Transmit_IT(), no STOP), then restart and data
+ *          (HAL_I2C_Master_Seq_Receive_IT(), STOP at the end)
+ *   write: register address and data in one transfer (copied in ucBuffer)
+ * HAL_I2C_Mem_Read_IT() is not used: it waits for the register address phase in the calling function.
+ *
+ * The list of jobs is shared by the tasks, the I2C interrupts and the timer of the timeouts: the tasks
+ * change it in a critical section (the I2C interrupts are masked by it, see I2C_MANAGER_IRQ_PRIORITY).
+ *
+ * The callbacks of the HAL are registered on the handle of the manager (USE_HAL_I2C_REGISTER_CALLBACKS):
+ * the HAL_I2C_xxxCallback() functions are free for the other I2C of the application.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "stm32wbxx.h"
+#include "stm32wbxx_hal.h"
+#include "string.h"
+#include "I2cManager.h"
+
+#define I2C_MANAGER_PORT				GPIOB
+#define I2C_MANAGER_SCL_PIN				GPIO_PIN_8
+#define I2C_MANAGER_SDA_PIN				GPIO_PIN_9
+
+//Phases of a job
+#define I2C_PHASE_REGISTER				1
+#define I2C_PHASE_DATA					2
+
+static I2C_HandleTypeDef I2cHandle;
+static TimerHandle_t xTimeoutTimer = NULL;
+
+//Job on the bus, and the list of the jobs waiting for it
+static I2cJob_t *pxCurrentJob = NULL;
+static I2cJob_t *pxFirstJob = NULL;
+static I2cJob_t *pxLastJob = NULL;
+
+//Register address and data sent by the current job
+static uint8_t ucBuffer[2 + I2C_MANAGER_MAX_WRITE];
+
+//Jobs started, and the progress of the bus at the last check of the timer (job, phase and bytes left)
+static uint32_t ulJobStarts = 0;
+static uint32_t ulCheckedStarts = 0;
+static uint8_t ucCheckedPhase = 0;
+static uint16_t usCheckedCount = 0;
+static volatile uint32_t ulRecoveries = 0;
+
+//Private helper functions
+static void prvInitPins(uint32_t ulMode, uint8_t ucAlternate);
+static void prvStartJob(I2cJob_t *pxJob);
+static void prvJobDone(uint8_t ucStatus, BaseType_t *pxHigherPriorityTaskWoken);
+static void prvClearBus(void);
+static void prvHalfClockDelay(void);
+static void prvTimeoutCallback(TimerHandle_t xTimer);
+static void prvMspInit(I2C_HandleTypeDef *hi2c);
+static void prvMasterTxCplt(I2C_HandleTypeDef *hi2c);
+static void prvMasterRxCplt(I2C_HandleTypeDef *hi2c);
+static void prvError(I2C_HandleTypeDef *hi2c);
+
+
+BaseType_t xI2cManagerInit(void)
+{
+	//1. SCL and SDA
+	__HAL_RCC_GPIOB_CLK_ENABLE();
+	prvInitPins(GPIO_MODE_AF_OD, GPIO_AF4_I2C1);
+
+	//2. I2C1 master, 7 bit addresses
+	memset(&I2cHandle, 0, sizeof(I2cHandle));
+	I2cHandle.Instance = I2C1;
+	I2cHandle.Init.Timing = I2C_MANAGER_TIMING;
+	I2cHandle.Init.OwnAddress1 = 0;
+	I2cHandle.Init.AddressingMode = I2C_ADDRESSINGMODE_7BIT;
+	I2cHandle.Init.DualAddressMode = I2C_DUALADDRESS_DISABLE;
+	I2cHandle.Init.OwnAddress2 = 0;
+	I2cHandle.Init.OwnAddress2Masks = I2C_OA2_NOMASK;
+	I2cHandle.Init.GeneralCallMode = I2C_GENERALCALL_DISABLE;
+	I2cHandle.Init.NoStretchMode = I2C_NOSTRETCH_DISABLE;
+
+	//The MspInit callback is registered before the initialization, the others after it
+	HAL_I2C_RegisterCallback(&I2cHandle, HAL_I2C_MSPINIT_CB_ID, prvMspInit);
+	if(HAL_I2C_Init(&I2cHandle) != HAL_OK)
+	{
+		return pdFAIL;
+	}
+	HAL_I2C_RegisterCallback(&I2cHandle, HAL_I2C_MASTER_TX_COMPLETE_CB_ID, prvMasterTxCplt);
+	HAL_I2C_RegisterCallback(&I2cHandle, HAL_I2C_MASTER_RX_COMPLETE_CB_ID, prvMasterRxCplt);
+	HAL_I2C_RegisterCallback(&I2cHandle, HAL_I2C_ERROR_CB_ID, prvError);
+
+	NVIC_SetPriority(I2C1_EV_IRQn, I2C_MANAGER_IRQ_PRIORITY); //Priority should be less than or equal to configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY
+	NVIC_SetPriority(I2C1_ER_IRQn, I2C_MANAGER_IRQ_PRIORITY);
+	NVIC_EnableIRQ(I2C1_EV_IRQn);
+	NVIC_EnableIRQ(I2C1_ER_IRQn);
+
+	//3. Timer of the timeouts. It checks the bus while the scheduler runs.
+	xTimeoutTimer = xTimerCreate("I2C-Timeout", pdMS_TO_TICKS(I2C_MANAGER_TIMEOUT_MS), pdTRUE, NULL, prvTimeoutCallback);
+	if( (xTimeoutTimer == NULL) || (xTimerStart(xTimeoutTimer, 0) != pdPASS) )
+	{
+		return pdFAIL;
+	}
+
+	return pdPASS;
+}
+
+BaseType_t xI2cSubmit(I2cJob_t *pxJob)
+{
+	//1. The job has to fit in the transfers of the manager
+	if( (pxJob->ucAddress > 0x7F) || (pxJob->ucRegisterSize > 2) || (pxJob->usLength == 0) ||
+		( (pxJob->ucRead == 0) && (pxJob->usLength > I2C_MANAGER_MAX_WRITE) ) )
+	{
+		return pdFAIL;
+	}
+
+	pxJob->xTask = xTaskGetCurrentTaskHandle();
+	pxJob->pxNext = NULL;
+	pxJob->ulCycles = 0;
+	pxJob->ucStatus = I2C_JOB_OK;
+	pxJob->ucDone = 0;
+
+	//2. Started now if the bus is idle, else from the interrupt at the end of the last job of the list
+	taskENTER_CRITICAL();
+	if(pxCurrentJob == NULL)
+	{
+		prvStartJob(pxJob);
+	}
+	else
+	{
+		if(pxLastJob == NULL)
+		{
+			pxFirstJob = pxJob;
+		}
+		else
+		{
+			pxLastJob->pxNext = pxJob;
+		}
+		pxLastJob = pxJob;
+	}
+
+	//Not started (the HAL is busy): ended as a bus error, the next job is tried
+	if( (pxCurrentJob == pxJob) && (pxJob->ucPhase == 0) )
+	{
+		prvJobDone(I2C_JOB_BUS_ERROR, NULL);
+	}
+	taskEXIT_CRITICAL();
+
+	return pdPASS;
+}
+
+BaseType_t xI2cWait(I2cJob_t *pxJob, TickType_t xTicksToWait)
+{
+	TimeOut_t xTimeOut;
+
+	//The notifications of the other jobs of the task wake it up too: the timeout is for the whole wait
+	vTaskSetTimeOutState(&xTimeOut);
+	while(pxJob->ucDone == 0)
+	{
+		if(xTaskCheckForTimeOut(&xTimeOut, &xTicksToWait) == pdTRUE)
+		{
+			return pdFAIL;
+		}
+		ulTaskNotifyTakeIndexed(I2C_MANAGER_NOTIFY_INDEX, pdTRUE, xTicksToWait);
+	}
+
+	return (pxJob->ucStatus == I2C_JOB_OK) ? pdPASS : pdFAIL;
+}
+
+BaseType_t xI2cReadRegister(uint8_t ucAddress, uint8_t ucRegister, uint8_t *pucData, uint16_t usLength)
+{
+	I2cJob_t xJob;
+
+	xJob.ucAddress = ucAddress;
+	xJob.ucRead = 1;
+	xJob.usRegister = ucRegister;
+	xJob.ucRegisterSize = 1;
+	xJob.pucData = pucData;
+	xJob.usLength = usLength;
+	xJob.pxCallback = NULL;
+	xJob.pvContext = NULL;
+
+	if(xI2cSubmit(&xJob) == pdFAIL)
+	{
+		return pdFAIL;
+	}
+	return xI2cWait(&xJob, portMAX_DELAY);
+}
+
+BaseType_t xI2cWriteRegister(uint8_t ucAddress, uint8_t ucRegister, const uint8_t *pucData, uint16_t usLength)
+{
+	I2cJob_t xJob;
+
+	xJob.ucAddress = ucAddress;
+	xJob.ucRead = 0;
+	xJob.usRegister = ucRegister;
+	xJob.ucRegisterSize = 1;
+	xJob.pucData = (uint8_t *) pucData;				//Only read by a write job
+	xJob.usLength = usLength;
+	xJob.pxCallback = NULL;
+	xJob.pvContext = NULL;
+
+	if(xI2cSubmit(&xJob) == pdFAIL)
+	{
+		return pdFAIL;
+	}
+	return xI2cWait(&xJob, portMAX_DELAY);
+}
+
+uint32_t ulI2cManagerRecoveries(void)
+{
+	return ulRecoveries;
+}
+
+
+void I2C1_EV_IRQHandler(void)
+{
+	HAL_I2C_EV_IRQHandler(&I2cHandle);
+}
+
+void I2C1_ER_IRQHandler(void)
+{
+	HAL_I2C_ER_IRQHandler(&I2cHandle);
+}
+
+//Called by HAL_I2C_Init()
+static void prvMspInit(I2C_HandleTypeDef *hi2c)
+{
+	__HAL_RCC_I2C1_CLK_ENABLE();
+}
+
+//Called from the I2C interrupt at the end of the register address phase of a read, or of a write
+static void prvMasterTxCplt(I2C_HandleTypeDef *hi2c)
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	I2cJob_t *pxJob = pxCurrentJob;
+
+	if(pxJob == NULL)
+	{
+		return;
+	}
+
+	if( (pxJob->ucRead != 0) && (pxJob->ucPhase == I2C_PHASE_REGISTER) )
+	{
+		//Restart in read, and STOP after the last byte
+		pxJob->ucPhase = I2C_PHASE_DATA;
+		if(HAL_I2C_Master_Seq_Receive_IT(&I2cHandle, (uint16_t)(pxJob->ucAddress << 1), pxJob->pucData, pxJob->usLength, I2C_LAST_FRAME) != HAL_OK)
+		{
+			prvJobDone(I2C_JOB_BUS_ERROR, &xHigherPriorityTaskWoken);
+		}
+	}
+	else
+	{
+		prvJobDone(I2C_JOB_OK, &xHigherPriorityTaskWoken);
+	}
+
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+//Called from the I2C interrupt at the end of the data phase of a read
+static void prvMasterRxCplt(I2C_HandleTypeDef *hi2c)
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	if(pxCurrentJob != NULL)
+	{
+		prvJobDone(I2C_JOB_OK, &xHigherPriorityTaskWoken);
+	}
+
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+//Called from the I2C interrupts on a NACK, a bus error or an arbitration lost. The HAL has stopped the transfer.
+static void prvError(I2C_HandleTypeDef *hi2c)
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	if(pxCurrentJob != NULL)
+	{
+		prvJobDone(((hi2c->ErrorCode & HAL_I2C_ERROR_AF) != 0) ? I2C_JOB_NACK : I2C_JOB_BUS_ERROR, &xHigherPriorityTaskWoken);
+	}
+
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+
+static void prvInitPins(uint32_t ulMode, uint8_t ucAlternate)
+{
+	GPIO_InitTypeDef GpioI2cPins;
+
+	//Open drain. The internal pull-ups are enabled, a bus needs external ones too (except with short wires).
+	memset(&GpioI2cPins, 0, sizeof(GpioI2cPins));
+	GpioI2cPins.Pin = I2C_MANAGER_SCL_PIN | I2C_MANAGER_SDA_PIN;
+	GpioI2cPins.Mode = ulMode;
+	GpioI2cPins.Pull = GPIO_PULLUP;
+	GpioI2cPins.Speed = GPIO_SPEED_FREQ_LOW;
+	GpioI2cPins.Alternate = ucAlternate;
+	HAL_GPIO_Init(I2C_MANAGER_PORT, &GpioI2cPins);
+}
+
+//Called in a critical section, from the I2C interrupts or with them masked, when the bus is idle
+static void prvStartJob(I2cJob_t *pxJob)
+{
+	uint16_t usAddress = (uint16_t)(pxJob->ucAddress << 1);
+	HAL_StatusTypeDef xStatus;
+	uint8_t ucLength = 0;
+
+	pxCurrentJob = pxJob;
+	pxJob->ucPhase = 0;
+	pxJob->ulStartCycle = DWT->CYCCNT;
+	ulJobStarts++;
+
+	//Register address, most significant byte first
+	if(pxJob->ucRegisterSize == 2)
+	{
+		ucBuffer[ucLength++] = (uint8_t)(pxJob->usRegister >> 8);
+	}
+	if(pxJob->ucRegisterSize != 0)
+	{
+		ucBuffer[ucLength++] = (uint8_t) pxJob->usRegister;
+	}
+
+	if(pxJob->ucRead == 0)
+	{
+		//Write: address and data, then STOP
+		memcpy(&ucBuffer[ucLength], pxJob->pucData, pxJob->usLength);
+		xStatus = HAL_I2C_Master_Seq_Transmit_IT(&I2cHandle, usAddress, ucBuffer, ucLength + pxJob->usLength, I2C_FIRST_AND_LAST_FRAME);
+		pxJob->ucPhase = I2C_PHASE_DATA;
+	}
+	else if(ucLength != 0)
+	{
+		//Read: register address without STOP, the data phase is started by prvMasterTxCplt()
+		xStatus = HAL_I2C_Master_Seq_Transmit_IT(&I2cHandle, usAddress, ucBuffer, ucLength, I2C_FIRST_FRAME);
+		pxJob->ucPhase = I2C_PHASE_REGISTER;
+	}
+	else
+	{
+		//Read without register address
+		xStatus = HAL_I2C_Master_Seq_Receive_IT(&I2cHandle, usAddress, pxJob->pucData, pxJob->usLength, I2C_FIRST_AND_LAST_FRAME);
+		pxJob->ucPhase = I2C_PHASE_DATA;
+	}
+
+	if(xStatus != HAL_OK)
+	{
+		//Seen by the caller of prvStartJob()
+		pxJob->ucPhase = 0;
+	}
+}
+
+/*
+ * Ends the current job (callback or notification) and starts the next one of the list.
+ * Called from the I2C interrupts, or in a critical section with them masked.
+ */
+static void prvJobDone(uint8_t ucStatus, BaseType_t *pxHigherPriorityTaskWoken)
+{
+	I2cJob_t *pxJob = pxCurrentJob;
+	TaskHandle_t xTask;
+	I2cCallback_t pxCallback;
+
+	while(pxJob != NULL)
+	{
+		xTask = pxJob->xTask;
+		pxCallback = pxJob->pxCallback;
+
+		pxJob->ulCycles = DWT->CYCCNT - pxJob->ulStartCycle;
+		pxJob->ucStatus = ucStatus;
+		pxCurrentJob = NULL;
+
+		//The job can be used again as soon as ucDone is set (or from its callback)
+		pxJob->ucDone = 1;
+		if(pxCallback != NULL)
+		{
+			pxCallback(pxJob);
+		}
+		else
+		{
+			vTaskNotifyGiveIndexedFromISR(xTask, I2C_MANAGER_NOTIFY_INDEX, pxHigherPriorityTaskWoken);
+		}
+
+		//Next job. If it cannot be started, it is ended as a bus error.
+		pxJob = pxFirstJob;
+		if(pxJob != NULL)
+		{
+			pxFirstJob = pxJob->pxNext;
+			if(pxFirstJob == NULL)
+			{
+				pxLastJob = NULL;
+			}
+
+			prvStartJob(pxJob);
+			if(pxJob->ucPhase != 0)
+			{
+				pxJob = NULL;
+			}
+			ucStatus = I2C_JOB_BUS_ERROR;
+		}
+	}
+}
+
+/*
+ * Stops the I2C and clears the bus: clock pulses until the slave which holds SDA low releases it
+ * (at most 9: the end of its byte and the acknowledge), then a STOP. The I2C interrupts are masked.
+ */
+static void prvClearBus(void)
+{
+	uint8_t i;
+
+	//1. The I2C is disabled: its state machine is reset
+	__HAL_I2C_DISABLE(&I2cHandle);
+	__HAL_I2C_DISABLE_IT(&I2cHandle, I2C_IT_ERRI | I2C_IT_TCI | I2C_IT_STOPI | I2C_IT_NACKI | I2C_IT_ADDRI | I2C_IT_RXI | I2C_IT_TXI);
+
+	//2. SCL and SDA driven by the CPU, released
+	HAL_GPIO_WritePin(I2C_MANAGER_PORT, I2C_MANAGER_SCL_PIN | I2C_MANAGER_SDA_PIN, GPIO_PIN_SET);
+	prvInitPins(GPIO_MODE_OUTPUT_OD, 0);
+	prvHalfClockDelay();
+
+	//3. Clock pulses
+	for(i = 0; (i < 9) && (HAL_GPIO_ReadPin(I2C_MANAGER_PORT, I2C_MANAGER_SDA_PIN) == GPIO_PIN_RESET); i++)
+	{
+		HAL_GPIO_WritePin(I2C_MANAGER_PORT, I2C_MANAGER_SCL_PIN, GPIO_PIN_RESET);
+		prvHalfClockDelay();
+		HAL_GPIO_WritePin(I2C_MANAGER_PORT, I2C_MANAGER_SCL_PIN, GPIO_PIN_SET);
+		prvHalfClockDelay();
+	}
+
+	//4. STOP: SDA from low to high while SCL is high
+	HAL_GPIO_WritePin(I2C_MANAGER_PORT, I2C_MANAGER_SCL_PIN, GPIO_PIN_RESET);
+	prvHalfClockDelay();
+	HAL_GPIO_WritePin(I2C_MANAGER_PORT, I2C_MANAGER_SDA_PIN, GPIO_PIN_RESET);
+	prvHalfClockDelay();
+	HAL_GPIO_WritePin(I2C_MANAGER_PORT, I2C_MANAGER_SCL_PIN, GPIO_PIN_SET);
+	prvHalfClockDelay();
+	HAL_GPIO_WritePin(I2C_MANAGER_PORT, I2C_MANAGER_SDA_PIN, GPIO_PIN_SET);
+	prvHalfClockDelay();
+
+	//5. Pins back to the I2C, which is enabled again. The HAL keeps the state of the stopped transfer and its lock.
+	prvInitPins(GPIO_MODE_AF_OD, GPIO_AF4_I2C1);
+	__HAL_I2C_ENABLE(&I2cHandle);
+
+	I2cHandle.State = HAL_I2C_STATE_READY;
+	I2cHandle.Mode = HAL_I2C_MODE_NONE;
+	I2cHandle.PreviousState = HAL_I2C_MODE_NONE;
+	I2cHandle.XferISR = NULL;
+	I2cHandle.ErrorCode = HAL_I2C_ERROR_NONE;
+	__HAL_UNLOCK(&I2cHandle);
+}
+
+//Half period of the SCL clock at 100 kHz
+static void prvHalfClockDelay(void)
+{
+	uint32_t ulStart = DWT->CYCCNT;
+
+	while((DWT->CYCCNT - ulStart) < (SystemCoreClock / 200000));
+}
+
+//Called from the timer task every I2C_MANAGER_TIMEOUT_MS
+static void prvTimeoutCallback(TimerHandle_t xTimer)
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	//The job cannot end while it is checked and the bus is cleared
+	NVIC_DisableIRQ(I2C1_EV_IRQn);
+	NVIC_DisableIRQ(I2C1_ER_IRQn);
+
+	/*
+	 * Same job, same phase and no byte transferred since the last check (XferCount of the HAL counts down
+	 * the bytes left): the bus has been stuck for more than one period. A long read which moves keeps going.
+	 */
+	if( (pxCurrentJob != NULL) && (ulJobStarts == ulCheckedStarts) &&
+		(pxCurrentJob->ucPhase == ucCheckedPhase) && (I2cHandle.XferCount == usCheckedCount) )
+	{
+		prvClearBus();
+		ulRecoveries++;
+
+		taskENTER_CRITICAL();
+		prvJobDone(I2C_JOB_TIMEOUT, &xHigherPriorityTaskWoken);
+		taskEXIT_CRITICAL();
+	}
+	ulCheckedStarts = ulJobStarts;
+	ucCheckedPhase = (pxCurrentJob != NULL) ? pxCurrentJob->ucPhase : 0;
+	usCheckedCount = I2cHandle.XferCount;
+
+	NVIC_EnableIRQ(I2C1_EV_IRQn);
+	NVIC_EnableIRQ(I2C1_ER_IRQn);
+
+	if(xHigherPriorityTaskWoken != pdFALSE)
+	{
+		taskYIELD();
+	}
+}
@@ -0,0 +1,459 @@
+/*
+ * I2cManagerExample.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * This application shows the I2C manager (I2cManager.c) with a simulated slave on the same board:
+ * I2C3 is a slave at SIM_SLAVE_ADDRESS with a map of SIM_SLAVE_REGISTERS registers, like a small sensor.
+ * Connect PB8 (I2C1 SCL) to PB13 (I2C3 SCL), and PB9 (I2C1 SDA) to PB14 (I2C3 SDA).
+ *
+ * The slave: a write sets the register pointer (first byte) and writes the next bytes from it; a read
+ * sends the registers from the pointer. SIM_REG_ID holds SIM_SLAVE_ID, and SIM_REG_SAMPLE is incremented
+ * at each read, like a new sample. When ucSlaveStuck is set, the slave does not answer its address:
+ * it holds SCL low until it is reset, like a slave which is locked up.
+ *
+ * The Test task checks the manager against the slave:
+ *   1. read of the identification register
+ *   2. write of 6 registers and read back
+ *   3. read from an address without slave: NACK
+ *   4. slave locked up: the job ends with a timeout and the bus is cleared; then the slave is reset
+ * Then it starts two tasks which use the bus at the same time: the Sensor task reads the sample registers
+ * and waits for its notification, the Control task writes a register with jobs which end in a callback.
+ * The Test task prints the numbers of jobs and errors every 2 seconds.
+ *
+ * The CPU runs at 32 MHz (MSI range 10): I2C_MANAGER_TIMING is for this clock.
+ * I2cManager.c has to be included in the build with this file, and HAL_I2C_MODULE_ENABLED and
+ * USE_HAL_I2C_REGISTER_CALLBACKS in stm32wbxx_hal_conf.h.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stm32wbxx.h"
+#include "stm32wbxx_nucleo.h"
+#include "stdio.h"
+#include "string.h"
+#include "I2cManager.h"
+
+//Simulated slave
+#define SIM_SLAVE_ADDRESS		0x42
+#define SIM_SLAVE_REGISTERS		16
+#define SIM_SLAVE_ID			0x5A
+#define SIM_REG_ID				0x00
+#define SIM_REG_SAMPLE			0x01
+#define SIM_REG_CONTROL			0x04
+#define SIM_REG_TEST			0x08
+
+//Address without slave
+#define ABSENT_ADDRESS			0x50
+
+//Task handles and functions
+TaskHandle_t xTestTask = NULL;
+TaskHandle_t xSensorTask = NULL;
+TaskHandle_t xControlTask = NULL;
+void vTestTaskFunction(void *params);
+void vSensorTaskFunction(void *params);
+void vControlTaskFunction(void *params);
+
+//UART Handle and Init types
+UART_HandleTypeDef Uart1;
+UART_InitTypeDef Uart1Init;
+GPIO_InitTypeDef GpioUARTpins;
+
+//Simulated slave on I2C3. Changed by its interrupts.
+static I2C_HandleTypeDef SlaveHandle;
+static uint8_t ucSlaveRegisters[SIM_SLAVE_REGISTERS];
+static uint8_t ucSlavePointer = 0;
+static uint8_t ucSlaveByte;
+static uint8_t ucSlaveFirstByte = 0;
+static volatile uint8_t ucSlaveStuck = 0;
+
+//Jobs of the Sensor and Control tasks, read by the Test task
+static volatile uint32_t ulSensorJobs = 0;
+static volatile uint32_t ulSensorErrors = 0;
+static volatile uint32_t ulControlJobs = 0;
+static volatile uint32_t ulControlErrors = 0;
+
+//Private helper functions and variables
+static void prvSetupClock(void);
+static void prvSetupUART(void);
+static BaseType_t prvSetupSlave(void);
+static void prvResetSlave(void);
+static void prvListen(void);
+static void prvPrintResult(const char *pcName, BaseType_t xPassed);
+static void prvControlCallback(I2cJob_t *pxJob);
+void printmsg(char *msg);
+char UsrMsg[250];
+
+
+int main()
+{
+	// Enable the DWT Cycle Count Register (SEGGER Settings)
+	DWT->CTRL |= (1 << 0);
+
+	// Private functions called to setup the Hardware. The clock first: the UART baud rate depends on it.
+	prvSetupClock();
+	prvSetupUART();
+
+	//Start Recording for SEGGER SystemView
+	SEGGER_SYSVIEW_Conf();
+	SEGGER_SYSVIEW_Start();
+
+	sprintf(UsrMsg,"Example of the interrupt driven I2C manager, with a simulated slave \r\n");
+	printmsg(UsrMsg);
+
+	if( (prvSetupSlave() == pdPASS) && (xI2cManagerInit() == pdPASS) )
+	{
+		//Create Test Task. It creates the Sensor and Control tasks after the tests.
+		xTaskCreate(vTestTaskFunction, "Test-Task", 384, NULL, 2, &xTestTask);
+
+		//Schedule the tasks
+		vTaskStartScheduler();
+	}
+	else
+	{
+		sprintf(UsrMsg, "I2C initialization failed... :( \r\n");
+		printmsg(UsrMsg);
+	}
+
+	/*
+	 * If scheduler can start the tasks and run them, the program will never reach here.
+	 * If the program comes to the below line, that means there was a problem while creating or scheduling the tasks
+	 */
+	for(;;);
+}
+
+
+void vTestTaskFunction(void *params)
+{
+	I2cJob_t xJob;
+	uint8_t ucWrite[6] = { 0x11, 0x22, 0x33, 0x44, 0x55, 0x66 };
+	uint8_t ucRead[6];
+	uint8_t ucId = 0;
+
+	//1. Identification
+	prvPrintResult("read ID", (xI2cReadRegister(SIM_SLAVE_ADDRESS, SIM_REG_ID, &ucId, 1) == pdPASS) && (ucId == SIM_SLAVE_ID));
+
+	//2. Write and read back. The job gives its duration: the time a blocking call would stall the task.
+	memset(ucRead, 0, sizeof(ucRead));
+	xJob.ucAddress = SIM_SLAVE_ADDRESS;
+	xJob.ucRead = 1;
+	xJob.usRegister = SIM_REG_TEST;
+	xJob.ucRegisterSize = 1;
+	xJob.pucData = ucRead;
+	xJob.usLength = sizeof(ucRead);
+	xJob.pxCallback = NULL;
+	xJob.pvContext = NULL;
+
+	prvPrintResult("write and read back", (xI2cWriteRegister(SIM_SLAVE_ADDRESS, SIM_REG_TEST, ucWrite, sizeof(ucWrite)) == pdPASS) &&
+				   (xI2cSubmit(&xJob) == pdPASS) && (xI2cWait(&xJob, portMAX_DELAY) == pdPASS) && (memcmp(ucWrite, ucRead, sizeof(ucRead)) == 0));
+	sprintf(UsrMsg, "  read of 6 bytes: %lu us on the bus \r\n", xJob.ulCycles / (SystemCoreClock / 1000000));
+	printmsg(UsrMsg);
+
+	//3. No slave
+	xJob.ucAddress = ABSENT_ADDRESS;
+	xI2cSubmit(&xJob);
+	xI2cWait(&xJob, portMAX_DELAY);
+	prvPrintResult("NACK without slave", xJob.ucStatus == I2C_JOB_NACK);
+
+	//4. Locked up slave: timeout and bus clear, then the slave is reset and answers again
+	ucSlaveStuck = 1;
+	xJob.ucAddress = SIM_SLAVE_ADDRESS;
+	xI2cSubmit(&xJob);
+	xI2cWait(&xJob, portMAX_DELAY);
+	prvPrintResult("timeout of a locked up slave", (xJob.ucStatus == I2C_JOB_TIMEOUT) && (ulI2cManagerRecoveries() == 1));
+
+	prvResetSlave();
+	prvPrintResult("read after the reset", (xI2cReadRegister(SIM_SLAVE_ADDRESS, SIM_REG_ID, &ucId, 1) == pdPASS) && (ucId == SIM_SLAVE_ID));
+
+	//Two tasks on the bus
+	xTaskCreate(vSensorTaskFunction, "Sensor-Task", configMINIMAL_STACK_SIZE, NULL, 3, &xSensorTask);
+	xTaskCreate(vControlTaskFunction, "Control-Task", configMINIMAL_STACK_SIZE, NULL, 3, &xControlTask);
+
+	while(1)
+	{
+		vTaskDelay(pdMS_TO_TICKS(2000));
+
+		sprintf(UsrMsg, "Sensor: %lu jobs, %lu errors   Control: %lu jobs, %lu errors   bus clears: %lu \r\n",
+				ulSensorJobs, ulSensorErrors, ulControlJobs, ulControlErrors, ulI2cManagerRecoveries());
+		printmsg(UsrMsg);
+	}
+}
+
+
+void vSensorTaskFunction(void *params)
+{
+	uint8_t ucSample[3];
+	TickType_t xLastWake = xTaskGetTickCount();
+
+	while(1)
+	{
+		vTaskDelayUntil(&xLastWake, pdMS_TO_TICKS(10));
+
+		//The task is blocked during the job: register address, restart and data are done by the interrupt
+		if(xI2cReadRegister(SIM_SLAVE_ADDRESS, SIM_REG_SAMPLE, ucSample, sizeof(ucSample)) == pdPASS)
+		{
+			ulSensorJobs++;
+		}
+		else
+		{
+			ulSensorErrors++;
+		}
+	}
+}
+
+
+void vControlTaskFunction(void *params)
+{
+	I2cJob_t xJob;
+	uint8_t ucValue = 0;
+
+	xJob.ucAddress = SIM_SLAVE_ADDRESS;
+	xJob.ucRead = 0;
+	xJob.usRegister = SIM_REG_CONTROL;
+	xJob.ucRegisterSize = 1;
+	xJob.pucData = &ucValue;
+	xJob.usLength = 1;
+	xJob.pxCallback = prvControlCallback;
+	xJob.pvContext = NULL;
+	xJob.ucDone = 1;
+
+	while(1)
+	{
+		vTaskDelay(pdMS_TO_TICKS(5));
+
+		//The job and its data belong to the manager until the callback: the previous one has to be done
+		if(xJob.ucDone != 0)
+		{
+			ucValue++;
+			xI2cSubmit(&xJob);
+		}
+	}
+}
+
+
+//Called from the I2C1 interrupt at the end of a job of the Control task
+static void prvControlCallback(I2cJob_t *pxJob)
+{
+	if(pxJob->ucStatus == I2C_JOB_OK)
+	{
+		ulControlJobs++;
+	}
+	else
+	{
+		ulControlErrors++;
+	}
+}
+
+static void prvPrintResult(const char *pcName, BaseType_t xPassed)
+{
+	sprintf(UsrMsg, "%-32s %s \r\n", pcName, (xPassed != pdFALSE) ? "passed" : "FAILED");
+	printmsg(UsrMsg);
+}
+
+
+static BaseType_t prvSetupSlave(void)
+{
+	GPIO_InitTypeDef GpioSlavePins;
+
+	memset(ucSlaveRegisters, 0, sizeof(ucSlaveRegisters));
+	ucSlaveRegisters[SIM_REG_ID] = SIM_SLAVE_ID;
+
+	//1. PB13 (SCL) and PB14 (SDA), open drain
+	__HAL_RCC_GPIOB_CLK_ENABLE();
+	memset(&GpioSlavePins, 0, sizeof(GpioSlavePins));
+	GpioSlavePins.Pin = GPIO_PIN_13 | GPIO_PIN_14;
+	GpioSlavePins.Mode = GPIO_MODE_AF_OD;
+	GpioSlavePins.Pull = GPIO_PULLUP;
+	GpioSlavePins.Speed = GPIO_SPEED_FREQ_LOW;
+	GpioSlavePins.Alternate = GPIO_AF4_I2C3;
+	HAL_GPIO_Init(GPIOB, &GpioSlavePins);
+
+	//2. I2C3 slave at SIM_SLAVE_ADDRESS
+	memset(&SlaveHandle, 0, sizeof(SlaveHandle));
+	SlaveHandle.Instance = I2C3;
+	SlaveHandle.Init.Timing = I2C_MANAGER_TIMING;
+	SlaveHandle.Init.OwnAddress1 = SIM_SLAVE_ADDRESS << 1;
+	SlaveHandle.Init.AddressingMode = I2C_ADDRESSINGMODE_7BIT;
+	SlaveHandle.Init.DualAddressMode = I2C_DUALADDRESS_DISABLE;
+	SlaveHandle.Init.OwnAddress2 = 0;
+	SlaveHandle.Init.OwnAddress2Masks = I2C_OA2_NOMASK;
+	SlaveHandle.Init.GeneralCallMode = I2C_GENERALCALL_DISABLE;
+	SlaveHandle.Init.NoStretchMode = I2C_NOSTRETCH_DISABLE;
+
+	if(HAL_I2C_Init(&SlaveHandle) != HAL_OK)
+	{
+		return pdFAIL;
+	}
+
+	NVIC_SetPriority(I2C3_EV_IRQn, I2C_MANAGER_IRQ_PRIORITY); //Priority should be less than or equal to configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY
+	NVIC_SetPriority(I2C3_ER_IRQn, I2C_MANAGER_IRQ_PRIORITY);
+	NVIC_EnableIRQ(I2C3_EV_IRQn);
+	NVIC_EnableIRQ(I2C3_ER_IRQn);
+
+	prvListen();
+	return pdPASS;
+}
+
+//Like a power cycle of the slave: I2C3 is disabled, which releases SCL, and initialized again
+static void prvResetSlave(void)
+{
+	NVIC_DisableIRQ(I2C3_EV_IRQn);
+	NVIC_DisableIRQ(I2C3_ER_IRQn);
+
+	HAL_I2C_DeInit(&SlaveHandle);
+	HAL_I2C_Init(&SlaveHandle);
+	ucSlaveStuck = 0;
+	prvListen();
+
+	NVIC_EnableIRQ(I2C3_EV_IRQn);
+	NVIC_EnableIRQ(I2C3_ER_IRQn);
+}
+
+static void prvListen(void)
+{
+	if(SlaveHandle.State == HAL_I2C_STATE_READY)
+	{
+		HAL_I2C_EnableListen_IT(&SlaveHandle);
+	}
+}
+
+void I2C3_EV_IRQHandler(void)
+{
+	HAL_I2C_EV_IRQHandler(&SlaveHandle);
+}
+
+void I2C3_ER_IRQHandler(void)
+{
+	HAL_I2C_ER_IRQHandler(&SlaveHandle);
+}
+
+//Called by HAL_I2C_Init() of the slave (the manager registers its own function)
+void HAL_I2C_MspInit(I2C_HandleTypeDef *hi2c)
+{
+	__HAL_RCC_I2C3_CLK_ENABLE();
+}
+
+//Called from the I2C3 interrupt when the master sends the address of the slave
+void HAL_I2C_AddrCallback(I2C_HandleTypeDef *hi2c, uint8_t TransferDirection, uint16_t AddrMatchCode)
+{
+	//Locked up: no transfer is prepared, the slave holds SCL low
+	if(ucSlaveStuck != 0)
+	{
+		return;
+	}
+
+	if(TransferDirection == I2C_DIRECTION_TRANSMIT)
+	{
+		//The master writes: register pointer, then the registers
+		ucSlaveFirstByte = 1;
+		HAL_I2C_Slave_Seq_Receive_IT(hi2c, &ucSlaveByte, 1, I2C_NEXT_FRAME);
+	}
+	else
+	{
+		//The master reads: the registers from the pointer, until it ends the transfer
+		ucSlaveRegisters[SIM_REG_SAMPLE]++;
+		HAL_I2C_Slave_Seq_Transmit_IT(hi2c, &ucSlaveRegisters[ucSlavePointer], SIM_SLAVE_REGISTERS - ucSlavePointer, I2C_LAST_FRAME);
+	}
+}
+
+//Called from the I2C3 interrupt for each byte written by the master
+void HAL_I2C_SlaveRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+	if(ucSlaveFirstByte != 0)
+	{
+		ucSlavePointer = ucSlaveByte % SIM_SLAVE_REGISTERS;
+		ucSlaveFirstByte = 0;
+	}
+	else
+	{
+		ucSlaveRegisters[ucSlavePointer] = ucSlaveByte;
+		ucSlavePointer = (ucSlavePointer + 1) % SIM_SLAVE_REGISTERS;
+	}
+
+	HAL_I2C_Slave_Seq_Receive_IT(hi2c, &ucSlaveByte, 1, I2C_NEXT_FRAME);
+}
+
+//Called from the I2C3 interrupt at the STOP
+void HAL_I2C_ListenCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+	prvListen();
+}
+
+//Called from the I2C3 interrupt: the NACK of the master at the end of a read, or the STOP while a byte is expected
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+	prvListen();
+}
+
+
+static void prvSetupClock(void)
+{
+	//MSI 4 MHz -> 32 MHz, which needs 1 flash wait state. I2C1 and I2C3 are clocked from it (PCLK1).
+	__HAL_FLASH_SET_LATENCY(FLASH_LATENCY_1);
+	while(__HAL_FLASH_GET_LATENCY() != FLASH_LATENCY_1);
+
+	__HAL_RCC_MSI_RANGE_CONFIG(RCC_MSIRANGE_10);
+	while(__HAL_RCC_GET_FLAG(RCC_FLAG_MSIRDY) == 0);
+
+	//SystemCoreClock is used by the kernel tick, SystemView and the UART baud rate
+	SystemCoreClockUpdate();
+}
+
+static void prvSetupUART(void)
+{
+	//1. Enable the UART1 and GPIOB Peripheral Clocks
+	__HAL_RCC_USART1_CLK_ENABLE();
+	__HAL_RCC_GPIOB_CLK_ENABLE();
+
+	//In UART connection with Virtual COM-port, PB6->TX and PB7->RX
+	//2. Alternate Functionality Configuration to make Port B pins work as UART pins
+
+	//Zeroing each and every member element of the structure.
+	memset(&GpioUARTpins, 0, sizeof(GpioUARTpins));
+	GpioUARTpins.Pin = GPIO_PIN_6 | GPIO_PIN_7;
+	GpioUARTpins.Mode = GPIO_MODE_AF_PP;
+	GpioUARTpins.Alternate = GPIO_AF7_USART1;
+	GpioUARTpins.Pull = GPIO_PULLUP;
+
+	HAL_GPIO_Init(GPIOB, &GpioUARTpins);
+
+	//3. Configure and initialize UART parameters
+
+	//Zeroing each and every member element of the structure.
+	memset(&Uart1Init, 0, sizeof(Uart1Init));
+	memset(&Uart1, 0, sizeof(Uart1));
+
+	//UART Initialization
+	Uart1Init.BaudRate = 115200;
+	Uart1Init.WordLength = UART_WORDLENGTH_8B;
+	Uart1Init.HwFlowCtl = UART_HWCONTROL_NONE;
+	Uart1Init.Mode = UART_MODE_TX_RX;
+	Uart1Init.Parity = UART_PARITY_NONE;
+	Uart1Init.StopBits = UART_STOPBITS_1;
+
+	Uart1.Init = Uart1Init;
+	Uart1.Instance = USART1;
+
+	//4. Initialize the UART peripheral
+	uint16_t UARTSetUpResult = HAL_UART_Init(&Uart1);
+
+	if(UARTSetUpResult == HAL_ERROR)
+	{
+		//printf("USART Initialization was not successful \n");
+	}
+
+}
+
+void printmsg(char *msg)
+{
+	HAL_UART_Transmit(&Uart1, (uint8_t *)msg, strlen(msg), 1);
+}
+
+//Implement the Idle Hook function
+void vApplicationIdleHook()
+{
+	//The CPU does not sleep: the duration of the jobs (ulCycles) is counted by the DWT cycle counter, stopped in sleep mode
+}
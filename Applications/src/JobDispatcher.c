@@ -0,0 +1,213 @@
+/*
+ * JobDispatcher.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * The job queue is a FreeRTOS queue of job descriptors. It is already a bounded queue for multiple
+ * producers and consumers with blocking on both sides, so a job costs one kernel call to post it
+ * and one to fetch it (instead of a queue send plus a semaphore give, and a take plus a receive).
+ *
+ * The submission time is stamped with the DWT cycle counter in the descriptor, so the worker can
+ * record the time the job waited in the queue.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "stm32wbxx.h"
+#include "JobDispatcher.h"
+
+typedef struct JobDescriptor
+{
+	JobFunction_t pxFunction;
+	void *pvParameter;
+	JobCompleteCallback_t pxCallback;
+	uint32_t ulTimestamp;
+}JobDescriptor_t;
+
+//Private helper functions
+static void prvWorkerTask(void *params);
+static void prvRecordSubmission(JobDispatcher_t *pxDispatcher, BaseType_t xResult);
+
+
+BaseType_t xJobDispatcherCreate(JobDispatcher_t *pxDispatcher, const char *pcName, UBaseType_t uxWorkerCount,
+		UBaseType_t uxQueueLength, UBaseType_t uxPriority)
+{
+	char cTaskName[configMAX_TASK_NAME_LEN];
+	UBaseType_t uxWorker, uxLength;
+
+	configASSERT( (uxWorkerCount > 0) && (uxWorkerCount <= JOB_DISPATCHER_MAX_WORKERS) );
+
+	pxDispatcher->uxWorkerCount = uxWorkerCount;
+	vJobDispatcherResetStats(pxDispatcher);
+
+	pxDispatcher->xJobQueue = xQueueCreate(uxQueueLength, sizeof(JobDescriptor_t));
+	if(pxDispatcher->xJobQueue == NULL)
+	{
+		return pdFAIL;
+	}
+
+	//Task name: pcName and the worker number
+	for(uxLength = 0; (pcName[uxLength] != '\0') && (uxLength < (configMAX_TASK_NAME_LEN - 3)); uxLength++)
+	{
+		cTaskName[uxLength] = pcName[uxLength];
+	}
+	cTaskName[uxLength + 1] = '\0';
+
+	for(uxWorker = 0; uxWorker < uxWorkerCount; uxWorker++)
+	{
+		JobDispatcherWorker_t *pxWorker = &pxDispatcher->xWorkers[uxWorker];
+
+		pxWorker->pxDispatcher = pxDispatcher;
+		pxWorker->uxIndex = uxWorker;
+		cTaskName[uxLength] = (char)('0' + uxWorker);
+
+		if(xTaskCreate(prvWorkerTask, cTaskName, JOB_DISPATCHER_STACK_SIZE, pxWorker, uxPriority, &pxWorker->xHandle) != pdPASS)
+		{
+			return pdFAIL;
+		}
+	}
+
+	return pdPASS;
+}
+
+BaseType_t xJobDispatcherSubmit(JobDispatcher_t *pxDispatcher, JobFunction_t pxFunction, void *pvParameter,
+		JobCompleteCallback_t pxCallback, TickType_t xTicksToWait)
+{
+	JobDescriptor_t xJob;
+	BaseType_t xResult;
+
+	xJob.pxFunction = pxFunction;
+	xJob.pvParameter = pvParameter;
+	xJob.pxCallback = pxCallback;
+	xJob.ulTimestamp = DWT->CYCCNT;
+
+	//Backpressure: block here while all the queue slots are taken
+	xResult = xQueueSend(pxDispatcher->xJobQueue, &xJob, xTicksToWait);
+
+	taskENTER_CRITICAL();
+	prvRecordSubmission(pxDispatcher, xResult);
+	taskEXIT_CRITICAL();
+
+	return xResult;
+}
+
+BaseType_t xJobDispatcherSubmitFromISR(JobDispatcher_t *pxDispatcher, JobFunction_t pxFunction, void *pvParameter,
+		JobCompleteCallback_t pxCallback, BaseType_t *pxHigherPriorityTaskWoken)
+{
+	JobDescriptor_t xJob;
+	BaseType_t xResult;
+	UBaseType_t uxSavedInterruptStatus;
+
+	xJob.pxFunction = pxFunction;
+	xJob.pvParameter = pvParameter;
+	xJob.pxCallback = pxCallback;
+	xJob.ulTimestamp = DWT->CYCCNT;
+
+	xResult = xQueueSendFromISR(pxDispatcher->xJobQueue, &xJob, pxHigherPriorityTaskWoken);
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	prvRecordSubmission(pxDispatcher, xResult);
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+
+	return xResult;
+}
+
+UBaseType_t uxJobDispatcherPending(JobDispatcher_t *pxDispatcher)
+{
+	return uxQueueMessagesWaiting(pxDispatcher->xJobQueue);
+}
+
+void vJobDispatcherGetStats(JobDispatcher_t *pxDispatcher, JobDispatcherStats_t *pxStats)
+{
+	taskENTER_CRITICAL();
+	*pxStats = *(JobDispatcherStats_t *) &pxDispatcher->xStats;
+	taskEXIT_CRITICAL();
+}
+
+void vJobDispatcherResetStats(JobDispatcher_t *pxDispatcher)
+{
+	volatile JobDispatcherStats_t *pxStats = &pxDispatcher->xStats;
+	UBaseType_t uxWorker;
+
+	taskENTER_CRITICAL();
+	pxStats->ulSubmitted = 0;
+	pxStats->ulRejected = 0;
+	pxStats->ulCompleted = 0;
+	pxStats->ulMaxPending = 0;
+	pxStats->ulMinQueueWait = 0xFFFFFFFFUL;
+	pxStats->ulMaxQueueWait = 0;
+	pxStats->ullTotalQueueWait = 0;
+	pxStats->ullTotalRunTime = 0;
+	for(uxWorker = 0; uxWorker < JOB_DISPATCHER_MAX_WORKERS; uxWorker++)
+	{
+		pxStats->ulCompletedPerWorker[uxWorker] = 0;
+	}
+	taskEXIT_CRITICAL();
+}
+
+
+static void prvWorkerTask(void *params)
+{
+	JobDispatcherWorker_t *pxWorker = (JobDispatcherWorker_t *) params;
+	JobDispatcher_t *pxDispatcher = pxWorker->pxDispatcher;
+	volatile JobDispatcherStats_t *pxStats = &pxDispatcher->xStats;
+	JobDescriptor_t xJob;
+	BaseType_t xResult;
+	uint32_t ulStart, ulQueueWait;
+
+	while(1)
+	{
+		//An idle worker blocks here. Only one of the waiting workers gets each job.
+		xQueueReceive(pxDispatcher->xJobQueue, &xJob, portMAX_DELAY);
+
+		ulStart = DWT->CYCCNT;
+		ulQueueWait = ulStart - xJob.ulTimestamp;
+
+		xResult = xJob.pxFunction(xJob.pvParameter);
+
+		if(xJob.pxCallback != NULL)
+		{
+			xJob.pxCallback(xJob.pvParameter, xResult);
+		}
+
+		taskENTER_CRITICAL();
+		pxStats->ulCompleted++;
+		pxStats->ulCompletedPerWorker[pxWorker->uxIndex]++;
+		pxStats->ullTotalRunTime += (DWT->CYCCNT - ulStart);
+		pxStats->ullTotalQueueWait += ulQueueWait;
+		if(ulQueueWait < pxStats->ulMinQueueWait)
+		{
+			pxStats->ulMinQueueWait = ulQueueWait;
+		}
+		if(ulQueueWait > pxStats->ulMaxQueueWait)
+		{
+			pxStats->ulMaxQueueWait = ulQueueWait;
+		}
+		taskEXIT_CRITICAL();
+	}
+}
+
+//It must be called inside a critical section
+static void prvRecordSubmission(JobDispatcher_t *pxDispatcher, BaseType_t xResult)
+{
+	volatile JobDispatcherStats_t *pxStats = &pxDispatcher->xStats;
+	uint32_t ulPending;
+
+	if(xResult != pdPASS)
+	{
+		pxStats->ulRejected++;
+		return;
+	}
+
+	pxStats->ulSubmitted++;
+
+	ulPending = (uint32_t) uxQueueMessagesWaitingFromISR(pxDispatcher->xJobQueue);
+	if(ulPending > pxStats->ulMaxPending)
+	{
+		pxStats->ulMaxPending = ulPending;
+	}
+}
@@ -0,0 +1,235 @@
+/*
+ * JobDispatcherExample.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * This application is the Manager/Employee example (BinarySemaphore.c) with a pool of employees.
+ * The Manager task posts the work to the job dispatcher (JobDispatcher.c) and the first free
+ * Employee (worker task) takes it. When all the employees are busy and the queue is full,
+ * the Manager is blocked until an Employee takes the next job (backpressure).
+ * The throughput and the time the jobs waited in the queue are printed every 5 seconds.
+ *
+ * JobDispatcher.c and Random.c have to be included in the build with this file, and HAL_RNG_MODULE_ENABLED
+ * in stm32wbxx_hal_conf.h.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stm32wbxx.h"
+#include "stm32wbxx_nucleo.h"
+#include "stdio.h"
+#include "string.h"
+#include "JobDispatcher.h"
+#include "Random.h"
+
+#define EMPLOYEE_COUNT			3
+#define JOB_QUEUE_LENGTH		4
+#define MAX_WORK_MS				100
+#define REPORT_PERIOD_MS		5000
+
+//Task handles and functions
+TaskHandle_t xManagerTask = NULL;
+TaskHandle_t xReportTask = NULL;
+void vManagerTaskFunction(void *params);
+void vReportTaskFunction(void *params);
+
+//Job and completion callback
+BaseType_t xEmployeeWork(void *pvParameter);
+void vWorkDone(void *pvParameter, BaseType_t xResult);
+
+//Pool of Employee tasks
+JobDispatcher_t xEmployees;
+
+//UART Handle and Init types
+UART_HandleTypeDef Uart1;
+UART_InitTypeDef Uart1Init;
+GPIO_InitTypeDef GpioUARTpins;
+
+//Private helper functions and variables
+static void prvSetupUART(void);
+void printmsg(char *msg);
+char UsrMsg[250];
+volatile uint32_t ulWorkDoneMs = 0;
+
+int main()
+{
+	// Enable the DWT Cycle Count Register (SEGGER Settings)
+	DWT->CTRL |= (1 << 0);
+
+	// Private function called to setup the Hardware
+	prvSetupUART();
+
+	//Start Recording for SEGGER SystemView
+	SEGGER_SYSVIEW_Conf();
+	SEGGER_SYSVIEW_Start();
+
+	sprintf(UsrMsg,"Example of a Manager task dispatching the work to a pool of Employee tasks \r\n");
+	printmsg(UsrMsg);
+
+	//Random work durations of the Manager task
+	xRandomInit();
+
+	if(xJobDispatcherCreate(&xEmployees, "Employee-", EMPLOYEE_COUNT, JOB_QUEUE_LENGTH, 2) == pdPASS)
+	{
+		//Create Manager Task. It will be higher priority task
+		xTaskCreate(vManagerTaskFunction, "Manager-Task", configMINIMAL_STACK_SIZE, NULL, 3, &xManagerTask);
+
+		//Create Report Task. It prints the statistics.
+		xTaskCreate(vReportTaskFunction, "Report-Task", 512, NULL, 4, &xReportTask);
+
+		//Schedule the tasks
+		vTaskStartScheduler();
+	}
+	else
+	{
+		sprintf(UsrMsg, "Job dispatcher creation failed... :( \r\n");
+		printmsg(UsrMsg);
+	}
+
+	/*
+	 * If scheduler can start the tasks and run them, the program will never reach here.
+	 * If the program comes to the below line, that means there was a problem while creating or scheduling the tasks
+	 */
+	for(;;);
+}
+
+
+void vManagerTaskFunction(void *params)
+{
+	uint32_t ulWorkTime;
+	RandomStream_t xStream;
+
+	vRandomStreamInit(&xStream);
+
+	while(1)
+	{
+		//Get the duration of the next work (in ms). The value itself is the job parameter.
+		ulWorkTime = ulRandomRange(&xStream, MAX_WORK_MS) + 1;
+
+		//Blocks while all the Employees are busy and the queue is full
+		if(xJobDispatcherSubmit(&xEmployees, xEmployeeWork, (void *) ulWorkTime, vWorkDone, portMAX_DELAY) != pdPASS)
+		{
+			sprintf(UsrMsg, "Manager Task: Could not dispatch the work... :( \r\n");
+			printmsg(UsrMsg);
+		}
+	}
+}
+
+
+void vReportTaskFunction(void *params)
+{
+	JobDispatcherStats_t xStats;
+	uint32_t ulCyclesPerUs = SystemCoreClock / 1000000UL;
+	UBaseType_t uxEmployee;
+
+	while(1)
+	{
+		vJobDispatcherResetStats(&xEmployees);
+		ulWorkDoneMs = 0;
+
+		vTaskDelay(pdMS_TO_TICKS(REPORT_PERIOD_MS));
+
+		vJobDispatcherGetStats(&xEmployees, &xStats);
+
+		if(xStats.ulCompleted == 0)
+		{
+			continue;
+		}
+
+		//Throughput in jobs per second, and the work time done per second (it is at most EMPLOYEE_COUNT * 1000)
+		sprintf(UsrMsg, "\r\nThroughput: %lu jobs/s, %lu ms of work/s, %lu submitted, %lu rejected, max pending %lu \r\n",
+				xStats.ulCompleted / (REPORT_PERIOD_MS / 1000), ulWorkDoneMs / (REPORT_PERIOD_MS / 1000),
+				xStats.ulSubmitted, xStats.ulRejected, xStats.ulMaxPending);
+		printmsg(UsrMsg);
+
+		sprintf(UsrMsg, "Queue wait: min %lu us, avg %lu us, max %lu us \r\n",
+				xStats.ulMinQueueWait / ulCyclesPerUs,
+				(uint32_t)(xStats.ullTotalQueueWait / xStats.ulCompleted) / ulCyclesPerUs,
+				xStats.ulMaxQueueWait / ulCyclesPerUs);
+		printmsg(UsrMsg);
+
+		for(uxEmployee = 0; uxEmployee < EMPLOYEE_COUNT; uxEmployee++)
+		{
+			sprintf(UsrMsg, "Employee %lu: %lu jobs \r\n", uxEmployee, xStats.ulCompletedPerWorker[uxEmployee]);
+			printmsg(UsrMsg);
+		}
+	}
+}
+
+
+BaseType_t xEmployeeWork(void *pvParameter)
+{
+	//Block for some amount of time to work on the given task
+	vTaskDelay(pdMS_TO_TICKS((uint32_t) pvParameter));
+
+	return pdPASS;
+}
+
+void vWorkDone(void *pvParameter, BaseType_t xResult)
+{
+	//Called by the Employee which did the work. The Employees can run it concurrently.
+	taskENTER_CRITICAL();
+	ulWorkDoneMs += (uint32_t) pvParameter;
+	taskEXIT_CRITICAL();
+}
+
+
+static void prvSetupUART(void)
+{
+	//1. Enable the UART1 and GPIOB Peripheral Clocks
+	__HAL_RCC_USART1_CLK_ENABLE();
+	__HAL_RCC_GPIOB_CLK_ENABLE();
+
+	//In UART connection with Virtual COM-port, PB6->TX and PB7->RX
+	//2. Alternate Functionality Configuration to make Port B pins work as UART pins
+
+	//Zeroing each and every member element of the structure.
+	memset(&GpioUARTpins, 0, sizeof(GpioUARTpins));
+	GpioUARTpins.Pin = GPIO_PIN_6 | GPIO_PIN_7;
+	GpioUARTpins.Mode = GPIO_MODE_AF_PP;
+	GpioUARTpins.Alternate = GPIO_AF7_USART1;
+	GpioUARTpins.Pull = GPIO_PULLUP;
+
+	HAL_GPIO_Init(GPIOB, &GpioUARTpins);
+
+	//3. Configure and initialize UART parameters
+
+	//Zeroing each and every member element of the structure.
+	memset(&Uart1Init, 0, sizeof(Uart1Init));
+	memset(&Uart1, 0, sizeof(Uart1));
+
+	//UART Initialization
+	Uart1Init.BaudRate = 115200;
+	Uart1Init.WordLength = UART_WORDLENGTH_8B;
+	Uart1Init.HwFlowCtl = UART_HWCONTROL_NONE;
+	Uart1Init.Mode = UART_MODE_TX_RX;
+	Uart1Init.Parity = UART_PARITY_NONE;
+	Uart1Init.StopBits = UART_STOPBITS_1;
+
+	Uart1.Init = Uart1Init;
+	Uart1.Instance = USART1;
+
+	//4. Initialize the UART peripheral
+	uint16_t UARTSetUpResult = HAL_UART_Init(&Uart1);
+
+	if(UARTSetUpResult == HAL_ERROR)
+	{
+		//printf("USART Initialization was not successful \n");
+	}
+
+}
+
+void printmsg(char *msg)
+{
+	HAL_UART_Transmit(&Uart1, (uint8_t *)msg, strlen(msg), 1);
+}
+
+//Implement the Idle Hook function
+void vApplicationIdleHook()
+{
+	//Send the CPU to normal sleep mode
+	__WFI();
+}
@@ -0,0 +1,226 @@
+/*
+ * LowPower.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * LPUART1 and LPTIM1 are clocked by the LSE, which keeps running in STOP2. LPTIM1 counts continuously
+ * from 0 to 0xFFFF: before STOP2 the compare register is set to the wake-up time, and after STOP2 the
+ * counter gives the time spent in STOP2, whatever the interrupt which woke up the CPU. The LSE periods
+ * which do not make a full tick are carried to the next STOP2.
+ *
+ * The decision is taken with the interrupts masked (PRIMASK): an interrupt which becomes pending
+ * after the check still ends the WFI, so no wake-up is lost.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stm32wbxx.h"
+#include "stm32wbxx_hal.h"
+#include "stm32wbxx_ll_lptim.h"
+#include "stm32wbxx_ll_pwr.h"
+#include "string.h"
+#include "LowPower.h"
+
+#if ( configUSE_TICKLESS_IDLE != 2 )
+	#error "LowPower.c needs configUSE_TICKLESS_IDLE 2 in FreeRTOSConfig.h"
+#endif
+
+//LPTIM1 counts LSE periods
+#define LPTIM_COUNT_MASK			0xFFFF
+
+//Votes for the sleep mode. Changed in critical sections.
+static volatile uint32_t ulSleepVotes = 0;
+
+//LSE periods which did not make a full tick (remainder of the last conversion)
+static uint32_t ulCountRemainder = 0;
+
+static LowPowerStats_t xStats;
+
+//Private helper functions
+static uint32_t prvReadCounter(void);
+static void prvSetCompare(uint32_t ulCompare);
+
+
+BaseType_t xLowPowerInit(void)
+{
+	uint32_t ulStart;
+
+	//1. LSE (in the backup domain, which is write protected)
+	HAL_PWR_EnableBkUpAccess();
+	__HAL_RCC_LSE_CONFIG(RCC_LSE_ON);
+	ulStart = DWT->CYCCNT;
+	while(__HAL_RCC_GET_FLAG(RCC_FLAG_LSERDY) == 0)
+	{
+		if((DWT->CYCCNT - ulStart) > ((SystemCoreClock / 1000) * LOW_POWER_LSE_TIMEOUT_MS))
+		{
+			return pdFAIL;
+		}
+	}
+
+	//2. LPTIM1 on the LSE, counting continuously. IER can only be changed with the LPTIM disabled.
+	__HAL_RCC_LPTIM1_CONFIG(RCC_LPTIM1CLKSOURCE_LSE);
+	__HAL_RCC_LPTIM1_CLK_ENABLE();
+	LL_LPTIM_EnableIT_CMPM(LPTIM1);
+	LL_LPTIM_Enable(LPTIM1);
+	LL_LPTIM_SetAutoReload(LPTIM1, LPTIM_COUNT_MASK);
+	while(LL_LPTIM_IsActiveFlag_ARROK(LPTIM1) == 0);
+	LL_LPTIM_ClearFlag_ARROK(LPTIM1);
+	prvSetCompare(LPTIM_COUNT_MASK);
+	LL_LPTIM_StartCounter(LPTIM1, LL_LPTIM_OPERATING_MODE_CONTINUOUS);
+
+	NVIC_SetPriority(LPTIM1_IRQn, LOW_POWER_IRQ_PRIORITY); //Priority should be less than or equal to configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY
+	NVIC_EnableIRQ(LPTIM1_IRQn);
+
+	//3. The device enters STOP2 only if both CPUs allow it: CPU2 is not started, its mode is set here
+	LL_C2_PWR_SetPowerMode(LL_PWR_MODE_SHUTDOWN);
+
+	memset(&xStats, 0, sizeof(xStats));
+
+	return pdPASS;
+}
+
+
+void vLowPowerHoldSleep(void)
+{
+	UBaseType_t uxSavedInterruptStatus;
+
+	//The FromISR critical section works from a task too
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	ulSleepVotes++;
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+}
+
+
+void vLowPowerReleaseSleep(void)
+{
+	UBaseType_t uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	configASSERT(ulSleepVotes > 0);
+	ulSleepVotes--;
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+}
+
+
+void vLowPowerGetStats(LowPowerStats_t *pxStats)
+{
+	//Changed by the idle task with the interrupts masked
+	taskENTER_CRITICAL();
+	*pxStats = xStats;
+	memset(&xStats, 0, sizeof(xStats));
+	taskEXIT_CRITICAL();
+}
+
+
+void vLowPowerSuppressTicksAndSleep(TickType_t xExpectedIdleTime)
+{
+	uint32_t ulStartCount;
+	uint32_t ulElapsed;
+	uint32_t ulTicks;
+	TickType_t xStopTicks;
+
+	__disable_irq();
+
+	//A task was readied (or a context switch requested) since the idle task called this function
+	if(eTaskConfirmSleepModeStatus() == eAbortSleep)
+	{
+		__enable_irq();
+		return;
+	}
+
+	if( (ulSleepVotes > 0) || (xExpectedIdleTime < LOW_POWER_STOP2_MIN_TICKS) )
+	{
+		//Sleep mode: the SysTick and the peripheral clocks keep running
+		if(xExpectedIdleTime >= LOW_POWER_STOP2_MIN_TICKS)
+		{
+			xStats.ulVetoed++;
+		}
+		xStats.ulSleepEntries++;
+		__DSB();
+		__WFI();
+		__ISB();
+		__enable_irq();
+		return;
+	}
+
+	/*
+	 * STOP2 for the idle time minus one tick: after the wake-up the SysTick is restarted and
+	 * gives the last tick, so the tick count cannot pass the wake-up time of the next task.
+	 */
+	xStopTicks = xExpectedIdleTime - 1;
+	if(xStopTicks > LOW_POWER_MAX_STOP2_TICKS)
+	{
+		xStopTicks = LOW_POWER_MAX_STOP2_TICKS;
+	}
+
+	SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+
+	ulStartCount = prvReadCounter();
+	prvSetCompare((ulStartCount + ((xStopTicks * LSE_VALUE) / configTICK_RATE_HZ)) & LPTIM_COUNT_MASK);
+	LL_LPTIM_ClearFLAG_CMPM(LPTIM1);
+	NVIC_ClearPendingIRQ(LPTIM1_IRQn);
+
+	HAL_PWREx_EnterSTOP2Mode(PWR_STOPENTRY_WFI);
+
+	//Time in STOP2, whatever woke up the CPU
+	ulElapsed = (prvReadCounter() - ulStartCount) & LPTIM_COUNT_MASK;
+	if(LL_LPTIM_IsActiveFlag_CMPM(LPTIM1) == 0)
+	{
+		xStats.ulEarlyWakeups++;
+	}
+
+	ulElapsed = (ulElapsed * configTICK_RATE_HZ) + ulCountRemainder;
+	ulTicks = ulElapsed / LSE_VALUE;
+	ulCountRemainder = ulElapsed % LSE_VALUE;
+	if(ulTicks > xStopTicks)
+	{
+		ulTicks = xStopTicks;
+		ulCountRemainder = 0;
+	}
+	vTaskStepTick(ulTicks);
+
+	xStats.ulStop2Entries++;
+	xStats.ulStop2Ticks += ulTicks;
+
+	//Full tick period after the restart (the current period was spent in STOP2)
+	SysTick->VAL = 0;
+	SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+
+	//The interrupt which ended STOP2 runs now
+	__enable_irq();
+}
+
+
+void LPTIM1_IRQHandler(void)
+{
+	//Only wakes up the CPU. It also comes once per counter period while the CPU runs.
+	LL_LPTIM_ClearFLAG_CMPM(LPTIM1);
+}
+
+
+//The counter is not synchronized with the CPU clock: two equal reads give a valid value
+static uint32_t prvReadCounter(void)
+{
+	uint32_t ulFirst;
+	uint32_t ulSecond;
+
+	do
+	{
+		ulFirst = LL_LPTIM_GetCounter(LPTIM1);
+		ulSecond = LL_LPTIM_GetCounter(LPTIM1);
+	}while(ulFirst != ulSecond);
+
+	return ulFirst;
+}
+
+
+static void prvSetCompare(uint32_t ulCompare)
+{
+	//The previous write must have reached the LPTIM (CMPOK) before the next one
+	LL_LPTIM_SetCompare(LPTIM1, ulCompare);
+	while(LL_LPTIM_IsActiveFlag_CMPOK(LPTIM1) == 0);
+	LL_LPTIM_ClearFlag_CMPOK(LPTIM1);
+}
@@ -0,0 +1,235 @@
+/*
+ * LowPowerConsole.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * This application shows a console which works while the device sleeps in STOP2 (LpuartConsole.c),
+ * with the tickless idle of LowPower.c. Connect a 3.3V USB-serial adapter to PA2 (LPUART1 TX) and
+ * PA3 (LPUART1 RX), at 9600 baud 8N1. USART1 is not used: it does not run in STOP2.
+ *
+ * The Console task waits for a command line (characters are echoed, Enter runs the line):
+ *   help    list of the commands
+ *   stats   time spent in STOP2 and the numbers of wake-ups since the last stats
+ *   led     toggles LED1
+ *   echo x  prints x
+ * The Blink task flashes LED2 every 2 seconds. Between the flashes and the characters nothing runs:
+ * the idle task enters STOP2, unless the console is still sending (sleep mode until the end of the
+ * transmission). The first character of a line wakes up the CPU from STOP2 and is received.
+ *
+ * The CPU runs on the MSI at 4 MHz (reset clock): it wakes up from STOP2 on the same clock.
+ * LowPower.c and LpuartConsole.c have to be included in the build with this file, and configUSE_TICKLESS_IDLE
+ * set to 2 in FreeRTOSConfig.h.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stm32wbxx.h"
+#include "stm32wbxx_nucleo.h"
+#include "stdio.h"
+#include "string.h"
+#include "LowPower.h"
+#include "LpuartConsole.h"
+
+#if ( configUSE_TICKLESS_IDLE != 2 )
+	#error "LowPowerConsole.c needs configUSE_TICKLESS_IDLE 2 in FreeRTOSConfig.h"
+#endif
+
+#define LINE_SIZE				64
+#define BLINK_PERIOD_MS			2000
+#define BLINK_ON_MS				20
+
+//Task handles and functions
+TaskHandle_t xConsoleTask = NULL;
+TaskHandle_t xBlinkTask = NULL;
+void vConsoleTaskFunction(void *params);
+void vBlinkTaskFunction(void *params);
+
+GPIO_InitTypeDef GpioLEDpins;
+
+//Private helper functions and variables
+static void prvSetupLED(void);
+static void prvRunCommand(char *pcLine);
+static void prvPrintStats(void);
+void printmsg(char *msg);
+char UsrMsg[250];
+
+//Tick count at the last stats
+static TickType_t xStatsStart = 0;
+
+
+int main()
+{
+	// Enable the DWT Cycle Count Register (SEGGER Settings)
+	DWT->CTRL |= (1 << 0);
+
+	// Private function called to setup the Hardware. The console is set up with the LSE, below.
+	prvSetupLED();
+
+	//Start Recording for SEGGER SystemView
+	SEGGER_SYSVIEW_Conf();
+	SEGGER_SYSVIEW_Start();
+
+	if( (xLowPowerInit() == pdPASS) && (xLpuartConsoleInit() == pdPASS) )
+	{
+		//Sent when the scheduler runs (the LPUART interrupt is masked until then)
+		sprintf(UsrMsg,"Example of a console on LPUART1, with STOP2 in the idle time \r\nType help \r\n> ");
+		printmsg(UsrMsg);
+
+		//Create Console Task. It will be higher priority task, so a command is not delayed by the LED.
+		xTaskCreate(vConsoleTaskFunction, "Console-Task", 384, NULL, 2, &xConsoleTask);
+
+		//Create Blink Task
+		xTaskCreate(vBlinkTaskFunction, "Blink-Task", 256, NULL, 1, &xBlinkTask);
+
+		//Schedule the tasks
+		vTaskStartScheduler();
+	}
+	else
+	{
+		//No console without the LSE: LED3 shows the failure
+		HAL_GPIO_WritePin(LED3_GPIO_PORT, LED3_PIN, GPIO_PIN_SET);
+	}
+
+	/*
+	 * If scheduler can start the tasks and run them, the program will never reach here.
+	 * If the program comes to the below line, that means there was a problem while creating or scheduling the tasks
+	 */
+	for(;;);
+}
+
+
+void vConsoleTaskFunction(void *params)
+{
+	char cLine[LINE_SIZE];
+	uint32_t ulLength = 0;
+	uint8_t ucByte;
+
+	xStatsStart = xTaskGetTickCount();
+
+	while(1)
+	{
+		//Blocks without timeout: the CPU is in STOP2 until a character comes
+		if(xLpuartConsoleRead(&ucByte, 1, portMAX_DELAY) == 0)
+		{
+			continue;
+		}
+
+		if( (ucByte == '\r') || (ucByte == '\n') )
+		{
+			printmsg("\r\n");
+			cLine[ulLength] = '\0';
+			if(ulLength > 0)
+			{
+				prvRunCommand(cLine);
+			}
+			ulLength = 0;
+			printmsg("> ");
+		}
+		else if( (ucByte == '\b') || (ucByte == 0x7F) )
+		{
+			if(ulLength > 0)
+			{
+				ulLength--;
+				printmsg("\b \b");
+			}
+		}
+		else if( (ucByte >= ' ') && (ulLength < (LINE_SIZE - 1)) )
+		{
+			cLine[ulLength++] = (char) ucByte;
+			xLpuartConsoleWrite(&ucByte, 1, portMAX_DELAY);
+		}
+	}
+}
+
+
+void vBlinkTaskFunction(void *params)
+{
+	TickType_t xLastWakeTime = xTaskGetTickCount();
+
+	while(1)
+	{
+		//The tick count is stepped after STOP2, so the period stays right
+		vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(BLINK_PERIOD_MS));
+		HAL_GPIO_WritePin(LED2_GPIO_PORT, LED2_PIN, GPIO_PIN_SET);
+		vTaskDelay(pdMS_TO_TICKS(BLINK_ON_MS));
+		HAL_GPIO_WritePin(LED2_GPIO_PORT, LED2_PIN, GPIO_PIN_RESET);
+	}
+}
+
+
+static void prvRunCommand(char *pcLine)
+{
+	if(strcmp(pcLine, "help") == 0)
+	{
+		printmsg("help, stats, led, echo <text> \r\n");
+	}
+	else if(strcmp(pcLine, "stats") == 0)
+	{
+		prvPrintStats();
+	}
+	else if(strcmp(pcLine, "led") == 0)
+	{
+		HAL_GPIO_TogglePin(LED1_GPIO_PORT, LED1_PIN);
+	}
+	else if(strncmp(pcLine, "echo ", 5) == 0)
+	{
+		printmsg(&pcLine[5]);
+		printmsg("\r\n");
+	}
+	else
+	{
+		printmsg("Unknown command \r\n");
+	}
+}
+
+
+static void prvPrintStats(void)
+{
+	LowPowerStats_t xPower;
+	LpuartConsoleStats_t xConsole;
+	TickType_t xNow = xTaskGetTickCount();
+	uint32_t ulElapsed = xNow - xStatsStart;
+
+	xStatsStart = xNow;
+	vLowPowerGetStats(&xPower);
+	vLpuartConsoleGetStats(&xConsole);
+
+	sprintf(UsrMsg, "%lu ms: %lu ms in STOP2 (%lu%%), STOP2 %lu (early %lu), sleep %lu (kept from STOP2 %lu) \r\n",
+			ulElapsed, xPower.ulStop2Ticks, (ulElapsed > 0) ? ((xPower.ulStop2Ticks * 100) / ulElapsed) : 0,
+			xPower.ulStop2Entries, xPower.ulEarlyWakeups, xPower.ulSleepEntries, xPower.ulVetoed);
+	printmsg(UsrMsg);
+
+	sprintf(UsrMsg, "Console: %lu wake-ups, %lu bytes received, %lu dropped, %lu bytes sent \r\n",
+			xConsole.ulWakeups, xConsole.ulRxBytes, xConsole.ulRxDropped, xConsole.ulTxBytes);
+	printmsg(UsrMsg);
+}
+
+
+static void prvSetupLED(void)
+{
+	//LED1 (PB5), LED2 (PB0) and LED3 (PB1). The outputs keep their level in STOP2.
+	__HAL_RCC_GPIOB_CLK_ENABLE();
+
+	memset(&GpioLEDpins, 0, sizeof(GpioLEDpins));
+	GpioLEDpins.Pin = LED1_PIN | LED2_PIN | LED3_PIN;
+	GpioLEDpins.Mode = GPIO_MODE_OUTPUT_PP;
+	GpioLEDpins.Pull = GPIO_NOPULL;
+	GpioLEDpins.Speed = GPIO_SPEED_FREQ_LOW;
+
+	HAL_GPIO_Init(GPIOB, &GpioLEDpins);
+}
+
+
+void printmsg(char *msg)
+{
+	xLpuartConsoleWrite((uint8_t *)msg, strlen(msg), portMAX_DELAY);
+}
+
+
+void vApplicationIdleHook()
+{
+	//Nothing: the low power mode is chosen by vLowPowerSuppressTicksAndSleep(), which knows the idle time
+}
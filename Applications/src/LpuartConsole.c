@@ -0,0 +1,342 @@
+/*
+ * LpuartConsole.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * The LPUART is enabled in STOP mode (UESM) and its kernel clock is the LSE, so it receives while the
+ * CPU is in STOP2. The wake-up interrupt (WUF) only counts the wake-ups: the received byte comes with
+ * the receive interrupt, like when the CPU runs.
+ *
+ * Transmit: the writer copies its data into the ring and enables the TXE interrupt, which sends the ring
+ * byte by byte. When the ring is empty the TC interrupt waits for the end of the last byte, and only then
+ * the sleep vote is released. Receive: the interrupt puts the bytes in the receive ring; if it is full
+ * the byte is dropped.
+ *
+ * The ring indexes are free running counters, shared with the LPUART interrupt: they are updated in
+ * critical sections (the LPUART interrupt priority is masked by taskENTER_CRITICAL()).
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "stm32wbxx.h"
+#include "stm32wbxx_hal.h"
+#include "stm32wbxx_ll_lpuart.h"
+#include "string.h"
+#include "LowPower.h"
+#include "LpuartConsole.h"
+
+#define TX_RING_MASK				(LPUART_CONSOLE_TX_SIZE - 1)
+#define RX_RING_MASK				(LPUART_CONSOLE_RX_SIZE - 1)
+
+//Loops to wait for the acknowledge of the transmitter and receiver enables
+#define LPUART_ENABLE_TRIES			100000
+
+//Transmit ring: bytes from ulTxTail to ulTxHead
+static uint8_t ucTxRing[LPUART_CONSOLE_TX_SIZE];
+static volatile uint32_t ulTxHead = 0;
+static volatile uint32_t ulTxTail = 0;
+static uint8_t ucTxActive = 0;					//1 from the start of a transmission to its TC: the sleep vote is held
+static TaskHandle_t xTxWaitingTask = NULL;
+static SemaphoreHandle_t xTxMutex = NULL;
+
+//Receive ring: bytes from ulRxTail to ulRxHead
+static uint8_t ucRxRing[LPUART_CONSOLE_RX_SIZE];
+static volatile uint32_t ulRxHead = 0;
+static volatile uint32_t ulRxTail = 0;
+static TaskHandle_t xRxWaitingTask = NULL;
+
+static LpuartConsoleStats_t xStats;
+
+//Private helper functions
+static void prvStartTx(void);
+static void prvWakeTask(TaskHandle_t *pxTask, BaseType_t *pxHigherPriorityTaskWoken);
+
+
+BaseType_t xLpuartConsoleInit(void)
+{
+	GPIO_InitTypeDef GpioPins;
+	uint32_t ulTries = 0;
+
+	//The LPUART kernel clock: the LSE must run
+	if(__HAL_RCC_GET_FLAG(RCC_FLAG_LSERDY) == 0)
+	{
+		return pdFAIL;
+	}
+
+	xTxMutex = xSemaphoreCreateMutex();
+	if(xTxMutex == NULL)
+	{
+		return pdFAIL;
+	}
+
+	//1. PA2 (TX) and PA3 (RX), AF8. The pull-up keeps RX idle (high) when nothing is connected.
+	__HAL_RCC_GPIOA_CLK_ENABLE();
+	memset(&GpioPins, 0, sizeof(GpioPins));
+	GpioPins.Pin = GPIO_PIN_2 | GPIO_PIN_3;
+	GpioPins.Mode = GPIO_MODE_AF_PP;
+	GpioPins.Pull = GPIO_PULLUP;
+	GpioPins.Speed = GPIO_SPEED_FREQ_LOW;
+	GpioPins.Alternate = GPIO_AF8_LPUART1;
+	HAL_GPIO_Init(GPIOA, &GpioPins);
+
+	//2. LPUART1 clocked by the LSE. The wake-up settings can only be changed with the LPUART disabled.
+	__HAL_RCC_LPUART1_CONFIG(RCC_LPUART1CLKSOURCE_LSE);
+	__HAL_RCC_LPUART1_CLK_ENABLE();
+	LL_LPUART_Disable(LPUART1);
+	LL_LPUART_SetBaudRate(LPUART1, LSE_VALUE, LL_LPUART_PRESCALER_DIV1, LPUART_CONSOLE_BAUD_RATE);
+	LL_LPUART_ConfigCharacter(LPUART1, LL_LPUART_DATAWIDTH_8B, LL_LPUART_PARITY_NONE, LL_LPUART_STOPBITS_1);
+	LL_LPUART_SetTransferDirection(LPUART1, LL_LPUART_DIRECTION_TX_RX);
+	LL_LPUART_SetWKUPType(LPUART1, LPUART_CONSOLE_WAKEUP);
+	if(LPUART_CONSOLE_WAKEUP == LL_LPUART_WAKEUP_ON_ADDRESS)
+	{
+		LL_LPUART_ConfigNodeAddress(LPUART1, LL_LPUART_ADDRESS_DETECT_4B, LPUART_CONSOLE_ADDRESS);
+		LL_LPUART_SetWakeUpMethod(LPUART1, LL_LPUART_WAKEUP_ADDRESSMARK);
+		LL_LPUART_EnableMuteMode(LPUART1);
+	}
+	LL_LPUART_EnableInStopMode(LPUART1);
+	LL_LPUART_Enable(LPUART1);
+
+	while( ((LL_LPUART_IsActiveFlag_TEACK(LPUART1) == 0) || (LL_LPUART_IsActiveFlag_REACK(LPUART1) == 0)) && (ulTries < LPUART_ENABLE_TRIES) )
+	{
+		ulTries++;
+	}
+	if(ulTries == LPUART_ENABLE_TRIES)
+	{
+		return pdFAIL;
+	}
+
+	if(LPUART_CONSOLE_WAKEUP == LL_LPUART_WAKEUP_ON_ADDRESS)
+	{
+		LL_LPUART_RequestEnterMuteMode(LPUART1);
+	}
+
+	memset(&xStats, 0, sizeof(xStats));
+
+	//3. Interrupts: received byte and wake-up. The transmit ones are enabled by the writes.
+	LL_LPUART_ClearFlag_WKUP(LPUART1);
+	LL_LPUART_EnableIT_RXNE_RXFNE(LPUART1);
+	LL_LPUART_EnableIT_WKUP(LPUART1);
+	NVIC_SetPriority(LPUART1_IRQn, LPUART_CONSOLE_IRQ_PRIORITY); //Priority should be less than or equal to configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY
+	NVIC_EnableIRQ(LPUART1_IRQn);
+
+	return pdPASS;
+}
+
+
+size_t xLpuartConsoleWrite(const uint8_t *pucData, size_t xLength, TickType_t xTicksToWait)
+{
+	TimeOut_t xTimeOut;
+	size_t xSent = 0;
+	uint32_t ulFree, ulChunk, ulOffset, ulFirst;
+
+	vTaskSetTimeOutState(&xTimeOut);
+
+	//One writer at a time, so the messages of the tasks are not interleaved
+	if(xSemaphoreTake(xTxMutex, xTicksToWait) != pdPASS)
+	{
+		return 0;
+	}
+
+	while(xSent < xLength)
+	{
+		taskENTER_CRITICAL();
+		ulFree = LPUART_CONSOLE_TX_SIZE - (ulTxHead - ulTxTail);
+		if(ulFree == 0)
+		{
+			xTxWaitingTask = xTaskGetCurrentTaskHandle();
+		}
+		taskEXIT_CRITICAL();
+
+		if(ulFree == 0)
+		{
+			//Woken up by the interrupt which sends a byte from the ring
+			if(xTaskCheckForTimeOut(&xTimeOut, &xTicksToWait) != pdFALSE)
+			{
+				break;
+			}
+			ulTaskNotifyTakeIndexed(LPUART_CONSOLE_NOTIFY_INDEX, pdTRUE, xTicksToWait);
+			continue;
+		}
+
+		ulChunk = xLength - xSent;
+		if(ulChunk > ulFree)
+		{
+			ulChunk = ulFree;
+		}
+
+		//The free space can wrap around the end of the ring. The interrupt does not read it before ulTxHead is moved.
+		ulOffset = ulTxHead & TX_RING_MASK;
+		ulFirst = LPUART_CONSOLE_TX_SIZE - ulOffset;
+		if(ulFirst > ulChunk)
+		{
+			ulFirst = ulChunk;
+		}
+		memcpy(&ucTxRing[ulOffset], &pucData[xSent], ulFirst);
+		memcpy(&ucTxRing[0], &pucData[xSent + ulFirst], ulChunk - ulFirst);
+
+		taskENTER_CRITICAL();
+		ulTxHead += ulChunk;
+		prvStartTx();
+		taskEXIT_CRITICAL();
+
+		xSent += ulChunk;
+	}
+
+	xSemaphoreGive(xTxMutex);
+
+	return xSent;
+}
+
+
+size_t xLpuartConsoleRead(uint8_t *pucBuffer, size_t xLength, TickType_t xTicksToWait)
+{
+	TimeOut_t xTimeOut;
+	size_t xReceived = 0;
+	uint32_t ulCount;
+
+	vTaskSetTimeOutState(&xTimeOut);
+
+	while(xReceived < xLength)
+	{
+		taskENTER_CRITICAL();
+		ulCount = ulRxHead - ulRxTail;
+		if( (ulCount == 0) && (xReceived == 0) )
+		{
+			xRxWaitingTask = xTaskGetCurrentTaskHandle();
+		}
+		taskEXIT_CRITICAL();
+
+		if(ulCount == 0)
+		{
+			//Return what has been copied so far, or wait for the first byte
+			if( (xReceived != 0) || (xTaskCheckForTimeOut(&xTimeOut, &xTicksToWait) != pdFALSE) )
+			{
+				break;
+			}
+			ulTaskNotifyTakeIndexed(LPUART_CONSOLE_NOTIFY_INDEX, pdTRUE, xTicksToWait);
+			continue;
+		}
+
+		//Only this task moves ulRxTail, so the bytes stay in place
+		while( (ulCount > 0) && (xReceived < xLength) )
+		{
+			pucBuffer[xReceived++] = ucRxRing[ulRxTail & RX_RING_MASK];
+			ulCount--;
+			taskENTER_CRITICAL();
+			ulRxTail++;
+			taskEXIT_CRITICAL();
+		}
+	}
+
+	return xReceived;
+}
+
+
+void vLpuartConsoleGetStats(LpuartConsoleStats_t *pxStats)
+{
+	taskENTER_CRITICAL();
+	*pxStats = xStats;
+	taskEXIT_CRITICAL();
+}
+
+
+void LPUART1_IRQHandler(void)
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	uint8_t ucByte;
+
+	//1. Wake-up from STOP2 (start bit or address match)
+	if(LL_LPUART_IsActiveFlag_WKUP(LPUART1) != 0)
+	{
+		LL_LPUART_ClearFlag_WKUP(LPUART1);
+		xStats.ulWakeups++;
+	}
+
+	//2. Overrun: the byte in RDR is valid, the next one was lost
+	if(LL_LPUART_IsActiveFlag_ORE(LPUART1) != 0)
+	{
+		LL_LPUART_ClearFlag_ORE(LPUART1);
+		xStats.ulRxDropped++;
+	}
+
+	//3. Received byte. With a framing or noise error it is dropped.
+	if(LL_LPUART_IsActiveFlag_RXNE_RXFNE(LPUART1) != 0)
+	{
+		ucByte = LL_LPUART_ReceiveData8(LPUART1);
+		if( (LL_LPUART_IsActiveFlag_FE(LPUART1) != 0) || (LL_LPUART_IsActiveFlag_NE(LPUART1) != 0) )
+		{
+			LL_LPUART_ClearFlag_FE(LPUART1);
+			LL_LPUART_ClearFlag_NE(LPUART1);
+			xStats.ulRxDropped++;
+		}
+		else if((ulRxHead - ulRxTail) < LPUART_CONSOLE_RX_SIZE)
+		{
+			ucRxRing[ulRxHead & RX_RING_MASK] = ucByte;
+			ulRxHead++;
+			xStats.ulRxBytes++;
+			prvWakeTask(&xRxWaitingTask, &xHigherPriorityTaskWoken);
+		}
+		else
+		{
+			xStats.ulRxDropped++;
+		}
+	}
+
+	//4. Transmit register empty: next byte of the ring, or wait for the end of the last one
+	if( (LL_LPUART_IsEnabledIT_TXE_TXFNF(LPUART1) != 0) && (LL_LPUART_IsActiveFlag_TXE_TXFNF(LPUART1) != 0) )
+	{
+		if(ulTxHead != ulTxTail)
+		{
+			LL_LPUART_TransmitData8(LPUART1, ucTxRing[ulTxTail & TX_RING_MASK]);
+			ulTxTail++;
+			xStats.ulTxBytes++;
+			prvWakeTask(&xTxWaitingTask, &xHigherPriorityTaskWoken);
+		}
+		else
+		{
+			LL_LPUART_DisableIT_TXE_TXFNF(LPUART1);
+			LL_LPUART_EnableIT_TC(LPUART1);
+		}
+	}
+
+	//5. Transmission complete (the flag is read now: a byte written in step 4 clears it)
+	if( (LL_LPUART_IsEnabledIT_TC(LPUART1) != 0) && (LL_LPUART_IsActiveFlag_TC(LPUART1) != 0) )
+	{
+		LL_LPUART_DisableIT_TC(LPUART1);
+		LL_LPUART_ClearFlag_TC(LPUART1);
+		ucTxActive = 0;
+		vLowPowerReleaseSleep();
+	}
+
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+
+//Called in a critical section, after new bytes were put in the transmit ring
+static void prvStartTx(void)
+{
+	if(ucTxActive == 0)
+	{
+		//The ring is sent by the interrupt, which needs the CPU awake: sleep mode until the end
+		ucTxActive = 1;
+		vLowPowerHoldSleep();
+	}
+
+	//The TC interrupt is only wanted after the last byte
+	LL_LPUART_DisableIT_TC(LPUART1);
+	LL_LPUART_EnableIT_TXE_TXFNF(LPUART1);
+}
+
+
+static void prvWakeTask(TaskHandle_t *pxTask, BaseType_t *pxHigherPriorityTaskWoken)
+{
+	if(*pxTask != NULL)
+	{
+		vTaskNotifyGiveIndexedFromISR(*pxTask, LPUART_CONSOLE_NOTIFY_INDEX, pxHigherPriorityTaskWoken);
+		*pxTask = NULL;
+	}
+}
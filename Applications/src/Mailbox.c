@@ -0,0 +1,338 @@
+/*
+ * Mailbox.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * Ring of a side: ulHead counts the messages sent (written by the sender), ulTail the slots released
+ * (written by the receiver). The receiver also keeps ulRead, the messages received (in its own RAM): the
+ * messages between ulTail and ulRead are being used in place by the application.
+ *
+ * The message (and its type and length) is written before the new head, and read after it; a slot is
+ * released (new tail) after its last read. __DMB() keeps this order for the other core.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "stm32wbxx.h"
+#include "stm32wbxx_hal.h"
+#include "string.h"
+#include "Mailbox.h"
+
+#define MAILBOX_MAGIC				0x4D424F58UL			//"MBOX"
+
+//Ring of messages sent by one side
+typedef struct MailboxRing
+{
+	volatile uint32_t ulHead;
+	volatile uint32_t ulTail;
+	volatile uint16_t usType[MAILBOX_SLOTS];
+	volatile uint16_t usLength[MAILBOX_SLOTS];
+	uint8_t ucData[MAILBOX_SLOTS][MAILBOX_SLOT_SIZE] __attribute__((aligned(8)));
+}MailboxRing_t;
+
+//Shared memory. The control block (ulMagic to ulSlotSize) is changed only with the HSEM taken.
+typedef struct MailboxShared
+{
+	volatile uint32_t ulMagic;
+	volatile uint32_t ulUp[2];				//Side started
+	volatile uint32_t ulSlots;				//Geometry of the rings, checked by the other side
+	volatile uint32_t ulSlotSize;
+	MailboxRing_t xRings[2];				//Indexed by the sending side
+}MailboxShared_t;
+
+//State of a side, in the RAM of its core
+typedef struct MailboxSide
+{
+	uint32_t ulRead;
+	TaskHandle_t xSenderWaiting;
+	TaskHandle_t xReceiverWaiting;
+	SemaphoreHandle_t xTxMutex;
+	MailboxStats_t xStats;
+}MailboxSide_t;
+
+static MailboxShared_t xShared __attribute__((section("MB_MEM2")));
+static MailboxSide_t xSides[2];
+
+#if (MAILBOX_LOOPBACK == 0)
+static IPCC_HandleTypeDef IpccHandle;
+static void prvDoorbellCallback(IPCC_HandleTypeDef *hipcc, uint32_t ChannelIndex, IPCC_CHANNELDirTypeDef ChannelDir);
+#endif
+
+//Private helper functions
+static void prvRingDoorbell(uint8_t ucToSide);
+static void prvWakeSide(uint8_t ucSide, BaseType_t *pxHigherPriorityTaskWoken);
+
+
+BaseType_t xMailboxInit(void)
+{
+	uint8_t ucSide;
+	BaseType_t xResult;
+
+	//1. Local state of the sides
+	memset(xSides, 0, sizeof(xSides));
+	for(ucSide = MAILBOX_CPU1; ucSide <= MAILBOX_CPU2; ucSide++)
+	{
+		xSides[ucSide].xTxMutex = xSemaphoreCreateMutex();
+		if(xSides[ucSide].xTxMutex == NULL)
+		{
+			return pdFAIL;
+		}
+	}
+
+	//2. Control block and empty rings. Tasks of the same core are not kept out by the HSEM (it is taken per core).
+	__HAL_RCC_HSEM_CLK_ENABLE();
+	taskENTER_CRITICAL();
+	xResult = (HAL_HSEM_FastTake(MAILBOX_HSEM_ID) == HAL_OK) ? pdPASS : pdFAIL;
+	if(xResult == pdPASS)
+	{
+		memset((void *) &xShared, 0, sizeof(xShared));
+		xShared.ulSlots = MAILBOX_SLOTS;
+		xShared.ulSlotSize = MAILBOX_SLOT_SIZE;
+		xShared.ulUp[MAILBOX_CPU1] = 1;
+		xShared.ulUp[MAILBOX_CPU2] = (MAILBOX_LOOPBACK != 0) ? 1 : 0;
+		__DMB();
+		xShared.ulMagic = MAILBOX_MAGIC;
+		HAL_HSEM_Release(MAILBOX_HSEM_ID, 0);
+	}
+	taskEXIT_CRITICAL();
+
+	if(xResult != pdPASS)
+	{
+		return pdFAIL;
+	}
+
+#if (MAILBOX_LOOPBACK == 0)
+	//3. Doorbell from CPU2: IPCC RX occupied interrupt of the channel
+	__HAL_RCC_IPCC_CLK_ENABLE();
+	memset(&IpccHandle, 0, sizeof(IpccHandle));
+	IpccHandle.Instance = IPCC;
+	if( (HAL_IPCC_Init(&IpccHandle) != HAL_OK) ||
+		(HAL_IPCC_ActivateNotification(&IpccHandle, MAILBOX_IPCC_CHANNEL, IPCC_CHANNEL_DIR_RX, prvDoorbellCallback) != HAL_OK) )
+	{
+		return pdFAIL;
+	}
+
+	NVIC_SetPriority(IPCC_C1_RX_IRQn, MAILBOX_IRQ_PRIORITY); //Priority should be less than or equal to configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY
+	NVIC_EnableIRQ(IPCC_C1_RX_IRQn);
+#endif
+
+	return pdPASS;
+}
+
+
+void *pvMailboxAcquire(uint8_t ucSide, TickType_t xTicksToWait)
+{
+	MailboxSide_t *pxSide = &xSides[ucSide];
+	MailboxRing_t *pxRing = &xShared.xRings[ucSide];
+	TimeOut_t xTimeOut;
+	uint32_t ulFree;
+	BaseType_t xWaited = pdFALSE;
+
+	configASSERT( (ucSide == MAILBOX_CPU1) || (MAILBOX_LOOPBACK != 0) );
+
+	vTaskSetTimeOutState(&xTimeOut);
+
+	//One sender at a time, from here to vMailboxSend()
+	if(xSemaphoreTake(pxSide->xTxMutex, xTicksToWait) != pdPASS)
+	{
+		return NULL;
+	}
+
+	while(1)
+	{
+		taskENTER_CRITICAL();
+		ulFree = MAILBOX_SLOTS - (pxRing->ulHead - pxRing->ulTail);
+		if(ulFree == 0)
+		{
+			pxSide->xSenderWaiting = xTaskGetCurrentTaskHandle();
+		}
+		taskEXIT_CRITICAL();
+
+		if(ulFree != 0)
+		{
+			break;
+		}
+
+		if(xWaited == pdFALSE)
+		{
+			xWaited = pdTRUE;
+			pxSide->xStats.ulFullWaits++;
+		}
+
+		//Woken up by the doorbell of the other side, which releases a slot
+		if(xTaskCheckForTimeOut(&xTimeOut, &xTicksToWait) != pdFALSE)
+		{
+			xSemaphoreGive(pxSide->xTxMutex);
+			return NULL;
+		}
+		ulTaskNotifyTakeIndexed(MAILBOX_NOTIFY_INDEX, pdTRUE, xTicksToWait);
+	}
+
+	return pxRing->ucData[pxRing->ulHead % MAILBOX_SLOTS];
+}
+
+
+void vMailboxSend(uint8_t ucSide, uint16_t usType, uint16_t usLength)
+{
+	MailboxRing_t *pxRing = &xShared.xRings[ucSide];
+	uint32_t ulSlot = pxRing->ulHead % MAILBOX_SLOTS;
+
+	configASSERT(usLength <= MAILBOX_SLOT_SIZE);
+
+	pxRing->usType[ulSlot] = usType;
+	pxRing->usLength[ulSlot] = usLength;
+
+	//Only the sender writes the head: no critical section, the other side sees the message before the head
+	__DMB();
+	pxRing->ulHead++;
+
+	taskENTER_CRITICAL();
+	xSides[ucSide].xStats.ulSent++;
+	taskEXIT_CRITICAL();
+
+	xSemaphoreGive(xSides[ucSide].xTxMutex);
+	prvRingDoorbell(ucSide ^ 1);
+}
+
+
+BaseType_t xMailboxReceive(uint8_t ucSide, MailboxMessage_t *pxMessage, TickType_t xTicksToWait)
+{
+	MailboxSide_t *pxSide = &xSides[ucSide];
+	MailboxRing_t *pxRing = &xShared.xRings[ucSide ^ 1];
+	TimeOut_t xTimeOut;
+	uint32_t ulCount;
+	uint32_t ulSlot;
+
+	configASSERT( (ucSide == MAILBOX_CPU1) || (MAILBOX_LOOPBACK != 0) );
+
+	vTaskSetTimeOutState(&xTimeOut);
+
+	while(1)
+	{
+		taskENTER_CRITICAL();
+		ulCount = pxRing->ulHead - pxSide->ulRead;
+		if(ulCount == 0)
+		{
+			pxSide->xReceiverWaiting = xTaskGetCurrentTaskHandle();
+		}
+		taskEXIT_CRITICAL();
+
+		if(ulCount != 0)
+		{
+			break;
+		}
+
+		//Woken up by the doorbell of the other side, which sends a message
+		if(xTaskCheckForTimeOut(&xTimeOut, &xTicksToWait) != pdFALSE)
+		{
+			return pdFAIL;
+		}
+		ulTaskNotifyTakeIndexed(MAILBOX_NOTIFY_INDEX, pdTRUE, xTicksToWait);
+	}
+
+	//The message is read after the head
+	__DMB();
+	ulSlot = pxSide->ulRead % MAILBOX_SLOTS;
+	pxMessage->usType = pxRing->usType[ulSlot];
+	pxMessage->usLength = pxRing->usLength[ulSlot];
+	pxMessage->pvData = pxRing->ucData[ulSlot];
+
+	taskENTER_CRITICAL();
+	pxSide->ulRead++;
+	pxSide->xStats.ulReceived++;
+	taskEXIT_CRITICAL();
+
+	return pdPASS;
+}
+
+
+void vMailboxRelease(uint8_t ucSide, const MailboxMessage_t *pxMessage)
+{
+	MailboxRing_t *pxRing = &xShared.xRings[ucSide ^ 1];
+
+	//The oldest message received and not released
+	configASSERT(pxRing->ulTail != xSides[ucSide].ulRead);
+	configASSERT(pxMessage->pvData == pxRing->ucData[pxRing->ulTail % MAILBOX_SLOTS]);
+
+	//Only the receiver writes the tail: the sender writes the slot again after its last read
+	__DMB();
+	pxRing->ulTail++;
+
+	prvRingDoorbell(ucSide ^ 1);
+}
+
+
+void vMailboxGetStats(uint8_t ucSide, MailboxStats_t *pxStats)
+{
+	taskENTER_CRITICAL();
+	*pxStats = xSides[ucSide].xStats;
+	taskEXIT_CRITICAL();
+}
+
+
+//From a task: the other side checks its rings again
+static void prvRingDoorbell(uint8_t ucToSide)
+{
+#if (MAILBOX_LOOPBACK != 0)
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	//Both sides are on this core
+	taskENTER_CRITICAL();
+	prvWakeSide(ucToSide, &xHigherPriorityTaskWoken);
+	taskEXIT_CRITICAL();
+
+	if(xHigherPriorityTaskWoken)
+	{
+		taskYIELD();
+	}
+#else
+	//Occupied until CPU2 clears it: a doorbell rung before is not served yet, this one is served with it
+	configASSERT(ucToSide == MAILBOX_CPU2);
+	HAL_IPCC_NotifyCPU(&IpccHandle, MAILBOX_IPCC_CHANNEL, IPCC_CHANNEL_DIR_TX);
+#endif
+}
+
+
+//In a critical section or an interrupt
+static void prvWakeSide(uint8_t ucSide, BaseType_t *pxHigherPriorityTaskWoken)
+{
+	MailboxSide_t *pxSide = &xSides[ucSide];
+
+	pxSide->xStats.ulDoorbells++;
+
+	if(pxSide->xSenderWaiting != NULL)
+	{
+		vTaskNotifyGiveIndexedFromISR(pxSide->xSenderWaiting, MAILBOX_NOTIFY_INDEX, pxHigherPriorityTaskWoken);
+		pxSide->xSenderWaiting = NULL;
+	}
+	if(pxSide->xReceiverWaiting != NULL)
+	{
+		vTaskNotifyGiveIndexedFromISR(pxSide->xReceiverWaiting, MAILBOX_NOTIFY_INDEX, pxHigherPriorityTaskWoken);
+		pxSide->xReceiverWaiting = NULL;
+	}
+}
+
+
+#if (MAILBOX_LOOPBACK == 0)
+void IPCC_C1_RX_IRQHandler(void)
+{
+	HAL_IPCC_RX_IRQHandler(&IpccHandle);
+}
+
+
+//Doorbell of CPU2. The HAL masked the channel interrupt before this call.
+static void prvDoorbellCallback(IPCC_HandleTypeDef *hipcc, uint32_t ChannelIndex, IPCC_CHANNELDirTypeDef ChannelDir)
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	//Cleared (and unmasked) before the tasks check the rings: a doorbell rung from now on calls again
+	HAL_IPCC_NotifyCPU(hipcc, ChannelIndex, IPCC_CHANNEL_DIR_RX);
+	prvWakeSide(MAILBOX_CPU1, &xHigherPriorityTaskWoken);
+
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+#endif
@@ -0,0 +1,379 @@
+/*
+ * MailboxExample.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * This application shows the mailbox between CPU1 and CPU2 (Mailbox.c), with MAILBOX_LOOPBACK: the CPU2
+ * side is used by tasks on CPU1, as a firmware on CPU2 would use it.
+ *
+ * CPU1 side:
+ *   - the Work task offloads a block of words to CPU2 every WORK_PERIOD_MS: it writes it directly in the slot
+ *   - the Cpu1-Rx task receives the results (it checks the sum and measures the round trip in CPU cycles)
+ *     and the radio packets (it checks their content)
+ * CPU2 side:
+ *   - the Cpu2-Worker task sums the words in the slot of the request (not copied) and sends the result
+ *   - the Cpu2-Radio task sends a packet of 16 to 200 bytes every RADIO_PERIOD_MS, like received radio traffic
+ * The two senders of CPU2 share its ring. The Work task prints the statistics every 2 seconds.
+ *
+ * Mailbox.c has to be included in the build with this file, and HAL_HSEM_MODULE_ENABLED and
+ * HAL_IPCC_MODULE_ENABLED in stm32wbxx_hal_conf.h.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stm32wbxx.h"
+#include "stm32wbxx_nucleo.h"
+#include "stdio.h"
+#include "string.h"
+#include "Mailbox.h"
+
+#if (MAILBOX_LOOPBACK == 0)
+#error "MailboxExample.c runs both sides on CPU1: set MAILBOX_LOOPBACK to 1 in Mailbox.h"
+#endif
+
+//Types of the messages
+#define MSG_WORK				1
+#define MSG_RESULT				2
+#define MSG_RADIO				3
+
+#define WORK_PERIOD_MS			20
+#define WORK_WORDS				48
+#define RADIO_PERIOD_MS			50
+#define RADIO_MIN_SIZE			16
+#define RADIO_MAX_SIZE			200
+#define REPORT_LOOPS			(2000 / WORK_PERIOD_MS)
+
+typedef struct WorkRequest
+{
+	uint32_t ulNumber;
+	uint32_t ulStartCycles;
+	uint32_t ulData[WORK_WORDS];
+}WorkRequest_t;
+
+typedef struct WorkResult
+{
+	uint32_t ulNumber;
+	uint32_t ulStartCycles;
+	uint32_t ulSum;
+}WorkResult_t;
+
+typedef struct RadioPacket
+{
+	uint32_t ulNumber;
+	uint8_t ucPayload[RADIO_MAX_SIZE - 4];
+}RadioPacket_t;
+
+//Task handles and functions
+TaskHandle_t xWorkTask = NULL;
+TaskHandle_t xCpu1RxTask = NULL;
+TaskHandle_t xCpu2WorkerTask = NULL;
+TaskHandle_t xCpu2RadioTask = NULL;
+void vWorkTaskFunction(void *params);
+void vCpu1RxTaskFunction(void *params);
+void vCpu2WorkerTaskFunction(void *params);
+void vCpu2RadioTaskFunction(void *params);
+
+//UART Handle and Init types
+UART_HandleTypeDef Uart1;
+UART_InitTypeDef Uart1Init;
+GPIO_InitTypeDef GpioUARTpins;
+
+//Checked by the Cpu1-Rx task, printed by the Work task
+static volatile uint32_t ulResults = 0;
+static volatile uint32_t ulWrongResults = 0;
+static volatile uint32_t ulPackets = 0;
+static volatile uint32_t ulWrongPackets = 0;
+static volatile uint32_t ulRoundTripMax = 0;
+static volatile uint32_t ulRoundTripLast = 0;
+
+//Private helper functions and variables
+static void prvSetupUART(void);
+static void prvPrintStats(void);
+static uint32_t prvWorkSum(uint32_t ulNumber);
+static size_t prvRadioSize(uint32_t ulNumber);
+void printmsg(char *msg);
+char UsrMsg[250];
+
+
+int main()
+{
+	// Enable the DWT Cycle Count Register (SEGGER Settings)
+	DWT->CTRL |= (1 << 0);
+
+	// Private function called to setup the Hardware
+	prvSetupUART();
+
+	//Start Recording for SEGGER SystemView
+	SEGGER_SYSVIEW_Conf();
+	SEGGER_SYSVIEW_Start();
+
+	sprintf(UsrMsg,"Example of the mailbox between CPU1 and CPU2 (both sides on CPU1) \r\n");
+	printmsg(UsrMsg);
+
+	if(xMailboxInit() == pdPASS)
+	{
+		//Create the tasks of both sides. The receivers run above the senders.
+		xTaskCreate(vWorkTaskFunction, "Work-Task", 384, NULL, 2, &xWorkTask);
+		xTaskCreate(vCpu1RxTaskFunction, "Cpu1-Rx", 256, NULL, 3, &xCpu1RxTask);
+		xTaskCreate(vCpu2WorkerTaskFunction, "Cpu2-Worker", 256, NULL, 3, &xCpu2WorkerTask);
+		xTaskCreate(vCpu2RadioTaskFunction, "Cpu2-Radio", 256, NULL, 2, &xCpu2RadioTask);
+
+		//Schedule the tasks
+		vTaskStartScheduler();
+	}
+	else
+	{
+		sprintf(UsrMsg, "Mailbox initialization failed... :( \r\n");
+		printmsg(UsrMsg);
+	}
+
+	/*
+	 * If scheduler can start the tasks and run them, the program will never reach here.
+	 * If the program comes to the below line, that means there was a problem while creating or scheduling the tasks
+	 */
+	for(;;);
+}
+
+
+void vWorkTaskFunction(void *params)
+{
+	TickType_t xLastWakeTime = xTaskGetTickCount();
+	WorkRequest_t *pxRequest;
+	uint32_t ulNumber = 0;
+	uint32_t ulLoops = 0;
+	uint32_t i;
+
+	while(1)
+	{
+		vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(WORK_PERIOD_MS));
+
+		//The request is written in the slot: it is not copied on the way to CPU2
+		pxRequest = pvMailboxAcquire(MAILBOX_CPU1, pdMS_TO_TICKS(WORK_PERIOD_MS));
+		if(pxRequest != NULL)
+		{
+			pxRequest->ulNumber = ulNumber;
+			for(i = 0; i < WORK_WORDS; i++)
+			{
+				pxRequest->ulData[i] = (ulNumber * 31) + i;
+			}
+			pxRequest->ulStartCycles = DWT->CYCCNT;
+			vMailboxSend(MAILBOX_CPU1, MSG_WORK, sizeof(WorkRequest_t));
+			ulNumber++;
+		}
+
+		if((++ulLoops % REPORT_LOOPS) == 0)
+		{
+			prvPrintStats();
+		}
+	}
+}
+
+
+void vCpu1RxTaskFunction(void *params)
+{
+	MailboxMessage_t xMessage;
+	WorkResult_t *pxResult;
+	RadioPacket_t *pxPacket;
+	uint32_t ulCycles;
+	uint32_t i;
+
+	while(1)
+	{
+		xMailboxReceive(MAILBOX_CPU1, &xMessage, portMAX_DELAY);
+
+		if( (xMessage.usType == MSG_RESULT) && (xMessage.usLength == sizeof(WorkResult_t)) )
+		{
+			pxResult = xMessage.pvData;
+			ulCycles = DWT->CYCCNT - pxResult->ulStartCycles;
+			ulRoundTripLast = ulCycles;
+			if(ulCycles > ulRoundTripMax)
+			{
+				ulRoundTripMax = ulCycles;
+			}
+			if(pxResult->ulSum != prvWorkSum(pxResult->ulNumber))
+			{
+				ulWrongResults++;
+			}
+			ulResults++;
+		}
+		else if(xMessage.usType == MSG_RADIO)
+		{
+			pxPacket = xMessage.pvData;
+			//Shorter than the packet number: not even the number can be read
+			if( (xMessage.usLength < 4) || (xMessage.usLength != prvRadioSize(pxPacket->ulNumber)) )
+			{
+				ulWrongPackets++;
+			}
+			else
+			{
+				for(i = 0; i < ((uint32_t) xMessage.usLength - 4u); i++)
+				{
+					if(pxPacket->ucPayload[i] != (uint8_t) (pxPacket->ulNumber + i))
+					{
+						ulWrongPackets++;
+						break;
+					}
+				}
+			}
+			ulPackets++;
+		}
+
+		vMailboxRelease(MAILBOX_CPU1, &xMessage);
+	}
+}
+
+
+void vCpu2WorkerTaskFunction(void *params)
+{
+	MailboxMessage_t xMessage;
+	WorkRequest_t *pxRequest;
+	WorkResult_t *pxResult;
+	uint32_t ulSum;
+	uint32_t i;
+
+	while(1)
+	{
+		xMailboxReceive(MAILBOX_CPU2, &xMessage, portMAX_DELAY);
+		if( (xMessage.usType != MSG_WORK) || (xMessage.usLength != sizeof(WorkRequest_t)) )
+		{
+			vMailboxRelease(MAILBOX_CPU2, &xMessage);
+			continue;
+		}
+
+		//The words are read in the slot of CPU1
+		pxRequest = xMessage.pvData;
+		ulSum = 0;
+		for(i = 0; i < WORK_WORDS; i++)
+		{
+			ulSum += pxRequest->ulData[i];
+		}
+
+		//The result goes in a slot of CPU2, then the request slot is given back
+		pxResult = pvMailboxAcquire(MAILBOX_CPU2, portMAX_DELAY);
+		pxResult->ulNumber = pxRequest->ulNumber;
+		pxResult->ulStartCycles = pxRequest->ulStartCycles;
+		pxResult->ulSum = ulSum;
+		vMailboxRelease(MAILBOX_CPU2, &xMessage);
+		vMailboxSend(MAILBOX_CPU2, MSG_RESULT, sizeof(WorkResult_t));
+	}
+}
+
+
+void vCpu2RadioTaskFunction(void *params)
+{
+	TickType_t xLastWakeTime = xTaskGetTickCount();
+	RadioPacket_t *pxPacket;
+	uint32_t ulNumber = 0;
+	size_t xSize;
+	uint32_t i;
+
+	while(1)
+	{
+		vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(RADIO_PERIOD_MS));
+
+		pxPacket = pvMailboxAcquire(MAILBOX_CPU2, pdMS_TO_TICKS(RADIO_PERIOD_MS));
+		if(pxPacket != NULL)
+		{
+			xSize = prvRadioSize(ulNumber);
+			pxPacket->ulNumber = ulNumber;
+			for(i = 0; i < (xSize - 4); i++)
+			{
+				pxPacket->ucPayload[i] = (uint8_t) (ulNumber + i);
+			}
+			vMailboxSend(MAILBOX_CPU2, MSG_RADIO, xSize);
+			ulNumber++;
+		}
+	}
+}
+
+
+static void prvPrintStats(void)
+{
+	MailboxStats_t xCpu1;
+	MailboxStats_t xCpu2;
+
+	vMailboxGetStats(MAILBOX_CPU1, &xCpu1);
+	vMailboxGetStats(MAILBOX_CPU2, &xCpu2);
+
+	sprintf(UsrMsg, "Results %lu (%lu wrong), round trip %lu cycles (max %lu), packets %lu (%lu wrong) \r\n",
+			ulResults, ulWrongResults, ulRoundTripLast, ulRoundTripMax, ulPackets, ulWrongPackets);
+	printmsg(UsrMsg);
+	sprintf(UsrMsg, "CPU1: sent %lu, received %lu, full %lu. CPU2: sent %lu, received %lu, full %lu \r\n",
+			xCpu1.ulSent, xCpu1.ulReceived, xCpu1.ulFullWaits, xCpu2.ulSent, xCpu2.ulReceived, xCpu2.ulFullWaits);
+	printmsg(UsrMsg);
+}
+
+
+//Sum of the words of a request
+static uint32_t prvWorkSum(uint32_t ulNumber)
+{
+	return (WORK_WORDS * ulNumber * 31) + ((WORK_WORDS * (WORK_WORDS - 1)) / 2);
+}
+
+
+//Size of a radio packet: it depends on its number
+static size_t prvRadioSize(uint32_t ulNumber)
+{
+	return RADIO_MIN_SIZE + ((ulNumber * 23) % (RADIO_MAX_SIZE - RADIO_MIN_SIZE + 1));
+}
+
+
+static void prvSetupUART(void)
+{
+	//1. Enable the UART1 and GPIOB Peripheral Clocks
+	__HAL_RCC_USART1_CLK_ENABLE();
+	__HAL_RCC_GPIOB_CLK_ENABLE();
+
+	//In UART connection with Virtual COM-port, PB6->TX and PB7->RX
+	//2. Alternate Functionality Configuration to make Port B pins work as UART pins
+
+	//Zeroing each and every member element of the structure.
+	memset(&GpioUARTpins, 0, sizeof(GpioUARTpins));
+	GpioUARTpins.Pin = GPIO_PIN_6 | GPIO_PIN_7;
+	GpioUARTpins.Mode = GPIO_MODE_AF_PP;
+	GpioUARTpins.Alternate = GPIO_AF7_USART1;
+	GpioUARTpins.Pull = GPIO_PULLUP;
+
+	HAL_GPIO_Init(GPIOB, &GpioUARTpins);
+
+	//3. Configure and initialize UART parameters
+
+	//Zeroing each and every member element of the structure.
+	memset(&Uart1Init, 0, sizeof(Uart1Init));
+	memset(&Uart1, 0, sizeof(Uart1));
+
+	//UART Initialization
+	Uart1Init.BaudRate = 115200;
+	Uart1Init.WordLength = UART_WORDLENGTH_8B;
+	Uart1Init.HwFlowCtl = UART_HWCONTROL_NONE;
+	Uart1Init.Mode = UART_MODE_TX_RX;
+	Uart1Init.Parity = UART_PARITY_NONE;
+	Uart1Init.StopBits = UART_STOPBITS_1;
+
+	Uart1.Init = Uart1Init;
+	Uart1.Instance = USART1;
+
+	//4. Initialize the UART peripheral
+	uint16_t UARTSetUpResult = HAL_UART_Init(&Uart1);
+
+	if(UARTSetUpResult == HAL_ERROR)
+	{
+		//printf("USART Initialization was not successful \n");
+	}
+
+}
+
+void printmsg(char *msg)
+{
+	HAL_UART_Transmit(&Uart1, (uint8_t *)msg, strlen(msg), 1);
+}
+
+//Implement the Idle Hook function
+void vApplicationIdleHook()
+{
+	//Send the CPU to normal sleep mode
+	__WFI();
+}
@@ -13,7 +13,7 @@
 #include "stdio.h"
 #include "string.h"
 #include "semphr.h"
-#include "stdlib.h"
+#include "Random.h"
 
 //Task handles and functions
 xTaskHandle xTask1Handle;
@@ -49,6 +49,9 @@ int main()
 	sprintf(UsrMsg,"Example of Mutual Exclusion for synchronization between 2 Tasks using Binary Semaphore \r\n");
 	printmsg(UsrMsg);
 
+	//Random numbers of the tasks (Random.c has to be included in the build, and HAL_RNG_MODULE_ENABLED)
+	xRandomInit();
+
 	//Create the mutex
 	xMutex = xSemaphoreCreateMutex();;
 
@@ -61,9 +64,6 @@ int main()
 		//Give the Binary semaphore for the first time, so that it is available to the tasks.
 		xSemaphoreGive(xMutex);
 
-		//Initialize the srand function
-		srand(0);
-
 		//Schedule tasks
 		vTaskStartScheduler();
 
@@ -83,6 +83,10 @@ int main()
 void PrintFunction(void *params)
 {
 	char *Taskdata = (char *) params;
+	RandomStream_t xStream;
+
+	//Each task has its own stream: no shared state between the tasks
+	vRandomStreamInit(&xStream);
 
 	while(1)
 	{
@@ -93,7 +97,7 @@ void PrintFunction(void *params)
 
 		xSemaphoreGive(xMutex);
 
-		vTaskDelay(pdMS_TO_TICKS(rand() & 0xF));
+		vTaskDelay(pdMS_TO_TICKS(ulRandomNext(&xStream) & 0xF));
 	}
 }
 
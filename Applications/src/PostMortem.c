@@ -0,0 +1,315 @@
+/*
+ * PostMortem.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * The ring is the RTT up buffer of SystemView: SEGGER_SYSVIEW_Conf.h puts it in .noinit in post-mortem mode.
+ * Its write offset is in the RTT control block, which is cleared at the start: it is saved in the record
+ * when the ring is frozen. The ring is cleared before each recording, so a ring which has not wrapped yet
+ * holds only zeros after the newest byte: then the capture starts at the beginning of the ring, else at the
+ * write offset (the oldest byte, usually in the middle of a packet: the decoder starts at the first sync).
+ *
+ * The record is only trusted if its magic number and CRC-32 are right, and if it describes the ring of this
+ * firmware (a new firmware may place the ring elsewhere).
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stm32wbxx.h"
+#include "stddef.h"
+#include "stdio.h"
+#include "string.h"
+#include "SEGGER_RTT.h"
+#include "SEGGER_SYSVIEW.h"
+#include "SEGGER_SYSVIEW_ConfDefaults.h"
+#include "Crc32.h"
+#include "PostMortem.h"
+
+#if (SEGGER_SYSVIEW_POST_MORTEM_MODE != 1)
+	#error "PostMortem.c needs SEGGER_SYSVIEW_POST_MORTEM_MODE 1 in SEGGER_SYSVIEW_Conf.h"
+#endif
+
+#define RECORD_MAGIC				0x504D5254UL			//"PMRT"
+
+//Bits of SCB->CFSR: the address in MMFAR or BFAR is the one of the fault
+#define CFSR_MMARVALID				(1UL << 7)
+#define CFSR_BFARVALID				(1UL << 15)
+
+//Record of the crash, written when the ring is frozen
+typedef struct PostMortemRecord
+{
+	uint32_t ulMagic;
+	PostMortemInfo_t xInfo;
+	uint8_t *pucRing;						//Ring of the capture, and offset of its oldest byte
+	uint32_t ulRingSize;
+	uint32_t ulStart;
+	uint32_t ulCrc;							//CRC-32 of all the members above
+}PostMortemRecord_t;
+
+static PostMortemRecord_t xRecord __attribute__((section(".noinit")));
+static volatile BaseType_t xHeld = pdFALSE;
+
+static const char * const pcReasonNames[] = { "none", "hardfault", "assert", "request" };
+
+//Line of the dump
+static char cLine[120];
+
+//Private helper functions
+static SEGGER_RTT_BUFFER_UP *prvRing(void);
+static uint32_t prvRecordCrc(void);
+static void prvFreeze(PostMortemInfo_t *pxInfo);
+static void prvHardFaultHandler(uint32_t *pulFrame) __attribute__((used));
+
+
+void vPostMortemInit(void)
+{
+	SEGGER_RTT_BUFFER_UP *pxRing = prvRing();
+
+	//1. A capture of this ring kept across the reset
+	if( (xRecord.ulMagic == RECORD_MAGIC) && (xRecord.ulCrc == prvRecordCrc()) &&
+		(xRecord.pucRing == (uint8_t *) pxRing->pBuffer) && (xRecord.ulRingSize == pxRing->SizeOfBuffer) )
+	{
+		xRecord.xInfo.cFile[POST_MORTEM_FILE_NAME_LEN - 1] = '\0';
+		xRecord.xInfo.cTask[configMAX_TASK_NAME_LEN - 1] = '\0';
+		xHeld = pdTRUE;
+		return;
+	}
+
+	//2. None: record from an empty ring
+	memset(&xRecord, 0, sizeof(xRecord));
+	memset(pxRing->pBuffer, 0, pxRing->SizeOfBuffer);
+	SEGGER_SYSVIEW_Start();
+}
+
+
+BaseType_t xPostMortemHeld(PostMortemInfo_t *pxInfo)
+{
+	if(xHeld == pdFALSE)
+	{
+		return pdFALSE;
+	}
+
+	if(pxInfo != NULL)
+	{
+		*pxInfo = xRecord.xInfo;
+	}
+	return pdTRUE;
+}
+
+
+void vPostMortemDump(void (*pvWriteLine)(const char *pcLine))
+{
+	PostMortemInfo_t *pxInfo = &xRecord.xInfo;
+	uint32_t ulCrc = 0;
+	uint32_t ulOffset, ulIndex, ulCount, i;
+	char *pcHex;
+
+	if(xHeld == pdFALSE)
+	{
+		pvWriteLine("PM-NONE");
+		return;
+	}
+
+	//1. Header: the CRC-32 of the bytes in the order of the dump
+	ulCount = xRecord.ulRingSize - xRecord.ulStart;
+	if(ulCount > pxInfo->ulBytes)
+	{
+		ulCount = pxInfo->ulBytes;
+	}
+	ulCrc = ulCrc32Software(ulCrc, &xRecord.pucRing[xRecord.ulStart], ulCount);
+	ulCrc = ulCrc32Software(ulCrc, xRecord.pucRing, pxInfo->ulBytes - ulCount);
+
+	sprintf(cLine, "PM-BEGIN reason=%s bytes=%lu crc=%08lX later=%lu", pcReasonNames[pxInfo->ulReason],
+			pxInfo->ulBytes, ulCrc, pxInfo->ulLaterFaults);
+	pvWriteLine(cLine);
+
+	if(pxInfo->ulReason == POST_MORTEM_HARDFAULT)
+	{
+		sprintf(cLine, "PM-FAULT pc=%08lX lr=%08lX psr=%08lX cfsr=%08lX hfsr=%08lX addr=%08lX task=%s", pxInfo->ulPC,
+				pxInfo->ulLR, pxInfo->ulPSR, pxInfo->ulCFSR, pxInfo->ulHFSR, pxInfo->ulFaultAddress, pxInfo->cTask);
+		pvWriteLine(cLine);
+	}
+	else if(pxInfo->ulReason == POST_MORTEM_ASSERT)
+	{
+		sprintf(cLine, "PM-ASSERT file=%s line=%lu task=%s", pxInfo->cFile, pxInfo->ulLine, pxInfo->cTask);
+		pvWriteLine(cLine);
+	}
+
+	//2. The ring, from its oldest byte
+	for(ulOffset = 0; ulOffset < pxInfo->ulBytes; ulOffset += POST_MORTEM_LINE_BYTES)
+	{
+		pcHex = cLine + sprintf(cLine, "PM-DATA %04lX ", ulOffset);
+		for(i = 0; (i < POST_MORTEM_LINE_BYTES) && (ulOffset + i < pxInfo->ulBytes); i++)
+		{
+			ulIndex = (xRecord.ulStart + ulOffset + i) % xRecord.ulRingSize;
+			pcHex += sprintf(pcHex, "%02X", xRecord.pucRing[ulIndex]);
+		}
+		pvWriteLine(cLine);
+	}
+
+	pvWriteLine("PM-END");
+}
+
+
+void vPostMortemRelease(void)
+{
+	SEGGER_RTT_BUFFER_UP *pxRing = prvRing();
+
+	if(xHeld == pdFALSE)
+	{
+		return;
+	}
+
+	taskENTER_CRITICAL();
+	xHeld = pdFALSE;
+	memset(&xRecord, 0, sizeof(xRecord));
+	memset(pxRing->pBuffer, 0, pxRing->SizeOfBuffer);
+	pxRing->WrOff = 0;
+	pxRing->RdOff = 0;
+	taskEXIT_CRITICAL();
+
+	SEGGER_SYSVIEW_Start();
+}
+
+
+void vPostMortemFreeze(void)
+{
+	PostMortemInfo_t xInfo;
+
+	memset(&xInfo, 0, sizeof(xInfo));
+	xInfo.ulReason = POST_MORTEM_REQUEST;
+
+	taskENTER_CRITICAL();
+	prvFreeze(&xInfo);
+	taskEXIT_CRITICAL();
+}
+
+
+void vPostMortemAssert(const char *pcFile, uint32_t ulLine)
+{
+	PostMortemInfo_t xInfo;
+	size_t xLength = strlen(pcFile);
+
+	memset(&xInfo, 0, sizeof(xInfo));
+	xInfo.ulReason = POST_MORTEM_ASSERT;
+	xInfo.ulLine = ulLine;
+
+	//The end of the path: the name of the file
+	if(xLength >= POST_MORTEM_FILE_NAME_LEN)
+	{
+		pcFile += xLength - (POST_MORTEM_FILE_NAME_LEN - 1);
+	}
+	strncpy(xInfo.cFile, pcFile, POST_MORTEM_FILE_NAME_LEN - 1);
+
+	prvFreeze(&xInfo);
+
+#if (POST_MORTEM_RESET == 1)
+	NVIC_SystemReset();
+#endif
+}
+
+
+//Hard fault: the stacked registers are on the stack which was in use (MSP or PSP, bit 2 of EXC_RETURN)
+void HardFault_Handler(void) __attribute__((naked));
+void HardFault_Handler(void)
+{
+	__asm volatile
+	(
+		"	tst lr, #4				\n"
+		"	ite eq					\n"
+		"	mrseq r0, msp			\n"
+		"	mrsne r0, psp			\n"
+		"	b prvHardFaultHandler	\n"
+	);
+}
+
+//pulFrame: R0, R1, R2, R3, R12, LR, PC, xPSR of the faulting code
+static void prvHardFaultHandler(uint32_t *pulFrame)
+{
+	PostMortemInfo_t xInfo;
+
+	memset(&xInfo, 0, sizeof(xInfo));
+	xInfo.ulReason = POST_MORTEM_HARDFAULT;
+	xInfo.ulLR = pulFrame[5];
+	xInfo.ulPC = pulFrame[6];
+	xInfo.ulPSR = pulFrame[7];
+	xInfo.ulCFSR = SCB->CFSR;
+	xInfo.ulHFSR = SCB->HFSR;
+	if((xInfo.ulCFSR & CFSR_BFARVALID) != 0)
+	{
+		xInfo.ulFaultAddress = SCB->BFAR;
+	}
+	else if((xInfo.ulCFSR & CFSR_MMARVALID) != 0)
+	{
+		xInfo.ulFaultAddress = SCB->MMFAR;
+	}
+
+	prvFreeze(&xInfo);
+
+#if (POST_MORTEM_RESET == 1)
+	NVIC_SystemReset();
+#endif
+	for(;;);
+}
+
+
+static SEGGER_RTT_BUFFER_UP *prvRing(void)
+{
+	return &_SEGGER_RTT.aUp[SEGGER_SYSVIEW_RTT_CHANNEL];
+}
+
+static uint32_t prvRecordCrc(void)
+{
+	return ulCrc32Software(0, (const uint8_t *) &xRecord, offsetof(PostMortemRecord_t, ulCrc));
+}
+
+//With the interrupts masked
+static void prvFreeze(PostMortemInfo_t *pxInfo)
+{
+	SEGGER_RTT_BUFFER_UP *pxRing = prvRing();
+	uint8_t *pucRing = (uint8_t *) pxRing->pBuffer;
+	uint32_t ulWrite, i;
+
+	//A crash while a capture is held (e.g. while it is dumped) is only counted
+	if(xHeld != pdFALSE)
+	{
+		xRecord.xInfo.ulLaterFaults++;
+		xRecord.ulCrc = prvRecordCrc();
+		return;
+	}
+
+	if(xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED)
+	{
+		strncpy(pxInfo->cTask, pcTaskGetName(NULL), configMAX_TASK_NAME_LEN - 1);
+	}
+
+	//1. Last event in the ring, then the recording stops
+	SEGGER_SYSVIEW_Error(pcReasonNames[pxInfo->ulReason]);
+	SEGGER_SYSVIEW_Stop();
+
+	//2. Oldest byte: zeros after the newest byte up to the end, the ring has not wrapped
+	ulWrite = pxRing->WrOff;
+	for(i = ulWrite; (i < pxRing->SizeOfBuffer) && (pucRing[i] == 0); i++);
+
+	xRecord.pucRing = pucRing;
+	xRecord.ulRingSize = pxRing->SizeOfBuffer;
+	if(i == pxRing->SizeOfBuffer)
+	{
+		xRecord.ulStart = 0;
+		pxInfo->ulBytes = ulWrite;
+	}
+	else
+	{
+		xRecord.ulStart = ulWrite;
+		pxInfo->ulBytes = pxRing->SizeOfBuffer;
+	}
+
+	//3. Record
+	xRecord.xInfo = *pxInfo;
+	xRecord.ulMagic = RECORD_MAGIC;
+	xRecord.ulCrc = prvRecordCrc();
+	xHeld = pdTRUE;
+}
@@ -0,0 +1,301 @@
+/*
+ * PostMortemExample.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * This application records SystemView without a probe (PostMortem.c): the last events stay in a RAM ring
+ * which survives a crash and the reset after it.
+ *
+ * The Producer task sends a counter to the Consumer task every 5 ms, so the ring is always full of recent
+ * context switches. The Console task takes one character commands from the UART:
+ *   h: HardFault (undefined instruction, like a call through a corrupted function pointer)
+ *   a: failed configASSERT()
+ *   f: freeze the ring now, without reset
+ *   d: dump the held capture (PM-... lines, see PostMortem.h)
+ *   r: release the held capture and record again
+ * After h or a, the MCU is reset and the capture is announced at the start. Save the terminal output of the
+ * dump to a file and decode it on the host:
+ *   python3 Tools/postmortem_decode.py console.log -o crash.SVDat
+ * It prints the cause and the last events, and crash.SVDat can be opened in SystemView.
+ *
+ * It needs SEGGER_SYSVIEW_POST_MORTEM_MODE 1 in SEGGER_SYSVIEW_Conf.h and configUSE_POST_MORTEM 1 in
+ * FreeRTOSConfig.h. PostMortem.c and Crc32.c have to be included in the build with this file.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "stm32wbxx.h"
+#include "stm32wbxx_nucleo.h"
+#include "stdio.h"
+#include "string.h"
+#include "PostMortem.h"
+
+#if (configUSE_POST_MORTEM != 1)
+	#error "PostMortemExample.c needs configUSE_POST_MORTEM 1 in FreeRTOSConfig.h"
+#endif
+
+#define PRODUCER_PERIOD_MS		5
+#define DATA_QUEUE_LENGTH		4
+
+//Task handles and functions
+TaskHandle_t xProducerTask = NULL;
+TaskHandle_t xConsumerTask = NULL;
+TaskHandle_t xConsoleTask = NULL;
+void vProducerTaskFunction(void *params);
+void vConsumerTaskFunction(void *params);
+void vConsoleTaskFunction(void *params);
+
+//Queue from the Producer task to the Consumer task
+QueueHandle_t xDataQueue = NULL;
+
+//UART Handle and Init types
+UART_HandleTypeDef Uart1;
+UART_InitTypeDef Uart1Init;
+GPIO_InitTypeDef GpioUARTpins;
+
+//Private helper functions and variables
+static const char * const pcReasons[] = { "none", "HardFault", "configASSERT()", "freeze" };
+static void prvSetupUART(void);
+static void prvPrintCapture(void);
+static void prvWriteLine(const char *pcLine);
+void printmsg(char *msg);
+char UsrMsg[250];
+
+
+int main()
+{
+	// Enable the DWT Cycle Count Register (SEGGER Settings)
+	DWT->CTRL |= (1 << 0);
+
+	// Private functions called to setup the Hardware
+	prvSetupUART();
+
+	//SystemView in post-mortem mode: the recording starts unless a capture is held
+	SEGGER_SYSVIEW_Conf();
+	vPostMortemInit();
+
+	sprintf(UsrMsg,"Example of a post-mortem SystemView trace kept across a crash \r\n");
+	printmsg(UsrMsg);
+	prvPrintCapture();
+
+	xDataQueue = xQueueCreate(DATA_QUEUE_LENGTH, sizeof(uint32_t));
+
+	if(xDataQueue != NULL)
+	{
+		//Create the tasks
+		xTaskCreate(vProducerTaskFunction, "Producer", 256, NULL, 2, &xProducerTask);
+		xTaskCreate(vConsumerTaskFunction, "Consumer", 256, NULL, 3, &xConsumerTask);
+		xTaskCreate(vConsoleTaskFunction, "Console", 384, NULL, 1, &xConsoleTask);
+
+		//Schedule the tasks
+		vTaskStartScheduler();
+	}
+	else
+	{
+		sprintf(UsrMsg, "Queue creation failed... :( \r\n");
+		printmsg(UsrMsg);
+	}
+
+	/*
+	 * If scheduler can start the tasks and run them, the program will never reach here.
+	 * If the program comes to the below line, that means there was a problem while creating or scheduling the tasks
+	 */
+	for(;;);
+}
+
+
+void vProducerTaskFunction(void *params)
+{
+	TickType_t xLastWakeTime = xTaskGetTickCount();
+	uint32_t ulCounter = 0;
+
+	while(1)
+	{
+		vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(PRODUCER_PERIOD_MS));
+		ulCounter++;
+		xQueueSend(xDataQueue, &ulCounter, 0);
+	}
+}
+
+
+void vConsumerTaskFunction(void *params)
+{
+	uint32_t ulValue;
+	uint32_t ulSum = 0;
+
+	while(1)
+	{
+		xQueueReceive(xDataQueue, &ulValue, portMAX_DELAY);
+		ulSum += ulValue;
+	}
+}
+
+
+void vConsoleTaskFunction(void *params)
+{
+	uint32_t ulCommand;
+
+	printmsg("Commands: h (HardFault), a (assert), f (freeze), d (dump), r (release) \r\n");
+
+	//Receive the commands from now on
+	__HAL_UART_ENABLE_IT(&Uart1, UART_IT_RXNE);
+
+	while(1)
+	{
+		xTaskNotifyWait(0, 0, &ulCommand, portMAX_DELAY);
+
+		switch(ulCommand)
+		{
+		case 'h':
+			printmsg("HardFault... \r\n");
+			__asm volatile ("udf #0");
+			break;
+
+		case 'a':
+			printmsg("configASSERT()... \r\n");
+			configASSERT( ulCommand != 'a' );
+			break;
+
+		case 'f':
+			vPostMortemFreeze();
+			prvPrintCapture();
+			break;
+
+		case 'd':
+			vPostMortemDump(prvWriteLine);
+			break;
+
+		case 'r':
+			vPostMortemRelease();
+			printmsg("Capture released, recording again \r\n");
+			break;
+
+		default:
+			break;
+		}
+	}
+}
+
+
+static void prvPrintCapture(void)
+{
+	PostMortemInfo_t xInfo;
+
+	if(xPostMortemHeld(&xInfo) == pdFALSE)
+	{
+		printmsg("No capture held: recording \r\n");
+		return;
+	}
+
+	sprintf(UsrMsg, "Capture held: %s, %lu bytes, task '%s', %lu later crashes \r\n",
+			pcReasons[xInfo.ulReason], xInfo.ulBytes, xInfo.cTask, xInfo.ulLaterFaults);
+	printmsg(UsrMsg);
+
+	if(xInfo.ulReason == POST_MORTEM_HARDFAULT)
+	{
+		sprintf(UsrMsg, "PC 0x%08lX, LR 0x%08lX, CFSR 0x%08lX, HFSR 0x%08lX \r\n", xInfo.ulPC, xInfo.ulLR, xInfo.ulCFSR, xInfo.ulHFSR);
+		printmsg(UsrMsg);
+	}
+	else if(xInfo.ulReason == POST_MORTEM_ASSERT)
+	{
+		sprintf(UsrMsg, "configASSERT() at %s:%lu \r\n", xInfo.cFile, xInfo.ulLine);
+		printmsg(UsrMsg);
+	}
+
+	printmsg("The recording waits: d to dump, r to release \r\n");
+}
+
+static void prvWriteLine(const char *pcLine)
+{
+	printmsg((char *) pcLine);
+	printmsg("\r\n");
+}
+
+
+static void prvSetupUART(void)
+{
+	//1. Enable the UART1 and GPIOB Peripheral Clocks
+	__HAL_RCC_USART1_CLK_ENABLE();
+	__HAL_RCC_GPIOB_CLK_ENABLE();
+
+	//In UART connection with Virtual COM-port, PB6->TX and PB7->RX
+	//2. Alternate Functionality Configuration to make Port B pins work as UART pins
+
+	//Zeroing each and every member element of the structure.
+	memset(&GpioUARTpins, 0, sizeof(GpioUARTpins));
+	GpioUARTpins.Pin = GPIO_PIN_6 | GPIO_PIN_7;
+	GpioUARTpins.Mode = GPIO_MODE_AF_PP;
+	GpioUARTpins.Alternate = GPIO_AF7_USART1;
+	GpioUARTpins.Pull = GPIO_PULLUP;
+
+	HAL_GPIO_Init(GPIOB, &GpioUARTpins);
+
+	//3. Configure and initialize UART parameters
+
+	//Zeroing each and every member element of the structure.
+	memset(&Uart1Init, 0, sizeof(Uart1Init));
+	memset(&Uart1, 0, sizeof(Uart1));
+
+	//UART Initialization
+	Uart1Init.BaudRate = 115200;
+	Uart1Init.WordLength = UART_WORDLENGTH_8B;
+	Uart1Init.HwFlowCtl = UART_HWCONTROL_NONE;
+	Uart1Init.Mode = UART_MODE_TX_RX;
+	Uart1Init.Parity = UART_PARITY_NONE;
+	Uart1Init.StopBits = UART_STOPBITS_1;
+
+	Uart1.Init = Uart1Init;
+	Uart1.Instance = USART1;
+
+	//4. Initialize the UART peripheral
+	uint16_t UARTSetUpResult = HAL_UART_Init(&Uart1);
+
+	if(UARTSetUpResult == HAL_ERROR)
+	{
+		//printf("USART Initialization was not successful \n");
+	}
+
+	//5. Set the USART1 interrupt priority in NVIC (the RXNE interrupt is enabled by the Console task)
+	NVIC_SetPriority(USART1_IRQn, 6); //Priority should be less than or equal to configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY
+
+	//6. Enable the USART1 IRQ in NVIC
+	NVIC_EnableIRQ(USART1_IRQn);
+}
+
+void printmsg(char *msg)
+{
+	HAL_UART_Transmit(&Uart1, (uint8_t *)msg, strlen(msg), 1);
+}
+
+
+//One command character to the Console task
+void USART1_IRQHandler(void)
+{
+	uint8_t RxData;
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	if( __HAL_UART_GET_FLAG(&Uart1, UART_FLAG_ORE) )
+	{
+		__HAL_UART_CLEAR_OREFLAG(&Uart1);
+	}
+
+	if( __HAL_UART_GET_FLAG(&Uart1, UART_FLAG_RXNE) )
+	{
+		//Reading the data register clears the RXNE flag
+		RxData = (uint8_t)(Uart1.Instance->RDR & 0xFF);
+		xTaskNotifyFromISR(xConsoleTask, RxData, eSetValueWithOverwrite, &xHigherPriorityTaskWoken);
+	}
+
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+//Implement the Idle Hook function
+void vApplicationIdleHook()
+{
+	//Send the CPU to normal sleep mode
+	__WFI();
+}
@@ -5,6 +5,10 @@
  *      Author: Rahul
  */
 
+/*
+ * StackProfiler.c (STACK_REPORT command) and RtcClock.c (RTC commands) have to be included in the build with
+ * this file, and configCHECK_FOR_STACK_OVERFLOW 2 in FreeRTOSConfig.h for the overflow check of the tasks.
+ */
 
 #include "FreeRTOS.h"
 #include "task.h"
@@ -14,6 +18,8 @@
 #include "string.h"
 #include "queue.h"
 #include "timers.h"	//For software timers
+#include "StackProfiler.h"
+#include "RtcClock.h"
 
 //Macros
 #define TRUE 			1
@@ -26,8 +32,22 @@
 #define LED_TOGGLE_OFF_CMD		4
 #define LED_READ_STATUS_CMD		5
 #define RTC_PRINT_DATETIME_CMD	6
+#define STACK_REPORT_CMD		7
+#define RTC_SET_DATETIME_CMD	8
 #define EXIT_CMD				0
 
+/*
+ * Task stack sizes (in words): 4 x 500 words is 8KB of the 12KB heap.
+ * Size them down from the STACK_REPORT numbers measured on the board, after using all the commands.
+ */
+#define USART_WRITE_STACK_SIZE		500
+#define MENU_HANDLE_STACK_SIZE		500
+#define CMD_HANDLE_STACK_SIZE		500
+#define CMD_PROCESS_STACK_SIZE		500
+
+//Arguments of a command: the characters after the command number, e.g. "20261019123456" for RTC_SET_DATETIME
+#define CMD_ARGS_SIZE			16
+
 //Task handles and function prototypes
 TaskHandle_t xUSARTWriteTaskHandle = NULL;
 TaskHandle_t xMenuHandleTaskHandle = NULL;
@@ -48,15 +68,13 @@ QueueHandle_t UsartWriteQueueHandle = NULL;
 typedef struct AppCmd
 {
 	uint8_t CmdNumber;
-	uint8_t CmdArgs[10];
+	uint8_t CmdArgs[CMD_ARGS_SIZE];
 }AppCmd_t;
 
 //Variable related to peripherals
 GPIO_InitTypeDef GpioLEDpin, GpioUARTpins;
 UART_HandleTypeDef Uart1;
 UART_InitTypeDef Uart1Init;
-RTC_HandleTypeDef RTCHandle;
-RTC_InitTypeDef RTCInit;
 
 //Helper functions
 static void prvSetupRTC(void);
@@ -68,11 +86,12 @@ void LEDToggleStart(void);
 void LEDToggleStop(void);
 void PrintLEDStatus(char *LEDStatus);
 void PrintRTCInfo(char *RTCInfo);
+void SetRTCDateTime(uint8_t *CmdArgs);
 
 //Helper variables
 void printmsg(char *msg);
 char usr_msg[250];
-uint8_t CmdBuffer[20] = {0};
+uint8_t CmdBuffer[24] = {0};
 uint8_t CmdLength=0;
 char Menu[] = {"\
 \r\nLED_ON			---> 1 \
@@ -81,6 +100,8 @@ char Menu[] = {"\
 \r\nLED_TOGGLE_OFF		---> 4 \
 \r\nLED_READ_STATUS		---> 5 \
 \r\nRTC_PRINT_DATETIME	---> 6 \
+\r\nSTACK_REPORT		---> 7 \
+\r\nRTC_SET_DATETIME	---> 8 YYYYMMDDhhmmss \
 \r\nEXIT_APP		---> 0 \
 \r\nType your option here: " };
 
@@ -89,6 +110,9 @@ int main()
 	// Enable the DWT Cycle Count Register (SEGGER Settings)
 	DWT->CTRL |= (1 << 0);
 
+	//Fill the main stack with the pattern to measure its usage
+	vStackProfilerInit();
+
 	// Private function called to setup the Hardware
 	prvSetupLED();
 	prvSetupUART();
@@ -104,7 +128,7 @@ int main()
 	//Create queues ( Command queue and Usart queue)
 	/*
 	 * The below queue create statement creates a queue with size 10 words (40 bytes),
-	 * whereas xQueueCreate(10,sizeof(AppCmd_t)) creates queue with size of 110 bytes
+	 * whereas xQueueCreate(10,sizeof(AppCmd_t)) creates queue with size of 170 bytes
 	 */
 	AppCmdQueueHandle = xQueueCreate(10,sizeof(AppCmd_t *));
 	if(AppCmdQueueHandle == NULL)
@@ -123,10 +147,16 @@ int main()
 	}
 
 	//Create tasks
-	xTaskCreate(vUSARTWriteTaskFunction, "USART-Write", 500, NULL, 5, &xUSARTWriteTaskHandle);
-	xTaskCreate(vMenuHandleTaskFunction, "USARTRead-MenuPrint", 500, NULL, 4, &xMenuHandleTaskHandle);
-	xTaskCreate(vCmdHandleTaskFunction, "Command-Handling", 500, NULL, 5, &xCmdHandleTaskHandle);
-	xTaskCreate(vCmdProcessTaskFunction, "Command-Processing", 500, NULL, 5, &xCmdProcessTaskHandle);
+	xTaskCreate(vUSARTWriteTaskFunction, "USART-Write", USART_WRITE_STACK_SIZE, NULL, 5, &xUSARTWriteTaskHandle);
+	xTaskCreate(vMenuHandleTaskFunction, "USARTRead-MenuPrint", MENU_HANDLE_STACK_SIZE, NULL, 4, &xMenuHandleTaskHandle);
+	xTaskCreate(vCmdHandleTaskFunction, "Command-Handling", CMD_HANDLE_STACK_SIZE, NULL, 5, &xCmdHandleTaskHandle);
+	xTaskCreate(vCmdProcessTaskFunction, "Command-Processing", CMD_PROCESS_STACK_SIZE, NULL, 5, &xCmdProcessTaskHandle);
+
+	//Tell the stack profiler the stack sizes
+	vStackProfilerRegister(xUSARTWriteTaskHandle, USART_WRITE_STACK_SIZE);
+	vStackProfilerRegister(xMenuHandleTaskHandle, MENU_HANDLE_STACK_SIZE);
+	vStackProfilerRegister(xCmdHandleTaskHandle, CMD_HANDLE_STACK_SIZE);
+	vStackProfilerRegister(xCmdProcessTaskHandle, CMD_PROCESS_STACK_SIZE);
 
 	//Schedule the tasks
 	vTaskStartScheduler();
@@ -190,7 +220,7 @@ void vCmdProcessTaskFunction(void *params)
 {
 	AppCmd_t *CmdToProcess;
 	char *LEDStatus = NULL;
-	char RTCInfo[50];
+	char RTCInfo[64];
 	char *ErrorMsg = NULL;
 
 	while(1)
@@ -227,6 +257,17 @@ void vCmdProcessTaskFunction(void *params)
 				PrintRTCInfo(RTCInfo);
 				break;
 
+			case RTC_SET_DATETIME_CMD:
+				//Set the RTC, then print the new date and time
+				SetRTCDateTime(CmdToProcess->CmdArgs);
+				PrintRTCInfo(RTCInfo);
+				break;
+
+			case STACK_REPORT_CMD:
+				//Print the stack usage of all the tasks (directly, the report has several lines)
+				vStackProfilerPrintReport(printmsg);
+				break;
+
 			case EXIT_CMD:
 				//Delete the tasks
 				vTaskDelete(xUSARTWriteTaskHandle);
@@ -257,28 +298,12 @@ void vCmdProcessTaskFunction(void *params)
 
 static void prvSetupRTC(void)
 {
-	/*
-	 * Rahul - I should improve this to get the real-time date and time.
-	 */
-	//Enable the RTC peripheral clock
-	//__HAL_RCC_RTC_ENABLE();
-
-	/*
-	//Initialize the RTC
-	memset(&RTCInit, 0, sizeof(RTCInit));
-	memset(&RTCHandle, 0, sizeof(RTCHandle));
-
-	RTCInit.HourFormat = RTC_HOURFORMAT_24;
-	RTCInit.OutPut = RTC_OUTPUT_WAKEUP;
-	RTCInit.OutPutPolarity = RTC_OUTPUT_POLARITY_HIGH;
-	RTCInit.OutPutRemap = RTC_OUTPUT_REMAP_NONE;
-	RTCInit.OutPutType = RTC_OUTPUT_TYPE_PUSHPULL;
-
-	RTCHandle.Init = RTCInit;
-	RTCHandle.Instance = RTC;
-
- 	HAL_RTC_Init(&RTCHandle);
-	*/
+	//RTC on the LSE. It keeps running (and keeps the date and time) across the resets.
+	if(xRtcClockInit() != pdPASS)
+	{
+		sprintf(usr_msg, "\r\nRTC initialization failed... :( \r\n");
+		printmsg(usr_msg);
+	}
 }
 
 static void prvSetupLED(void)
@@ -376,7 +401,11 @@ void USART1_IRQHandler(void)
 		//Read the UART message
 		HAL_UART_Receive(&Uart1,&RxData, sizeof(uint8_t), 10);
 
-		CmdBuffer[CmdLength++] = RxData;
+		//The last byte of the buffer is kept for the Enter button: the characters before it are dropped
+		if( (CmdLength < (sizeof(CmdBuffer) - 1)) || (RxData == '\r') )
+		{
+			CmdBuffer[CmdLength++] = RxData;
+		}
 
 		if(RxData == '\r')
 		{
@@ -410,7 +439,19 @@ uint8_t getCommandCode(uint8_t *buffer)
 
 void getArguments(uint8_t *buffer)
 {
+	uint8_t i = 1;
+	uint8_t Length = 0;
 
+	//Copy the characters after the command number up to the Enter button, without the spaces
+	while( (i < sizeof(CmdBuffer)) && (CmdBuffer[i] != '\r') && (Length < (CMD_ARGS_SIZE - 1)) )
+	{
+		if(CmdBuffer[i] != ' ')
+		{
+			buffer[Length++] = CmdBuffer[i];
+		}
+		i++;
+	}
+	buffer[Length] = '\0';
 }
 
 void ToggleLED(TimerHandle_t xTimer)
@@ -459,18 +500,51 @@ void PrintLEDStatus(char *LEDStatus)
 
 void PrintRTCInfo(char *RCTInfo)
 {
-	RTC_TimeTypeDef TimeStructure;
-	RTC_DateTypeDef DateStructure;
+	char DateTime[RTC_CLOCK_TEXT_SIZE];
 
-	//We must call HAL_RTC_GetDate() after HAL_RTC_GetTime() to unlock the values/.
-	//(Check the RTC peripheral for more details)
-	HAL_RTC_GetTime(&RTCHandle, &TimeStructure, RTC_FORMAT_BIN);
-	HAL_RTC_GetDate(&RTCHandle, &DateStructure, RTC_FORMAT_BIN);
+	//Cached wall clock: no RTC register read here
+	xRtcClockFormat(ullRtcClockNowMs(), DateTime, sizeof(DateTime));
 
-	sprintf(RCTInfo, "\r\n Time: %02d:%02d:%02d \r\n Date: %02d/%02d/%04d \r\n", TimeStructure.Hours, TimeStructure.Minutes, TimeStructure.Seconds, DateStructure.Date, DateStructure.Month, DateStructure.Year);
+	sprintf(RCTInfo, "\r\n Date/Time: %s %s\r\n", DateTime, (xRtcClockIsSet() == pdTRUE) ? "" : "(not set) ");
 	xQueueSend(UsartWriteQueueHandle, &RCTInfo, portMAX_DELAY);
 }
 
+void SetRTCDateTime(uint8_t *CmdArgs)
+{
+	RtcDateTime_t DateTime;
+	uint32_t Digits[14];
+	uint8_t i;
+	char *ErrorMsg = "\r\n Invalid date/time, expected: 8 YYYYMMDDhhmmss \r\n";
+
+	//Exactly 14 digits
+	for(i = 0; i < 14; i++)
+	{
+		if( (CmdArgs[i] < '0') || (CmdArgs[i] > '9') )
+		{
+			break;
+		}
+		Digits[i] = CmdArgs[i] - '0';
+	}
+
+	if( (i == 14) && (CmdArgs[14] == '\0') )
+	{
+		DateTime.usYear = (Digits[0] * 1000) + (Digits[1] * 100) + (Digits[2] * 10) + Digits[3];
+		DateTime.ucMonth = (Digits[4] * 10) + Digits[5];
+		DateTime.ucDay = (Digits[6] * 10) + Digits[7];
+		DateTime.ucHours = (Digits[8] * 10) + Digits[9];
+		DateTime.ucMinutes = (Digits[10] * 10) + Digits[11];
+		DateTime.ucSeconds = (Digits[12] * 10) + Digits[13];
+		DateTime.usMilliseconds = 0;
+
+		if(xRtcClockSet(&DateTime) == pdPASS)
+		{
+			return;
+		}
+	}
+
+	xQueueSend(UsartWriteQueueHandle, &ErrorMsg, portMAX_DELAY);
+}
+
 //Implement the Idle Hook function
 void vApplicationIdleHook()
 {
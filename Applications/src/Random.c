@@ -0,0 +1,246 @@
+/*
+ * Random.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * The pool is a ring of RANDOM_POOL_WORDS words. The RNG interrupt adds one word per interrupt and starts
+ * the next one until the pool is full; the readers take the words in a critical section and restart the
+ * filling. Before the scheduler is started the interrupts can be masked, so the first filling is done by polling.
+ *
+ * The RNG is clocked by CLK48 / 3 (HSI48). An error of the RNG (seed or clock error) stops the filling;
+ * the RNG is restarted at the next read of the pool.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stm32wbxx.h"
+#include "stm32wbxx_hal.h"
+#include "string.h"
+#include "Random.h"
+
+//Loops to wait for one word of the RNG during the first filling
+#define RANDOM_INIT_TRIES			10000
+
+static RNG_HandleTypeDef RngHandle;
+static BaseType_t xRngReady = pdFALSE;
+
+//Pool: ulPoolCount words from ulPoolRead. Changed by the RNG interrupt and in critical sections.
+static uint32_t ulPool[RANDOM_POOL_WORDS];
+static uint32_t ulPoolRead = 0;
+static uint32_t ulPoolCount = 0;
+static uint8_t ucFilling = 0;
+static volatile uint32_t ulRngErrors = 0;
+
+//Private helper functions
+static void prvStartFilling(void);
+static uint32_t prvMix(uint32_t ulValue);
+static uint32_t prvRotateLeft(uint32_t ulValue, uint8_t ucBits);
+
+
+BaseType_t xRandomInit(void)
+{
+	uint32_t ulTries;
+	uint8_t i;
+
+	//1. The RNG is clocked by CLK48 (HSI48, the same source as the USB device)
+	__HAL_RCC_HSI48_ENABLE();
+	while(__HAL_RCC_GET_FLAG(RCC_FLAG_HSI48RDY) == 0);
+	__HAL_RCC_USB_CONFIG(RCC_USBCLKSOURCE_HSI48);
+	__HAL_RCC_RNG_CONFIG(RCC_RNGCLKSOURCE_CLK48);
+
+	RngHandle.Instance = RNG;
+	RngHandle.Init.ClockErrorDetection = RNG_CED_ENABLE;
+	if(HAL_RNG_Init(&RngHandle) != HAL_OK)
+	{
+		return pdFAIL;
+	}
+
+	//2. First filling by polling. No data after RANDOM_INIT_TRIES loops, or an error: the RNG is not used.
+	for(i = 0; i < RANDOM_POOL_WORDS; i++)
+	{
+		for(ulTries = 0; ulTries < RANDOM_INIT_TRIES; ulTries++)
+		{
+			if(__HAL_RNG_GET_FLAG(&RngHandle, RNG_FLAG_DRDY) != RESET)
+			{
+				break;
+			}
+		}
+
+		if( (ulTries == RANDOM_INIT_TRIES) || (__HAL_RNG_GET_FLAG(&RngHandle, RNG_FLAG_SECS) != RESET) ||
+			(__HAL_RNG_GET_FLAG(&RngHandle, RNG_FLAG_CECS) != RESET) )
+		{
+			ulPoolCount = 0;
+			return pdFAIL;
+		}
+
+		ulPool[i] = RngHandle.Instance->DR;
+		ulPoolCount++;
+	}
+
+	//3. Then the pool is filled again by interrupt
+	NVIC_SetPriority(RNG_IRQn, RANDOM_IRQ_PRIORITY); //Priority should be less than or equal to configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY
+	NVIC_EnableIRQ(RNG_IRQn);
+
+	xRngReady = pdTRUE;
+	return pdPASS;
+}
+
+size_t xRandomGetEntropy(uint32_t *pulWords, size_t xWords)
+{
+	UBaseType_t uxSavedInterruptStatus;
+	size_t xCopied = 0;
+
+	//The interrupt safe version masks the interrupts in a task too
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+
+	while( (xCopied < xWords) && (ulPoolCount != 0) )
+	{
+		pulWords[xCopied++] = ulPool[ulPoolRead];
+		ulPool[ulPoolRead] = 0;						//A word is given only once
+		ulPoolRead = (ulPoolRead + 1) % RANDOM_POOL_WORDS;
+		ulPoolCount--;
+	}
+	prvStartFilling();
+
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+
+	return xCopied;
+}
+
+void vRandomStreamInit(RandomStream_t *pxStream)
+{
+	size_t xWords;
+
+	xWords = xRandomGetEntropy(pxStream->ulState, 4);
+
+	//Pool empty (or no RNG): the missing words come from the cycle counter and the address of the stream
+	while(xWords < 4)
+	{
+		pxStream->ulState[xWords] = prvMix(DWT->CYCCNT ^ ((uint32_t) pxStream + xWords));
+		xWords++;
+	}
+
+	//The state must not be all zero (the generator would only return 0)
+	if( (pxStream->ulState[0] | pxStream->ulState[1] | pxStream->ulState[2] | pxStream->ulState[3]) == 0 )
+	{
+		pxStream->ulState[0] = 1;
+	}
+}
+
+//xoshiro128** (D. Blackman, S. Vigna)
+uint32_t ulRandomNext(RandomStream_t *pxStream)
+{
+	uint32_t *pulState = pxStream->ulState;
+	uint32_t ulResult = prvRotateLeft(pulState[1] * 5, 7) * 9;
+	uint32_t ulTemp = pulState[1] << 9;
+
+	pulState[2] ^= pulState[0];
+	pulState[3] ^= pulState[1];
+	pulState[1] ^= pulState[2];
+	pulState[0] ^= pulState[3];
+	pulState[2] ^= ulTemp;
+	pulState[3] = prvRotateLeft(pulState[3], 11);
+
+	return ulResult;
+}
+
+//Multiplication and rejection of the few values which make the result biased (D. Lemire)
+uint32_t ulRandomRange(RandomStream_t *pxStream, uint32_t ulRange)
+{
+	uint64_t ullProduct;
+	uint32_t ulThreshold;
+
+	if(ulRange == 0)
+	{
+		return 0;
+	}
+
+	ullProduct = (uint64_t) ulRandomNext(pxStream) * ulRange;
+	if((uint32_t) ullProduct < ulRange)
+	{
+		ulThreshold = (0 - ulRange) % ulRange;			//2^32 mod ulRange
+		while((uint32_t) ullProduct < ulThreshold)
+		{
+			ullProduct = (uint64_t) ulRandomNext(pxStream) * ulRange;
+		}
+	}
+
+	return (uint32_t)(ullProduct >> 32);
+}
+
+
+void RNG_IRQHandler(void)
+{
+	HAL_RNG_IRQHandler(&RngHandle);
+}
+
+//Called by HAL_RNG_Init()
+void HAL_RNG_MspInit(RNG_HandleTypeDef *hrng)
+{
+	__HAL_RCC_RNG_CLK_ENABLE();
+}
+
+//Called from the RNG interrupt with a new word
+void HAL_RNG_ReadyDataCallback(RNG_HandleTypeDef *hrng, uint32_t random32bit)
+{
+	if(ulPoolCount < RANDOM_POOL_WORDS)
+	{
+		ulPool[(ulPoolRead + ulPoolCount) % RANDOM_POOL_WORDS] = random32bit;
+		ulPoolCount++;
+	}
+
+	ucFilling = 0;
+	prvStartFilling();
+}
+
+//Called from the RNG interrupt on a seed or clock error. The words of this period are not used.
+void HAL_RNG_ErrorCallback(RNG_HandleTypeDef *hrng)
+{
+	__HAL_RNG_DISABLE_IT(hrng);
+	ulRngErrors++;
+	ucFilling = 0;
+}
+
+
+//Called from the RNG interrupt or in a critical section
+static void prvStartFilling(void)
+{
+	if( (xRngReady == pdFALSE) || (ucFilling != 0) || (ulPoolCount == RANDOM_POOL_WORDS) )
+	{
+		return;
+	}
+
+	//After an error, the RNG is restarted (the HAL keeps the error state and its lock)
+	if(RngHandle.State == HAL_RNG_STATE_ERROR)
+	{
+		__HAL_RNG_DISABLE(&RngHandle);
+		__HAL_RNG_ENABLE(&RngHandle);
+		RngHandle.State = HAL_RNG_STATE_READY;
+		__HAL_UNLOCK(&RngHandle);
+	}
+
+	if(HAL_RNG_GenerateRandomNumber_IT(&RngHandle) == HAL_OK)
+	{
+		ucFilling = 1;
+	}
+}
+
+//Finalizer of MurmurHash3: every bit of the input changes half of the bits of the result
+static uint32_t prvMix(uint32_t ulValue)
+{
+	ulValue ^= ulValue >> 16;
+	ulValue *= 0x85ebca6bUL;
+	ulValue ^= ulValue >> 13;
+	ulValue *= 0xc2b2ae35UL;
+	ulValue ^= ulValue >> 16;
+
+	return ulValue;
+}
+
+static uint32_t prvRotateLeft(uint32_t ulValue, uint8_t ucBits)
+{
+	return (ulValue << ucBits) | (ulValue >> (32 - ucBits));
+}
@@ -0,0 +1,243 @@
+/*
+ * RandomExample.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * This application shows the random number service (Random.c) which replaces rand() in the other examples
+ * (BinarySemaphore.c, MutexExample.c, CountingSemaphore.c and JobDispatcherExample.c). TimerWheelExample.c and
+ * DeferredWorkExample.c keep their small LCG with a fixed seed: their benchmarks need the same sequence every run.
+ *
+ * The Test task measures the CPU cycles of one call (DWT cycle counter) of rand(), of the streams
+ * (ulRandomNext() and ulRandomRange()) and of a read of the pool of true random words (xRandomGetEntropy()).
+ * The first call of rand() is measured alone: it sets up the state of rand() in the reentrancy structure.
+ * Then two Dice tasks roll dice with their own stream at the same time, and the RNG interrupt fills the
+ * pool again in the background.
+ *
+ * Random.c has to be included in the build with this file, and HAL_RNG_MODULE_ENABLED in stm32wbxx_hal_conf.h.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stm32wbxx.h"
+#include "stm32wbxx_nucleo.h"
+#include "stdio.h"
+#include "string.h"
+#include "stdlib.h"
+#include "Random.h"
+
+//Calls of each measurement
+#define BENCHMARK_CALLS			1000
+
+//Task handles and functions
+TaskHandle_t xTestTask = NULL;
+TaskHandle_t xDice1Task = NULL;
+TaskHandle_t xDice2Task = NULL;
+void vTestTaskFunction(void *params);
+void vDiceTaskFunction(void *params);
+
+//UART Handle and Init types
+UART_HandleTypeDef Uart1;
+UART_InitTypeDef Uart1Init;
+GPIO_InitTypeDef GpioUARTpins;
+
+//The results are written here, so that the calls are not removed by the compiler
+static volatile uint32_t ulSink;
+
+//Private helper functions and variables
+static void prvSetupUART(void);
+static void prvPrintCycles(const char *pcName, uint32_t ulCycles, uint32_t ulCalls);
+void printmsg(char *msg);
+char UsrMsg[250];
+
+
+int main()
+{
+	// Enable the DWT Cycle Count Register (SEGGER Settings)
+	DWT->CTRL |= (1 << 0);
+
+	// Private function called to setup the Hardware
+	prvSetupUART();
+
+	//Start Recording for SEGGER SystemView
+	SEGGER_SYSVIEW_Conf();
+	SEGGER_SYSVIEW_Start();
+
+	sprintf(UsrMsg,"Example of random numbers with the RNG and per task streams \r\n");
+	printmsg(UsrMsg);
+
+	//The streams work without the RNG too (seeded from the cycle counter)
+	if(xRandomInit() == pdPASS)
+	{
+		sprintf(UsrMsg, "RNG ready, pool of %u words filled \r\n", RANDOM_POOL_WORDS);
+	}
+	else
+	{
+		sprintf(UsrMsg, "RNG not available, streams seeded from the cycle counter \r\n");
+	}
+	printmsg(UsrMsg);
+
+	//Create Test Task. It creates the Dice tasks when the measurements are done.
+	xTaskCreate(vTestTaskFunction, "Test-Task", 256, NULL, 2, &xTestTask);
+
+	//Schedule the tasks
+	vTaskStartScheduler();
+
+	/*
+	 * If scheduler can start the tasks and run them, the program will never reach here.
+	 * If the program comes to the below line, that means there was a problem while creating or scheduling the tasks
+	 */
+	for(;;);
+}
+
+
+void vTestTaskFunction(void *params)
+{
+	RandomStream_t xStream;
+	uint32_t ulCycles, ulWord;
+	uint32_t i;
+
+	vRandomStreamInit(&xStream);
+
+	printmsg("\r\nCycles per call: \r\n");
+
+	//1. rand(): the first call, then the next ones
+	ulCycles = DWT->CYCCNT;
+	ulSink = (uint32_t) rand();
+	prvPrintCycles("rand(), first call", DWT->CYCCNT - ulCycles, 1);
+
+	ulCycles = DWT->CYCCNT;
+	for(i = 0; i < BENCHMARK_CALLS; i++)
+	{
+		ulSink = (uint32_t) rand();
+	}
+	prvPrintCycles("rand()", DWT->CYCCNT - ulCycles, BENCHMARK_CALLS);
+
+	//2. Stream of the task: no lock, no access to the RNG
+	ulCycles = DWT->CYCCNT;
+	for(i = 0; i < BENCHMARK_CALLS; i++)
+	{
+		ulSink = ulRandomNext(&xStream);
+	}
+	prvPrintCycles("ulRandomNext()", DWT->CYCCNT - ulCycles, BENCHMARK_CALLS);
+
+	ulCycles = DWT->CYCCNT;
+	for(i = 0; i < BENCHMARK_CALLS; i++)
+	{
+		ulSink = ulRandomRange(&xStream, 6);
+	}
+	prvPrintCycles("ulRandomRange(6)", DWT->CYCCNT - ulCycles, BENCHMARK_CALLS);
+
+	//3. Pool: critical section, and the RNG is restarted. The pool is not refilled as fast as it is read.
+	ulCycles = DWT->CYCCNT;
+	for(i = 0; i < RANDOM_POOL_WORDS; i++)
+	{
+		ulSink = xRandomGetEntropy(&ulWord, 1);
+	}
+	prvPrintCycles("xRandomGetEntropy(1 word)", DWT->CYCCNT - ulCycles, RANDOM_POOL_WORDS);
+
+	//Let the RNG interrupt fill the pool again before the Dice tasks seed their streams
+	vTaskDelay(pdMS_TO_TICKS(10));
+
+	xTaskCreate(vDiceTaskFunction, "Dice1-Task", configMINIMAL_STACK_SIZE, "Dice 1", 2, &xDice1Task);
+	xTaskCreate(vDiceTaskFunction, "Dice2-Task", configMINIMAL_STACK_SIZE, "Dice 2", 2, &xDice2Task);
+
+	vTaskDelete(NULL);
+}
+
+
+void vDiceTaskFunction(void *params)
+{
+	char *pcName = (char *) params;
+	RandomStream_t xStream;
+	uint32_t ulRolls[6];
+	char cLine[64];
+	uint32_t i;
+
+	//Each task has its own stream
+	vRandomStreamInit(&xStream);
+	memset(ulRolls, 0, sizeof(ulRolls));
+
+	while(1)
+	{
+		//600 rolls, then the number of each face
+		for(i = 0; i < 600; i++)
+		{
+			ulRolls[ulRandomRange(&xStream, 6)]++;
+		}
+
+		sprintf(cLine, "%s: %lu %lu %lu %lu %lu %lu \r\n", pcName, ulRolls[0], ulRolls[1], ulRolls[2], ulRolls[3], ulRolls[4], ulRolls[5]);
+		printmsg(cLine);
+		memset(ulRolls, 0, sizeof(ulRolls));
+
+		vTaskDelay(pdMS_TO_TICKS(500 + ulRandomRange(&xStream, 500)));
+	}
+}
+
+
+//Prints the average number of cycles of one call (the loop included)
+static void prvPrintCycles(const char *pcName, uint32_t ulCycles, uint32_t ulCalls)
+{
+	sprintf(UsrMsg, "  %-28s %6lu cycles \r\n", pcName, ulCycles / ulCalls);
+	printmsg(UsrMsg);
+}
+
+
+static void prvSetupUART(void)
+{
+	//1. Enable the UART1 and GPIOB Peripheral Clocks
+	__HAL_RCC_USART1_CLK_ENABLE();
+	__HAL_RCC_GPIOB_CLK_ENABLE();
+
+	//In UART connection with Virtual COM-port, PB6->TX and PB7->RX
+	//2. Alternate Functionality Configuration to make Port B pins work as UART pins
+
+	//Zeroing each and every member element of the structure.
+	memset(&GpioUARTpins, 0, sizeof(GpioUARTpins));
+	GpioUARTpins.Pin = GPIO_PIN_6 | GPIO_PIN_7;
+	GpioUARTpins.Mode = GPIO_MODE_AF_PP;
+	GpioUARTpins.Alternate = GPIO_AF7_USART1;
+	GpioUARTpins.Pull = GPIO_PULLUP;
+
+	HAL_GPIO_Init(GPIOB, &GpioUARTpins);
+
+	//3. Configure and initialize UART parameters
+
+	//Zeroing each and every member element of the structure.
+	memset(&Uart1Init, 0, sizeof(Uart1Init));
+	memset(&Uart1, 0, sizeof(Uart1));
+
+	//UART Initialization
+	Uart1Init.BaudRate = 115200;
+	Uart1Init.WordLength = UART_WORDLENGTH_8B;
+	Uart1Init.HwFlowCtl = UART_HWCONTROL_NONE;
+	Uart1Init.Mode = UART_MODE_TX_RX;
+	Uart1Init.Parity = UART_PARITY_NONE;
+	Uart1Init.StopBits = UART_STOPBITS_1;
+
+	Uart1.Init = Uart1Init;
+	Uart1.Instance = USART1;
+
+	//4. Initialize the UART peripheral
+	uint16_t UARTSetUpResult = HAL_UART_Init(&Uart1);
+
+	if(UARTSetUpResult == HAL_ERROR)
+	{
+		//printf("USART Initialization was not successful \n");
+	}
+
+}
+
+void printmsg(char *msg)
+{
+	HAL_UART_Transmit(&Uart1, (uint8_t *)msg, strlen(msg), 1);
+}
+
+//Implement the Idle Hook function
+void vApplicationIdleHook()
+{
+	//Send the CPU to normal sleep mode
+	__WFI();
+}
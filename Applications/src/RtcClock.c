@@ -0,0 +1,322 @@
+/*
+ * RtcClock.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * The RTC prescalers divide the LSE (32768 Hz) by 8 (PREDIV_A) then by 4096 (PREDIV_S): 1 Hz for the
+ * calendar, and sub-seconds of 1/4096 s. The backup register RTC_BKP_DR0 says whether the RTC was
+ * already started (and set) by an earlier run: it is not initialized again, which would stop it.
+ *
+ * The base is the RTC time in ms and the tick count of the same moment, read in a critical section.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "timers.h"
+#include "stm32wbxx.h"
+#include "stm32wbxx_hal.h"
+#include "stdio.h"
+#include "string.h"
+#include "RtcClock.h"
+
+#define RTC_ASYNCH_PREDIV			7
+#define RTC_SYNCH_PREDIV			4095
+
+//Values of RTC_BKP_DR0
+#define RTC_MAGIC_RUNNING			0x52544352UL			//"RTCR": started, not set
+#define RTC_MAGIC_SET				0x52544353UL			//"RTCS": started and set
+
+#define MS_PER_DAY					86400000ULL
+#define DAYS_PER_4_YEARS			1461
+
+static RTC_HandleTypeDef RTCHandle;
+
+//Base of the time. Written and read in critical sections.
+static uint64_t ullBaseMs = 0;
+static TickType_t xBaseTick = 0;
+static uint64_t ullLastMs = 0;
+
+//Serializes the RTC accesses (set and resync)
+static SemaphoreHandle_t xRtcMutex = NULL;
+static TimerHandle_t xResyncTimer = NULL;
+
+static const uint16_t usDaysBeforeMonth[12] = { 0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334 };
+
+//Private helper functions
+static BaseType_t prvStartLSE(void);
+static void prvResync(BaseType_t xSet);
+static void prvResyncTimerCallback(TimerHandle_t xTimer);
+static uint32_t prvDaysFromDate(uint32_t ulYear, uint32_t ulMonth, uint32_t ulDay);
+static BaseType_t prvIsLeapYear(uint32_t ulYear);
+
+
+BaseType_t xRtcClockInit(void)
+{
+	uint32_t ulMagic;
+
+	//1. LSE (in the backup domain, which is write protected), RTC clock
+	if(prvStartLSE() != pdPASS)
+	{
+		return pdFAIL;
+	}
+	__HAL_RCC_RTC_ENABLE();
+	__HAL_RCC_RTCAPB_CLK_ENABLE();
+
+	//2. RTC, only if it is not already running
+	memset(&RTCHandle, 0, sizeof(RTCHandle));
+	RTCHandle.Instance = RTC;
+	RTCHandle.Init.HourFormat = RTC_HOURFORMAT_24;
+	RTCHandle.Init.AsynchPrediv = RTC_ASYNCH_PREDIV;
+	RTCHandle.Init.SynchPrediv = RTC_SYNCH_PREDIV;
+	RTCHandle.Init.OutPut = RTC_OUTPUT_DISABLE;
+	RTCHandle.Init.OutPutRemap = RTC_OUTPUT_REMAP_NONE;
+	RTCHandle.Init.OutPutPolarity = RTC_OUTPUT_POLARITY_HIGH;
+	RTCHandle.Init.OutPutType = RTC_OUTPUT_TYPE_OPENDRAIN;
+
+	ulMagic = HAL_RTCEx_BKUPRead(&RTCHandle, RTC_BKP_DR0);
+	if( (ulMagic == RTC_MAGIC_RUNNING) || (ulMagic == RTC_MAGIC_SET) )
+	{
+		RTCHandle.State = HAL_RTC_STATE_READY;
+	}
+	else
+	{
+		if(HAL_RTC_Init(&RTCHandle) != HAL_OK)
+		{
+			return pdFAIL;
+		}
+		HAL_RTCEx_BKUPWrite(&RTCHandle, RTC_BKP_DR0, RTC_MAGIC_RUNNING);
+	}
+
+	//3. First base, and the resync
+	xRtcMutex = xSemaphoreCreateMutex();
+	xResyncTimer = xTimerCreate("RTC-Resync", pdMS_TO_TICKS(RTC_CLOCK_RESYNC_MS), pdTRUE, NULL, prvResyncTimerCallback);
+	if( (xRtcMutex == NULL) || (xResyncTimer == NULL) )
+	{
+		return pdFAIL;
+	}
+	prvResync(pdTRUE);
+
+	return (xTimerStart(xResyncTimer, 0) == pdPASS) ? pdPASS : pdFAIL;
+}
+
+
+BaseType_t xRtcClockIsSet(void)
+{
+	return (HAL_RTCEx_BKUPRead(&RTCHandle, RTC_BKP_DR0) == RTC_MAGIC_SET) ? pdTRUE : pdFALSE;
+}
+
+
+BaseType_t xRtcClockSet(const RtcDateTime_t *pxDateTime)
+{
+	RTC_TimeTypeDef xTime;
+	RTC_DateTypeDef xDate;
+	uint32_t ulDaysInMonth;
+	BaseType_t xResult = pdFAIL;
+
+	if( (pxDateTime->usYear < 2000) || (pxDateTime->usYear > 2099) || (pxDateTime->ucMonth < 1) || (pxDateTime->ucMonth > 12) )
+	{
+		return pdFAIL;
+	}
+	ulDaysInMonth = (pxDateTime->ucMonth == 12) ? 31 : (usDaysBeforeMonth[pxDateTime->ucMonth] - usDaysBeforeMonth[pxDateTime->ucMonth - 1]);
+	if( (pxDateTime->ucMonth == 2) && (prvIsLeapYear(pxDateTime->usYear) != pdFALSE) )
+	{
+		ulDaysInMonth++;
+	}
+	if( (pxDateTime->ucDay < 1) || (pxDateTime->ucDay > ulDaysInMonth) || (pxDateTime->ucHours > 23) ||
+		(pxDateTime->ucMinutes > 59) || (pxDateTime->ucSeconds > 59) )
+	{
+		return pdFAIL;
+	}
+
+	memset(&xTime, 0, sizeof(xTime));
+	xTime.Hours = pxDateTime->ucHours;
+	xTime.Minutes = pxDateTime->ucMinutes;
+	xTime.Seconds = pxDateTime->ucSeconds;
+	xTime.DayLightSaving = RTC_DAYLIGHTSAVING_NONE;
+	xTime.StoreOperation = RTC_STOREOPERATION_RESET;
+
+	//2000-01-01 was a Saturday (RTC_WEEKDAY_MONDAY is 1, RTC_WEEKDAY_SUNDAY is 7)
+	memset(&xDate, 0, sizeof(xDate));
+	xDate.Year = pxDateTime->usYear - 2000;
+	xDate.Month = pxDateTime->ucMonth;
+	xDate.Date = pxDateTime->ucDay;
+	xDate.WeekDay = ((prvDaysFromDate(pxDateTime->usYear, pxDateTime->ucMonth, pxDateTime->ucDay) + 5) % 7) + 1;
+
+	xSemaphoreTake(xRtcMutex, portMAX_DELAY);
+	if( (HAL_RTC_SetDate(&RTCHandle, &xDate, RTC_FORMAT_BIN) == HAL_OK) && (HAL_RTC_SetTime(&RTCHandle, &xTime, RTC_FORMAT_BIN) == HAL_OK) )
+	{
+		HAL_RTCEx_BKUPWrite(&RTCHandle, RTC_BKP_DR0, RTC_MAGIC_SET);
+		prvResync(pdTRUE);
+		xResult = pdPASS;
+	}
+	xSemaphoreGive(xRtcMutex);
+
+	return xResult;
+}
+
+
+uint64_t ullRtcClockNowMs(void)
+{
+	UBaseType_t uxSavedInterruptStatus;
+	uint64_t ullNow;
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	ullNow = ullBaseMs + ((uint64_t) (xTaskGetTickCountFromISR() - xBaseTick) * portTICK_PERIOD_MS);
+	if(ullNow < ullLastMs)
+	{
+		ullNow = ullLastMs;
+	}
+	ullLastMs = ullNow;
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+
+	return ullNow;
+}
+
+
+void vRtcClockToDateTime(uint64_t ullMs, RtcDateTime_t *pxDateTime)
+{
+	uint32_t ulDays = (uint32_t) (ullMs / MS_PER_DAY);
+	uint32_t ulMsOfDay = (uint32_t) (ullMs % MS_PER_DAY);
+	uint32_t ulYear;
+	uint32_t ulMonth;
+	uint32_t ulLeap;
+
+	//Blocks of 4 years from 2000: the first year of each block is a leap year (366 days)
+	ulYear = 2000 + ((ulDays / DAYS_PER_4_YEARS) * 4);
+	ulDays %= DAYS_PER_4_YEARS;
+	if(ulDays >= 366)
+	{
+		ulDays -= 366;
+		ulYear += 1 + (ulDays / 365);
+		ulDays %= 365;
+	}
+
+	ulLeap = (prvIsLeapYear(ulYear) != pdFALSE) ? 1 : 0;
+	for(ulMonth = 12; ulMonth > 1; ulMonth--)
+	{
+		if(ulDays >= (usDaysBeforeMonth[ulMonth - 1] + ((ulMonth > 2) ? ulLeap : 0)))
+		{
+			break;
+		}
+	}
+	ulDays -= usDaysBeforeMonth[ulMonth - 1] + ((ulMonth > 2) ? ulLeap : 0);
+
+	pxDateTime->usYear = ulYear;
+	pxDateTime->ucMonth = ulMonth;
+	pxDateTime->ucDay = ulDays + 1;
+	pxDateTime->ucHours = ulMsOfDay / 3600000;
+	pxDateTime->ucMinutes = (ulMsOfDay / 60000) % 60;
+	pxDateTime->ucSeconds = (ulMsOfDay / 1000) % 60;
+	pxDateTime->usMilliseconds = ulMsOfDay % 1000;
+}
+
+
+size_t xRtcClockFormat(uint64_t ullMs, char *pcBuffer, size_t xSize)
+{
+	RtcDateTime_t xDateTime;
+
+	configASSERT(xSize >= RTC_CLOCK_TEXT_SIZE);
+
+	vRtcClockToDateTime(ullMs, &xDateTime);
+	return (size_t) snprintf(pcBuffer, xSize, "%04u-%02u-%02u %02u:%02u:%02u.%03u", xDateTime.usYear, xDateTime.ucMonth, xDateTime.ucDay,
+			xDateTime.ucHours, xDateTime.ucMinutes, xDateTime.ucSeconds, xDateTime.usMilliseconds);
+}
+
+
+static BaseType_t prvStartLSE(void)
+{
+	uint32_t ulStart;
+
+	HAL_PWR_EnableBkUpAccess();
+
+	//The RTC clock source can only be changed by a reset of the backup domain
+	if( (LL_RCC_GetRTCClockSource() != LL_RCC_RTC_CLKSOURCE_NONE) && (LL_RCC_GetRTCClockSource() != LL_RCC_RTC_CLKSOURCE_LSE) )
+	{
+		__HAL_RCC_BACKUPRESET_FORCE();
+		__HAL_RCC_BACKUPRESET_RELEASE();
+	}
+
+	__HAL_RCC_LSE_CONFIG(RCC_LSE_ON);
+	ulStart = DWT->CYCCNT;
+	while(__HAL_RCC_GET_FLAG(RCC_FLAG_LSERDY) == 0)
+	{
+		if((DWT->CYCCNT - ulStart) > ((SystemCoreClock / 1000) * RTC_CLOCK_LSE_TIMEOUT_MS))
+		{
+			return pdFAIL;
+		}
+	}
+	__HAL_RCC_RTC_CONFIG(RCC_RTCCLKSOURCE_LSE);
+
+	return pdPASS;
+}
+
+
+//Reads the RTC and makes it the base. The caller holds xRtcMutex (or the scheduler is not started).
+static void prvResync(BaseType_t xSet)
+{
+	RTC_TimeTypeDef xTime;
+	RTC_DateTypeDef xDate;
+	uint64_t ullRtcMs;
+
+	//After a calendar update or a wake-up from STOP, the shadow registers are valid once RSF is set again
+	__HAL_RTC_WRITEPROTECTION_DISABLE(&RTCHandle);
+	HAL_RTC_WaitForSynchro(&RTCHandle);
+	__HAL_RTC_WRITEPROTECTION_ENABLE(&RTCHandle);
+
+	//The read of SSR and TR locks the shadow registers until DR is read: HAL_RTC_GetDate() after HAL_RTC_GetTime()
+	taskENTER_CRITICAL();
+	HAL_RTC_GetTime(&RTCHandle, &xTime, RTC_FORMAT_BIN);
+	HAL_RTC_GetDate(&RTCHandle, &xDate, RTC_FORMAT_BIN);
+	xBaseTick = xTaskGetTickCount();
+
+	ullRtcMs = (uint64_t) prvDaysFromDate(2000 + xDate.Year, xDate.Month, xDate.Date) * MS_PER_DAY;
+	ullRtcMs += (((xTime.Hours * 60) + xTime.Minutes) * 60 + xTime.Seconds) * 1000UL;
+	ullRtcMs += ((xTime.SecondFraction - xTime.SubSeconds) * 1000UL) / (xTime.SecondFraction + 1);
+	ullBaseMs = ullRtcMs;
+
+	//A new time may go back, a resync does not (ullRtcClockNowMs() holds the last time)
+	if(xSet != pdFALSE)
+	{
+		ullLastMs = ullRtcMs;
+	}
+	taskEXIT_CRITICAL();
+}
+
+
+static void prvResyncTimerCallback(TimerHandle_t xTimer)
+{
+	//The timer task must not block: if the clock is being set, it makes a new base anyway
+	if(xSemaphoreTake(xRtcMutex, 0) == pdPASS)
+	{
+		prvResync(pdFALSE);
+		xSemaphoreGive(xRtcMutex);
+	}
+}
+
+
+//Days since 2000-01-01
+static uint32_t prvDaysFromDate(uint32_t ulYear, uint32_t ulMonth, uint32_t ulDay)
+{
+	uint32_t ulYears = ulYear - 2000;
+	uint32_t ulDays;
+
+	//(ulYears + 3) / 4 leap years before this one (2000 is one)
+	ulDays = (ulYears * 365) + ((ulYears + 3) / 4) + usDaysBeforeMonth[ulMonth - 1] + (ulDay - 1);
+	if( (ulMonth > 2) && (prvIsLeapYear(ulYear) != pdFALSE) )
+	{
+		ulDays++;
+	}
+
+	return ulDays;
+}
+
+
+//Every fourth year from 2000 to 2099 (2000 is divisible by 400)
+static BaseType_t prvIsLeapYear(uint32_t ulYear)
+{
+	return ((ulYear % 4) == 0) ? pdTRUE : pdFALSE;
+}
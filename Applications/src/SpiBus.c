@@ -0,0 +1,597 @@
+/*
+ * SpiBus.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * Each segment is one DMA transfer of the HAL (HAL_SPI_TransmitReceive_DMA(), HAL_SPI_Transmit_DMA() or
+ * HAL_SPI_Receive_DMA()). At the end of the transfer, the DMA interrupt releases the CS of the segment and
+ * starts the next segment, or ends the transaction: the task of the transaction is notified, and the first
+ * transaction of the list of the bus is started. The bus is not idle between two transactions, and no task
+ * has to be scheduled to keep it busy.
+ *
+ * The lists are shared by the tasks and the interrupts: the tasks change them in a critical section
+ * (the interrupts are masked by it, see SPI_BUS_IRQ_PRIORITY).
+ *
+ * When the device of a segment has another clock or another SPI mode than the previous one, the SPI
+ * is disabled and configured again before its CS is driven low.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stm32wbxx.h"
+#include "stm32wbxx_hal.h"
+#include "string.h"
+#include "SpiBus.h"
+
+//Pins, DMA channels and interrupts of one bus
+typedef struct SpiBusHardware
+{
+	SPI_TypeDef *pxInstance;
+	GPIO_TypeDef *pxPort;
+	uint16_t usPins;					//SCK, MISO and MOSI
+	uint8_t ucAlternate;
+	DMA_Channel_TypeDef *pxRxChannel;
+	DMA_Channel_TypeDef *pxTxChannel;
+	uint32_t ulRxRequest;
+	uint32_t ulTxRequest;
+	IRQn_Type xSpiIRQn;
+	IRQn_Type xRxIRQn;
+	IRQn_Type xTxIRQn;
+}SpiBusHardware_t;
+
+//State of one bus. Changed by its interrupts and in critical sections.
+typedef struct SpiBus
+{
+	SPI_HandleTypeDef xSpi;
+	DMA_HandleTypeDef xDmaRx;
+	DMA_HandleTypeDef xDmaTx;
+	BaseType_t xReady;
+	SpiTransaction_t *pxCurrent;		//Transaction on the bus
+	SpiTransaction_t *pxFirst;			//List of the transactions waiting for the bus
+	SpiTransaction_t *pxLast;
+	const SpiDevice_t *pxSelected;		//Device with its CS low
+	SpiBusStats_t xStats;
+}SpiBus_t;
+
+static const SpiBusHardware_t xHardware[SPI_BUS_COUNT] =
+{
+	{ SPI1, GPIOA, GPIO_PIN_5 | GPIO_PIN_6 | GPIO_PIN_7, GPIO_AF5_SPI1, DMA1_Channel2, DMA1_Channel3,
+	  DMA_REQUEST_SPI1_RX, DMA_REQUEST_SPI1_TX, SPI1_IRQn, DMA1_Channel2_IRQn, DMA1_Channel3_IRQn },
+	{ SPI2, GPIOB, GPIO_PIN_13 | GPIO_PIN_14 | GPIO_PIN_15, GPIO_AF5_SPI2, DMA1_Channel4, DMA1_Channel5,
+	  DMA_REQUEST_SPI2_RX, DMA_REQUEST_SPI2_TX, SPI2_IRQn, DMA1_Channel4_IRQn, DMA1_Channel5_IRQn }
+};
+
+static SpiBus_t xBuses[SPI_BUS_COUNT];
+
+//Private helper functions
+static BaseType_t prvInitDma(DMA_HandleTypeDef *pxDma, DMA_Channel_TypeDef *pxChannel, uint32_t ulRequest, uint32_t ulDirection);
+static void prvEnableGpioClock(GPIO_TypeDef *pxPort);
+static SpiBus_t *prvGetBus(SPI_HandleTypeDef *hspi);
+static void prvSelect(SpiBus_t *pxBus, const SpiDevice_t *pxDevice);
+static void prvDeselect(SpiBus_t *pxBus);
+static BaseType_t prvStartSegment(SpiBus_t *pxBus);
+static void prvRunBus(SpiBus_t *pxBus, BaseType_t *pxHigherPriorityTaskWoken);
+static void prvTransactionDone(SpiBus_t *pxBus, BaseType_t *pxHigherPriorityTaskWoken);
+static void prvSegmentDone(SPI_HandleTypeDef *hspi, uint8_t ucError);
+
+
+BaseType_t xSpiBusInit(uint8_t ucBus)
+{
+	const SpiBusHardware_t *pxHardware;
+	SpiBus_t *pxBus;
+	GPIO_InitTypeDef GpioSpiPins;
+
+	if(ucBus >= SPI_BUS_COUNT)
+	{
+		return pdFAIL;
+	}
+	pxHardware = &xHardware[ucBus];
+	pxBus = &xBuses[ucBus];
+	memset(pxBus, 0, sizeof(SpiBus_t));
+
+	//1. SCK, MISO and MOSI
+	prvEnableGpioClock(pxHardware->pxPort);
+	memset(&GpioSpiPins, 0, sizeof(GpioSpiPins));
+	GpioSpiPins.Pin = pxHardware->usPins;
+	GpioSpiPins.Mode = GPIO_MODE_AF_PP;
+	GpioSpiPins.Pull = GPIO_NOPULL;
+	GpioSpiPins.Speed = GPIO_SPEED_FREQ_HIGH;
+	GpioSpiPins.Alternate = pxHardware->ucAlternate;
+	HAL_GPIO_Init(pxHardware->pxPort, &GpioSpiPins);
+
+	//2. SPI master, 8 bit, CS driven by the driver. The clock and the mode are set for each device.
+	pxBus->xSpi.Instance = pxHardware->pxInstance;
+	pxBus->xSpi.Init.Mode = SPI_MODE_MASTER;
+	pxBus->xSpi.Init.Direction = SPI_DIRECTION_2LINES;
+	pxBus->xSpi.Init.DataSize = SPI_DATASIZE_8BIT;
+	pxBus->xSpi.Init.CLKPolarity = SPI_POLARITY_LOW;
+	pxBus->xSpi.Init.CLKPhase = SPI_PHASE_1EDGE;
+	pxBus->xSpi.Init.NSS = SPI_NSS_SOFT;
+	pxBus->xSpi.Init.BaudRatePrescaler = SPI_BAUDRATEPRESCALER_256;
+	pxBus->xSpi.Init.FirstBit = SPI_FIRSTBIT_MSB;
+	pxBus->xSpi.Init.TIMode = SPI_TIMODE_DISABLE;
+	pxBus->xSpi.Init.CRCCalculation = SPI_CRCCALCULATION_DISABLE;
+	pxBus->xSpi.Init.CRCPolynomial = 7;
+	pxBus->xSpi.Init.CRCLength = SPI_CRC_LENGTH_DATASIZE;
+	pxBus->xSpi.Init.NSSPMode = SPI_NSS_PULSE_DISABLE;
+
+	if(HAL_SPI_Init(&pxBus->xSpi) != HAL_OK)
+	{
+		return pdFAIL;
+	}
+
+	//3. DMA channels: data register to memory, and memory to data register, bytes
+	__HAL_RCC_DMAMUX1_CLK_ENABLE();
+	__HAL_RCC_DMA1_CLK_ENABLE();
+
+	if( (prvInitDma(&pxBus->xDmaRx, pxHardware->pxRxChannel, pxHardware->ulRxRequest, DMA_PERIPH_TO_MEMORY) == pdFAIL) ||
+		(prvInitDma(&pxBus->xDmaTx, pxHardware->pxTxChannel, pxHardware->ulTxRequest, DMA_MEMORY_TO_PERIPH) == pdFAIL) )
+	{
+		return pdFAIL;
+	}
+
+	__HAL_LINKDMA(&pxBus->xSpi, hdmarx, pxBus->xDmaRx);
+	__HAL_LINKDMA(&pxBus->xSpi, hdmatx, pxBus->xDmaTx);
+
+	//4. Interrupts: end of the DMA transfers, and SPI errors
+	NVIC_SetPriority(pxHardware->xRxIRQn, SPI_BUS_IRQ_PRIORITY); //Priority should be less than or equal to configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY
+	NVIC_SetPriority(pxHardware->xTxIRQn, SPI_BUS_IRQ_PRIORITY);
+	NVIC_SetPriority(pxHardware->xSpiIRQn, SPI_BUS_IRQ_PRIORITY);
+	NVIC_EnableIRQ(pxHardware->xRxIRQn);
+	NVIC_EnableIRQ(pxHardware->xTxIRQn);
+	NVIC_EnableIRQ(pxHardware->xSpiIRQn);
+
+	pxBus->xReady = pdTRUE;
+	return pdPASS;
+}
+
+void vSpiDeviceInit(const SpiDevice_t *pxDevice)
+{
+	GPIO_InitTypeDef GpioCsPin;
+
+	prvEnableGpioClock(pxDevice->pxCsPort);
+
+	//High before the pin is an output: no glitch on the CS
+	HAL_GPIO_WritePin(pxDevice->pxCsPort, pxDevice->usCsPin, GPIO_PIN_SET);
+
+	memset(&GpioCsPin, 0, sizeof(GpioCsPin));
+	GpioCsPin.Pin = pxDevice->usCsPin;
+	GpioCsPin.Mode = GPIO_MODE_OUTPUT_PP;
+	GpioCsPin.Pull = GPIO_NOPULL;
+	GpioCsPin.Speed = GPIO_SPEED_FREQ_HIGH;
+	HAL_GPIO_Init(pxDevice->pxCsPort, &GpioCsPin);
+}
+
+void vSpiSubmit(SpiTransaction_t *pxTransaction)
+{
+	SpiBus_t *pxBus;
+	uint8_t ucBus;
+	uint8_t i;
+
+	pxTransaction->xTask = xTaskGetCurrentTaskHandle();
+	pxTransaction->pxNext = NULL;
+	pxTransaction->ucSegment = 0;
+	pxTransaction->ulQueueCycles = 0;
+	pxTransaction->ulBusCycles = 0;
+	pxTransaction->ucError = 0;
+	pxTransaction->ucDone = 0;
+
+	//1. Nothing to do
+	if(pxTransaction->ucSegments == 0)
+	{
+		pxTransaction->ucDone = 1;
+		return;
+	}
+
+	//2. All the segments have to be on a bus which is initialized
+	ucBus = pxTransaction->pxSegments[0].pxDevice->ucBus;
+	for(i = 1; i < pxTransaction->ucSegments; i++)
+	{
+		if(pxTransaction->pxSegments[i].pxDevice->ucBus != ucBus)
+		{
+			ucBus = SPI_BUS_COUNT;
+		}
+	}
+
+	if( (ucBus >= SPI_BUS_COUNT) || (xBuses[ucBus].xReady == pdFALSE) )
+	{
+		pxTransaction->ucError = 1;
+		pxTransaction->ucDone = 1;
+		return;
+	}
+	pxBus = &xBuses[ucBus];
+
+	//3. At the end of the list. Started now if the bus is idle, else from the interrupt at the end of the others.
+	taskENTER_CRITICAL();
+
+	pxTransaction->ulSubmitCycle = DWT->CYCCNT;
+	if(pxBus->pxLast == NULL)
+	{
+		pxBus->pxFirst = pxTransaction;
+	}
+	else
+	{
+		pxBus->pxLast->pxNext = pxTransaction;
+	}
+	pxBus->pxLast = pxTransaction;
+
+	if(pxBus->pxCurrent == NULL)
+	{
+		prvRunBus(pxBus, NULL);
+	}
+
+	taskEXIT_CRITICAL();
+}
+
+BaseType_t xSpiWait(SpiTransaction_t *pxTransaction, TickType_t xTicksToWait)
+{
+	TimeOut_t xTimeOut;
+
+	//The notifications of the other transactions of the task wake it up too: the timeout is for the whole wait
+	vTaskSetTimeOutState(&xTimeOut);
+	while(pxTransaction->ucDone == 0)
+	{
+		if(xTaskCheckForTimeOut(&xTimeOut, &xTicksToWait) == pdTRUE)
+		{
+			return pdFAIL;
+		}
+		ulTaskNotifyTakeIndexed(SPI_BUS_NOTIFY_INDEX, pdTRUE, xTicksToWait);
+	}
+
+	return (pxTransaction->ucError == 0) ? pdPASS : pdFAIL;
+}
+
+BaseType_t xSpiTransfer(const SpiDevice_t *pxDevice, const uint8_t *pucTx, uint8_t *pucRx, uint16_t usLength)
+{
+	SpiSegment_t xSegment;
+	SpiTransaction_t xTransaction;
+
+	xSegment.pxDevice = pxDevice;
+	xSegment.pucTx = pucTx;
+	xSegment.pucRx = pucRx;
+	xSegment.usLength = usLength;
+	xSegment.ucKeepCs = 0;
+
+	xTransaction.pxSegments = &xSegment;
+	xTransaction.ucSegments = 1;
+
+	vSpiSubmit(&xTransaction);
+	return xSpiWait(&xTransaction, portMAX_DELAY);
+}
+
+void vSpiBusGetStats(uint8_t ucBus, SpiBusStats_t *pxStats)
+{
+	taskENTER_CRITICAL();
+	*pxStats = xBuses[ucBus].xStats;
+	memset(&xBuses[ucBus].xStats, 0, sizeof(SpiBusStats_t));
+	taskEXIT_CRITICAL();
+}
+
+void vSpiBusResetStats(uint8_t ucBus)
+{
+	taskENTER_CRITICAL();
+	memset(&xBuses[ucBus].xStats, 0, sizeof(SpiBusStats_t));
+	taskEXIT_CRITICAL();
+}
+
+
+void DMA1_Channel2_IRQHandler(void)
+{
+	HAL_DMA_IRQHandler(&xBuses[SPI_BUS_1].xDmaRx);
+}
+
+void DMA1_Channel3_IRQHandler(void)
+{
+	HAL_DMA_IRQHandler(&xBuses[SPI_BUS_1].xDmaTx);
+}
+
+void DMA1_Channel4_IRQHandler(void)
+{
+	HAL_DMA_IRQHandler(&xBuses[SPI_BUS_2].xDmaRx);
+}
+
+void DMA1_Channel5_IRQHandler(void)
+{
+	HAL_DMA_IRQHandler(&xBuses[SPI_BUS_2].xDmaTx);
+}
+
+void SPI1_IRQHandler(void)
+{
+	HAL_SPI_IRQHandler(&xBuses[SPI_BUS_1].xSpi);
+}
+
+void SPI2_IRQHandler(void)
+{
+	HAL_SPI_IRQHandler(&xBuses[SPI_BUS_2].xSpi);
+}
+
+//Called by HAL_SPI_Init()
+void HAL_SPI_MspInit(SPI_HandleTypeDef *hspi)
+{
+	if(hspi->Instance == SPI1)
+	{
+		__HAL_RCC_SPI1_CLK_ENABLE();
+	}
+	else
+	{
+		__HAL_RCC_SPI2_CLK_ENABLE();
+	}
+}
+
+//Called from the DMA interrupt at the end of a segment
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+	prvSegmentDone(hspi, 0);
+}
+
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+	prvSegmentDone(hspi, 0);
+}
+
+void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+	prvSegmentDone(hspi, 0);
+}
+
+//Called from the SPI or DMA interrupt on an error. The HAL has stopped the transfer.
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
+{
+	prvSegmentDone(hspi, 1);
+}
+
+
+static BaseType_t prvInitDma(DMA_HandleTypeDef *pxDma, DMA_Channel_TypeDef *pxChannel, uint32_t ulRequest, uint32_t ulDirection)
+{
+	pxDma->Instance = pxChannel;
+	pxDma->Init.Request = ulRequest;
+	pxDma->Init.Direction = ulDirection;
+	pxDma->Init.PeriphInc = DMA_PINC_DISABLE;
+	pxDma->Init.MemInc = DMA_MINC_ENABLE;
+	pxDma->Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+	pxDma->Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+	pxDma->Init.Mode = DMA_NORMAL;
+	pxDma->Init.Priority = DMA_PRIORITY_MEDIUM;
+
+	return (HAL_DMA_Init(pxDma) == HAL_OK) ? pdPASS : pdFAIL;
+}
+
+static void prvEnableGpioClock(GPIO_TypeDef *pxPort)
+{
+	if(pxPort == GPIOA)
+	{
+		__HAL_RCC_GPIOA_CLK_ENABLE();
+	}
+	else if(pxPort == GPIOB)
+	{
+		__HAL_RCC_GPIOB_CLK_ENABLE();
+	}
+	else if(pxPort == GPIOC)
+	{
+		__HAL_RCC_GPIOC_CLK_ENABLE();
+	}
+	else if(pxPort == GPIOD)
+	{
+		__HAL_RCC_GPIOD_CLK_ENABLE();
+	}
+	else if(pxPort == GPIOE)
+	{
+		__HAL_RCC_GPIOE_CLK_ENABLE();
+	}
+	else
+	{
+		__HAL_RCC_GPIOH_CLK_ENABLE();
+	}
+}
+
+static SpiBus_t *prvGetBus(SPI_HandleTypeDef *hspi)
+{
+	uint8_t i;
+
+	for(i = 0; i < SPI_BUS_COUNT; i++)
+	{
+		if(hspi == &xBuses[i].xSpi)
+		{
+			return &xBuses[i];
+		}
+	}
+
+	return NULL;
+}
+
+//Drives the CS of the device low, after the CS of the previous device is released and the SPI configured for the device
+static void prvSelect(SpiBus_t *pxBus, const SpiDevice_t *pxDevice)
+{
+	SPI_InitTypeDef *pxInit = &pxBus->xSpi.Init;
+
+	if(pxBus->pxSelected == pxDevice)
+	{
+		return;
+	}
+	prvDeselect(pxBus);
+
+	//The clock and the mode can only be changed while the SPI is disabled. The HAL enables it at the next start.
+	if( (pxInit->BaudRatePrescaler != pxDevice->ulPrescaler) || (pxInit->CLKPolarity != pxDevice->ulPolarity) ||
+		(pxInit->CLKPhase != pxDevice->ulPhase) )
+	{
+		__HAL_SPI_DISABLE(&pxBus->xSpi);
+		MODIFY_REG(pxBus->xSpi.Instance->CR1, SPI_CR1_BR | SPI_CR1_CPOL | SPI_CR1_CPHA,
+				   pxDevice->ulPrescaler | pxDevice->ulPolarity | pxDevice->ulPhase);
+		pxInit->BaudRatePrescaler = pxDevice->ulPrescaler;
+		pxInit->CLKPolarity = pxDevice->ulPolarity;
+		pxInit->CLKPhase = pxDevice->ulPhase;
+	}
+
+	HAL_GPIO_WritePin(pxDevice->pxCsPort, pxDevice->usCsPin, GPIO_PIN_RESET);
+	pxBus->pxSelected = pxDevice;
+}
+
+static void prvDeselect(SpiBus_t *pxBus)
+{
+	if(pxBus->pxSelected != NULL)
+	{
+		HAL_GPIO_WritePin(pxBus->pxSelected->pxCsPort, pxBus->pxSelected->usCsPin, GPIO_PIN_SET);
+		pxBus->pxSelected = NULL;
+	}
+}
+
+/*
+ * Starts the DMA transfer of the current segment of the current transaction.
+ * Returns pdFALSE if no transfer is running: the transaction has no segment left, or the transfer could not be started.
+ */
+static BaseType_t prvStartSegment(SpiBus_t *pxBus)
+{
+	SpiTransaction_t *pxTransaction = pxBus->pxCurrent;
+	const SpiSegment_t *pxSegment;
+	HAL_StatusTypeDef xStatus;
+
+	//Segments without data: only the CS
+	while(pxTransaction->ucSegment < pxTransaction->ucSegments)
+	{
+		pxSegment = &pxTransaction->pxSegments[pxTransaction->ucSegment];
+		prvSelect(pxBus, pxSegment->pxDevice);
+		if(pxSegment->usLength != 0)
+		{
+			break;
+		}
+
+		if(pxSegment->ucKeepCs == 0)
+		{
+			prvDeselect(pxBus);
+		}
+		pxTransaction->ucSegment++;
+	}
+
+	if(pxTransaction->ucSegment == pxTransaction->ucSegments)
+	{
+		prvDeselect(pxBus);
+		return pdFALSE;
+	}
+
+	if( (pxSegment->pucTx != NULL) && (pxSegment->pucRx != NULL) )
+	{
+		xStatus = HAL_SPI_TransmitReceive_DMA(&pxBus->xSpi, (uint8_t *) pxSegment->pucTx, pxSegment->pucRx, pxSegment->usLength);
+	}
+	else if(pxSegment->pucTx != NULL)
+	{
+		xStatus = HAL_SPI_Transmit_DMA(&pxBus->xSpi, (uint8_t *) pxSegment->pucTx, pxSegment->usLength);
+	}
+	else if(pxSegment->pucRx != NULL)
+	{
+		xStatus = HAL_SPI_Receive_DMA(&pxBus->xSpi, pxSegment->pucRx, pxSegment->usLength);
+	}
+	else
+	{
+		xStatus = HAL_ERROR;
+	}
+
+	if(xStatus != HAL_OK)
+	{
+		pxTransaction->ucError = 1;
+		prvDeselect(pxBus);
+		return pdFALSE;
+	}
+
+	return pdTRUE;
+}
+
+//Keeps the bus busy: starts the next segment or transaction, until a transfer is running or the list is empty
+//Called in a critical section or from the interrupts of the bus
+static void prvRunBus(SpiBus_t *pxBus, BaseType_t *pxHigherPriorityTaskWoken)
+{
+	while( (pxBus->pxCurrent != NULL) || (pxBus->pxFirst != NULL) )
+	{
+		if(pxBus->pxCurrent == NULL)
+		{
+			pxBus->pxCurrent = pxBus->pxFirst;
+			pxBus->pxFirst = pxBus->pxCurrent->pxNext;
+			if(pxBus->pxFirst == NULL)
+			{
+				pxBus->pxLast = NULL;
+			}
+
+			pxBus->pxCurrent->ulStartCycle = DWT->CYCCNT;
+			pxBus->pxCurrent->ulQueueCycles = pxBus->pxCurrent->ulStartCycle - pxBus->pxCurrent->ulSubmitCycle;
+		}
+
+		if( (pxBus->pxCurrent->ucError == 0) && (prvStartSegment(pxBus) == pdTRUE) )
+		{
+			return;
+		}
+
+		prvTransactionDone(pxBus, pxHigherPriorityTaskWoken);
+	}
+}
+
+//Ends the current transaction and wakes up its task
+static void prvTransactionDone(SpiBus_t *pxBus, BaseType_t *pxHigherPriorityTaskWoken)
+{
+	SpiTransaction_t *pxTransaction = pxBus->pxCurrent;
+	SpiBusStats_t *pxStats = &pxBus->xStats;
+	TaskHandle_t xTask = pxTransaction->xTask;
+	uint32_t ulLatency;
+
+	pxTransaction->ulBusCycles = DWT->CYCCNT - pxTransaction->ulStartCycle;
+	ulLatency = pxTransaction->ulQueueCycles + pxTransaction->ulBusCycles;
+
+	pxStats->ulTransactions++;
+	pxStats->ulBusyCycles += pxTransaction->ulBusCycles;
+	if(pxTransaction->ucError != 0)
+	{
+		pxStats->ulErrors++;
+	}
+	if(pxTransaction->ulQueueCycles > pxStats->ulMaxQueueCycles)
+	{
+		pxStats->ulMaxQueueCycles = pxTransaction->ulQueueCycles;
+	}
+	if(ulLatency > pxStats->ulMaxLatencyCycles)
+	{
+		pxStats->ulMaxLatencyCycles = ulLatency;
+	}
+
+	//The task can use the transaction again as soon as ucDone is set
+	pxBus->pxCurrent = NULL;
+	pxTransaction->ucDone = 1;
+	vTaskNotifyGiveIndexedFromISR(xTask, SPI_BUS_NOTIFY_INDEX, pxHigherPriorityTaskWoken);
+}
+
+//Called from the interrupts of the bus at the end of the DMA transfer of a segment
+static void prvSegmentDone(SPI_HandleTypeDef *hspi, uint8_t ucError)
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	SpiBus_t *pxBus = prvGetBus(hspi);
+	SpiTransaction_t *pxTransaction;
+	const SpiSegment_t *pxSegment;
+
+	if( (pxBus == NULL) || (pxBus->pxCurrent == NULL) )
+	{
+		return;
+	}
+	pxTransaction = pxBus->pxCurrent;
+	pxSegment = &pxTransaction->pxSegments[pxTransaction->ucSegment];
+
+	if(ucError != 0)
+	{
+		//The transaction is ended by prvRunBus()
+		pxTransaction->ucError = 1;
+		prvDeselect(pxBus);
+	}
+	else
+	{
+		pxBus->xStats.ulSegments++;
+		pxBus->xStats.ulBytes += pxSegment->usLength;
+
+		if(pxSegment->ucKeepCs == 0)
+		{
+			prvDeselect(pxBus);
+		}
+		pxTransaction->ucSegment++;
+	}
+
+	prvRunBus(pxBus, &xHigherPriorityTaskWoken);
+
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
@@ -0,0 +1,322 @@
+/*
+ * SpiBusExample.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * This application shares the SPI1 bus between three tasks with the SPI driver (SpiBus.c).
+ * Two devices are on the bus: a fast one (CS on PA4, SPI clock 8 MHz, mode 0) and a slow one
+ * (CS on PA9, SPI clock 1 MHz, mode 3), so the driver changes the configuration of the SPI between them.
+ *
+ *   Stream task: writes and reads blocks of STREAM_LENGTH bytes on the fast device, one after the other.
+ *   Sensor task: every 10 ms, one batched transaction: a command byte and a read of 6 bytes on the slow
+ *                device (CS kept low between both), then a write of 2 bytes on the fast device.
+ *   Report task: every 2 seconds, the statistics of the bus (utilization, latency) and the errors.
+ *
+ * The received bytes are checked against the sent ones: connect MOSI (PA7) to MISO (PA6) for the check
+ * to pass. Without the wire, the transfers run the same and the mismatches are counted.
+ *
+ * The statistics are in CPU cycles (DWT cycle counter), which stops in sleep mode: the idle hook of this
+ * example does not sleep. The CPU runs at 32 MHz (MSI range 10), like UsbCdcConsole.c.
+ * SpiBus.c has to be included in the build with this file, and HAL_SPI_MODULE_ENABLED in stm32wbxx_hal_conf.h.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stm32wbxx.h"
+#include "stm32wbxx_nucleo.h"
+#include "stdio.h"
+#include "string.h"
+#include "SpiBus.h"
+
+#define STREAM_LENGTH			256
+#define SENSOR_PERIOD_MS		10
+#define REPORT_PERIOD_MS		2000
+
+//Task handles and functions
+TaskHandle_t xStreamTask = NULL;
+TaskHandle_t xSensorTask = NULL;
+TaskHandle_t xReportTask = NULL;
+void vStreamTaskFunction(void *params);
+void vSensorTaskFunction(void *params);
+void vReportTaskFunction(void *params);
+
+//UART Handle and Init types
+UART_HandleTypeDef Uart1;
+UART_InitTypeDef Uart1Init;
+GPIO_InitTypeDef GpioUARTpins;
+
+//Devices of the bus
+static const SpiDevice_t xFastDevice = { SPI_BUS_1, GPIOA, GPIO_PIN_4, SPI_BAUDRATEPRESCALER_4, SPI_POLARITY_LOW, SPI_PHASE_1EDGE };
+static const SpiDevice_t xSlowDevice = { SPI_BUS_1, GPIOA, GPIO_PIN_9, SPI_BAUDRATEPRESCALER_32, SPI_POLARITY_HIGH, SPI_PHASE_2EDGE };
+
+//Checks of the loopback and latency of the Sensor task, read by the Report task
+static volatile uint32_t ulStreamMismatches = 0;
+static volatile uint32_t ulSensorMismatches = 0;
+static volatile uint32_t ulSensorTransactions = 0;
+static volatile uint32_t ulSensorLatencySum = 0;
+static volatile uint32_t ulSensorLatencyMax = 0;
+
+//Private helper functions and variables
+static void prvSetupClock(void);
+static void prvSetupUART(void);
+static uint32_t prvCyclesToMicroseconds(uint32_t ulCycles);
+void printmsg(char *msg);
+char UsrMsg[250];
+
+
+int main()
+{
+	// Enable the DWT Cycle Count Register (SEGGER Settings)
+	DWT->CTRL |= (1 << 0);
+
+	// Private functions called to setup the Hardware. The clock first: the UART baud rate depends on it.
+	prvSetupClock();
+	prvSetupUART();
+
+	//Start Recording for SEGGER SystemView
+	SEGGER_SYSVIEW_Conf();
+	SEGGER_SYSVIEW_Start();
+
+	sprintf(UsrMsg,"Example of a SPI bus shared by tasks, with DMA transactions \r\n");
+	printmsg(UsrMsg);
+
+	if(xSpiBusInit(SPI_BUS_1) == pdPASS)
+	{
+		vSpiDeviceInit(&xFastDevice);
+		vSpiDeviceInit(&xSlowDevice);
+
+		//Create the tasks. The Sensor task has the highest priority: its transactions wait only for the bus.
+		xTaskCreate(vStreamTaskFunction, "Stream-Task", configMINIMAL_STACK_SIZE, NULL, 2, &xStreamTask);
+		xTaskCreate(vSensorTaskFunction, "Sensor-Task", configMINIMAL_STACK_SIZE, NULL, 3, &xSensorTask);
+		xTaskCreate(vReportTaskFunction, "Report-Task", 384, NULL, 1, &xReportTask);
+
+		//Schedule the tasks
+		vTaskStartScheduler();
+	}
+	else
+	{
+		sprintf(UsrMsg, "SPI initialization failed... :( \r\n");
+		printmsg(UsrMsg);
+	}
+
+	/*
+	 * If scheduler can start the tasks and run them, the program will never reach here.
+	 * If the program comes to the below line, that means there was a problem while creating or scheduling the tasks
+	 */
+	for(;;);
+}
+
+
+void vStreamTaskFunction(void *params)
+{
+	static uint8_t ucTx[STREAM_LENGTH];
+	static uint8_t ucRx[STREAM_LENGTH];
+	uint8_t ucPattern = 0;
+	uint32_t i;
+
+	while(1)
+	{
+		for(i = 0; i < STREAM_LENGTH; i++)
+		{
+			ucTx[i] = (uint8_t)(ucPattern + i);
+		}
+
+		//The task is blocked during the transfer: the CPU is free for the other tasks
+		if( (xSpiTransfer(&xFastDevice, ucTx, ucRx, STREAM_LENGTH) != pdPASS) ||
+			(memcmp(ucTx, ucRx, STREAM_LENGTH) != 0) )
+		{
+			ulStreamMismatches++;
+		}
+
+		ucPattern++;
+	}
+}
+
+
+void vSensorTaskFunction(void *params)
+{
+	uint8_t ucCommand = 0x3B;
+	uint8_t ucData[6];
+	uint8_t ucWrite[2];
+	SpiSegment_t xSegments[3];
+	SpiTransaction_t xTransaction;
+	TickType_t xLastWake = xTaskGetTickCount();
+	uint32_t ulLatency;
+	uint8_t i;
+
+	//Command, then read on the slow device (one CS frame), then write on the fast device
+	xSegments[0].pxDevice = &xSlowDevice;
+	xSegments[0].pucTx = &ucCommand;
+	xSegments[0].pucRx = NULL;
+	xSegments[0].usLength = 1;
+	xSegments[0].ucKeepCs = 1;
+
+	xSegments[1].pxDevice = &xSlowDevice;
+	xSegments[1].pucTx = NULL;
+	xSegments[1].pucRx = ucData;
+	xSegments[1].usLength = sizeof(ucData);
+	xSegments[1].ucKeepCs = 0;
+
+	xSegments[2].pxDevice = &xFastDevice;
+	xSegments[2].pucTx = ucWrite;
+	xSegments[2].pucRx = NULL;
+	xSegments[2].usLength = sizeof(ucWrite);
+	xSegments[2].ucKeepCs = 0;
+
+	xTransaction.pxSegments = xSegments;
+	xTransaction.ucSegments = 3;
+
+	while(1)
+	{
+		vTaskDelayUntil(&xLastWake, pdMS_TO_TICKS(SENSOR_PERIOD_MS));
+
+		//The bytes of the read segment are sent: with the loopback they come back
+		for(i = 0; i < sizeof(ucData); i++)
+		{
+			ucData[i] = (uint8_t)(0xA0 + i);
+		}
+		ucWrite[0] = ucData[0];
+		ucWrite[1] = ucData[5];
+
+		vSpiSubmit(&xTransaction);
+		if(xSpiWait(&xTransaction, pdMS_TO_TICKS(SENSOR_PERIOD_MS)) != pdPASS)
+		{
+			//Not done in time: the transaction must stay valid until its end
+			xSpiWait(&xTransaction, portMAX_DELAY);
+			ulSensorMismatches++;
+		}
+		else if( (ucData[0] != 0xA0) || (ucData[5] != 0xA5) )
+		{
+			ulSensorMismatches++;
+		}
+
+		ulLatency = xTransaction.ulQueueCycles + xTransaction.ulBusCycles;
+		ulSensorTransactions++;
+		ulSensorLatencySum += ulLatency;
+		if(ulLatency > ulSensorLatencyMax)
+		{
+			ulSensorLatencyMax = ulLatency;
+		}
+	}
+}
+
+
+void vReportTaskFunction(void *params)
+{
+	SpiBusStats_t xStats;
+	uint32_t ulLastCycle, ulElapsed, ulTransactions, ulAverage;
+	char cLine[160];
+
+	vSpiBusResetStats(SPI_BUS_1);
+	ulLastCycle = DWT->CYCCNT;
+
+	while(1)
+	{
+		vTaskDelay(pdMS_TO_TICKS(REPORT_PERIOD_MS));
+
+		vSpiBusGetStats(SPI_BUS_1, &xStats);
+		ulElapsed = DWT->CYCCNT - ulLastCycle;
+		ulLastCycle += ulElapsed;
+
+		//Bus: in percent of the elapsed time, and the kbytes per second
+		sprintf(cLine, "Bus: %lu transactions, %lu segments, %lu kB/s, busy %lu %%, max wait %lu us, max latency %lu us \r\n",
+				xStats.ulTransactions, xStats.ulSegments, xStats.ulBytes / (REPORT_PERIOD_MS / 1000) / 1024,
+				(uint32_t)(((uint64_t) xStats.ulBusyCycles * 100) / ulElapsed),
+				prvCyclesToMicroseconds(xStats.ulMaxQueueCycles), prvCyclesToMicroseconds(xStats.ulMaxLatencyCycles));
+		printmsg(cLine);
+
+		//Sensor task: latency of its batched transactions (time in the list of the bus and on the bus)
+		taskENTER_CRITICAL();
+		ulTransactions = ulSensorTransactions;
+		ulAverage = (ulTransactions != 0) ? (ulSensorLatencySum / ulTransactions) : 0;
+		sprintf(cLine, "Sensor: %lu transactions, latency average %lu us, max %lu us \r\n",
+				ulTransactions, prvCyclesToMicroseconds(ulAverage), prvCyclesToMicroseconds(ulSensorLatencyMax));
+		ulSensorTransactions = 0;
+		ulSensorLatencySum = 0;
+		ulSensorLatencyMax = 0;
+		taskEXIT_CRITICAL();
+		printmsg(cLine);
+
+		sprintf(cLine, "Errors: bus %lu, stream %lu, sensor %lu %s\r\n", xStats.ulErrors, ulStreamMismatches, ulSensorMismatches,
+				((ulStreamMismatches | ulSensorMismatches) != 0) ? "(MOSI to MISO connected?) " : "");
+		printmsg(cLine);
+	}
+}
+
+
+static uint32_t prvCyclesToMicroseconds(uint32_t ulCycles)
+{
+	return ulCycles / (SystemCoreClock / 1000000);
+}
+
+static void prvSetupClock(void)
+{
+	//MSI 4 MHz -> 32 MHz, which needs 1 flash wait state. SPI1 is clocked from it (PCLK2).
+	__HAL_FLASH_SET_LATENCY(FLASH_LATENCY_1);
+	while(__HAL_FLASH_GET_LATENCY() != FLASH_LATENCY_1);
+
+	__HAL_RCC_MSI_RANGE_CONFIG(RCC_MSIRANGE_10);
+	while(__HAL_RCC_GET_FLAG(RCC_FLAG_MSIRDY) == 0);
+
+	//SystemCoreClock is used by the kernel tick, SystemView, the UART baud rate and the statistics
+	SystemCoreClockUpdate();
+}
+
+static void prvSetupUART(void)
+{
+	//1. Enable the UART1 and GPIOB Peripheral Clocks
+	__HAL_RCC_USART1_CLK_ENABLE();
+	__HAL_RCC_GPIOB_CLK_ENABLE();
+
+	//In UART connection with Virtual COM-port, PB6->TX and PB7->RX
+	//2. Alternate Functionality Configuration to make Port B pins work as UART pins
+
+	//Zeroing each and every member element of the structure.
+	memset(&GpioUARTpins, 0, sizeof(GpioUARTpins));
+	GpioUARTpins.Pin = GPIO_PIN_6 | GPIO_PIN_7;
+	GpioUARTpins.Mode = GPIO_MODE_AF_PP;
+	GpioUARTpins.Alternate = GPIO_AF7_USART1;
+	GpioUARTpins.Pull = GPIO_PULLUP;
+
+	HAL_GPIO_Init(GPIOB, &GpioUARTpins);
+
+	//3. Configure and initialize UART parameters
+
+	//Zeroing each and every member element of the structure.
+	memset(&Uart1Init, 0, sizeof(Uart1Init));
+	memset(&Uart1, 0, sizeof(Uart1));
+
+	//UART Initialization
+	Uart1Init.BaudRate = 115200;
+	Uart1Init.WordLength = UART_WORDLENGTH_8B;
+	Uart1Init.HwFlowCtl = UART_HWCONTROL_NONE;
+	Uart1Init.Mode = UART_MODE_TX_RX;
+	Uart1Init.Parity = UART_PARITY_NONE;
+	Uart1Init.StopBits = UART_STOPBITS_1;
+
+	Uart1.Init = Uart1Init;
+	Uart1.Instance = USART1;
+
+	//4. Initialize the UART peripheral
+	uint16_t UARTSetUpResult = HAL_UART_Init(&Uart1);
+
+	if(UARTSetUpResult == HAL_ERROR)
+	{
+		//printf("USART Initialization was not successful \n");
+	}
+
+}
+
+void printmsg(char *msg)
+{
+	HAL_UART_Transmit(&Uart1, (uint8_t *)msg, strlen(msg), 1);
+}
+
+//Implement the Idle Hook function
+void vApplicationIdleHook()
+{
+	//No sleep: the DWT cycle counter is the time base of the statistics, and it stops in sleep mode
+}
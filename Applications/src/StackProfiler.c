@@ -0,0 +1,234 @@
+/*
+ * StackProfiler.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * The kernel fills every new task stack with 0xA5 (configUSE_TRACE_FACILITY or
+ * configCHECK_FOR_STACK_OVERFLOW > 1), and the high water mark is the number of words
+ * at the end of the stack which still hold this pattern. The main stack is filled with
+ * the same pattern by vStackProfilerInit() and scanned the same way.
+ *
+ * The kernel does not keep the stack size of a task, so it has to be registered.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "stm32wbxx.h"
+#include "stdio.h"
+#include "SEGGER_RTT.h"
+#include "SEGGER_SYSVIEW.h"
+#include "StackProfiler.h"
+
+#define STACK_FILL_WORD		0xA5A5A5A5UL
+
+//Keep this many bytes below the stack pointer untouched when filling the main stack
+#define MAIN_STACK_GUARD	64
+
+//Symbols of the linker script
+extern uint32_t _estack;
+extern uint32_t _Min_Stack_Size;
+
+typedef struct StackRegistration
+{
+	TaskHandle_t xTask;
+	uint32_t ulStackWords;
+}StackRegistration_t;
+
+static StackRegistration_t xRegistrations[STACK_PROFILER_MAX_TASKS];
+static TaskStatus_t xTaskStatus[STACK_PROFILER_MAX_TASKS];
+static StackProfile_t xProfiles[STACK_PROFILER_MAX_TASKS];
+static char cReportLine[100];
+
+#if ( configCHECK_FOR_STACK_OVERFLOW > 0 )
+//Name of the task which overflowed its stack (to be checked with the debugger)
+volatile const char *pcStackOverflowTask = NULL;
+#endif
+
+//Private helper functions
+static uint32_t prvGetRegisteredSize(TaskHandle_t xTask);
+static uint32_t prvRecommend(uint32_t ulUsedWords);
+
+
+void vStackProfilerInit(void)
+{
+	uint32_t *pulBottom = (uint32_t *) ( (uint32_t) &_estack - (uint32_t) &_Min_Stack_Size );
+	uint32_t *pulLimit = (uint32_t *) ( __get_MSP() - MAIN_STACK_GUARD );
+
+	//Fill from the bottom of the main stack up to just below the current stack pointer
+	while(pulBottom < pulLimit)
+	{
+		*pulBottom++ = STACK_FILL_WORD;
+	}
+}
+
+void vStackProfilerRegister(TaskHandle_t xTask, uint32_t ulStackWords)
+{
+	UBaseType_t i;
+
+	if(xTask == NULL)
+	{
+		return;
+	}
+
+	taskENTER_CRITICAL();
+	for(i = 0; i < STACK_PROFILER_MAX_TASKS; i++)
+	{
+		//Update the entry of the task, or take a free one
+		if( (xRegistrations[i].xTask == xTask) || (xRegistrations[i].xTask == NULL) )
+		{
+			xRegistrations[i].xTask = xTask;
+			xRegistrations[i].ulStackWords = ulStackWords;
+			break;
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+
+UBaseType_t uxStackProfilerSample(StackProfile_t *pxProfiles, UBaseType_t uxMaxProfiles)
+{
+	UBaseType_t uxTasks, i;
+	uint32_t ulStackWords;
+
+	uxTasks = uxTaskGetSystemState(xTaskStatus, STACK_PROFILER_MAX_TASKS, NULL);
+
+	if(uxTasks > uxMaxProfiles)
+	{
+		uxTasks = uxMaxProfiles;
+	}
+
+	for(i = 0; i < uxTasks; i++)
+	{
+		ulStackWords = prvGetRegisteredSize(xTaskStatus[i].xHandle);
+
+		pxProfiles[i].pcTaskName = xTaskStatus[i].pcTaskName;
+		pxProfiles[i].ulStackWords = ulStackWords;
+		pxProfiles[i].ulUsedWords = 0;
+		pxProfiles[i].ulRecommendedWords = 0;
+
+		if(ulStackWords != 0)
+		{
+			pxProfiles[i].ulUsedWords = ulStackWords - xTaskStatus[i].usStackHighWaterMark;
+			pxProfiles[i].ulRecommendedWords = prvRecommend(pxProfiles[i].ulUsedWords);
+		}
+	}
+
+	return uxTasks;
+}
+
+void vStackProfilerMainStack(uint32_t *pulStackWords, uint32_t *pulUsedWords)
+{
+	uint32_t *pulBottom = (uint32_t *) ( (uint32_t) &_estack - (uint32_t) &_Min_Stack_Size );
+	uint32_t *pulWord = pulBottom;
+	uint32_t ulStackWords = (uint32_t) &_Min_Stack_Size / sizeof(uint32_t);
+
+	//The stack grows downwards: the words which still hold the pattern at the bottom were never used
+	while( (pulWord < &_estack) && (*pulWord == STACK_FILL_WORD) )
+	{
+		pulWord++;
+	}
+
+	*pulStackWords = ulStackWords;
+	*pulUsedWords = ulStackWords - (uint32_t)(pulWord - pulBottom);
+}
+
+void vStackProfilerPrintReport(void (*pxPrint)(char *msg))
+{
+	UBaseType_t uxTasks, i;
+	uint32_t ulStackWords, ulUsedWords, ulReclaimable = 0;
+
+	uxTasks = uxStackProfilerSample(xProfiles, STACK_PROFILER_MAX_TASKS);
+
+	pxPrint("\r\nTask                 Stack   Used  Recommended (words) \r\n");
+
+	for(i = 0; i < uxTasks; i++)
+	{
+		if(xProfiles[i].ulStackWords == 0)
+		{
+			sprintf(cReportLine, "%-20s     ?      ?  (not registered, %u words never used) \r\n", xProfiles[i].pcTaskName,
+					xTaskStatus[i].usStackHighWaterMark);
+		}
+		else
+		{
+			sprintf(cReportLine, "%-20s %5lu  %5lu  %5lu %s\r\n", xProfiles[i].pcTaskName,
+					xProfiles[i].ulStackWords, xProfiles[i].ulUsedWords, xProfiles[i].ulRecommendedWords,
+					(xProfiles[i].ulStackWords < xProfiles[i].ulRecommendedWords) ? "<-- margin too small " : "");
+
+			if(xProfiles[i].ulStackWords > xProfiles[i].ulRecommendedWords)
+			{
+				ulReclaimable += xProfiles[i].ulStackWords - xProfiles[i].ulRecommendedWords;
+			}
+		}
+		pxPrint(cReportLine);
+	}
+
+	vStackProfilerMainStack(&ulStackWords, &ulUsedWords);
+	sprintf(cReportLine, "%-20s %5lu  %5lu  (main stack, interrupts) \r\n", "MSP", ulStackWords, ulUsedWords);
+	pxPrint(cReportLine);
+
+	sprintf(cReportLine, "Reclaimable: %lu bytes, heap free: %u bytes (minimum ever %u bytes) \r\n",
+			ulReclaimable * sizeof(StackType_t), xPortGetFreeHeapSize(), xPortGetMinimumEverFreeHeapSize());
+	pxPrint(cReportLine);
+}
+
+
+#if ( configCHECK_FOR_STACK_OVERFLOW > 0 )
+//Called by the kernel when it detects an overflow of the task stack (configCHECK_FOR_STACK_OVERFLOW)
+void vApplicationStackOverflowHook(TaskHandle_t xTask, char *pcTaskName)
+{
+	pcStackOverflowTask = pcTaskName;
+
+	//RTT channel 0 is the terminal channel (SystemView uses channel 1)
+	SEGGER_RTT_WriteString(0, "\r\nStack overflow in task: ");
+	SEGGER_RTT_WriteString(0, pcTaskName);
+	SEGGER_RTT_WriteString(0, "\r\n");
+	SEGGER_SYSVIEW_Error("Stack overflow");
+
+	//The stack of the task is corrupted: stop here like configASSERT()
+	taskDISABLE_INTERRUPTS();
+	for( ;; );
+}
+#endif
+
+
+static uint32_t prvGetRegisteredSize(TaskHandle_t xTask)
+{
+	UBaseType_t i;
+
+	if(xTask == xTaskGetIdleTaskHandle())
+	{
+		return configMINIMAL_STACK_SIZE;
+	}
+
+#if ( configUSE_TIMERS == 1 )
+	if(xTask == xTimerGetTimerDaemonTaskHandle())
+	{
+		return configTIMER_TASK_STACK_DEPTH;
+	}
+#endif
+
+	for(i = 0; i < STACK_PROFILER_MAX_TASKS; i++)
+	{
+		if(xRegistrations[i].xTask == xTask)
+		{
+			return xRegistrations[i].ulStackWords;
+		}
+	}
+
+	return 0;
+}
+
+static uint32_t prvRecommend(uint32_t ulUsedWords)
+{
+	uint32_t ulMargin = (ulUsedWords * STACK_PROFILER_MARGIN_PERCENT) / 100;
+
+	if(ulMargin < STACK_PROFILER_MIN_MARGIN_WORDS)
+	{
+		ulMargin = STACK_PROFILER_MIN_MARGIN_WORDS;
+	}
+
+	return ( (ulUsedWords + ulMargin + STACK_PROFILER_ALIGN_WORDS - 1) / STACK_PROFILER_ALIGN_WORDS ) * STACK_PROFILER_ALIGN_WORDS;
+}
@@ -0,0 +1,189 @@
+/*
+ * Supervisor.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * The supervisor keeps, for each slot, the value of the check-in counter at its last change and the tick
+ * count of that change. A counter which did not change for more than the deadline of its slot is a missed
+ * deadline. The record of the reset is in .noinit (LinkerScript.ld): the startup code does not clear it,
+ * so it survives the IWDG reset. It is only trusted if its magic number and check word are right.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stm32wbxx.h"
+#include "stm32wbxx_hal.h"
+#include "string.h"
+#include "Supervisor.h"
+
+#define RECORD_MAGIC				0x53555056UL			//"SUPV"
+
+//Record written before the reset
+typedef struct SupervisorRecord
+{
+	uint32_t ulMagic;
+	SupervisorReport_t xReport;
+	uint32_t ulCheck;						//~ulMagic ^ slot: a random RAM content is not taken for a record
+}SupervisorRecord_t;
+
+volatile uint32_t ulSupervisorCheckIns[SUPERVISOR_MAX_TASKS];
+
+static SupervisorRecord_t xRecord __attribute__((section(".noinit")));
+static SupervisorReport_t xLastReset;
+
+//Slots. Registered in critical sections, read by the supervisor task.
+static TaskHandle_t xSlotTasks[SUPERVISOR_MAX_TASKS];
+static TickType_t xDeadlines[SUPERVISOR_MAX_TASKS];
+static uint32_t ulLastCounts[SUPERVISOR_MAX_TASKS];
+static TickType_t xLastCheckIns[SUPERVISOR_MAX_TASKS];
+
+static IWDG_HandleTypeDef IwdgHandle;
+
+//Private helper functions
+static void prvSupervisorTask(void *params);
+static void prvWriteRecord(BaseType_t xSlot, TickType_t xNow);
+
+
+BaseType_t xSupervisorInit(void)
+{
+	//1. Cause of the last reset: the record is valid only after an IWDG reset
+	memset(&xLastReset, 0, sizeof(xLastReset));
+	xLastReset.xSlot = SUPERVISOR_NO_SLOT;
+	if(__HAL_RCC_GET_FLAG(RCC_FLAG_IWDGRST) != 0)
+	{
+		xLastReset.xWatchdogReset = pdTRUE;
+		if( (xRecord.ulMagic == RECORD_MAGIC) && (xRecord.ulCheck == (~RECORD_MAGIC ^ (uint32_t) xRecord.xReport.xSlot)) )
+		{
+			xLastReset = xRecord.xReport;
+			xLastReset.cTaskName[configMAX_TASK_NAME_LEN - 1] = '\0';
+		}
+	}
+	memset(&xRecord, 0, sizeof(xRecord));
+	__HAL_RCC_CLEAR_RESET_FLAGS();
+
+	memset(xSlotTasks, 0, sizeof(xSlotTasks));
+
+	if(xTaskCreate(prvSupervisorTask, "Supervisor", configMINIMAL_STACK_SIZE, NULL, SUPERVISOR_TASK_PRIORITY, NULL) != pdPASS)
+	{
+		return pdFAIL;
+	}
+
+	//2. IWDG (it starts the LSI). It stops when the CPU is halted by the debugger.
+	__HAL_DBGMCU_FREEZE_IWDG();
+	IwdgHandle.Instance = IWDG;
+	IwdgHandle.Init.Prescaler = IWDG_PRESCALER_64;
+	IwdgHandle.Init.Reload = (SUPERVISOR_IWDG_TIMEOUT_MS * (LSI_VALUE / 64)) / 1000;
+	IwdgHandle.Init.Window = IWDG_WINDOW_DISABLE;
+	if(HAL_IWDG_Init(&IwdgHandle) != HAL_OK)
+	{
+		return pdFAIL;
+	}
+
+	return pdPASS;
+}
+
+
+void vSupervisorLastReset(SupervisorReport_t *pxReport)
+{
+	*pxReport = xLastReset;
+}
+
+
+BaseType_t xSupervisorRegister(TickType_t xDeadline)
+{
+	BaseType_t xSlot;
+
+	taskENTER_CRITICAL();
+	for(xSlot = 0; xSlot < SUPERVISOR_MAX_TASKS; xSlot++)
+	{
+		if(xSlotTasks[xSlot] == NULL)
+		{
+			//The deadline starts now
+			xDeadlines[xSlot] = xDeadline;
+			ulLastCounts[xSlot] = ulSupervisorCheckIns[xSlot];
+			xLastCheckIns[xSlot] = xTaskGetTickCount();
+			xSlotTasks[xSlot] = xTaskGetCurrentTaskHandle();
+			break;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return (xSlot < SUPERVISOR_MAX_TASKS) ? xSlot : SUPERVISOR_NO_SLOT;
+}
+
+
+void vSupervisorUnregister(BaseType_t xSlot)
+{
+	configASSERT( (xSlot >= 0) && (xSlot < SUPERVISOR_MAX_TASKS) );
+
+	taskENTER_CRITICAL();
+	xSlotTasks[xSlot] = NULL;
+	taskEXIT_CRITICAL();
+}
+
+
+static void prvSupervisorTask(void *params)
+{
+	TickType_t xLastWakeTime = xTaskGetTickCount();
+	TickType_t xNow;
+	BaseType_t xSlot;
+	BaseType_t xLate;
+	uint32_t ulCount;
+
+	while(1)
+	{
+		vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(SUPERVISOR_PERIOD_MS));
+
+		xNow = xTaskGetTickCount();
+		xLate = SUPERVISOR_NO_SLOT;
+
+		taskENTER_CRITICAL();
+		for(xSlot = 0; xSlot < SUPERVISOR_MAX_TASKS; xSlot++)
+		{
+			if(xSlotTasks[xSlot] == NULL)
+			{
+				continue;
+			}
+
+			ulCount = ulSupervisorCheckIns[xSlot];
+			if(ulCount != ulLastCounts[xSlot])
+			{
+				ulLastCounts[xSlot] = ulCount;
+				xLastCheckIns[xSlot] = xNow;
+			}
+			else if( ((xNow - xLastCheckIns[xSlot]) > xDeadlines[xSlot]) && (xLate == SUPERVISOR_NO_SLOT) )
+			{
+				xLate = xSlot;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if(xLate == SUPERVISOR_NO_SLOT)
+		{
+			HAL_IWDG_Refresh(&IwdgHandle);
+		}
+		else
+		{
+			//No refresh any more: the IWDG resets the MCU
+			prvWriteRecord(xLate, xNow);
+			vTaskSuspend(NULL);
+		}
+	}
+}
+
+
+static void prvWriteRecord(BaseType_t xSlot, TickType_t xNow)
+{
+	memset(&xRecord, 0, sizeof(xRecord));
+	xRecord.xReport.xWatchdogReset = pdTRUE;
+	xRecord.xReport.xSlot = xSlot;
+	strncpy(xRecord.xReport.cTaskName, pcTaskGetName(xSlotTasks[xSlot]), configMAX_TASK_NAME_LEN - 1);
+	xRecord.xReport.ulDeadlineMs = xDeadlines[xSlot] * portTICK_PERIOD_MS;
+	xRecord.xReport.ulLateMs = (xNow - xLastCheckIns[xSlot]) * portTICK_PERIOD_MS;
+	xRecord.xReport.ulUptimeMs = xNow * portTICK_PERIOD_MS;
+	xRecord.ulCheck = ~RECORD_MAGIC ^ (uint32_t) xSlot;
+	xRecord.ulMagic = RECORD_MAGIC;
+}
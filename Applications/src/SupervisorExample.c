@@ -0,0 +1,257 @@
+/*
+ * SupervisorExample.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * This application shows the task supervisor (Supervisor.c) with the IWDG.
+ *
+ * The Sensor task (every 50 ms, deadline 200 ms) and the Logger task (every 500 ms, deadline 1.5 s)
+ * check in at each loop. After FAULT_AFTER_MS one fault is injected, a different one at each start:
+ *   1. the Sensor task hangs in an endless loop (like a polling loop which never ends)
+ *   2. the Logger task waits forever for a semaphore which is never given (deadlock)
+ *   3. configASSERT() fails: the interrupts are masked, the supervisor itself cannot run
+ * The supervisor stops refreshing the IWDG and the MCU is reset. At the next start, the cause of the
+ * reset is printed: the task which missed its deadline (1 and 2), or no task identified (3).
+ *
+ * The number of the next fault is kept in .noinit, like the record of the supervisor.
+ * Supervisor.c has to be included in the build with this file, and HAL_IWDG_MODULE_ENABLED in stm32wbxx_hal_conf.h.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "stm32wbxx.h"
+#include "stm32wbxx_nucleo.h"
+#include "stdio.h"
+#include "string.h"
+#include "Supervisor.h"
+
+#define FAULT_AFTER_MS			5000
+#define FAULT_MAGIC				0x46415554UL			//"FAUT"
+
+#define FAULT_SENSOR_HANG		0
+#define FAULT_LOGGER_DEADLOCK	1
+#define FAULT_ASSERT			2
+#define FAULT_COUNT				3
+
+//Task handles and functions
+TaskHandle_t xSensorTask = NULL;
+TaskHandle_t xLoggerTask = NULL;
+void vSensorTaskFunction(void *params);
+void vLoggerTaskFunction(void *params);
+
+//UART Handle and Init types
+UART_HandleTypeDef Uart1;
+UART_InitTypeDef Uart1Init;
+GPIO_InitTypeDef GpioUARTpins;
+
+//Fault of this run, and the next one kept across the reset
+static uint32_t ulFault = 0;
+static uint32_t ulNextFault[2] __attribute__((section(".noinit")));
+
+//Never given: the deadlock of the Logger task
+static SemaphoreHandle_t xNeverGiven = NULL;
+
+//Private helper functions and variables
+static void prvSetupUART(void);
+static void prvPrintLastReset(void);
+static BaseType_t prvFaultDue(uint32_t ulThisFault, TickType_t xStart);
+void printmsg(char *msg);
+char UsrMsg[250];
+
+
+int main()
+{
+	// Enable the DWT Cycle Count Register (SEGGER Settings)
+	DWT->CTRL |= (1 << 0);
+
+	// Private function called to setup the Hardware
+	prvSetupUART();
+
+	//Start Recording for SEGGER SystemView
+	SEGGER_SYSVIEW_Conf();
+	SEGGER_SYSVIEW_Start();
+
+	sprintf(UsrMsg,"Example of the task supervisor with the IWDG \r\n");
+	printmsg(UsrMsg);
+
+	//Fault of this run (the first one after a power on), then the next one for the next start
+	ulFault = (ulNextFault[0] == FAULT_MAGIC) ? (ulNextFault[1] % FAULT_COUNT) : 0;
+	ulNextFault[0] = FAULT_MAGIC;
+	ulNextFault[1] = ulFault + 1;
+
+	xNeverGiven = xSemaphoreCreateBinary();
+
+	//Create Sensor and Logger Tasks. They register themselves with the supervisor.
+	xTaskCreate(vSensorTaskFunction, "Sensor-Task", 256, NULL, 2, &xSensorTask);
+	xTaskCreate(vLoggerTaskFunction, "Logger-Task", 384, NULL, 1, &xLoggerTask);
+
+	//Last: the IWDG runs from here
+	if( (xNeverGiven != NULL) && (xSupervisorInit() == pdPASS) )
+	{
+		prvPrintLastReset();
+
+		sprintf(UsrMsg, "Fault %lu in %u ms \r\n", ulFault + 1, FAULT_AFTER_MS);
+		printmsg(UsrMsg);
+
+		//Schedule the tasks
+		vTaskStartScheduler();
+	}
+	else
+	{
+		sprintf(UsrMsg, "Supervisor initialization failed... :( \r\n");
+		printmsg(UsrMsg);
+	}
+
+	/*
+	 * If scheduler can start the tasks and run them, the program will never reach here.
+	 * If the program comes to the below line, that means there was a problem while creating or scheduling the tasks
+	 */
+	for(;;);
+}
+
+
+void vSensorTaskFunction(void *params)
+{
+	BaseType_t xSlot = xSupervisorRegister(pdMS_TO_TICKS(200));
+	TickType_t xStart = xTaskGetTickCount();
+	TickType_t xLastWakeTime = xStart;
+	volatile uint32_t ulSpin = 0;
+
+	while(1)
+	{
+		vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(50));
+		SUPERVISOR_CHECK_IN(xSlot);
+
+		if(prvFaultDue(FAULT_SENSOR_HANG, xStart) != pdFALSE)
+		{
+			//Fault 1: a loop which never ends, without check-in
+			while(1)
+			{
+				ulSpin++;
+			}
+		}
+
+		if(prvFaultDue(FAULT_ASSERT, xStart) != pdFALSE)
+		{
+			//Fault 3: the interrupts are masked, nothing runs any more
+			configASSERT(ulSpin == 1);
+		}
+	}
+}
+
+
+void vLoggerTaskFunction(void *params)
+{
+	BaseType_t xSlot = xSupervisorRegister(pdMS_TO_TICKS(1500));
+	TickType_t xStart = xTaskGetTickCount();
+	TickType_t xLastWakeTime = xStart;
+	uint32_t ulLoops = 0;
+
+	while(1)
+	{
+		vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(500));
+		SUPERVISOR_CHECK_IN(xSlot);
+
+		if((++ulLoops % 4) == 0)
+		{
+			sprintf(UsrMsg, "Running for %lu ms \r\n", (uint32_t) ((xTaskGetTickCount() - xStart) * portTICK_PERIOD_MS));
+			printmsg(UsrMsg);
+		}
+
+		if(prvFaultDue(FAULT_LOGGER_DEADLOCK, xStart) != pdFALSE)
+		{
+			//Fault 2: blocked forever
+			xSemaphoreTake(xNeverGiven, portMAX_DELAY);
+		}
+	}
+}
+
+
+static void prvPrintLastReset(void)
+{
+	SupervisorReport_t xReport;
+
+	vSupervisorLastReset(&xReport);
+	if(xReport.xWatchdogReset == pdFALSE)
+	{
+		printmsg("Last reset: not by the watchdog \r\n");
+	}
+	else if(xReport.xSlot == SUPERVISOR_NO_SLOT)
+	{
+		printmsg("Last reset: watchdog, no task identified (the supervisor could not run) \r\n");
+	}
+	else
+	{
+		sprintf(UsrMsg, "Last reset: watchdog, %s missed its deadline of %lu ms (no check-in for %lu ms, %lu ms after the start) \r\n",
+				xReport.cTaskName, xReport.ulDeadlineMs, xReport.ulLateMs, xReport.ulUptimeMs);
+		printmsg(UsrMsg);
+	}
+}
+
+
+static BaseType_t prvFaultDue(uint32_t ulThisFault, TickType_t xStart)
+{
+	return ( (ulFault == ulThisFault) && ((xTaskGetTickCount() - xStart) >= pdMS_TO_TICKS(FAULT_AFTER_MS)) ) ? pdTRUE : pdFALSE;
+}
+
+
+static void prvSetupUART(void)
+{
+	//1. Enable the UART1 and GPIOB Peripheral Clocks
+	__HAL_RCC_USART1_CLK_ENABLE();
+	__HAL_RCC_GPIOB_CLK_ENABLE();
+
+	//In UART connection with Virtual COM-port, PB6->TX and PB7->RX
+	//2. Alternate Functionality Configuration to make Port B pins work as UART pins
+
+	//Zeroing each and every member element of the structure.
+	memset(&GpioUARTpins, 0, sizeof(GpioUARTpins));
+	GpioUARTpins.Pin = GPIO_PIN_6 | GPIO_PIN_7;
+	GpioUARTpins.Mode = GPIO_MODE_AF_PP;
+	GpioUARTpins.Alternate = GPIO_AF7_USART1;
+	GpioUARTpins.Pull = GPIO_PULLUP;
+
+	HAL_GPIO_Init(GPIOB, &GpioUARTpins);
+
+	//3. Configure and initialize UART parameters
+
+	//Zeroing each and every member element of the structure.
+	memset(&Uart1Init, 0, sizeof(Uart1Init));
+	memset(&Uart1, 0, sizeof(Uart1));
+
+	//UART Initialization
+	Uart1Init.BaudRate = 115200;
+	Uart1Init.WordLength = UART_WORDLENGTH_8B;
+	Uart1Init.HwFlowCtl = UART_HWCONTROL_NONE;
+	Uart1Init.Mode = UART_MODE_TX_RX;
+	Uart1Init.Parity = UART_PARITY_NONE;
+	Uart1Init.StopBits = UART_STOPBITS_1;
+
+	Uart1.Init = Uart1Init;
+	Uart1.Instance = USART1;
+
+	//4. Initialize the UART peripheral
+	uint16_t UARTSetUpResult = HAL_UART_Init(&Uart1);
+
+	if(UARTSetUpResult == HAL_ERROR)
+	{
+		//printf("USART Initialization was not successful \n");
+	}
+
+}
+
+void printmsg(char *msg)
+{
+	HAL_UART_Transmit(&Uart1, (uint8_t *)msg, strlen(msg), 1);
+}
+
+//Implement the Idle Hook function
+void vApplicationIdleHook()
+{
+	//Send the CPU to normal sleep mode
+	__WFI();
+}
@@ -31,6 +31,10 @@ extern void initialise_monitor_handles(void);
 #define AVAILABLE TRUE
 #define NOT_AVAILABLE FALSE
 
+//Notification indexes of the LED task (index 0 is left to the kernel)
+#define BUTTON_EVENT_INDEX	1	//Used as a binary semaphore: one event per button press
+#define PRESS_COUNT_INDEX	2	//Used as a counter, nobody waits on it
+
 TaskHandle_t xLEDTaskHandle = NULL;
 TaskHandle_t xButtonTaskHandle = NULL;
 
@@ -96,11 +100,14 @@ void vLEDTaskFunction(void *params)
 	{
 		uint32_t currentNotificationValue = 0;
 
-		// Wait until the task receives any notification event from Button Task
-		if(xTaskNotifyWait(0,0,&currentNotificationValue,portMAX_DELAY) == pdTRUE)
+		// Wait until the task receives the button event from Button Task
+		if(ulTaskNotifyTakeIndexed(BUTTON_EVENT_INDEX, pdTRUE, portMAX_DELAY) != 0)
 		{
 			HAL_GPIO_TogglePin(GPIOB, LED1_PIN);
 
+			//Read the press count (clearing no bits). It is not affected by the event above.
+			currentNotificationValue = ulTaskNotifyValueClearIndexed(NULL, PRESS_COUNT_INDEX, 0);
+
 			sprintf(usr_msg, "Notification from Button Task. \n\r");
 			printmsg(usr_msg);
 			sprintf(usr_msg, "Button press count: %ld \n\r", currentNotificationValue);
@@ -123,8 +130,9 @@ void vButtonTaskFunction(void *params)
 			//Button is pressed on the nucleo board
 			// Wait for 100ms to compensate for the button de-bouncing
 			delay(200);
-			//Send the notification to LED Task
-			xTaskNotify(xLEDTaskHandle,0x0, eIncrement);
+			//Count the press, then send the event to LED Task
+			xTaskNotifyIndexed(xLEDTaskHandle, PRESS_COUNT_INDEX, 0x0, eIncrement);
+			xTaskNotifyGiveIndexed(xLEDTaskHandle, BUTTON_EVENT_INDEX);
 		}
 	}
 
@@ -0,0 +1,618 @@
+/*
+ * TimerWheel.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * Hierarchical timer wheel (same scheme as the classic Linux kernel timer wheel).
+ *
+ * Level 0 has one slot per tick for the next 256 ticks. Each higher level has 64 slots,
+ * and every slot covers a whole revolution of the level below it. When level 0 wraps,
+ * the current slot of level 1 is cascaded (its timers are re-inserted closer to the
+ * current time), and so on for the higher levels.
+ *
+ * Start, stop and expire are O(1): every slot is a doubly linked list, so a timer is
+ * inserted or removed without searching. The lists are changed directly from the calling
+ * task or ISR inside a short critical section. Only the callbacks run in the service task,
+ * which sleeps until the next occupied slot instead of waking on every tick.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "TimerWheel.h"
+
+//Slot count and mask for each level
+#define L0_SIZE						( 1UL << TIMER_WHEEL_L0_BITS )
+#define L0_MASK						( L0_SIZE - 1UL )
+#define LN_SIZE						( 1UL << TIMER_WHEEL_LN_BITS )
+#define LN_MASK						( LN_SIZE - 1UL )
+#define LEVEL_SHIFT(level)			( TIMER_WHEEL_L0_BITS + ( ( (level) - 1 ) * TIMER_WHEEL_LN_BITS ) )
+#define MAP_WORDS					( L0_SIZE / 32UL )
+
+//Timer flags
+#define TIMER_FLAG_IN_USE			0x01
+#define TIMER_FLAG_ACTIVE			0x02
+#define TIMER_FLAG_AUTO_RELOAD		0x04
+
+//Level value used while a timer sits in the expired list of the service task
+#define LEVEL_EXPIRED				0xFF
+
+//Intrusive circular doubly linked list
+typedef struct TimerWheelLink
+{
+	struct TimerWheelLink *pxNext;
+	struct TimerWheelLink *pxPrev;
+}TimerWheelLink_t;
+
+typedef struct TimerWheelTimer
+{
+	TimerWheelLink_t xLink;				//Must be the first member
+	TickType_t xExpiry;
+	TickType_t xPeriod;
+	TimerWheelCallback_t pxCallback;
+	void *pvTimerID;
+	const char *pcTimerName;
+	uint16_t usSlot;
+	uint8_t ucLevel;
+	uint8_t ucFlags;
+}TimerWheelTimer_t;
+
+//Wheel state (only modified inside critical sections)
+static TimerWheelLink_t xLevel0[L0_SIZE];
+static TimerWheelLink_t xLevelN[TIMER_WHEEL_LEVELS - 1][LN_SIZE];
+static uint32_t ulLevel0Map[MAP_WORDS];			//One bit per non-empty level 0 slot
+static UBaseType_t uxUpperCount = 0;			//Timers in level 1 and above
+static UBaseType_t uxActiveCount = 0;
+static TickType_t xWheelTime = 0;				//Next tick to be processed
+static TickType_t xNextWakeTick = 0;			//Tick the service task is sleeping until
+static BaseType_t xServiceSleeping = pdFALSE;
+static BaseType_t xSleepForever = pdFALSE;
+
+//Timer pool
+static TimerWheelTimer_t xTimerPool[TIMER_WHEEL_MAX_TIMERS];
+static TimerWheelTimer_t *pxFreeList = NULL;
+
+static TaskHandle_t xTimerWheelTaskHandle = NULL;
+
+//Private helper functions
+static void prvTimerWheelTask(void *params);
+static void prvListInit(TimerWheelLink_t *pxList);
+static void prvListInsertTail(TimerWheelLink_t *pxList, TimerWheelLink_t *pxLink);
+static void prvListRemove(TimerWheelLink_t *pxLink);
+static void prvListMove(TimerWheelLink_t *pxFrom, TimerWheelLink_t *pxTo);
+static void prvInsertTimer(TimerWheelTimer_t *pxTimer);
+static void prvRemoveTimer(TimerWheelTimer_t *pxTimer);
+static UBaseType_t prvCascade(UBaseType_t uxLevel, UBaseType_t uxIndex);
+static UBaseType_t prvNextOccupiedSlot(UBaseType_t uxIndex);
+static BaseType_t prvStartTimer(TimerWheelTimer_t *pxTimer, TickType_t xNow);
+static void prvCollectExpired(TickType_t xNow, TimerWheelLink_t *pxExpired);
+static TickType_t prvTicksToNextEvent(TickType_t xNow);
+
+
+BaseType_t xTimerWheelInit(UBaseType_t uxPriority, configSTACK_DEPTH_TYPE usStackDepth)
+{
+	UBaseType_t i, j;
+
+	for(i = 0; i < L0_SIZE; i++)
+	{
+		prvListInit(&xLevel0[i]);
+	}
+
+	for(i = 0; i < (TIMER_WHEEL_LEVELS - 1); i++)
+	{
+		for(j = 0; j < LN_SIZE; j++)
+		{
+			prvListInit(&xLevelN[i][j]);
+		}
+	}
+
+	//Chain all the timers of the pool into the free list
+	pxFreeList = NULL;
+	for(i = 0; i < TIMER_WHEEL_MAX_TIMERS; i++)
+	{
+		xTimerPool[i].ucFlags = 0;
+		xTimerPool[i].xLink.pxNext = (TimerWheelLink_t *) pxFreeList;
+		pxFreeList = &xTimerPool[i];
+	}
+
+	xWheelTime = xTaskGetTickCount();
+
+	return xTaskCreate(prvTimerWheelTask, "TimerWheel", usStackDepth, NULL, uxPriority, &xTimerWheelTaskHandle);
+}
+
+TimerWheelHandle_t xTimerWheelCreate(const char * const pcTimerName, TickType_t xTimerPeriodInTicks,
+		UBaseType_t uxAutoReload, void * const pvTimerID, TimerWheelCallback_t pxCallbackFunction)
+{
+	TimerWheelTimer_t *pxTimer;
+
+	configASSERT( xTimerPeriodInTicks > 0 );
+
+	taskENTER_CRITICAL();
+	pxTimer = pxFreeList;
+	if(pxTimer != NULL)
+	{
+		pxFreeList = (TimerWheelTimer_t *) pxTimer->xLink.pxNext;
+	}
+	taskEXIT_CRITICAL();
+
+	if(pxTimer != NULL)
+	{
+		pxTimer->xLink.pxNext = NULL;
+		pxTimer->xLink.pxPrev = NULL;
+		pxTimer->xExpiry = 0;
+		pxTimer->xPeriod = xTimerPeriodInTicks;
+		pxTimer->pxCallback = pxCallbackFunction;
+		pxTimer->pvTimerID = pvTimerID;
+		pxTimer->pcTimerName = pcTimerName;
+		pxTimer->usSlot = 0;
+		pxTimer->ucLevel = 0;
+		pxTimer->ucFlags = TIMER_FLAG_IN_USE | ( (uxAutoReload != pdFALSE) ? TIMER_FLAG_AUTO_RELOAD : 0 );
+	}
+
+	return pxTimer;
+}
+
+BaseType_t xTimerWheelStart(TimerWheelHandle_t xTimer, TickType_t xTicksToWait)
+{
+	BaseType_t xWakeService;
+
+	( void ) xTicksToWait;
+	configASSERT( xTimer != NULL );
+
+	taskENTER_CRITICAL();
+	xWakeService = prvStartTimer(xTimer, xTaskGetTickCount());
+	taskEXIT_CRITICAL();
+
+	if(xWakeService != pdFALSE)
+	{
+		xTaskNotifyGive(xTimerWheelTaskHandle);
+	}
+
+	return pdPASS;
+}
+
+BaseType_t xTimerWheelStop(TimerWheelHandle_t xTimer, TickType_t xTicksToWait)
+{
+	( void ) xTicksToWait;
+	configASSERT( xTimer != NULL );
+
+	/*
+	 * The service task does not need to be woken. If it sleeps until this timer,
+	 * it will just find an empty slot and go back to sleep.
+	 */
+	taskENTER_CRITICAL();
+	prvRemoveTimer(xTimer);
+	taskEXIT_CRITICAL();
+
+	return pdPASS;
+}
+
+BaseType_t xTimerWheelChangePeriod(TimerWheelHandle_t xTimer, TickType_t xNewPeriod, TickType_t xTicksToWait)
+{
+	configASSERT( xNewPeriod > 0 );
+
+	//Like xTimerChangePeriod(), changing the period also starts the timer
+	xTimer->xPeriod = xNewPeriod;
+	return xTimerWheelStart(xTimer, xTicksToWait);
+}
+
+BaseType_t xTimerWheelDelete(TimerWheelHandle_t xTimer, TickType_t xTicksToWait)
+{
+	( void ) xTicksToWait;
+	configASSERT( xTimer != NULL );
+
+	taskENTER_CRITICAL();
+	prvRemoveTimer(xTimer);
+	xTimer->ucFlags = 0;
+	xTimer->xLink.pxNext = (TimerWheelLink_t *) pxFreeList;
+	pxFreeList = xTimer;
+	taskEXIT_CRITICAL();
+
+	return pdPASS;
+}
+
+BaseType_t xTimerWheelStartFromISR(TimerWheelHandle_t xTimer, BaseType_t *pxHigherPriorityTaskWoken)
+{
+	BaseType_t xWakeService;
+	UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( xTimer != NULL );
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	xWakeService = prvStartTimer(xTimer, xTaskGetTickCountFromISR());
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+
+	if(xWakeService != pdFALSE)
+	{
+		vTaskNotifyGiveFromISR(xTimerWheelTaskHandle, pxHigherPriorityTaskWoken);
+	}
+
+	return pdPASS;
+}
+
+BaseType_t xTimerWheelStopFromISR(TimerWheelHandle_t xTimer, BaseType_t *pxHigherPriorityTaskWoken)
+{
+	UBaseType_t uxSavedInterruptStatus;
+
+	( void ) pxHigherPriorityTaskWoken;
+	configASSERT( xTimer != NULL );
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	prvRemoveTimer(xTimer);
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+
+	return pdPASS;
+}
+
+BaseType_t xTimerWheelChangePeriodFromISR(TimerWheelHandle_t xTimer, TickType_t xNewPeriod, BaseType_t *pxHigherPriorityTaskWoken)
+{
+	configASSERT( xNewPeriod > 0 );
+
+	xTimer->xPeriod = xNewPeriod;
+	return xTimerWheelStartFromISR(xTimer, pxHigherPriorityTaskWoken);
+}
+
+BaseType_t xTimerWheelIsTimerActive(TimerWheelHandle_t xTimer)
+{
+	return ( (xTimer->ucFlags & TIMER_FLAG_ACTIVE) != 0 ) ? pdTRUE : pdFALSE;
+}
+
+void *pvTimerWheelGetTimerID(TimerWheelHandle_t xTimer)
+{
+	return xTimer->pvTimerID;
+}
+
+void vTimerWheelSetTimerID(TimerWheelHandle_t xTimer, void *pvNewID)
+{
+	xTimer->pvTimerID = pvNewID;
+}
+
+const char *pcTimerWheelGetName(TimerWheelHandle_t xTimer)
+{
+	return xTimer->pcTimerName;
+}
+
+TickType_t xTimerWheelGetPeriod(TimerWheelHandle_t xTimer)
+{
+	return xTimer->xPeriod;
+}
+
+TickType_t xTimerWheelGetExpiryTime(TimerWheelHandle_t xTimer)
+{
+	return xTimer->xExpiry;
+}
+
+TaskHandle_t xTimerWheelGetTaskHandle(void)
+{
+	return xTimerWheelTaskHandle;
+}
+
+
+static void prvTimerWheelTask(void *params)
+{
+	TimerWheelLink_t xExpired;
+	TimerWheelTimer_t *pxTimer;
+	TickType_t xNow, xTicksToWait;
+
+	prvListInit(&xExpired);
+
+	while(1)
+	{
+		xNow = xTaskGetTickCount();
+
+		//Move every timer which is due into the local expired list
+		taskENTER_CRITICAL();
+		xServiceSleeping = pdFALSE;
+		prvCollectExpired(xNow, &xExpired);
+		taskEXIT_CRITICAL();
+
+		/*
+		 * Execute the callbacks one by one outside of the critical section.
+		 * A callback may stop or delete any timer (even one still in the expired list),
+		 * so the list is re-checked under the critical section every time.
+		 */
+		while(1)
+		{
+			taskENTER_CRITICAL();
+			if(xExpired.pxNext == &xExpired)
+			{
+				taskEXIT_CRITICAL();
+				break;
+			}
+
+			pxTimer = (TimerWheelTimer_t *) xExpired.pxNext;
+			prvListRemove(&pxTimer->xLink);
+
+			if(pxTimer->ucFlags & TIMER_FLAG_AUTO_RELOAD)
+			{
+				//Reload relative to the expiry time (not to the current time) so the period does not drift
+				pxTimer->xExpiry += pxTimer->xPeriod;
+				prvInsertTimer(pxTimer);
+			}
+			else
+			{
+				pxTimer->ucFlags &= ~TIMER_FLAG_ACTIVE;
+				uxActiveCount--;
+			}
+			taskEXIT_CRITICAL();
+
+			pxTimer->pxCallback(pxTimer);
+		}
+
+		//Sleep until the next occupied slot. Starting an earlier timer notifies this task.
+		taskENTER_CRITICAL();
+		xNow = xTaskGetTickCount();
+		xTicksToWait = prvTicksToNextEvent(xNow);
+		xNextWakeTick = xNow + xTicksToWait;
+		xSleepForever = (xTicksToWait == portMAX_DELAY) ? pdTRUE : pdFALSE;
+		xServiceSleeping = pdTRUE;
+		taskEXIT_CRITICAL();
+
+		ulTaskNotifyTake(pdTRUE, xTicksToWait);
+	}
+}
+
+static void prvCollectExpired(TickType_t xNow, TimerWheelLink_t *pxExpired)
+{
+	UBaseType_t uxIndex, uxNext, uxLevel;
+	TickType_t xJump, xRemaining;
+	TimerWheelLink_t *pxLink;
+
+	//Process every tick up to and including xNow (wrap-around safe comparison)
+	while( (int32_t)(xNow - xWheelTime) >= 0 )
+	{
+		uxIndex = xWheelTime & L0_MASK;
+
+		//Level 0 wrapped: cascade the next slot of level 1, and of the higher levels if they wrap too
+		if( (uxIndex == 0) && (uxUpperCount != 0) )
+		{
+			for(uxLevel = 1; uxLevel < TIMER_WHEEL_LEVELS; uxLevel++)
+			{
+				if( prvCascade(uxLevel, (xWheelTime >> LEVEL_SHIFT(uxLevel)) & LN_MASK) != 0 )
+				{
+					break;
+				}
+			}
+		}
+
+		if(xLevel0[uxIndex].pxNext != &xLevel0[uxIndex])
+		{
+			//Hand the whole slot over to the service task
+			for(pxLink = xLevel0[uxIndex].pxNext; pxLink != &xLevel0[uxIndex]; pxLink = pxLink->pxNext)
+			{
+				( (TimerWheelTimer_t *) pxLink )->ucLevel = LEVEL_EXPIRED;
+			}
+			prvListMove(&xLevel0[uxIndex], pxExpired);
+			ulLevel0Map[uxIndex >> 5] &= ~( 1UL << (uxIndex & 31UL) );
+			xWheelTime++;
+		}
+		else
+		{
+			/*
+			 * Skip the empty slots in one step, up to the next occupied slot or up to the end
+			 * of level 0 (cascade point, and the occupied slots of the next revolution).
+			 */
+			uxNext = prvNextOccupiedSlot(uxIndex);
+			xRemaining = (xNow - xWheelTime) + 1;
+			xJump = uxNext - uxIndex;
+
+			if(xJump > xRemaining)
+			{
+				xJump = xRemaining;
+			}
+
+			xWheelTime += xJump;
+		}
+	}
+}
+
+static TickType_t prvTicksToNextEvent(TickType_t xNow)
+{
+	UBaseType_t uxIndex, uxNext;
+	TickType_t xBehind;
+
+	if(uxActiveCount == 0)
+	{
+		return portMAX_DELAY;
+	}
+
+	//Wheel is behind the tick count (e.g. the callbacks took long), process again immediately
+	xBehind = xNow - xWheelTime;
+	if( (int32_t)xBehind >= 0 )
+	{
+		return 0;
+	}
+
+	uxIndex = xWheelTime & L0_MASK;
+
+	//The next tick is a cascade point, which may bring timers due on that very tick
+	if( (uxIndex == 0) && (uxUpperCount != 0) )
+	{
+		return xWheelTime - xNow;
+	}
+
+	uxNext = prvNextOccupiedSlot(uxIndex);
+
+	if( (uxNext == L0_SIZE) && (uxUpperCount == 0) )
+	{
+		//Only possible if the occupied slots are before uxIndex, i.e. in the next revolution
+		uxNext = prvNextOccupiedSlot(0) + L0_SIZE;
+	}
+
+	//Slot uxNext is processed when the tick count reaches xWheelTime + (uxNext - uxIndex)
+	return (xWheelTime - xNow) + (TickType_t)(uxNext - uxIndex);
+}
+
+static BaseType_t prvStartTimer(TimerWheelTimer_t *pxTimer, TickType_t xNow)
+{
+	if(pxTimer->ucFlags & TIMER_FLAG_ACTIVE)
+	{
+		prvRemoveTimer(pxTimer);
+	}
+
+	pxTimer->xExpiry = xNow + pxTimer->xPeriod;
+	pxTimer->ucFlags |= TIMER_FLAG_ACTIVE;
+	uxActiveCount++;
+	prvInsertTimer(pxTimer);
+
+	//Wake the service task only if it sleeps beyond the new expiry time
+	if(xServiceSleeping == pdFALSE)
+	{
+		return pdFALSE;
+	}
+
+	return ( (xSleepForever != pdFALSE) || ( (int32_t)(pxTimer->xExpiry - xNextWakeTick) < 0 ) ) ? pdTRUE : pdFALSE;
+}
+
+static void prvInsertTimer(TimerWheelTimer_t *pxTimer)
+{
+	TickType_t xExpiry = pxTimer->xExpiry;
+	TickType_t xDelta = xExpiry - xWheelTime;
+	UBaseType_t uxLevel;
+	UBaseType_t uxSlot;
+
+	if( (int32_t)xDelta < 0 )
+	{
+		//Already due: it goes to the next slot to be processed
+		uxLevel = 0;
+		uxSlot = xWheelTime & L0_MASK;
+	}
+	else if(xDelta < L0_SIZE)
+	{
+		uxLevel = 0;
+		uxSlot = xExpiry & L0_MASK;
+	}
+	else
+	{
+		for(uxLevel = 1; uxLevel < (TIMER_WHEEL_LEVELS - 1); uxLevel++)
+		{
+			if( xDelta < ( 1UL << LEVEL_SHIFT(uxLevel + 1) ) )
+			{
+				break;
+			}
+		}
+		uxSlot = (xExpiry >> LEVEL_SHIFT(uxLevel)) & LN_MASK;
+	}
+
+	pxTimer->ucLevel = (uint8_t) uxLevel;
+	pxTimer->usSlot = (uint16_t) uxSlot;
+
+	if(uxLevel == 0)
+	{
+		prvListInsertTail(&xLevel0[uxSlot], &pxTimer->xLink);
+		ulLevel0Map[uxSlot >> 5] |= ( 1UL << (uxSlot & 31UL) );
+	}
+	else
+	{
+		prvListInsertTail(&xLevelN[uxLevel - 1][uxSlot], &pxTimer->xLink);
+		uxUpperCount++;
+	}
+}
+
+static void prvRemoveTimer(TimerWheelTimer_t *pxTimer)
+{
+	UBaseType_t uxSlot = pxTimer->usSlot;
+
+	if( (pxTimer->ucFlags & TIMER_FLAG_ACTIVE) == 0 )
+	{
+		return;
+	}
+
+	prvListRemove(&pxTimer->xLink);
+	pxTimer->ucFlags &= ~TIMER_FLAG_ACTIVE;
+	uxActiveCount--;
+
+	if(pxTimer->ucLevel == 0)
+	{
+		if(xLevel0[uxSlot].pxNext == &xLevel0[uxSlot])
+		{
+			ulLevel0Map[uxSlot >> 5] &= ~( 1UL << (uxSlot & 31UL) );
+		}
+	}
+	else if(pxTimer->ucLevel != LEVEL_EXPIRED)
+	{
+		uxUpperCount--;
+	}
+}
+
+static UBaseType_t prvCascade(UBaseType_t uxLevel, UBaseType_t uxIndex)
+{
+	TimerWheelLink_t xList;
+	TimerWheelTimer_t *pxTimer;
+
+	prvListInit(&xList);
+	prvListMove(&xLevelN[uxLevel - 1][uxIndex], &xList);
+
+	//Re-insert the timers. They now land in a lower level (or in level 0)
+	while(xList.pxNext != &xList)
+	{
+		pxTimer = (TimerWheelTimer_t *) xList.pxNext;
+		prvListRemove(&pxTimer->xLink);
+		uxUpperCount--;
+		prvInsertTimer(pxTimer);
+	}
+
+	return uxIndex;
+}
+
+static UBaseType_t prvNextOccupiedSlot(UBaseType_t uxIndex)
+{
+	UBaseType_t uxWord = uxIndex >> 5;
+	uint32_t ulBits = ulLevel0Map[uxWord] & ( 0xFFFFFFFFUL << (uxIndex & 31UL) );
+
+	//Returns L0_SIZE if there is no occupied slot from uxIndex to the end of level 0
+	while(1)
+	{
+		if(ulBits != 0)
+		{
+			return (uxWord << 5) + (UBaseType_t) __builtin_ctz(ulBits);
+		}
+
+		if(++uxWord >= MAP_WORDS)
+		{
+			return L0_SIZE;
+		}
+
+		ulBits = ulLevel0Map[uxWord];
+	}
+}
+
+static void prvListInit(TimerWheelLink_t *pxList)
+{
+	pxList->pxNext = pxList;
+	pxList->pxPrev = pxList;
+}
+
+static void prvListInsertTail(TimerWheelLink_t *pxList, TimerWheelLink_t *pxLink)
+{
+	pxLink->pxNext = pxList;
+	pxLink->pxPrev = pxList->pxPrev;
+	pxList->pxPrev->pxNext = pxLink;
+	pxList->pxPrev = pxLink;
+}
+
+static void prvListRemove(TimerWheelLink_t *pxLink)
+{
+	pxLink->pxPrev->pxNext = pxLink->pxNext;
+	pxLink->pxNext->pxPrev = pxLink->pxPrev;
+	pxLink->pxNext = pxLink;
+	pxLink->pxPrev = pxLink;
+}
+
+static void prvListMove(TimerWheelLink_t *pxFrom, TimerWheelLink_t *pxTo)
+{
+	//Append all the entries of pxFrom at the end of pxTo, and leave pxFrom empty
+	if(pxFrom->pxNext == pxFrom)
+	{
+		return;
+	}
+
+	pxFrom->pxNext->pxPrev = pxTo->pxPrev;
+	pxTo->pxPrev->pxNext = pxFrom->pxNext;
+	pxFrom->pxPrev->pxNext = pxTo;
+	pxTo->pxPrev = pxFrom->pxPrev;
+
+	prvListInit(pxFrom);
+}
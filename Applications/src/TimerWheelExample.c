@@ -0,0 +1,351 @@
+/*
+ * TimerWheelExample.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * This application toggles the LED with the timer wheel service (TimerWheel.c) instead of xTimerCreate(),
+ * and benchmarks the timer wheel against the FreeRTOS software timers (timers.c) with 10, 100 and 1000 timers.
+ *
+ * For each timer count it reports:
+ *  - The average number of CPU cycles (DWT) for a start and for a stop call.
+ *    The benchmark task runs below the timer task, so for timers.c the measured time also includes
+ *    the timer task processing the command (the O(n) insertion into the sorted active timer list).
+ *  - The CPU load while all the timers are running with periods between 10ms and 200ms.
+ *    The load is measured by counting the idle loop iterations against a run without any timer.
+ *
+ * configUSE_TIMERS must be 1. TimerWheel.c has to be included in the build with this file.
+ * The FreeRTOS timers are allocated from the 12KB heap, so timers.c cannot create all of the 1000 timers.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stm32wbxx.h"
+#include "stm32wbxx_nucleo.h"
+#include "stdio.h"
+#include "string.h"
+#include "timers.h"	//For software timers
+#include "TimerWheel.h"
+
+//Macros
+#define TRUE 			1
+#define FALSE 			0
+
+#define BENCH_MAX_TIMERS		1000
+#define BENCH_RUN_TIME_MS		1000
+#define BENCH_MIN_PERIOD_MS		10
+#define BENCH_MAX_PERIOD_MS		200
+
+//Task handles and function prototypes
+TaskHandle_t xBenchmarkTaskHandle = NULL;
+void vBenchmarkTaskFunction(void *params);
+
+//Timer handles used by the benchmark
+TimerHandle_t xRtosTimers[BENCH_MAX_TIMERS];
+TimerWheelHandle_t xWheelTimers[BENCH_MAX_TIMERS];
+TimerWheelHandle_t xLEDTimerHandle = NULL;
+
+//Variables related to peripherals
+GPIO_InitTypeDef GpioLEDpin, GpioUARTpins;
+UART_HandleTypeDef Uart1;
+UART_InitTypeDef Uart1Init;
+
+//Helper functions
+static void prvSetupLED(void);
+static void prvSetupUART(void);
+static uint32_t prvNextPeriod(void);
+static uint32_t prvMeasureIdle(void);
+static void prvBenchmarkRtosTimers(uint32_t ulCount, uint32_t ulIdleBase);
+static void prvBenchmarkWheelTimers(uint32_t ulCount, uint32_t ulIdleBase);
+void ToggleLED(TimerWheelHandle_t xTimer);
+void RtosTimerCallback(TimerHandle_t xTimer);
+void WheelTimerCallback(TimerWheelHandle_t xTimer);
+
+//Helper variables
+void printmsg(char *msg);
+char usr_msg[250];
+volatile uint32_t ulIdleCount = 0;
+volatile uint32_t ulExpiredCount = 0;
+uint32_t ulPeriodSeed = 1;
+
+int main()
+{
+	// Enable the DWT Cycle Count Register (SEGGER Settings)
+	DWT->CTRL |= (1 << 0);
+
+	// Private function called to setup the Hardware
+	prvSetupLED();
+	prvSetupUART();
+
+	sprintf(usr_msg, "\r\nThis is the Timer Wheel Example application: \r\n");
+	printmsg(usr_msg);
+
+	// Start recording the FreeRTOS Application data in SEGGER
+	SEGGER_SYSVIEW_Conf();
+	SEGGER_SYSVIEW_Start();
+
+	/*
+	 * The timer wheel task runs at the same priority as the FreeRTOS timer task,
+	 * so both the services are compared under the same conditions.
+	 */
+	if(xTimerWheelInit(configTIMER_TASK_PRIORITY, configTIMER_TASK_STACK_DEPTH) != pdPASS)
+	{
+		sprintf(usr_msg, "Timer wheel creation failed !");
+		printmsg(usr_msg);
+		return 0;
+	}
+
+	//Toggle the LED every 500ms using the timer wheel
+	xLEDTimerHandle = xTimerWheelCreate("LED-Timer", pdMS_TO_TICKS(500), pdTRUE, NULL, ToggleLED);
+	xTimerWheelStart(xLEDTimerHandle, portMAX_DELAY);
+
+	//Benchmark task is below the timer task priority
+	xTaskCreate(vBenchmarkTaskFunction, "Timer-Benchmark", 512, NULL, 1, &xBenchmarkTaskHandle);
+
+	//Schedule the tasks
+	vTaskStartScheduler();
+
+	for(;;);
+}
+
+void vBenchmarkTaskFunction(void *params)
+{
+	const uint32_t ulCounts[] = { 10, 100, 1000 };
+	uint32_t ulIdleBase;
+	uint8_t i;
+
+	//Idle loop count without any benchmark timer running (reference for the CPU load)
+	ulIdleBase = prvMeasureIdle();
+
+	sprintf(usr_msg, "\r\nIdle reference: %lu loops in %d ms \r\n", ulIdleBase, BENCH_RUN_TIME_MS);
+	printmsg(usr_msg);
+
+	for(i = 0; i < (sizeof(ulCounts) / sizeof(ulCounts[0])); i++)
+	{
+		prvBenchmarkRtosTimers(ulCounts[i], ulIdleBase);
+		prvBenchmarkWheelTimers(ulCounts[i], ulIdleBase);
+	}
+
+	sprintf(usr_msg, "\r\nBenchmark finished. \r\n");
+	printmsg(usr_msg);
+
+	vTaskDelete(NULL);
+}
+
+static void prvBenchmarkRtosTimers(uint32_t ulCount, uint32_t ulIdleBase)
+{
+	uint32_t i, ulCreated = 0, ulStart, ulStartCycles = 0, ulStopCycles = 0, ulIdle;
+
+	ulPeriodSeed = 1;
+
+	for(i = 0; i < ulCount; i++)
+	{
+		xRtosTimers[i] = xTimerCreate("Bench", pdMS_TO_TICKS(prvNextPeriod()), pdTRUE, NULL, RtosTimerCallback);
+		if(xRtosTimers[i] == NULL)
+		{
+			break;
+		}
+		ulCreated++;
+	}
+
+	//Start all the timers
+	for(i = 0; i < ulCreated; i++)
+	{
+		ulStart = DWT->CYCCNT;
+		xTimerStart(xRtosTimers[i], portMAX_DELAY);
+		ulStartCycles += DWT->CYCCNT - ulStart;
+	}
+
+	ulExpiredCount = 0;
+	ulIdle = prvMeasureIdle();
+
+	//Stop all the timers
+	for(i = 0; i < ulCreated; i++)
+	{
+		ulStart = DWT->CYCCNT;
+		xTimerStop(xRtosTimers[i], portMAX_DELAY);
+		ulStopCycles += DWT->CYCCNT - ulStart;
+	}
+
+	if(ulCreated == 0)
+	{
+		sprintf(usr_msg, "timers.c   %4lu timers: no timer could be created \r\n", ulCount);
+		printmsg(usr_msg);
+		return;
+	}
+
+	sprintf(usr_msg, "timers.c   %4lu timers (%4lu created): start %6lu cyc, stop %6lu cyc, %5lu expiries, CPU load %3lu%% \r\n",
+			ulCount, ulCreated, ulStartCycles / ulCreated, ulStopCycles / ulCreated, ulExpiredCount,
+			(ulIdle >= ulIdleBase) ? 0 : ( (ulIdleBase - ulIdle) * 100 ) / ulIdleBase);
+	printmsg(usr_msg);
+
+	for(i = 0; i < ulCreated; i++)
+	{
+		xTimerDelete(xRtosTimers[i], portMAX_DELAY);
+	}
+
+	//Let the timer task free the deleted timers
+	vTaskDelay(pdMS_TO_TICKS(10));
+}
+
+static void prvBenchmarkWheelTimers(uint32_t ulCount, uint32_t ulIdleBase)
+{
+	uint32_t i, ulCreated = 0, ulStart, ulStartCycles = 0, ulStopCycles = 0, ulIdle;
+
+	ulPeriodSeed = 1;
+
+	for(i = 0; i < ulCount; i++)
+	{
+		xWheelTimers[i] = xTimerWheelCreate("Bench", pdMS_TO_TICKS(prvNextPeriod()), pdTRUE, NULL, WheelTimerCallback);
+		if(xWheelTimers[i] == NULL)
+		{
+			break;
+		}
+		ulCreated++;
+	}
+
+	for(i = 0; i < ulCreated; i++)
+	{
+		ulStart = DWT->CYCCNT;
+		xTimerWheelStart(xWheelTimers[i], portMAX_DELAY);
+		ulStartCycles += DWT->CYCCNT - ulStart;
+	}
+
+	ulExpiredCount = 0;
+	ulIdle = prvMeasureIdle();
+
+	for(i = 0; i < ulCreated; i++)
+	{
+		ulStart = DWT->CYCCNT;
+		xTimerWheelStop(xWheelTimers[i], portMAX_DELAY);
+		ulStopCycles += DWT->CYCCNT - ulStart;
+	}
+
+	if(ulCreated == 0)
+	{
+		sprintf(usr_msg, "TimerWheel %4lu timers: no timer could be created \r\n", ulCount);
+		printmsg(usr_msg);
+		return;
+	}
+
+	sprintf(usr_msg, "TimerWheel %4lu timers (%4lu created): start %6lu cyc, stop %6lu cyc, %5lu expiries, CPU load %3lu%% \r\n",
+			ulCount, ulCreated, ulStartCycles / ulCreated, ulStopCycles / ulCreated, ulExpiredCount,
+			(ulIdle >= ulIdleBase) ? 0 : ( (ulIdleBase - ulIdle) * 100 ) / ulIdleBase);
+	printmsg(usr_msg);
+
+	for(i = 0; i < ulCreated; i++)
+	{
+		xTimerWheelDelete(xWheelTimers[i], portMAX_DELAY);
+	}
+}
+
+static uint32_t prvMeasureIdle(void)
+{
+	uint32_t ulIdleStart = ulIdleCount;
+
+	//The benchmark task blocks, so only the timer services and the idle task run during this time
+	vTaskDelay(pdMS_TO_TICKS(BENCH_RUN_TIME_MS));
+
+	return ulIdleCount - ulIdleStart;
+}
+
+static uint32_t prvNextPeriod(void)
+{
+	//Small LCG, so that both the services get exactly the same sequence of periods
+	ulPeriodSeed = (ulPeriodSeed * 1103515245UL) + 12345UL;
+	return BENCH_MIN_PERIOD_MS + ( (ulPeriodSeed >> 16) % (BENCH_MAX_PERIOD_MS - BENCH_MIN_PERIOD_MS + 1) );
+}
+
+void ToggleLED(TimerWheelHandle_t xTimer)
+{
+	HAL_GPIO_TogglePin(LED1_GPIO_PORT, LED1_PIN);
+}
+
+void RtosTimerCallback(TimerHandle_t xTimer)
+{
+	ulExpiredCount++;
+}
+
+void WheelTimerCallback(TimerWheelHandle_t xTimer)
+{
+	ulExpiredCount++;
+}
+
+static void prvSetupLED(void)
+{
+	LED1_GPIO_CLK_ENABLE();
+
+	//Zeroing each and every member element of the structure.
+	memset(&GpioLEDpin, 0, sizeof(GpioLEDpin));
+	GpioLEDpin.Pin = LED1_PIN;
+	GpioLEDpin.Mode = GPIO_MODE_OUTPUT_PP;
+	GpioLEDpin.Speed = GPIO_SPEED_FREQ_MEDIUM;
+	GpioLEDpin.Pull = GPIO_NOPULL;
+
+	HAL_GPIO_Init(GPIOB, &GpioLEDpin);
+	HAL_GPIO_TogglePin(GPIOB, LED1_PIN);
+	HAL_GPIO_TogglePin(GPIOB, LED1_PIN);
+
+}
+
+static void prvSetupUART(void)
+{
+	//1. Enable the UART1 and GPIOB Peripheral Clocks
+	__HAL_RCC_USART1_CLK_ENABLE();
+	__HAL_RCC_GPIOB_CLK_ENABLE();
+
+	//In UART connection with Virtual COM-port, PB6->TX and PB7->RX
+	//2. Alternate Functionality Configuration to make Port B pins work as UART pins
+
+	//Zeroing each and every member element of the structure.
+	memset(&GpioUARTpins, 0, sizeof(GpioUARTpins));
+	GpioUARTpins.Pin = GPIO_PIN_6 | GPIO_PIN_7;
+	GpioUARTpins.Mode = GPIO_MODE_AF_PP;
+	GpioUARTpins.Alternate = GPIO_AF7_USART1;
+	GpioUARTpins.Pull = GPIO_PULLUP;
+
+	HAL_GPIO_Init(GPIOB, &GpioUARTpins);
+
+	//3. Configure and initialize UART parameters
+
+	//Zeroing each and every member element of the structure.
+	memset(&Uart1Init, 0, sizeof(Uart1Init));
+	memset(&Uart1, 0, sizeof(Uart1));
+
+	//UART Initialization
+	Uart1Init.BaudRate = 115200;
+	Uart1Init.WordLength = UART_WORDLENGTH_8B;
+	Uart1Init.HwFlowCtl = UART_HWCONTROL_NONE;
+	Uart1Init.Mode = UART_MODE_TX_RX;
+	Uart1Init.Parity = UART_PARITY_NONE;
+	Uart1Init.StopBits = UART_STOPBITS_1;
+
+	Uart1.Init = Uart1Init;
+	Uart1.Instance = USART1;
+
+	//4. Initialize the UART peripheral
+	uint16_t UARTSetUpResult = HAL_UART_Init(&Uart1);
+
+	if(UARTSetUpResult == HAL_ERROR)
+	{
+		//printf("USART Initialization was not successful \n");
+	}
+
+}
+
+void printmsg(char *msg)
+{
+	HAL_UART_Transmit(&Uart1, (uint8_t *)msg, strlen(msg), 1);
+}
+
+//Implement the Idle Hook function
+void vApplicationIdleHook()
+{
+	/*
+	 * No __WFI() here: the idle loop iterations are counted to measure the CPU load
+	 * left over by the timer services.
+	 */
+	ulIdleCount++;
+}
@@ -0,0 +1,319 @@
+/*
+ * TouchKeys.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * The IOs are pulled low between the acquisitions (IODEF): the electrodes and the sampling capacitors are
+ * discharged during the scan period, before the next acquisition.
+ *
+ * The baseline is kept with 4 fractional bits, so the tracking can follow a drift smaller than one count
+ * per acquisition. A count above the baseline by more than the release threshold (e.g. the key was touched
+ * during the calibration) sets the baseline to the count at once.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "timers.h"
+#include "stm32wbxx.h"
+#include "stm32wbxx_hal.h"
+#include "string.h"
+#include "TouchKeys.h"
+
+//One key: electrode on a channel IO, sampling capacitor on another IO of the same group
+typedef struct TouchKeyPins
+{
+	GPIO_TypeDef *pxChannelPort;
+	uint16_t usChannelPin;
+	GPIO_TypeDef *pxSamplingPort;
+	uint16_t usSamplingPin;
+	uint32_t ulChannelIO;
+	uint32_t ulSamplingIO;
+	uint32_t ulGroupIndex;
+}TouchKeyPins_t;
+
+typedef struct TouchKey
+{
+	TouchKeyState_t xState;
+	int32_t lBaseline;						//Baseline * 16
+	uint32_t ulCalibrationSum;
+	uint32_t ulScans;						//Calibration scans, then scans of the press
+	uint8_t ucDebounce;
+}TouchKey_t;
+
+//Keys (AF9): PB12 (TSC_G1_IO1) with its sampling capacitor on PB15 (TSC_G1_IO4), PB4 (TSC_G2_IO1) with PB5 (TSC_G2_IO2)
+static const TouchKeyPins_t xKeyPins[TOUCH_KEYS] =
+{
+	{ GPIOB, GPIO_PIN_12, GPIOB, GPIO_PIN_15, TSC_GROUP1_IO1, TSC_GROUP1_IO4, TSC_GROUP1_IDX },
+	{ GPIOB, GPIO_PIN_4, GPIOB, GPIO_PIN_5, TSC_GROUP2_IO1, TSC_GROUP2_IO2, TSC_GROUP2_IDX },
+};
+
+static TSC_HandleTypeDef TscHandle;
+static TimerHandle_t xScanTimer = NULL;
+static QueueHandle_t xQueue = NULL;
+
+//Changed by the interrupt
+static TouchKey_t xKeys[TOUCH_KEYS];
+static TouchStats_t xStats;
+
+//Private helper functions
+static void prvSetupPins(void);
+static void prvScanTimerCallback(TimerHandle_t xTimer);
+static void prvUpdateKey(UBaseType_t uxKey, uint16_t usCount, BaseType_t *pxHigherPriorityTaskWoken);
+static void prvPostEvent(UBaseType_t uxKey, uint8_t ucType, int16_t sDelta, BaseType_t *pxHigherPriorityTaskWoken);
+
+
+BaseType_t xTouchKeysInit(QueueHandle_t xEventQueue)
+{
+	uint32_t ulChannelIOs = 0, ulSamplingIOs = 0;
+	UBaseType_t i;
+
+	xQueue = xEventQueue;
+	memset(xKeys, 0, sizeof(xKeys));
+	memset(&xStats, 0, sizeof(xStats));
+
+	for(i = 0; i < TOUCH_KEYS; i++)
+	{
+		ulChannelIOs |= xKeyPins[i].ulChannelIO;
+		ulSamplingIOs |= xKeyPins[i].ulSamplingIO;
+	}
+
+	//1. Pins
+	prvSetupPins();
+
+	//2. TSC: short charge transfer pulses, all the groups of the keys acquired together
+	memset(&TscHandle, 0, sizeof(TscHandle));
+	TscHandle.Instance = TSC;
+	TscHandle.Init.CTPulseHighLength = TSC_CTPH_2CYCLES;
+	TscHandle.Init.CTPulseLowLength = TSC_CTPL_2CYCLES;
+	TscHandle.Init.SpreadSpectrum = DISABLE;
+	TscHandle.Init.SpreadSpectrumDeviation = 1;
+	TscHandle.Init.SpreadSpectrumPrescaler = TSC_SS_PRESC_DIV1;
+	TscHandle.Init.PulseGeneratorPrescaler = TSC_PG_PRESC_DIV4;
+	TscHandle.Init.MaxCountValue = TSC_MCV_8191;
+	TscHandle.Init.IODefaultMode = TSC_IODEF_OUT_PP_LOW;
+	TscHandle.Init.SynchroPinPolarity = TSC_SYNC_POLARITY_FALLING;
+	TscHandle.Init.AcquisitionMode = TSC_ACQ_MODE_NORMAL;
+	TscHandle.Init.MaxCountInterrupt = ENABLE;
+	TscHandle.Init.ChannelIOs = ulChannelIOs;
+	TscHandle.Init.ShieldIOs = 0;
+	TscHandle.Init.SamplingIOs = ulSamplingIOs;
+
+	if(HAL_TSC_Init(&TscHandle) != HAL_OK)
+	{
+		return pdFAIL;
+	}
+
+	__HAL_TSC_CLEAR_FLAG(&TscHandle, TSC_FLAG_EOA | TSC_FLAG_MCE);
+	__HAL_TSC_ENABLE_IT(&TscHandle, TSC_IT_EOA | TSC_IT_MCE);
+
+	NVIC_SetPriority(TSC_IRQn, TOUCH_IRQ_PRIORITY); //Priority should be less than or equal to configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY
+	NVIC_EnableIRQ(TSC_IRQn);
+
+	//3. Scan timer
+	xScanTimer = xTimerCreate("Touch-Scan", pdMS_TO_TICKS(TOUCH_SCAN_PERIOD_MS), pdTRUE, NULL, prvScanTimerCallback);
+	if( (xScanTimer == NULL) || (xTimerStart(xScanTimer, 0) != pdPASS) )
+	{
+		return pdFAIL;
+	}
+
+	return pdPASS;
+}
+
+void vTouchKeysGetState(UBaseType_t uxKey, TouchKeyState_t *pxState)
+{
+	if(uxKey >= TOUCH_KEYS)
+	{
+		memset(pxState, 0, sizeof(TouchKeyState_t));
+		return;
+	}
+
+	taskENTER_CRITICAL();
+	*pxState = xKeys[uxKey].xState;
+	taskEXIT_CRITICAL();
+}
+
+void vTouchKeysGetStats(TouchStats_t *pxStats)
+{
+	taskENTER_CRITICAL();
+	*pxStats = xStats;
+	taskEXIT_CRITICAL();
+}
+
+
+static void prvSetupPins(void)
+{
+	GPIO_InitTypeDef GpioTouchPin;
+	UBaseType_t i;
+
+	__HAL_RCC_GPIOB_CLK_ENABLE();
+
+	memset(&GpioTouchPin, 0, sizeof(GpioTouchPin));
+	GpioTouchPin.Pull = GPIO_NOPULL;
+	GpioTouchPin.Speed = GPIO_SPEED_FREQ_LOW;
+	GpioTouchPin.Alternate = GPIO_AF9_TSC;
+
+	for(i = 0; i < TOUCH_KEYS; i++)
+	{
+		//Electrode: push-pull. Sampling capacitor: open drain.
+		GpioTouchPin.Mode = GPIO_MODE_AF_PP;
+		GpioTouchPin.Pin = xKeyPins[i].usChannelPin;
+		HAL_GPIO_Init(xKeyPins[i].pxChannelPort, &GpioTouchPin);
+
+		GpioTouchPin.Mode = GPIO_MODE_AF_OD;
+		GpioTouchPin.Pin = xKeyPins[i].usSamplingPin;
+		HAL_GPIO_Init(xKeyPins[i].pxSamplingPort, &GpioTouchPin);
+	}
+}
+
+//Timer task: starts one acquisition of all the keys
+static void prvScanTimerCallback(TimerHandle_t xTimer)
+{
+	if((TSC->CR & TSC_CR_START) != 0)
+	{
+		taskENTER_CRITICAL();
+		xStats.ulBusyScans++;
+		taskEXIT_CRITICAL();
+		return;
+	}
+
+	__HAL_TSC_START_ACQ(&TscHandle);
+}
+
+
+//Called by HAL_TSC_Init()
+void HAL_TSC_MspInit(TSC_HandleTypeDef *htsc)
+{
+	__HAL_RCC_TSC_CLK_ENABLE();
+}
+
+//End of an acquisition (or max count error)
+void TSC_IRQHandler(void)
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	uint32_t ulStart = DWT->CYCCNT;
+	uint32_t ulCycles;
+	UBaseType_t i;
+
+	__HAL_TSC_CLEAR_FLAG(&TscHandle, TSC_FLAG_EOA | TSC_FLAG_MCE);
+	xStats.ulAcquisitions++;
+
+	for(i = 0; i < TOUCH_KEYS; i++)
+	{
+		if(__HAL_TSC_GET_GROUP_STATUS(&TscHandle, xKeyPins[i].ulGroupIndex) == TSC_GROUP_COMPLETED)
+		{
+			prvUpdateKey(i, (uint16_t) HAL_TSC_GroupGetValue(&TscHandle, xKeyPins[i].ulGroupIndex), &xHigherPriorityTaskWoken);
+		}
+		else
+		{
+			xStats.ulMaxCountErrors++;
+		}
+	}
+
+	ulCycles = DWT->CYCCNT - ulStart;
+	xStats.ulInterruptCycles += ulCycles;
+	if(ulCycles > xStats.ulWorstInterruptCycles)
+	{
+		xStats.ulWorstInterruptCycles = ulCycles;
+	}
+
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+
+static void prvUpdateKey(UBaseType_t uxKey, uint16_t usCount, BaseType_t *pxHigherPriorityTaskWoken)
+{
+	TouchKey_t *pxKey = &xKeys[uxKey];
+	int32_t lDelta;
+
+	pxKey->xState.usCount = usCount;
+
+	//1. Calibration: average of the first counts
+	if(pxKey->xState.ucCalibrated == 0)
+	{
+		pxKey->ulCalibrationSum += usCount;
+		if(++pxKey->ulScans == TOUCH_CALIBRATION_SCANS)
+		{
+			pxKey->lBaseline = (int32_t) ((pxKey->ulCalibrationSum * 16) / TOUCH_CALIBRATION_SCANS);
+			pxKey->xState.usBaseline = (uint16_t) (pxKey->lBaseline >> 4);
+			pxKey->xState.ucCalibrated = 1;
+			pxKey->ucDebounce = 0;
+		}
+		return;
+	}
+
+	lDelta = (pxKey->lBaseline >> 4) - usCount;
+	pxKey->xState.sDelta = (int16_t) lDelta;
+
+	if(pxKey->xState.ucPressed == 0)
+	{
+		//2. Released: press after TOUCH_DEBOUNCE_SCANS over the threshold, else baseline tracking
+		if(lDelta >= TOUCH_PRESS_THRESHOLD)
+		{
+			if(++pxKey->ucDebounce >= TOUCH_DEBOUNCE_SCANS)
+			{
+				pxKey->xState.ucPressed = 1;
+				pxKey->ucDebounce = 0;
+				pxKey->ulScans = 0;
+				prvPostEvent(uxKey, TOUCH_EVENT_PRESS, (int16_t) lDelta, pxHigherPriorityTaskWoken);
+			}
+		}
+		else
+		{
+			pxKey->ucDebounce = 0;
+			if(lDelta < -TOUCH_RELEASE_THRESHOLD)
+			{
+				pxKey->lBaseline = (int32_t) usCount << 4;
+			}
+			else
+			{
+				pxKey->lBaseline += (((int32_t) usCount << 4) - pxKey->lBaseline) >> TOUCH_BASELINE_SHIFT;
+			}
+			pxKey->xState.usBaseline = (uint16_t) (pxKey->lBaseline >> 4);
+		}
+	}
+	else
+	{
+		//3. Pressed: release after TOUCH_DEBOUNCE_SCANS under the release threshold (hysteresis)
+		if(lDelta < TOUCH_RELEASE_THRESHOLD)
+		{
+			if(++pxKey->ucDebounce >= TOUCH_DEBOUNCE_SCANS)
+			{
+				pxKey->xState.ucPressed = 0;
+				pxKey->ucDebounce = 0;
+				prvPostEvent(uxKey, TOUCH_EVENT_RELEASE, (int16_t) lDelta, pxHigherPriorityTaskWoken);
+			}
+		}
+		else
+		{
+			pxKey->ucDebounce = 0;
+			if(++pxKey->ulScans >= TOUCH_MAX_PRESS_SCANS)
+			{
+				//Stuck: released, and calibrated again
+				pxKey->xState.ucPressed = 0;
+				pxKey->xState.ucCalibrated = 0;
+				pxKey->ulCalibrationSum = 0;
+				pxKey->ulScans = 0;
+				prvPostEvent(uxKey, TOUCH_EVENT_RELEASE, (int16_t) lDelta, pxHigherPriorityTaskWoken);
+			}
+		}
+	}
+}
+
+static void prvPostEvent(UBaseType_t uxKey, uint8_t ucType, int16_t sDelta, BaseType_t *pxHigherPriorityTaskWoken)
+{
+	TouchEvent_t xEvent;
+
+	xEvent.ucKey = (uint8_t) uxKey;
+	xEvent.ucType = ucType;
+	xEvent.usDelta = (sDelta > 0) ? (uint16_t) sDelta : 0;
+	xEvent.xTick = xTaskGetTickCountFromISR();
+
+	if( (xQueue == NULL) || (xQueueSendToBackFromISR(xQueue, &xEvent, pxHigherPriorityTaskWoken) != pdPASS) )
+	{
+		xStats.ulLostEvents++;
+	}
+}
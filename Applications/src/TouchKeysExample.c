@@ -0,0 +1,205 @@
+/*
+ * TouchKeysExample.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * This application reads two capacitive touch keys with the TSC (TouchKeys.c) instead of the button on PC2.
+ *
+ * The acquisitions, the baseline tracking and the debounce run in the background (timer and TSC interrupt).
+ * The Key task only waits on the queue of the events and prints them.
+ * The Report task prints every 2 seconds the acquisitions per second, the CPU time of the TSC interrupt
+ * (average and worst cycles, share of the CPU), the count, baseline and delta of each key, and the errors.
+ * The deltas printed while touching the electrodes give the values for the thresholds of TouchKeys.h.
+ *
+ * Electrodes: a pad or a wire on PB12 and on PB4. Sampling capacitors (e.g. 10 nF) from PB15 and from PB5 to GND.
+ * TouchKeys.c has to be included in the build with this file, and HAL_TSC_MODULE_ENABLED in stm32wbxx_hal_conf.h.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "stm32wbxx.h"
+#include "stm32wbxx_nucleo.h"
+#include "stdio.h"
+#include "string.h"
+#include "TouchKeys.h"
+
+#define REPORT_PERIOD_MS		2000
+#define EVENT_QUEUE_LENGTH		8
+
+//Task handles and functions
+TaskHandle_t xKeyTask = NULL;
+TaskHandle_t xReportTask = NULL;
+void vKeyTaskFunction(void *params);
+void vReportTaskFunction(void *params);
+
+//Queue of the touch events
+QueueHandle_t xTouchQueue = NULL;
+
+//UART Handle and Init types
+UART_HandleTypeDef Uart1;
+UART_InitTypeDef Uart1Init;
+GPIO_InitTypeDef GpioUARTpins;
+
+//Private helper functions and variables
+static void prvSetupUART(void);
+void printmsg(char *msg);
+char UsrMsg[250];
+
+
+int main()
+{
+	// Enable the DWT Cycle Count Register (SEGGER Settings)
+	DWT->CTRL |= (1 << 0);
+
+	// Private functions called to setup the Hardware
+	prvSetupUART();
+
+	//Start Recording for SEGGER SystemView
+	SEGGER_SYSVIEW_Conf();
+	SEGGER_SYSVIEW_Start();
+
+	sprintf(UsrMsg,"Example of touch keys with background TSC acquisition and debounced events \r\n");
+	printmsg(UsrMsg);
+
+	xTouchQueue = xQueueCreate(EVENT_QUEUE_LENGTH, sizeof(TouchEvent_t));
+
+	if( (xTouchQueue != NULL) && (xTouchKeysInit(xTouchQueue) == pdPASS) )
+	{
+		//Create the tasks
+		xTaskCreate(vKeyTaskFunction, "Key-Task", 256, NULL, 2, &xKeyTask);
+		xTaskCreate(vReportTaskFunction, "Report-Task", 384, NULL, 1, &xReportTask);
+
+		//Schedule the tasks
+		vTaskStartScheduler();
+	}
+	else
+	{
+		sprintf(UsrMsg, "TSC initialization failed... :( \r\n");
+		printmsg(UsrMsg);
+	}
+
+	/*
+	 * If scheduler can start the tasks and run them, the program will never reach here.
+	 * If the program comes to the below line, that means there was a problem while creating or scheduling the tasks
+	 */
+	for(;;);
+}
+
+
+void vKeyTaskFunction(void *params)
+{
+	TouchEvent_t xEvent;
+
+	while(1)
+	{
+		//Blocked until an event: no polling
+		xQueueReceive(xTouchQueue, &xEvent, portMAX_DELAY);
+
+		sprintf(UsrMsg, "Key %u %s (delta %u) at tick %lu \r\n", xEvent.ucKey,
+				(xEvent.ucType == TOUCH_EVENT_PRESS) ? "pressed" : "released", xEvent.usDelta, xEvent.xTick);
+		printmsg(UsrMsg);
+	}
+}
+
+
+void vReportTaskFunction(void *params)
+{
+	TouchStats_t xStats, xPrevious;
+	TouchKeyState_t xState;
+	uint32_t ulAcquisitions, ulCycles, ulHundredths;
+	UBaseType_t i;
+
+	vTouchKeysGetStats(&xPrevious);
+
+	while(1)
+	{
+		vTaskDelay(pdMS_TO_TICKS(REPORT_PERIOD_MS));
+
+		vTouchKeysGetStats(&xStats);
+		ulAcquisitions = xStats.ulAcquisitions - xPrevious.ulAcquisitions;
+		ulCycles = xStats.ulInterruptCycles - xPrevious.ulInterruptCycles;
+		xPrevious = xStats;
+
+		//Share of the CPU in hundredths of a percent
+		ulHundredths = (uint32_t) (((uint64_t) ulCycles * 10000 * 1000) / ((uint64_t) SystemCoreClock * REPORT_PERIOD_MS));
+
+		sprintf(UsrMsg, "Acquisitions %lu/s, interrupt: average %lu, worst %lu cycles, CPU %lu.%02lu%% \r\n",
+				(ulAcquisitions * 1000) / REPORT_PERIOD_MS, (ulAcquisitions != 0) ? (ulCycles / ulAcquisitions) : 0,
+				xStats.ulWorstInterruptCycles, ulHundredths / 100, ulHundredths % 100);
+		printmsg(UsrMsg);
+
+		for(i = 0; i < TOUCH_KEYS; i++)
+		{
+			vTouchKeysGetState(i, &xState);
+			sprintf(UsrMsg, "Key %lu: count %u, baseline %u, delta %d%s%s \r\n", i, xState.usCount, xState.usBaseline,
+					xState.sDelta, (xState.ucCalibrated != 0) ? "" : ", calibrating", (xState.ucPressed != 0) ? ", pressed" : "");
+			printmsg(UsrMsg);
+		}
+
+		sprintf(UsrMsg, "Max count errors %lu, busy scans %lu, lost events %lu \r\n",
+				xStats.ulMaxCountErrors, xStats.ulBusyScans, xStats.ulLostEvents);
+		printmsg(UsrMsg);
+	}
+}
+
+
+static void prvSetupUART(void)
+{
+	//1. Enable the UART1 and GPIOB Peripheral Clocks
+	__HAL_RCC_USART1_CLK_ENABLE();
+	__HAL_RCC_GPIOB_CLK_ENABLE();
+
+	//In UART connection with Virtual COM-port, PB6->TX and PB7->RX
+	//2. Alternate Functionality Configuration to make Port B pins work as UART pins
+
+	//Zeroing each and every member element of the structure.
+	memset(&GpioUARTpins, 0, sizeof(GpioUARTpins));
+	GpioUARTpins.Pin = GPIO_PIN_6 | GPIO_PIN_7;
+	GpioUARTpins.Mode = GPIO_MODE_AF_PP;
+	GpioUARTpins.Alternate = GPIO_AF7_USART1;
+	GpioUARTpins.Pull = GPIO_PULLUP;
+
+	HAL_GPIO_Init(GPIOB, &GpioUARTpins);
+
+	//3. Configure and initialize UART parameters
+
+	//Zeroing each and every member element of the structure.
+	memset(&Uart1Init, 0, sizeof(Uart1Init));
+	memset(&Uart1, 0, sizeof(Uart1));
+
+	//UART Initialization
+	Uart1Init.BaudRate = 115200;
+	Uart1Init.WordLength = UART_WORDLENGTH_8B;
+	Uart1Init.HwFlowCtl = UART_HWCONTROL_NONE;
+	Uart1Init.Mode = UART_MODE_TX_RX;
+	Uart1Init.Parity = UART_PARITY_NONE;
+	Uart1Init.StopBits = UART_STOPBITS_1;
+
+	Uart1.Init = Uart1Init;
+	Uart1.Instance = USART1;
+
+	//4. Initialize the UART peripheral
+	uint16_t UARTSetUpResult = HAL_UART_Init(&Uart1);
+
+	if(UARTSetUpResult == HAL_ERROR)
+	{
+		//printf("USART Initialization was not successful \n");
+	}
+
+}
+
+void printmsg(char *msg)
+{
+	HAL_UART_Transmit(&Uart1, (uint8_t *)msg, strlen(msg), 1);
+}
+
+//Implement the Idle Hook function
+void vApplicationIdleHook()
+{
+	//Send the CPU to normal sleep mode
+	__WFI();
+}
@@ -0,0 +1,827 @@
+/*
+ * UsbCdc.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * Minimal CDC-ACM device stack on top of the HAL PCD driver (there is no USB device library in
+ * this project). It answers the standard requests needed for the enumeration, and the CDC
+ * class requests sent by the host serial drivers (line coding and control line state).
+ *
+ * Endpoints: EP0 control, EP1 bulk IN/OUT (data), EP2 interrupt IN (notifications, never used).
+ *
+ * Transmit: xUsbCdcWrite() copies the data into the transmit ring and starts an IN transfer from the
+ * ring itself. The HAL sends it packet by packet from the USB interrupt, and the transfer completion
+ * starts the next one, so a task only copies its data once.
+ * Receive: the OUT endpoint is armed with the next free packet buffer. When all the buffers are
+ * full, it is not armed again until the reader frees one: the device answers NAK and the host waits
+ * (no data is lost).
+ *
+ * The ring and buffer indexes are shared with the USB interrupt, so they are updated in critical
+ * sections (the USB interrupt priority is masked by taskENTER_CRITICAL()).
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "stm32wbxx.h"
+#include "stm32wbxx_hal.h"
+#include "string.h"
+#include "UsbCdc.h"
+
+//Endpoint addresses and sizes
+#define EP0_SIZE				64
+#define CDC_IN_EP				0x81
+#define CDC_OUT_EP				0x01
+#define CDC_CMD_EP				0x82
+#define CDC_DATA_SIZE			64
+#define CDC_CMD_SIZE			8
+
+//Buffer addresses of the endpoints in the packet memory (after the buffer descriptor table)
+#define PMA_EP0_OUT				0x18
+#define PMA_EP0_IN				0x58
+#define PMA_CDC_IN				0xC0
+#define PMA_CDC_OUT				0x110
+#define PMA_CDC_CMD				0x100
+
+#define USB_VID					0x0483
+#define USB_PID					0x5740
+
+//Standard requests
+#define REQ_GET_STATUS			0x00
+#define REQ_CLEAR_FEATURE		0x01
+#define REQ_SET_FEATURE			0x03
+#define REQ_SET_ADDRESS			0x05
+#define REQ_GET_DESCRIPTOR		0x06
+#define REQ_GET_CONFIGURATION	0x08
+#define REQ_SET_CONFIGURATION	0x09
+#define REQ_GET_INTERFACE		0x0A
+#define REQ_SET_INTERFACE		0x0B
+
+//CDC class requests
+#define CDC_SET_LINE_CODING			0x20
+#define CDC_GET_LINE_CODING			0x21
+#define CDC_SET_CONTROL_LINE_STATE	0x22
+#define CDC_SEND_BREAK				0x23
+
+#define REQ_TYPE_MASK			0x60
+#define REQ_TYPE_STANDARD		0x00
+#define REQ_TYPE_CLASS			0x20
+#define REQ_RECIPIENT_MASK		0x1F
+#define REQ_RECIPIENT_ENDPOINT	0x02
+
+#define DESC_DEVICE				0x01
+#define DESC_CONFIGURATION		0x02
+#define DESC_STRING				0x03
+
+#define TX_RING_MASK			(USB_CDC_TX_RING_SIZE - 1)
+
+//Stages of a control transfer on EP0
+typedef enum
+{
+	eEp0Idle,
+	eEp0DataIn,
+	eEp0DataOut,
+	eEp0StatusIn,
+	eEp0StatusOut
+}Ep0Stage_t;
+
+static const uint8_t ucDeviceDescriptor[18] =
+{
+	0x12, DESC_DEVICE,
+	0x00, 0x02,								//USB 2.0
+	0x02, 0x00, 0x00,						//Class CDC (the interfaces tell the rest)
+	EP0_SIZE,
+	(USB_VID & 0xFF), (USB_VID >> 8),
+	(USB_PID & 0xFF), (USB_PID >> 8),
+	0x00, 0x02,								//Device release 2.00
+	1, 2, 3,								//Manufacturer, product and serial number strings
+	1										//Number of configurations
+};
+
+static const uint8_t ucConfigDescriptor[67] =
+{
+	//Configuration
+	0x09, DESC_CONFIGURATION, 67, 0x00, 2, 1, 0, 0xC0, 0x32,
+	//Interface 0: communication class, abstract control model
+	0x09, 0x04, 0, 0, 1, 0x02, 0x02, 0x01, 0,
+	//Header, call management, ACM and union functional descriptors
+	0x05, 0x24, 0x00, 0x10, 0x01,
+	0x05, 0x24, 0x01, 0x00, 1,
+	0x04, 0x24, 0x02, 0x02,
+	0x05, 0x24, 0x06, 0, 1,
+	//Notification endpoint
+	0x07, 0x05, CDC_CMD_EP, 0x03, CDC_CMD_SIZE, 0x00, 0x10,
+	//Interface 1: data class
+	0x09, 0x04, 1, 0, 2, 0x0A, 0x00, 0x00, 0,
+	//Data endpoints
+	0x07, 0x05, CDC_OUT_EP, 0x02, CDC_DATA_SIZE, 0x00, 0x00,
+	0x07, 0x05, CDC_IN_EP, 0x02, CDC_DATA_SIZE, 0x00, 0x00
+};
+
+static const char *pcStrings[] = { NULL, "STMicroelectronics", "FreeRTOS CDC Console" };
+
+static PCD_HandleTypeDef xPcd;
+
+//Device state
+static volatile uint8_t ucConfigured = 0;
+static volatile uint8_t ucSuspended = 0;
+static volatile uint8_t ucDtr = 0;
+
+//115200 baud, 1 stop bit, no parity, 8 data bits (only reported to the host, it does not limit anything)
+static uint8_t ucLineCoding[7] = { 0x00, 0xC2, 0x01, 0x00, 0, 0, 8 };
+
+//Control transfers
+static Ep0Stage_t eEp0Stage = eEp0Idle;
+static uint8_t ucEp0Zlp = 0;
+static uint8_t ucEp0Buffer[EP0_SIZE];
+
+//Transmit ring. The indexes are free running (they are masked to access the ring).
+static uint8_t ucTxRing[USB_CDC_TX_RING_SIZE];
+static volatile uint32_t ulTxHead = 0;
+static volatile uint32_t ulTxTail = 0;
+static volatile uint32_t ulTxInFlight = 0;
+static volatile uint8_t ucTxBusy = 0;
+static volatile uint8_t ucTxZlp = 0;
+static TaskHandle_t xTxWaitingTask = NULL;
+static SemaphoreHandle_t xTxMutex = NULL;
+
+//Receive packet buffers. The indexes are free running packet counts.
+static uint8_t ucRxPackets[USB_CDC_RX_PACKETS][CDC_DATA_SIZE];
+static volatile uint16_t usRxLength[USB_CDC_RX_PACKETS];
+static volatile uint32_t ulRxHead = 0;
+static volatile uint32_t ulRxTail = 0;
+static uint32_t ulRxOffset = 0;
+static volatile uint8_t ucRxArmed = 0;
+static TaskHandle_t xRxWaitingTask = NULL;
+
+static volatile UsbCdcStats_t xStats;
+
+//Set by the callbacks, used at the end of the USB interrupt
+static BaseType_t xUsbHigherPriorityTaskWoken = pdFALSE;
+
+//Private helper functions
+static void prvStartTx(void);
+static void prvArmRx(void);
+static void prvWakeTask(TaskHandle_t *pxTask);
+static void prvEp0Send(const uint8_t *pucData, uint16_t usLength, uint16_t usRequested);
+static void prvEp0Status(void);
+static void prvEp0Stall(void);
+static void prvStandardRequest(const uint8_t *pucSetup);
+static void prvClassRequest(const uint8_t *pucSetup);
+static void prvSendDescriptor(uint8_t ucType, uint8_t ucIndex, uint16_t usRequested);
+static void prvSetConfiguration(uint8_t ucConfiguration);
+
+
+BaseType_t xUsbCdcInit(void)
+{
+	xTxMutex = xSemaphoreCreateMutex();
+	if(xTxMutex == NULL)
+	{
+		return pdFAIL;
+	}
+
+	memset(&xPcd, 0, sizeof(xPcd));
+	xPcd.Instance = USB;
+	xPcd.Init.dev_endpoints = 8;
+	xPcd.Init.speed = PCD_SPEED_FULL;
+	xPcd.Init.phy_itface = PCD_PHY_EMBEDDED;
+	xPcd.Init.Sof_enable = DISABLE;
+	xPcd.Init.low_power_enable = DISABLE;
+	xPcd.Init.lpm_enable = DISABLE;
+	xPcd.Init.battery_charging_enable = DISABLE;
+
+	if(HAL_PCD_Init(&xPcd) != HAL_OK)
+	{
+		return pdFAIL;
+	}
+
+	HAL_PCDEx_PMAConfig(&xPcd, 0x00, PCD_SNG_BUF, PMA_EP0_OUT);
+	HAL_PCDEx_PMAConfig(&xPcd, 0x80, PCD_SNG_BUF, PMA_EP0_IN);
+	HAL_PCDEx_PMAConfig(&xPcd, CDC_IN_EP, PCD_SNG_BUF, PMA_CDC_IN);
+	HAL_PCDEx_PMAConfig(&xPcd, CDC_OUT_EP, PCD_SNG_BUF, PMA_CDC_OUT);
+	HAL_PCDEx_PMAConfig(&xPcd, CDC_CMD_EP, PCD_SNG_BUF, PMA_CDC_CMD);
+
+	//Connect the D+ pull-up: the host starts the enumeration
+	if(HAL_PCD_Start(&xPcd) != HAL_OK)
+	{
+		return pdFAIL;
+	}
+
+	return pdPASS;
+}
+
+BaseType_t xUsbCdcIsConnected(void)
+{
+	return ( (ucConfigured != 0) && (ucSuspended == 0) && (ucDtr != 0) ) ? pdTRUE : pdFALSE;
+}
+
+size_t xUsbCdcWrite(const uint8_t *pucData, size_t xLength, TickType_t xTicksToWait)
+{
+	TimeOut_t xTimeOut;
+	size_t xSent = 0;
+	uint32_t ulFree, ulChunk, ulOffset, ulFirst;
+
+	if(xUsbCdcIsConnected() == pdFALSE)
+	{
+		return 0;
+	}
+
+	vTaskSetTimeOutState(&xTimeOut);
+
+	//One writer at a time, so the messages of the tasks are not interleaved
+	if(xSemaphoreTake(xTxMutex, xTicksToWait) != pdPASS)
+	{
+		return 0;
+	}
+
+	while( (xSent < xLength) && (xUsbCdcIsConnected() != pdFALSE) )
+	{
+		taskENTER_CRITICAL();
+		ulFree = USB_CDC_TX_RING_SIZE - (ulTxHead - ulTxTail);
+		if(ulFree == 0)
+		{
+			xTxWaitingTask = xTaskGetCurrentTaskHandle();
+		}
+		taskEXIT_CRITICAL();
+
+		if(ulFree == 0)
+		{
+			//Woken up by the end of the IN transfer which frees the ring
+			if(xTaskCheckForTimeOut(&xTimeOut, &xTicksToWait) != pdFALSE)
+			{
+				break;
+			}
+			ulTaskNotifyTakeIndexed(USB_CDC_NOTIFY_INDEX, pdTRUE, xTicksToWait);
+			continue;
+		}
+
+		ulChunk = xLength - xSent;
+		if(ulChunk > ulFree)
+		{
+			ulChunk = ulFree;
+		}
+
+		//The free space can wrap around the end of the ring. The interrupt does not read it before ulTxHead is moved.
+		ulOffset = ulTxHead & TX_RING_MASK;
+		ulFirst = USB_CDC_TX_RING_SIZE - ulOffset;
+		if(ulFirst > ulChunk)
+		{
+			ulFirst = ulChunk;
+		}
+		memcpy(&ucTxRing[ulOffset], &pucData[xSent], ulFirst);
+		memcpy(&ucTxRing[0], &pucData[xSent + ulFirst], ulChunk - ulFirst);
+
+		taskENTER_CRITICAL();
+		ulTxHead += ulChunk;
+		prvStartTx();
+		taskEXIT_CRITICAL();
+
+		xSent += ulChunk;
+	}
+
+	xSemaphoreGive(xTxMutex);
+
+	return xSent;
+}
+
+size_t xUsbCdcRead(uint8_t *pucBuffer, size_t xLength, TickType_t xTicksToWait)
+{
+	TimeOut_t xTimeOut;
+	size_t xReceived = 0;
+	uint32_t ulPackets, ulSlot, ulCount;
+
+	vTaskSetTimeOutState(&xTimeOut);
+
+	while(xReceived < xLength)
+	{
+		taskENTER_CRITICAL();
+		ulPackets = ulRxHead - ulRxTail;
+		if( (ulPackets == 0) && (xReceived == 0) )
+		{
+			xRxWaitingTask = xTaskGetCurrentTaskHandle();
+		}
+		taskEXIT_CRITICAL();
+
+		if(ulPackets == 0)
+		{
+			//Return what has been copied so far, or wait for the first packet
+			if( (xReceived != 0) || (xTaskCheckForTimeOut(&xTimeOut, &xTicksToWait) != pdFALSE) )
+			{
+				break;
+			}
+			ulTaskNotifyTakeIndexed(USB_CDC_NOTIFY_INDEX, pdTRUE, xTicksToWait);
+			continue;
+		}
+
+		//Copy from the oldest packet. Only this task moves ulRxTail, so the packet stays in place.
+		ulSlot = ulRxTail % USB_CDC_RX_PACKETS;
+		ulCount = usRxLength[ulSlot] - ulRxOffset;
+		if(ulCount > (xLength - xReceived))
+		{
+			ulCount = xLength - xReceived;
+		}
+		memcpy(&pucBuffer[xReceived], &ucRxPackets[ulSlot][ulRxOffset], ulCount);
+		xReceived += ulCount;
+		ulRxOffset += ulCount;
+
+		if(ulRxOffset == usRxLength[ulSlot])
+		{
+			//Packet consumed: give the buffer back to the OUT endpoint
+			ulRxOffset = 0;
+			taskENTER_CRITICAL();
+			ulRxTail++;
+			prvArmRx();
+			taskEXIT_CRITICAL();
+		}
+	}
+
+	return xReceived;
+}
+
+void vUsbCdcGetStats(UsbCdcStats_t *pxStats)
+{
+	taskENTER_CRITICAL();
+	*pxStats = *(UsbCdcStats_t *) &xStats;
+	taskEXIT_CRITICAL();
+}
+
+
+//USB interrupt handler
+void USB_LP_IRQHandler(void)
+{
+	xUsbHigherPriorityTaskWoken = pdFALSE;
+
+	HAL_PCD_IRQHandler(&xPcd);
+
+	portYIELD_FROM_ISR(xUsbHigherPriorityTaskWoken);
+}
+
+//Called by HAL_PCD_Init() to set up the clocks, pins and interrupt of the USB device
+void HAL_PCD_MspInit(PCD_HandleTypeDef *hpcd)
+{
+	GPIO_InitTypeDef GpioUSBpins;
+	RCC_CRSInitTypeDef CrsInit;
+
+	//1. The USB device is clocked by the HSI48 oscillator
+	__HAL_RCC_HSI48_ENABLE();
+	while(__HAL_RCC_GET_FLAG(RCC_FLAG_HSI48RDY) == 0);
+	__HAL_RCC_USB_CONFIG(RCC_USBCLKSOURCE_HSI48);
+
+	//2. The Clock Recovery System trims the HSI48 with the Start Of Frame packets of the host (USB accuracy)
+	__HAL_RCC_CRS_CLK_ENABLE();
+	CrsInit.Prescaler = RCC_CRS_SYNC_DIV1;
+	CrsInit.Source = RCC_CRS_SYNC_SOURCE_USB;
+	CrsInit.Polarity = RCC_CRS_SYNC_POLARITY_RISING;
+	CrsInit.ReloadValue = RCC_CRS_RELOADVALUE_DEFAULT;
+	CrsInit.ErrorLimitValue = RCC_CRS_ERRORLIMIT_DEFAULT;
+	CrsInit.HSI48CalibrationValue = RCC_CRS_HSI48CALIBRATION_DEFAULT;
+	HAL_RCCEx_CRSConfig(&CrsInit);
+
+	//3. PA11->USB_DM and PA12->USB_DP
+	__HAL_RCC_GPIOA_CLK_ENABLE();
+	memset(&GpioUSBpins, 0, sizeof(GpioUSBpins));
+	GpioUSBpins.Pin = GPIO_PIN_11 | GPIO_PIN_12;
+	GpioUSBpins.Mode = GPIO_MODE_AF_PP;
+	GpioUSBpins.Pull = GPIO_NOPULL;
+	GpioUSBpins.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+	GpioUSBpins.Alternate = GPIO_AF10_USB;
+	HAL_GPIO_Init(GPIOA, &GpioUSBpins);
+
+	//4. USB peripheral clock, USB supply and interrupt
+	__HAL_RCC_USB_CLK_ENABLE();
+	HAL_PWREx_EnableVddUSB();
+
+	NVIC_SetPriority(USB_LP_IRQn, USB_CDC_IRQ_PRIORITY); //Priority should be less than or equal to configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY
+	NVIC_EnableIRQ(USB_LP_IRQn);
+}
+
+
+//The HAL PCD callbacks below are called from the USB interrupt
+
+void HAL_PCD_ResetCallback(PCD_HandleTypeDef *hpcd)
+{
+	ucConfigured = 0;
+	ucDtr = 0;
+	ucSuspended = 0;
+	eEp0Stage = eEp0Idle;
+
+	HAL_PCD_EP_Open(hpcd, 0x00, EP0_SIZE, EP_TYPE_CTRL);
+	HAL_PCD_EP_Open(hpcd, 0x80, EP0_SIZE, EP_TYPE_CTRL);
+
+	//The data endpoints are closed by the reset: drop the data not sent yet
+	ulTxTail = ulTxHead;
+	ulTxInFlight = 0;
+	ucTxBusy = 0;
+	ucTxZlp = 0;
+	ucRxArmed = 0;
+
+	prvWakeTask(&xTxWaitingTask);
+}
+
+void HAL_PCD_SuspendCallback(PCD_HandleTypeDef *hpcd)
+{
+	//The host is asleep or the cable has been unplugged
+	ucSuspended = 1;
+	prvWakeTask(&xTxWaitingTask);
+}
+
+void HAL_PCD_ResumeCallback(PCD_HandleTypeDef *hpcd)
+{
+	ucSuspended = 0;
+}
+
+void HAL_PCD_SetupStageCallback(PCD_HandleTypeDef *hpcd)
+{
+	const uint8_t *pucSetup = (const uint8_t *) hpcd->Setup;
+
+	eEp0Stage = eEp0Idle;
+	ucEp0Zlp = 0;
+
+	switch(pucSetup[0] & REQ_TYPE_MASK)
+	{
+		case REQ_TYPE_STANDARD:
+			prvStandardRequest(pucSetup);
+			break;
+
+		case REQ_TYPE_CLASS:
+			prvClassRequest(pucSetup);
+			break;
+
+		default:
+			prvEp0Stall();
+			break;
+	}
+}
+
+void HAL_PCD_DataInStageCallback(PCD_HandleTypeDef *hpcd, uint8_t epnum)
+{
+	if(epnum == 0)
+	{
+		PCD_EPTypeDef *pxEp0 = &hpcd->IN_ep[0];
+
+		if(pxEp0->xfer_len != 0)
+		{
+			//The HAL sends one packet at a time on EP0: continue the data stage
+			HAL_PCD_EP_Transmit(hpcd, 0x80, pxEp0->xfer_buff, pxEp0->xfer_len);
+		}
+		else if(ucEp0Zlp != 0)
+		{
+			//The data ended on a full packet but is shorter than requested: end it with an empty packet
+			ucEp0Zlp = 0;
+			HAL_PCD_EP_Transmit(hpcd, 0x80, NULL, 0);
+		}
+		else if(eEp0Stage == eEp0DataIn)
+		{
+			eEp0Stage = eEp0StatusOut;
+			HAL_PCD_EP_Receive(hpcd, 0x00, NULL, 0);
+		}
+		else
+		{
+			//End of the status stage (the HAL applies a new address here)
+			eEp0Stage = eEp0Idle;
+		}
+	}
+	else if(epnum == (CDC_IN_EP & 0x7F))
+	{
+		ulTxTail += ulTxInFlight;
+		xStats.ulTxBytes += ulTxInFlight;
+		xStats.ulTxTransfers++;
+
+		//A transfer which ends with a full packet needs an empty packet, otherwise the host keeps waiting for the rest
+		ucTxZlp = ( (ulTxInFlight != 0) && ((ulTxInFlight % CDC_DATA_SIZE) == 0) ) ? 1 : 0;
+		ulTxInFlight = 0;
+		ucTxBusy = 0;
+
+		prvStartTx();
+		prvWakeTask(&xTxWaitingTask);
+	}
+}
+
+void HAL_PCD_DataOutStageCallback(PCD_HandleTypeDef *hpcd, uint8_t epnum)
+{
+	uint32_t ulCount;
+
+	if(epnum == 0)
+	{
+		if(eEp0Stage == eEp0DataOut)
+		{
+			//The new line coding has been received in ucLineCoding
+			prvEp0Status();
+		}
+		else
+		{
+			eEp0Stage = eEp0Idle;
+		}
+	}
+	else if(epnum == CDC_OUT_EP)
+	{
+		ucRxArmed = 0;
+		ulCount = HAL_PCD_EP_GetRxCount(hpcd, CDC_OUT_EP);
+
+		if(ulCount != 0)
+		{
+			usRxLength[ulRxHead % USB_CDC_RX_PACKETS] = (uint16_t) ulCount;
+			ulRxHead++;
+			xStats.ulRxBytes += ulCount;
+		}
+
+		if( (ulRxHead - ulRxTail) == USB_CDC_RX_PACKETS )
+		{
+			xStats.ulRxPaused++;
+		}
+
+		prvArmRx();
+		prvWakeTask(&xRxWaitingTask);
+	}
+}
+
+
+//It must be called from the USB interrupt or in a critical section
+static void prvStartTx(void)
+{
+	uint32_t ulPending, ulOffset, ulLength;
+
+	if( (ucTxBusy != 0) || (ucConfigured == 0) )
+	{
+		return;
+	}
+
+	ulPending = ulTxHead - ulTxTail;
+
+	if(ulPending == 0)
+	{
+		if(ucTxZlp != 0)
+		{
+			ucTxZlp = 0;
+			ucTxBusy = 1;
+			HAL_PCD_EP_Transmit(&xPcd, CDC_IN_EP, NULL, 0);
+		}
+		return;
+	}
+
+	//Send the data where it is in the ring, up to the end of the ring
+	ulOffset = ulTxTail & TX_RING_MASK;
+	ulLength = USB_CDC_TX_RING_SIZE - ulOffset;
+	if(ulLength > ulPending)
+	{
+		ulLength = ulPending;
+	}
+	if(ulLength > USB_CDC_MAX_TX_TRANSFER)
+	{
+		ulLength = USB_CDC_MAX_TX_TRANSFER;
+	}
+
+	ucTxZlp = 0;
+	ucTxBusy = 1;
+	ulTxInFlight = ulLength;
+	HAL_PCD_EP_Transmit(&xPcd, CDC_IN_EP, &ucTxRing[ulOffset], ulLength);
+}
+
+//It must be called from the USB interrupt or in a critical section
+static void prvArmRx(void)
+{
+	if( (ucRxArmed != 0) || (ucConfigured == 0) || ((ulRxHead - ulRxTail) >= USB_CDC_RX_PACKETS) )
+	{
+		return;
+	}
+
+	ucRxArmed = 1;
+	HAL_PCD_EP_Receive(&xPcd, CDC_OUT_EP, ucRxPackets[ulRxHead % USB_CDC_RX_PACKETS], CDC_DATA_SIZE);
+}
+
+//Called from the USB interrupt
+static void prvWakeTask(TaskHandle_t *pxTask)
+{
+	if(*pxTask != NULL)
+	{
+		vTaskNotifyGiveIndexedFromISR(*pxTask, USB_CDC_NOTIFY_INDEX, &xUsbHigherPriorityTaskWoken);
+		*pxTask = NULL;
+	}
+}
+
+static void prvEp0Send(const uint8_t *pucData, uint16_t usLength, uint16_t usRequested)
+{
+	if(usLength > usRequested)
+	{
+		usLength = usRequested;
+	}
+
+	ucEp0Zlp = ( (usLength < usRequested) && ((usLength % EP0_SIZE) == 0) && (usLength != 0) ) ? 1 : 0;
+	eEp0Stage = eEp0DataIn;
+	HAL_PCD_EP_Transmit(&xPcd, 0x80, (uint8_t *) pucData, usLength);
+}
+
+static void prvEp0Status(void)
+{
+	eEp0Stage = eEp0StatusIn;
+	HAL_PCD_EP_Transmit(&xPcd, 0x80, NULL, 0);
+}
+
+static void prvEp0Stall(void)
+{
+	eEp0Stage = eEp0Idle;
+	HAL_PCD_EP_SetStall(&xPcd, 0x80);
+	HAL_PCD_EP_SetStall(&xPcd, 0x00);
+}
+
+static void prvStandardRequest(const uint8_t *pucSetup)
+{
+	uint16_t usValue = pucSetup[2] | (pucSetup[3] << 8);
+	uint16_t usIndex = pucSetup[4] | (pucSetup[5] << 8);
+	uint16_t usLength = pucSetup[6] | (pucSetup[7] << 8);
+
+	switch(pucSetup[1])
+	{
+		case REQ_GET_STATUS:
+			ucEp0Buffer[0] = 0;
+			ucEp0Buffer[1] = 0;
+			prvEp0Send(ucEp0Buffer, 2, usLength);
+			break;
+
+		case REQ_CLEAR_FEATURE:
+		case REQ_SET_FEATURE:
+			//Only the endpoint halt feature is supported
+			if( ((pucSetup[0] & REQ_RECIPIENT_MASK) == REQ_RECIPIENT_ENDPOINT) && (usValue == 0) && ((usIndex & 0x7F) != 0) )
+			{
+				if(pucSetup[1] == REQ_SET_FEATURE)
+				{
+					HAL_PCD_EP_SetStall(&xPcd, (uint8_t) usIndex);
+				}
+				else
+				{
+					HAL_PCD_EP_ClrStall(&xPcd, (uint8_t) usIndex);
+				}
+			}
+			prvEp0Status();
+			break;
+
+		case REQ_SET_ADDRESS:
+			//The HAL applies the address when the status stage is done
+			HAL_PCD_SetAddress(&xPcd, (uint8_t)(usValue & 0x7F));
+			prvEp0Status();
+			break;
+
+		case REQ_GET_DESCRIPTOR:
+			prvSendDescriptor((uint8_t)(usValue >> 8), (uint8_t)(usValue & 0xFF), usLength);
+			break;
+
+		case REQ_GET_CONFIGURATION:
+			ucEp0Buffer[0] = ucConfigured;
+			prvEp0Send(ucEp0Buffer, 1, usLength);
+			break;
+
+		case REQ_SET_CONFIGURATION:
+			if(usValue > 1)
+			{
+				prvEp0Stall();
+				break;
+			}
+			prvSetConfiguration((uint8_t) usValue);
+			prvEp0Status();
+			break;
+
+		case REQ_GET_INTERFACE:
+			ucEp0Buffer[0] = 0;
+			prvEp0Send(ucEp0Buffer, 1, usLength);
+			break;
+
+		case REQ_SET_INTERFACE:
+			prvEp0Status();
+			break;
+
+		default:
+			prvEp0Stall();
+			break;
+	}
+}
+
+static void prvClassRequest(const uint8_t *pucSetup)
+{
+	uint16_t usValue = pucSetup[2] | (pucSetup[3] << 8);
+	uint16_t usLength = pucSetup[6] | (pucSetup[7] << 8);
+
+	switch(pucSetup[1])
+	{
+		case CDC_SET_LINE_CODING:
+			eEp0Stage = eEp0DataOut;
+			HAL_PCD_EP_Receive(&xPcd, 0x00, ucLineCoding, sizeof(ucLineCoding));
+			break;
+
+		case CDC_GET_LINE_CODING:
+			prvEp0Send(ucLineCoding, sizeof(ucLineCoding), usLength);
+			break;
+
+		case CDC_SET_CONTROL_LINE_STATE:
+			//Bit 0 is DTR: the terminal program has opened the port
+			ucDtr = (uint8_t)(usValue & 0x01);
+			if(ucDtr == 0)
+			{
+				prvWakeTask(&xTxWaitingTask);
+			}
+			prvEp0Status();
+			break;
+
+		case CDC_SEND_BREAK:
+			prvEp0Status();
+			break;
+
+		default:
+			prvEp0Stall();
+			break;
+	}
+}
+
+static void prvSendDescriptor(uint8_t ucType, uint8_t ucIndex, uint16_t usRequested)
+{
+	static const char cHex[] = "0123456789ABCDEF";
+	uint32_t ulSerial;
+	uint8_t i, ucLength;
+
+	switch(ucType)
+	{
+		case DESC_DEVICE:
+			prvEp0Send(ucDeviceDescriptor, sizeof(ucDeviceDescriptor), usRequested);
+			break;
+
+		case DESC_CONFIGURATION:
+			prvEp0Send(ucConfigDescriptor, sizeof(ucConfigDescriptor), usRequested);
+			break;
+
+		case DESC_STRING:
+			ucEp0Buffer[1] = DESC_STRING;
+
+			if(ucIndex == 0)
+			{
+				//Supported language: English (United States)
+				ucEp0Buffer[0] = 4;
+				ucEp0Buffer[2] = 0x09;
+				ucEp0Buffer[3] = 0x04;
+			}
+			else if(ucIndex < (sizeof(pcStrings) / sizeof(pcStrings[0])))
+			{
+				//The strings are sent in UTF-16
+				for(ucLength = 0; pcStrings[ucIndex][ucLength] != '\0'; ucLength++)
+				{
+					ucEp0Buffer[2 + (2 * ucLength)] = (uint8_t) pcStrings[ucIndex][ucLength];
+					ucEp0Buffer[3 + (2 * ucLength)] = 0;
+				}
+				ucEp0Buffer[0] = 2 + (2 * ucLength);
+			}
+			else if(ucIndex == 3)
+			{
+				//Serial number from the unique device ID, so each board gets its own COM port
+				ulSerial = HAL_GetUIDw0();
+				for(i = 0; i < 8; i++)
+				{
+					ucEp0Buffer[2 + (2 * i)] = (uint8_t) cHex[(ulSerial >> (28 - (4 * i))) & 0x0F];
+					ucEp0Buffer[3 + (2 * i)] = 0;
+				}
+				ucEp0Buffer[0] = 2 + (2 * 8);
+			}
+			else
+			{
+				prvEp0Stall();
+				break;
+			}
+
+			prvEp0Send(ucEp0Buffer, ucEp0Buffer[0], usRequested);
+			break;
+
+		default:
+			//No device qualifier descriptor: the device is full speed only
+			prvEp0Stall();
+			break;
+	}
+}
+
+static void prvSetConfiguration(uint8_t ucConfiguration)
+{
+	if(ucConfiguration == ucConfigured)
+	{
+		return;
+	}
+
+	if(ucConfiguration != 0)
+	{
+		HAL_PCD_EP_Open(&xPcd, CDC_IN_EP, CDC_DATA_SIZE, EP_TYPE_BULK);
+		HAL_PCD_EP_Open(&xPcd, CDC_OUT_EP, CDC_DATA_SIZE, EP_TYPE_BULK);
+		HAL_PCD_EP_Open(&xPcd, CDC_CMD_EP, CDC_CMD_SIZE, EP_TYPE_INTR);
+
+		ucConfigured = 1;
+		ucTxBusy = 0;
+		ucRxArmed = 0;
+		prvArmRx();
+		prvStartTx();
+	}
+	else
+	{
+		ucConfigured = 0;
+		HAL_PCD_EP_Close(&xPcd, CDC_IN_EP);
+		HAL_PCD_EP_Close(&xPcd, CDC_OUT_EP);
+		HAL_PCD_EP_Close(&xPcd, CDC_CMD_EP);
+		prvWakeTask(&xTxWaitingTask);
+	}
+}
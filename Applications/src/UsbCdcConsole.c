@@ -0,0 +1,216 @@
+/*
+ * UsbCdcConsole.c
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rahul
+ */
+
+/*
+ * This application uses the USB CDC virtual COM port (UsbCdc.c) as the console instead of USART1.
+ * Connect the USB_USER connector of the Nucleo board: the host sees a second serial port.
+ *
+ * The Echo task sends back everything received on the USB port, and the Report task prints the
+ * throughput every 5 seconds with printmsg(). printmsg() writes to the USB port when it is open
+ * (CONSOLE_USE_USB_CDC), otherwise to USART1 (ST-LINK virtual COM port) like the other applications.
+ *
+ * Throughput test: set CONSOLE_USE_USB_CDC to 0 (the reports go to USART1 and only the echoed data
+ * goes to the USB port), then run Tools/cdc_loopback.py on the host with the USB port.
+ *
+ * UsbCdc.c has to be included in the build with this file, and HAL_PCD_MODULE_ENABLED in stm32wbxx_hal_conf.h.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stm32wbxx.h"
+#include "stm32wbxx_nucleo.h"
+#include "stdio.h"
+#include "string.h"
+#include "UsbCdc.h"
+
+//1: console messages on the USB port when it is open, 0: always on USART1
+#define CONSOLE_USE_USB_CDC		1
+
+#define ECHO_BUFFER_SIZE		256
+#define REPORT_PERIOD_MS		5000
+
+//Task handles and functions
+TaskHandle_t xEchoTask = NULL;
+TaskHandle_t xReportTask = NULL;
+void vEchoTaskFunction(void *params);
+void vReportTaskFunction(void *params);
+
+//UART Handle and Init types
+UART_HandleTypeDef Uart1;
+UART_InitTypeDef Uart1Init;
+GPIO_InitTypeDef GpioUARTpins;
+
+//Private helper functions and variables
+static void prvSetupClock(void);
+static void prvSetupUART(void);
+void printmsg(char *msg);
+char UsrMsg[250];
+
+int main()
+{
+	// Enable the DWT Cycle Count Register (SEGGER Settings)
+	DWT->CTRL |= (1 << 0);
+
+	// Private functions called to setup the Hardware. The clock first: the UART baud rate depends on it.
+	prvSetupClock();
+	prvSetupUART();
+
+	//Start Recording for SEGGER SystemView
+	SEGGER_SYSVIEW_Conf();
+	SEGGER_SYSVIEW_Start();
+
+	sprintf(UsrMsg,"Example of a console on the USB CDC virtual COM port \r\n");
+	printmsg(UsrMsg);
+
+	if(xUsbCdcInit() == pdPASS)
+	{
+		//Create Echo Task. It will be higher priority task, so the host data does not wait behind the reports.
+		xTaskCreate(vEchoTaskFunction, "Echo-Task", 256 + (ECHO_BUFFER_SIZE / sizeof(StackType_t)), NULL, 3, &xEchoTask);
+
+		//Create Report Task
+		xTaskCreate(vReportTaskFunction, "Report-Task", 384, NULL, 2, &xReportTask);
+
+		//Schedule the tasks
+		vTaskStartScheduler();
+	}
+	else
+	{
+		sprintf(UsrMsg, "USB device initialization failed... :( \r\n");
+		printmsg(UsrMsg);
+	}
+
+	/*
+	 * If scheduler can start the tasks and run them, the program will never reach here.
+	 * If the program comes to the below line, that means there was a problem while creating or scheduling the tasks
+	 */
+	for(;;);
+}
+
+
+void vEchoTaskFunction(void *params)
+{
+	uint8_t ucBuffer[ECHO_BUFFER_SIZE];
+	size_t xReceived;
+
+	while(1)
+	{
+		//Blocks until the host sends something
+		xReceived = xUsbCdcRead(ucBuffer, sizeof(ucBuffer), portMAX_DELAY);
+
+		if(xReceived != 0)
+		{
+			//Blocks while the transmit ring is full: the OUT endpoint is then held back too (end to end flow control)
+			xUsbCdcWrite(ucBuffer, xReceived, portMAX_DELAY);
+		}
+	}
+}
+
+
+void vReportTaskFunction(void *params)
+{
+	UsbCdcStats_t xStats, xLastStats;
+	uint32_t ulSeconds = REPORT_PERIOD_MS / 1000;
+
+	vUsbCdcGetStats(&xLastStats);
+
+	while(1)
+	{
+		vTaskDelay(pdMS_TO_TICKS(REPORT_PERIOD_MS));
+
+		vUsbCdcGetStats(&xStats);
+
+		sprintf(UsrMsg, "\r\nUSB %s: RX %lu B/s, TX %lu B/s, %lu IN transfers, %lu RX pauses \r\n",
+				(xUsbCdcIsConnected() != pdFALSE) ? "open" : "closed",
+				(xStats.ulRxBytes - xLastStats.ulRxBytes) / ulSeconds,
+				(xStats.ulTxBytes - xLastStats.ulTxBytes) / ulSeconds,
+				xStats.ulTxTransfers - xLastStats.ulTxTransfers,
+				xStats.ulRxPaused - xLastStats.ulRxPaused);
+		printmsg(UsrMsg);
+
+		xLastStats = xStats;
+	}
+}
+
+
+static void prvSetupClock(void)
+{
+	//The USB device needs HCLK >= 14.2 MHz. MSI 4 MHz -> 32 MHz, which needs 1 flash wait state.
+	__HAL_FLASH_SET_LATENCY(FLASH_LATENCY_1);
+	while(__HAL_FLASH_GET_LATENCY() != FLASH_LATENCY_1);
+
+	__HAL_RCC_MSI_RANGE_CONFIG(RCC_MSIRANGE_10);
+	while(__HAL_RCC_GET_FLAG(RCC_FLAG_MSIRDY) == 0);
+
+	//SystemCoreClock is used by the kernel tick, SystemView and the UART baud rate
+	SystemCoreClockUpdate();
+}
+
+static void prvSetupUART(void)
+{
+	//1. Enable the UART1 and GPIOB Peripheral Clocks
+	__HAL_RCC_USART1_CLK_ENABLE();
+	__HAL_RCC_GPIOB_CLK_ENABLE();
+
+	//In UART connection with Virtual COM-port, PB6->TX and PB7->RX
+	//2. Alternate Functionality Configuration to make Port B pins work as UART pins
+
+	//Zeroing each and every member element of the structure.
+	memset(&GpioUARTpins, 0, sizeof(GpioUARTpins));
+	GpioUARTpins.Pin = GPIO_PIN_6 | GPIO_PIN_7;
+	GpioUARTpins.Mode = GPIO_MODE_AF_PP;
+	GpioUARTpins.Alternate = GPIO_AF7_USART1;
+	GpioUARTpins.Pull = GPIO_PULLUP;
+
+	HAL_GPIO_Init(GPIOB, &GpioUARTpins);
+
+	//3. Configure and initialize UART parameters
+
+	//Zeroing each and every member element of the structure.
+	memset(&Uart1Init, 0, sizeof(Uart1Init));
+	memset(&Uart1, 0, sizeof(Uart1));
+
+	//UART Initialization
+	Uart1Init.BaudRate = 115200;
+	Uart1Init.WordLength = UART_WORDLENGTH_8B;
+	Uart1Init.HwFlowCtl = UART_HWCONTROL_NONE;
+	Uart1Init.Mode = UART_MODE_TX_RX;
+	Uart1Init.Parity = UART_PARITY_NONE;
+	Uart1Init.StopBits = UART_STOPBITS_1;
+
+	Uart1.Init = Uart1Init;
+	Uart1.Instance = USART1;
+
+	//4. Initialize the UART peripheral
+	uint16_t UARTSetUpResult = HAL_UART_Init(&Uart1);
+
+	if(UARTSetUpResult == HAL_ERROR)
+	{
+		//printf("USART Initialization was not successful \n");
+	}
+
+}
+
+void printmsg(char *msg)
+{
+#if ( CONSOLE_USE_USB_CDC == 1 )
+	//No baud rate on the USB port: the message is queued and the task only waits if the ring is full
+	if(xUsbCdcIsConnected() != pdFALSE)
+	{
+		xUsbCdcWrite((uint8_t *)msg, strlen(msg), pdMS_TO_TICKS(10));
+		return;
+	}
+#endif
+
+	HAL_UART_Transmit(&Uart1, (uint8_t *)msg, strlen(msg), 1);
+}
+
+//Implement the Idle Hook function
+void vApplicationIdleHook()
+{
+	//Send the CPU to normal sleep mode
+	__WFI();
+}